@@ -28,7 +28,9 @@
 #include <fuerte/asio_ns.h>
 
 #include <mutex>
+#include <string>
 #include <thread>
+#include <unordered_map>
 #include <utility>
 
 // run / runWithWork / poll for Loop mapping to ioservice
@@ -66,6 +68,18 @@ class EventLoopService {
 
   asio_ns::ssl::context& sslContext();
 
+  /// @brief TLS session to resume for a new connection to the endpoint.
+  /// the caller owns a reference to the returned session and must free it.
+  /// returns a nullptr if there is no session for the endpoint
+  SSL_SESSION* sslSession(std::string const& endpoint);
+
+  /// @brief store the TLS session for an endpoint, takes over the reference
+  void storeSslSession(std::string const& endpoint, SSL_SESSION* session);
+
+  /// @brief index of the SSL ex_data slot which holds the session key
+  /// (a std::string const*) of a connection
+  static int sslSessionIndex();
+
   // stop and join threads
   void stop();
 
@@ -78,6 +92,12 @@ class EventLoopService {
   /// global SSL context to use here
   std::unique_ptr<asio_ns::ssl::context> _sslContext;
 
+  /// protect the TLS sessions
+  std::mutex _sslSessionsMutex;
+  /// last TLS session per endpoint and verify mode, so that new connections
+  /// can resume the session instead of doing a full handshake
+  std::unordered_map<std::string, SSL_SESSION*> _sslSessions;
+
   /// io contexts
   std::vector<std::shared_ptr<asio_ns::io_context>> _ioContexts;
   /// Threads powering each io_context
@@ -121,13 +121,18 @@ struct Socket<SocketType::Tcp> {
 template <>
 struct Socket<fuerte::SocketType::Ssl> {
   Socket(EventLoopService& loop, asio_ns::io_context& ctx)
-    : resolver(ctx), socket(ctx, loop.sslContext()), timer(ctx), cleanupDone(false) {}
+    : loop(loop), resolver(ctx), socket(ctx, loop.sslContext()), timer(ctx), cleanupDone(false) {}
 
   ~Socket() { this->cancel(); }
 
   template <typename F>
   void connect(detail::ConnectionConfiguration const& config, F&& done) {
     bool verify = config._verifyHost;
+    // sessions of connections without certificate verification must never
+    // be resumed by connections which require it, so the verify mode is
+    // part of the key
+    sessionKey = config._host + ":" + config._port +
+                 (verify ? ":verify" : ":noverify");
     resolveConnect(
         config, resolver, socket.next_layer(),
         [=, this, done(std::forward<F>(done))](auto const& ec) mutable {
@@ -155,6 +160,15 @@ struct Socket<fuerte::SocketType::Ssl> {
             } else {
               socket.set_verify_mode(asio_ns::ssl::verify_none);
             }
+
+            // resume the last session with this endpoint if there is one,
+            // and let the context store new sessions under our key
+            SSL* ssl = socket.native_handle();
+            SSL_set_ex_data(ssl, EventLoopService::sslSessionIndex(), &sessionKey);
+            if (SSL_SESSION* session = loop.sslSession(sessionKey)) {
+              SSL_set_session(ssl, session);
+              SSL_SESSION_free(session);
+            }
           } catch (std::bad_alloc const&) {
             // definitely an OOM error
             done(boost::system::errc::make_error_code(boost::system::errc::not_enough_memory));
@@ -227,6 +241,10 @@ struct Socket<fuerte::SocketType::Ssl> {
     });
   }
 
+  EventLoopService& loop;
+  /// @brief key of the TLS sessions for the endpoint and verify mode,
+  /// "host:port:verify" or "host:port:noverify"
+  std::string sessionKey;
   asio_ns::ip::tcp::resolver resolver;
   asio_ns::ssl::stream<asio_ns::ip::tcp::socket> socket;
   asio_ns::steady_timer timer;
@@ -51,7 +51,29 @@ EventLoopService::EventLoopService(unsigned int threadCount, char const* name)
   }
 }
 
-EventLoopService::~EventLoopService() { stop(); }
+namespace {
+// called by OpenSSL for each new client session, including the session
+// tickets which TLS 1.3 servers send after the handshake
+int storeNewSslSession(SSL* ssl, SSL_SESSION* session) {
+  auto const* key = static_cast<std::string const*>(
+      SSL_get_ex_data(ssl, EventLoopService::sslSessionIndex()));
+  auto* loop = static_cast<EventLoopService*>(
+      SSL_CTX_get_app_data(SSL_get_SSL_CTX(ssl)));
+  if (key == nullptr || loop == nullptr) {
+    return 0;
+  }
+  loop->storeSslSession(*key, session);
+  // we have taken over the reference
+  return 1;
+}
+}  // namespace
+
+EventLoopService::~EventLoopService() {
+  stop();
+  for (auto& it : _sslSessions) {
+    SSL_SESSION_free(it.second);
+  }
+}
 
 asio_ns::ssl::context& EventLoopService::sslContext() {
   std::lock_guard<std::mutex> guard(_sslContextMutex);
@@ -62,10 +84,56 @@ asio_ns::ssl::context& EventLoopService::sslContext() {
     _sslContext.reset(new asio_ns::ssl::context(asio_ns::ssl::context::sslv23));
 #endif
     _sslContext->set_default_verify_paths();
+
+    // cache client sessions, so that connections to the same endpoint can
+    // use an abbreviated handshake. this avoids a flood of full handshakes
+    // when many connections are opened at once
+    SSL_CTX* native = _sslContext->native_handle();
+    SSL_CTX_set_app_data(native, this);
+    SSL_CTX_set_session_cache_mode(
+        native, SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+    SSL_CTX_sess_set_new_cb(native, &storeNewSslSession);
   }
   return *_sslContext;
 }
 
+SSL_SESSION* EventLoopService::sslSession(std::string const& endpoint) {
+  std::lock_guard<std::mutex> guard(_sslSessionsMutex);
+  auto it = _sslSessions.find(endpoint);
+  if (it == _sslSessions.end()) {
+    return nullptr;
+  }
+  SSL_SESSION_up_ref(it->second);
+  return it->second;
+}
+
+void EventLoopService::storeSslSession(std::string const& endpoint,
+                                       SSL_SESSION* session) {
+  SSL_SESSION* previous = nullptr;
+  {
+    std::lock_guard<std::mutex> guard(_sslSessionsMutex);
+    try {
+      auto [it, inserted] = _sslSessions.try_emplace(endpoint, session);
+      if (!inserted) {
+        previous = it->second;
+        it->second = session;
+      }
+    } catch (...) {
+      // out of memory. not caching the session is fine
+      previous = session;
+    }
+  }
+  if (previous != nullptr) {
+    SSL_SESSION_free(previous);
+  }
+}
+
+int EventLoopService::sslSessionIndex() {
+  static int const index =
+      SSL_get_ex_new_index(0, nullptr, nullptr, nullptr, nullptr);
+  return index;
+}
+
 void EventLoopService::stop() {
   // allow run() to exit, wait for threads to finish only then stop the context
   std::for_each(_guards.begin(), _guards.end(), [](auto& g) { g.reset(); });
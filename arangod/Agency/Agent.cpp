@@ -79,6 +79,10 @@ DECLARE_COUNTER(arangodb_agency_read_no_leader_total, "Agency read no leader");
 DECLARE_COUNTER(arangodb_agency_read_ok_total, "Agency read ok");
 DECLARE_HISTOGRAM(arangodb_agency_write_hist, AgentScale,
                   "Agency write histogram [ms]");
+DECLARE_HISTOGRAM(arangodb_agency_write_apply_hist, AgentScale,
+                  "Agency write spearhead application histogram [ms]");
+DECLARE_HISTOGRAM(arangodb_agency_write_persist_hist, AgentScale,
+                  "Agency write log persistence histogram [ms]");
 DECLARE_COUNTER(arangodb_agency_write_no_leader_total,
                 "Agency write no leader");
 DECLARE_COUNTER(arangodb_agency_write_ok_total, "Agency write ok");
@@ -118,6 +122,12 @@ Agent::Agent(ArangodServer& server, config_t const& config)
       _write_hist_msec(
           server.getFeature<arangodb::metrics::MetricsFeature>().add(
               arangodb_agency_write_hist{})),
+      _write_apply_hist_msec(
+          server.getFeature<arangodb::metrics::MetricsFeature>().add(
+              arangodb_agency_write_apply_hist{})),
+      _write_persist_hist_msec(
+          server.getFeature<arangodb::metrics::MetricsFeature>().add(
+              arangodb_agency_write_persist_hist{})),
       _commit_hist_msec(
           server.getFeature<arangodb::metrics::MetricsFeature>().add(
               arangodb_agency_commit_hist{})),
@@ -595,6 +605,13 @@ void Agent::sendAppendEntriesRPC() {
   // _lastSent only accessed in main thread
   std::string const myid = id();
 
+  // the last compacted snapshot is loaded at most once for all followers
+  // that need it, unless there was another compaction in the meantime
+  Store snapshot("snapshot");
+  index_t snapshotIndex = 0;
+  term_t snapshotTerm = 0;
+  bool snapshotLoaded = false;
+
   for (auto const& followerId : _config.active()) {
     if (followerId != myid && leading()) {
       term_t t(term());
@@ -683,21 +700,23 @@ void Agent::sendAppendEntriesRPC() {
       }
       index_t lowest = unconfirmed.front().index;
 
-      Store snapshot("snapshot");
-      index_t snapshotIndex;
-      term_t snapshotTerm;
-
       if (lowest > lastConfirmed || needSnapshot) {
         // Ooops, compaction has thrown away so many log entries that
         // we cannot actually update the follower. We need to send our
         // latest snapshot instead:
-        bool success = false;
-        try {
-          success = _state.loadLastCompactedSnapshot(snapshot, snapshotIndex,
-                                                     snapshotTerm);
-        } catch (std::exception const& e) {
-          LOG_TOPIC("f2287", WARN, Logger::AGENCY)
-              << "Exception thrown by loadLastCompactedSnapshot: " << e.what();
+        bool success =
+            snapshotLoaded && snapshotIndex == _state.lastCompactionAt();
+        if (!success) {
+          snapshotLoaded = false;
+          try {
+            success = _state.loadLastCompactedSnapshot(snapshot, snapshotIndex,
+                                                       snapshotTerm);
+            snapshotLoaded = success;
+          } catch (std::exception const& e) {
+            LOG_TOPIC("f2287", WARN, Logger::AGENCY)
+                << "Exception thrown by loadLastCompactedSnapshot: "
+                << e.what();
+          }
         }
         if (!success) {
           LOG_TOPIC("6e2b8", WARN, Logger::AGENCY)
@@ -1425,9 +1444,18 @@ write_ret_t Agent::write(velocypack::Slice query, WriteMode const& wmode) {
 
       std::lock_guard ioLocker{_ioLock};
 
+      auto const applyStart = high_resolution_clock::now();
       applied = _spearhead.applyTransactions(chunk.slice(), wmode);
+      auto const persistStart = high_resolution_clock::now();
       auto tmp = _state.logLeaderMulti(chunk.slice(), applied, currentTerm);
       indices.insert(indices.end(), tmp.begin(), tmp.end());
+
+      _write_apply_hist_msec.count(
+          duration<float, std::milli>(persistStart - applyStart).count());
+      _write_persist_hist_msec.count(
+          duration<float, std::milli>(high_resolution_clock::now() -
+                                      persistStart)
+              .count());
     }
     _write_hist_msec.count(
         duration<float, std::milli>(high_resolution_clock::now() - start)
@@ -515,6 +515,8 @@ class Agent final : public arangodb::ServerThread<ArangodServer>,
   metrics::Counter& _read_ok;
   metrics::Counter& _read_no_leader;
   metrics::Histogram<metrics::LogScale<float>>& _write_hist_msec;
+  metrics::Histogram<metrics::LogScale<float>>& _write_apply_hist_msec;
+  metrics::Histogram<metrics::LogScale<float>>& _write_persist_hist_msec;
   metrics::Histogram<metrics::LogScale<float>>& _commit_hist_msec;
   metrics::Histogram<metrics::LogScale<float>>& _append_hist_msec;
   metrics::Histogram<metrics::LogScale<float>>& _compaction_hist_msec;
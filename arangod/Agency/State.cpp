@@ -104,6 +104,36 @@ inline static std::string stringify(index_t index) {
   return i_str.str();
 }
 
+static void buildLogDocument(Builder& body, index_t index, term_t term,
+                             uint64_t millis, Slice entry,
+                             std::string const& clientId) {
+  VPackObjectBuilder b(&body);
+  body.add(StaticStrings::KeyString, Value(stringify(index)));
+  body.add("term", Value(term));
+  body.add("request", entry);
+  body.add("clientId", Value(clientId));
+  body.add("timestamp", Value(timestamp(millis)));
+  body.add("epoch_millis", Value(millis));
+}
+
+// verbose logging for all agency operations
+// there are two different log levels in use here for the AGENCYSTORE topic
+// - DEBUG: will log writes only on the leader
+// - TRACE: will log writes on both leaders and followers
+// the default log level for the AGENCYSTORE topic is WARN
+static void logOperation(index_t index, term_t term, Slice entry,
+                         std::string const& clientId, bool leading) {
+  if (leading) {
+    LOG_TOPIC("b578f", DEBUG, Logger::AGENCYSTORE)
+        << "leader: true, client: " << clientId << ", index: " << index
+        << ", term: " << term << ", data: " << entry.toJson();
+  } else {
+    LOG_TOPIC("f586f", TRACE, Logger::AGENCYSTORE)
+        << "leader: false, client: " << clientId << ", index: " << index
+        << ", term: " << term << ", data: " << entry.toJson();
+  }
+}
+
 /// Persist one entry
 bool State::persist(index_t index, term_t term, uint64_t millis,
                     arangodb::velocypack::Slice const& entry,
@@ -115,15 +145,7 @@ bool State::persist(index_t index, term_t term, uint64_t millis,
       << " entry: " << entry.toJson();
 
   Builder body;
-  {
-    VPackObjectBuilder b(&body);
-    body.add(StaticStrings::KeyString, Value(stringify(index)));
-    body.add("term", Value(term));
-    body.add("request", entry);
-    body.add("clientId", Value(clientId));
-    body.add("timestamp", Value(timestamp(millis)));
-    body.add("epoch_millis", Value(millis));
-  }
+  buildLogDocument(body, index, term, millis, entry, clientId);
 
   TRI_ASSERT(_vocbase != nullptr);
   transaction::StandaloneContext ctx(*_vocbase);
@@ -156,6 +178,58 @@ bool State::persist(index_t index, term_t term, uint64_t millis,
   return res.ok();
 }
 
+/// Persist several entries in one transaction, so they are committed (and
+/// synced) together
+bool State::persistBatch(std::vector<PendingEntry> const& entries) const {
+  TRI_IF_FAILURE("State::persist") { return true; }
+  TRI_ASSERT(!entries.empty());
+
+  Builder body;
+  {
+    VPackArrayBuilder a(&body);
+    for (auto const& e : entries) {
+      LOG_TOPIC("d07c4", TRACE, Logger::AGENCY)
+          << "persist index=" << e.index << " term=" << e.term
+          << " entry: " << e.entry.toJson();
+      buildLogDocument(body, e.index, e.term, e.millis, e.entry, e.clientId);
+    }
+  }
+
+  TRI_ASSERT(_vocbase != nullptr);
+  transaction::StandaloneContext ctx(*_vocbase);
+  SingleCollectionTransaction trx(
+      std::shared_ptr<transaction::Context>(
+          std::shared_ptr<transaction::Context>(), &ctx),
+      "log", AccessMode::Type::WRITE);
+
+  Result res = trx.begin();
+
+  if (!res.ok()) {
+    THROW_ARANGO_EXCEPTION(res);
+  }
+
+  try {
+    OperationResult result = trx.insert("log", body.slice(), _options);
+    if (result.ok() && !result.countErrorCodes.empty()) {
+      // at least one of the documents could not be inserted
+      res.reset(result.countErrorCodes.begin()->first);
+    } else {
+      res = result.result;
+    }
+    res = trx.finish(res);
+  } catch (std::exception const& e) {
+    LOG_TOPIC("1c9b3", ERR, Logger::AGENCY)
+        << "Failed to persist log entries:" << e.what();
+    return false;
+  }
+
+  LOG_TOPIC("8f2a6", TRACE, Logger::AGENCY)
+      << "persist done for " << entries.size() << " entries from index "
+      << entries.front().index << " ok:" << res.ok();
+
+  return res.ok();
+}
+
 bool State::persistConf(index_t index, term_t term, uint64_t millis,
                         arangodb::velocypack::Slice const& entry,
                         std::string const& clientId) const {
@@ -273,6 +347,10 @@ std::vector<index_t> State::logLeaderMulti(
 
   TRI_ASSERT(!_log.empty());  // log must never be empty
 
+  // all entries up to the next reconfiguration are persisted together
+  std::vector<PendingEntry> pending;
+  index_t nextIndex = _log.back().index + 1;
+
   size_t j = 0;
   for (auto const& i : VPackArrayIterator(transactions)) {
     if (!i.isArray()) {
@@ -288,15 +366,24 @@ std::vector<index_t> State::logLeaderMulti(
       TRI_ASSERT(transaction.isObject());
       TRI_ASSERT(transaction.length() > 0);
       size_t pos = transaction.keyAt(0).copyString().find(RECONFIGURE);
-
-      idx[j] = logNonBlocking(
-          _log.back().index + 1, i[0], term,
+      uint64_t millis =
           duration_cast<milliseconds>(system_clock::now().time_since_epoch())
-              .count(),
-          clientId, true, pos == 0 || pos == 1);
+              .count();
+
+      if (pos == 0 || pos == 1) {
+        logBatchNonBlocking(pending, true);
+        idx[j] = logNonBlocking(nextIndex, i[0], term, millis, clientId, true,
+                                true);
+      } else {
+        idx[j] = nextIndex;
+        pending.emplace_back(
+            PendingEntry{nextIndex, term, millis, i[0], std::move(clientId)});
+      }
+      ++nextIndex;
     }
     ++j;
   }
+  logBatchNonBlocking(pending, true);
 
   return idx;
 }
@@ -316,20 +403,7 @@ index_t State::logLeaderSingle(arangodb::velocypack::Slice slice, term_t term,
 index_t State::logNonBlocking(index_t idx, velocypack::Slice slice, term_t term,
                               uint64_t millis, std::string const& clientId,
                               bool leading, bool reconfiguration) {
-  // verbose logging for all agency operations
-  // there are two different log levels in use here for the AGENCYSTORE topic
-  // - DEBUG: will log writes only on the leader
-  // - TRACE: will log writes on both leaders and followers
-  // the default log level for the AGENCYSTORE topic is WARN
-  if (leading) {
-    LOG_TOPIC("b578f", DEBUG, Logger::AGENCYSTORE)
-        << "leader: true, client: " << clientId << ", index: " << idx
-        << ", term: " << term << ", data: " << slice.toJson();
-  } else {
-    LOG_TOPIC("f586f", TRACE, Logger::AGENCYSTORE)
-        << "leader: false, client: " << clientId << ", index: " << idx
-        << ", term: " << term << ", data: " << slice.toJson();
-  }
+  logOperation(idx, term, slice, clientId, leading);
 
   bool success = reconfiguration
                      ? persistConf(idx, term, millis, slice, clientId)
@@ -350,6 +424,32 @@ index_t State::logNonBlocking(index_t idx, velocypack::Slice slice, term_t term,
   return _log.back().index;
 }
 
+void State::logBatchNonBlocking(std::vector<PendingEntry>& entries,
+                                bool leading) {
+  if (entries.empty()) {
+    return;
+  }
+
+  for (auto const& e : entries) {
+    logOperation(e.index, e.term, e.entry, e.clientId, leading);
+  }
+
+  if (!persistBatch(entries)) {  // log to disk or die
+    LOG_TOPIC("4e8b1", FATAL, Logger::AGENCY)
+        << "RAFT member fails to persist log entries!";
+    FATAL_ERROR_EXIT();
+  }
+
+  for (auto& e : entries) {
+    auto byteSize = e.entry.byteSize();
+    auto buf = std::make_shared<Buffer<uint8_t>>(byteSize);
+    buf->append(e.entry.begin(), byteSize);
+    logEmplaceBackNoLock(
+        log_t(e.index, e.term, std::move(buf), e.clientId, e.millis));
+  }
+  entries.clear();
+}
+
 void State::logEmplaceBackNoLock(log_t&& l) {
   if (!l.clientId.empty()) {
     try {
@@ -448,6 +548,9 @@ index_t State::logFollower(VPackSlice transactions) {
   if (nqs > ndups) {
     TRI_ASSERT(transactions.isArray());
 
+    // all entries up to the next reconfiguration are persisted together
+    std::vector<PendingEntry> pending;
+
     for (size_t i = ndups; i < nqs; ++i) {
       VPackSlice slice = transactions[i];
 
@@ -473,11 +576,18 @@ index_t State::logFollower(VPackSlice transactions) {
       bool reconfiguration = query.keyAt(0).isEqualString(RECONFIGURE);
 
       // first to disk
-      if (logNonBlocking(index, query, term, tstamp, clientId, false,
-                         reconfiguration) == 0) {
-        break;
+      if (reconfiguration) {
+        logBatchNonBlocking(pending, false);
+        if (logNonBlocking(index, query, term, tstamp, clientId, false,
+                           true) == 0) {
+          break;
+        }
+      } else {
+        pending.emplace_back(
+            PendingEntry{index, term, tstamp, query, std::move(clientId)});
       }
     }
+    logBatchNonBlocking(pending, false);
   }
   return _log.back().index;  // never empty
 }
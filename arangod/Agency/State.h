@@ -242,10 +242,27 @@ class State {
                          std::string const& clientId = std::string(),
                          bool leading = false, bool reconfiguration = false);
 
+  /// @brief A log entry waiting to be persisted together with others
+  struct PendingEntry {
+    index_t index;
+    term_t term;
+    uint64_t millis;
+    velocypack::Slice entry;
+    std::string clientId;
+  };
+
+  /// @brief Log several log entries, persisting them in a single
+  /// transaction. None of them must be a reconfiguration. Must be guarded by
+  /// caller. Clears entries.
+  void logBatchNonBlocking(std::vector<PendingEntry>& entries, bool leading);
+
   /// @brief Save currentTerm, votedFor, log entries
   bool persist(index_t, term_t, uint64_t, arangodb::velocypack::Slice const&,
                std::string const&) const;
 
+  /// @brief Save several log entries in a single transaction
+  bool persistBatch(std::vector<PendingEntry> const& entries) const;
+
   /// @brief Save currentTerm, votedFor, log entries for reconfiguration
   bool persistConf(index_t, term_t, uint64_t,
                    arangodb::velocypack::Slice const&,
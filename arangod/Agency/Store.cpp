@@ -448,9 +448,13 @@ std::vector<bool> Store::readMultiple(VPackSlice queries,
                                       Builder& result) const {
   std::vector<bool> success;
   if (queries.isArray()) {
+    std::unique_lock storeLocker{_storeLock};
+    auto readNode = _node;  // Freeze KV-Store once for all queries
+    storeLocker.unlock();
+
     VPackArrayBuilder r(&result);
     for (auto const& query : VPackArrayIterator(queries)) {
-      success.push_back(read(query, result));
+      success.push_back(read(readNode, query, result));
     }
   } else {
     LOG_TOPIC("fec72", ERR, Logger::AGENCY)
@@ -499,6 +503,15 @@ NodePtr readQueries(NodePtr const& root,
 
 /// Read single query into ret
 bool Store::read(VPackSlice query, Builder& ret) const {
+  std::unique_lock storeLocker{_storeLock};
+  auto readNode = _node;  // Freeze KV-Store for shared_ptr copy
+  storeLocker.unlock();
+
+  return read(readNode, query, ret);
+}
+
+/// Read single query from root into ret
+bool Store::read(NodePtr const& root, VPackSlice query, Builder& ret) {
   bool success = true;
   bool showHidden = false;
 
@@ -532,11 +545,7 @@ bool Store::read(VPackSlice query, Builder& ret) const {
   //   a fast path for exactly one path, in which we do not have to copy all
   //   a slow path for more than one path
 
-  std::unique_lock storeLocker{_storeLock};
-  auto readNode = _node;  // Freeze KV-Store for shared_ptr copy
-  storeLocker.unlock();
-
-  NodePtr node = readQueries(readNode, query_strs);
+  NodePtr node = readQueries(root, query_strs);
   // Into result builder
   node->toBuilder(ret, showHidden);
   return success;
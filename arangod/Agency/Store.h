@@ -167,6 +167,11 @@ class Store {
   void registerPrefixTrigger(std::string const& prefix, AgencyTriggerCallback);
 
  private:
+  /// @brief Read individual entry specified in slice from root into builder
+  static bool read(std::shared_ptr<Node const> const& root,
+                   arangodb::velocypack::Slice query,
+                   arangodb::velocypack::Builder& result);
+
   /// @brief Apply single slice
   bool applies(arangodb::velocypack::Slice const&);
 
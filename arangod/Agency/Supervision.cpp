@@ -40,6 +40,7 @@
 #include "Basics/StaticStrings.h"
 #include "Basics/StringUtils.h"
 #include "Basics/overload.h"
+#include "Containers/FlatHashSet.h"
 #include "Cluster/ClusterHelpers.h"
 #include "Cluster/ServerState.h"
 #include "Metrics/CounterBuilder.h"
@@ -3134,8 +3135,12 @@ void arangodb::consensus::enforceReplicationFunctional(
   // the function:
   int const maxNrAddRemoveJobsInTodo = 50;
 
+  // While at it, collect the shards which already have an addFollower,
+  // removeFollower or moveShard job in ToDo, so that we do not have to
+  // scan ToDo again for every shard below.
   auto const& todos = *snapshot.hasAsChildren(toDoPrefix);
   int nrAddRemoveJobsInTodo = 0;
+  containers::FlatHashSet<std::string> shardsWithJobsInTodo;
   for (auto it = todos.begin(); it != todos.end(); ++it) {
     auto jobNode = (it->second);
     auto t = jobNode->hasAsString("type");
@@ -3144,8 +3149,18 @@ void arangodb::consensus::enforceReplicationFunctional(
         return;
       }
     }
+    if (t && (t.value() == "addFollower" || t.value() == "removeFollower" ||
+              t.value() == "moveShard")) {
+      if (auto s = jobNode->hasAsString("shard"); s) {
+        shardsWithJobsInTodo.emplace(s.value());
+      }
+    }
   }
 
+  // number of servers a satellite collection is distributed to. the same
+  // for all satellite collections, so it is only computed once
+  std::optional<size_t> satelliteReplicationFactor;
+
   // We will loop over plannedDBs, so we use hasAsChildren
   auto const& plannedDBs = *snapshot.hasAsChildren(planColPrefix);
   auto const& databaseProperties = *snapshot.hasAsChildren("/Plan/Databases");
@@ -3167,9 +3182,12 @@ void arangodb::consensus::enforceReplicationFunctional(
         auto replFact2 = col.hasAsString(StaticStrings::ReplicationFactor);
         if (replFact2 && replFact2.value() == StaticStrings::Satellite) {
           // satellites => distribute to every server
-          auto available = Job::availableServers(snapshot);
-          replicationFactor =
-              Job::countGoodOrBadServersInList(snapshot, available);
+          if (!satelliteReplicationFactor.has_value()) {
+            auto available = Job::availableServers(snapshot);
+            satelliteReplicationFactor =
+                Job::countGoodOrBadServersInList(snapshot, available);
+          }
+          replicationFactor = *satelliteReplicationFactor;
         } else {
           LOG_TOPIC("d3b54", DEBUG, Logger::SUPERVISION)
               << "no replicationFactor entry in " << col.toJson();
@@ -3210,24 +3228,15 @@ void arangodb::consensus::enforceReplicationFunctional(
               apparentReplicationFactor != replicationFactor) {
             // Check that there is not yet an addFollower or removeFollower
             // or moveShard job in ToDo for this shard:
-            auto const& todo = *snapshot.hasAsChildren(toDoPrefix);
             bool found = false;
-            for (auto const& pair : todo) {
-              auto const& job = pair.second;
-              auto tmp_type = job->hasAsString("type");
-              auto tmp_shard = job->hasAsString("shard");
-              if ((tmp_type == "addFollower" || tmp_type == "removeFollower" ||
-                   tmp_type == "moveShard") &&
-                  tmp_shard == shard_.first) {
-                found = true;
-                LOG_TOPIC("441b6", DEBUG, Logger::SUPERVISION)
-                    << "already found "
-                       "addFollower or removeFollower job in ToDo, not "
-                       "scheduling "
-                       "again for shard "
-                    << shard_.first;
-                break;
-              }
+            if (shardsWithJobsInTodo.contains(std::string_view{shard_.first})) {
+              found = true;
+              LOG_TOPIC("441b6", DEBUG, Logger::SUPERVISION)
+                  << "already found "
+                     "addFollower or removeFollower job in ToDo, not "
+                     "scheduling "
+                     "again for shard "
+                  << shard_.first;
             }
             // Check that shard is not locked:
             if (snapshot.has(blockedShardsPrefix + shard_.first)) {
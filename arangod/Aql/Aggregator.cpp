@@ -36,6 +36,8 @@
 #include <velocypack/Iterator.h>
 #include <velocypack/Slice.h>
 
+#include <cmath>
+#include <deque>
 #include <set>
 
 using namespace arangodb;
@@ -50,6 +52,34 @@ constexpr bool doesNotRequireInput = false;
 constexpr bool official = true;
 constexpr bool internalOnly = false;
 
+/// @brief running sum using Neumaier's compensated summation. this keeps
+/// the rounding error independent of the number of values, so that values
+/// can also be subtracted again without the result drifting away from the
+/// sum of the remaining values
+struct CompensatedSum {
+  void reset() noexcept {
+    sum = 0.0;
+    compensation = 0.0;
+  }
+
+  void add(double v) noexcept {
+    double const t = sum + v;
+    if (std::abs(sum) >= std::abs(v)) {
+      compensation += (sum - t) + v;
+    } else {
+      compensation += (v - t) + sum;
+    }
+    sum = t;
+  }
+
+  bool isFinite() const noexcept { return std::isfinite(sum); }
+
+  double value() const noexcept { return sum + compensation; }
+
+  double sum = 0.0;
+  double compensation = 0.0;
+};
+
 /// @brief struct containing aggregator meta information
 struct AggregatorInfo {
   /// @brief factory to create a new aggregator instance in a query
@@ -88,7 +118,7 @@ class MemoryBlockAllocator {
  public:
   /// @brief create a temporary storage instance
   explicit MemoryBlockAllocator(size_t blockSize)
-      : blockSize(blockSize), current(nullptr), end(nullptr) {}
+      : blockSize(blockSize), current(nullptr), end(nullptr), allocated(0) {}
 
   /// @brief destroy a temporary storage instance
   ~MemoryBlockAllocator() { clear(); }
@@ -100,8 +130,12 @@ class MemoryBlockAllocator {
     blocks.clear();
     current = nullptr;
     end = nullptr;
+    allocated = 0;
   }
 
+  /// @brief total size of all allocated blocks
+  size_t memoryUsage() const noexcept { return allocated; }
+
   /// @brief register a short data value
   char* store(char const* p, size_t length) {
     if (current == nullptr || (current + length > end)) {
@@ -133,6 +167,7 @@ class MemoryBlockAllocator {
     }
     current = buffer;
     end = current + length;
+    allocated += length;
   }
 
   /// @brief already allocated blocks
@@ -146,6 +181,9 @@ class MemoryBlockAllocator {
 
   /// @brief end of current block
   char* end;
+
+  /// @brief total size of all allocated blocks
+  size_t allocated;
 };
 
 /// @brief aggregator for LENGTH()
@@ -159,6 +197,14 @@ struct AggregatorLength final : public Aggregator {
 
   void reduce(AqlValue const&) override { ++count; }
 
+  bool supportsRemoval() const noexcept override { return true; }
+
+  bool remove(AqlValue const&) override {
+    TRI_ASSERT(count > 0);
+    --count;
+    return true;
+  }
+
   AqlValue get() const override {
     uint64_t value = count;
     return AqlValue(AqlValueHintUInt(value));
@@ -171,11 +217,31 @@ struct AggregatorMin final : public Aggregator {
   explicit AggregatorMin(velocypack::Options const* opts)
       : Aggregator(opts), value() {}
 
-  ~AggregatorMin() { value.destroy(); }
+  ~AggregatorMin() {
+    value.destroy();
+    clearCandidates();
+  }
 
-  void reset() override { value.erase(); }
+  void reset() override {
+    value.erase();
+    clearCandidates();
+  }
 
   void reduce(AqlValue const& cmpValue) override {
+    if (removal) {
+      if (!cmpValue.isNull(true)) {
+        // values greater than the new one cannot become the minimum anymore,
+        // as they will be removed before it
+        while (!candidates.empty() &&
+               AqlValue::Compare(_vpackOptions, candidates.back(), cmpValue,
+                                 true) > 0) {
+          candidates.back().destroy();
+          candidates.pop_back();
+        }
+        candidates.emplace_back(cmpValue.clone());
+      }
+      return;
+    }
     if (!cmpValue.isNull(true) &&
         (value.isEmpty() ||
          AqlValue::Compare(_vpackOptions, value, cmpValue, true) > 0)) {
@@ -186,25 +252,86 @@ struct AggregatorMin final : public Aggregator {
     }
   }
 
+  bool supportsRemoval() const noexcept override { return true; }
+
+  void enableRemoval() override {
+    TRI_ASSERT(value.isEmpty() && candidates.empty());
+    removal = true;
+  }
+
+  bool remove(AqlValue const& cmpValue) override {
+    TRI_ASSERT(removal);
+    // values are removed in the order they were added. so the value is
+    // either the oldest candidate, or it was dropped by reduce() already
+    if (!cmpValue.isNull(true) && !candidates.empty() &&
+        AqlValue::Compare(_vpackOptions, candidates.front(), cmpValue, true) ==
+            0) {
+      candidates.front().destroy();
+      candidates.pop_front();
+    }
+    return true;
+  }
+
   AqlValue get() const override {
+    if (removal) {
+      if (candidates.empty()) {
+        return AqlValue(AqlValueHintNull());
+      }
+      return candidates.front().clone();
+    }
     if (value.isEmpty()) {
       return AqlValue(AqlValueHintNull());
     }
     return value.clone();
   }
 
+  std::size_t memoryUsage() const noexcept override {
+    // the memory of the candidates' values themselves is not counted, to
+    // keep this cheap
+    return value.memoryUsage() + candidates.size() * sizeof(AqlValue);
+  }
+
+  void clearCandidates() noexcept {
+    for (auto& c : candidates) {
+      c.destroy();
+    }
+    candidates.clear();
+  }
+
   AqlValue value;
+  /// @brief only used if removal is enabled: the values that can still become
+  /// the minimum, in the order they were added. the first one is the minimum
+  std::deque<AqlValue> candidates;
+  bool removal = false;
 };
 
 struct AggregatorMax final : public Aggregator {
   explicit AggregatorMax(velocypack::Options const* opts)
       : Aggregator(opts), value() {}
 
-  ~AggregatorMax() { value.destroy(); }
+  ~AggregatorMax() {
+    value.destroy();
+    clearCandidates();
+  }
 
-  void reset() override { value.erase(); }
+  void reset() override {
+    value.erase();
+    clearCandidates();
+  }
 
   void reduce(AqlValue const& cmpValue) override {
+    if (removal) {
+      // values less than the new one cannot become the maximum anymore, as
+      // they will be removed before it
+      while (!candidates.empty() &&
+             AqlValue::Compare(_vpackOptions, candidates.back(), cmpValue,
+                               true) < 0) {
+        candidates.back().destroy();
+        candidates.pop_back();
+      }
+      candidates.emplace_back(cmpValue.clone());
+      return;
+    }
     if (value.isEmpty() ||
         AqlValue::Compare(_vpackOptions, value, cmpValue, true) < 0) {
       value.destroy();
@@ -212,22 +339,65 @@ struct AggregatorMax final : public Aggregator {
     }
   }
 
+  bool supportsRemoval() const noexcept override { return true; }
+
+  void enableRemoval() override {
+    TRI_ASSERT(value.isEmpty() && candidates.empty());
+    removal = true;
+  }
+
+  bool remove(AqlValue const& cmpValue) override {
+    TRI_ASSERT(removal);
+    // values are removed in the order they were added. so the value is
+    // either the oldest candidate, or it was dropped by reduce() already
+    if (!candidates.empty() &&
+        AqlValue::Compare(_vpackOptions, candidates.front(), cmpValue, true) ==
+            0) {
+      candidates.front().destroy();
+      candidates.pop_front();
+    }
+    return true;
+  }
+
   AqlValue get() const override {
+    if (removal) {
+      if (candidates.empty()) {
+        return AqlValue(AqlValueHintNull());
+      }
+      return candidates.front().clone();
+    }
     if (value.isEmpty()) {
       return AqlValue(AqlValueHintNull());
     }
     return value.clone();
   }
 
+  std::size_t memoryUsage() const noexcept override {
+    // the memory of the candidates' values themselves is not counted, to
+    // keep this cheap
+    return value.memoryUsage() + candidates.size() * sizeof(AqlValue);
+  }
+
+  void clearCandidates() noexcept {
+    for (auto& c : candidates) {
+      c.destroy();
+    }
+    candidates.clear();
+  }
+
   AqlValue value;
+  /// @brief only used if removal is enabled: the values that can still become
+  /// the maximum, in the order they were added. the first one is the maximum
+  std::deque<AqlValue> candidates;
+  bool removal = false;
 };
 
 struct AggregatorSum final : public Aggregator {
   explicit AggregatorSum(velocypack::Options const* opts)
-      : Aggregator(opts), sum(0.0), invalid(false), invoked(false) {}
+      : Aggregator(opts), invalid(false), invoked(false) {}
 
   void reset() override {
-    sum = 0.0;
+    sum.reset();
     invalid = false;
     invoked = false;
   }
@@ -242,7 +412,7 @@ struct AggregatorSum final : public Aggregator {
       if (cmpValue.isNumber()) {
         double const number = cmpValue.toDouble();
         if (!std::isnan(number) && number != HUGE_VAL && number != -HUGE_VAL) {
-          sum += number;
+          sum.add(number);
           return;
         }
       }
@@ -250,17 +420,31 @@ struct AggregatorSum final : public Aggregator {
     }
   }
 
+  bool supportsRemoval() const noexcept override { return true; }
+
+  bool remove(AqlValue const& cmpValue) override {
+    if (invalid || !sum.isFinite()) {
+      // an overflowed sum cannot be restored by subtracting values
+      return false;
+    }
+    if (!cmpValue.isNull(true)) {
+      TRI_ASSERT(cmpValue.isNumber());
+      sum.add(-cmpValue.toDouble());
+    }
+    return true;
+  }
+
   AqlValue get() const override {
-    if (invalid || !invoked || std::isnan(sum) || sum == HUGE_VAL ||
-        sum == -HUGE_VAL) {
+    double v = sum.value();
+    if (invalid || !invoked || std::isnan(v) || v == HUGE_VAL ||
+        v == -HUGE_VAL) {
       return AqlValue(AqlValueHintNull());
     }
 
-    double v = sum;
     return AqlValue(AqlValueHintDouble(v));
   }
 
-  double sum;
+  CompensatedSum sum;
   bool invalid;
   bool invoked;
 };
@@ -268,11 +452,11 @@ struct AggregatorSum final : public Aggregator {
 /// @brief the single-server variant of AVERAGE
 struct AggregatorAverage : public Aggregator {
   explicit AggregatorAverage(velocypack::Options const* opts)
-      : Aggregator(opts), count(0), sum(0.0), invalid(false) {}
+      : Aggregator(opts), count(0), invalid(false) {}
 
   void reset() override final {
     count = 0;
-    sum = 0.0;
+    sum.reset();
     invalid = false;
   }
 
@@ -285,7 +469,7 @@ struct AggregatorAverage : public Aggregator {
       if (cmpValue.isNumber()) {
         double const number = cmpValue.toDouble();
         if (!std::isnan(number) && number != HUGE_VAL && number != -HUGE_VAL) {
-          sum += number;
+          sum.add(number);
           ++count;
           return;
         }
@@ -294,20 +478,37 @@ struct AggregatorAverage : public Aggregator {
     }
   }
 
+  bool supportsRemoval() const noexcept override { return true; }
+
+  bool remove(AqlValue const& cmpValue) override {
+    if (invalid || !sum.isFinite()) {
+      // an overflowed sum cannot be restored by subtracting values
+      return false;
+    }
+    if (!cmpValue.isNull(true)) {
+      TRI_ASSERT(cmpValue.isNumber());
+      TRI_ASSERT(count > 0);
+      sum.add(-cmpValue.toDouble());
+      --count;
+    }
+    return true;
+  }
+
   virtual AqlValue get() const override {
-    if (invalid || count == 0 || std::isnan(sum) || sum == HUGE_VAL ||
-        sum == -HUGE_VAL) {
+    double const total = sum.value();
+    if (invalid || count == 0 || std::isnan(total) || total == HUGE_VAL ||
+        total == -HUGE_VAL) {
       return AqlValue(AqlValueHintNull());
     }
 
     TRI_ASSERT(count > 0);
 
-    double v = sum / count;
+    double v = total / count;
     return AqlValue(AqlValueHintDouble(v));
   }
 
   uint64_t count;
-  double sum;
+  CompensatedSum sum;
   bool invalid;
 };
 
@@ -320,13 +521,14 @@ struct AggregatorAverageStep1 final : public AggregatorAverage {
   AqlValue get() const override {
     builder.clear();
     builder.openArray();
-    if (invalid || count == 0 || std::isnan(sum) || sum == HUGE_VAL ||
-        sum == -HUGE_VAL) {
+    double const total = sum.value();
+    if (invalid || count == 0 || std::isnan(total) || total == HUGE_VAL ||
+        total == -HUGE_VAL) {
       builder.add(VPackValue(VPackValueType::Null));
       builder.add(VPackValue(VPackValueType::Null));
     } else {
       TRI_ASSERT(count > 0);
-      builder.add(VPackValue(sum));
+      builder.add(VPackValue(total));
       builder.add(VPackValue(count));
     }
     builder.close();
@@ -342,6 +544,10 @@ struct AggregatorAverageStep2 final : public AggregatorAverage {
   explicit AggregatorAverageStep2(velocypack::Options const* opts)
       : AggregatorAverage(opts) {}
 
+  bool supportsRemoval() const noexcept override { return false; }
+
+  bool remove(AqlValue const&) override { return false; }
+
   void reduce(AqlValue const& cmpValue) override {
     if (!cmpValue.isArray()) {
       invalid = true;
@@ -363,7 +569,7 @@ struct AggregatorAverageStep2 final : public AggregatorAverage {
       invalid = true;
       return;
     }
-    sum += v;
+    sum.add(v);
     count += countValue.toInt64();
   }
 };
@@ -644,6 +850,11 @@ struct AggregatorUnique : public Aggregator {
     return AqlValue(builder.slice());
   }
 
+  std::size_t memoryUsage() const noexcept override final {
+    return allocator.memoryUsage() + seen.capacity() * sizeof(VPackSlice) +
+           builder.bufferRef().capacity();
+  }
+
   MemoryBlockAllocator allocator;
   containers::FlatHashSet<velocypack::Slice,
                           basics::VelocyPackHelper::VPackHash,
@@ -669,7 +880,7 @@ struct AggregatorUniqueStep2 final : public AggregatorUnique {
     for (VPackSlice it : VPackArrayIterator(s)) {
       if (seen.contains(it)) {
         // already saw the same value
-        return;
+        continue;
       }
 
       char* pos = allocator.store(it.startAs<char>(), it.byteSize());
@@ -722,6 +933,13 @@ struct AggregatorSortedUnique : public Aggregator {
     return AqlValue(builder.slice());
   }
 
+  std::size_t memoryUsage() const noexcept override final {
+    // a node of the set holds the slice and three pointers, plus a color
+    return allocator.memoryUsage() +
+           seen.size() * (sizeof(VPackSlice) + 4 * sizeof(void*)) +
+           builder.bufferRef().capacity();
+  }
+
   MemoryBlockAllocator allocator;
   std::set<velocypack::Slice, basics::VelocyPackHelper::VPackLess<true>> seen;
   mutable arangodb::velocypack::Builder builder;
@@ -744,7 +962,7 @@ struct AggregatorSortedUniqueStep2 final : public AggregatorSortedUnique {
     for (VPackSlice it : VPackArrayIterator(s)) {
       if (seen.find(it) != seen.end()) {
         // already saw the same value
-        return;
+        continue;
       }
 
       char* pos = allocator.store(it.startAs<char>(), it.byteSize());
@@ -787,6 +1005,10 @@ struct AggregatorCountDistinct : public Aggregator {
     return AqlValue(AqlValueHintUInt(value));
   }
 
+  std::size_t memoryUsage() const noexcept override final {
+    return allocator.memoryUsage() + seen.capacity() * sizeof(VPackSlice);
+  }
+
   MemoryBlockAllocator allocator;
   containers::FlatHashSet<velocypack::Slice,
                           basics::VelocyPackHelper::VPackHash,
@@ -839,9 +1061,9 @@ struct AggregatorCountDistinctStep2 final : public AggregatorCountDistinct {
     }
 
     for (VPackSlice it : VPackArrayIterator(s)) {
-      if (seen.find(s) != seen.end()) {
+      if (seen.contains(it)) {
         // already saw the same value
-        return;
+        continue;
       }
 
       char* pos = allocator.store(it.startAs<char>(), it.byteSize());
@@ -850,6 +1072,65 @@ struct AggregatorCountDistinctStep2 final : public AggregatorCountDistinct {
   }
 };
 
+/// @brief the DB server variant of COLLECT ... INTO var = expr, which
+/// collects all values of a group into an array
+struct AggregatorPushStep1 : public Aggregator {
+  explicit AggregatorPushStep1(velocypack::Options const* opts)
+      : Aggregator(opts) {}
+
+  // cppcheck-suppress virtualCallInConstructor
+  void reset() override final { builder.clear(); }
+
+  void reduce(AqlValue const& cmpValue) override {
+    if (builder.isClosed()) {
+      builder.openArray();
+    }
+    cmpValue.toVelocyPack(_vpackOptions, builder, /*resolveExternals*/ true,
+                          /*allowUnindexed*/ false);
+  }
+
+  AqlValue get() const override final {
+    // if not yet an array, start one
+    if (builder.isClosed()) {
+      builder.openArray();
+    }
+
+    // always close the Builder
+    builder.close();
+    return AqlValue(builder.slice());
+  }
+
+  std::size_t memoryUsage() const noexcept override final {
+    return builder.bufferRef().capacity();
+  }
+
+  mutable arangodb::velocypack::Builder builder;
+};
+
+/// @brief the coordinator variant of COLLECT ... INTO var = expr, which
+/// concatenates the arrays of the DB servers
+struct AggregatorPushStep2 final : public AggregatorPushStep1 {
+  explicit AggregatorPushStep2(velocypack::Options const* opts)
+      : AggregatorPushStep1(opts) {}
+
+  void reduce(AqlValue const& cmpValue) override final {
+    AqlValueMaterializer materializer(_vpackOptions);
+
+    VPackSlice s = materializer.slice(cmpValue, true);
+
+    if (!s.isArray()) {
+      return;
+    }
+
+    if (builder.isClosed()) {
+      builder.openArray();
+    }
+    for (VPackSlice it : VPackArrayIterator(s)) {
+      builder.add(it);
+    }
+  }
+};
+
 struct BitFunctionAnd {
   uint64_t compute(uint64_t value1, uint64_t value2) noexcept {
     return value1 & value2;
@@ -1024,6 +1305,12 @@ std::unordered_map<std::string_view, AggregatorInfo> const aggregators = {
     {"COUNT_DISTINCT_STEP2",
      {std::make_shared<GenericFactory<AggregatorCountDistinctStep2>>(),
       doesRequireInput, internalOnly, "", "COUNT_DISTINCT_STEP2"}},
+    {"PUSH_STEP1",
+     {std::make_shared<GenericFactory<AggregatorPushStep1>>(),
+      doesRequireInput, internalOnly, "", "PUSH_STEP1"}},
+    {"PUSH_STEP2",
+     {std::make_shared<GenericFactory<AggregatorPushStep2>>(),
+      doesRequireInput, internalOnly, "", "PUSH_STEP2"}},
     {"BIT_AND",
      {std::make_shared<GenericFactory<AggregatorBitAnd>>(), doesRequireInput,
       official, "BIT_AND", "BIT_AND"}},
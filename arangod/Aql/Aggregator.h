@@ -56,6 +56,26 @@ struct Aggregator {
   virtual void reset() = 0;
   virtual void reduce(AqlValue const&) = 0;
   virtual AqlValue get() const = 0;
+
+  /// @brief whether or not the aggregator implements remove()
+  virtual bool supportsRemoval() const noexcept { return false; }
+
+  /// @brief prepares the aggregator for calls to remove(). must be called
+  /// before the first value is passed to reduce(), and only if
+  /// supportsRemoval() returns true
+  virtual void enableRemoval() {}
+
+  /// @brief removes a value that was passed to reduce() before, so that the
+  /// aggregator can be used for sliding windows. values must be removed in
+  /// the order in which they were added. returns false if the value cannot
+  /// be removed (e.g. because the sum overflowed). in this case the caller
+  /// must reset the aggregator and reduce all remaining values again
+  virtual bool remove(AqlValue const&) { return false; }
+
+  /// @brief approximate memory allocated for the aggregator's state, in
+  /// addition to the aggregator's own size
+  virtual std::size_t memoryUsage() const noexcept { return 0; }
+
   AqlValue stealValue() {
     AqlValue r = this->get();
     this->reset();
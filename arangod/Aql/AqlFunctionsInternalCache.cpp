@@ -31,9 +31,93 @@
 #include <velocypack/Collection.h>
 #include <velocypack/Dumper.h>
 #include <velocypack/Iterator.h>
+#include <velocypack/Utf8Helper.h>
+
+#include <array>
+#include <mutex>
 
 using namespace arangodb::aql;
 
+namespace {
+
+/// @brief process-wide cache for compiled regex patterns. compiled
+/// icu::RegexPattern objects are immutable and can be shared by threads,
+/// in contrast to icu::RegexMatcher objects
+class SharedPatternCache {
+ public:
+  /// @brief maximum number of cached patterns
+  static constexpr std::size_t maxPatterns = 1024;
+
+  /// @brief returns the compiled pattern, or nullptr if the pattern is
+  /// invalid
+  std::shared_ptr<icu::RegexPattern const> get(std::string const& pattern) {
+    {
+      std::lock_guard guard(_mutex);
+      auto it = _patterns.find(pattern);
+      if (it != _patterns.end()) {
+        return it->second;
+      }
+    }
+
+    // compile outside of the lock. concurrent compilations of the same
+    // pattern are harmless
+    UErrorCode status = U_ZERO_ERROR;
+    UParseError parseError;
+    std::shared_ptr<icu::RegexPattern const> compiled(
+        icu::RegexPattern::compile(icu::UnicodeString::fromUTF8(pattern), 0,
+                                   parseError, status));
+    if (U_FAILURE(status)) {
+      compiled.reset();
+    }
+
+    std::lock_guard guard(_mutex);
+    if (_patterns.size() >= maxPatterns) {
+      // evict an arbitrary pattern. caches of running queries keep it alive
+      _patterns.erase(_patterns.begin());
+    }
+    return _patterns.try_emplace(pattern, std::move(compiled)).first->second;
+  }
+
+ private:
+  std::mutex _mutex;
+  std::unordered_map<std::string, std::shared_ptr<icu::RegexPattern const>>
+      _patterns;
+};
+
+SharedPatternCache sharedPatterns;
+
+/// @brief whether the value contains a line terminator other than \r and
+/// \n. a `.` in an ICU regex does not match these
+bool containsLineTerminator(std::string_view value) noexcept {
+  size_t const length = value.size();
+  for (size_t i = 0; i < length; ++i) {
+    auto c = static_cast<unsigned char>(value[i]);
+    if (c == 0x0b || c == 0x0c) {
+      return true;
+    }
+    if (c == 0xc2 && i + 1 < length &&
+        static_cast<unsigned char>(value[i + 1]) == 0x85) {
+      // U+0085
+      return true;
+    }
+    if (c == 0xe2 && i + 2 < length &&
+        static_cast<unsigned char>(value[i + 1]) == 0x80 &&
+        (static_cast<unsigned char>(value[i + 2]) == 0xa8 ||
+         static_cast<unsigned char>(value[i + 2]) == 0xa9)) {
+      // U+2028, U+2029
+      return true;
+    }
+  }
+  return false;
+}
+
+bool isValidUtf8(std::string_view value) noexcept {
+  return arangodb::velocypack::Utf8Helper::isValidUtf8(
+      reinterpret_cast<std::uint8_t const*>(value.data()), value.size());
+}
+
+}  // namespace
+
 AqlFunctionsInternalCache::~AqlFunctionsInternalCache() { clear(); }
 
 void AqlFunctionsInternalCache::clear() noexcept {
@@ -109,20 +193,26 @@ arangodb::ValidatorBase* AqlFunctionsInternalCache::buildValidator(
 /// @brief get matcher from cache, or insert a new matcher for the specified
 /// pattern
 icu::RegexMatcher* AqlFunctionsInternalCache::fromCache(
-    std::string const& pattern,
-    std::unordered_map<std::string, std::unique_ptr<icu::RegexMatcher>>&
-        cache) {
+    std::string const& pattern, MatcherCache& cache) {
   // insert into cache, no matter if pattern is valid or not
   auto matcherIter =
       cache
           .try_emplace(pattern, arangodb::lazyConstruct([&] {
-                         return std::unique_ptr<icu::RegexMatcher>(
-                             arangodb::basics::Utf8Helper::DefaultUtf8Helper
-                                 .buildMatcher(pattern));
+                         CachedMatcher cached;
+                         cached.pattern = ::sharedPatterns.get(pattern);
+                         if (cached.pattern != nullptr) {
+                           UErrorCode status = U_ZERO_ERROR;
+                           cached.matcher.reset(
+                               cached.pattern->matcher(status));
+                           if (U_FAILURE(status)) {
+                             cached.matcher.reset();
+                           }
+                         }
+                         return cached;
                        }))
           .first;
 
-  return matcherIter->second.get();
+  return matcherIter->second.matcher.get();
 }
 
 /// @brief compile a REGEX pattern from a string
@@ -205,6 +295,88 @@ void AqlFunctionsInternalCache::buildLikePattern(std::string& out,
   out.push_back('$');
 }
 
+std::optional<bool> AqlFunctionsInternalCache::matchLikePattern(
+    std::string_view expr, std::string_view value, std::string& buffer) {
+  // split the pattern at its % wildcards into literal segments, removing
+  // escape characters the same way as buildLikePattern() does
+  constexpr std::size_t maxSegments = 16;
+  std::array<std::size_t, maxSegments> segmentEnds;
+  std::size_t numSegments = 0;
+
+  buffer.clear();
+  bool escaped = false;
+  for (char c : expr) {
+    if (c == '\\') {
+      if (escaped) {
+        // literal backslash
+        buffer.push_back('\\');
+      }
+      escaped = !escaped;
+      continue;
+    }
+    if (!escaped) {
+      if (c == '_') {
+        // single character wildcard
+        return std::nullopt;
+      }
+      if (c == '%') {
+        if (numSegments == maxSegments - 1) {
+          return std::nullopt;
+        }
+        segmentEnds[numSegments++] = buffer.size();
+        continue;
+      }
+    } else if (c != '%' && c != '_' && c != '?' && c != '+' && c != '[' &&
+               c != '(' && c != ')' && c != '{' && c != '}' && c != '^' &&
+               c != '$' && c != '|' && c != '.' && c != '*') {
+      // found a backslash followed by no special character
+      buffer.push_back('\\');
+    }
+    buffer.push_back(c);
+    escaped = false;
+  }
+  segmentEnds[numSegments++] = buffer.size();
+
+  if (!::isValidUtf8(buffer) || !::isValidUtf8(value)) {
+    // ICU replaces invalid sequences
+    return std::nullopt;
+  }
+
+  std::string_view literals = buffer;
+  if (numSegments == 1) {
+    // no wildcards
+    return value == literals;
+  }
+
+  if (::containsLineTerminator(value)) {
+    return std::nullopt;
+  }
+
+  std::string_view first = literals.substr(0, segmentEnds[0]);
+  std::string_view last = literals.substr(segmentEnds[numSegments - 2]);
+  if (value.size() < first.size() + last.size() ||
+      value.substr(0, first.size()) != first ||
+      value.substr(value.size() - last.size()) != last) {
+    return false;
+  }
+
+  // find the other segments in order between the first and the last one.
+  // taking the leftmost match for every segment is sufficient, because only
+  // % wildcards are involved
+  std::string_view rest =
+      value.substr(first.size(), value.size() - first.size() - last.size());
+  for (std::size_t i = 1; i < numSegments - 1; ++i) {
+    std::string_view segment = literals.substr(
+        segmentEnds[i - 1], segmentEnds[i] - segmentEnds[i - 1]);
+    auto pos = rest.find(segment);
+    if (pos == std::string_view::npos) {
+      return false;
+    }
+    rest = rest.substr(pos + segment.size());
+  }
+  return true;
+}
+
 /// @brief inspect a LIKE pattern from a string, and remove all
 /// of its escape characters. will stop at the first wildcards found.
 /// returns a pair with the following meaning:
@@ -29,13 +29,15 @@
 
 #include <unicode/regex.h>
 #include <memory>
+#include <optional>
 #include <string_view>
 
 namespace arangodb {
 
 namespace aql {
 
-/// cache for parsed regexes, not thread safe
+/// cache for parsed regexes, not thread safe. the compiled patterns are
+/// shared process-wide, only the matchers are per instance
 class AqlFunctionsInternalCache final {
  public:
   AqlFunctionsInternalCache(AqlFunctionsInternalCache const&) = delete;
@@ -74,13 +76,28 @@ class AqlFunctionsInternalCache final {
   static std::pair<bool, bool> inspectLikePattern(std::string& out,
                                                   std::string_view expr);
 
+  /// @brief matches a value against a case-sensitive LIKE pattern with plain
+  /// string operations, without going through ICU. returns std::nullopt if
+  /// the pattern contains `_` wildcards or if the value contains characters
+  /// that need ICU semantics. in this case the caller must use the matcher
+  /// built by buildLikeMatcher(). buffer is used as scratch space.
+  static std::optional<bool> matchLikePattern(std::string_view expr,
+                                              std::string_view value,
+                                              std::string& buffer);
+
  private:
+  struct CachedMatcher {
+    /// @brief the compiled pattern, shared with other caches. must outlive
+    /// the matcher
+    std::shared_ptr<icu::RegexPattern const> pattern;
+    std::unique_ptr<icu::RegexMatcher> matcher;
+  };
+  using MatcherCache = std::unordered_map<std::string, CachedMatcher>;
+
   /// @brief get matcher from cache, or insert a new matcher for the specified
   /// pattern
-  icu::RegexMatcher* fromCache(
-      std::string const& pattern,
-      std::unordered_map<std::string, std::unique_ptr<icu::RegexMatcher>>&
-          cache);
+  icu::RegexMatcher* fromCache(std::string const& pattern,
+                               MatcherCache& cache);
 
   static void buildRegexPattern(std::string& out, std::string_view expr,
                                 bool caseInsensitive);
@@ -89,11 +106,9 @@ class AqlFunctionsInternalCache final {
 
  private:
   /// @brief cache for compiled regexes (REGEX function)
-  std::unordered_map<std::string, std::unique_ptr<icu::RegexMatcher>>
-      _regexCache;
+  MatcherCache _regexCache;
   /// @brief cache for compiled regexes (LIKE function)
-  std::unordered_map<std::string, std::unique_ptr<icu::RegexMatcher>>
-      _likeCache;
+  MatcherCache _likeCache;
   /// @brief cache for validators -- This is currently only used for JSONSchema
   /// validation.
   std::unordered_map<std::size_t, std::unique_ptr<arangodb::ValidatorBase>>
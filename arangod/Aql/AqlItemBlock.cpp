@@ -72,12 +72,34 @@ inline void copyValueOver(arangodb::containers::HashSet<void*>& cache,
 }
 }  // namespace
 
+template<typename F>
+void AqlItemBlock::forEachValueInRows(size_t fromRow, size_t toRow,
+                                      F&& callback) {
+  if (fromRow >= toRow) {
+    return;
+  }
+  if (_layout == Layout::ColumnMajor) {
+    for (RegisterId::value_t col = 0; col < _numRegisters; ++col) {
+      size_t const base = col * _columnStride;
+      for (size_t i = base + fromRow; i < base + toRow; ++i) {
+        callback(_data[i]);
+      }
+    }
+  } else {
+    size_t const end = toRow * _numRegisters;
+    for (size_t i = fromRow * _numRegisters; i < end; ++i) {
+      callback(_data[i]);
+    }
+  }
+}
+
 /// @brief create the block
 AqlItemBlock::AqlItemBlock(AqlItemBlockManager& manager, size_t numRows,
                            RegisterCount numRegisters)
     : _numRows(numRows),
       _numRegisters(numRegisters),
       _maxModifiedRowIndex(0),
+      _columnStride(numRows),
       _manager(manager),
       _refCount(0),
       _rowIndex(0),
@@ -307,9 +329,7 @@ void AqlItemBlock::destroy() noexcept {
       eraseAll();
     } else {
       size_t totalUsed = 0;
-      size_t const n = maxModifiedEntries();
-      for (size_t i = 0; i < n; i++) {
-        auto& it = _data[i];
+      forEachValueInRows(0, _maxModifiedRowIndex, [&](AqlValue& it) {
         if (it.requiresDestruction()) {
           auto it2 = _valueCount.find(it.data());
           if (it2 !=
@@ -321,13 +341,13 @@ void AqlItemBlock::destroy() noexcept {
               totalUsed += valueInfo.memoryUsage;
               it.destroy();
               // destroy() calls erase, so no need to call erase() again later
-              continue;
+              return;
             }
           }
         }
         // Note that if we do not know it the thing it has been stolen from us!
         it.erase();
-      }
+      });
       _valueCount.clear();
       decreaseMemoryUsage(totalUsed);
     }
@@ -383,9 +403,9 @@ void AqlItemBlock::shrink(size_t numRows) {
 #endif
 
   size_t totalUsed = 0;
-  size_t const n = maxModifiedEntries();
-  for (size_t i = numEntries(); i < n; ++i) {
-    AqlValue& a = _data[i];
+  // note: _numRows has already been adjusted, but _maxModifiedRowIndex has
+  // not. the rows to clean are thus [_numRows, _maxModifiedRowIndex)
+  forEachValueInRows(_numRows, _maxModifiedRowIndex, [&](AqlValue& a) {
     if (a.requiresDestruction()) {
       auto it = _valueCount.find(a.data());
 
@@ -399,12 +419,12 @@ void AqlItemBlock::shrink(size_t numRows) {
           // no need for an extra a.erase() here
           a.destroy();
           _valueCount.erase(it);
-          continue;
+          return;
         }
       }
     }
     a.erase();
-  }
+  });
 
   _maxModifiedRowIndex = std::min<size_t>(_maxModifiedRowIndex, _numRows);
   TRI_ASSERT(_maxModifiedRowIndex <= _numRows);
@@ -441,6 +461,7 @@ void AqlItemBlock::rescale(size_t numRows, RegisterCount numRegisters) {
 
   _numRows = numRows;
   _numRegisters = numRegisters;
+  _columnStride = numRows;
   _maxModifiedRowIndex = std::min<size_t>(_maxModifiedRowIndex, _numRows);
   TRI_ASSERT(_maxModifiedRowIndex <= _numRows);
 }
@@ -711,16 +732,19 @@ void AqlItemBlock::toVelocyPack(size_t from, size_t to,
   options.buildUnindexedArrays = true;
   options.buildUnindexedObjects = true;
 
-  VPackBuilder raw(&options);
-  raw.openArray();
-  // Two nulls in the beginning such that indices start with 2
-  raw.add(VPackValue(VPackValueType::Null));
-  raw.add(VPackValue(VPackValueType::Null));
-
   result.add("nrItems", VPackValue(to - from));
   result.add("nrRegs", VPackValue(_numRegisters));
   result.add(StaticStrings::Error, VPackValue(false));
 
+  // the values are written into the result directly, as they make up most of
+  // the data. "data" only contains small numbers, so it is built separately
+  // and added after "raw"
+  result.add(VPackValue("raw"));
+  result.openArray(/*unindexed*/ true);
+  // Two nulls in the beginning such that indices start with 2
+  result.add(VPackValue(VPackValueType::Null));
+  result.add(VPackValue(VPackValueType::Null));
+
   enum State {
     Empty,       // saw an empty value
     Range,       // saw a range value
@@ -729,6 +753,7 @@ void AqlItemBlock::toVelocyPack(size_t from, size_t to,
   };
 
   std::unordered_map<AqlValue, size_t> table;  // remember duplicates
+  table.reserve(to - from);
   size_t lastTablePos = 0;
   State lastState = Positional;
 
@@ -736,7 +761,8 @@ void AqlItemBlock::toVelocyPack(size_t from, size_t to,
   size_t runLength = 0;
   size_t tablePos = 0;
 
-  result.add("data", VPackValue(VPackValueType::Array));
+  VPackBuilder data(&options);
+  data.openArray();
 
   // write out data buffered for repeated "empty" or "next" values
   auto writeBuffered = [](State lastState, size_t lastTablePos,
@@ -807,7 +833,7 @@ void AqlItemBlock::toVelocyPack(size_t from, size_t to,
 
         if (it == table.end()) {
           currentState = Next;
-          a.toVelocyPack(trxOptions, raw, /*resolveExternals*/ false,
+          a.toVelocyPack(trxOptions, result, /*resolveExternals*/ false,
                          /*allowUnindexed*/ true);
           table.try_emplace(a, pos++);
         } else {
@@ -824,7 +850,7 @@ void AqlItemBlock::toVelocyPack(size_t from, size_t to,
       if (currentState != lastState ||
           (currentState == Positional && tablePos != lastTablePos)) {
         // write out remaining buffered data in case of a state change
-        writeBuffered(lastState, lastTablePos, result, runLength);
+        writeBuffered(lastState, lastTablePos, data, runLength);
 
         lastTablePos = 0;
         lastState = currentState;
@@ -840,21 +866,20 @@ void AqlItemBlock::toVelocyPack(size_t from, size_t to,
           break;
 
         case Range:
-          result.add(VPackValue(-2));
-          result.add(VPackValue(a.range()->_low));
-          result.add(VPackValue(a.range()->_high));
+          data.add(VPackValue(-2));
+          data.add(VPackValue(a.range()->_low));
+          data.add(VPackValue(a.range()->_high));
           break;
       }
     }
   }
 
   // write out any remaining buffered data
-  writeBuffered(lastState, lastTablePos, result, runLength);
+  writeBuffered(lastState, lastTablePos, data, runLength);
 
-  result.close();  // closes "data"
-
-  raw.close();
-  result.add("raw", raw.slice());
+  data.close();
+  result.close();  // closes "raw"
+  result.add("data", data.slice());
 }
 
 void AqlItemBlock::rowToSimpleVPack(
@@ -1038,11 +1063,7 @@ void AqlItemBlock::destroyValue(size_t index, RegisterId::value_t column) {
 }
 
 void AqlItemBlock::eraseAll() {
-  size_t const n = maxModifiedEntries();
-  for (size_t i = 0; i < n; i++) {
-    auto& it = _data[i];
-    it.erase();
-  }
+  forEachValueInRows(0, _maxModifiedRowIndex, [](AqlValue& it) { it.erase(); });
 
   size_t totalUsed = 0;
   for (auto const& it : _valueCount) {
@@ -1105,6 +1126,38 @@ RegisterCount AqlItemBlock::numRegisters() const noexcept {
   return _numRegisters;
 }
 
+AqlItemBlock::Layout AqlItemBlock::layout() const noexcept { return _layout; }
+
+void AqlItemBlock::setLayout(Layout layout) {
+  if (layout == _layout) {
+    return;
+  }
+  if (ADB_UNLIKELY(_maxModifiedRowIndex != 0 || !_valueCount.empty())) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(
+        TRI_ERROR_INTERNAL,
+        "cannot change layout of AqlItemBlock that contains values");
+  }
+  _layout = layout;
+  _columnStride = _numRows;
+}
+
+bool AqlItemBlock::hasContiguousColumns() const noexcept {
+  // with a single register, the row-major layout is also column-major
+  return _layout == Layout::ColumnMajor || _numRegisters == 1;
+}
+
+std::span<AqlValue const> AqlItemBlock::getColumn(RegisterId::value_t column,
+                                                  size_t from,
+                                                  size_t to) const noexcept {
+  TRI_ASSERT(hasContiguousColumns());
+  TRI_ASSERT(from <= to);
+  TRI_ASSERT(to <= _numRows);
+  if (from == to) {
+    return {};
+  }
+  return {_data.data() + getAddress(from, column), to - from};
+}
+
 size_t AqlItemBlock::numRows() const noexcept { return _numRows; }
 size_t AqlItemBlock::maxModifiedRowIndex() const noexcept {
   return _maxModifiedRowIndex;
@@ -1199,9 +1252,14 @@ size_t AqlItemBlock::getAddress(size_t index,
   TRI_ASSERT(index < _numRows);
   TRI_ASSERT(reg < _numRegisters)
       << "violated " << reg << " < " << _numRegisters;
+  if (_layout == Layout::ColumnMajor) {
+    TRI_ASSERT(_numRows <= _columnStride);
+    return reg * _columnStride + index;
+  }
   return index * _numRegisters + reg;
 }
 
+
 void AqlItemBlock::copySubqueryDepth(size_t currentRow, size_t fromRow) {
   if (_shadowRows.is(fromRow) && !_shadowRows.is(currentRow)) {
     _shadowRows.make(currentRow, _shadowRows.getDepth(fromRow));
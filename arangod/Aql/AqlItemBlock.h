@@ -29,6 +29,7 @@
 
 #include "Containers/SmallVector.h"
 
+#include <cstdint>
 #include <limits>
 #include <span>
 #include <thread>
@@ -59,6 +60,13 @@ class SharedAqlItemBlockPtr;
 // copies. Furthermore, when parts of an AqlItemBlock are handed on
 // to another AqlItemBlock, then the <AqlValue>s inside must be copied
 // (deep copy) to make the blocks independent.
+//
+// By default, the values are stored row by row (i.e. all registers of row 0,
+// then all registers of row 1 etc.). Alternatively, a block can store its
+// values column by column, so that all values of a single register are
+// contiguous in memory. This is selected by the AqlItemBlockManager when the
+// block is handed out, and is beneficial for executors that only touch a
+// few registers of blocks with many registers.
 
 class AqlItemBlock {
   friend class AqlItemBlockManager;
@@ -112,6 +120,14 @@ class AqlItemBlock {
 
   using ShadowRowIterator = std::vector<uint32_t>::const_iterator;
 
+  /// @brief memory layout of the values inside the block
+  enum class Layout : std::uint8_t {
+    // all registers of a row are adjacent
+    RowMajor,
+    // all rows of a register are adjacent
+    ColumnMajor,
+  };
+
  protected:
   /// @brief destroy the block
   /// Should only ever be deleted by AqlItemManager::returnBlock, so the
@@ -205,6 +221,22 @@ class AqlItemBlock {
   /// @brief getter for _numRegisters
   RegisterCount numRegisters() const noexcept;
 
+  /// @brief getter for _layout
+  Layout layout() const noexcept;
+
+  /// @brief change the memory layout of the block. this is only allowed
+  /// while the block does not contain any values
+  void setLayout(Layout layout);
+
+  /// @brief whether or not the values of each register are stored
+  /// contiguously, so that getColumn() can be used
+  bool hasContiguousColumns() const noexcept;
+
+  /// @brief get the values of a register in rows [from, to) as a contiguous
+  /// span. Only allowed if hasContiguousColumns() is true.
+  std::span<AqlValue const> getColumn(RegisterId::value_t column, size_t from,
+                                      size_t to) const noexcept;
+
   /// @brief getter for _numRows
   size_t numRows() const noexcept;
   size_t maxModifiedRowIndex() const noexcept;
@@ -359,11 +391,16 @@ class AqlItemBlock {
   /// @brief get the computed address within the data vector
   size_t getAddress(size_t index, RegisterId::value_t reg) const noexcept;
 
+  /// @brief invoke the callback for the values of all registers in rows
+  /// [fromRow, toRow), independent of the layout
+  template<typename F>
+  void forEachValueInRows(size_t fromRow, size_t toRow, F&& callback);
+
   void copySubqueryDepth(size_t currentRow, size_t fromRow);
 
  private:
   /// @brief _data, the actual data as a single vector of dimensions _numRows
-  /// times _numRegisters
+  /// times _numRegisters. The order of the values depends on _layout.
   std::vector<AqlValue> _data;
 
   /// @brief _valueCount, since we have to allow for identical AqlValues
@@ -388,6 +425,15 @@ class AqlItemBlock {
   /// @brief (highest) number of rows that have been written to
   size_t _maxModifiedRowIndex = 0;
 
+  /// @brief distance between two adjacent registers of the same row in
+  /// _data, if the block uses the column-major layout. This is the number of
+  /// rows the block was sized for, and it is not affected by shrink(), so
+  /// that shrinking does not need to move any values.
+  size_t _columnStride = 0;
+
+  /// @brief memory layout of _data
+  Layout _layout = Layout::RowMajor;
+
   /// @brief manager for this item block
   AqlItemBlockManager& _manager;
 
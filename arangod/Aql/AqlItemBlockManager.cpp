@@ -82,6 +82,12 @@ SharedAqlItemBlockPtr AqlItemBlockManager::requestBlock(
   }
 
   TRI_ASSERT(block != nullptr);
+  // blocks are empty here, so changing the layout cannot fail
+  block->setLayout(_columnarLayoutMinRegisters > 0 &&
+                           numRegisters >= _columnarLayoutMinRegisters
+                       ? AqlItemBlock::Layout::ColumnMajor
+                       : AqlItemBlock::Layout::RowMajor);
+
   TRI_ASSERT(block->numRows() == numRows);
   TRI_ASSERT(block->numRegisters() == numRegisters);
   TRI_ASSERT(block->numEntries() == targetSize);
@@ -153,6 +159,16 @@ arangodb::ResourceMonitor& AqlItemBlockManager::resourceMonitor()
   return _resourceMonitor;
 }
 
+void AqlItemBlockManager::setColumnarLayoutMinRegisters(
+    RegisterCount value) noexcept {
+  _columnarLayoutMinRegisters = value;
+}
+
+RegisterCount AqlItemBlockManager::columnarLayoutMinRegisters()
+    const noexcept {
+  return _columnarLayoutMinRegisters;
+}
+
 #ifdef ARANGODB_USE_GOOGLE_TESTS
 void AqlItemBlockManager::deleteBlock(AqlItemBlock* block) { delete block; }
 #endif
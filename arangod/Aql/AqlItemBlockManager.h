@@ -63,6 +63,13 @@ class AqlItemBlockManager {
 
   TEST_VIRTUAL arangodb::ResourceMonitor& resourceMonitor() const noexcept;
 
+  /// @brief set the minimum number of registers from which on blocks are
+  /// handed out with the column-major layout. 0 means that all blocks use
+  /// the row-major layout.
+  void setColumnarLayoutMinRegisters(RegisterCount value) noexcept;
+
+  RegisterCount columnarLayoutMinRegisters() const noexcept;
+
   void initializeConstValueBlock(RegisterCount nrRegs);
 
   AqlItemBlock* getConstValueBlock() { return _constValueBlock; }
@@ -88,6 +95,10 @@ class AqlItemBlockManager {
  private:
   arangodb::ResourceMonitor& _resourceMonitor;
 
+  /// @brief number of registers from which on blocks use the column-major
+  /// layout. 0 = disabled
+  RegisterCount _columnarLayoutMinRegisters = 0;
+
   static constexpr uint32_t numBuckets = 12;
   static constexpr size_t numBlocksPerBucket = 7;
 
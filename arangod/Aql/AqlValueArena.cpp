@@ -0,0 +1,124 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "AqlValueArena.h"
+#include "Basics/ResourceUsage.h"
+#include "Basics/debugging.h"
+
+#include <velocypack/Slice.h>
+
+#include <cstring>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+namespace {
+/// @brief approximate memory used by the hash set for each slot
+constexpr size_t memoryPerSlot = sizeof(std::string_view) + 1;
+}  // namespace
+
+AqlValueArena::AqlValueArena(ResourceMonitor& resourceMonitor,
+                             size_t maxMemory)
+    : _resourceMonitor(resourceMonitor),
+      _maxMemory(maxMemory),
+      _position(nullptr),
+      _available(0),
+      _memoryUsage(0) {}
+
+AqlValueArena::~AqlValueArena() { clear(); }
+
+AqlValue AqlValueArena::intern(AqlValue const& value) {
+  if (!value.requiresDestruction() && !value.isPointer()) {
+    // inline values do not use any memory
+    return value;
+  }
+  if (value.isRange()) {
+    return value.clone();
+  }
+
+  velocypack::Slice slice = value.slice();
+  velocypack::ValueLength const length = slice.byteSize();
+  if (length <= sizeof(AqlValue) - 1) {
+    // fits into an inline value
+    return AqlValue(slice, length);
+  }
+
+  if (length <= maxValueSize) {
+    auto it = _values.find(std::string_view(
+        reinterpret_cast<char const*>(slice.start()), length));
+    uint8_t const* data = nullptr;
+    if (it != _values.end()) {
+      data = reinterpret_cast<uint8_t const*>(it->data());
+    } else {
+      data = store(slice);
+    }
+    if (data != nullptr) {
+      return AqlValue(AqlValueHintSliceNoCopy(velocypack::Slice(data)));
+    }
+  }
+
+  // too large, or the arena is full
+  return value.clone();
+}
+
+void AqlValueArena::clear() noexcept {
+  // swap with an empty set to actually free the set's memory
+  containers::FlatHashSet<std::string_view>().swap(_values);
+  _blocks.clear();
+  _position = nullptr;
+  _available = 0;
+  _resourceMonitor.decreaseMemoryUsage(_memoryUsage);
+  _memoryUsage = 0;
+}
+
+uint8_t const* AqlValueArena::store(velocypack::Slice slice) {
+  size_t const length = slice.byteSize();
+  TRI_ASSERT(length <= maxValueSize);
+
+  if (_available < length) {
+    if (_memoryUsage + blockSize > _maxMemory) {
+      return nullptr;
+    }
+    // note: the rest of the previous block is wasted, which is at most
+    // maxValueSize bytes
+    ResourceUsageScope scope(_resourceMonitor, blockSize);
+    _blocks.emplace_back(std::make_unique<uint8_t[]>(blockSize));
+    scope.steal();
+    _memoryUsage += blockSize;
+    _position = _blocks.back().get();
+    _available = blockSize;
+  }
+
+  uint8_t* data = _position;
+  memcpy(data, slice.start(), length);
+  _position += length;
+  _available -= length;
+
+  size_t const capacity = _values.capacity();
+  _values.emplace(reinterpret_cast<char const*>(data), length);
+  if (_values.capacity() != capacity) {
+    size_t const memory = (_values.capacity() - capacity) * memoryPerSlot;
+    _resourceMonitor.increaseMemoryUsage(memory);
+    _memoryUsage += memory;
+  }
+
+  return data;
+}
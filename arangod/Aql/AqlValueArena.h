@@ -0,0 +1,97 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Aql/AqlValue.h"
+#include "Containers/FlatHashSet.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace arangodb {
+struct ResourceMonitor;
+
+namespace aql {
+
+/// @brief storage for copies of AqlValues, owned by a single executor. values
+/// are copied into large blocks instead of being allocated one by one, and
+/// identical values are stored only once. the memory is released all at once
+/// when the arena is cleared or destroyed.
+/// interned values are VPACK_SLICE_POINTER values, so they can be copied
+/// freely and do not need to be destroyed. they must not be handed out to
+/// other executors though, as they are only valid as long as the arena is
+/// not cleared. the arena is not thread-safe.
+class AqlValueArena {
+ public:
+  /// @brief size of the blocks the arena allocates
+  static constexpr size_t blockSize = 32 * 1024;
+
+  /// @brief larger values are not interned, but cloned as usual
+  static constexpr size_t maxValueSize = 1024;
+
+  /// @brief maximum memory held by the arena. once reached, values are
+  /// cloned as usual, so that queries which copy lots of distinct values,
+  /// e.g. a COLLECT inside a subquery, do not pile up memory in the arena
+  static constexpr size_t defaultMaxMemory = 64 * 1024 * 1024;
+
+  explicit AqlValueArena(ResourceMonitor& resourceMonitor,
+                         size_t maxMemory = defaultMaxMemory);
+  ~AqlValueArena();
+
+  AqlValueArena(AqlValueArena const&) = delete;
+  AqlValueArena& operator=(AqlValueArena const&) = delete;
+
+  /// @brief returns a copy of the value that stays valid until the arena is
+  /// cleared, as a replacement for AqlValue::clone(). the returned value
+  /// must be destroyed if it requires destruction, as it may be a regular
+  /// clone of the value
+  AqlValue intern(AqlValue const& value);
+
+  /// @brief memory used by the arena
+  size_t memoryUsage() const noexcept { return _memoryUsage; }
+
+  /// @brief releases all memory of the arena. all values interned so far
+  /// become invalid
+  void clear() noexcept;
+
+ private:
+  /// @brief copy the value into the arena, returns a nullptr if the arena
+  /// is full
+  uint8_t const* store(velocypack::Slice slice);
+
+  ResourceMonitor& _resourceMonitor;
+  size_t const _maxMemory;
+
+  std::vector<std::unique_ptr<uint8_t[]>> _blocks;
+  /// @brief free space at the end of the current block
+  uint8_t* _position;
+  size_t _available;
+  /// @brief all interned values, referring to the arena's memory
+  containers::FlatHashSet<std::string_view> _values;
+  size_t _memoryUsage;
+};
+
+}  // namespace aql
+}  // namespace arangodb
@@ -25,9 +25,27 @@
 
 #include "Basics/debugging.h"
 
+#include <velocypack/Slice.h>
+
 using namespace arangodb;
 using namespace arangodb::aql;
 
+namespace {
+bool isEqual(velocypack::Options const* options, AqlValue const& lhs,
+             AqlValue const& rhs) {
+  if (!lhs.isRange() && !rhs.isRange()) {
+    // fast path for the common case of string values, which do not need
+    // the generic comparison
+    VPackSlice l = lhs.slice();
+    VPackSlice r = rhs.slice();
+    if (l.isString() && r.isString()) {
+      return l.stringView() == r.stringView();
+    }
+  }
+  return AqlValue::Compare(options, lhs, rhs, false) == 0;
+}
+}  // namespace
+
 AqlValueGroupHash::AqlValueGroupHash([[maybe_unused]] size_t num)
 #ifdef ARANGODB_ENABLE_MAINTAINER_MODE
     : _num(num)
@@ -71,9 +89,7 @@ bool AqlValueGroupEqual::operator()(const std::vector<AqlValue>& lhs,
   size_t const n = lhs.size();
 
   for (size_t i = 0; i < n; ++i) {
-    int res = AqlValue::Compare(_vpackOptions, lhs[i], rhs[i], false);
-
-    if (res != 0) {
+    if (!::isEqual(_vpackOptions, lhs[i], rhs[i])) {
       return false;
     }
   }
@@ -83,7 +99,7 @@ bool AqlValueGroupEqual::operator()(const std::vector<AqlValue>& lhs,
 
 bool AqlValueGroupEqual::operator()(AqlValue const& lhs,
                                     AqlValue const& rhs) const {
-  return AqlValue::Compare(_vpackOptions, lhs, rhs, false) == 0;
+  return ::isEqual(_vpackOptions, lhs, rhs);
 }
 
 bool AqlValueGroupEqual::operator()(HashedAqlValueGroup const& lhs,
@@ -40,6 +40,7 @@
 #include "Aql/AqlFunctionsInternalCache.h"
 #include "Basics/Arithmetic.h"
 #include "Basics/Exceptions.h"
+#include "Basics/NumberUtils.h"
 #include "Basics/tri-strings.h"
 #include "Basics/tryEmplaceHelper.h"
 #include "Cluster/ClusterFeature.h"
@@ -54,6 +55,7 @@
 #include "Utilities/NameValidator.h"
 #include "VocBase/LogicalCollection.h"
 #include "VocBase/LogicalView.h"
+#include "VocBase/Methods/AqlUserFunctions.h"
 #include "V8Server/V8DealerFeature.h"
 
 #include <absl/strings/str_cat.h>
@@ -288,6 +290,47 @@ LogicalDataSource::Category injectDataSourceInQuery(
   return dataSource->category();
 }
 
+/// @brief collect the bind parameters that are used as comparison operands
+/// in FILTER conditions (candidates) and the ones used anywhere else
+void collectRuntimeBindParameters(AstNode const* node, bool isCondition,
+                                  std::unordered_set<std::string>& candidates,
+                                  std::unordered_set<std::string>& excluded) {
+  if (node->type == NODE_TYPE_PARAMETER) {
+    excluded.emplace(node->getString());
+    return;
+  }
+
+  if (isCondition && node->isSimpleComparisonOperator()) {
+    TRI_ASSERT(node->numMembers() == 2);
+    AstNode const* lhs = node->getMemberUnchecked(0);
+    AstNode const* rhs = node->getMemberUnchecked(1);
+    for (auto [value, other] : {std::pair{lhs, rhs}, std::pair{rhs, lhs}}) {
+      if (value->type == NODE_TYPE_PARAMETER &&
+          other->isAttributeAccessForVariable()) {
+        candidates.emplace(value->getString());
+      } else {
+        collectRuntimeBindParameters(value, false, candidates, excluded);
+      }
+    }
+    return;
+  }
+
+  // the operands of logical operators are still part of the condition
+  bool const isConditionPart =
+      node->type == NODE_TYPE_FILTER ||
+      (isCondition && (node->type == NODE_TYPE_OPERATOR_BINARY_AND ||
+                       node->type == NODE_TYPE_OPERATOR_BINARY_OR ||
+                       node->type == NODE_TYPE_OPERATOR_NARY_AND ||
+                       node->type == NODE_TYPE_OPERATOR_NARY_OR ||
+                       node->type == NODE_TYPE_OPERATOR_UNARY_NOT));
+
+  size_t const n = node->numMembers();
+  for (size_t i = 0; i < n; ++i) {
+    collectRuntimeBindParameters(node->getMemberUnchecked(i), isConditionPart,
+                                 candidates, excluded);
+  }
+}
+
 }  // namespace
 
 /// @brief inverse comparison operators
@@ -1891,6 +1934,13 @@ AstNode* Ast::createNodeFunctionCall(std::string_view functionName,
     }
   } else {
     // user-defined function (UDF)
+    if (AstNode* inlined =
+            createNodeNativeUserFunctionCall(normalized, arguments);
+        inlined != nullptr) {
+      // native functions do not need V8
+      return inlined;
+    }
+
     if (_query.vocbase().server().hasFeature<V8DealerFeature>() &&
         !_query.vocbase()
              .server()
@@ -1918,6 +1968,63 @@ AstNode* Ast::createNodeFunctionCall(std::string_view functionName,
   return node;
 }
 
+/// @brief create the AST nodes for a call to a native user-defined function
+AstNode* Ast::createNodeNativeUserFunctionCall(std::string const& functionName,
+                                               AstNode const* arguments) {
+  auto it = _nativeUserFunctions.find(functionName);
+  if (it == _nativeUserFunctions.end()) {
+    std::shared_ptr<VPackBuilder const> definition;
+    Result res =
+        lookupNativeUserFunction(_query.vocbase(), functionName, definition);
+    if (res.fail() && !res.is(TRI_ERROR_QUERY_FUNCTION_NOT_FOUND)) {
+      THROW_ARANGO_EXCEPTION(res);
+    }
+    it = _nativeUserFunctions.emplace(functionName, std::move(definition))
+             .first;
+  }
+  if (it->second == nullptr) {
+    return nullptr;
+  }
+
+  VPackSlice definition = it->second->slice();
+  size_t const n = arguments->numMembers();
+  size_t const expected = definition.get("arguments").getNumber<size_t>();
+  if (n != expected) {
+    THROW_ARANGO_EXCEPTION_PARAMS(
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, functionName.c_str(),
+        static_cast<int>(expected), static_cast<int>(expected));
+  }
+
+  // the arguments are referred to as bind parameters @0, @1, ... in the body
+  std::vector<size_t> uses(n, 0);
+  AstNode* body = createNode(definition.get("ast"));
+  body = traverseAndModify(body, [&](AstNode* node) -> AstNode* {
+    if (node->type != NODE_TYPE_PARAMETER) {
+      return node;
+    }
+    size_t const position = NumberUtils::atoi_zero<size_t>(
+        node->getStringView().data(),
+        node->getStringView().data() + node->getStringLength());
+    TRI_ASSERT(position < n);
+    AstNode* argument = arguments->getMemberUnchecked(position);
+    if (uses[position]++ > 0) {
+      // inserting an argument more than once would evaluate it more than
+      // once, which is only allowed if that gives the same results
+      if (!argument->isDeterministic()) {
+        THROW_ARANGO_EXCEPTION_MESSAGE(
+            TRI_ERROR_QUERY_FUNCTION_RUNTIME_ERROR,
+            absl::StrCat("argument ", position, " of native function '",
+                         functionName,
+                         "' is used more than once and must be "
+                         "deterministic"));
+      }
+      argument = clone(argument);
+    }
+    return argument;
+  });
+  return body;
+}
+
 /// @brief create an AST range node
 AstNode* Ast::createNodeRange(AstNode const* start, AstNode const* end) {
   AstNode* node = createNode(NODE_TYPE_RANGE);
@@ -1949,9 +2056,25 @@ AstNode* Ast::createNodeNaryOperator(AstNodeType type, AstNode const* child) {
   return node;
 }
 
+/// @brief return the bind parameters that can be evaluated at runtime
+std::unordered_set<std::string> Ast::runtimeBindParameters() const {
+  std::unordered_set<std::string> candidates;
+  if (!_containsBindParameters) {
+    return candidates;
+  }
+
+  std::unordered_set<std::string> excluded;
+  ::collectRuntimeBindParameters(_root, false, candidates, excluded);
+  for (auto const& name : excluded) {
+    candidates.erase(name);
+  }
+  return candidates;
+}
+
 /// @brief injects bind parameters into the AST
-void Ast::injectBindParameters(BindParameters& parameters,
-                               CollectionNameResolver const& resolver) {
+void Ast::injectBindParameters(
+    BindParameters& parameters, CollectionNameResolver const& resolver,
+    std::unordered_set<std::string> const& runtimeBindParameters) {
   if (_containsBindParameters || _containsTraversal) {
     // inject bind parameters into query AST
     auto func = [&](AstNode* node) -> AstNode* {
@@ -1973,7 +2096,15 @@ void Ast::injectBindParameters(BindParameters& parameters,
                                 param);
         }
 
-        if (node->type == NODE_TYPE_PARAMETER) {
+        if (node->type == NODE_TYPE_PARAMETER &&
+            runtimeBindParameters.contains(param)) {
+          // keep the parameter node. its value is looked up at runtime
+          node->markAsRuntimeBindParameter();
+          if (cachedNode == nullptr) {
+            // mark the bind parameter as being used
+            parameters.registerNode(param, node);
+          }
+        } else if (node->type == NODE_TYPE_PARAMETER) {
           auto const constantParameter = node->isConstant();
 
           if (cachedNode != nullptr) {
@@ -2386,10 +2517,21 @@ void Ast::validateAndOptimize(transaction::Methods& trx,
       TRI_ASSERT(ctx->filterDepth == -1);
       ctx->filterDepth = 0;
     } else if (node->type == NODE_TYPE_TRAVERSAL) {
+#ifdef USE_ENTERPRISE
+      // parallel traversals are only supported in the Enterprise Edition
       size_t parallelism = extractParallelism(node->getMember(4));
       if (parallelism > 1) {
         setContainsParallelNode();
       }
+#endif
+    } else if (node->type == NODE_TYPE_COLLECT) {
+#ifdef USE_ENTERPRISE
+      // parallel COLLECT is only supported in the Enterprise Edition
+      size_t parallelism = extractParallelism(node->getMember(0));
+      if (parallelism > 1) {
+        setContainsParallelNode();
+      }
+#endif
     } else if (node->type == NODE_TYPE_FCALL) {
       auto func = static_cast<Function*>(node->getData());
       TRI_ASSERT(func != nullptr);
@@ -4411,8 +4553,4 @@ bool Ast::containsUpsertNode() const noexcept { return _containsUpsertNode; }
 
 void Ast::setContainsUpsertNode() noexcept { _containsUpsertNode = true; }
 
-void Ast::setContainsParallelNode() noexcept {
-#ifdef USE_ENTERPRISE
-  _containsParallelNode = true;
-#endif
-}
+void Ast::setContainsParallelNode() noexcept { _containsParallelNode = true; }
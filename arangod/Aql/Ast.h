@@ -153,6 +153,10 @@ class Ast {
   void setContainsUpsertNode() noexcept;
   void setContainsParallelNode() noexcept;
 
+  /// @brief whether or not the query uses V8. only valid after
+  /// validateAndOptimize() was called
+  bool willUseV8() const noexcept { return _willUseV8; }
+
   bool canApplyParallelism() const noexcept {
     return _containsParallelNode && !_willUseV8 && !_containsModificationNode;
   }
@@ -438,9 +442,18 @@ class Ast {
   /// @brief create an AST n-ary operator
   AstNode* createNodeNaryOperator(AstNodeType, AstNode const*);
 
-  /// @brief injects bind parameters into the AST
-  void injectBindParameters(BindParameters& parameters,
-                            CollectionNameResolver const& resolver);
+  /// @brief injects bind parameters into the AST. the runtime bind
+  /// parameters are not injected, but are kept as parameter nodes that are
+  /// evaluated when the query is executed
+  void injectBindParameters(
+      BindParameters& parameters, CollectionNameResolver const& resolver,
+      std::unordered_set<std::string> const& runtimeBindParameters = {});
+
+  /// @brief return the bind parameters that can be evaluated at runtime
+  /// without making the execution plan worse. these are the bind parameters
+  /// that are only used as comparison operands in FILTER conditions, with an
+  /// attribute access on the other side
+  std::unordered_set<std::string> runtimeBindParameters() const;
 
   /// @brief replace variables
   ///        the unlock parameter will unlock the variable node before it
@@ -631,6 +644,12 @@ class Ast {
   /// the subnodes
   void copyPayload(AstNode const* node, AstNode* copy) const;
 
+  /// @brief create the AST nodes for a call to a native user-defined
+  /// function, by inserting the arguments into the function's body. returns
+  /// a nullptr if the function is not a native function
+  AstNode* createNodeNativeUserFunctionCall(std::string const& functionName,
+                                            AstNode const* arguments);
+
   bool hasFlag(AstPropertyFlag flag) const noexcept {
     return ((_astFlags & static_cast<decltype(_astFlags)>(flag)) != 0);
   }
@@ -657,6 +676,11 @@ class Ast {
   /// @brief the bind parameters we found in the query
   std::unordered_set<std::string> _bindParameters;
 
+  /// @brief definitions of the native user-defined functions used in the
+  /// query, nullptr for JavaScript functions
+  std::unordered_map<std::string, std::shared_ptr<velocypack::Builder const>>
+      _nativeUserFunctions;
+
   /// @brief root node of the AST
   AstNode* _root;
 
@@ -682,7 +706,7 @@ class Ast {
 
   bool _containsUpsertNode{false};
 
-  /// @brief contains a parallel traversal
+  /// @brief contains a parallel traversal, COLLECT or collection scan
   bool _containsParallelNode;
 
   /// @brief query makes use of V8 function(s)
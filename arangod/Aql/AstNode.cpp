@@ -414,8 +414,8 @@ int compareAstNodes(AstNode const* lhs, AstNode const* rhs, bool compareUtf8) {
 }
 
 /// @brief create the node
-AstNode::AstNode(AstNodeType type)
-    : type(type), flags(0), _computedValue(nullptr), members{} {
+AstNode::AstNode(AstNodeType type, std::pmr::memory_resource* resource)
+    : type(type), flags(0), _computedValue(nullptr), members(resource) {
   // properly zero-initialize all members
   value.value._int = 0;
   value.length = 0;
@@ -433,8 +433,9 @@ AstNode::AstNode(AstNodeValue const& value)
       members{} {}
 
 /// @brief create the node from VPack
-AstNode::AstNode(Ast* ast, arangodb::velocypack::Slice slice)
-    : AstNode(getNodeTypeFromVPack(slice)) {
+AstNode::AstNode(Ast* ast, arangodb::velocypack::Slice slice,
+                 std::pmr::memory_resource* resource)
+    : AstNode(getNodeTypeFromVPack(slice), resource) {
   TRI_ASSERT(flags == 0);
   TRI_ASSERT(_computedValue == nullptr);
 
@@ -454,6 +455,11 @@ AstNode::AstNode(Ast* ast, arangodb::velocypack::Slice slice)
         char const* p = v.getString(l);
         setStringValue(ast->resources().registerString(p, l), l);
       }
+      if (type == NODE_TYPE_PARAMETER) {
+        // all other bind parameters have been replaced by their values
+        // before the plan was serialized
+        markAsRuntimeBindParameter();
+      }
       break;
     }
     case NODE_TYPE_VALUE: {
@@ -1755,6 +1761,8 @@ bool AstNode::isConstant() const {
 
   if (type == NODE_TYPE_PARAMETER) {
     // bind parameter values will always be constant values later on...
+    // (except for runtime bind parameters, which have DETERMINED_CONSTANT
+    // set already)
     setFlag(DETERMINED_CONSTANT, VALUE_CONSTANT);
     return true;
   }
@@ -2440,6 +2448,20 @@ void AstNode::removeFlag(AstNodeFlagType flag) const noexcept {
   flags &= ~flag;
 }
 
+/// @brief mark a bind parameter node as being evaluated at runtime
+void AstNode::markAsRuntimeBindParameter() const noexcept {
+  TRI_ASSERT(type == NODE_TYPE_PARAMETER);
+  // the node may have been considered constant during parsing already
+  removeFlag(VALUE_CONSTANT);
+  removeFlag(VALUE_NONDETERMINISTIC);
+  removeFlag(VALUE_V8);
+  setFlag(DETERMINED_CONSTANT);
+  setFlag(DETERMINED_SIMPLE, VALUE_SIMPLE);
+  setFlag(DETERMINED_RUNONDBSERVER, VALUE_RUNONDBSERVER);
+  setFlag(DETERMINED_NONDETERMINISTIC);
+  setFlag(DETERMINED_V8);
+}
+
 bool AstNode::isSorted() const noexcept {
   return ((flags & (DETERMINED_SORTED | VALUE_SORTED)) ==
           (DETERMINED_SORTED | VALUE_SORTED));
@@ -28,6 +28,7 @@
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <memory_resource>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -235,14 +236,19 @@ struct AstNode {
   /// a binary sort to do lookups
   static constexpr size_t kSortNumberThreshold = 8;
 
-  /// @brief create the node
-  explicit AstNode(AstNodeType);
+  /// @brief create the node. the member array is allocated from the
+  /// given memory resource, which must outlive the node
+  explicit AstNode(AstNodeType, std::pmr::memory_resource* resource =
+                                    std::pmr::get_default_resource());
 
   /// @brief create a node, with defining a value
   explicit AstNode(AstNodeValue const& value);
 
-  /// @brief create the node from VPack
-  explicit AstNode(Ast*, arangodb::velocypack::Slice slice);
+  /// @brief create the node from VPack. the member array is allocated from
+  /// the given memory resource, which must outlive the node
+  explicit AstNode(
+      Ast*, arangodb::velocypack::Slice slice,
+      std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
   /// @brief destroy the node
   ~AstNode();
@@ -337,6 +343,11 @@ struct AstNode {
   /// @brief remove a flag for the node
   void removeFlag(AstNodeFlagType flag) const noexcept;
 
+  /// @brief mark a bind parameter node as being evaluated at runtime, i.e.
+  /// as a simple, deterministic, but non-constant expression. such nodes
+  /// are only left in the AST for plans stored in the query plan cache
+  void markAsRuntimeBindParameter() const noexcept;
+
   /// @brief whether or not the node value is trueish
   bool isTrue() const;
 
@@ -592,8 +603,10 @@ struct AstNode {
   /// @brief precomputed VPack value (used when executing expressions)
   uint8_t mutable* _computedValue;
 
-  /// @brief the node's sub nodes
-  std::vector<AstNode*> members{};
+  /// @brief the node's sub nodes. for nodes created via AstResources, the
+  /// array lives in the query's arena and is released together with the
+  /// nodes
+  std::pmr::vector<AstNode*> members;
 };
 
 template<bool resolveAttributeAccess = true>
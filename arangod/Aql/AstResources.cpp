@@ -40,6 +40,7 @@ char const* emptyString = "";
 
 AstResources::AstResources(ResourceMonitor& resourceMonitor)
     : _resourceMonitor(resourceMonitor),
+      _memberArena(kInitialMemberArenaSize),
       _stringsLength(0),
       _shortStringStorage(_resourceMonitor, 1024),
       _childNodes(0) {}
@@ -72,6 +73,7 @@ void AstResources::clear() noexcept {
   size_t memoryUsage = (_nodes.numUsed() * sizeof(AstNode)) + _stringsLength +
                        (_childNodes * memoryUsageForChildNode());
   _nodes.clear();
+  _memberArena.release();
   clearStrings();
   _shortStringStorage.clear();
   _childNodes = 0;
@@ -83,6 +85,7 @@ void AstResources::clearMost() noexcept {
   size_t memoryUsage = (_nodes.numUsed() * sizeof(AstNode)) + _stringsLength +
                        (_childNodes * memoryUsageForChildNode());
   _nodes.clearMost();
+  _memberArena.release();
   clearStrings();
   _shortStringStorage.clearMost();
   _childNodes = 0;
@@ -120,7 +123,7 @@ AstNode* AstResources::registerNode(AstNodeType type) {
   // may throw
   ResourceUsageScope scope(_resourceMonitor, sizeof(AstNode));
 
-  AstNode* node = _nodes.allocate(type);
+  AstNode* node = _nodes.allocate(type, &_memberArena);
 
   // now we are responsible for tracking the memory usage
   scope.steal();
@@ -132,7 +135,7 @@ AstNode* AstResources::registerNode(Ast* ast, velocypack::Slice slice) {
   // may throw
   ResourceUsageScope scope(_resourceMonitor, sizeof(AstNode));
 
-  AstNode* node = _nodes.allocate(ast, slice);
+  AstNode* node = _nodes.allocate(ast, slice, &_memberArena);
 
   // now we are responsible for tracking the memory usage
   scope.steal();
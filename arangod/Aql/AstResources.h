@@ -23,6 +23,7 @@
 
 #pragma once
 
+#include <memory_resource>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -90,6 +91,10 @@ class AstResources {
   // return the memory usage for an AstNode child node pointer
   constexpr static size_t memoryUsageForChildNode() { return sizeof(AstNode*); }
 
+  // size of the first chunk of the arena for member arrays. later chunks
+  // grow geometrically
+  constexpr static size_t kInitialMemberArenaSize = 4096;
+
   // return the minimum capacity for long strings container
   constexpr static size_t kMinCapacityForLongStrings = 8;
 
@@ -108,6 +113,11 @@ class AstResources {
   // resource monitor used for tracking allocations/deallocations
   ResourceMonitor& _resourceMonitor;
 
+  // arena for the member arrays of all nodes created in the AST. memory is
+  // only given back when the arena is released, after all nodes have been
+  // destroyed. must be declared before _nodes, so that it outlives them
+  std::pmr::monotonic_buffer_resource _memberArena;
+
   // all nodes created in the AST - will be used for freeing them later
   FixedSizeAllocator<AstNode> _nodes;
 
@@ -29,6 +29,7 @@
 #include "Aql/AqlItemBlockInputRange.h"
 #include "Aql/ExecutorExpressionContext.h"
 #include "Aql/Expression.h"
+#include "Aql/ExpressionKernel.h"
 #include "Aql/OutputAqlItemRow.h"
 #include "Aql/Query.h"
 #include "Aql/SingleRowFetcher.h"
@@ -40,6 +41,17 @@
 using namespace arangodb;
 using namespace arangodb::aql;
 
+namespace {
+// minimum number of rows for which we use the batch evaluation kernel
+constexpr size_t minBatchSize = 4;
+// number of rows the kernel must have been tried on before we decide
+// whether it is worth keeping
+constexpr size_t minKernelRows = 1000;
+// the kernel is dropped if the rows in batches it could not evaluate
+// outnumber the rows in batches it evaluated by more than this factor
+constexpr size_t maxKernelMissRatio = 2;
+}  // namespace
+
 CalculationExecutorInfos::CalculationExecutorInfos(
     RegisterId outputRegister, QueryContext& query, Expression& expression,
     std::vector<std::pair<VariableId, RegisterId>>&& expInVarToRegs)
@@ -53,10 +65,18 @@ CalculationExecutor<calculationType>::CalculationExecutor(
     Fetcher& fetcher, CalculationExecutorInfos& infos)
     : _trx(infos.getQuery().newTrxContext()),
       _infos(infos),
+      _kernelMissRows(0),
+      _kernelHitRows(0),
+      _kernelSkipRows(0),
       _fetcher(fetcher),
       _currentRow(InputAqlItemRow{CreateInvalidInputRowHint{}}),
       _rowState(ExecutionState::HASMORE),
-      _hasEnteredContext(false) {}
+      _hasEnteredContext(false) {
+  if constexpr (calculationType == CalculationType::Condition) {
+    _kernel = ExpressionKernel::compile(infos.getExpression().node(),
+                                        infos.getVarToRegs());
+  }
+}
 
 template<CalculationType calculationType>
 CalculationExecutor<calculationType>::~CalculationExecutor() = default;
@@ -92,6 +112,15 @@ CalculationExecutor<calculationType>::produceRows(
   while (inputRange.hasDataRow()) {
     // This executor is passthrough. it has enough place to write.
     TRI_ASSERT(!output.isFull());
+    if constexpr (calculationType == CalculationType::Condition) {
+      if (_kernelSkipRows > 0) {
+        // still inside a batch the kernel could not evaluate
+        --_kernelSkipRows;
+      } else if (_kernel != nullptr && doBatchEvaluation(inputRange, output)) {
+        continue;
+      }
+    }
+
     std::tie(state, input) =
         inputRange.nextDataRow(AqlItemBlockInputRange::HasDataRow{});
     TRI_ASSERT(input.isInitialized());
@@ -116,6 +145,12 @@ CalculationExecutor<calculationType>::produceRows(
                state == ExecutorState::HASMORE);
   }
 
+  // a batch never extends beyond the next shadow row or the end of the
+  // block, so the rows after it (e.g. those of the next subquery run) must
+  // get the kernel again
+  TRI_ASSERT(_kernelSkipRows == 0);
+  _kernelSkipRows = 0;
+
   return {inputRange.upstreamState(), NoStats{}, output.getClientCall()};
 }
 
@@ -186,6 +221,64 @@ void CalculationExecutor<CalculationType::Condition>::doEvaluation(
   output.moveValueInto(_infos.getOutputRegisterId(), input, guard);
 }
 
+template<CalculationType calculationType>
+bool CalculationExecutor<calculationType>::doBatchEvaluation(
+    AqlItemBlockInputRange& inputRange, OutputAqlItemRow& output) {
+  TRI_ASSERT(calculationType == CalculationType::Condition);
+  TRI_ASSERT(_kernel != nullptr);
+
+  auto const& block = inputRange.getBlock();
+  TRI_ASSERT(block != nullptr);
+  size_t const from = inputRange.getRowIndex();
+  // the batch ends at the next shadow row or at the end of the block
+  size_t to = block->numRows();
+  if (auto [it, end] = block->getShadowRowIndexesFrom(from); it != end) {
+    to = *it;
+  }
+  to = std::min(to, from + output.numRowsLeft());
+  TRI_ASSERT(from <= to);
+  if (to - from < minBatchSize) {
+    return false;
+  }
+
+  TRI_IF_FAILURE("CalculationBlock::executeExpression") {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+  }
+
+  if (!_kernel->evaluate(*block, from, to)) {
+    // evaluate this batch row by row, and do not retry the kernel on each
+    // of its remaining rows. the current row is evaluated right away by the
+    // caller, so only the rows after it need to be skipped
+    _kernelSkipRows = to - from - 1;
+    _kernelMissRows += to - from;
+    if (_kernelMissRows + _kernelHitRows >= minKernelRows &&
+        _kernelMissRows > _kernelHitRows * maxKernelMissRatio) {
+      // the input data is mostly not suitable for the kernel
+      _kernel.reset();
+    }
+    return false;
+  }
+  _kernelHitRows += to - from;
+
+  RegisterId const outReg = _infos.getOutputRegisterId();
+  bool const producesBool =
+      _kernel->resultType() == ExpressionKernel::ResultType::Bool;
+  for (size_t i = 0; i < to - from; ++i) {
+    auto [state, input] =
+        inputRange.nextDataRow(AqlItemBlockInputRange::HasDataRow{});
+    TRI_ASSERT(input.isInitialized());
+    if (producesBool) {
+      AqlValueHintBool const value(_kernel->boolResult(i));
+      output.moveValueInto(outReg, input, value);
+    } else {
+      AqlValueHintDouble const value(_kernel->numberResult(i));
+      output.moveValueInto(outReg, input, value);
+    }
+    output.advanceRow();
+  }
+  return true;
+}
+
 template<>
 void CalculationExecutor<CalculationType::V8Condition>::doEvaluation(
     InputAqlItemRow& input, OutputAqlItemRow& output) {
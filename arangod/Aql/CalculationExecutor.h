@@ -31,6 +31,7 @@
 #include "Aql/types.h"
 #include "Transaction/Methods.h"
 
+#include <memory>
 #include <unordered_set>
 #include <vector>
 
@@ -44,6 +45,7 @@ namespace aql {
 struct AqlCall;
 class AqlItemBlockInputRange;
 class Expression;
+class ExpressionKernel;
 class OutputAqlItemRow;
 class QueryContext;
 template<BlockPassthrough>
@@ -107,10 +109,24 @@ class CalculationExecutor {
   [[nodiscard]] std::tuple<ExecutorState, Stats, AqlCall> produceRows(
       AqlItemBlockInputRange& inputRange, OutputAqlItemRow& output);
 
+#ifdef ARANGODB_USE_GOOGLE_TESTS
+  // whether the compiled batch evaluation kernel is (still) in use
+  [[nodiscard]] bool usesKernel() const noexcept { return _kernel != nullptr; }
+  // number of rows evaluated by the kernel
+  [[nodiscard]] size_t kernelHitRows() const noexcept { return _kernelHitRows; }
+#endif
+
  private:
   // specialized implementations
   void doEvaluation(InputAqlItemRow& input, OutputAqlItemRow& output);
 
+  // evaluate the expression for all consecutive data rows at the current
+  // position of the input range at once, using the compiled kernel. returns
+  // false if nothing was produced, and the rows must be evaluated one by one.
+  // Only for Conditions
+  bool doBatchEvaluation(AqlItemBlockInputRange& inputRange,
+                         OutputAqlItemRow& output);
+
   // Only for V8Conditions
   template<CalculationType U = calculationType,
            typename = std::enable_if_t<U == CalculationType::V8Condition>>
@@ -128,6 +144,19 @@ class CalculationExecutor {
   aql::AqlFunctionsInternalCache _aqlFunctionsInternalCache;
   CalculationExecutorInfos& _infos;
 
+  // compiled batch evaluation kernel, if the expression is simple enough.
+  // only used for Conditions
+  std::unique_ptr<ExpressionKernel> _kernel;
+  // number of rows in batches the kernel could not evaluate, and number of
+  // rows in batches it evaluated successfully. used to give up on the kernel
+  // if most of the input data does not suit it
+  size_t _kernelMissRows;
+  size_t _kernelHitRows;
+  // number of rows left from the last batch the kernel could not evaluate,
+  // not counting the row the kernel was tried on. these are evaluated one
+  // by one
+  size_t _kernelSkipRows;
+
   Fetcher& _fetcher;
 
   InputAqlItemRow _currentRow;
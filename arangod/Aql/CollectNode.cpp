@@ -27,6 +27,7 @@
 #include "Aql/CountCollectExecutor.h"
 #include "Aql/DistinctCollectExecutor.h"
 #include "Aql/ExecutionBlockImpl.tpp"
+#include "Aql/ExecutionEngine.h"
 #include "Aql/ExecutionNodeId.h"
 #include "Aql/ExecutionPlan.h"
 #include "Aql/HashedCollectExecutor.h"
@@ -36,6 +37,7 @@
 #include "Aql/SortedCollectExecutor.h"
 #include "Aql/VariableGenerator.h"
 #include "Aql/WalkerWorker.h"
+#include "RestServer/TemporaryStorageFeature.h"
 #include "Transaction/Methods.h"
 
 #include <velocypack/Builder.h>
@@ -299,7 +301,14 @@ std::unique_ptr<ExecutionBlock> CollectNode::createBlock(
           _expressionVariable, std::move(aggregateTypes),
           std::move(inputVariables), std::move(aggregateRegisters),
           &_plan->getAst()->query().vpackOptions(),
-          _plan->getAst()->query().resourceMonitor());
+          _plan->getAst()->query().resourceMonitor(), _options.parallelism,
+          &engine.getQuery()
+               .vocbase()
+               .server()
+               .getFeature<TemporaryStorageFeature>(),
+          engine.getQuery().queryOptions().spillOverThresholdNumRows,
+          engine.getQuery().queryOptions().spillOverThresholdMemoryUsage,
+          /*useValueArena*/ true);
 
       return std::make_unique<ExecutionBlockImpl<HashedCollectExecutor>>(
           &engine, this, std::move(registerInfos), std::move(executorInfos));
@@ -393,7 +402,8 @@ std::unique_ptr<ExecutionBlock> CollectNode::createBlock(
       TRI_ASSERT(groupRegisters.size() == 1);
       auto executorInfos = DistinctCollectExecutorInfos(
           groupRegisters.front(), &_plan->getAst()->query().vpackOptions(),
-          _plan->getAst()->query().resourceMonitor());
+          _plan->getAst()->query().resourceMonitor(),
+          /*useValueArena*/ true);
 
       return std::make_unique<ExecutionBlockImpl<DistinctCollectExecutor>>(
           &engine, this, std::move(registerInfos), std::move(executorInfos));
@@ -802,11 +812,20 @@ bool CollectNode::hasExpressionVariable() const {
   return _expressionVariable != nullptr;
 }
 
+Variable const* CollectNode::expressionVariable() const {
+  return _expressionVariable;
+}
+
 void CollectNode::expressionVariable(Variable const* variable) {
   TRI_ASSERT(!hasExpressionVariable());
   _expressionVariable = variable;
 }
 
+void CollectNode::clearExpressionVariable() {
+  TRI_ASSERT(hasExpressionVariable());
+  _expressionVariable = nullptr;
+}
+
 bool CollectNode::hasKeepVariables() const { return !_keepVariables.empty(); }
 
 std::vector<Variable const*> const& CollectNode::keepVariables() const {
@@ -24,6 +24,8 @@
 #include "CollectOptions.h"
 #include "Basics/Exceptions.h"
 
+#include <algorithm>
+
 #include <velocypack/Builder.h>
 #include <velocypack/Slice.h>
 
@@ -31,12 +33,16 @@ using namespace arangodb::aql;
 
 /// @brief constructor
 CollectOptions::CollectOptions(VPackSlice slice)
-    : method(CollectMethod::UNDEFINED) {
+    : method(CollectMethod::UNDEFINED), parallelism(1) {
   VPackSlice v = slice.get("collectOptions");
   if (v.isObject()) {
-    v = v.get("method");
-    if (v.isString()) {
-      method = methodFromString(v.stringView());
+    VPackSlice value = v.get("method");
+    if (value.isString()) {
+      method = methodFromString(value.stringView());
+    }
+    value = v.get("parallelism");
+    if (value.isNumber()) {
+      parallelism = std::max<size_t>(1, value.getNumber<size_t>());
     }
   }
 }
@@ -55,6 +61,9 @@ bool CollectOptions::shouldUseMethod(CollectMethod m) const {
 void CollectOptions::toVelocyPack(VPackBuilder& builder) const {
   VPackObjectBuilder guard(&builder);
   builder.add("method", VPackValue(methodToString(method)));
+  if (parallelism > 1) {
+    builder.add("parallelism", VPackValue(parallelism));
+  }
 }
 
 /// @brief get the aggregation method from a string
@@ -96,4 +105,5 @@ std::string_view CollectOptions::methodToString(
                                  "cannot stringify unknown aggregation method");
 }
 
-CollectOptions::CollectOptions() : method(CollectMethod::UNDEFINED) {}
+CollectOptions::CollectOptions()
+    : method(CollectMethod::UNDEFINED), parallelism(1) {}
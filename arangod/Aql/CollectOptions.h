@@ -23,6 +23,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <string>
 #include <string_view>
 
@@ -65,6 +66,10 @@ struct CollectOptions final {
   static std::string_view methodToString(CollectOptions::CollectMethod method);
 
   CollectMethod method;
+
+  /// @brief number of partitions a hashed COLLECT is aggregated in, on
+  /// scheduler threads. 1 means no parallelism
+  std::size_t parallelism;
 };
 
 struct GroupVarInfo final {
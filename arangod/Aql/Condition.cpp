@@ -46,6 +46,8 @@
 #include "Transaction/CountCache.h"
 #include "Transaction/Methods.h"
 
+#include <algorithm>
+
 #include <velocypack/Builder.h>
 
 #ifdef _WIN32
@@ -188,13 +190,40 @@ AstNode* normalizeCompare(Ast* ast, AstNode* node) {
   return node;
 }
 
+// converts n-ary AND/OR nodes in the subtree back into chains of binary
+// operators, so that the subtree can be kept as an opaque member of an AND
+// in a DNF condition. n-ary nodes are only created for conditions, so all
+// other node types are left alone
+AstNode* toResidualCondition(Ast* ast, AstNode* node) {
+  if (node->type != NODE_TYPE_OPERATOR_NARY_AND &&
+      node->type != NODE_TYPE_OPERATOR_NARY_OR) {
+    return node;
+  }
+
+  bool const isAnd = (node->type == NODE_TYPE_OPERATOR_NARY_AND);
+  size_t const n = node->numMembers();
+  if (n == 0) {
+    // an empty AND is true, an empty OR is false
+    return ast->createNodeValueBool(isAnd);
+  }
+
+  AstNode* result = toResidualCondition(ast, node->getMemberUnchecked(0));
+  for (size_t i = 1; i < n; ++i) {
+    result = ast->createNodeBinaryOperator(
+        isAnd ? NODE_TYPE_OPERATOR_BINARY_AND : NODE_TYPE_OPERATOR_BINARY_OR,
+        result, toResidualCondition(ast, node->getMemberUnchecked(i)));
+  }
+  return result;
+}
+
 struct PermutationState {
   PermutationState(aql::AstNode const* value, size_t n) noexcept
       : value(value), current(0), n(n) {}
 
   aql::AstNode const* getValue() const {
-    if (value->type == aql::NODE_TYPE_OPERATOR_BINARY_OR ||
-        value->type == aql::NODE_TYPE_OPERATOR_NARY_OR) {
+    // only n-ary ORs are expanded. binary ORs are residual conditions,
+    // which must be kept as a whole
+    if (value->type == aql::NODE_TYPE_OPERATOR_NARY_OR) {
       TRI_ASSERT(current < n);
       return value->getMember(current);
     }
@@ -1984,31 +2013,39 @@ AstNode* Condition::transformNodePostorder(
       ::arangodb::containers::SmallVector<::PermutationState, 4> clauses;
       clauses.reserve(n);
 
+      // fetch maximum number of condition members from query options
+      size_t const maxNumberOfConditionMembers = std::max<size_t>(
+          _ast->query().queryOptions().maxDNFConditionMembers, 1);
+
       size_t orMembers = 1;
       for (size_t i = 0; i < n; ++i) {
         auto sub = node->getMemberUnchecked(i);
-        size_t const subMembers =
+        size_t subMembers =
             (sub->type == NODE_TYPE_OPERATOR_NARY_OR ? sub->numMembers() : 1);
 
+        // check if there would be too many members in the DNF version of
+        // the condition. we may suffer from combinatorial explosion here.
+        // this is checked before any expansion work is done, and before
+        // the multiplication can overflow.
+        if (subMembers > 1 &&
+            subMembers > (maxNumberOfConditionMembers - 1) / orMembers) {
+          TRI_IF_FAILURE("Condition::failIfTooComplex") {
+            THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_QUERY_DNF_COMPLEXITY,
+                                           "too complex query condition");
+          }
+          // do not distribute this OR over the other members, but keep
+          // it as a residual filter condition. it cannot be used for
+          // index lookups, but all other members of the AND still can.
+          sub = ::toResidualCondition(_ast, sub);
+          node->changeMember(i, sub);
+          subMembers = 1;
+        }
+
         clauses.emplace_back(sub, subMembers);
         orMembers *= subMembers;
       }
       TRI_ASSERT(clauses.size() == n);
-
-      // fetch maximum number of condition members from query options
-      size_t maxNumberOfConditionMembers =
-          _ast->query().queryOptions().maxDNFConditionMembers;
-
-      // check if there would be too many members in the DNF version of
-      // the condition. we may suffer from combinatorial explosion here.
-      if (orMembers >= maxNumberOfConditionMembers) {
-        // throw a special error about a too complex query condition.
-        // this will be handled by the callers, so that they will continue
-        // with a simplified version of the condition (which may not be
-        // usable for index lookups).
-        THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_QUERY_DNF_COMPLEXITY,
-                                       "too complex query condition");
-      }
+      TRI_ASSERT(orMembers < maxNumberOfConditionMembers || orMembers == 1);
 
       auto newOperator = _ast->createNode(NODE_TYPE_OPERATOR_NARY_OR);
       _ast->resources().reserveChildNodes(newOperator, orMembers);
@@ -29,6 +29,7 @@
 #include "Aql/OutputAqlItemRow.h"
 #include "Aql/SingleRowFetcher.h"
 #include "Aql/SortExecutor.h"
+#include "Aql/SortLimitThreshold.h"
 #include "Aql/SortRegister.h"
 #include "Aql/Stats.h"
 #include "Basics/Exceptions.h"
@@ -112,6 +113,16 @@ void ConstrainedSortExecutor::pushRow(InputAqlItemRow const& input) {
 
   // now restore heap condition
   std::push_heap(_rows.begin(), _rows.end(), *_cmpHeap);
+
+  if (_rowsPushed >= _infos.limit()) {
+    auto* threshold = _infos.sortLimitThreshold();
+    if (threshold != nullptr) {
+      // the heap is full. rows that are sorted after its first element can
+      // be discarded upstream
+      threshold->update(_heapBuffer->getValueReference(
+          _rows.front(), _infos.sortRegisters()[0].reg));
+    }
+  }
 }
 
 bool ConstrainedSortExecutor::compareInput(size_t rowPos,
@@ -172,6 +183,10 @@ ConstrainedSortExecutor::ConstrainedSortExecutor(Fetcher& fetcher,
   }
 
   _cmpHeap->setBuffer(_heapBuffer.get());
+
+  if (auto* threshold = _infos.sortLimitThreshold(); threshold != nullptr) {
+    threshold->reset();
+  }
 }
 
 ConstrainedSortExecutor::~ConstrainedSortExecutor() {
@@ -27,6 +27,7 @@
 #include "DistinctCollectExecutor.h"
 
 #include "Aql/AqlValue.h"
+#include "Aql/AqlValueArena.h"
 #include "Aql/InputAqlItemRow.h"
 #include "Aql/OutputAqlItemRow.h"
 #include "Aql/RegisterInfos.h"
@@ -36,6 +37,7 @@
 #include "Basics/ResourceUsage.h"
 #include "Logger/LogMacros.h"
 
+#include <cmath>
 #include <utility>
 
 #define INTERNAL_LOG_DC LOG_DEVEL_IF(false)
@@ -45,10 +47,12 @@ using namespace arangodb::aql;
 
 DistinctCollectExecutorInfos::DistinctCollectExecutorInfos(
     std::pair<RegisterId, RegisterId> groupRegister,
-    velocypack::Options const* opts, arangodb::ResourceMonitor& resourceMonitor)
+    velocypack::Options const* opts, arangodb::ResourceMonitor& resourceMonitor,
+    bool useValueArena)
     : _groupRegister(std::move(groupRegister)),
       _vpackOptions(opts),
-      _resourceMonitor(resourceMonitor) {}
+      _resourceMonitor(resourceMonitor),
+      _useValueArena(useValueArena) {}
 
 std::pair<RegisterId, RegisterId> const&
 DistinctCollectExecutorInfos::getGroupRegister() const {
@@ -67,7 +71,12 @@ arangodb::ResourceMonitor& DistinctCollectExecutorInfos::getResourceMonitor()
 DistinctCollectExecutor::DistinctCollectExecutor(Fetcher&, Infos& infos)
     : _infos(infos),
       _seen(1024, AqlValueGroupHash(1),
-            AqlValueGroupEqual(_infos.vpackOptions())) {}
+            AqlValueGroupEqual(_infos.vpackOptions())) {
+  if (_infos.useValueArena()) {
+    _valueArena =
+        std::make_unique<AqlValueArena>(_infos.getResourceMonitor());
+  }
+}
 
 DistinctCollectExecutor::~DistinctCollectExecutor() { destroyValues(); }
 
@@ -94,7 +103,15 @@ void DistinctCollectExecutor::destroyValues() {
     const_cast<AqlValue*>(&value)->destroy();
   }
   _seen.clear();
+  _seenNumbers.clear();
+  _seenStrings.clear();
+  memoryUsage += _scalarMemoryUsage;
+  _scalarMemoryUsage = 0;
   _infos.getResourceMonitor().decreaseMemoryUsage(memoryUsage);
+  if (_valueArena != nullptr) {
+    // the seen values were the only references into the arena
+    _valueArena->clear();
+  }
 }
 
 const DistinctCollectExecutor::Infos& DistinctCollectExecutor::infos()
@@ -132,19 +149,26 @@ auto DistinctCollectExecutor::produceRows(AqlItemBlockInputRange& inputRange,
     // their contents
     AqlValue groupValue = input.getValue(_infos.getGroupRegister().second);
 
+    if (!groupValue.isRange()) {
+      if (auto isNew = addSeenScalar(groupValue.slice()); isNew.has_value()) {
+        if (*isNew) {
+          output.cloneValueInto(_infos.getGroupRegister().first, input,
+                                groupValue);
+          output.advanceRow();
+        }
+        continue;
+      }
+    }
+
     // now check if we already know this group
     if (!_seen.contains(groupValue)) {
-      size_t memoryUsage = memoryUsageForGroup(groupValue);
-      arangodb::ResourceUsageScope guard(_infos.getResourceMonitor(),
-                                         memoryUsage);
+      addSeen(groupValue);
 
-      output.cloneValueInto(_infos.getGroupRegister().first, input, groupValue);
+      // the copy in _seen may be stored in the arena, which is released
+      // independently of the output. so the output gets a copy of its own
+      output.cloneValueInto(_infos.getGroupRegister().first, input,
+                            groupValue);
       output.advanceRow();
-
-      _seen.emplace(groupValue.clone());
-
-      // now we are responsible for memory tracking
-      guard.steal();
     }
   }
 
@@ -183,23 +207,102 @@ auto DistinctCollectExecutor::skipRowsRange(AqlItemBlockInputRange& inputRange,
     // their contents
     AqlValue groupValue = input.getValue(_infos.getGroupRegister().second);
 
+    if (!groupValue.isRange()) {
+      if (auto isNew = addSeenScalar(groupValue.slice()); isNew.has_value()) {
+        if (*isNew) {
+          skipped += 1;
+          call.didSkip(1);
+        }
+        continue;
+      }
+    }
+
     // now check if we already know this group
     if (!_seen.contains(groupValue)) {
       skipped += 1;
       call.didSkip(1);
 
-      size_t memoryUsage = memoryUsageForGroup(groupValue);
-      arangodb::ResourceUsageScope guard(_infos.getResourceMonitor(),
-                                         memoryUsage);
+      addSeen(groupValue);
+    }
+  }
 
-      _seen.emplace(groupValue.clone());
+  return {inputRange.upstreamState(), {}, skipped, {}};
+}
 
-      // now we are responsible for memory tracking
-      guard.steal();
+AqlValue DistinctCollectExecutor::cloneValue(AqlValue const& value) {
+  if (_valueArena != nullptr) {
+    return _valueArena->intern(value);
+  }
+  return value.clone();
+}
+
+AqlValue DistinctCollectExecutor::addSeen(AqlValue const& value) {
+  AqlValue copy = cloneValue(value);
+  AqlValueGuard valueGuard{copy, true};
+
+  size_t memoryUsage = memoryUsageForGroup(copy);
+  arangodb::ResourceUsageScope guard(_infos.getResourceMonitor(), memoryUsage);
+
+  _seen.emplace(copy);
+  valueGuard.steal();
+
+  // now we are responsible for memory tracking
+  guard.steal();
+  return copy;
+}
+
+std::optional<bool> DistinctCollectExecutor::addSeenScalar(
+    velocypack::Slice value) {
+  // doubles are exact for integers below 2^53, and numbers of different
+  // types are compared as doubles
+  constexpr int64_t exactLimit = int64_t(1) << 53;
+
+  if (value.isString()) {
+    std::string_view s = value.stringView();
+    if (_seenStrings.contains(s)) {
+      return false;
     }
+    size_t memoryUsage = 3 * sizeof(void*) + sizeof(std::string) + s.size();
+    arangodb::ResourceUsageScope guard(_infos.getResourceMonitor(),
+                                       memoryUsage);
+    _seenStrings.emplace(s);
+    guard.steal();
+    _scalarMemoryUsage += memoryUsage;
+    return true;
   }
 
-  return {inputRange.upstreamState(), {}, skipped, {}};
+  int64_t number;
+  if (value.isSmallInt() || value.isInt()) {
+    number = value.getInt();
+  } else if (value.isUInt()) {
+    uint64_t u = value.getUInt();
+    if (u >= static_cast<uint64_t>(exactLimit)) {
+      return std::nullopt;
+    }
+    number = static_cast<int64_t>(u);
+  } else if (value.isDouble()) {
+    double d = value.getDouble();
+    if (!(std::abs(d) < static_cast<double>(exactLimit)) ||
+        std::trunc(d) != d) {
+      return std::nullopt;
+    }
+    number = static_cast<int64_t>(d);
+  } else {
+    return std::nullopt;
+  }
+  if (number <= -exactLimit || number >= exactLimit) {
+    return std::nullopt;
+  }
+
+  if (_seenNumbers.contains(number)) {
+    return false;
+  }
+  size_t memoryUsage = 2 * sizeof(int64_t);
+  arangodb::ResourceUsageScope guard(_infos.getResourceMonitor(), memoryUsage);
+  _seenNumbers.emplace(number);
+  guard.steal();
+  _scalarMemoryUsage += memoryUsage;
+  return true;
 }
 
 size_t DistinctCollectExecutor::memoryUsageForGroup(
@@ -36,7 +36,10 @@
 
 #include "Containers/FlatHashSet.h"
 
+#include <cstdint>
 #include <memory>
+#include <optional>
+#include <string>
 #include <unordered_set>
 
 namespace arangodb {
@@ -47,6 +50,7 @@ class Methods;
 }
 namespace aql {
 
+class AqlValueArena;
 class InputAqlItemRow;
 class OutputAqlItemRow;
 class NoStats;
@@ -58,7 +62,8 @@ class DistinctCollectExecutorInfos {
  public:
   DistinctCollectExecutorInfos(std::pair<RegisterId, RegisterId> groupRegister,
                                velocypack::Options const* opts,
-                               arangodb::ResourceMonitor& resourceMonitor);
+                               arangodb::ResourceMonitor& resourceMonitor,
+                               bool useValueArena = false);
 
   DistinctCollectExecutorInfos() = delete;
   DistinctCollectExecutorInfos(DistinctCollectExecutorInfos&&) = default;
@@ -70,6 +75,7 @@ class DistinctCollectExecutorInfos {
       const;
   velocypack::Options const* vpackOptions() const;
   arangodb::ResourceMonitor& getResourceMonitor() const;
+  bool useValueArena() const noexcept { return _useValueArena; }
 
  private:
   /// @brief pairs, consisting of out register and in register
@@ -79,6 +85,9 @@ class DistinctCollectExecutorInfos {
   velocypack::Options const* _vpackOptions;
 
   arangodb::ResourceMonitor& _resourceMonitor;
+
+  /// @brief whether the seen values are stored in an arena of the executor
+  bool _useValueArena;
 };
 
 /**
@@ -127,11 +136,30 @@ class DistinctCollectExecutor {
   Infos const& infos() const noexcept;
   void destroyValues();
   size_t memoryUsageForGroup(AqlValue const& value) const;
+  /// @brief copy a value for storing it in _seen
+  AqlValue cloneValue(AqlValue const& value);
+  /// @brief store a copy of an unseen value, returns the copy
+  AqlValue addSeen(AqlValue const& value);
+  /// @brief records integral numbers and strings in the typed sets. returns
+  /// true if the value is new, false if it was seen before, and nullopt if
+  /// the value needs to be handled via _seen
+  std::optional<bool> addSeenScalar(velocypack::Slice value);
 
  private:
   Infos const& _infos;
   containers::FlatHashSet<AqlValue, AqlValueGroupHash, AqlValueGroupEqual>
       _seen;
+  /// @brief seen integral numbers with an absolute value below 2^53, and
+  /// seen strings. these are by far the most common DISTINCT values, and the
+  /// typed sets avoid the generic hashing and comparison of AqlValues.
+  /// numbers in this range are equal to numbers outside of it under no
+  /// circumstances, so all other values can still be handled via _seen
+  containers::FlatHashSet<int64_t> _seenNumbers;
+  containers::FlatHashSet<std::string> _seenStrings;
+  size_t _scalarMemoryUsage = 0;
+  /// @brief storage for the values in _seen, may be a nullptr. cleared
+  /// together with _seen
+  std::unique_ptr<AqlValueArena> _valueArena;
 };
 
 }  // namespace aql
@@ -67,6 +67,11 @@ IndexIterator::DocumentCallback aql::getCallback(
       return true;
     }
 
+    if (!context.checkSortLimitThreshold(slice)) {
+      context.incrFiltered();
+      return false;
+    }
+
     // recycle our Builder object
     VPackBuilder& objectBuilder = context.getBuilder();
     objectBuilder.clear();
@@ -112,6 +117,11 @@ IndexIterator::DocumentCallback aql::getCallback(
       return true;
     }
 
+    if (!context.checkSortLimitThreshold(slice)) {
+      context.incrFiltered();
+      return false;
+    }
+
     InputAqlItemRow const& input = context.getInputRow();
     OutputAqlItemRow& output = context.getOutputRow();
     RegisterId registerId = context.getOutputRegister();
@@ -191,6 +201,7 @@ DocumentProducingFunctionContext::DocumentProducingFunctionContext(
       _filter(infos.getFilter()),
       _projections(infos.getProjections()),
       _filterProjections(infos.getFilterProjections()),
+      _sortLimitThresholdFilter(infos.getSortLimitThresholdFilter()),
       _resourceMonitor(infos.getResourceMonitor()),
       _numScanned(0),
       _numFiltered(0),
@@ -200,6 +211,7 @@ DocumentProducingFunctionContext::DocumentProducingFunctionContext(
       _checkUniqueness(false),
       _produceResult(infos.getProduceResult()),
       _allowCoveringIndexOptimization(false),
+      _checkSortLimitThresholdWithFilterProjections(false),
       _isLastIndex(false) {
   // build ExpressionContext for filtering if we need one
   if (hasFilter()) {
@@ -233,6 +245,7 @@ DocumentProducingFunctionContext::DocumentProducingFunctionContext(
       _filter(infos.getFilter()),
       _projections(infos.getProjections()),
       _filterProjections(infos.getFilterProjections()),
+      _sortLimitThresholdFilter(infos.getSortLimitThresholdFilter()),
       _resourceMonitor(infos.getResourceMonitor()),
       _numScanned(0),
       _numFiltered(0),
@@ -243,6 +256,9 @@ DocumentProducingFunctionContext::DocumentProducingFunctionContext(
                        infos.hasMultipleExpansions()),
       _produceResult(infos.getProduceResult()),
       _allowCoveringIndexOptimization(false),  // can be updated later
+      _checkSortLimitThresholdWithFilterProjections(
+          !_sortLimitThresholdFilter.empty() &&
+          _sortLimitThresholdFilter.isCoveredBy(_filterProjections)),
       _isLastIndex(false) {
   // build ExpressionContext for filtering if we need one
   if (hasFilter()) {
@@ -411,6 +427,13 @@ bool DocumentProducingFunctionContext::checkFilter(
   return checkFilter(ctx);
 }
 
+bool DocumentProducingFunctionContext::checkSortLimitThreshold(
+    velocypack::Slice slice) {
+  return _sortLimitThresholdFilter.empty() ||
+         !_sortLimitThresholdFilter.excludes(slice,
+                                             _sortLimitThresholdSnapshot);
+}
+
 bool DocumentProducingFunctionContext::checkFilter(
     DocumentProducingExpressionContext& ctx) {
   _killCheckCounter = (_killCheckCounter + 1) % 1024;
@@ -479,6 +502,12 @@ IndexIterator::CoveringCallback aql::getCallback(
       }
     }
     if constexpr (!skip) {
+      // the projections contain the attribute compared with the threshold
+      if (!context.checkSortLimitThreshold(objectBuilder.slice())) {
+        context.incrFiltered();
+        return false;
+      }
+
       InputAqlItemRow const& input = context.getInputRow();
       OutputAqlItemRow& output = context.getOutputRow();
       RegisterId registerId = context.getOutputRegister();
@@ -528,11 +557,27 @@ IndexIterator::CoveringCallback aql::getCallback(
     }
 
     if constexpr (!skip) {
+      bool const checkThresholdWithFilterProjections =
+          context.checkSortLimitThresholdWithFilterProjections();
+      if (checkThresholdWithFilterProjections &&
+          !context.checkSortLimitThreshold(objectBuilder.slice())) {
+        // the document does not need to be read at all
+        context.incrFiltered();
+        return false;
+      }
+
+      bool excluded = false;
       // read the full document from the storage engine only now,
       // after checking the filter condition
       context.getPhysical().read(
           context.getTrxPtr(), token,
           [&](LocalDocumentId const&, VPackSlice s) -> bool {
+            if (!checkThresholdWithFilterProjections &&
+                !context.checkSortLimitThreshold(s)) {
+              excluded = true;
+              return false;
+            }
+
             OutputAqlItemRow& output = context.getOutputRow();
             TRI_ASSERT(!output.isFull());
 
@@ -562,6 +607,11 @@ IndexIterator::CoveringCallback aql::getCallback(
             return false;
           },
           context.getReadOwnWrites());
+
+      if (excluded) {
+        context.incrFiltered();
+        return false;
+      }
     }
 
     return true;
@@ -34,6 +34,7 @@
 #include "Aql/types.h"
 #include "Aql/AqlFunctionsInternalCache.h"
 #include "Aql/Projections.h"
+#include "Aql/SortLimitThreshold.h"
 #include "Containers/FlatHashSet.h"
 #include "Indexes/IndexIterator.h"
 #include "StorageEngine/PhysicalCollection.h"
@@ -123,6 +124,16 @@ struct DocumentProducingFunctionContext {
   // called only for late materialization
   bool checkFilter(IndexIteratorCoveringData const* covering);
 
+  // called for documents and projections. returns false if the document
+  // cannot make it into the heap of a downstream SORT with a limit
+  bool checkSortLimitThreshold(velocypack::Slice slice);
+
+  // whether or not the sort limit threshold can be checked with the filter
+  // projections already, before reading the document
+  bool checkSortLimitThresholdWithFilterProjections() const noexcept {
+    return _checkSortLimitThresholdWithFilterProjections;
+  }
+
   void reset();
 
   void setIsLastIndex(bool val);
@@ -147,6 +158,10 @@ struct DocumentProducingFunctionContext {
   Expression* _filter;
   aql::Projections const& _projections;
   aql::Projections const& _filterProjections;
+  SortLimitThresholdFilter const& _sortLimitThresholdFilter;
+  /// @brief our copy of the sort limit threshold, so that checking it does
+  /// not need to acquire a lock
+  SortLimitThreshold::Snapshot _sortLimitThresholdSnapshot;
   ResourceMonitor& _resourceMonitor;
 
   uint64_t _numScanned;
@@ -173,6 +188,7 @@ struct DocumentProducingFunctionContext {
 
   bool const _produceResult;
   bool _allowCoveringIndexOptimization;
+  bool _checkSortLimitThresholdWithFilterProjections;
   /// @brief Flag if the current index pointer is the last of the list.
   ///        Used in uniqueness checks.
   bool _isLastIndex;
@@ -25,6 +25,7 @@
 
 #include "Aql/Ast.h"
 #include "Aql/AstNode.h"
+#include "Aql/ExecutionEngine.h"
 #include "Aql/ExecutionNode.h"
 #include "Aql/ExecutionPlan.h"
 #include "Aql/Expression.h"
@@ -84,6 +85,19 @@ DocumentProducingNode::DocumentProducingNode(ExecutionPlan* plan,
   if (!p.isNone()) {
     setMaxProjections(p.getNumber<size_t>());
   }
+
+  p = slice.get("sortLimitThreshold");
+  if (p.isObject()) {
+    std::vector<std::string> attribute;
+    for (VPackSlice name : VPackArrayIterator(p.get("attribute"))) {
+      attribute.emplace_back(name.copyString());
+    }
+    setSortLimitThreshold(
+        ExecutionNodeId{p.get("node").getNumber<ExecutionNodeId::BaseType>()},
+        std::move(attribute),
+        arangodb::basics::VelocyPackHelper::getBooleanValue(p, "ascending",
+                                                            true));
+  }
 }
 
 void DocumentProducingNode::cloneInto(ExecutionPlan* plan,
@@ -96,6 +110,8 @@ void DocumentProducingNode::cloneInto(ExecutionPlan* plan,
   c.setCanReadOwnWrites(canReadOwnWrites());
   c.setMaxProjections(maxProjections());
   c.setUseCache(useCache());
+  // the threshold is intentionally not cloned, as the clone may refer to a
+  // different SORT node
 }
 
 void DocumentProducingNode::replaceVariables(
@@ -139,6 +155,20 @@ void DocumentProducingNode::toVelocyPack(arangodb::velocypack::Builder& builder,
 
   builder.add(StaticStrings::UseCache, VPackValue(useCache()));
   builder.add(StaticStrings::MaxProjections, VPackValue(maxProjections()));
+
+  if (hasSortLimitThreshold()) {
+    builder.add(VPackValue("sortLimitThreshold"));
+    builder.openObject();
+    builder.add("node", VPackValue(_sortLimitThresholdNode.id()));
+    builder.add(VPackValue("attribute"));
+    builder.openArray();
+    for (auto const& name : _sortLimitThresholdAttribute) {
+      builder.add(VPackValue(name));
+    }
+    builder.close();
+    builder.add("ascending", VPackValue(_sortLimitThresholdAscending));
+    builder.close();
+  }
 }
 
 Variable const* DocumentProducingNode::outVariable() const {
@@ -169,6 +199,27 @@ void DocumentProducingNode::setProjections(
   _projections = std::move(projections);
 }
 
+void DocumentProducingNode::setSortLimitThreshold(
+    ExecutionNodeId sortNode, std::vector<std::string> attribute,
+    bool ascending) {
+  TRI_ASSERT(!attribute.empty() || !sortNode);
+  _sortLimitThresholdNode = sortNode;
+  _sortLimitThresholdAttribute = std::move(attribute);
+  _sortLimitThresholdAscending = ascending;
+}
+
+SortLimitThresholdFilter DocumentProducingNode::sortLimitThresholdFilter(
+    ExecutionEngine& engine) const {
+  SortLimitThresholdFilter result;
+  if (hasSortLimitThreshold()) {
+    result.threshold =
+        engine.sortLimitThreshold(_sortLimitThresholdNode, /*create*/ true);
+    result.attribute = _sortLimitThresholdAttribute;
+    result.ascending = _sortLimitThresholdAscending;
+  }
+  return result;
+}
+
 bool DocumentProducingNode::doCount() const {
   return _count && (_filter == nullptr);
 }
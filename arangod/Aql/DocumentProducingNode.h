@@ -29,7 +29,9 @@
 #include <unordered_set>
 #include <vector>
 
+#include "Aql/ExecutionNodeId.h"
 #include "Aql/Projections.h"
+#include "Aql/SortLimitThreshold.h"
 #include "Aql/types.h"
 #include "Utils/OperationOptions.h"
 
@@ -39,6 +41,7 @@ class Builder;
 class Slice;
 }  // namespace velocypack
 namespace aql {
+class ExecutionEngine;
 class ExecutionPlan;
 class Expression;
 struct Variable;
@@ -102,6 +105,24 @@ class DocumentProducingNode {
 
   void setMaxProjections(size_t value) noexcept { _maxProjections = value; }
 
+  /// @brief compare the produced documents with the threshold of the heap
+  /// of a downstream SORT node with a limit, so that documents which cannot
+  /// make it into the heap are discarded early
+  void setSortLimitThreshold(ExecutionNodeId sortNode,
+                             std::vector<std::string> attribute,
+                             bool ascending);
+
+  /// @brief whether or not the documents are compared with the threshold
+  /// of a downstream SORT node
+  bool hasSortLimitThreshold() const noexcept {
+    return static_cast<bool>(_sortLimitThresholdNode);
+  }
+
+  /// @brief returns the filter comparing the documents with the threshold
+  /// of the downstream SORT node, or an empty filter
+  SortLimitThresholdFilter sortLimitThresholdFilter(
+      ExecutionEngine& engine) const;
+
   // arbitrary default value for the maximum number of projected attributes
   static constexpr size_t kMaxProjections = 5;
 
@@ -125,6 +146,14 @@ class DocumentProducingNode {
   ReadOwnWrites _readOwnWrites{ReadOwnWrites::no};
 
   size_t _maxProjections{kMaxProjections};
+
+  /// @brief id of the SORT node whose threshold is used, if any
+  ExecutionNodeId _sortLimitThresholdNode{0};
+
+  /// @brief attribute of the documents the first sort criterion refers to
+  std::vector<std::string> _sortLimitThresholdAttribute;
+
+  bool _sortLimitThresholdAscending{true};
 };
 
 }  // namespace aql
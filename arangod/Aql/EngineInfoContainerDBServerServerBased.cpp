@@ -26,6 +26,8 @@
 #include "ApplicationFeatures/ApplicationServer.h"
 #include "Aql/Ast.h"
 #include "Aql/GraphNode.h"
+#include "Aql/QueryProfile.h"
+#include "Aql/Timing.h"
 #include "Aql/TraverserEngineShardLists.h"
 #include "Basics/StaticStrings.h"
 #include "Basics/StringUtils.h"
@@ -138,7 +140,8 @@ void EngineInfoContainerDBServerServerBased::closeSnippet(
 std::vector<bool> EngineInfoContainerDBServerServerBased::buildEngineInfo(
     QueryId clusterQueryId, VPackBuilder& infoBuilder, ServerID const& server,
     std::unordered_map<ExecutionNodeId, ExecutionNode*> const& nodesById,
-    std::map<ExecutionNodeId, ExecutionNodeId>& nodeAliases) {
+    std::map<ExecutionNodeId, ExecutionNodeId>& nodeAliases,
+    VPackSlice variables) {
   LOG_TOPIC("4bbe6", DEBUG, arangodb::Logger::AQL)
       << "Building Engine Info for " << server;
 
@@ -152,8 +155,7 @@ std::vector<bool> EngineInfoContainerDBServerServerBased::buildEngineInfo(
   addOptionsPart(infoBuilder, server);
   TRI_ASSERT(infoBuilder.isOpenObject());
 
-  addVariablesPart(infoBuilder);
-  TRI_ASSERT(infoBuilder.isOpenObject());
+  infoBuilder.add("variables", variables);
 
   infoBuilder.add("isModificationQuery",
                   VPackValue(_query.isModificationQuery()));
@@ -182,16 +184,14 @@ std::vector<bool> EngineInfoContainerDBServerServerBased::buildEngineInfo(
 
 arangodb::futures::Future<Result>
 EngineInfoContainerDBServerServerBased::buildSetupRequest(
-    transaction::Methods& trx, ServerID const& server, VPackSlice infoSlice,
-    std::vector<bool> didCreateEngine, MapRemoteToSnippet& snippetIds,
-    aql::ServerQueryIdList& serverToQueryId, std::mutex& serverToQueryIdLock,
-    network::ConnectionPool* pool,
+    transaction::Methods& trx, ServerID const& server,
+    VPackBuffer<uint8_t> buffer, std::vector<bool> didCreateEngine,
+    MapRemoteToSnippet& snippetIds, aql::ServerQueryIdList& serverToQueryId,
+    std::mutex& serverToQueryIdLock, network::ConnectionPool* pool,
     network::RequestOptions const& options) const {
   TRI_ASSERT(!server.starts_with("server:"));
 
-  auto byteSize = infoSlice.byteSize();
-  VPackBuffer<uint8_t> buffer(byteSize);
-  buffer.append(infoSlice.begin(), byteSize);
+  VPackSlice infoSlice(buffer.data());
 
   // add the transaction ID header
   network::Headers headers;
@@ -284,7 +284,8 @@ bool EngineInfoContainerDBServerServerBased::isNotSatelliteLeader(
 Result EngineInfoContainerDBServerServerBased::buildEngines(
     std::unordered_map<ExecutionNodeId, ExecutionNode*> const& nodesById,
     MapRemoteToSnippet& snippetIds, aql::ServerQueryIdList& serverToQueryId,
-    std::map<ExecutionNodeId, ExecutionNodeId>& nodeAliases) {
+    std::map<ExecutionNodeId, ExecutionNodeId>& nodeAliases,
+    QueryProfile* profile) {
   TRI_ASSERT(serverToQueryId.empty());
 
   // This needs to be a set with a defined order, it is important, that we
@@ -392,12 +393,25 @@ Result EngineInfoContainerDBServerServerBased::buildEngines(
     engineInformation.reserve(dbServers.size());
   }
 
+  // the variables are the same for all servers, so we serialize them only
+  // once
+  double start = currentSteadyClockValue();
+  VPackBuilder variables;
+  buildVariablesPart(variables);
+  double buildTime = currentSteadyClockValue() - start;
+
+  // the requests are sent while the requests for the following servers are
+  // still built, so that the servers can lock and instantiate their snippets
+  // in the meantime
   for (ServerID const& server : dbServers) {
     // Build Lookup Infos
+    start = currentSteadyClockValue();
     VPackBuilder infoBuilder;
     auto didCreateEngine = buildEngineInfo(clusterQueryId, infoBuilder, server,
-                                           nodesById, nodeAliases);
+                                           nodesById, nodeAliases,
+                                           variables.slice());
     VPackSlice infoSlice = infoBuilder.slice();
+    buildTime += currentSteadyClockValue() - start;
 
     if (isNotSatelliteLeader(infoSlice)) {
       continue;
@@ -410,10 +424,17 @@ Result EngineInfoContainerDBServerServerBased::buildEngines(
       serversAdded.emplace(server);
     }
 
-    networkCalls.emplace_back(
-        buildSetupRequest(trx, server, infoSlice, didCreateEngine, snippetIds,
-                          serverToQueryId, serverToQueryIdLock, pool, options));
-    if (!isReadOnly) {
+    if (isReadOnly) {
+      networkCalls.emplace_back(buildSetupRequest(
+          trx, server, std::move(*infoBuilder.steal()),
+          std::move(didCreateEngine), snippetIds, serverToQueryId,
+          serverToQueryIdLock, pool, options));
+    } else {
+      VPackBuffer<uint8_t> buffer(infoSlice.byteSize());
+      buffer.append(infoSlice.begin(), infoSlice.byteSize());
+      networkCalls.emplace_back(buildSetupRequest(
+          trx, server, std::move(buffer), didCreateEngine, snippetIds,
+          serverToQueryId, serverToQueryIdLock, pool, options));
       // need to keep a copy of the request only in case of write queries,
       // when it is possible that the initial lock request fails due to a
       // lock timeout error
@@ -422,6 +443,7 @@ Result EngineInfoContainerDBServerServerBased::buildEngines(
     }
     _query.incHttpRequests(unsigned(1));
   }
+  start = currentSteadyClockValue();
 
   futures::Future<Result> fastPathResult =
       futures::collectAll(networkCalls)
@@ -451,6 +473,14 @@ Result EngineInfoContainerDBServerServerBased::buildEngines(
             // we see was LOCK_TIMEOUT.
             return res;
           });
+  fastPathResult.wait();
+  if (profile != nullptr) {
+    profile->addClusterSetupTime(
+        QueryProfile::ClusterSetupPhase::BuildingRequests, buildTime);
+    profile->addClusterSetupTime(
+        QueryProfile::ClusterSetupPhase::AwaitingServers,
+        currentSteadyClockValue() - start);
+  }
   if (fastPathResult.get().fail()) {
     if (fastPathResult.get().isNot(TRI_ERROR_LOCK_TIMEOUT)) {
       // we got an error. this will trigger the cleanupGuard!
@@ -539,6 +569,14 @@ Result EngineInfoContainerDBServerServerBased::buildEngines(
     std::string serverBefore;
 #endif
     // fallback routine, use synchronous requests (slowPath)
+    start = currentSteadyClockValue();
+    auto slowPathGuard = scopeGuard([profile, start]() noexcept {
+      if (profile != nullptr) {
+        profile->addClusterSetupTime(
+            QueryProfile::ClusterSetupPhase::LockingInOrder,
+            currentSteadyClockValue() - start);
+      }
+    });
     for (auto& [server, buffer, didCreateEngine] : engineInformation) {
 #ifdef ARANGODB_ENABLE_MAINTAINER_MODE
       // If the serverBefore has a smaller ID we allways contact by increasing
@@ -563,7 +601,7 @@ Result EngineInfoContainerDBServerServerBased::buildEngines(
           infoSlice, overwrittenOptions.slice(), false);
 
       auto request = buildSetupRequest(
-          trx, std::move(server), newRequest.slice(),
+          trx, std::move(server), std::move(*newRequest.steal()),
           std::move(didCreateEngine), snippetIds, serverToQueryId,
           serverToQueryIdLock, pool, options);
       _query.incHttpRequests(unsigned(1));
@@ -796,11 +834,11 @@ void EngineInfoContainerDBServerServerBased::addOptionsPart(
 #endif
 }
 
-// Insert the Variables information into the message to be sent to DBServers
-void EngineInfoContainerDBServerServerBased::addVariablesPart(
+// Serialize the Variables information, which is the same in the messages to
+// all DBServers
+void EngineInfoContainerDBServerServerBased::buildVariablesPart(
     arangodb::velocypack::Builder& builder) const {
-  TRI_ASSERT(builder.isOpenObject());
-  builder.add(VPackValue("variables"));
+  TRI_ASSERT(builder.isEmpty());
   // This will open and close an Object.
   _query.ast()->variables()->toVelocyPack(builder);
 }
@@ -53,6 +53,7 @@ class ExecutionNode;
 class GatherNode;
 class GraphNode;
 class QueryContext;
+struct QueryProfile;
 class QuerySnippet;
 
 class EngineInfoContainerDBServerServerBased {
@@ -85,10 +86,13 @@ class EngineInfoContainerDBServerServerBased {
   //   In case the network is broken and this shutdown request is lost
   //   the DBServers will clean up their snippets after a TTL.
   //   simon: in v3.7 we get a global QueryId for all snippets on a server
+  //   The time spent in the phases of the setup is added to the profile,
+  //   unless it is a nullptr.
   Result buildEngines(
       std::unordered_map<ExecutionNodeId, ExecutionNode*> const& nodesById,
       MapRemoteToSnippet& snippetIds, aql::ServerQueryIdList& serverQueryIds,
-      std::map<ExecutionNodeId, ExecutionNodeId>& nodeAliases);
+      std::map<ExecutionNodeId, ExecutionNodeId>& nodeAliases,
+      QueryProfile* profile);
 
   // Insert a GraphNode that needs to generate TraverserEngines on
   // the DBServers. The GraphNode itself will retain on the coordinator.
@@ -111,6 +115,8 @@ class EngineInfoContainerDBServerServerBased {
    * responsible for more then one shard we need to duplicate some nodes in the
    * query (e.g. an IndexNode can only access one shard at a time) this list can
    * map cloned node -> original node ids.
+   * @param variables The serialized variables of the query, which are the
+   * same for all servers.
    *
    * @return A vector with one entry per GraphNode in the query (in order) it
    * indicates if this Server has created a GraphEngine for this Node and needs
@@ -119,10 +125,12 @@ class EngineInfoContainerDBServerServerBased {
   std::vector<bool> buildEngineInfo(
       QueryId clusterQueryId, VPackBuilder& infoBuilder, ServerID const& server,
       std::unordered_map<ExecutionNodeId, ExecutionNode*> const& nodesById,
-      std::map<ExecutionNodeId, ExecutionNodeId>& nodeAliases);
+      std::map<ExecutionNodeId, ExecutionNodeId>& nodeAliases,
+      VPackSlice variables);
 
   arangodb::futures::Future<Result> buildSetupRequest(
-      transaction::Methods& trx, ServerID const& server, VPackSlice infoSlice,
+      transaction::Methods& trx, ServerID const& server,
+      VPackBuffer<uint8_t> buffer,
       std::vector<bool> didCreateEngine, MapRemoteToSnippet& snippetIds,
       aql::ServerQueryIdList& serverToQueryId, std::mutex& serverToQueryIdLock,
       network::ConnectionPool* pool,
@@ -156,8 +164,9 @@ class EngineInfoContainerDBServerServerBased {
   void addOptionsPart(arangodb::velocypack::Builder& builder,
                       ServerID const& server) const;
 
-  // Insert the Variables information into the message to be send to DBServers
-  void addVariablesPart(arangodb::velocypack::Builder& builder) const;
+  // Serialize the Variables information, which is the same in the messages to
+  // all DBServers
+  void buildVariablesPart(arangodb::velocypack::Builder& builder) const;
 
   // Insert the Snippets information into the message to be send to DBServers
   void addSnippetPart(
@@ -131,11 +131,18 @@ EnumerateCollectionExecutor::EnumerateCollectionExecutor(Fetcher& fetcher,
       _currentRow(InputAqlItemRow{CreateInvalidInputRowHint{}}) {
   TRI_ASSERT(_trx.status() == transaction::Status::RUNNING);
 
-  _cursor = _trx.indexScan(
-      _infos.getQuery().resourceMonitor(), _infos.getCollection()->name(),
-      (_infos.getRandom() ? transaction::Methods::CursorType::ANY
-                          : transaction::Methods::CursorType::ALL),
-      infos.canReadOwnWrites());
+  if (auto const& range = _infos.getDocumentRange(); range.has_value()) {
+    TRI_ASSERT(!_infos.getRandom());
+    _cursor = _trx.indexScanRange(
+        _infos.getQuery().resourceMonitor(), _infos.getCollection()->name(),
+        range->first, range->second, infos.canReadOwnWrites());
+  } else {
+    _cursor = _trx.indexScan(
+        _infos.getQuery().resourceMonitor(), _infos.getCollection()->name(),
+        (_infos.getRandom() ? transaction::Methods::CursorType::ANY
+                            : transaction::Methods::CursorType::ALL),
+        infos.canReadOwnWrites());
+  }
 
   if (!_infos.getCount()) {
     if (_infos.getProduceResult()) {
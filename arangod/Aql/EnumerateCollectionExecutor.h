@@ -31,8 +31,10 @@
 #include "Aql/InputAqlItemRow.h"
 #include "Aql/RegisterInfos.h"
 #include "Transaction/Methods.h"
+#include "VocBase/Identifiers/LocalDocumentId.h"
 
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -95,6 +97,28 @@ class EnumerateCollectionExecutorInfos {
 
   ReadOwnWrites canReadOwnWrites() const noexcept { return _readOwnWrites; }
 
+  /// @brief discard documents that cannot make it into the heap of a
+  /// downstream SORT with a limit
+  void setSortLimitThresholdFilter(SortLimitThresholdFilter filter) {
+    _sortLimitThresholdFilter = std::move(filter);
+  }
+
+  SortLimitThresholdFilter const& getSortLimitThresholdFilter()
+      const noexcept {
+    return _sortLimitThresholdFilter;
+  }
+
+  /// @brief only enumerate the documents with a LocalDocumentId in the
+  /// range [lower, upper), for scanning a collection in parallel
+  void setDocumentRange(LocalDocumentId lower, LocalDocumentId upper) {
+    _documentRange.emplace(lower, upper);
+  }
+
+  std::optional<std::pair<LocalDocumentId, LocalDocumentId>> const&
+  getDocumentRange() const noexcept {
+    return _documentRange;
+  }
+
  private:
   aql::QueryContext& _query;
   Collection const* _collection;
@@ -108,6 +132,8 @@ class EnumerateCollectionExecutorInfos {
   bool const _random;
   bool const _count;
   ReadOwnWrites const _readOwnWrites;
+  SortLimitThresholdFilter _sortLimitThresholdFilter;
+  std::optional<std::pair<LocalDocumentId, LocalDocumentId>> _documentRange;
 };
 
 /**
@@ -286,6 +286,16 @@ class ExecutionBlockImpl final : public ExecutionBlock {
   // Will as a side effect modify _outputItemRow
   void ensureOutputBlock(AqlCall&& call);
 
+  // Number of rows for the next output block, so that the block is not
+  // much larger than kTargetOutputBlockMemoryUsage, based on the size of
+  // the rows produced so far. Between kMinAdaptiveBatchSize and
+  // ExecutionBlock::DefaultBatchSize.
+  [[nodiscard]] size_t adaptiveBatchSize() const noexcept;
+
+  // Update the average size of the rows produced, using a block that is
+  // handed out to the client
+  void trackOutputBlockSize(SharedAqlItemBlockPtr const& block) noexcept;
+
   // Compute the next state based on the given call.
   // Can only be one of Skip/Produce/FullCount/FastForward/Done
   [[nodiscard]] auto nextState(AqlCall const& call) const -> ExecState;
@@ -495,6 +505,17 @@ class ExecutionBlockImpl final : public ExecutionBlock {
   bool _executorReturnedDone = false;
 
   bool _initialized = false;
+
+  // memory usage an output block should not exceed by much. wide rows, e.g.
+  // full documents, lead to smaller blocks, so that one block still fits
+  // into the CPU caches
+  static constexpr size_t kTargetOutputBlockMemoryUsage = 1024 * 1024;
+
+  // lower bound for adaptive block sizes, to limit the per-call overhead
+  static constexpr size_t kMinAdaptiveBatchSize = 64;
+
+  // moving average of the dynamic memory usage per output row, in bytes
+  size_t _averageRowMemoryUsage = 0;
 };
 
 }  // namespace arangodb::aql
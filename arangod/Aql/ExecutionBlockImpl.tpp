@@ -49,6 +49,7 @@
 #include "Graph/Steps/SingleServerProviderStep.h"
 #include "Graph/algorithm-aliases.h"
 
+#include <algorithm>
 #include <type_traits>
 
 namespace arangodb {
@@ -110,6 +111,8 @@ class CountCollectExecutor;
 class DistinctCollectExecutor;
 class EnumerateCollectionExecutor;
 class EnumerateListExecutor;
+class HashJoinExecutor;
+class MergeJoinExecutor;
 }  // namespace aql
 
 namespace graph {
@@ -612,6 +615,16 @@ auto ExecutionBlockImpl<Executor>::allocateOutputBlock(AqlCall&& call)
       }
     }
 
+    if constexpr (!std::is_same_v<Executor, SubqueryStartExecutor>) {
+      // A hard limit (e.g. by a LIMIT downstream) caps the number of rows we
+      // may write. Shadow rows do not count against it, so only do this if
+      // there are none in the input.
+      if (call.hasHardLimit() && _lastRange.countShadowRows() == 0) {
+        blockSize = std::min(blockSize, call.getLimit());
+      }
+    }
+    blockSize = std::min(blockSize, adaptiveBatchSize());
+
     if (blockSize == 0) {
       // There is no data to be produced
       return createOutputRow(SharedAqlItemBlockPtr{nullptr}, std::move(call));
@@ -623,6 +636,36 @@ auto ExecutionBlockImpl<Executor>::allocateOutputBlock(AqlCall&& call)
   }
 }
 
+template<class Executor>
+size_t ExecutionBlockImpl<Executor>::adaptiveBatchSize() const noexcept {
+  size_t const rowMemoryUsage =
+      _averageRowMemoryUsage +
+      _registerInfos.numberOfOutputRegisters() * sizeof(AqlValue);
+  size_t const minBatchSize =
+      std::min(kMinAdaptiveBatchSize, ExecutionBlock::DefaultBatchSize);
+  if (rowMemoryUsage == 0) {
+    return ExecutionBlock::DefaultBatchSize;
+  }
+  return std::clamp(kTargetOutputBlockMemoryUsage / rowMemoryUsage,
+                    minBatchSize, ExecutionBlock::DefaultBatchSize);
+}
+
+template<class Executor>
+void ExecutionBlockImpl<Executor>::trackOutputBlockSize(
+    SharedAqlItemBlockPtr const& block) noexcept {
+  if (block == nullptr || block->numRows() == 0) {
+    return;
+  }
+  size_t const current = block->getMemoryUsage() / block->numRows();
+  if (_averageRowMemoryUsage == 0) {
+    _averageRowMemoryUsage = current;
+  } else {
+    // give the latest block a weight of 1/4, so that we adapt to changing
+    // row sizes quickly, but do not jump around with every block
+    _averageRowMemoryUsage = (3 * _averageRowMemoryUsage + current) / 4;
+  }
+}
+
 template<class Executor>
 void ExecutionBlockImpl<Executor>::ensureOutputBlock(AqlCall&& call) {
   if (_outputItemRow == nullptr || !_outputItemRow->isInitialized()) {
@@ -757,8 +800,9 @@ static SkipRowsRangeVariant constexpr skipRowsType() {
                   IdExecutor<SingleRowFetcher<BlockPassthrough::Enable>>,
                   IdExecutor<ConstFetcher>, HashedCollectExecutor,
                   AccuWindowExecutor, WindowExecutor, IndexExecutor,
-                  EnumerateCollectionExecutor, DistinctCollectExecutor,
-                  ConstrainedSortExecutor, CountCollectExecutor,
+                  EnumerateCollectionExecutor, HashJoinExecutor,
+                  DistinctCollectExecutor, ConstrainedSortExecutor,
+                  CountCollectExecutor, MergeJoinExecutor,
 #ifdef ARANGODB_USE_GOOGLE_TESTS
                   TestLambdaSkipExecutor,
 #endif
@@ -2094,6 +2138,10 @@ ExecutionBlockImpl<Executor>::executeWithoutTrace(
 
   auto outputBlock = _outputItemRow != nullptr ? _outputItemRow->stealBlock()
                                                : SharedAqlItemBlockPtr{nullptr};
+  if constexpr (Executor::Properties::allowsBlockPassthrough ==
+                BlockPassthrough::Disable) {
+    trackOutputBlockSize(outputBlock);
+  }
   // We are locally done with our output.
   // Next time we need to check the client call again
   _execState = returnToState;
@@ -41,6 +41,8 @@
 #include "Aql/ReturnExecutor.h"
 #include "Aql/SkipResult.h"
 #include "Aql/SharedQueryState.h"
+#include "Aql/SortLimitThreshold.h"
+#include "Aql/SubqueryResultCache.h"
 #include "Basics/ScopeGuard.h"
 #include "Containers/FlatHashMap.h"
 #include "Cluster/ClusterFeature.h"
@@ -50,7 +52,10 @@
 #include "Futures/Utilities.h"
 #include "Logger/LogMacros.h"
 #include "RestServer/DatabaseFeature.h"
+#include "StorageEngine/PhysicalCollection.h"
+#include "VocBase/LogicalCollection.h"
 #include "VocBase/Methods/Queries.h"
+#include "VocBase/vocbase.h"
 
 using namespace arangodb;
 using namespace arangodb::aql;
@@ -535,7 +540,7 @@ struct DistributedQueryInstanciator final
 
     std::map<ExecutionNodeId, ExecutionNodeId> nodeAliases;
     Result res = _dbserverParts.buildEngines(_nodesById, snippetIds, srvrQryId,
-                                             nodeAliases);
+                                             nodeAliases, _query.profile());
     if (res.fail()) {
       return res;
     }
@@ -632,6 +637,7 @@ auto ExecutionEngine::execute(AqlCallStack const& stack)
     _query.debugKillQuery();
   }
 
+  SharedQueryState::CpuTimeScope cpuTime(*_sharedState);
   auto const res = _root->execute(stack);
 
   TRI_IF_FAILURE("ExecutionEngine::directKillAfterAQLQueryExecute") {
@@ -664,6 +670,7 @@ auto ExecutionEngine::executeForClient(AqlCallStack const& stack,
         "unexpected node type "s + root()->getPlanNode()->getTypeString());
   }
 
+  SharedQueryState::CpuTimeScope cpuTime(*_sharedState);
   auto const res = rootBlock->executeForClient(stack, clientId);
 #ifdef ARANGODB_ENABLE_MAINTAINER_MODE
   if (std::get<ExecutionState>(res) == ExecutionState::WAITING) {
@@ -754,12 +761,15 @@ void ExecutionEngine::instantiateFromPlan(Query& query, ExecutionPlan& plan,
   aql::SnippetList& snippets = query.snippets();
   TRI_ASSERT(snippets.empty() || ServerState::instance()->isClusterRole(role));
 
-#ifdef USE_ENTERPRISE
   std::map<aql::ExecutionNodeId, aql::ExecutionNodeId> aliases;
+#ifdef USE_ENTERPRISE
   if (arangodb::ServerState::isSingleServerOrCoordinator(role)) {
     ExecutionEngine::parallelizeTraversals(query, plan, aliases);
   }
 #endif
+  if (!arangodb::ServerState::isCoordinator(role)) {
+    ExecutionEngine::parallelizeCollectionScans(query, plan, aliases);
+  }
 
   if (arangodb::ServerState::isCoordinator(role)) {
     // distributed query
@@ -783,11 +793,9 @@ void ExecutionEngine::instantiateFromPlan(Query& query, ExecutionPlan& plan,
     auto retEngine =
         std::make_unique<ExecutionEngine>(eId, query, mgr, query.sharedState());
 
-#ifdef USE_ENTERPRISE
     for (auto const& pair : aliases) {
       query.executionStats().addAlias(pair.first, pair.second);
     }
-#endif
 
     SingleServerQueryInstanciator inst(*retEngine);
     plan.root()->walk(inst);
@@ -849,6 +857,77 @@ void arangodb::aql::ExecutionEngine::initFromPlanForCalculation(
   setupEngineRoot(*inst.root);
 }
 
+void ExecutionEngine::parallelizeCollectionScans(
+    aql::Query& query, ExecutionPlan& plan,
+    std::map<aql::ExecutionNodeId, aql::ExecutionNodeId>& aliases) {
+  if (!query.ast()->canApplyParallelism()) {
+    // the scans would share the query's transaction context otherwise
+    return;
+  }
+
+  containers::SmallVector<ExecutionNode*, 8> nodes;
+  plan.findNodesOfType(nodes, ExecutionNode::ENUMERATE_COLLECTION, false);
+
+  for (auto* node : nodes) {
+    auto* ec = ExecutionNode::castTo<EnumerateCollectionNode*>(node);
+    ExecutionNode* singleton = ec->getFirstDependency();
+    if (ec->parallelism() <= 1 || !ec->isDeterministic() ||
+        ec->isHashJoin() || ec->doCount() || ec->hasSortLimitThreshold() ||
+        ec->isInSplicedSubquery() || !ec->hasParent() ||
+        singleton == nullptr ||
+        singleton->getType() != ExecutionNode::SINGLETON) {
+      continue;
+    }
+
+    auto logical = query.vocbase().lookupCollection(ec->collection()->name());
+    if (logical == nullptr) {
+      continue;
+    }
+    std::vector<LocalDocumentId> const bounds =
+        logical->getPhysical()->partitionDocuments(ec->parallelism());
+    if (bounds.empty()) {
+      // too few documents, or not supported by the storage engine
+      continue;
+    }
+
+    // every range of documents is scanned by its own copy of the node, on
+    // top of its own singleton. the scans are executed asynchronously, and
+    // their results are combined by a parallel gather node, in no
+    // particular order. the asynchronous nodes and the gather node must not
+    // reduce the number of registers, so they expose their input registers
+    auto addAsync = [&](ExecutionNode* scan) {
+      auto* async = plan.createNode<AsyncNode>(&plan, plan.nextId());
+      plan.insertAfter(scan, async);
+      async->cloneRegisterPlan(scan);
+      async->setRegsToClear({});
+      aliases.try_emplace(async->id(), ExecutionNodeId::InternalNode);
+      return async;
+    };
+
+    ec->setDocumentRange(LocalDocumentId(), bounds.front());
+    auto* first = addAsync(ec);
+    auto* gather = plan.createNode<GatherNode>(
+        &plan, plan.nextId(), GatherNode::SortMode::Default,
+        GatherNode::Parallelism::Parallel);
+    plan.insertAfter(first, gather);
+    gather->cloneRegisterPlan(first);
+    gather->setRegsToClear({});
+    aliases.try_emplace(gather->id(), ExecutionNodeId::InternalNode);
+
+    for (size_t i = 0; i < bounds.size(); ++i) {
+      auto* start = singleton->clone(&plan, false, false);
+      aliases.try_emplace(start->id(), ExecutionNodeId::InternalNode);
+      auto* scan = ExecutionNode::castTo<EnumerateCollectionNode*>(
+          ec->clone(&plan, false, false));
+      scan->addDependency(start);
+      scan->setDocumentRange(
+          bounds[i], i + 1 < bounds.size() ? bounds[i + 1] : LocalDocumentId());
+      aliases.try_emplace(scan->id(), ec->id());
+      gather->addDependency(addAsync(scan));
+    }
+  }
+}
+
 void ExecutionEngine::initializeConstValueBlock(ExecutionPlan& plan,
                                                 AqlItemBlockManager& mgr) {
   auto registerPlan = plan.root()->getRegisterPlan();
@@ -891,6 +970,8 @@ void arangodb::aql::ExecutionEngine::reset() {
   _resultRegister = RegisterId{RegisterId::maxRegisterId};
   _initializeCursorCalled = false;
   _sharedState.reset();
+  _sortLimitThresholds.clear();
+  _subqueryResultCaches.clear();
 }
 
 ExecutionBlock* ExecutionEngine::root() const {
@@ -931,6 +1012,28 @@ ExecutionEngine::rebootTrackers() {
   return _rebootTrackers;
 }
 
+std::shared_ptr<SortLimitThreshold> ExecutionEngine::sortLimitThreshold(
+    ExecutionNodeId id, bool create) {
+  if (!create) {
+    auto it = _sortLimitThresholds.find(id);
+    return it == _sortLimitThresholds.end() ? nullptr : it->second;
+  }
+  auto& threshold = _sortLimitThresholds[id];
+  if (threshold == nullptr) {
+    threshold = std::make_shared<SortLimitThreshold>(&_query.vpackOptions());
+  }
+  return threshold;
+}
+
+std::shared_ptr<SubqueryResultCache> ExecutionEngine::subqueryResultCache(
+    ExecutionNodeId id) {
+  auto& cache = _subqueryResultCaches[id];
+  if (cache == nullptr) {
+    cache = std::make_shared<SubqueryResultCache>(_query.resourceMonitor());
+  }
+  return cache;
+}
+
 std::shared_ptr<SharedQueryState> const& ExecutionEngine::sharedState() const {
   return _sharedState;
 }
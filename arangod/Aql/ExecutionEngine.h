@@ -23,6 +23,7 @@
 
 #pragma once
 
+#include "Aql/ExecutionNodeId.h"
 #include "Aql/ExecutionState.h"
 #include "Aql/SharedAqlItemBlockPtr.h"
 #include "Aql/types.h"
@@ -34,6 +35,7 @@
 
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -52,6 +54,8 @@ class QueryContext;
 class QueryRegistry;
 class SkipResult;
 class SharedQueryState;
+class SortLimitThreshold;
+class SubqueryResultCache;
 
 class ExecutionEngine {
  public:
@@ -131,6 +135,25 @@ class ExecutionEngine {
 
   std::vector<arangodb::cluster::CallbackGuard>& rebootTrackers();
 
+  /// @brief returns the threshold of the SORT node with the given id, which
+  /// is shared by the SORT node and the node producing its documents. the
+  /// producing node creates it. as dependencies are instantiated first, the
+  /// SORT node only looks it up, and gets a nullptr if nobody uses it
+  std::shared_ptr<SortLimitThreshold> sortLimitThreshold(ExecutionNodeId id,
+                                                         bool create);
+
+  /// @brief returns the result cache of the memoized subquery starting at
+  /// the SubqueryStartNode with the given id, which is shared by the
+  /// SubqueryStartNode and the SubqueryEndNode of the subquery. whichever is
+  /// instantiated first creates it
+  std::shared_ptr<SubqueryResultCache> subqueryResultCache(ExecutionNodeId id);
+
+  /// @brief splits up the collection scans that the optimizer marked for
+  /// parallel execution into scans of disjoint ranges of documents
+  static void parallelizeCollectionScans(
+      aql::Query& query, ExecutionPlan& plan,
+      std::map<aql::ExecutionNodeId, aql::ExecutionNodeId>& aliases);
+
 #ifdef USE_ENTERPRISE
   static bool parallelizeGraphNode(
       aql::Query& query, ExecutionPlan& plan, aql::GraphNode* graphNode,
@@ -178,6 +201,15 @@ class ExecutionEngine {
   /// @brief the register the final result of the query is stored in
   RegisterId _resultRegister;
 
+  /// @brief thresholds of SORT nodes, by id of the SORT node
+  std::unordered_map<ExecutionNodeId, std::shared_ptr<SortLimitThreshold>>
+      _sortLimitThresholds;
+
+  /// @brief result caches of memoized subqueries, by id of the
+  /// SubqueryStartNode
+  std::unordered_map<ExecutionNodeId, std::shared_ptr<SubqueryResultCache>>
+      _subqueryResultCaches;
+
   /// @brief whether or not initializeCursor was called
   bool _initializeCursorCalled;
 };
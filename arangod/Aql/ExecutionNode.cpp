@@ -39,6 +39,7 @@
 #include "Aql/ExecutionPlan.h"
 #include "Aql/Expression.h"
 #include "Aql/FilterExecutor.h"
+#include "Aql/HashJoinExecutor.h"
 #include "Aql/Function.h"
 #include "Aql/IResearchViewNode.h"
 #include "Aql/IdExecutor.h"
@@ -1708,7 +1709,28 @@ EnumerateCollectionNode::EnumerateCollectionNode(
       DocumentProducingNode(plan, base),
       CollectionAccessingNode(plan, base),
       _random(base.get("random").getBoolean()),
-      _hint(base) {}
+      _hint(base),
+      _hashJoinProbeVariable(nullptr),
+      _parallelism(basics::VelocyPackHelper::getNumericValue<size_t>(
+          base, "parallelism", 1)) {
+  VPackSlice documentRange = base.get("documentRange");
+  if (documentRange.isArray()) {
+    _documentRange.emplace(
+        LocalDocumentId(documentRange.at(0).getNumber<uint64_t>()),
+        LocalDocumentId(documentRange.at(1).getNumber<uint64_t>()));
+  }
+  VPackSlice hashJoin = base.get("hashJoin");
+  if (hashJoin.isObject()) {
+    for (auto it : VPackArrayIterator(hashJoin.get("buildAttribute"))) {
+      _hashJoinBuildAttribute.emplace_back(it.copyString());
+    }
+    _hashJoinProbeVariable =
+        Variable::varFromVPack(plan->getAst(), hashJoin, "probeVariable");
+    for (auto it : VPackArrayIterator(hashJoin.get("probeAttribute"))) {
+      _hashJoinProbeAttribute.emplace_back(it.copyString());
+    }
+  }
+}
 
 /// @brief doToVelocyPack, for EnumerateCollectionNode
 void EnumerateCollectionNode::doToVelocyPack(velocypack::Builder& builder,
@@ -1717,6 +1739,37 @@ void EnumerateCollectionNode::doToVelocyPack(velocypack::Builder& builder,
 
   _hint.toVelocyPack(builder);
 
+  if (isHashJoin()) {
+    builder.add(VPackValue("hashJoin"));
+    builder.openObject();
+    builder.add(VPackValue("buildAttribute"));
+    builder.openArray();
+    for (auto const& it : _hashJoinBuildAttribute) {
+      builder.add(VPackValue(it));
+    }
+    builder.close();
+    builder.add(VPackValue("probeVariable"));
+    _hashJoinProbeVariable->toVelocyPack(builder);
+    builder.add(VPackValue("probeAttribute"));
+    builder.openArray();
+    for (auto const& it : _hashJoinProbeAttribute) {
+      builder.add(VPackValue(it));
+    }
+    builder.close();
+    builder.close();
+  }
+
+  if (_parallelism > 1) {
+    builder.add("parallelism", VPackValue(_parallelism));
+  }
+  if (_documentRange.has_value()) {
+    builder.add(VPackValue("documentRange"));
+    builder.openArray();
+    builder.add(VPackValue(_documentRange->first.id()));
+    builder.add(VPackValue(_documentRange->second.id()));
+    builder.close();
+  }
+
   // add outvariable and projection
   DocumentProducingNode::toVelocyPack(builder, flags);
 
@@ -1755,6 +1808,22 @@ std::unique_ptr<ExecutionBlock> EnumerateCollectionNode::createBlock(
       produceResult, this->_filter.get(), this->projections(),
       std::move(filterVarsToRegs), this->_random, this->doCount(),
       this->canReadOwnWrites());
+
+  if (isHashJoin()) {
+    auto const& queryOptions = engine.getQuery().queryOptions();
+    auto hashJoinInfos = HashJoinExecutorInfos(
+        std::move(executorInfos), _hashJoinBuildAttribute,
+        variableToRegisterId(_hashJoinProbeVariable), _hashJoinProbeAttribute,
+        queryOptions.spillOverThresholdNumRows,
+        queryOptions.spillOverThresholdMemoryUsage);
+    return std::make_unique<ExecutionBlockImpl<HashJoinExecutor>>(
+        &engine, this, std::move(registerInfos), std::move(hashJoinInfos));
+  }
+  executorInfos.setSortLimitThresholdFilter(sortLimitThresholdFilter(engine));
+  if (_documentRange.has_value()) {
+    executorInfos.setDocumentRange(_documentRange->first,
+                                   _documentRange->second);
+  }
   return std::make_unique<ExecutionBlockImpl<EnumerateCollectionExecutor>>(
       &engine, this, std::move(registerInfos), std::move(executorInfos));
 }
@@ -1773,6 +1842,11 @@ ExecutionNode* EnumerateCollectionNode::clone(ExecutionPlan* plan,
       plan, _id, collection(), outVariable, _random, _hint);
 
   c->_projections = _projections;
+  c->_hashJoinBuildAttribute = _hashJoinBuildAttribute;
+  c->_hashJoinProbeVariable = _hashJoinProbeVariable;
+  c->_hashJoinProbeAttribute = _hashJoinProbeAttribute;
+  c->_parallelism = _parallelism;
+  c->_documentRange = _documentRange;
   CollectionAccessingNode::cloneInto(*c);
   DocumentProducingNode::cloneInto(plan, *c);
 
@@ -1784,10 +1858,25 @@ ExecutionNode* EnumerateCollectionNode::clone(ExecutionPlan* plan,
 void EnumerateCollectionNode::replaceVariables(
     std::unordered_map<VariableId, Variable const*> const& replacements) {
   DocumentProducingNode::replaceVariables(replacements);
+  if (isHashJoin()) {
+    _hashJoinProbeVariable =
+        Variable::replace(_hashJoinProbeVariable, replacements);
+  }
 }
 
 void EnumerateCollectionNode::setRandom() { _random = true; }
 
+void EnumerateCollectionNode::setHashJoin(
+    std::vector<std::string> buildAttribute, Variable const* probeVariable,
+    std::vector<std::string> probeAttribute) {
+  TRI_ASSERT(hasFilter());
+  TRI_ASSERT(!buildAttribute.empty());
+  TRI_ASSERT(probeVariable != nullptr);
+  _hashJoinBuildAttribute = std::move(buildAttribute);
+  _hashJoinProbeVariable = probeVariable;
+  _hashJoinProbeAttribute = std::move(probeAttribute);
+}
+
 bool EnumerateCollectionNode::isDeterministic() {
   return !_random && (canReadOwnWrites() == ReadOwnWrites::no);
 }
@@ -1801,6 +1890,9 @@ void EnumerateCollectionNode::getVariablesUsedHere(VarSet& vars) const {
     // node must also be used later.
     vars.erase(outVariable());
   }
+  if (isHashJoin()) {
+    vars.emplace(_hashJoinProbeVariable);
+  }
 }
 
 std::vector<Variable const*> EnumerateCollectionNode::getVariablesSetHere()
@@ -1820,6 +1912,7 @@ CostEstimate EnumerateCollectionNode::estimateCost() const {
   CostEstimate estimate = _dependencies.at(0)->getCost();
   auto estimatedNrItems =
       collection()->count(&trx, transaction::CountType::TryCache);
+  auto const incomingItems = estimate.estimatedNrItems;
   if (_random) {
     // we retrieve at most one random document from the collection.
     // so the estimate is at most 1
@@ -1830,13 +1923,22 @@ CostEstimate EnumerateCollectionNode::estimateCost() const {
     // must not be multiplied with the number of items in this collection
     estimate.estimatedNrItems *= estimatedNrItems;
   }
-  // We do a full collection scan for each incoming item.
-  // random iteration is slightly more expensive than linear iteration
-  // we also penalize each EnumerateCollectionNode slightly (and do not
-  // do the same for IndexNodes) so IndexNodes will be preferred
-  estimate.estimatedCost += estimate.estimatedNrItems *
-                                (_random ? 1.005 : (hasFilter() ? 2.0 : 1.0)) +
-                            1.0;
+  if (isHashJoin()) {
+    // we scan and hash the collection only once, and then do a lookup in
+    // the hash table for each incoming item. building the hash table is more
+    // expensive than scanning, so that the smaller collection is preferred
+    // for building
+    estimate.estimatedCost += incomingItems + estimatedNrItems * 3.0 + 1.0;
+  } else {
+    // We do a full collection scan for each incoming item.
+    // random iteration is slightly more expensive than linear iteration
+    // we also penalize each EnumerateCollectionNode slightly (and do not
+    // do the same for IndexNodes) so IndexNodes will be preferred
+    estimate.estimatedCost +=
+        estimate.estimatedNrItems *
+            (_random ? 1.005 : (hasFilter() ? 2.0 : 1.0)) +
+        1.0;
+  }
 
   return estimate;
 }
@@ -2764,7 +2866,9 @@ EnumerateCollectionNode::EnumerateCollectionNode(
       DocumentProducingNode(outVariable),
       CollectionAccessingNode(collection),
       _random(random),
-      _hint(hint) {}
+      _hint(hint),
+      _hashJoinProbeVariable(nullptr),
+      _parallelism(1) {}
 
 ExecutionNode::NodeType EnumerateCollectionNode::getType() const {
   return ENUMERATE_COLLECTION;
@@ -55,6 +55,7 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 #include <vector>
 #include <unordered_map>
 
@@ -72,6 +73,7 @@
 #include "Basics/TypeTraits.h"
 #include "Basics/Identifier.h"
 #include "Containers/HashSet.h"
+#include "VocBase/Identifiers/LocalDocumentId.h"
 
 namespace arangodb {
 namespace velocypack {
@@ -694,6 +696,33 @@ class EnumerateCollectionNode : public ExecutionNode,
   /// @brief user hint regarding which index ot use
   IndexHint const& hint() const;
 
+  /// @brief execute the node as a hash join: the documents of the collection
+  /// are put into a hash table by the value of buildAttribute once, and are
+  /// then looked up by the value of probeAttribute of probeVariable for
+  /// every input row. the node's filter condition must contain the equality
+  /// comparison of both
+  void setHashJoin(std::vector<std::string> buildAttribute,
+                   Variable const* probeVariable,
+                   std::vector<std::string> probeAttribute);
+
+  /// @brief whether or not the node is executed as a hash join
+  bool isHashJoin() const noexcept { return _hashJoinProbeVariable != nullptr; }
+
+  /// @brief number of disjoint ranges of documents to scan in parallel. the
+  /// node is split up accordingly when the execution engine is created
+  void setParallelism(size_t parallelism) noexcept {
+    _parallelism = parallelism;
+  }
+
+  size_t parallelism() const noexcept { return _parallelism; }
+
+  /// @brief only enumerate the documents with a LocalDocumentId in the
+  /// range [lower, upper). an empty upper bound means that the range is
+  /// unbounded
+  void setDocumentRange(LocalDocumentId lower, LocalDocumentId upper) {
+    _documentRange.emplace(lower, upper);
+  }
+
  protected:
   /// @brief export to VelocyPack
   void doToVelocyPack(arangodb::velocypack::Builder&,
@@ -705,6 +734,22 @@ class EnumerateCollectionNode : public ExecutionNode,
 
   /// @brief a possible hint from the user regarding which index to use
   IndexHint _hint;
+
+  /// @brief attribute of the collection's documents to build the hash
+  /// table on, only used for hash joins
+  std::vector<std::string> _hashJoinBuildAttribute;
+
+  /// @brief variable to look up the documents with, only set for hash joins
+  Variable const* _hashJoinProbeVariable;
+
+  /// @brief attribute of the probe variable to look up the documents with
+  std::vector<std::string> _hashJoinProbeAttribute;
+
+  /// @brief number of ranges to scan in parallel
+  size_t _parallelism;
+
+  /// @brief the range of documents to enumerate, if restricted
+  std::optional<std::pair<LocalDocumentId, LocalDocumentId>> _documentRange;
 };
 
 /// @brief class EnumerateListNode
@@ -1056,6 +1056,9 @@ ModificationOptions ExecutionPlan::parseModificationOptions(
           options.exclusive = value->isTrue();
         } else if (name == "ignoreErrors") {
           options.ignoreErrors = value->isTrue();
+        } else if (name == StaticStrings::ReadOwnWrites &&
+                   std::string_view(operationName) == "UPSERT") {
+          options.readOwnWrites = value->isTrue();
         } else {
           if (addWarnings) {
             invalidOptionAttribute(query, "unknown", operationName, name.data(),
@@ -1100,6 +1103,14 @@ CollectOptions ExecutionPlan::createCollectOptions(AstNode const* node) {
               handled = true;
             }
           }
+        } else if (name == "parallelism") {
+          // parallelism is only used when there is no usage of V8 in the
+          // query and if the query is not a modification query.
+          if (_ast->canApplyParallelism()) {
+            options.parallelism =
+                Ast::validatedParallelism(member->getMember(0));
+          }
+          handled = true;
         }
         if (!handled) {
           invalidOptionAttribute(_ast->query(), "unknown", "COLLECT",
@@ -2183,6 +2194,29 @@ ExecutionNode* ExecutionPlan::fromNodeUpsert(ExecutionNode* previous,
   }
   TRI_ASSERT(updateVar != nullptr);
 
+  if (!options.readOwnWrites) {
+    // the lookup subquery does not need to see the writes of the UPSERT for
+    // the previous input rows. this allows the UPSERT to look up and write
+    // the documents of many input rows at once
+    for (auto* current = previous; current != nullptr;
+         current = current->getFirstDependency()) {
+      if (current->getType() == ExecutionNode::SUBQUERY) {
+        auto* sq = ExecutionNode::castTo<SubqueryNode*>(current);
+        for (auto* n = sq->getSubquery(); n != nullptr;
+             n = n->getFirstDependency()) {
+          if (n->getType() == ExecutionNode::ENUMERATE_COLLECTION) {
+            ExecutionNode::castTo<EnumerateCollectionNode*>(n)
+                ->setCanReadOwnWrites(ReadOwnWrites::no);
+          }
+        }
+        break;
+      }
+      if (current->getType() != ExecutionNode::CALCULATION) {
+        break;
+      }
+    }
+  }
+
   bool isReplace =
       (node->getIntValue(true) == static_cast<int64_t>(NODE_TYPE_REPLACE));
   ExecutionNode* en = registerNode(
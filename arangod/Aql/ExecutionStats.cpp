@@ -53,6 +53,7 @@ void ExecutionStats::toVelocyPack(VPackBuilder& builder,
     builder.add("fullCount", VPackValue(fullCount > count ? fullCount : count));
   }
   builder.add("executionTime", VPackValue(executionTime));
+  builder.add("cpuTime", VPackValue(cpuTime));
 
   builder.add("peakMemoryUsage", VPackValue(peakMemoryUsage));
   builder.add("intermediateCommits", VPackValue(intermediateCommits));
@@ -91,6 +92,7 @@ void ExecutionStats::add(ExecutionStats const& summand) {
   count += summand.count;
   peakMemoryUsage = std::max(summand.peakMemoryUsage, peakMemoryUsage);
   intermediateCommits += summand.intermediateCommits;
+  cpuTime += summand.cpuTime;
   // intentionally no modification of executionTime, as the overall
   // time is calculated in the end
 
@@ -149,6 +151,7 @@ ExecutionStats::ExecutionStats() noexcept
       fullCount(0),
       count(0),
       executionTime(0.0),
+      cpuTime(0.0),
       peakMemoryUsage(0),
       intermediateCommits(0) {}
 
@@ -179,6 +182,8 @@ ExecutionStats::ExecutionStats(VPackSlice slice) : ExecutionStats() {
       slice, "peakMemoryUsage", 0);
   intermediateCommits = basics::VelocyPackHelper::getNumericValue<uint64_t>(
       slice, "intermediateCommits", 0);
+  cpuTime =
+      basics::VelocyPackHelper::getNumericValue<double>(slice, "cpuTime", 0.0);
 
   // cursorsCreated and cursorsRearmed are optional attributes.
   // the attributes are currently not shown in profile outputs,
@@ -250,6 +255,7 @@ void ExecutionStats::clear() noexcept {
   fullCount = 0;
   count = 0;
   executionTime = 0.0;
+  cpuTime = 0.0;
   peakMemoryUsage = 0;
   intermediateCommits = 0;
   _nodes.clear();
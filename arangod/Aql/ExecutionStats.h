@@ -110,6 +110,10 @@ struct ExecutionStats {
   /// the outside
   double executionTime = 0.0;
 
+  /// @brief CPU time (in seconds) spent executing the query, summed up over
+  /// all threads and servers
+  double cpuTime = 0.0;
+
   /// @brief peak memory usage of the query
   size_t peakMemoryUsage = 0;
 
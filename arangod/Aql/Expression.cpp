@@ -30,6 +30,7 @@
 #include "Aql/ExecutionNode.h"
 #include "Aql/ExecutionPlan.h"
 #include "Aql/ExpressionContext.h"
+#include "Aql/ExpressionProgram.h"
 #include "Aql/Function.h"
 #include "Aql/Functions.h"
 #include "Aql/Quantifier.h"
@@ -113,6 +114,20 @@ AqlValue Expression::execute(ExpressionContext* ctx, bool& mustDestroy) {
     }
 
     case SIMPLE: {
+      if (auto* program = _program.load(std::memory_order_acquire);
+          program != nullptr) {
+        return program->execute(*ctx, mustDestroy);
+      }
+      if (_executions.load(std::memory_order_relaxed) <
+              ExpressionProgram::compileThreshold &&
+          _executions.fetch_add(1, std::memory_order_relaxed) + 1 ==
+              ExpressionProgram::compileThreshold) {
+        // the expression is executed often, so compile it. exactly one
+        // thread sees the counter reach the threshold
+        if (auto* program = publishProgram(); program != nullptr) {
+          return program->execute(*ctx, mustDestroy);
+        }
+      }
       return executeSimpleExpression(*ctx, _node, mustDestroy, true);
     }
 
@@ -185,7 +200,13 @@ void Expression::freeInternals() noexcept {
       break;
     }
 
-    case SIMPLE:
+    case SIMPLE: {
+      // the program refers to the old AST nodes
+      delete _program.exchange(nullptr, std::memory_order_acq_rel);
+      _executions.store(0, std::memory_order_relaxed);
+      break;
+    }
+
     case UNPROCESSED: {
       // nothing to do
       break;
@@ -382,6 +403,37 @@ void Expression::initAccessor() {
 
 /// @brief prepare the expression for execution, without an
 /// ExpressionContext.
+void Expression::compile() {
+  prepareForExecution();
+
+  if (_type == SIMPLE && _program.load(std::memory_order_acquire) == nullptr &&
+      _executions.load(std::memory_order_relaxed) <
+          ExpressionProgram::compileThreshold) {
+    publishProgram();
+  }
+  // do not try to compile the expression again during execution
+  _executions.store(ExpressionProgram::compileThreshold,
+                    std::memory_order_relaxed);
+}
+
+/// @brief compile the SIMPLE expression and publish the program, unless
+/// another thread has published one already. returns the published program,
+/// or a nullptr if the expression cannot be compiled
+ExpressionProgram* Expression::publishProgram() {
+  auto program = ExpressionProgram::compile(_node);
+  if (program == nullptr) {
+    return nullptr;
+  }
+  ExpressionProgram* expected = nullptr;
+  if (_program.compare_exchange_strong(expected, program.get(),
+                                       std::memory_order_acq_rel,
+                                       std::memory_order_acquire)) {
+    return program.release();
+  }
+  // lost the race, use the program of the other thread
+  return expected;
+}
+
 void Expression::prepareForExecution() {
   TRI_ASSERT(_type != UNPROCESSED);
 
@@ -440,6 +492,8 @@ AqlValue Expression::executeSimpleExpression(ExpressionContext& ctx,
       return executeSimpleExpressionObject(ctx, node, mustDestroy);
     case NODE_TYPE_VALUE:
       return executeSimpleExpressionValue(ctx, node, mustDestroy);
+    case NODE_TYPE_PARAMETER:
+      return executeSimpleExpressionParameter(ctx, node, mustDestroy);
     case NODE_TYPE_REFERENCE:
       return executeSimpleExpressionReference(ctx, node, mustDestroy, doCopy);
     case NODE_TYPE_FCALL:
@@ -803,6 +857,20 @@ AqlValue Expression::executeSimpleExpressionValue(ExpressionContext& ctx,
   return AqlValue(node->computeValue(builder.get()).begin());
 }
 
+// execute an expression of type SIMPLE with PARAMETER. parameter nodes are
+// only left in the AST for bind parameters that are evaluated at runtime
+AqlValue Expression::executeSimpleExpressionParameter(ExpressionContext& ctx,
+                                                      AstNode const* node,
+                                                      bool& mustDestroy) {
+  VPackSlice value = ctx.getBindParameterValue(node->getStringView());
+  if (value.isNone()) {
+    THROW_ARANGO_EXCEPTION_PARAMS(TRI_ERROR_QUERY_BIND_PARAMETER_MISSING,
+                                  node->getString().c_str());
+  }
+  mustDestroy = true;
+  return AqlValue(AqlValueHintSliceCopy(value));
+}
+
 // execute an expression of type SIMPLE with REFERENCE
 AqlValue Expression::executeSimpleExpressionReference(ExpressionContext& ctx,
                                                       AstNode const* node,
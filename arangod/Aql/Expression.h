@@ -23,7 +23,9 @@
 
 #pragma once
 
+#include <atomic>
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <unordered_map>
 
@@ -51,11 +53,15 @@ struct AstNode;
 class AttributeAccessor;
 class ExecutionPlan;
 class ExpressionContext;
+class ExpressionProgram;
 class QueryContext;
 struct Variable;
 
 /// @brief AqlExpression, used in execution plans and execution blocks
 class Expression {
+  // executes sub-expressions it does not compile itself
+  friend class ExpressionProgram;
+
  public:
   enum ExpressionType : uint32_t {
     UNPROCESSED,
@@ -162,10 +168,19 @@ class Expression {
   // prepare the expression for execution
   void prepareForExecution();
 
+  // prepare the expression for execution, and compile a SIMPLE expression
+  // right away instead of once it has been executed often. afterwards,
+  // executing the expression does not modify it anymore, so it can be
+  // executed concurrently
+  void compile();
+
  private:
   // free the internal data structures
   void freeInternals() noexcept;
 
+  // compile a SIMPLE expression and publish its program
+  ExpressionProgram* publishProgram();
+
   // find a value in an array
   static bool findInArray(AqlValue const&, AqlValue const&,
                           velocypack::Options const* vopts, AstNode const*);
@@ -208,6 +223,11 @@ class Expression {
                                                AstNode const*,
                                                bool& mustDestroy);
 
+  // execute an expression of type SIMPLE with PARAMETER
+  static AqlValue executeSimpleExpressionParameter(ExpressionContext& ctx,
+                                                   AstNode const*,
+                                                   bool& mustDestroy);
+
   // execute an expression of type SIMPLE with REFERENCE
   static AqlValue executeSimpleExpressionReference(ExpressionContext& ctx,
                                                    AstNode const*,
@@ -309,6 +329,17 @@ class Expression {
   // type of expression
   ExpressionType _type;
 
+  // number of executions of a SIMPLE expression, used to decide when to
+  // compile it. the expression can be executed by multiple threads
+  // concurrently, and the counter is only a heuristic, so it is relaxed
+  std::atomic<uint32_t> _executions{0};
+
+  // compiled program of a SIMPLE expression, if any. owned by the
+  // expression. it is published once with a compare-and-swap, so threads
+  // executing the expression concurrently either see no program or a
+  // completely built one
+  std::atomic<ExpressionProgram*> _program{nullptr};
+
   arangodb::ResourceMonitor& _resourceMonitor;
 };
 
@@ -25,6 +25,8 @@
 
 #include "Basics/ErrorCode.h"
 
+#include <velocypack/Slice.h>
+
 #include <string_view>
 #include <unicode/regex.h>
 
@@ -37,7 +39,6 @@ class Methods;
 }
 namespace velocypack {
 struct Options;
-class Slice;
 }  // namespace velocypack
 
 namespace aql {
@@ -78,6 +79,14 @@ class ExpressionContext {
 
   // unregister a temporary variable from the ExpressionContext.
   virtual void clearVariable(Variable const* variable) noexcept = 0;
+
+  // return the value of a bind parameter that was not injected into the
+  // query, because the plan is kept in the query plan cache. returns a
+  // none slice if the value is not available
+  virtual velocypack::Slice getBindParameterValue(
+      std::string_view /*name*/) const {
+    return velocypack::Slice::noneSlice();
+  }
 };
 }  // namespace aql
 }  // namespace arangodb
@@ -0,0 +1,500 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "ExpressionKernel.h"
+
+#include "Aql/AqlItemBlock.h"
+#include "Aql/AqlValue.h"
+#include "Aql/AstNode.h"
+#include "Aql/Variable.h"
+#include "Basics/debugging.h"
+
+#include <velocypack/Slice.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <optional>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+namespace {
+// integers with a higher magnitude cannot be converted into doubles without
+// losing precision. the regular comparison code compares such integers
+// exactly, so we must not handle them in the kernel
+constexpr int64_t maxSafeInteger = (int64_t(1) << 53);
+
+// maximum number of attribute access levels we handle
+constexpr size_t maxAttributeDepth = 8;
+
+/// @brief extract a number from a slice, if it can be represented exactly
+/// as a double
+bool sliceToDouble(velocypack::Slice s, double& out) noexcept {
+  if (s.isDouble()) {
+    out = s.getDouble();
+    return std::isfinite(out);
+  }
+  if (s.isSmallInt() || s.isInt()) {
+    int64_t v = s.getIntUnchecked();
+    if (v > maxSafeInteger || v < -maxSafeInteger) {
+      return false;
+    }
+    out = static_cast<double>(v);
+    return true;
+  }
+  if (s.isUInt()) {
+    uint64_t v = s.getUIntUnchecked();
+    if (v > static_cast<uint64_t>(maxSafeInteger)) {
+      return false;
+    }
+    out = static_cast<double>(v);
+    return true;
+  }
+  return false;
+}
+
+/// @brief the regular expression execution converts NaN and +/-inf into
+/// null. if any intermediate result is not finite, the batch must be
+/// evaluated by the regular code
+bool allFinite(double const* values, size_t n) noexcept {
+  bool ok = true;
+  for (size_t i = 0; i < n; ++i) {
+    // NaN compares false with everything
+    ok &= (std::abs(values[i]) <= std::numeric_limits<double>::max());
+  }
+  return ok;
+}
+
+bool noneZero(double const* values, size_t n) noexcept {
+  bool ok = true;
+  for (size_t i = 0; i < n; ++i) {
+    ok &= (values[i] != 0.0);
+  }
+  return ok;
+}
+
+// the following loops are written without any data-dependent branches, so
+// that the compiler can vectorize them
+template<typename F>
+void applyBinary(double const* __restrict lhs, double const* __restrict rhs,
+                 double* __restrict out, size_t n, F&& f) noexcept {
+  for (size_t i = 0; i < n; ++i) {
+    out[i] = f(lhs[i], rhs[i]);
+  }
+}
+}  // namespace
+
+ExpressionKernel::~ExpressionKernel() = default;
+
+std::unique_ptr<ExpressionKernel> ExpressionKernel::compile(
+    AstNode const* node,
+    std::vector<std::pair<VariableId, RegisterId>> const& varToRegs) {
+  if (node == nullptr) {
+    return nullptr;
+  }
+
+  // cannot use std::make_unique here because the constructor is private
+  std::unique_ptr<ExpressionKernel> kernel(new ExpressionKernel());
+  ResultType type;
+  size_t slot = kernel->build(node, varToRegs, type);
+  if (slot == invalidSlot) {
+    return nullptr;
+  }
+  if (auto op = kernel->_instructions[slot].op; op == OpCode::LoadConstant ||
+                                                op == OpCode::LoadRegister ||
+                                                op == OpCode::LoadAttribute) {
+    // constants are not worth it, and plain value accesses must return the
+    // original value and not a number converted to double
+    return nullptr;
+  }
+  // the result of the expression is always in the last slot
+  TRI_ASSERT(slot + 1 == kernel->_instructions.size());
+  kernel->_resultType = type;
+  kernel->_columns.resize(kernel->_instructions.size());
+  return kernel;
+}
+
+size_t ExpressionKernel::addInstruction(Instruction instruction) {
+  _instructions.emplace_back(instruction);
+  return _instructions.size() - 1;
+}
+
+size_t ExpressionKernel::build(
+    AstNode const* node,
+    std::vector<std::pair<VariableId, RegisterId>> const& varToRegs,
+    ResultType& type) {
+  auto findRegister = [&](AstNode const* ref) -> std::optional<RegisterId> {
+    TRI_ASSERT(ref->type == NODE_TYPE_REFERENCE);
+    auto v = static_cast<Variable const*>(ref->getData());
+    TRI_ASSERT(v != nullptr);
+    for (auto const& [id, reg] : varToRegs) {
+      if (id == v->id) {
+        return reg;
+      }
+    }
+    return std::nullopt;
+  };
+
+  switch (node->type) {
+    case NODE_TYPE_VALUE: {
+      if (!node->isNumericValue()) {
+        return invalidSlot;
+      }
+      if (node->isIntValue()) {
+        int64_t v = node->getIntValue();
+        if (v > maxSafeInteger || v < -maxSafeInteger) {
+          return invalidSlot;
+        }
+      }
+      type = ResultType::Number;
+      Instruction instruction{.op = OpCode::LoadConstant};
+      instruction.constant = node->getDoubleValue();
+      return addInstruction(instruction);
+    }
+
+    case NODE_TYPE_REFERENCE: {
+      auto reg = findRegister(node);
+      if (!reg.has_value()) {
+        return invalidSlot;
+      }
+      type = ResultType::Number;
+      Instruction instruction{.op = OpCode::LoadRegister};
+      instruction.reg = *reg;
+      return addInstruction(instruction);
+    }
+
+    case NODE_TYPE_ATTRIBUTE_ACCESS: {
+      std::vector<std::string> path;
+      AstNode const* current = node;
+      while (current->type == NODE_TYPE_ATTRIBUTE_ACCESS) {
+        if (path.size() >= maxAttributeDepth) {
+          return invalidSlot;
+        }
+        path.emplace_back(current->getString());
+        current = current->getMemberUnchecked(0);
+      }
+      if (current->type != NODE_TYPE_REFERENCE) {
+        return invalidSlot;
+      }
+      auto reg = findRegister(current);
+      if (!reg.has_value()) {
+        return invalidSlot;
+      }
+      std::reverse(path.begin(), path.end());
+      _paths.emplace_back(std::move(path));
+      type = ResultType::Number;
+      Instruction instruction{.op = OpCode::LoadAttribute};
+      instruction.reg = *reg;
+      instruction.path = _paths.size() - 1;
+      return addInstruction(instruction);
+    }
+
+    case NODE_TYPE_OPERATOR_BINARY_PLUS:
+    case NODE_TYPE_OPERATOR_BINARY_MINUS:
+    case NODE_TYPE_OPERATOR_BINARY_TIMES:
+    case NODE_TYPE_OPERATOR_BINARY_DIV:
+    case NODE_TYPE_OPERATOR_BINARY_MOD:
+    case NODE_TYPE_OPERATOR_BINARY_EQ:
+    case NODE_TYPE_OPERATOR_BINARY_NE:
+    case NODE_TYPE_OPERATOR_BINARY_LT:
+    case NODE_TYPE_OPERATOR_BINARY_LE:
+    case NODE_TYPE_OPERATOR_BINARY_GT:
+    case NODE_TYPE_OPERATOR_BINARY_GE: {
+      ResultType lhsType;
+      ResultType rhsType;
+      size_t lhs = build(node->getMemberUnchecked(0), varToRegs, lhsType);
+      if (lhs == invalidSlot || lhsType != ResultType::Number) {
+        return invalidSlot;
+      }
+      size_t rhs = build(node->getMemberUnchecked(1), varToRegs, rhsType);
+      if (rhs == invalidSlot || rhsType != ResultType::Number) {
+        return invalidSlot;
+      }
+
+      OpCode op;
+      type = ResultType::Bool;
+      switch (node->type) {
+        case NODE_TYPE_OPERATOR_BINARY_PLUS:
+          op = OpCode::Plus;
+          type = ResultType::Number;
+          break;
+        case NODE_TYPE_OPERATOR_BINARY_MINUS:
+          op = OpCode::Minus;
+          type = ResultType::Number;
+          break;
+        case NODE_TYPE_OPERATOR_BINARY_TIMES:
+          op = OpCode::Times;
+          type = ResultType::Number;
+          break;
+        case NODE_TYPE_OPERATOR_BINARY_DIV:
+          op = OpCode::Div;
+          type = ResultType::Number;
+          break;
+        case NODE_TYPE_OPERATOR_BINARY_MOD:
+          op = OpCode::Mod;
+          type = ResultType::Number;
+          break;
+        case NODE_TYPE_OPERATOR_BINARY_EQ:
+          op = OpCode::Eq;
+          break;
+        case NODE_TYPE_OPERATOR_BINARY_NE:
+          op = OpCode::Ne;
+          break;
+        case NODE_TYPE_OPERATOR_BINARY_LT:
+          op = OpCode::Lt;
+          break;
+        case NODE_TYPE_OPERATOR_BINARY_LE:
+          op = OpCode::Le;
+          break;
+        case NODE_TYPE_OPERATOR_BINARY_GT:
+          op = OpCode::Gt;
+          break;
+        default:
+          TRI_ASSERT(node->type == NODE_TYPE_OPERATOR_BINARY_GE);
+          op = OpCode::Ge;
+          break;
+      }
+      Instruction instruction{.op = op};
+      instruction.lhs = lhs;
+      instruction.rhs = rhs;
+      return addInstruction(instruction);
+    }
+
+    case NODE_TYPE_OPERATOR_BINARY_AND:
+    case NODE_TYPE_OPERATOR_BINARY_OR:
+    case NODE_TYPE_OPERATOR_NARY_AND:
+    case NODE_TYPE_OPERATOR_NARY_OR: {
+      // note: AND and OR return one of their operands in AQL. as we only
+      // allow boolean operands here, the result is always a boolean as well
+      bool const isAnd = (node->type == NODE_TYPE_OPERATOR_BINARY_AND ||
+                          node->type == NODE_TYPE_OPERATOR_NARY_AND);
+      size_t const n = node->numMembers();
+      if (n == 0) {
+        return invalidSlot;
+      }
+      size_t result = invalidSlot;
+      for (size_t i = 0; i < n; ++i) {
+        ResultType memberType;
+        size_t member = build(node->getMemberUnchecked(i), varToRegs,
+                              memberType);
+        if (member == invalidSlot || memberType != ResultType::Bool) {
+          return invalidSlot;
+        }
+        if (result == invalidSlot) {
+          result = member;
+        } else {
+          Instruction instruction{.op = isAnd ? OpCode::And : OpCode::Or};
+          instruction.lhs = result;
+          instruction.rhs = member;
+          result = addInstruction(instruction);
+        }
+      }
+      type = ResultType::Bool;
+      return result;
+    }
+
+    case NODE_TYPE_OPERATOR_UNARY_NOT: {
+      ResultType memberType;
+      size_t member =
+          build(node->getMemberUnchecked(0), varToRegs, memberType);
+      if (member == invalidSlot || memberType != ResultType::Bool) {
+        return invalidSlot;
+      }
+      type = ResultType::Bool;
+      Instruction instruction{.op = OpCode::Not};
+      instruction.lhs = member;
+      return addInstruction(instruction);
+    }
+
+    default:
+      return invalidSlot;
+  }
+}
+
+bool ExpressionKernel::load(Instruction const& instruction,
+                            AqlItemBlock const& block, size_t from, size_t to,
+                            double* out) {
+  size_t const n = to - from;
+
+  if (instruction.op == OpCode::LoadRegister &&
+      instruction.reg.isRegularRegister() && block.hasContiguousColumns()) {
+    // all values of the register are adjacent in memory
+    auto column = block.getColumn(instruction.reg.value(), from, to);
+    TRI_ASSERT(column.size() == n);
+    for (size_t i = 0; i < n; ++i) {
+      AqlValue const& value = column[i];
+      if (!value.isNumber() || !sliceToDouble(value.slice(), out[i])) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  auto const* path = instruction.op == OpCode::LoadAttribute
+                         ? &_paths[instruction.path]
+                         : nullptr;
+  for (size_t i = 0; i < n; ++i) {
+    AqlValue const& value = block.getValueReference(from + i, instruction.reg);
+    velocypack::Slice s;
+    if (path == nullptr) {
+      if (!value.isNumber()) {
+        return false;
+      }
+      s = value.slice();
+    } else {
+      // note: this will not handle the special attributes _id and _key
+      // inside custom types, but these are never numbers anyway
+      if (!value.isObject()) {
+        return false;
+      }
+      s = value.slice();
+      if (path->size() == 1) {
+        s = s.get((*path)[0]);
+      } else {
+        s = s.get(*path);
+      }
+    }
+    if (!sliceToDouble(s, out[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool ExpressionKernel::evaluate(AqlItemBlock const& block, size_t from,
+                                size_t to) {
+  TRI_ASSERT(from <= to);
+  size_t const n = to - from;
+  if (n == 0) {
+    return true;
+  }
+
+  for (size_t slot = 0; slot < _instructions.size(); ++slot) {
+    auto const& instruction = _instructions[slot];
+    auto& column = _columns[slot];
+    column.resize(n);
+    double* out = column.data();
+    double const* lhs = _columns[instruction.lhs].data();
+    double const* rhs = _columns[instruction.rhs].data();
+
+    switch (instruction.op) {
+      case OpCode::LoadConstant:
+        std::fill_n(out, n, instruction.constant);
+        break;
+      case OpCode::LoadRegister:
+      case OpCode::LoadAttribute:
+        if (!load(instruction, block, from, to, out)) {
+          return false;
+        }
+        break;
+      case OpCode::Plus:
+        applyBinary(lhs, rhs, out, n, [](double l, double r) { return l + r; });
+        if (!allFinite(out, n)) {
+          return false;
+        }
+        break;
+      case OpCode::Minus:
+        applyBinary(lhs, rhs, out, n, [](double l, double r) { return l - r; });
+        if (!allFinite(out, n)) {
+          return false;
+        }
+        break;
+      case OpCode::Times:
+        applyBinary(lhs, rhs, out, n, [](double l, double r) { return l * r; });
+        if (!allFinite(out, n)) {
+          return false;
+        }
+        break;
+      case OpCode::Div:
+        // division by zero produces a warning, which only the regular
+        // expression execution can do
+        if (!noneZero(rhs, n)) {
+          return false;
+        }
+        applyBinary(lhs, rhs, out, n, [](double l, double r) { return l / r; });
+        if (!allFinite(out, n)) {
+          return false;
+        }
+        break;
+      case OpCode::Mod:
+        if (!noneZero(rhs, n)) {
+          return false;
+        }
+        applyBinary(lhs, rhs, out, n,
+                    [](double l, double r) { return std::fmod(l, r); });
+        if (!allFinite(out, n)) {
+          return false;
+        }
+        break;
+      case OpCode::Eq:
+        applyBinary(lhs, rhs, out, n,
+                    [](double l, double r) { return double(l == r); });
+        break;
+      case OpCode::Ne:
+        applyBinary(lhs, rhs, out, n,
+                    [](double l, double r) { return double(l != r); });
+        break;
+      case OpCode::Lt:
+        applyBinary(lhs, rhs, out, n,
+                    [](double l, double r) { return double(l < r); });
+        break;
+      case OpCode::Le:
+        applyBinary(lhs, rhs, out, n,
+                    [](double l, double r) { return double(l <= r); });
+        break;
+      case OpCode::Gt:
+        applyBinary(lhs, rhs, out, n,
+                    [](double l, double r) { return double(l > r); });
+        break;
+      case OpCode::Ge:
+        applyBinary(lhs, rhs, out, n,
+                    [](double l, double r) { return double(l >= r); });
+        break;
+      case OpCode::And:
+        applyBinary(lhs, rhs, out, n,
+                    [](double l, double r) { return l * r; });
+        break;
+      case OpCode::Or:
+        applyBinary(lhs, rhs, out, n,
+                    [](double l, double r) { return std::max(l, r); });
+        break;
+      case OpCode::Not:
+        for (size_t i = 0; i < n; ++i) {
+          out[i] = 1.0 - lhs[i];
+        }
+        break;
+    }
+  }
+  return true;
+}
+
+double ExpressionKernel::numberResult(size_t i) const noexcept {
+  TRI_ASSERT(_resultType == ResultType::Number);
+  TRI_ASSERT(i < _columns.back().size());
+  return _columns.back()[i];
+}
+
+bool ExpressionKernel::boolResult(size_t i) const noexcept {
+  TRI_ASSERT(_resultType == ResultType::Bool);
+  TRI_ASSERT(i < _columns.back().size());
+  return _columns.back()[i] != 0.0;
+}
@@ -0,0 +1,144 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Aql/types.h"
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace arangodb::aql {
+
+class AqlItemBlock;
+struct AstNode;
+
+/// @brief a small, typed evaluation kernel for simple numeric expressions.
+/// The kernel is compiled once from an expression's AST and can then be
+/// evaluated for a whole range of rows of an AqlItemBlock at once.
+/// Supported are numeric constants, references to input variables and
+/// attribute accesses on them (e.g. `doc.a.b`), the arithmetic operators
+/// `+ - * / %`, the comparison operators `== != < <= > >=`, and `AND`, `OR`,
+/// `NOT` on the results of comparisons.
+/// The kernel only handles inputs that are all numbers and that produce
+/// results identical to the regular expression execution. For all other
+/// inputs (e.g. strings, null, division by zero or non-finite intermediate
+/// results), evaluate() returns false, and the caller must fall back to
+/// Expression::execute() for the batch.
+class ExpressionKernel {
+ public:
+  enum class ResultType : std::uint8_t { Number, Bool };
+
+  ExpressionKernel(ExpressionKernel const&) = delete;
+  ExpressionKernel& operator=(ExpressionKernel const&) = delete;
+  ~ExpressionKernel();
+
+  /// @brief try to compile a kernel for the expression. returns a nullptr if
+  /// the expression contains anything the kernel does not support.
+  static std::unique_ptr<ExpressionKernel> compile(
+      AstNode const* node,
+      std::vector<std::pair<VariableId, RegisterId>> const& varToRegs);
+
+  /// @brief type of the values produced by the kernel
+  ResultType resultType() const noexcept { return _resultType; }
+
+  /// @brief evaluate the kernel for rows [from, to) of the block. returns
+  /// false if the kernel cannot produce results for this range
+  bool evaluate(AqlItemBlock const& block, size_t from, size_t to);
+
+  /// @brief get result for the i-th row of the last successful evaluate()
+  /// call. Only valid if resultType() is Number
+  double numberResult(size_t i) const noexcept;
+
+  /// @brief get result for the i-th row of the last successful evaluate()
+  /// call. Only valid if resultType() is Bool
+  bool boolResult(size_t i) const noexcept;
+
+ private:
+  enum class OpCode : std::uint8_t {
+    LoadConstant,
+    LoadRegister,
+    LoadAttribute,
+    Plus,
+    Minus,
+    Times,
+    Div,
+    Mod,
+    Eq,
+    Ne,
+    Lt,
+    Le,
+    Gt,
+    Ge,
+    And,
+    Or,
+    Not,
+  };
+
+  struct Instruction {
+    OpCode op;
+    // register to load from (for LoadRegister and LoadAttribute)
+    RegisterId reg;
+    // constant value (for LoadConstant)
+    double constant = 0.0;
+    // index into _paths (for LoadAttribute)
+    size_t path = 0;
+    // operand slots. the result slot of an instruction is its own index
+    size_t lhs = 0;
+    size_t rhs = 0;
+  };
+
+  /// @brief marker for unsupported (sub-)expressions
+  static constexpr size_t invalidSlot = std::numeric_limits<size_t>::max();
+
+  ExpressionKernel() = default;
+
+  /// @brief recursively build the instructions for the node. returns the
+  /// slot of the node's result, or invalidSlot if the node is unsupported
+  size_t build(AstNode const* node,
+               std::vector<std::pair<VariableId, RegisterId>> const& varToRegs,
+               ResultType& type);
+
+  size_t addInstruction(Instruction instruction);
+
+  /// @brief gather the numbers of rows [from, to) for a load instruction.
+  /// returns false if any of the values is not a number that can be
+  /// represented exactly as a double
+  bool load(Instruction const& instruction, AqlItemBlock const& block,
+            size_t from, size_t to, double* out);
+
+  std::vector<Instruction> _instructions;
+
+  /// @brief attribute paths used by LoadAttribute instructions
+  std::vector<std::vector<std::string>> _paths;
+
+  /// @brief one column per instruction, either holding doubles or booleans
+  /// (as 0.0/1.0). the columns are reused between evaluate() calls
+  std::vector<std::vector<double>> _columns;
+
+  ResultType _resultType = ResultType::Number;
+};
+
+}  // namespace arangodb::aql
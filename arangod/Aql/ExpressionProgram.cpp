@@ -0,0 +1,529 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "ExpressionProgram.h"
+
+#include "Aql/AqlValue.h"
+#include "Aql/Expression.h"
+#include "Aql/ExpressionContext.h"
+#include "Aql/Variable.h"
+#include "Basics/debugging.h"
+#include "Basics/voc-errors.h"
+#include "Containers/SmallVector.h"
+#include "Transaction/Methods.h"
+
+#include <velocypack/Slice.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <string>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+namespace {
+
+/// @brief a value on the stack of the program. numbers and booleans
+/// produced by the program itself are not turned into AqlValues
+struct Slot {
+  enum class Kind : std::uint8_t { Value, Number, Bool };
+
+  static Slot fromValue(AqlValue value, bool mustDestroy) noexcept {
+    Slot slot;
+    slot.value = value;
+    slot.mustDestroy = mustDestroy;
+    return slot;
+  }
+
+  static Slot fromNumber(double number) noexcept {
+    if (!std::isfinite(number)) {
+      // the regular expression code converts NaN and +/-inf into null
+      return fromValue(AqlValue(AqlValueHintNull()), false);
+    }
+    Slot slot;
+    slot.kind = Kind::Number;
+    slot.number = number;
+    return slot;
+  }
+
+  static Slot fromBool(bool b) noexcept {
+    Slot slot;
+    slot.kind = Kind::Bool;
+    slot.number = b ? 1.0 : 0.0;
+    return slot;
+  }
+
+  bool toBoolean() const noexcept {
+    if (kind == Kind::Value) {
+      return value.toBoolean();
+    }
+    return number != 0.0;
+  }
+
+  double toDouble() const {
+    if (kind == Kind::Value) {
+      bool failed = false;
+      double result = value.toDouble(failed);
+      return failed ? 0.0 : result;
+    }
+    return number;
+  }
+
+  /// @brief the slot as an AqlValue. the slot keeps ownership of the value
+  AqlValue toAqlValue() const noexcept {
+    switch (kind) {
+      case Kind::Number:
+        return AqlValue(AqlValueHintDouble(number));
+      case Kind::Bool:
+        return AqlValue(AqlValueHintBool(number != 0.0));
+      case Kind::Value:
+        break;
+    }
+    return value;
+  }
+
+  void destroy() noexcept {
+    if (mustDestroy) {
+      value.destroy();
+      mustDestroy = false;
+    }
+  }
+
+  AqlValue value;
+  // number, or 0.0/1.0 for booleans
+  double number = 0.0;
+  Kind kind = Kind::Value;
+  bool mustDestroy = false;
+};
+
+/// @brief the stack of the program, destroys all values left on it
+class Stack {
+ public:
+  explicit Stack(size_t capacity) { _slots.reserve(capacity); }
+
+  ~Stack() {
+    for (auto& slot : _slots) {
+      slot.destroy();
+    }
+  }
+
+  void push(Slot slot) noexcept {
+    // the capacity was reserved upfront, so this does not allocate
+    TRI_ASSERT(_slots.size() < _slots.capacity());
+    _slots.push_back(slot);
+  }
+
+  /// @brief destroy the value on top of the stack and remove it
+  void pop() noexcept {
+    TRI_ASSERT(!_slots.empty());
+    _slots.back().destroy();
+    _slots.pop_back();
+  }
+
+  Slot& top() noexcept {
+    TRI_ASSERT(!_slots.empty());
+    return _slots.back();
+  }
+
+  Slot& below() noexcept {
+    TRI_ASSERT(_slots.size() >= 2);
+    return _slots[_slots.size() - 2];
+  }
+
+  size_t size() const noexcept { return _slots.size(); }
+
+ private:
+  containers::SmallVector<Slot, 8> _slots;
+};
+
+/// @brief unary plus for an AqlValue, same as Expression does it
+AqlValue unaryPlus(AqlValue const& operand) {
+  if (operand.isNumber()) {
+    VPackSlice const s = operand.slice();
+    if (s.isSmallInt() || s.isInt()) {
+      return AqlValue(AqlValueHintInt(s.getNumber<int64_t>()));
+    } else if (s.isUInt()) {
+      return AqlValue(AqlValueHintUInt(s.getUInt()));
+    }
+  }
+  bool failed = false;
+  double value = operand.toDouble(failed);
+  if (failed) {
+    value = 0.0;
+  }
+  return AqlValue(AqlValueHintDouble(+value));
+}
+
+/// @brief unary minus for an AqlValue, same as Expression does it
+AqlValue unaryMinus(AqlValue const& operand) {
+  if (operand.isNumber()) {
+    VPackSlice const s = operand.slice();
+    if (s.isSmallInt()) {
+      return AqlValue(AqlValueHintInt(-s.getNumber<int64_t>()));
+    } else if (s.isInt()) {
+      int64_t v = s.getNumber<int64_t>();
+      if (v != INT64_MIN) {
+        return AqlValue(AqlValueHintInt(-v));
+      }
+    } else if (s.isUInt()) {
+      uint64_t v = s.getNumber<uint64_t>();
+      if (v <= uint64_t(INT64_MAX)) {
+        return AqlValue(AqlValueHintInt(-s.getNumber<int64_t>()));
+      }
+    }
+  }
+  bool failed = false;
+  double value = operand.toDouble(failed);
+  if (failed) {
+    value = 0.0;
+  }
+  return AqlValue(AqlValueHintDouble(-value));
+}
+
+bool compareResult(AstNodeType type, int result) noexcept {
+  switch (type) {
+    case NODE_TYPE_OPERATOR_BINARY_EQ:
+      return result == 0;
+    case NODE_TYPE_OPERATOR_BINARY_NE:
+      return result != 0;
+    case NODE_TYPE_OPERATOR_BINARY_LT:
+      return result < 0;
+    case NODE_TYPE_OPERATOR_BINARY_LE:
+      return result <= 0;
+    case NODE_TYPE_OPERATOR_BINARY_GT:
+      return result > 0;
+    case NODE_TYPE_OPERATOR_BINARY_GE:
+      return result >= 0;
+    default:
+      TRI_ASSERT(false);
+      return false;
+  }
+}
+
+}  // namespace
+
+std::unique_ptr<ExpressionProgram> ExpressionProgram::compile(
+    AstNode const* node) {
+  TRI_ASSERT(node != nullptr);
+
+  std::unique_ptr<ExpressionProgram> program(new ExpressionProgram());
+  program->build(node, true);
+  TRI_ASSERT(program->_stackSize == 1);
+
+  if (program->_instructions.size() <= 1) {
+    // a single instruction does the same as the regular execution
+    return nullptr;
+  }
+  return program;
+}
+
+void ExpressionProgram::build(AstNode const* node, bool doCopy) {
+  switch (node->type) {
+    case NODE_TYPE_VALUE:
+      addInstruction({.op = OpCode::LoadConstant, .node = node}, 1);
+      return;
+
+    case NODE_TYPE_REFERENCE:
+      addInstruction(
+          {.op = OpCode::LoadVariable,
+           .doCopy = doCopy,
+           .variable = static_cast<Variable const*>(node->getData())},
+          1);
+      return;
+
+    case NODE_TYPE_ATTRIBUTE_ACCESS:
+      TRI_ASSERT(node->numMembers() == 1);
+      build(node->getMemberUnchecked(0), false);
+      addInstruction(
+          {.op = OpCode::LoadAttribute, .name = node->getStringView()}, 0);
+      return;
+
+    case NODE_TYPE_OPERATOR_BINARY_PLUS:
+    case NODE_TYPE_OPERATOR_BINARY_MINUS:
+    case NODE_TYPE_OPERATOR_BINARY_TIMES:
+    case NODE_TYPE_OPERATOR_BINARY_DIV:
+    case NODE_TYPE_OPERATOR_BINARY_MOD:
+      build(node->getMemberUnchecked(0), true);
+      build(node->getMemberUnchecked(1), true);
+      addInstruction({.op = OpCode::Arithmetic, .type = node->type}, -1);
+      return;
+
+    case NODE_TYPE_OPERATOR_BINARY_EQ:
+    case NODE_TYPE_OPERATOR_BINARY_NE:
+    case NODE_TYPE_OPERATOR_BINARY_LT:
+    case NODE_TYPE_OPERATOR_BINARY_LE:
+    case NODE_TYPE_OPERATOR_BINARY_GT:
+    case NODE_TYPE_OPERATOR_BINARY_GE:
+      build(node->getMemberUnchecked(0), false);
+      build(node->getMemberUnchecked(1), false);
+      addInstruction({.op = OpCode::Compare, .type = node->type}, -1);
+      return;
+
+    case NODE_TYPE_OPERATOR_UNARY_NOT:
+      build(node->getMember(0), false);
+      addInstruction({.op = OpCode::Not}, 0);
+      return;
+
+    case NODE_TYPE_OPERATOR_UNARY_PLUS:
+      build(node->getMember(0), false);
+      addInstruction({.op = OpCode::Plus}, 0);
+      return;
+
+    case NODE_TYPE_OPERATOR_UNARY_MINUS:
+      build(node->getMember(0), false);
+      addInstruction({.op = OpCode::Minus}, 0);
+      return;
+
+    case NODE_TYPE_OPERATOR_BINARY_AND:
+    case NODE_TYPE_OPERATOR_BINARY_OR: {
+      build(node->getMemberUnchecked(0), true);
+      size_t const jump = _instructions.size();
+      // the stack change is for the fall-through case. if the jump is
+      // taken, the left operand is the result
+      addInstruction({.op = node->type == NODE_TYPE_OPERATOR_BINARY_AND
+                                ? OpCode::JumpIfFalse
+                                : OpCode::JumpIfTrue},
+                     -1);
+      build(node->getMemberUnchecked(1), true);
+      _instructions[jump].target = static_cast<uint32_t>(_instructions.size());
+      return;
+    }
+
+    case NODE_TYPE_OPERATOR_TERNARY: {
+      if (node->numMembers() == 2) {
+        // a ?: b
+        build(node->getMember(0), true);
+        size_t const jump = _instructions.size();
+        addInstruction({.op = OpCode::JumpIfTrue}, -1);
+        build(node->getMemberUnchecked(1), true);
+        _instructions[jump].target =
+            static_cast<uint32_t>(_instructions.size());
+        return;
+      }
+
+      TRI_ASSERT(node->numMembers() == 3);
+      build(node->getMember(0), false);
+      size_t const jumpToFalse = _instructions.size();
+      addInstruction({.op = OpCode::PopJumpIfFalse}, -1);
+      build(node->getMemberUnchecked(1), true);
+      size_t const jumpToEnd = _instructions.size();
+      // the false part starts with the stack the true part started with
+      addInstruction({.op = OpCode::Jump}, -1);
+      _instructions[jumpToFalse].target =
+          static_cast<uint32_t>(_instructions.size());
+      build(node->getMemberUnchecked(2), true);
+      _instructions[jumpToEnd].target =
+          static_cast<uint32_t>(_instructions.size());
+      return;
+    }
+
+    default:
+      // everything else is executed by the regular expression code
+      addInstruction({.op = OpCode::Evaluate, .doCopy = doCopy, .node = node},
+                     1);
+      return;
+  }
+}
+
+void ExpressionProgram::addInstruction(Instruction instruction,
+                                       int stackChange) {
+  TRI_ASSERT(stackChange >= 0 || _stackSize >= size_t(-stackChange));
+  _instructions.emplace_back(instruction);
+  _stackSize += stackChange;
+  _maxStackSize = std::max(_maxStackSize, _stackSize);
+}
+
+AqlValue ExpressionProgram::execute(ExpressionContext& ctx,
+                                    bool& mustDestroy) const {
+  Stack stack(_maxStackSize);
+
+  size_t const n = _instructions.size();
+  size_t pc = 0;
+  while (pc < n) {
+    Instruction const& instruction = _instructions[pc++];
+
+    switch (instruction.op) {
+      case OpCode::LoadConstant: {
+        bool localMustDestroy = false;
+        AqlValue value = Expression::executeSimpleExpressionValue(
+            ctx, instruction.node, localMustDestroy);
+        stack.push(Slot::fromValue(value, localMustDestroy));
+        break;
+      }
+
+      case OpCode::LoadVariable: {
+        bool localMustDestroy = false;
+        AqlValue value = ctx.getVariableValue(
+            instruction.variable, instruction.doCopy, localMustDestroy);
+        stack.push(Slot::fromValue(value, localMustDestroy));
+        break;
+      }
+
+      case OpCode::LoadAttribute: {
+        Slot& slot = stack.top();
+        bool localMustDestroy = false;
+        AqlValue value;
+        if (slot.kind == Slot::Kind::Value) {
+          auto* resolver = ctx.trx().resolver();
+          TRI_ASSERT(resolver != nullptr);
+          value = slot.value.get(*resolver, instruction.name, localMustDestroy,
+                                 true);
+        } else {
+          // attributes of numbers and booleans are null
+          value = AqlValue(AqlValueHintNull());
+        }
+        slot.destroy();
+        slot = Slot::fromValue(value, localMustDestroy);
+        break;
+      }
+
+      case OpCode::Evaluate: {
+        bool localMustDestroy = false;
+        AqlValue value = Expression::executeSimpleExpression(
+            ctx, instruction.node, localMustDestroy, instruction.doCopy);
+        stack.push(Slot::fromValue(value, localMustDestroy));
+        break;
+      }
+
+      case OpCode::Arithmetic: {
+        double const l = stack.below().toDouble();
+        double const r = stack.top().toDouble();
+        stack.pop();
+        stack.pop();
+
+        if (r == 0.0 && (instruction.type == NODE_TYPE_OPERATOR_BINARY_DIV ||
+                         instruction.type == NODE_TYPE_OPERATOR_BINARY_MOD)) {
+          // division by zero
+          std::string msg("in operator ");
+          msg.append(instruction.type == NODE_TYPE_OPERATOR_BINARY_DIV ? "/"
+                                                                        : "%");
+          msg.append(": ");
+          msg.append(TRI_errno_string(TRI_ERROR_QUERY_DIVISION_BY_ZERO));
+          ctx.registerWarning(TRI_ERROR_QUERY_DIVISION_BY_ZERO, msg.c_str());
+          stack.push(Slot::fromValue(AqlValue(AqlValueHintNull()), false));
+          break;
+        }
+
+        double result = 0.0;
+        switch (instruction.type) {
+          case NODE_TYPE_OPERATOR_BINARY_PLUS:
+            result = l + r;
+            break;
+          case NODE_TYPE_OPERATOR_BINARY_MINUS:
+            result = l - r;
+            break;
+          case NODE_TYPE_OPERATOR_BINARY_TIMES:
+            result = l * r;
+            break;
+          case NODE_TYPE_OPERATOR_BINARY_DIV:
+            result = l / r;
+            break;
+          case NODE_TYPE_OPERATOR_BINARY_MOD:
+            result = std::fmod(l, r);
+            break;
+          default:
+            TRI_ASSERT(false);
+            break;
+        }
+        stack.push(Slot::fromNumber(result));
+        break;
+      }
+
+      case OpCode::Compare: {
+        Slot const& lhs = stack.below();
+        Slot const& rhs = stack.top();
+        int result;
+        if (lhs.kind != Slot::Kind::Value && lhs.kind == rhs.kind) {
+          // two numbers or two booleans produced by the program
+          result = lhs.number < rhs.number ? -1
+                                           : (lhs.number > rhs.number ? 1 : 0);
+        } else {
+          // for equality and non-equality we can use a binary comparison
+          bool const compareUtf8 =
+              (instruction.type != NODE_TYPE_OPERATOR_BINARY_EQ &&
+               instruction.type != NODE_TYPE_OPERATOR_BINARY_NE);
+          result = AqlValue::Compare(&ctx.trx().vpackOptions(),
+                                     lhs.toAqlValue(), rhs.toAqlValue(),
+                                     compareUtf8);
+        }
+        stack.pop();
+        stack.pop();
+        stack.push(Slot::fromBool(compareResult(instruction.type, result)));
+        break;
+      }
+
+      case OpCode::Not: {
+        Slot& slot = stack.top();
+        bool const result = !slot.toBoolean();
+        slot.destroy();
+        slot = Slot::fromBool(result);
+        break;
+      }
+
+      case OpCode::Plus:
+      case OpCode::Minus: {
+        bool const minus = instruction.op == OpCode::Minus;
+        Slot& slot = stack.top();
+        if (slot.kind == Slot::Kind::Value) {
+          AqlValue value =
+              minus ? unaryMinus(slot.value) : unaryPlus(slot.value);
+          slot.destroy();
+          slot = Slot::fromValue(value, false);
+        } else {
+          slot = Slot::fromNumber(minus ? -slot.number : slot.number);
+        }
+        break;
+      }
+
+      case OpCode::JumpIfFalse:
+      case OpCode::JumpIfTrue: {
+        bool const jumpIf = instruction.op == OpCode::JumpIfTrue;
+        if (stack.top().toBoolean() == jumpIf) {
+          pc = instruction.target;
+        } else {
+          stack.pop();
+        }
+        break;
+      }
+
+      case OpCode::PopJumpIfFalse: {
+        bool const condition = stack.top().toBoolean();
+        stack.pop();
+        if (!condition) {
+          pc = instruction.target;
+        }
+        break;
+      }
+
+      case OpCode::Jump:
+        pc = instruction.target;
+        break;
+    }
+  }
+
+  TRI_ASSERT(stack.size() == 1);
+  Slot& result = stack.top();
+  mustDestroy = result.mustDestroy;
+  // the caller takes over the ownership
+  result.mustDestroy = false;
+  return result.toAqlValue();
+}
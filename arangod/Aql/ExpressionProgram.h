@@ -0,0 +1,122 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Aql/AstNode.h"
+
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace arangodb::aql {
+
+struct AqlValue;
+class ExpressionContext;
+struct Variable;
+
+/// @brief a compiled form of a SIMPLE expression, which is executed by a
+/// small stack machine instead of recursively walking the AST.
+/// Expressions are compiled only once they have been executed
+/// compileThreshold times, so that expressions which are executed rarely do
+/// not pay for the compilation. Long-lived expressions can be compiled right
+/// away via Expression::compile().
+/// References, constants, attribute accesses, the arithmetic operators,
+/// the comparison operators `== != < <= > >=`, unary `+ - !`, `AND`, `OR`
+/// and the ternary operator are compiled into instructions. Intermediate
+/// numbers and booleans are kept as plain doubles and bools between
+/// instructions, so that e.g. `doc.a * 2 + 1 > doc.b` does not create
+/// AqlValues for its intermediate results. All other sub-expressions (e.g.
+/// function calls) are executed by the regular expression code. The results
+/// are identical to the regular expression execution.
+class ExpressionProgram {
+ public:
+  /// @brief number of executions of an expression before it gets compiled
+  static constexpr uint32_t compileThreshold = 1000;
+
+  ExpressionProgram(ExpressionProgram const&) = delete;
+  ExpressionProgram& operator=(ExpressionProgram const&) = delete;
+
+  /// @brief compile the expression. returns a nullptr if the program would
+  /// not be any faster than the regular expression execution, e.g. if the
+  /// expression is a single function call
+  static std::unique_ptr<ExpressionProgram> compile(AstNode const* node);
+
+  /// @brief execute the program. same contract as Expression::execute()
+  AqlValue execute(ExpressionContext& ctx, bool& mustDestroy) const;
+
+ private:
+  enum class OpCode : std::uint8_t {
+    // push the value of a NODE_TYPE_VALUE node
+    LoadConstant,
+    // push the value of a variable
+    LoadVariable,
+    // replace the top of the stack with one of its attributes
+    LoadAttribute,
+    // execute the node with the regular expression code, push the result
+    Evaluate,
+    Arithmetic,
+    Compare,
+    Not,
+    Plus,
+    Minus,
+    // if the top of the stack is false, jump and keep it, otherwise pop it
+    JumpIfFalse,
+    // if the top of the stack is true, jump and keep it, otherwise pop it
+    JumpIfTrue,
+    // pop the top of the stack, jump if it was false
+    PopJumpIfFalse,
+    Jump,
+  };
+
+  struct Instruction {
+    OpCode op;
+    // operator for Arithmetic and Compare
+    AstNodeType type = NODE_TYPE_NOP;
+    // whether values must be copied (for LoadVariable and Evaluate)
+    bool doCopy = false;
+    // jump target
+    uint32_t target = 0;
+    // node for LoadConstant and Evaluate
+    AstNode const* node = nullptr;
+    // variable for LoadVariable
+    Variable const* variable = nullptr;
+    // attribute name for LoadAttribute, points into the AST
+    std::string_view name;
+  };
+
+  ExpressionProgram() = default;
+
+  /// @brief recursively add the instructions for the node. doCopy has the
+  /// same meaning as in Expression::executeSimpleExpression()
+  void build(AstNode const* node, bool doCopy);
+
+  void addInstruction(Instruction instruction, int stackChange);
+
+  std::vector<Instruction> _instructions;
+
+  /// @brief stack depth while building, and maximum stack depth
+  size_t _stackSize = 0;
+  size_t _maxStackSize = 0;
+};
+
+}  // namespace arangodb::aql
@@ -28,6 +28,7 @@
 
 #include "Aql/AqlCall.h"
 #include "Aql/AqlCallStack.h"
+#include "Aql/AqlItemBlock.h"
 #include "Aql/AqlItemBlockInputRange.h"
 #include "Aql/InputAqlItemRow.h"
 #include "Aql/OutputAqlItemRow.h"
@@ -57,6 +58,8 @@ auto FilterExecutor::skipRowsRange(AqlItemBlockInputRange& inputRange,
                                    AqlCall& call)
     -> std::tuple<ExecutorState, Stats, size_t, AqlCall> {
   FilterStats stats{};
+  // skipping moves the input range, so a pending selection cannot be resumed
+  _selectionBlock = nullptr;
 
   while (inputRange.hasDataRow() && call.needSkipMore()) {
     auto const [unused, input] =
@@ -82,15 +85,49 @@ auto FilterExecutor::produceRows(AqlItemBlockInputRange& inputRange,
   FilterStats stats{};
 
   while (inputRange.hasDataRow() && !output.isFull()) {
-    auto const& [state, input] =
-        inputRange.nextDataRow(AqlItemBlockInputRange::HasDataRow{});
-    TRI_ASSERT(input);
-    TRI_ASSERT(input.isInitialized());
-    if (input.getValue(_infos.getInputRegister()).toBoolean()) {
+    auto const& block = inputRange.getBlock();
+    TRI_ASSERT(block != nullptr);
+    size_t const from = inputRange.getRowIndex();
+    if (_selectionBlock.get() != block.get() || _selectionResume != from) {
+      // evaluate the filter for all data rows up to the next shadow row or
+      // the end of the block, before copying any of the surviving rows
+      size_t to = block->numRows();
+      if (auto [it, end] = block->getShadowRowIndexesFrom(from); it != end) {
+        to = *it;
+      }
+      TRI_ASSERT(from < to);
+      _numSelected = selectRows(*block, from, to);
+      _selectionBlock = block;
+      _selectionPosition = 0;
+      _selectionEnd = to;
+    }
+
+    size_t copied = 0;
+    // all rows before this index have been consumed
+    size_t consumed = _selectionEnd;
+    for (; _selectionPosition < _numSelected; ++_selectionPosition) {
+      if (output.isFull()) {
+        // the rows starting at this one are left for the next call, which
+        // continues with the rest of the selection
+        consumed = _selection[_selectionPosition];
+        break;
+      }
+      InputAqlItemRow input{block, _selection[_selectionPosition]};
+      TRI_ASSERT(input.isInitialized());
       output.copyRow(input);
       output.advanceRow();
+      ++copied;
+    }
+    stats.incrFiltered(consumed - from - copied);
+
+    while (inputRange.getRowIndex() < consumed) {
+      inputRange.advanceDataRow();
+    }
+    if (consumed == _selectionEnd) {
+      // the whole batch has been consumed
+      _selectionBlock = nullptr;
     } else {
-      stats.incrFiltered();
+      _selectionResume = consumed;
     }
   }
 
@@ -98,6 +135,30 @@ auto FilterExecutor::produceRows(AqlItemBlockInputRange& inputRange,
   return {inputRange.upstreamState(), stats, AqlCall{}};
 }
 
+size_t FilterExecutor::selectRows(AqlItemBlock const& block, size_t from,
+                                  size_t to) {
+  TRI_ASSERT(from <= to);
+  RegisterId const reg = _infos.getInputRegister();
+  _selection.resize(to - from);
+
+  // the selection vector is filled without branching on the filter result:
+  // the index of every row is written, but only kept if the row passes
+  size_t numSelected = 0;
+  if (block.hasContiguousColumns()) {
+    auto const values = block.getColumn(reg.value(), from, to);
+    for (size_t i = 0; i < values.size(); ++i) {
+      _selection[numSelected] = from + i;
+      numSelected += values[i].toBoolean() ? 1 : 0;
+    }
+  } else {
+    for (size_t row = from; row < to; ++row) {
+      _selection[numSelected] = row;
+      numSelected += block.getValueReference(row, reg).toBoolean() ? 1 : 0;
+    }
+  }
+  return numSelected;
+}
+
 [[nodiscard]] auto FilterExecutor::expectedNumberOfRowsNew(
     AqlItemBlockInputRange const& input, AqlCall const& call) const noexcept
     -> size_t {
@@ -28,13 +28,16 @@
 
 #include "Aql/ExecutionState.h"
 #include "Aql/RegisterInfos.h"
+#include "Aql/SharedAqlItemBlockPtr.h"
 #include "Aql/types.h"
 
 #include <memory>
+#include <vector>
 
 namespace arangodb::aql {
 
 struct AqlCall;
+class AqlItemBlock;
 class AqlItemBlockInputRange;
 class InputAqlItemRow;
 class OutputAqlItemRow;
@@ -104,7 +107,33 @@ class FilterExecutor {
       -> size_t;
 
  private:
+  /**
+   * @brief evaluate the filter condition for the data rows [from, to) of
+   *        the block, and store the indexes of all rows that pass the
+   *        filter in _selection.
+   *
+   * @return the number of rows that passed the filter
+   */
+  size_t selectRows(AqlItemBlock const& block, size_t from, size_t to);
+
   Infos& _infos;
+
+  // selection vector with the indexes of the input rows that passed the
+  // filter. reused between calls to avoid reallocations.
+  std::vector<size_t> _selection;
+
+  // the block the current selection belongs to, or a nullptr if there is
+  // none. if the output is full before all selected rows are copied, the
+  // next call continues with the rest of the selection instead of
+  // evaluating the remaining rows of the batch again
+  SharedAqlItemBlockPtr _selectionBlock;
+  // the input row at which the rest of the selection continues
+  size_t _selectionResume = 0;
+  // position of the next selected row in _selection
+  size_t _selectionPosition = 0;
+  size_t _numSelected = 0;
+  // end of the batch of rows the selection was built for
+  size_t _selectionEnd = 0;
 };
 
 }  // namespace arangodb::aql
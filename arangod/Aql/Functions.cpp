@@ -27,6 +27,7 @@
 #include "ApplicationFeatures/ApplicationServer.h"
 #include "ApplicationFeatures/LanguageFeature.h"
 #include "Aql/AqlFunctionFeature.h"
+#include "Aql/AqlFunctionsInternalCache.h"
 #include "Aql/AqlValueMaterializer.h"
 #include "Aql/Expression.h"
 #include "Aql/ExpressionContext.h"
@@ -3214,6 +3215,22 @@ AqlValue functions::Like(ExpressionContext* expressionContext, AstNode const&,
   AqlValue const& regex = extractFunctionParameterValue(parameters, 1);
   ::appendAsString(vopts, adapter, regex);
 
+  // extract value
+  transaction::StringLeaser valueBuffer(trx);
+  velocypack::StringSink valueAdapter(valueBuffer.get());
+  AqlValue const& value = extractFunctionParameterValue(parameters, 0);
+  ::appendAsString(vopts, valueAdapter, value);
+
+  if (!caseInsensitive) {
+    // simple patterns can be matched without ICU
+    transaction::StringLeaser scratch(trx);
+    auto result = AqlFunctionsInternalCache::matchLikePattern(
+        *buffer, *valueBuffer, *scratch);
+    if (result.has_value()) {
+      return AqlValue(AqlValueHintBool(*result));
+    }
+  }
+
   // the matcher is owned by the context!
   icu::RegexMatcher* matcher =
       expressionContext->buildLikeMatcher(*buffer, caseInsensitive);
@@ -3224,14 +3241,9 @@ AqlValue functions::Like(ExpressionContext* expressionContext, AstNode const&,
     return AqlValue(AqlValueHintNull());
   }
 
-  // extract value
-  buffer->clear();
-  AqlValue const& value = extractFunctionParameterValue(parameters, 0);
-  ::appendAsString(vopts, adapter, value);
-
   bool error = false;
   bool const result = basics::Utf8Helper::DefaultUtf8Helper.matches(
-      matcher, buffer->data(), buffer->length(), false, error);
+      matcher, valueBuffer->data(), valueBuffer->length(), false, error);
 
   if (error) {
     // compiling regular expression failed
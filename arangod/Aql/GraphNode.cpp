@@ -526,9 +526,11 @@ GraphNode::GraphNode(ExecutionPlan* plan,
   // set traversal-translations
   _options->setCollectionToShard(
       _collectionToShard);  // could be moved as it will only be used here
+#ifdef USE_ENTERPRISE
   if (_options->parallelism() > 1) {
     _plan->getAst()->setContainsParallelNode();
   }
+#endif
 }
 
 /// @brief Internal constructor to clone the node.
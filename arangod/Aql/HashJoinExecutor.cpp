@@ -0,0 +1,372 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "HashJoinExecutor.h"
+
+#include "Aql/AqlCall.h"
+#include "Aql/AqlItemBlockInputRange.h"
+#include "Aql/AqlValue.h"
+#include "Aql/Collection.h"
+#include "Aql/ExecutionBlock.h"
+#include "Aql/OutputAqlItemRow.h"
+#include "Aql/QueryContext.h"
+#include "Aql/SingleRowFetcher.h"
+#include "Aql/Stats.h"
+#include "Basics/Exceptions.h"
+#include "Indexes/IndexIterator.h"
+
+#include <velocypack/Slice.h>
+
+#include <utility>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+namespace {
+
+// must be the same seed for the build and the probe side
+constexpr uint64_t hashSeed = 0xdeadbeef;
+
+// number of documents to read from the collection at once when building
+// the hash table
+constexpr uint64_t buildBatchSize = 1000;
+
+// approximate per-document overhead of the hash table
+constexpr size_t entryOverhead = 64;
+
+/// @brief hash the value of the (possibly nested) attribute in the same way
+/// as AqlValue::hash() does. a non-existing attribute is treated as null,
+/// as it would be in an AQL comparison
+uint64_t hashAttribute(velocypack::Slice value,
+                       std::vector<std::string> const& path) {
+  value = value.resolveExternals();
+  for (auto const& name : path) {
+    if (!value.isObject()) {
+      value = velocypack::Slice::noneSlice();
+      break;
+    }
+    value = value.get(name).resolveExternals();
+  }
+  if (value.isNone()) {
+    value = velocypack::Slice::nullSlice();
+  }
+  return value.normalizedHash(hashSeed);
+}
+
+}  // namespace
+
+HashJoinExecutorInfos::HashJoinExecutorInfos(
+    EnumerateCollectionExecutorInfos base,
+    std::vector<std::string> buildAttribute, RegisterId probeRegister,
+    std::vector<std::string> probeAttribute, size_t maxBuildRows,
+    size_t maxBuildMemoryUsage)
+    : EnumerateCollectionExecutorInfos(std::move(base)),
+      _buildAttribute(std::move(buildAttribute)),
+      _probeRegister(probeRegister),
+      _probeAttribute(std::move(probeAttribute)),
+      _maxBuildRows(maxBuildRows),
+      _maxBuildMemoryUsage(maxBuildMemoryUsage) {
+  TRI_ASSERT(!_buildAttribute.empty());
+  TRI_ASSERT(getFilter() != nullptr);
+  TRI_ASSERT(getProduceResult());
+  TRI_ASSERT(!getRandom());
+  TRI_ASSERT(!getCount());
+}
+
+std::vector<std::string> const& HashJoinExecutorInfos::getBuildAttribute()
+    const noexcept {
+  return _buildAttribute;
+}
+
+RegisterId HashJoinExecutorInfos::getProbeRegister() const noexcept {
+  return _probeRegister;
+}
+
+std::vector<std::string> const& HashJoinExecutorInfos::getProbeAttribute()
+    const noexcept {
+  return _probeAttribute;
+}
+
+size_t HashJoinExecutorInfos::getMaxBuildRows() const noexcept {
+  return _maxBuildRows;
+}
+
+size_t HashJoinExecutorInfos::getMaxBuildMemoryUsage() const noexcept {
+  return _maxBuildMemoryUsage;
+}
+
+HashJoinExecutor::HashJoinExecutor(Fetcher&, Infos& infos)
+    : _trx(infos.getQuery().newTrxContext()),
+      _infos(infos),
+      _documentProducingFunctionContext(_trx, _currentRow, infos),
+      _currentRow(InputAqlItemRow{CreateInvalidInputRowHint{}}),
+      _memoryUsage(infos.getResourceMonitor()),
+      _nextEntry(invalidEntry),
+      _cursorHasMore(false),
+      _hashTableBuilt(false),
+      _useHashTable(false) {
+  TRI_ASSERT(_trx.status() == transaction::Status::RUNNING);
+
+  _cursor = _trx.indexScan(
+      _infos.getQuery().resourceMonitor(), _infos.getCollection()->name(),
+      transaction::Methods::CursorType::ALL, infos.canReadOwnWrites());
+
+  _documentProducer =
+      buildDocumentCallback<false, false>(_documentProducingFunctionContext);
+  _documentSkipper =
+      buildDocumentCallback<false, true>(_documentProducingFunctionContext);
+}
+
+HashJoinExecutor::~HashJoinExecutor() = default;
+
+void HashJoinExecutor::buildHashTable(EnumerateCollectionStats& stats) {
+  TRI_ASSERT(!_hashTableBuilt);
+  _hashTableBuilt = true;
+  _useHashTable = true;
+
+  uint64_t scanned = 0;
+  auto cb = [&](LocalDocumentId const& id, velocypack::Slice document) {
+    ++scanned;
+    if (_useHashTable && !addToHashTable(id, document)) {
+      // limits exceeded. we will scan the collection for every input row
+      // instead
+      _useHashTable = false;
+    }
+    return true;
+  };
+
+  _cursor->reset();
+  while (_useHashTable && _cursor->nextDocument(cb, buildBatchSize)) {
+    if (_infos.getQuery().killed()) {
+      THROW_ARANGO_EXCEPTION(TRI_ERROR_QUERY_KILLED);
+    }
+  }
+  stats.incrScanned(scanned);
+
+  if (!_useHashTable) {
+    clearHashTable();
+  }
+}
+
+bool HashJoinExecutor::addToHashTable(LocalDocumentId id,
+                                      velocypack::Slice document) {
+  size_t const memoryUsage = document.byteSize() + entryOverhead;
+  if (_entries.size() >= _infos.getMaxBuildRows() ||
+      _memoryUsage.tracked() + memoryUsage > _infos.getMaxBuildMemoryUsage()) {
+    return false;
+  }
+  // may throw if the query's memory limit is exceeded
+  _memoryUsage.increase(memoryUsage);
+
+  uint64_t const hash = hashAttribute(document, _infos.getBuildAttribute());
+  size_t const index = _entries.size();
+  _entries.emplace_back(Entry{id, _documents.size(), invalidEntry});
+  _documents.append(document.start(), document.byteSize());
+
+  auto [it, inserted] = _chains.try_emplace(hash, Chain{index, index});
+  if (!inserted) {
+    _entries[it->second.tail].next = index;
+    it->second.tail = index;
+  }
+  return true;
+}
+
+void HashJoinExecutor::clearHashTable() noexcept {
+  _chains = {};
+  _entries = {};
+  _documents.clear();
+  _memoryUsage.revert();
+  _nextEntry = invalidEntry;
+}
+
+void HashJoinExecutor::initializeNewRow(AqlItemBlockInputRange& inputRange) {
+  if (_currentRow) {
+    // moves one row forward
+    inputRange.advanceDataRow();
+  }
+  std::tie(std::ignore, _currentRow) = inputRange.peekDataRow();
+  if (!_currentRow) {
+    return;
+  }
+
+  TRI_ASSERT(_currentRow.isInitialized());
+
+  if (_useHashTable) {
+    AqlValue const& value = _currentRow.getValue(_infos.getProbeRegister());
+    uint64_t hash;
+    if (_infos.getProbeAttribute().empty()) {
+      hash = value.hash(hashSeed);
+    } else if (value.isObject()) {
+      hash = hashAttribute(value.slice(), _infos.getProbeAttribute());
+    } else {
+      hash = hashAttribute(velocypack::Slice::nullSlice(), {});
+    }
+    auto it = _chains.find(hash);
+    _nextEntry = (it == _chains.end() ? invalidEntry : it->second.head);
+  } else {
+    _cursor->reset();
+    _cursorHasMore = _cursor->hasMore();
+  }
+}
+
+bool HashJoinExecutor::hasMoreMatches() const noexcept {
+  if (_useHashTable) {
+    return _nextEntry != invalidEntry;
+  }
+  return _cursorHasMore;
+}
+
+velocypack::Slice HashJoinExecutor::document(
+    Entry const& entry) const noexcept {
+  return velocypack::Slice(_documents.data() + entry.offset);
+}
+
+void HashJoinExecutor::produceMatches(OutputAqlItemRow& output) {
+  if (!_useHashTable) {
+    _cursorHasMore =
+        _cursor->nextDocument(_documentProducer, output.numRowsLeft());
+    return;
+  }
+
+  while (_nextEntry != invalidEntry && !output.isFull()) {
+    Entry const& entry = _entries[_nextEntry];
+    _nextEntry = entry.next;
+    // checks the filter condition and writes the document if it matches
+    _documentProducer(entry.id, document(entry));
+  }
+}
+
+uint64_t HashJoinExecutor::skipMatches(size_t toSkip,
+                                       EnumerateCollectionStats& stats) {
+  if (!_useHashTable) {
+    _cursorHasMore = _cursor->nextDocument(_documentSkipper, toSkip);
+  } else {
+    uint64_t skipped = 0;
+    while (_nextEntry != invalidEntry && skipped < toSkip) {
+      Entry const& entry = _entries[_nextEntry];
+      _nextEntry = entry.next;
+      if (_documentSkipper(entry.id, document(entry))) {
+        ++skipped;
+      }
+    }
+  }
+
+  uint64_t filtered =
+      _documentProducingFunctionContext.getAndResetNumFiltered();
+  uint64_t scanned = _documentProducingFunctionContext.getAndResetNumScanned();
+  TRI_ASSERT(scanned >= filtered);
+  stats.incrFiltered(filtered);
+  stats.incrScanned(scanned);
+  return scanned - filtered;
+}
+
+[[nodiscard]] auto HashJoinExecutor::expectedNumberOfRowsNew(
+    AqlItemBlockInputRange const& input, AqlCall const& call) const noexcept
+    -> size_t {
+  // we do not know how many documents match
+  return call.getLimit();
+}
+
+std::tuple<ExecutorState, EnumerateCollectionStats, AqlCall>
+HashJoinExecutor::produceRows(AqlItemBlockInputRange& inputRange,
+                              OutputAqlItemRow& output) {
+  TRI_IF_FAILURE("HashJoinExecutor::produceRows") {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+  }
+
+  EnumerateCollectionStats stats{};
+  AqlCall upstreamCall{};
+  upstreamCall.fullCount = output.getClientCall().fullCount;
+
+  TRI_ASSERT(_documentProducingFunctionContext.getAndResetNumScanned() == 0);
+  TRI_ASSERT(_documentProducingFunctionContext.getAndResetNumFiltered() == 0);
+  _documentProducingFunctionContext.setOutputRow(&output);
+
+  if (!_hashTableBuilt && inputRange.hasDataRow()) {
+    buildHashTable(stats);
+  }
+
+  while (inputRange.hasDataRow() && !output.isFull()) {
+    TRI_ASSERT(output.isInitialized());
+
+    if (!hasMoreMatches()) {
+      initializeNewRow(inputRange);
+    }
+
+    if (hasMoreMatches()) {
+      TRI_ASSERT(_currentRow.isInitialized());
+      produceMatches(output);
+
+      stats.incrScanned(
+          _documentProducingFunctionContext.getAndResetNumScanned());
+      stats.incrFiltered(
+          _documentProducingFunctionContext.getAndResetNumFiltered());
+    }
+  }
+  if (!hasMoreMatches()) {
+    initializeNewRow(inputRange);
+  }
+  return {inputRange.upstreamState(), stats, upstreamCall};
+}
+
+std::tuple<ExecutorState, EnumerateCollectionStats, size_t, AqlCall>
+HashJoinExecutor::skipRowsRange(AqlItemBlockInputRange& inputRange,
+                                AqlCall& call) {
+  AqlCall upstreamCall{};
+  EnumerateCollectionStats stats{};
+
+  if (!_hashTableBuilt && inputRange.hasDataRow()) {
+    buildHashTable(stats);
+  }
+
+  while ((inputRange.hasDataRow() || hasMoreMatches()) && call.shouldSkip()) {
+    if (!hasMoreMatches()) {
+      initializeNewRow(inputRange);
+    }
+
+    if (hasMoreMatches()) {
+      TRI_ASSERT(_currentRow.isInitialized());
+      // if offset is > 0, we're in offset skip phase, otherwise in
+      // fullCount phase
+      size_t toSkip = call.getOffset() > 0 ? call.getOffset()
+                                           : ExecutionBlock::SkipAllSize();
+      call.didSkip(skipMatches(toSkip, stats));
+    }
+  }
+  if (hasMoreMatches()) {
+    return {ExecutorState::HASMORE, stats, call.getSkipCount(), upstreamCall};
+  }
+  if (!call.needsFullCount()) {
+    // Do not overfetch too much
+    upstreamCall.softLimit = call.getOffset();
+  }
+
+  return {inputRange.upstreamState(), stats, call.getSkipCount(), upstreamCall};
+}
+
+void HashJoinExecutor::initializeCursor() {
+  // the hash table is kept, as the collection's documents do not change
+  // within the query
+  _currentRow = InputAqlItemRow{CreateInvalidInputRowHint{}};
+  _nextEntry = invalidEntry;
+  _cursorHasMore = false;
+  _cursor->reset();
+}
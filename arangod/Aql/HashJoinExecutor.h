@@ -0,0 +1,207 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Aql/DocumentProducingHelper.h"
+#include "Aql/EnumerateCollectionExecutor.h"
+#include "Aql/InputAqlItemRow.h"
+#include "Aql/RegisterInfos.h"
+#include "Basics/ResourceUsage.h"
+#include "Containers/FlatHashMap.h"
+#include "Transaction/Methods.h"
+#include "VocBase/Identifiers/LocalDocumentId.h"
+
+#include <velocypack/Buffer.h>
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace arangodb {
+class IndexIterator;
+
+namespace aql {
+
+struct AqlCall;
+class AqlItemBlockInputRange;
+class EnumerateCollectionStats;
+class OutputAqlItemRow;
+
+template<BlockPassthrough>
+class SingleRowFetcher;
+
+class HashJoinExecutorInfos : public EnumerateCollectionExecutorInfos {
+ public:
+  HashJoinExecutorInfos(EnumerateCollectionExecutorInfos base,
+                        std::vector<std::string> buildAttribute,
+                        RegisterId probeRegister,
+                        std::vector<std::string> probeAttribute,
+                        size_t maxBuildRows, size_t maxBuildMemoryUsage);
+
+  HashJoinExecutorInfos() = delete;
+  HashJoinExecutorInfos(HashJoinExecutorInfos&&) = default;
+  HashJoinExecutorInfos(HashJoinExecutorInfos const&) = delete;
+  ~HashJoinExecutorInfos() = default;
+
+  /// @brief attribute of the collection's documents the hash table is
+  /// built on
+  std::vector<std::string> const& getBuildAttribute() const noexcept;
+
+  /// @brief register of the input rows from which the lookup value is read
+  RegisterId getProbeRegister() const noexcept;
+
+  /// @brief attribute of the probe register value to look up with
+  std::vector<std::string> const& getProbeAttribute() const noexcept;
+
+  /// @brief maximum number of documents to keep in the hash table
+  size_t getMaxBuildRows() const noexcept;
+
+  /// @brief maximum memory usage of the hash table
+  size_t getMaxBuildMemoryUsage() const noexcept;
+
+ private:
+  std::vector<std::string> _buildAttribute;
+  RegisterId _probeRegister;
+  std::vector<std::string> _probeAttribute;
+  size_t const _maxBuildRows;
+  size_t const _maxBuildMemoryUsage;
+};
+
+/**
+ * @brief Implementation of an EnumerateCollectionNode that is executed as a
+ * hash join. All documents of the collection are read once and put into a hash
+ * table keyed by the build attribute. For every input row, only the documents
+ * with the same hash value as the probe value are then checked against the
+ * node's filter condition. If the hash table would grow beyond the configured
+ * limits, the executor falls back to a full collection scan per input row,
+ * exactly like the EnumerateCollectionExecutor does.
+ */
+class HashJoinExecutor {
+ public:
+  struct Properties {
+    static constexpr bool preservesOrder = true;
+    static constexpr BlockPassthrough allowsBlockPassthrough =
+        BlockPassthrough::Disable;
+    static constexpr bool inputSizeRestrictsOutputSize = false;
+  };
+  using Fetcher = SingleRowFetcher<Properties::allowsBlockPassthrough>;
+  using Infos = HashJoinExecutorInfos;
+  using Stats = EnumerateCollectionStats;
+
+  HashJoinExecutor() = delete;
+  HashJoinExecutor(HashJoinExecutor&&) = delete;
+  HashJoinExecutor(HashJoinExecutor const&) = delete;
+  HashJoinExecutor(Fetcher& fetcher, Infos&);
+  ~HashJoinExecutor();
+
+  [[nodiscard]] auto expectedNumberOfRowsNew(
+      AqlItemBlockInputRange const& input, AqlCall const& call) const noexcept
+      -> size_t;
+
+  /**
+   * @brief produce the next Rows of Aql Values.
+   *
+   * @return ExecutorState, the stats, and a new Call that needs to be send to
+   * upstream
+   */
+  [[nodiscard]] std::tuple<ExecutorState, Stats, AqlCall> produceRows(
+      AqlItemBlockInputRange& input, OutputAqlItemRow& output);
+
+  /**
+   * @brief skip the next Row of Aql Values.
+   *
+   * @return ExecutorState, the stats, and a new Call that needs to be send to
+   * upstream
+   */
+  [[nodiscard]] std::tuple<ExecutorState, Stats, size_t, AqlCall> skipRowsRange(
+      AqlItemBlockInputRange& inputRange, AqlCall& call);
+
+  void initializeCursor();
+
+ private:
+  /// @brief a document in the hash table. documents with the same hash
+  /// value are chained via their next index
+  struct Entry {
+    LocalDocumentId id;
+    size_t offset;
+    size_t next;
+  };
+
+  /// @brief first and last entry of a hash value's chain
+  struct Chain {
+    size_t head;
+    size_t tail;
+  };
+
+  static constexpr size_t invalidEntry = std::numeric_limits<size_t>::max();
+
+  /// @brief read all documents of the collection into the hash table. if that
+  /// exceeds the configured limits, the hash table is dropped again and we
+  /// fall back to scanning the collection for every input row
+  void buildHashTable(EnumerateCollectionStats& stats);
+
+  /// @brief returns false if the document could not be added because of the
+  /// configured limits
+  bool addToHashTable(LocalDocumentId id, velocypack::Slice document);
+
+  void clearHashTable() noexcept;
+
+  void initializeNewRow(AqlItemBlockInputRange& inputRange);
+
+  bool hasMoreMatches() const noexcept;
+
+  void produceMatches(OutputAqlItemRow& output);
+
+  uint64_t skipMatches(size_t toSkip, EnumerateCollectionStats& stats);
+
+  velocypack::Slice document(Entry const& entry) const noexcept;
+
+  transaction::Methods _trx;
+  Infos& _infos;
+  IndexIterator::DocumentCallback _documentProducer;
+  IndexIterator::DocumentCallback _documentSkipper;
+  DocumentProducingFunctionContext _documentProducingFunctionContext;
+  InputAqlItemRow _currentRow;
+  std::unique_ptr<IndexIterator> _cursor;
+
+  containers::FlatHashMap<uint64_t, Chain> _chains;
+  std::vector<Entry> _entries;
+
+  /// @brief copies of all documents in the hash table
+  velocypack::Buffer<uint8_t> _documents;
+
+  ResourceUsageScope _memoryUsage;
+
+  /// @brief next hash table entry to check for the current input row
+  size_t _nextEntry;
+
+  /// @brief only used when falling back to a collection scan per input row
+  bool _cursorHasMore;
+
+  bool _hashTableBuilt;
+  bool _useHashTable;
+};
+
+}  // namespace aql
+}  // namespace arangodb
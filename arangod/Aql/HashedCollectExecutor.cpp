@@ -28,7 +28,10 @@
 
 #include "Aql/Aggregator.h"
 #include "Aql/AqlCall.h"
+#include "Aql/AqlItemBlock.h"
+#include "Aql/AqlItemBlockInputRange.h"
 #include "Aql/AqlValue.h"
+#include "Aql/AqlValueArena.h"
 #include "Aql/ExecutionNode.h"
 #include "Aql/InputAqlItemRow.h"
 #include "Aql/OutputAqlItemRow.h"
@@ -37,10 +40,19 @@
 #include "Aql/SingleRowFetcher.h"
 #include "Basics/Exceptions.h"
 #include "Basics/ResourceUsage.h"
-
+#include "RestServer/TemporaryStorageFeature.h"
+#include "Scheduler/Scheduler.h"
+#include "Scheduler/SchedulerFeature.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
 #include <utility>
 
 #include <velocypack/Builder.h>
+#include <velocypack/Iterator.h>
 #include <velocypack/Options.h>
 
 using namespace arangodb;
@@ -48,13 +60,100 @@ using namespace arangodb::aql;
 
 static const AqlValue EmptyValue;
 
+namespace {
+
+/// @brief partition of a group, based on the group's hash. uses the upper
+/// bits of the hash, because the hash tables use the lower ones
+size_t partitionForHash(size_t hash, size_t numPartitions) noexcept {
+  return (static_cast<std::uint64_t>(hash) >> 32) % numPartitions;
+}
+
+/// @brief executes fn(0), ..., fn(n - 1), potentially in parallel on
+/// scheduler threads. Every task must be claimed before it is executed. The
+/// calling thread claims and executes all tasks that have not been picked up
+/// by a worker yet, so it only ever waits for tasks that are already running.
+/// Tasks that are picked up from the scheduler queue after all tasks have
+/// been claimed return immediately. Rethrows the first exception thrown by
+/// any of the tasks, after all tasks have finished.
+template<typename F>
+void runInParallel(size_t n, F const& fn) {
+  struct State {
+    explicit State(size_t n) : claimed(n), pending(n) {}
+
+    bool tryClaim(size_t i) noexcept {
+      return !claimed[i].exchange(true, std::memory_order_relaxed);
+    }
+
+    void execute(size_t i, F const& fn) noexcept {
+      try {
+        fn(i);
+      } catch (...) {
+        std::lock_guard<std::mutex> guard(mutex);
+        if (exception == nullptr) {
+          exception = std::current_exception();
+        }
+      }
+      if (pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        // need to lock the mutex to enforce serialization with the waiting
+        // thread
+        std::lock_guard<std::mutex> guard(mutex);
+        bell.notify_one();
+      }
+    }
+
+    std::vector<std::atomic<bool>> claimed;
+    std::atomic<size_t> pending;
+    std::mutex mutex;
+    std::condition_variable bell;
+    std::exception_ptr exception;
+  };
+
+  auto state = std::make_shared<State>(n);
+
+  auto* scheduler = SchedulerFeature::SCHEDULER;
+  if (scheduler != nullptr) {
+    // the calling thread will process the first task anyway
+    for (size_t i = 1; i < n; ++i) {
+      scheduler->queue(RequestLane::INTERNAL_LOW, [state, i, &fn]() {
+        // fn must only be accessed if we could claim the task. otherwise
+        // the caller may already be gone
+        if (state->tryClaim(i)) {
+          state->execute(i, fn);
+        }
+      });
+    }
+  }
+
+  for (size_t i = 0; i < n; ++i) {
+    if (state->tryClaim(i)) {
+      state->execute(i, fn);
+    }
+  }
+
+  {
+    std::unique_lock<std::mutex> guard(state->mutex);
+    state->bell.wait(guard, [&state]() {
+      return state->pending.load(std::memory_order_acquire) == 0;
+    });
+  }
+
+  if (state->exception != nullptr) {
+    std::rethrow_exception(state->exception);
+  }
+}
+
+}  // namespace
+
 HashedCollectExecutorInfos::HashedCollectExecutorInfos(
     std::vector<std::pair<RegisterId, RegisterId>>&& groupRegisters,
     RegisterId collectRegister, RegisterId expressionRegister,
     Variable const* expressionVariable, std::vector<std::string> aggregateTypes,
     std::vector<std::pair<std::string, RegisterId>>&& inputVariables,
     std::vector<std::pair<RegisterId, RegisterId>>&& aggregateRegisters,
-    velocypack::Options const* opts, arangodb::ResourceMonitor& resourceMonitor)
+    velocypack::Options const* opts, arangodb::ResourceMonitor& resourceMonitor,
+    size_t parallelism, TemporaryStorageFeature* tempStorage,
+    size_t spillOverThresholdNumRows, size_t spillOverThresholdMemoryUsage,
+    bool useValueArena)
     : _aggregateTypes(aggregateTypes),
       _aggregateRegisters(aggregateRegisters),
       _groupRegisters(std::move(groupRegisters)),
@@ -63,8 +162,14 @@ HashedCollectExecutorInfos::HashedCollectExecutorInfos(
       _inputVariables(std::move(inputVariables)),
       _expressionVariable(expressionVariable),
       _vpackOptions(opts),
-      _resourceMonitor(resourceMonitor) {
+      _resourceMonitor(resourceMonitor),
+      _parallelism(parallelism),
+      _tempStorage(tempStorage),
+      _spillOverThresholdNumRows(spillOverThresholdNumRows),
+      _spillOverThresholdMemoryUsage(spillOverThresholdMemoryUsage),
+      _useValueArena(useValueArena) {
   TRI_ASSERT(!_groupRegisters.empty());
+  TRI_ASSERT(_parallelism > 0);
 }
 
 std::vector<std::pair<RegisterId, RegisterId>> const&
@@ -123,6 +228,33 @@ HashedCollectExecutor::HashedCollectExecutor(Fetcher& fetcher, Infos& infos)
       _memoryUsageForInto(0) {
   _aggregatorFactories = createAggregatorFactories(_infos);
   _nextGroup.values.reserve(_infos.getGroupRegisters().size());
+
+  // the INTO register requires building the per-group arrays in input order,
+  // so we can only aggregate in parallel without it
+  if (_infos.getParallelism() > 1 &&
+      _infos.getCollectRegister().value() == RegisterId::maxRegisterId) {
+    _partitions.reserve(_infos.getParallelism());
+    for (size_t i = 0; i < _infos.getParallelism(); ++i) {
+      _partitions.emplace_back(
+          1024, AqlValueGroupHash(_infos.getGroupRegisters().size()),
+          AqlValueGroupEqual(_infos.getVPackOptions()));
+    }
+  }
+
+  if (_infos.useValueArena()) {
+    size_t const numArenas = std::max<size_t>(_partitions.size(), 1);
+    _valueArenas.reserve(numArenas);
+    for (size_t i = 0; i < numArenas; ++i) {
+      _valueArenas.emplace_back(
+          std::make_unique<AqlValueArena>(_infos.getResourceMonitor()));
+    }
+  }
+
+  // spilling is only supported for the non-parallel mode, and without INTO,
+  // because spilled rows only contain the group and aggregate values
+  _canSpill = !isParallel() && _infos.getTemporaryStorage() != nullptr &&
+              _infos.getTemporaryStorage()->canBeUsed() &&
+              _infos.getCollectRegister().value() == RegisterId::maxRegisterId;
 };
 
 HashedCollectExecutor::~HashedCollectExecutor() {
@@ -133,23 +265,46 @@ HashedCollectExecutor::~HashedCollectExecutor() {
 }
 
 void HashedCollectExecutor::destroyAllGroupsAqlValues() {
+  size_t memoryUsage = destroyGroupsAqlValues(_allGroups);
+  for (auto& partition : _partitions) {
+    memoryUsage += destroyGroupsAqlValues(partition);
+  }
+  memoryUsage += _memoryUsageForInto;
+
+  _infos.getResourceMonitor().decreaseMemoryUsage(memoryUsage);
+  _memoryUsageForInto = 0;
+
+  for (auto& arena : _valueArenas) {
+    arena->clear();
+  }
+}
+
+size_t HashedCollectExecutor::destroyGroupsAqlValues(GroupMapType& groups) {
   size_t memoryUsage = 0;
-  for (auto& it : _allGroups) {
+  for (auto& it : groups) {
     memoryUsage += memoryUsageForGroup(it.first, true);
     for (auto& it2 : it.first.values) {
       const_cast<AqlValue*>(&it2)->destroy();
     }
   }
-  memoryUsage += _memoryUsageForInto;
-
-  _infos.getResourceMonitor().decreaseMemoryUsage(memoryUsage);
-  _memoryUsageForInto = 0;
+  return memoryUsage;
 }
 
 void HashedCollectExecutor::consumeInputRow(InputAqlItemRow& input) {
   TRI_ASSERT(input.isInitialized());
 
-  decltype(_allGroups)::iterator currentGroupIt = findOrEmplaceGroup(input);
+  decltype(_allGroups)::iterator currentGroupIt;
+  if (_spillBackend != nullptr) {
+    // once we have started spilling, we only aggregate the groups that are
+    // already in memory. the rows of all other groups are spilled
+    currentGroupIt = findGroup(input);
+    if (currentGroupIt == _allGroups.end()) {
+      spillInputRow(input);
+      return;
+    }
+  } else {
+    currentGroupIt = findOrEmplaceGroup(input);
+  }
 
   if (!_infos.getAggregateTypes().empty()) {
     // reduce the aggregates
@@ -159,16 +314,31 @@ void HashedCollectExecutor::consumeInputRow(InputAqlItemRow& input) {
     TRI_ASSERT(aggregateValues != nullptr &&
                aggregateValues->size() ==
                    _infos.getAggregatedRegisters().size());
+    // the aggregators' memory only matters for deciding when to start
+    // spilling
+    bool const trackMemory = _canSpill && _spillBackend == nullptr;
     size_t j = 0;
     for (auto const& r : _infos.getAggregatedRegisters()) {
+      Aggregator& aggregator = (*aggregateValues)[j];
+      size_t const before = trackMemory ? aggregator.memoryUsage() : 0;
       if (r.second.value() == RegisterId::maxRegisterId) {
-        (*aggregateValues)[j].reduce(EmptyValue);
+        aggregator.reduce(EmptyValue);
       } else {
-        (*aggregateValues)[j].reduce(input.getValue(r.second));
+        aggregator.reduce(input.getValue(r.second));
+      }
+      if (trackMemory) {
+        // the memory usage may also shrink, e.g. if MIN replaces a long
+        // string with a shorter one
+        _memoryUsageForGroups += aggregator.memoryUsage();
+        _memoryUsageForGroups -= before;
       }
       ++j;
     }
   }
+
+  if (ADB_UNLIKELY(shouldStartSpilling())) {
+    startSpilling();
+  }
 }
 
 void HashedCollectExecutor::writeCurrentGroupToOutput(
@@ -181,9 +351,19 @@ void HashedCollectExecutor::writeCurrentGroupToOutput(
   size_t i = 0;
   for (auto& it : keys) {
     AqlValue& key = *const_cast<AqlValue*>(&it);
-    AqlValueGuard guard{key, true};
-    output.moveValueInto(_infos.getGroupRegisters()[i++].first,
-                         _lastInitializedInputRow, guard);
+    if (!_valueArenas.empty() && !key.requiresDestruction() &&
+        key.isPointer()) {
+      // the value may be stored in an arena, which is released before the
+      // output is consumed
+      AqlValue copy(AqlValueHintSliceCopy(key.slice()));
+      AqlValueGuard guard{copy, true};
+      output.moveValueInto(_infos.getGroupRegisters()[i++].first,
+                           _lastInitializedInputRow, guard);
+    } else {
+      AqlValueGuard guard{key, true};
+      output.moveValueInto(_infos.getGroupRegisters()[i++].first,
+                           _lastInitializedInputRow, guard);
+    }
     key.erase();  // to prevent double-freeing later
   }
 
@@ -220,26 +400,368 @@ void HashedCollectExecutor::writeCurrentGroupToOutput(
 auto HashedCollectExecutor::consumeInputRange(
     AqlItemBlockInputRange& inputRange) -> bool {
   TRI_ASSERT(!_isInitialized);
+  size_t const from = inputRange.getRowIndex();
   do {
     auto [state, input] = inputRange.nextDataRow();
     if (input) {
-      consumeInputRow(input);
+      if (!isParallel()) {
+        consumeInputRow(input);
+      }
       // We need to retain this
       _lastInitializedInputRow = std::move(input);
     }
     if (state == ExecutorState::DONE) {
+      if (isParallel()) {
+        bufferInputRows(inputRange, from);
+        aggregatePendingRows();
+        mergePartitions();
+      } else if (_spillBackend != nullptr) {
+        // the spilled partitions are aggregated after all groups in memory
+        // have been returned
+        _spillBackend->seal();
+      }
       // initialize group iterator for output
       _currentGroup = _allGroups.begin();
       return true;
     }
   } while (inputRange.hasDataRow());
 
+  if (isParallel()) {
+    bufferInputRows(inputRange, from);
+    if (_numPendingRows >= parallelBatchSize) {
+      aggregatePendingRows();
+    }
+  }
+
   TRI_ASSERT(inputRange.upstreamState() == ExecutorState::HASMORE);
   return false;
 }
 
+void HashedCollectExecutor::bufferInputRows(AqlItemBlockInputRange& inputRange,
+                                            size_t from) {
+  TRI_ASSERT(isParallel());
+  size_t const to = inputRange.getRowIndex();
+  TRI_ASSERT(from <= to);
+  if (from == to) {
+    return;
+  }
+  // the rows stay in their input block, which we keep alive until they are
+  // aggregated. all rows in the range are data rows.
+  _pendingRows.emplace_back(
+      PendingRows{inputRange.getBlock(), from, to, std::vector<size_t>{}});
+  _numPendingRows += to - from;
+}
+
+void HashedCollectExecutor::aggregatePendingRows() {
+  TRI_ASSERT(isParallel());
+  if (_pendingRows.empty()) {
+    return;
+  }
+
+  // Note that the tasks must neither modify the input blocks nor copy any
+  // SharedAqlItemBlockPtr, as the blocks' reference counts are not
+  // thread-safe.
+  runInParallel(_pendingRows.size(),
+                [this](size_t i) { hashPendingRows(_pendingRows[i]); });
+  runInParallel(_partitions.size(),
+                [this](size_t partition) { consumePendingRows(partition); });
+
+  _pendingRows.clear();
+  _numPendingRows = 0;
+}
+
+void HashedCollectExecutor::hashPendingRows(PendingRows& pending) const {
+  AqlItemBlock const& block = *pending.block;
+  AqlValueGroupHash hasher(_infos.getGroupRegisters().size());
+  AqlValueGroup values;
+  values.reserve(_infos.getGroupRegisters().size());
+
+  pending.hashes.resize(pending.to - pending.from);
+  for (size_t row = pending.from; row < pending.to; ++row) {
+    values.clear();
+    for (auto const& reg : _infos.getGroupRegisters()) {
+      values.emplace_back(block.getValueReference(row, reg.second));
+    }
+    pending.hashes[row - pending.from] = hasher(values);
+  }
+}
+
+void HashedCollectExecutor::consumePendingRows(size_t partition) {
+  TRI_ASSERT(partition < _partitions.size());
+  GroupMapType& groups = _partitions[partition];
+
+  GroupKeyType group;
+  group.values.reserve(_infos.getGroupRegisters().size());
+
+  for (auto const& pending : _pendingRows) {
+    AqlItemBlock const& block = *pending.block;
+    TRI_ASSERT(pending.hashes.size() == pending.to - pending.from);
+
+    for (size_t row = pending.from; row < pending.to; ++row) {
+      size_t const hash = pending.hashes[row - pending.from];
+      if (partitionForHash(hash, _partitions.size()) != partition) {
+        continue;
+      }
+
+      // for looking up the group simply re-use the values of the group
+      // registers, without cloning their contents
+      group.values.clear();
+      for (auto const& reg : _infos.getGroupRegisters()) {
+        group.values.emplace_back(block.getValueReference(row, reg.second));
+      }
+      group.hash = hash;
+
+      auto it = groups.find(group);
+      if (it == groups.end()) {
+        it = emplacePartitionGroup(groups, group, valueArena(partition));
+      }
+
+      if (!_infos.getAggregateTypes().empty()) {
+        // reduce the aggregates
+        ValueAggregators* aggregateValues = it->second.first.get();
+        TRI_ASSERT(aggregateValues != nullptr &&
+                   aggregateValues->size() ==
+                       _infos.getAggregatedRegisters().size());
+        size_t j = 0;
+        for (auto const& r : _infos.getAggregatedRegisters()) {
+          if (r.second.value() == RegisterId::maxRegisterId) {
+            (*aggregateValues)[j].reduce(EmptyValue);
+          } else {
+            (*aggregateValues)[j].reduce(
+                block.getValueReference(row, r.second));
+          }
+          ++j;
+        }
+      }
+    }
+  }
+}
+
+AqlValueArena* HashedCollectExecutor::valueArena(
+    size_t partition) const noexcept {
+  if (_valueArenas.empty()) {
+    return nullptr;
+  }
+  TRI_ASSERT(partition < _valueArenas.size());
+  return _valueArenas[partition].get();
+}
+
+AqlValue HashedCollectExecutor::cloneGroupValue(AqlValue const& value,
+                                                AqlValueArena* arena) {
+  // group values are often repeated, e.g. the same city name for many
+  // combinations of city and year. the arena stores them only once
+  if (arena != nullptr) {
+    return arena->intern(value);
+  }
+  return value.clone();
+}
+
+size_t HashedCollectExecutor::valueArenasMemoryUsage() const noexcept {
+  size_t memoryUsage = 0;
+  for (auto const& arena : _valueArenas) {
+    memoryUsage += arena->memoryUsage();
+  }
+  return memoryUsage;
+}
+
+HashedCollectExecutor::GroupMapType::iterator
+HashedCollectExecutor::emplacePartitionGroup(GroupMapType& groups,
+                                             GroupKeyType const& group,
+                                             AqlValueArena* arena) {
+  // the values are still owned by the input block, which may be shared with
+  // other partitions. so we always need to clone them here.
+  GroupKeyType key;
+  key.hash = group.hash;
+  key.values.reserve(group.values.size());
+  for (auto const& value : group.values) {
+    AqlValue a = cloneGroupValue(value, arena);
+    AqlValueGuard guard{a, true};
+    key.values.emplace_back(a);
+    guard.steal();
+  }
+  return emplaceGroup(groups, std::move(key));
+}
+
+HashedCollectExecutor::GroupMapType::iterator
+HashedCollectExecutor::emplaceGroup(GroupMapType& groups,
+                                    GroupKeyType&& group) {
+  // this builds a new group with aggregate functions being prepared.
+  auto aggregateValues = makeAggregateValues();
+
+  ResourceUsageScope guard(_infos.getResourceMonitor(),
+                           memoryUsageForGroup(group, true));
+
+  // note: aggregateValues may be a nullptr!
+  auto [result, emplaced] = groups.try_emplace(
+      std::move(group), std::make_pair(std::move(aggregateValues),
+                                       std::unique_ptr<velocypack::Builder>()));
+  // emplace must not fail
+  TRI_ASSERT(emplaced);
+
+  guard.steal();
+  return result;
+}
+
+bool HashedCollectExecutor::shouldStartSpilling() const noexcept {
+  return _canSpill && _spillBackend == nullptr &&
+         (_allGroups.size() > _infos.spillOverThresholdNumRows() ||
+          _memoryUsageForGroups + valueArenasMemoryUsage() >
+              _infos.spillOverThresholdMemoryUsage());
+}
+
+void HashedCollectExecutor::startSpilling() {
+  TRI_ASSERT(_canSpill);
+  TRI_ASSERT(_spillBackend == nullptr);
+  _spillBuilder = std::make_unique<velocypack::Builder>();
+  _spillBackend = _infos.getTemporaryStorage()->getHashedCollectSpillBackend();
+}
+
+void HashedCollectExecutor::spillInputRow(InputAqlItemRow const& input) {
+  TRI_ASSERT(_spillBackend != nullptr);
+  TRI_ASSERT(_nextGroup.values.size() == _infos.getGroupRegisters().size());
+
+  // a spilled row consists of the group values, followed by the input
+  // values of all aggregators
+  auto& builder = *_spillBuilder;
+  builder.clear();
+  builder.openArray();
+  for (auto const& value : _nextGroup.values) {
+    value.toVelocyPack(_infos.getVPackOptions(), builder,
+                       /*resolveExternals*/ false,
+                       /*allowUnindexed*/ false);
+  }
+  for (auto const& r : _infos.getAggregatedRegisters()) {
+    if (r.second.value() == RegisterId::maxRegisterId) {
+      builder.add(velocypack::Slice::nullSlice());
+    } else {
+      input.getValue(r.second).toVelocyPack(_infos.getVPackOptions(), builder,
+                                            /*resolveExternals*/ false,
+                                            /*allowUnindexed*/ false);
+    }
+  }
+  builder.close();
+
+  _spillBackend->storeRow(partitionForHash(_nextGroup.hash, numSpillPartitions),
+                          builder.slice());
+}
+
+bool HashedCollectExecutor::hasMoreGroups() {
+  if (_currentGroup != _allGroups.end()) {
+    return true;
+  }
+  if (_spillBackend == nullptr || !_spillBackend->hasMore()) {
+    return false;
+  }
+  loadNextSpilledPartition();
+  return _currentGroup != _allGroups.end();
+}
+
+void HashedCollectExecutor::loadNextSpilledPartition() {
+  TRI_ASSERT(_spillBackend != nullptr && _spillBackend->hasMore());
+  TRI_ASSERT(_currentGroup == _allGroups.end());
+
+  // all groups in memory have been returned already
+  clearGroups();
+
+  size_t const numGroupValues = _infos.getGroupRegisters().size();
+  AqlValueGroupHash hasher(numGroupValues);
+  GroupKeyType group;
+  group.values.reserve(numGroupValues);
+
+  size_t const partition = _spillBackend->currentPartition();
+  do {
+    velocypack::Slice row = _spillBackend->currentRow();
+    TRI_ASSERT(row.isArray());
+    TRI_ASSERT(row.length() ==
+               numGroupValues + _infos.getAggregatedRegisters().size());
+
+    velocypack::ArrayIterator it(row);
+    group.values.clear();
+    for (size_t i = 0; i < numGroupValues; ++i) {
+      group.values.emplace_back(AqlValueHintSliceNoCopy(it.value()));
+      it.next();
+    }
+    group.hash = hasher(group.values);
+
+    auto groupIt = _allGroups.find(group);
+    if (groupIt == _allGroups.end()) {
+      // the row's data is only valid until we move on to the next row, so
+      // the group values need to be copied
+      GroupKeyType key;
+      key.hash = group.hash;
+      key.values.reserve(numGroupValues);
+      for (auto const& value : group.values) {
+        AqlValue a(AqlValueHintSliceCopy(value.slice()));
+        AqlValueGuard guard{a, true};
+        key.values.emplace_back(a);
+        guard.steal();
+      }
+      groupIt = emplaceGroup(_allGroups, std::move(key));
+    }
+
+    if (!_infos.getAggregateTypes().empty()) {
+      ValueAggregators* aggregateValues = groupIt->second.first.get();
+      TRI_ASSERT(aggregateValues != nullptr &&
+                 aggregateValues->size() ==
+                     _infos.getAggregatedRegisters().size());
+      size_t j = 0;
+      for (auto const& r : _infos.getAggregatedRegisters()) {
+        if (r.second.value() == RegisterId::maxRegisterId) {
+          (*aggregateValues)[j].reduce(EmptyValue);
+        } else {
+          // aggregators may keep (shallow) copies of their input values,
+          // so the value must not point into the row's data
+          AqlValue value(AqlValueHintSliceCopy(it.value()));
+          AqlValueGuard guard{value, true};
+          (*aggregateValues)[j].reduce(value);
+        }
+        it.next();
+        ++j;
+      }
+    }
+
+    _spillBackend->next();
+  } while (_spillBackend->hasMore() &&
+           _spillBackend->currentPartition() == partition);
+
+  _currentGroup = _allGroups.begin();
+  _returnedGroups = 0;
+}
+
+void HashedCollectExecutor::clearGroups() {
+  _infos.getResourceMonitor().decreaseMemoryUsage(
+      destroyGroupsAqlValues(_allGroups));
+  _allGroups.clear();
+  _currentGroup = _allGroups.end();
+
+  // the interned group values were only referenced by the groups. this
+  // releases the memory of the groups in memory when we start processing
+  // the spilled partitions
+  for (auto& arena : _valueArenas) {
+    arena->clear();
+  }
+}
+
+void HashedCollectExecutor::mergePartitions() {
+  TRI_ASSERT(isParallel());
+  TRI_ASSERT(_allGroups.empty());
+  size_t numGroups = 0;
+  for (auto const& partition : _partitions) {
+    numGroups += partition.size();
+  }
+  _allGroups.reserve(numGroups);
+
+  // the groups of different partitions are disjoint, so this only moves the
+  // map entries
+  for (auto& partition : _partitions) {
+    _allGroups.merge(partition);
+    TRI_ASSERT(partition.empty());
+  }
+}
+
 auto HashedCollectExecutor::returnState() const -> ExecutorState {
-  if (!_isInitialized || _currentGroup != _allGroups.end()) {
+  if (!_isInitialized || _currentGroup != _allGroups.end() ||
+      (_spillBackend != nullptr && _spillBackend->hasMore())) {
     // We have either not started, or not produce all groups.
     return ExecutorState::HASMORE;
   }
@@ -272,7 +794,7 @@ auto HashedCollectExecutor::produceRows(AqlItemBlockInputRange& inputRange,
   }
 
   if (_isInitialized) {
-    while (_currentGroup != _allGroups.end() && !output.isFull()) {
+    while (!output.isFull() && hasMoreGroups()) {
       writeCurrentGroupToOutput(output);
       ++_currentGroup;
       ++_returnedGroups;
@@ -308,7 +830,7 @@ auto HashedCollectExecutor::skipRowsRange(AqlItemBlockInputRange& inputRange,
   }
 
   if (_isInitialized) {
-    while (_currentGroup != _allGroups.end() && call.needSkipMore()) {
+    while (call.needSkipMore() && hasMoreGroups()) {
       ++_currentGroup;
       call.didSkip(1);
     }
@@ -324,7 +846,7 @@ auto HashedCollectExecutor::skipRowsRange(AqlItemBlockInputRange& inputRange,
 // it returns an iterator to the group matching the current row in
 // _allGroups. additionally, .second is true iff a new group was emplaced.
 decltype(HashedCollectExecutor::_allGroups)::iterator
-HashedCollectExecutor::findOrEmplaceGroup(InputAqlItemRow& input) {
+HashedCollectExecutor::findGroup(InputAqlItemRow& input) {
   _nextGroup.values.clear();
   TRI_ASSERT(_nextGroup.values.capacity() == _infos.getGroupRegisters().size());
 
@@ -337,7 +859,12 @@ HashedCollectExecutor::findOrEmplaceGroup(InputAqlItemRow& input) {
   AqlValueGroupHash hasher(_nextGroup.values.size());
   _nextGroup.hash = hasher(_nextGroup.values);
 
-  auto it = _allGroups.find(_nextGroup);
+  return _allGroups.find(_nextGroup);
+}
+
+decltype(HashedCollectExecutor::_allGroups)::iterator
+HashedCollectExecutor::findOrEmplaceGroup(InputAqlItemRow& input) {
+  auto it = findGroup(input);
   if (it != _allGroups.end()) {
     // group already exists
     if (_infos.getCollectRegister().value() != RegisterId::maxRegisterId) {
@@ -371,19 +898,20 @@ HashedCollectExecutor::findOrEmplaceGroup(InputAqlItemRow& input) {
       // So this block is responsible for every grouped tuple, until it
       // is handed over to the output block. There is no overlapping
       // of responsibilities of tuples.
-      AqlValue a = input.getValue(reg.second).clone();
+      AqlValue a = cloneGroupValue(input.getValue(reg.second), valueArena(0));
       AqlValueGuard guard{a, true};
       _nextGroup.values.emplace_back(a);
       guard.steal();
     }
   }
-  TRI_ASSERT(_nextGroup.hash == hasher(_nextGroup.values));
+  TRI_ASSERT(_nextGroup.hash ==
+             AqlValueGroupHash(_nextGroup.values.size())(_nextGroup.values));
 
   // this builds a new group with aggregate functions being prepared.
   auto aggregateValues = makeAggregateValues();
 
-  ResourceUsageScope guard(_infos.getResourceMonitor(),
-                           memoryUsageForGroup(_nextGroup, true));
+  size_t const memoryUsage = memoryUsageForGroup(_nextGroup, true);
+  ResourceUsageScope guard(_infos.getResourceMonitor(), memoryUsage);
 
   std::unique_ptr<velocypack::Builder> builder;
 
@@ -402,6 +930,7 @@ HashedCollectExecutor::findOrEmplaceGroup(InputAqlItemRow& input) {
   TRI_ASSERT(emplaced);
 
   guard.steal();
+  _memoryUsageForGroups += memoryUsage + aggregateValuesSize();
 
   // Moving _nextGroup left us with an empty vector of minimum capacity.
   // So in order to have correct capacity reserve again.
@@ -428,6 +957,10 @@ HashedCollectExecutor::findOrEmplaceGroup(InputAqlItemRow& input) {
     // Otherwise we do not know.
     return call.getLimit();
   }
+  if (_spillBackend != nullptr && _spillBackend->hasMore()) {
+    // We do not know how many groups the spilled partitions contain
+    return call.getLimit();
+  }
   // We know how many groups we have left
   TRI_ASSERT(_returnedGroups <= _allGroups.size());
   return std::min<size_t>(call.getLimit(), _allGroups.size() - _returnedGroups);
@@ -496,14 +1029,21 @@ HashedCollectExecutor::makeAggregateValues() const {
   if (_aggregatorFactories.empty()) {
     return {};
   }
+  void* p = ::operator new(aggregateValuesSize());
+  new (p) ValueAggregators(_aggregatorFactories, _infos.getVPackOptions());
+  return std::unique_ptr<ValueAggregators>(static_cast<ValueAggregators*>(p));
+}
+
+std::size_t HashedCollectExecutor::aggregateValuesSize() const noexcept {
+  if (_aggregatorFactories.empty()) {
+    return 0;
+  }
   std::size_t size = sizeof(ValueAggregators) +
                      sizeof(Aggregator*) * _aggregatorFactories.size();
   for (auto factory : _aggregatorFactories) {
     size += factory->getAggregatorSize();
   }
-  void* p = ::operator new(size);
-  new (p) ValueAggregators(_aggregatorFactories, _infos.getVPackOptions());
-  return std::unique_ptr<ValueAggregators>(static_cast<ValueAggregators*>(p));
+  return size;
 }
 
 HashedCollectExecutor::ValueAggregators::ValueAggregators(
@@ -29,20 +29,25 @@
 #include "Aql/Aggregator.h"
 #include "Aql/AqlValueGroup.h"
 #include "Aql/ExecutionState.h"
+#include "Aql/HashedCollectSpillBackend.h"
 #include "Aql/InputAqlItemRow.h"
 #include "Aql/RegisterInfos.h"
+#include "Aql/SharedAqlItemBlockPtr.h"
 #include "Aql/Stats.h"
 #include "Aql/types.h"
 #include "Aql/AqlValueGroup.h"
 
 #include "Containers/FlatHashMap.h"
 
+#include <limits>
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 namespace arangodb {
 struct ResourceMonitor;
+class TemporaryStorageFeature;
 
 namespace velocypack {
 class Builder;
@@ -52,7 +57,9 @@ struct Options;
 namespace aql {
 
 struct AqlCall;
+class AqlItemBlock;
 class AqlItemBlockInputRange;
+class AqlValueArena;
 class OutputAqlItemRow;
 class RegisterInfos;
 template<BlockPassthrough>
@@ -73,6 +80,17 @@ class HashedCollectExecutorInfos {
    * @param aggregateTypes Aggregation methods used
    * @param aggregateRegisters Input and output Register for Aggregation
    * @param trxPtr The AQL transaction, as it might be needed for aggregates
+   * @param parallelism Number of partitions to aggregate in parallel.
+   *                    Only used if there is no INTO register.
+   * @param tempStorage Storage for spilling input rows to disk if there
+   *                    are too many groups. May be a nullptr.
+   * @param spillOverThresholdNumRows Number of groups after which input
+   *                                  rows of new groups are spilled.
+   * @param spillOverThresholdMemoryUsage Memory usage of the groups after
+   *                                      which input rows of new groups are
+   *                                      spilled.
+   * @param useValueArena Whether the executor stores copies of the group
+   *                      values in an arena of its own.
    */
   HashedCollectExecutorInfos(
       std::vector<std::pair<RegisterId, RegisterId>>&& groupRegisters,
@@ -82,7 +100,12 @@ class HashedCollectExecutorInfos {
       std::vector<std::pair<std::string, RegisterId>>&& inputVariables,
       std::vector<std::pair<RegisterId, RegisterId>>&& aggregateRegisters,
       velocypack::Options const* vpackOptions,
-      arangodb::ResourceMonitor& resourceMonitor);
+      arangodb::ResourceMonitor& resourceMonitor, size_t parallelism = 1,
+      TemporaryStorageFeature* tempStorage = nullptr,
+      size_t spillOverThresholdNumRows = std::numeric_limits<size_t>::max(),
+      size_t spillOverThresholdMemoryUsage =
+          std::numeric_limits<size_t>::max(),
+      bool useValueArena = false);
 
   HashedCollectExecutorInfos() = delete;
   HashedCollectExecutorInfos(HashedCollectExecutorInfos&&) = default;
@@ -106,6 +129,17 @@ class HashedCollectExecutorInfos {
     return _inputVariables;
   }
   arangodb::ResourceMonitor& getResourceMonitor() const;
+  size_t getParallelism() const noexcept { return _parallelism; }
+  TemporaryStorageFeature* getTemporaryStorage() const noexcept {
+    return _tempStorage;
+  }
+  size_t spillOverThresholdNumRows() const noexcept {
+    return _spillOverThresholdNumRows;
+  }
+  size_t spillOverThresholdMemoryUsage() const noexcept {
+    return _spillOverThresholdMemoryUsage;
+  }
+  bool useValueArena() const noexcept { return _useValueArena; }
 
  private:
   /// @brief aggregate types
@@ -137,6 +171,18 @@ class HashedCollectExecutorInfos {
 
   /// @brief resource manager
   arangodb::ResourceMonitor& _resourceMonitor;
+
+  /// @brief number of partitions to aggregate in parallel
+  size_t _parallelism;
+
+  /// @brief storage for spilled input rows, may be a nullptr
+  TemporaryStorageFeature* _tempStorage;
+
+  size_t _spillOverThresholdNumRows;
+  size_t _spillOverThresholdMemoryUsage;
+
+  /// @brief whether copies of the group values are stored in arenas
+  bool _useValueArena;
 };
 
 /**
@@ -210,8 +256,29 @@ class HashedCollectExecutor {
       containers::FlatHashMap<GroupKeyType, GroupValueType, AqlValueGroupHash,
                               AqlValueGroupEqual>;
 
+  /// @brief consecutive data rows of an input block that are buffered for
+  /// the parallel aggregation, together with the hashes of their groups
+  struct PendingRows {
+    SharedAqlItemBlockPtr block;
+    size_t from;
+    size_t to;
+    std::vector<size_t> hashes;
+  };
+
+  /// @brief minimum number of buffered input rows before they are aggregated
+  /// in parallel
+  static constexpr size_t parallelBatchSize = 16 * 1024;
+
+  /// @brief number of partitions spilled input rows are distributed to. the
+  /// partitions are aggregated one after the other
+  static constexpr size_t numSpillPartitions = 64;
+
   Infos const& infos() const noexcept;
 
+  /// @brief whether the groups are aggregated in multiple partitions in
+  /// parallel
+  bool isParallel() const noexcept { return !_partitions.empty(); }
+
   /**
    * @brief Consumes all rows from upstream
    *        Every row is collected into one of the groups.
@@ -231,9 +298,76 @@ class HashedCollectExecutor {
 
   void destroyAllGroupsAqlValues();
 
+  size_t destroyGroupsAqlValues(GroupMapType& groups);
+
+  /// @brief buffer the data rows [from, current row) of the input range for
+  /// the parallel aggregation
+  void bufferInputRows(AqlItemBlockInputRange& inputRange, size_t from);
+
+  /// @brief aggregate all buffered input rows into the partitions, using
+  /// one task per partition
+  void aggregatePendingRows();
+
+  /// @brief compute the group hashes of the buffered rows
+  void hashPendingRows(PendingRows& pending) const;
+
+  /// @brief aggregate all buffered input rows that belong to the partition.
+  /// may be called concurrently for different partitions
+  void consumePendingRows(size_t partition);
+
+  /// @brief move the groups of all partitions into _allGroups
+  void mergePartitions();
+
+  /// @brief the arena for the groups of a partition, or for all groups in
+  /// non-parallel mode. returns a nullptr if no arenas are used
+  AqlValueArena* valueArena(size_t partition) const noexcept;
+
+  /// @brief copies a group value, using the arena if available
+  static AqlValue cloneGroupValue(AqlValue const& value, AqlValueArena* arena);
+
+  /// @brief memory used by all arenas
+  size_t valueArenasMemoryUsage() const noexcept;
+
+  /// @brief clones the group values of a row and emplaces the group into
+  /// the partition. the row itself is not modified
+  GroupMapType::iterator emplacePartitionGroup(GroupMapType& groups,
+                                               GroupKeyType const& group,
+                                               AqlValueArena* arena);
+
+  /// @brief emplaces a new group with fresh aggregators. takes over the
+  /// ownership of the group values
+  GroupMapType::iterator emplaceGroup(GroupMapType& groups,
+                                      GroupKeyType&& group);
+
+  /// @brief whether the in-memory groups have reached the spill-over
+  /// thresholds, and no new groups should be created in memory
+  bool shouldStartSpilling() const noexcept;
+
+  void startSpilling();
+
+  /// @brief write the row to the spill storage. requires findGroup() to
+  /// have been called for the row
+  void spillInputRow(InputAqlItemRow const& input);
+
+  /// @brief whether there are more groups to return. if all groups in
+  /// memory have been returned, this loads the next spilled partition
+  bool hasMoreGroups();
+
+  /// @brief replace the groups in memory with the groups of the next
+  /// spilled partition
+  void loadNextSpilledPartition();
+
+  /// @brief destroy all groups in memory, and release the memory of the
+  /// arenas
+  void clearGroups();
+
   static std::vector<Aggregator::Factory const*> createAggregatorFactories(
       HashedCollectExecutor::Infos const& infos);
 
+  /// @brief looks up the group of the row. leaves the (not cloned) group
+  /// values and their hash in _nextGroup
+  GroupMapType::iterator findGroup(InputAqlItemRow& input);
+
   GroupMapType::iterator findOrEmplaceGroup(InputAqlItemRow& input);
 
   void consumeInputRow(InputAqlItemRow& input);
@@ -245,6 +379,9 @@ class HashedCollectExecutor {
 
   std::unique_ptr<ValueAggregators> makeAggregateValues() const;
 
+  /// @brief size of the allocation for the aggregators of a group
+  std::size_t aggregateValuesSize() const noexcept;
+
   size_t memoryUsageForGroup(GroupKeyType const& group, bool withBase) const;
 
   Infos const& _infos;
@@ -268,6 +405,38 @@ class HashedCollectExecutor {
   size_t _returnedGroups = 0;
 
   size_t _memoryUsageForInto;
+
+  /// @brief groups per partition, only used in parallel mode. a group is
+  /// assigned to a partition based on its hash, so every group is contained
+  /// in exactly one partition and no aggregator states need to be merged
+  std::vector<GroupMapType> _partitions;
+
+  /// @brief storage for the group values. one arena per partition in
+  /// parallel mode, so that the partitions do not need to synchronize, and
+  /// a single arena otherwise. interned group values are copied when they
+  /// are written to the output, so the arenas can be released as soon as
+  /// the groups in memory are destroyed
+  std::vector<std::unique_ptr<AqlValueArena>> _valueArenas;
+
+  /// @brief input rows that are not yet aggregated, only used in parallel
+  /// mode
+  std::vector<PendingRows> _pendingRows;
+  size_t _numPendingRows = 0;
+
+  /// @brief whether input rows can be spilled to disk
+  bool _canSpill = false;
+
+  /// @brief approximate memory usage of the groups in memory, including
+  /// their aggregators, used to decide when to start spilling. the memory
+  /// of the aggregators is only tracked until spilling has started
+  size_t _memoryUsageForGroups = 0;
+
+  /// @brief storage for the spilled input rows. only set once we have
+  /// started spilling
+  std::unique_ptr<HashedCollectSpillBackend> _spillBackend;
+
+  /// @brief builder for the values of spilled rows, recycled for all rows
+  std::unique_ptr<velocypack::Builder> _spillBuilder;
 };
 
 }  // namespace aql
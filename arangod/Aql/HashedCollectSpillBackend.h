@@ -0,0 +1,63 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+
+namespace arangodb {
+namespace velocypack {
+class Slice;
+}
+
+namespace aql {
+
+// storage for input rows of a hashed COLLECT that did not fit into memory.
+// the rows are stored per partition, and can be read back partition by
+// partition after seal() was called. rows of the same partition are
+// returned in insertion order.
+class HashedCollectSpillBackend {
+ public:
+  virtual ~HashedCollectSpillBackend() = default;
+
+  // store the values of an input row for the partition
+  virtual void storeRow(size_t partition, velocypack::Slice values) = 0;
+
+  // seal the storage backend. after that, no more rows must be stored
+  virtual void seal() = 0;
+
+  // whether or not there are more rows to read. requires seal() to have
+  // been called!
+  virtual bool hasMore() const = 0;
+
+  // partition of the current row. requires hasMore()
+  virtual size_t currentPartition() const = 0;
+
+  // values of the current row. requires hasMore(). the slice is only valid
+  // until the next call to next()
+  virtual velocypack::Slice currentRow() const = 0;
+
+  // move to the next row. requires hasMore()
+  virtual void next() = 0;
+};
+
+}  // namespace aql
+}  // namespace arangodb
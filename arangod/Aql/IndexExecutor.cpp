@@ -103,10 +103,9 @@ void resolveFCallConstAttributes(Ast* ast, AstNode* fcall) {
 template<bool checkUniqueness>
 IndexIterator::CoveringCallback getCallback(
     DocumentProducingFunctionContext& context,
-    transaction::Methods::IndexHandle const& index,
     IndexNode::IndexValuesVars const& outNonMaterializedIndVars,
     IndexNode::IndexValuesRegisters const& outNonMaterializedIndRegs) {
-  auto impl = [&context, &index, &outNonMaterializedIndVars,
+  auto impl = [&context, &outNonMaterializedIndVars,
                &outNonMaterializedIndRegs]<typename TokenType>(
                   TokenType&& token, IndexIteratorCoveringData& covering) {
     constexpr bool isLocalDocumentId =
@@ -129,11 +128,13 @@ IndexIterator::CoveringCallback getCallback(
 
     context.incrScanned();
 
-    auto indexId = index->id();
-    TRI_ASSERT(indexId == outNonMaterializedIndRegs.first &&
-               indexId == outNonMaterializedIndVars.first);
-    if (ADB_UNLIKELY(indexId != outNonMaterializedIndRegs.first ||
-                     indexId != outNonMaterializedIndVars.first)) {
+    // note: if the node uses multiple indexes, the index values are at the
+    // same positions for all of them, and the registers are described by
+    // the first index
+    TRI_ASSERT(outNonMaterializedIndRegs.first ==
+               outNonMaterializedIndVars.first);
+    if (ADB_UNLIKELY(outNonMaterializedIndRegs.first !=
+                     outNonMaterializedIndVars.first)) {
       return false;
     }
 
@@ -435,10 +436,10 @@ IndexExecutor::CursorReader::CursorReader(
     case Type::LateMaterialized:
       _coveringProducer =
           checkUniqueness
-              ? ::getCallback<true>(context, _index,
+              ? ::getCallback<true>(context,
                                     _infos.getOutNonMaterializedIndVars(),
                                     _infos.getOutNonMaterializedIndRegs())
-              : ::getCallback<false>(context, _index,
+              : ::getCallback<false>(context,
                                      _infos.getOutNonMaterializedIndVars(),
                                      _infos.getOutNonMaterializedIndRegs());
       break;
@@ -132,6 +132,17 @@ class IndexExecutorInfos {
 
   bool isOneIndexCondition() const noexcept { return _oneIndexCondition; }
 
+  /// @brief discard documents that cannot make it into the heap of a
+  /// downstream SORT with a limit
+  void setSortLimitThresholdFilter(SortLimitThresholdFilter filter) {
+    _sortLimitThresholdFilter = std::move(filter);
+  }
+
+  SortLimitThresholdFilter const& getSortLimitThresholdFilter()
+      const noexcept {
+    return _sortLimitThresholdFilter;
+  }
+
  private:
   /// @brief _indexes holds all Indexes used in this block
   std::vector<transaction::Methods::IndexHandle> _indexes;
@@ -183,6 +194,8 @@ class IndexExecutorInfos {
   bool const _oneIndexCondition;
 
   ReadOwnWrites const _readOwnWrites;
+
+  SortLimitThresholdFilter _sortLimitThresholdFilter;
 };
 
 /**
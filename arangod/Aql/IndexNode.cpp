@@ -34,6 +34,7 @@
 #include "Aql/ExecutionPlan.h"
 #include "Aql/Expression.h"
 #include "Aql/IndexExecutor.h"
+#include "Aql/MergeJoinExecutor.h"
 #include "Aql/NonConstExpressionContainer.h"
 #include "Aql/OptimizerUtils.h"
 #include "Aql/Projections.h"
@@ -70,7 +71,8 @@ IndexNode::IndexNode(
       _needsGatherNodeSort(false),
       _allCoveredByOneIndex(allCoveredByOneIndex),
       _options(opts),
-      _outNonMaterializedDocId(nullptr) {
+      _outNonMaterializedDocId(nullptr),
+      _mergeJoinAscending(true) {
   TRI_ASSERT(_condition != nullptr);
 
   prepareProjections();
@@ -87,7 +89,9 @@ IndexNode::IndexNode(ExecutionPlan* plan,
           base, "needsGatherNodeSort", false)),
       _options(),
       _outNonMaterializedDocId(aql::Variable::varFromVPack(
-          plan->getAst(), base, "outNmDocId", true)) {
+          plan->getAst(), base, "outNmDocId", true)),
+      _mergeJoinAscending(basics::VelocyPackHelper::getBooleanValue(
+          base, "mergeJoinAscending", true)) {
   _options.sorted =
       basics::VelocyPackHelper::getBooleanValue(base, "sorted", true);
   _options.ascending =
@@ -193,6 +197,19 @@ IndexNode::IndexNode(ExecutionPlan* plan,
     }
   }
   _options.forLateMaterialization = isLateMaterialized();
+
+  VPackSlice mergeJoin = base.get("mergeJoin");
+  if (mergeJoin.isArray()) {
+    for (auto it : VPackArrayIterator(mergeJoin)) {
+      MergeJoinKey key;
+      key.variable = Variable::varFromVPack(plan->getAst(), it, "variable");
+      for (auto name : VPackArrayIterator(it.get("attribute"))) {
+        key.attribute.emplace_back(name.copyString());
+      }
+      _mergeJoinKeys.emplace_back(std::move(key));
+    }
+  }
+
   prepareProjections();
 }
 
@@ -242,6 +259,25 @@ void IndexNode::doToVelocyPack(VPackBuilder& builder, unsigned flags) const {
   builder.add("limit", VPackValue(_options.limit));
   builder.add(StaticStrings::IndexLookahead, VPackValue(_options.lookahead));
 
+  if (isMergeJoin()) {
+    builder.add(VPackValue("mergeJoin"));
+    builder.openArray();
+    for (auto const& key : _mergeJoinKeys) {
+      builder.openObject();
+      builder.add(VPackValue("variable"));
+      key.variable->toVelocyPack(builder);
+      builder.add(VPackValue("attribute"));
+      builder.openArray();
+      for (auto const& it : key.attribute) {
+        builder.add(VPackValue(it));
+      }
+      builder.close();
+      builder.close();
+    }
+    builder.close();
+    builder.add("mergeJoinAscending", VPackValue(_mergeJoinAscending));
+  }
+
   if (isLateMaterialized()) {
     builder.add(VPackValue("outNmDocId"));
     _outNonMaterializedDocId->toVelocyPack(builder);
@@ -396,6 +432,22 @@ std::unique_ptr<ExecutionBlock> IndexNode::createBlock(
       _plan->getAst(), this->options(), _outNonMaterializedIndVars,
       std::move(outNonMaterializedIndRegs));
 
+  if (isMergeJoin() && isProduceResult() && !isLateMaterialized()) {
+    TRI_ASSERT(_indexes.size() == 1);
+    std::vector<MergeJoinExecutorInfos::ProbeKey> probeKeys;
+    probeKeys.reserve(_mergeJoinKeys.size());
+    for (auto const& key : _mergeJoinKeys) {
+      probeKeys.emplace_back(variableToRegisterId(key.variable),
+                             key.attribute);
+    }
+    auto mergeJoinInfos =
+        MergeJoinExecutorInfos(std::move(executorInfos), std::move(probeKeys),
+                               _mergeJoinAscending);
+    return std::make_unique<ExecutionBlockImpl<MergeJoinExecutor>>(
+        &engine, this, std::move(registerInfos), std::move(mergeJoinInfos));
+  }
+
+  executorInfos.setSortLimitThresholdFilter(sortLimitThresholdFilter(engine));
   return std::make_unique<ExecutionBlockImpl<IndexExecutor>>(
       &engine, this, std::move(registerInfos), std::move(executorInfos));
 }
@@ -433,6 +485,8 @@ ExecutionNode* IndexNode::clone(ExecutionPlan* plan, bool withDependencies,
   c->needsGatherNodeSort(_needsGatherNodeSort);
   c->_outNonMaterializedDocId = outNonMaterializedDocId;
   c->_outNonMaterializedIndVars = std::move(outNonMaterializedIndVars);
+  c->_mergeJoinKeys = _mergeJoinKeys;
+  c->_mergeJoinAscending = _mergeJoinAscending;
   CollectionAccessingNode::cloneInto(*c);
   DocumentProducingNode::cloneInto(plan, *c);
   return cloneHelper(std::move(c), withDependencies, withProperties);
@@ -443,6 +497,9 @@ ExecutionNode* IndexNode::clone(ExecutionPlan* plan, bool withDependencies,
 void IndexNode::replaceVariables(
     std::unordered_map<VariableId, Variable const*> const& replacements) {
   DocumentProducingNode::replaceVariables(replacements);
+  for (auto& key : _mergeJoinKeys) {
+    key.variable = Variable::replace(key.variable, replacements);
+  }
 }
 
 /// @brief destroy the IndexNode
@@ -484,7 +541,13 @@ CostEstimate IndexNode::estimateCost() const {
   }
 
   estimate.estimatedNrItems *= totalItems;
-  estimate.estimatedCost += incoming * totalCost;
+  if (isMergeJoin() && !doCount() && !isLateMaterialized()) {
+    // we read the whole index only once, and compare each incoming item
+    // with the current index position
+    estimate.estimatedCost += itemsInCollection + incoming * (1.0 + totalItems);
+  } else {
+    estimate.estimatedCost += incoming * totalCost;
+  }
   return estimate;
 }
 
@@ -537,6 +600,12 @@ std::vector<transaction::Methods::IndexHandle> const& IndexNode::getIndexes()
   return _indexes;
 }
 
+void IndexNode::setMergeJoin(std::vector<MergeJoinKey> keys, bool ascending) {
+  TRI_ASSERT(_indexes.size() == 1);
+  _mergeJoinKeys = std::move(keys);
+  _mergeJoinAscending = ascending;
+}
+
 void IndexNode::setLateMaterialized(aql::Variable const* docIdVariable,
                                     IndexId commonIndexId,
                                     IndexVarsInfo const& indexVariables) {
@@ -24,6 +24,7 @@
 #pragma once
 
 #include <memory>
+#include <string>
 #include <vector>
 
 #include "Aql/CollectionAccessingNode.h"
@@ -154,6 +155,21 @@ class IndexNode : public ExecutionNode,
                            IndexId commonIndexId,
                            IndexVarsInfo const& indexVariables);
 
+  /// @brief lookup value for the i-th field of the index in merge join mode
+  struct MergeJoinKey {
+    Variable const* variable = nullptr;
+    std::vector<std::string> attribute;
+  };
+
+  /// @brief execute the node as a merge join. the node must use a single
+  /// sorted index, and the lookup values must be the attributes of a
+  /// variable that is produced in index order, ascending or descending. an
+  /// empty list of keys turns the merge join off again
+  void setMergeJoin(std::vector<MergeJoinKey> keys, bool ascending);
+
+  /// @brief whether or not the node is executed as a merge join
+  bool isMergeJoin() const noexcept { return !_mergeJoinKeys.empty(); }
+
   void setProjections(Projections projections) override;
 
   /// @brief remember the condition to execute for early filtering
@@ -205,6 +221,14 @@ class IndexNode : public ExecutionNode,
 
   /// @brief output variables to non-materialized document index references
   IndexValuesVars _outNonMaterializedIndVars;
+
+  /// @brief lookup values for the index fields in merge join mode, empty
+  /// otherwise
+  std::vector<MergeJoinKey> _mergeJoinKeys;
+
+  /// @brief whether the lookup values of the merge join arrive in ascending
+  /// or in descending order
+  bool _mergeJoinAscending;
 };
 
 }  // namespace aql
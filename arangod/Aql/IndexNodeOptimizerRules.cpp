@@ -37,12 +37,18 @@
 #include "Cluster/ServerState.h"
 #include "Indexes/Index.h"
 
+#include <algorithm>
+
 using namespace arangodb::aql;
 
 namespace {
 
-bool attributesMatch(arangodb::transaction::Methods::IndexHandle const& index,
+using IndexHandles = std::vector<arangodb::transaction::Methods::IndexHandle>;
+
+bool attributesMatch(IndexHandles const& indexes,
                      latematerialized::NodeExpressionWithAttrs& node) {
+  TRI_ASSERT(!indexes.empty());
+  auto const& index = indexes.front();
   // check all node attributes to be in index
   for (auto& nodeAttr : node.attrs) {
     nodeAttr.afData.field = nullptr;
@@ -61,13 +67,45 @@ bool attributesMatch(arangodb::transaction::Methods::IndexHandle const& index,
     if (nodeAttr.afData.field == nullptr) {
       return false;
     }
+    // all other indexes must cover the attribute at the same position, as
+    // the index values are looked up by position for all of them
+    for (size_t i = 1; i < indexes.size(); ++i) {
+      auto const& coveredFields = indexes[i]->coveredFields();
+      std::vector<std::string> postfix;
+      if (nodeAttr.afData.fieldNumber >= coveredFields.size() ||
+          !latematerialized::isPrefix<false>(
+              coveredFields[nodeAttr.afData.fieldNumber], nodeAttr.attr, false,
+              postfix) ||
+          postfix != nodeAttr.afData.postfix) {
+        return false;
+      }
+    }
   }
   return true;
 }
 
+/// @brief whether the indexes of an index node can be used together for
+/// late materialization
+bool canLateMaterialize(IndexHandles const& indexes) {
+  TRI_ASSERT(!indexes.empty());
+  if (indexes.size() == 1) {
+    return true;
+  }
+  // When enabling this for other index types please consider how inverted
+  // index would operate together with persistent as first produces
+  // SearchDocs but latter LocalDocumentIds. Usage of two separate variables
+  // might be the simplest solution. Primary and edge indexes produce a
+  // single value instead of an array of index values.
+  return std::all_of(indexes.begin(), indexes.end(), [](auto const& index) {
+    auto const type = index->type();
+    return type == arangodb::Index::TRI_IDX_TYPE_PERSISTENT_INDEX ||
+           type == arangodb::Index::TRI_IDX_TYPE_HASH_INDEX ||
+           type == arangodb::Index::TRI_IDX_TYPE_SKIPLIST_INDEX;
+  });
+}
+
 bool processCalculationNode(
-    Variable const* var,
-    arangodb::transaction::Methods::IndexHandle const& index,
+    Variable const* var, IndexHandles const& indexes,
     CalculationNode* calculationNode, Expression* expression,
     std::vector<latematerialized::NodeExpressionWithAttrs>& nodesToChange) {
   latematerialized::NodeExpressionWithAttrs node;
@@ -79,7 +117,7 @@ bool processCalculationNode(
     // is not safe for optimization
     return false;
   } else if (!node.attrs.empty()) {
-    if (!attributesMatch(index, node)) {
+    if (!attributesMatch(indexes, node)) {
       return false;
     } else {
       nodesToChange.emplace_back(std::move(node));
@@ -122,15 +160,13 @@ void arangodb::aql::lateDocumentMaterializationRule(
       }
       auto& indexes = indexNode->getIndexes();
       TRI_ASSERT(!indexes.empty());
-      if (indexes.size() != 1) {
-        // When enabling this please consider how inverted index would
-        // operate together with persistent as first produces
-        // SearchDocs but latter LocalDocumentIds. Usage of
-        // two separate variables might be the simplest solution
-        continue;  // several indexes are not supported
+      if (!canLateMaterialize(indexes)) {
+        continue;  // this combination of indexes is not supported
       }
       auto& index = indexes.front();
-      if (index->coveredFields().empty()) {
+      if (std::any_of(indexes.begin(), indexes.end(), [](auto const& index) {
+            return index->coveredFields().empty();
+          })) {
         // index does not cover any fields
         continue;
       }
@@ -142,7 +178,7 @@ void arangodb::aql::lateDocumentMaterializationRule(
         VarSet currentUsedVars;
         Ast::getReferencedVariables(filter->node(), currentUsedVars);
         if (currentUsedVars.find(var) != currentUsedVars.end() &&
-            !processCalculationNode(var, index, nullptr, filter,
+            !processCalculationNode(var, indexes, nullptr, filter,
                                     nodesToChange)) {
           // IndexNode has an early pruning filter which references variables
           // not stored in index. In this case we cannot perform the
@@ -172,7 +208,7 @@ void arangodb::aql::lateDocumentMaterializationRule(
             auto* calculationNode =
                 ExecutionNode::castTo<CalculationNode*>(current);
             TRI_ASSERT(calculationNode);
-            valid = processCalculationNode(var, index, calculationNode,
+            valid = processCalculationNode(var, indexes, calculationNode,
                                            calculationNode->expression(),
                                            nodesToChange);
             break;
@@ -227,7 +263,7 @@ void arangodb::aql::lateDocumentMaterializationRule(
                         ExecutionNode::castTo<CalculationNode*>(scn);
                     TRI_ASSERT(calculationNode);
                     valid = processCalculationNode(
-                        var, index, calculationNode,
+                        var, indexes, calculationNode,
                         calculationNode->expression(), nodesToChange);
                     if (!valid) {
                       break;
@@ -332,7 +368,9 @@ void arangodb::aql::lateDocumentMaterializationRule(
         // we could apply late materialization
         // 1. We need to notify index node - it should not materialize
         // documents, but produce only localDocIds or SearchDocs
-        // in case of inverted index
+        // in case of inverted index. with multiple indexes, the index values
+        // are at the same positions for all of them, so the first index
+        // describes the values
         indexNode->setLateMaterialized(localDocIdTmp, index->id(),
                                        uniqueVariables);
         // 2. We need to add materializer after limit node to do materialization
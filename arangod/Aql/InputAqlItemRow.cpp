@@ -176,6 +176,22 @@ RegisterCount InputAqlItemRow::getNumRegisters() const noexcept {
   return block().numRegisters();
 }
 
+bool InputAqlItemRow::hasContiguousColumns() const noexcept {
+  TRI_ASSERT(isInitialized());
+  return block().hasContiguousColumns();
+}
+
+std::span<AqlValue const> InputAqlItemRow::getColumnSpan(
+    RegisterId registerId, size_t end) const noexcept {
+  TRI_ASSERT(isInitialized());
+  TRI_ASSERT(registerId.isRegularRegister());
+  TRI_ASSERT(registerId < getNumRegisters());
+  TRI_ASSERT(_baseIndex < end);
+  return block().getColumn(registerId.value(), _baseIndex, end);
+}
+
+size_t InputAqlItemRow::getBaseIndex() const noexcept { return _baseIndex; }
+
 bool InputAqlItemRow::isSameBlockAndIndex(
     InputAqlItemRow const& other) const noexcept {
   return this->_block == other._block && this->_baseIndex == other._baseIndex;
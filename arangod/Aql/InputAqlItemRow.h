@@ -30,6 +30,7 @@
 #include "Aql/types.h"
 
 #include <cstddef>
+#include <span>
 #include <unordered_set>
 
 namespace arangodb {
@@ -89,6 +90,27 @@ class InputAqlItemRow {
 
   RegisterCount getNumRegisters() const noexcept;
 
+  /**
+   * @brief Whether the values of each register are stored contiguously in
+   *        the underlying block, so that getColumnSpan() can be used.
+   */
+  bool hasContiguousColumns() const noexcept;
+
+  /**
+   * @brief Get the values of the given register for this row and the
+   *        following rows of the underlying block, up to (excluding) row
+   *        number `end` of the block. Requires hasContiguousColumns().
+   *        Note that the span may include shadow rows, if the block
+   *        contains any in the requested range.
+   */
+  std::span<AqlValue const> getColumnSpan(RegisterId registerId,
+                                          size_t end) const noexcept;
+
+  /**
+   * @brief The row's index in the underlying block.
+   */
+  size_t getBaseIndex() const noexcept;
+
   // This the old operator==. It tests if both rows refer to the _same_ block
   // and the _same_ index.
   [[nodiscard]] bool isSameBlockAndIndex(
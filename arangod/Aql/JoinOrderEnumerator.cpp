@@ -0,0 +1,163 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "JoinOrderEnumerator.h"
+
+#include "Basics/debugging.h"
+
+#include <algorithm>
+#include <limits>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+size_t JoinOrderEnumerator::addRelation(double rows, double scanCost) {
+  TRI_ASSERT(_relations.size() < maxRelations);
+  _relations.emplace_back(Relation{std::max(rows, 0.0), scanCost});
+  return _relations.size() - 1;
+}
+
+void JoinOrderEnumerator::addJoin(size_t outer, size_t inner, double matches,
+                                  double lookupCost) {
+  TRI_ASSERT(outer < _relations.size());
+  TRI_ASSERT(inner < _relations.size());
+  TRI_ASSERT(outer != inner);
+  _joins.emplace_back(Join{outer, inner, std::max(matches, 0.0), lookupCost});
+}
+
+bool JoinOrderEnumerator::isConnected(size_t set,
+                                      size_t relation) const noexcept {
+  return std::any_of(_joins.begin(), _joins.end(), [&](Join const& join) {
+    return join.inner == relation && (set & (size_t(1) << join.outer)) != 0;
+  });
+}
+
+std::pair<double, double> JoinOrderEnumerator::extend(size_t outerSet,
+                                                      double outerRows,
+                                                      size_t relation) const {
+  // use the cheapest join condition to get from the outer loops to the loop.
+  // without a join condition, the loop is a cross product
+  double matches = _relations[relation].rows;
+  double lookupCost = _relations[relation].scanCost;
+  for (auto const& join : _joins) {
+    if (join.inner != relation ||
+        (outerSet & (size_t(1) << join.outer)) == 0) {
+      continue;
+    }
+    if (join.lookupCost < lookupCost ||
+        (join.lookupCost == lookupCost && join.matches < matches)) {
+      matches = join.matches;
+      lookupCost = join.lookupCost;
+    }
+  }
+
+  double rows = outerRows * matches;
+  return {rows, outerRows * lookupCost + rows};
+}
+
+double JoinOrderEnumerator::cost(std::vector<size_t> const& order) const {
+  TRI_ASSERT(order.size() == _relations.size());
+  size_t set = 0;
+  double rows = 1.0;
+  double total = 0.0;
+  for (auto relation : order) {
+    TRI_ASSERT(relation < _relations.size());
+    auto [newRows, cost] = extend(set, rows, relation);
+    set |= size_t(1) << relation;
+    rows = newRows;
+    total += cost;
+  }
+  return total;
+}
+
+std::vector<size_t> JoinOrderEnumerator::findOrder() const {
+  size_t const n = _relations.size();
+  TRI_ASSERT(n <= maxRelations);
+
+  std::vector<size_t> original;
+  original.reserve(n);
+  for (size_t i = 0; i < n; ++i) {
+    original.emplace_back(i);
+  }
+  if (n <= 1) {
+    return original;
+  }
+
+  struct Entry {
+    double cost = std::numeric_limits<double>::infinity();
+    double rows = 0.0;
+    // the innermost loop of the set, and the set without it
+    size_t last = 0;
+    size_t previous = 0;
+  };
+
+  // cheapest order for each subset of the loops. a subset only depends on
+  // smaller subsets, so iterating over them in ascending order is enough
+  size_t const all = (size_t(1) << n) - 1;
+  std::vector<Entry> best(all + 1);
+  best[0].cost = 0.0;
+  best[0].rows = 1.0;
+
+  for (size_t set = 0; set < all; ++set) {
+    Entry const current = best[set];
+    if (current.cost == std::numeric_limits<double>::infinity()) {
+      continue;
+    }
+
+    bool hasConnected = false;
+    for (size_t relation = 0; relation < n && !hasConnected; ++relation) {
+      hasConnected = (set & (size_t(1) << relation)) == 0 &&
+                     isConnected(set, relation);
+    }
+
+    for (size_t relation = 0; relation < n; ++relation) {
+      size_t const bit = size_t(1) << relation;
+      if ((set & bit) != 0 || (hasConnected && !isConnected(set, relation))) {
+        // already contained, or a cross product although there is a join
+        // condition to continue with
+        continue;
+      }
+      auto [rows, cost] = extend(set, current.rows, relation);
+      Entry& next = best[set | bit];
+      if (current.cost + cost < next.cost) {
+        next.cost = current.cost + cost;
+        next.rows = rows;
+        next.last = relation;
+        next.previous = set;
+      }
+    }
+  }
+
+  // only deviate from the original order if it is really better
+  if (best[all].cost >= cost(original)) {
+    return original;
+  }
+
+  std::vector<size_t> order(n);
+  size_t set = all;
+  for (size_t i = n; i-- > 0;) {
+    TRI_ASSERT(set != 0);
+    order[i] = best[set].last;
+    set = best[set].previous;
+  }
+  TRI_ASSERT(set == 0);
+  return order;
+}
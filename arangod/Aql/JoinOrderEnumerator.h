@@ -0,0 +1,94 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace arangodb {
+namespace aql {
+
+/// @brief finds the cheapest order of a set of nested loops by dynamic
+/// programming over all subsets of the loops. the loops are executed as
+/// nested loops, so only left-deep orders are considered. when extending a
+/// subset of loops, loops that are connected to the subset by a join
+/// condition are preferred, so that cross products are only considered if
+/// there is no other way to continue.
+/// the time and memory needed grow exponentially with the number of loops,
+/// so the number of loops is limited to maxRelations
+class JoinOrderEnumerator {
+ public:
+  static constexpr size_t maxRelations = 12;
+
+  /// @brief add a loop. rows is the estimated number of rows the loop
+  /// produces on its own (after applying the conditions that only refer to
+  /// the loop itself), and scanCost is the cost of producing these rows
+  /// once. returns the index of the loop
+  size_t addRelation(double rows, double scanCost);
+
+  /// @brief add a join condition between two loops. when the inner loop is
+  /// nested into a set of loops containing the outer loop, producing the
+  /// matching rows of the inner loop costs lookupCost for each row of the
+  /// outer loops, and returns matches rows on average
+  void addJoin(size_t outer, size_t inner, double matches, double lookupCost);
+
+  /// @brief number of loops added
+  size_t size() const noexcept { return _relations.size(); }
+
+  /// @brief estimated cost of executing the loops in the given order, from
+  /// the outermost to the innermost loop
+  double cost(std::vector<size_t> const& order) const;
+
+  /// @brief the cheapest order of the loops, from the outermost to the
+  /// innermost loop. among orders with the same cost, the order in which the
+  /// loops were added is preferred
+  std::vector<size_t> findOrder() const;
+
+ private:
+  struct Relation {
+    double rows;
+    double scanCost;
+  };
+
+  struct Join {
+    size_t outer;
+    size_t inner;
+    double matches;
+    double lookupCost;
+  };
+
+  /// @brief the rows produced and the cost for adding the loop to the set
+  /// of outer loops, which produce outerRows rows
+  std::pair<double, double> extend(size_t outerSet, double outerRows,
+                                   size_t relation) const;
+
+  /// @brief whether or not a join condition connects the set of loops with
+  /// the loop
+  bool isConnected(size_t set, size_t relation) const noexcept;
+
+  std::vector<Relation> _relations;
+  std::vector<Join> _joins;
+};
+
+}  // namespace aql
+}  // namespace arangodb
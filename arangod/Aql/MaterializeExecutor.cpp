@@ -217,6 +217,63 @@ MaterializeExecutor<T, localDocumentId>::produceRows(
   auto end = _bufferedDocs.end();
   auto& callback = _readDocumentContext._callback;
   auto docRegId = _readDocumentContext._infos->inputNonMaterializedDocRegId();
+
+  if constexpr (localDocumentId) {
+    static_assert(isSingleCollection);
+    while (inputRange.hasDataRow() && !output.isFull()) {
+      // collect as many input rows as can be written, so that their
+      // documents can be read from the collection in one go
+      _batchRows.clear();
+      _batchDocumentIds.clear();
+      size_t const maxRows = output.numRowsLeft();
+      while (inputRange.hasDataRow() && _batchRows.size() < maxRows) {
+        auto const [state, input] =
+            inputRange.nextDataRow(AqlItemBlockInputRange::HasDataRow{});
+
+        TRI_IF_FAILURE("MaterializeExecutor::all_fail_and_count") {
+          stats.incrFiltered();
+          continue;
+        }
+
+        TRI_IF_FAILURE("MaterializeExecutor::all_fail") { continue; }
+
+        TRI_IF_FAILURE("MaterializeExecutor::only_one") {
+          if (output.numRowsWritten() + _batchRows.size() > 0) {
+            continue;
+          }
+        }
+
+        _batchDocumentIds.emplace_back(
+            input.getValue(docRegId).slice().getUInt());
+        _batchRows.emplace_back(input);
+      }
+
+      // the callback is only called for the documents that are found, in
+      // the order of the input rows
+      size_t next = 0;
+      _collection->getPhysical()->readMany(
+          &_trx, _batchDocumentIds,
+          [&](LocalDocumentId const& token, VPackSlice slice) {
+            while (_batchDocumentIds[next] != token) {
+              // document not found
+              stats.incrFiltered();
+              ++next;
+              TRI_ASSERT(next < _batchDocumentIds.size());
+            }
+            _readDocumentContext._inputRow = &_batchRows[next++];
+            _readDocumentContext._outputRow = &output;
+            callback(token, slice);
+            output.advanceRow();
+            return true;
+          },
+          ReadOwnWrites::no);
+      stats.incrFiltered(_batchRows.size() - next);
+    }
+    _batchRows.clear();
+
+    return {inputRange.upstreamState(), stats, upstreamCall};
+  }
+
   while (inputRange.hasDataRow() && !output.isFull()) {
     bool written = false;
     auto const [state, input] =
@@ -237,19 +294,7 @@ MaterializeExecutor<T, localDocumentId>::produceRows(
       }
     }
 
-    if constexpr (localDocumentId) {
-      // FIXME(gnusi): use rocksdb::DB::MultiGet(...)
-      TRI_ASSERT(isSingleCollection);
-      if constexpr (isSingleCollection) {
-        written =
-            _collection->getPhysical()
-                ->read(
-                    &_trx,
-                    LocalDocumentId(input.getValue(docRegId).slice().getUInt()),
-                    callback, ReadOwnWrites::no)
-                .ok();
-      }
-    } else {
+    if constexpr (!localDocumentId) {
       if (doc != end) {
         auto const& documentId = std::get<1>(*doc);
         if (documentId.isSet()) {
@@ -26,6 +26,7 @@
 #include "Aql/ExecutionBlock.h"
 #include "Aql/ExecutionBlockImpl.h"
 #include "Aql/ExecutionState.h"
+#include "Aql/InputAqlItemRow.h"
 #include "Aql/OutputAqlItemRow.h"
 #include "Aql/RegisterInfos.h"
 #include "Aql/types.h"
@@ -38,6 +39,7 @@
 
 #include <iosfwd>
 #include <memory>
+#include <vector>
 
 namespace arangodb {
 namespace aql {
@@ -176,6 +178,10 @@ class MaterializeExecutor {
   using BufferedRecordsContainer = std::vector<BufferRecord>;
   BufferedRecordsContainer _bufferedDocs;
 
+  // input rows and their document ids that are materialized together
+  std::vector<InputAqlItemRow> _batchRows;
+  std::vector<LocalDocumentId> _batchDocumentIds;
+
   transaction::Methods _trx;
   ReadContext _readDocumentContext;
   Infos const& _infos;
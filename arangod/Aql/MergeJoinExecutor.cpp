@@ -0,0 +1,343 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "MergeJoinExecutor.h"
+
+#include "Aql/AqlCall.h"
+#include "Aql/AqlItemBlockInputRange.h"
+#include "Aql/AqlValue.h"
+#include "Aql/AqlValueMaterializer.h"
+#include "Aql/Collection.h"
+#include "Aql/ExecutionBlock.h"
+#include "Aql/OutputAqlItemRow.h"
+#include "Aql/QueryContext.h"
+#include "Aql/SingleRowFetcher.h"
+#include "Basics/Exceptions.h"
+#include "Basics/VelocyPackHelper.h"
+#include "Indexes/IndexIterator.h"
+#include "StorageEngine/PhysicalCollection.h"
+#include "VocBase/LogicalCollection.h"
+
+#include <velocypack/Slice.h>
+
+#include <utility>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+namespace {
+
+/// @brief compare two lookup values in the same way as the persistent index
+/// orders its entries
+int compareKeys(velocypack::Slice lhs, velocypack::Slice rhs) {
+  return basics::VelocyPackHelper::compare(lhs, rhs, true);
+}
+
+/// @brief add the value of the (possibly nested) attribute to the builder.
+/// a non-existing attribute is treated as null, as it is in the index
+void addAttribute(velocypack::Builder& builder, velocypack::Slice value,
+                  std::vector<std::string> const& path) {
+  value = value.resolveExternals();
+  for (auto const& name : path) {
+    if (!value.isObject()) {
+      value = velocypack::Slice::noneSlice();
+      break;
+    }
+    value = value.get(name).resolveExternals();
+  }
+  if (value.isNone()) {
+    value = velocypack::Slice::nullSlice();
+  }
+  builder.add(value);
+}
+
+}  // namespace
+
+MergeJoinExecutorInfos::MergeJoinExecutorInfos(IndexExecutorInfos base,
+                                               std::vector<ProbeKey> probeKeys,
+                                               bool ascending)
+    : IndexExecutorInfos(std::move(base)),
+      _probeKeys(std::move(probeKeys)),
+      _ascending(ascending) {
+  TRI_ASSERT(!_probeKeys.empty());
+  TRI_ASSERT(getIndexes().size() == 1);
+  TRI_ASSERT(getProduceResult());
+  TRI_ASSERT(!getCount());
+  TRI_ASSERT(!isLateMaterialized());
+}
+
+std::vector<MergeJoinExecutorInfos::ProbeKey> const&
+MergeJoinExecutorInfos::getProbeKeys() const noexcept {
+  return _probeKeys;
+}
+
+bool MergeJoinExecutorInfos::isAscending() const noexcept {
+  return _ascending;
+}
+
+MergeJoinExecutor::MergeJoinExecutor(Fetcher&, Infos& infos)
+    : _trx(infos.query().newTrxContext()),
+      _infos(infos),
+      _currentRow(InputAqlItemRow{CreateInvalidInputRowHint{}}),
+      _documentProducingFunctionContext(_trx, _currentRow, infos),
+      _hasLookahead(false),
+      _cursorExhausted(false),
+      _hasMatches(false),
+      _matchesPosition(0) {
+  TRI_ASSERT(_trx.status() == transaction::Status::RUNNING);
+
+  // the documents are always read from the collection, even if the index
+  // could cover the projections, because we only keep the document ids of
+  // the matching index entries
+  _documentProducingFunctionContext.setAllowCoveringIndexOptimization(false);
+  _documentProducer =
+      buildDocumentCallback<false, false>(_documentProducingFunctionContext);
+  _documentSkipper =
+      buildDocumentCallback<false, true>(_documentProducingFunctionContext);
+}
+
+MergeJoinExecutor::~MergeJoinExecutor() = default;
+
+bool MergeJoinExecutor::fetchLookahead(IndexStats& stats) {
+  if (_hasLookahead) {
+    return true;
+  }
+
+  if (_cursor == nullptr) {
+    // full scan over the index, in the order of the lookup values
+    IndexIteratorOptions options = _infos.getOptions();
+    options.sorted = true;
+    options.ascending = _infos.isAscending();
+    options.limit = 0;
+    _cursor = _trx.indexScanForCondition(
+        _infos.query().resourceMonitor(), _infos.getIndexes()[0], nullptr,
+        _infos.getOutVariable(), options, _infos.canReadOwnWrites(),
+        transaction::Methods::kNoMutableConditionIdx);
+    stats.incrCursorsCreated();
+  }
+
+  size_t const numKeys = _infos.getProbeKeys().size();
+  auto cb = [&](LocalDocumentId const& token,
+                IndexIteratorCoveringData& covering) {
+    TRI_ASSERT(covering.isArray());
+    TRI_ASSERT(covering.length() >= numKeys);
+    _lookaheadKey.clear();
+    _lookaheadKey.openArray();
+    for (size_t i = 0; i < numKeys; ++i) {
+      _lookaheadKey.add(covering.at(i));
+    }
+    _lookaheadKey.close();
+    _lookaheadId = token;
+    _hasLookahead = true;
+    return true;
+  };
+
+  while (!_hasLookahead && !_cursorExhausted) {
+    _cursorExhausted = !_cursor->nextCovering(cb, 1);
+  }
+  return _hasLookahead;
+}
+
+int MergeJoinExecutor::compare(velocypack::Slice lhs,
+                               velocypack::Slice rhs) const {
+  int cmp = compareKeys(lhs, rhs);
+  return _infos.isAscending() ? cmp : -cmp;
+}
+
+void MergeJoinExecutor::seek(IndexStats& stats) {
+  _matchesPosition = 0;
+
+  if (_hasMatches) {
+    int cmp = compare(_probeKey.slice(), _matchesKey.slice());
+    if (cmp == 0) {
+      // same lookup value as for the previous input row
+      return;
+    }
+    if (cmp < 0) {
+      // the optimizer only uses a merge join if the input is sorted in
+      // index order. starting again from the beginning of the index for
+      // every out-of-order value could make the join quadratic
+      THROW_ARANGO_EXCEPTION_MESSAGE(
+          TRI_ERROR_INTERNAL, "merge join input is not sorted in index order");
+    }
+  }
+
+  _matches.clear();
+  _matchesKey.clear();
+  _matchesKey.add(_probeKey.slice());
+  _hasMatches = true;
+
+  uint_fast16_t killCheckCounter = 0;
+  while (fetchLookahead(stats)) {
+    int cmp = compare(_lookaheadKey.slice(), _probeKey.slice());
+    if (cmp > 0) {
+      // keep the entry for the next lookup value
+      break;
+    }
+    if (cmp == 0) {
+      _matches.emplace_back(_lookaheadId);
+    }
+    _hasLookahead = false;
+
+    if (++killCheckCounter == 0 && _infos.query().killed()) {
+      THROW_ARANGO_EXCEPTION(TRI_ERROR_QUERY_KILLED);
+    }
+  }
+}
+
+void MergeJoinExecutor::initializeNewRow(AqlItemBlockInputRange& inputRange,
+                                         IndexStats& stats) {
+  if (_currentRow) {
+    // moves one row forward
+    inputRange.advanceDataRow();
+  }
+  std::tie(std::ignore, _currentRow) = inputRange.peekDataRow();
+  if (!_currentRow) {
+    return;
+  }
+
+  TRI_ASSERT(_currentRow.isInitialized());
+
+  _probeKey.clear();
+  _probeKey.openArray();
+  for (auto const& [reg, path] : _infos.getProbeKeys()) {
+    AqlValue const& value = _currentRow.getValue(reg);
+    AqlValueMaterializer materializer(&_trx.vpackOptions());
+    addAttribute(_probeKey, materializer.slice(value, false), path);
+  }
+  _probeKey.close();
+
+  seek(stats);
+}
+
+bool MergeJoinExecutor::hasMoreMatches() const noexcept {
+  return _currentRow && _matchesPosition < _matches.size();
+}
+
+uint64_t MergeJoinExecutor::processMatches(
+    IndexIterator::DocumentCallback const& callback, uint64_t limit,
+    IndexStats& stats) {
+  auto& physical = *_infos.getCollection()->getCollection()->getPhysical();
+
+  uint64_t processed = 0;
+  bool matched = false;
+  auto cb = [&](LocalDocumentId const& token, velocypack::Slice document) {
+    matched = callback(token, document);
+    return true;
+  };
+
+  while (_matchesPosition < _matches.size() && processed < limit) {
+    LocalDocumentId const id = _matches[_matchesPosition++];
+    matched = false;
+    // the document may only be missing if it was removed by this query
+    // already, in which case we must not return it anyway
+    std::ignore = physical.read(&_trx, id, cb, _infos.canReadOwnWrites());
+    if (matched) {
+      ++processed;
+    }
+  }
+
+  stats.incrScanned(_documentProducingFunctionContext.getAndResetNumScanned());
+  stats.incrFiltered(
+      _documentProducingFunctionContext.getAndResetNumFiltered());
+  return processed;
+}
+
+[[nodiscard]] auto MergeJoinExecutor::expectedNumberOfRowsNew(
+    AqlItemBlockInputRange const& input, AqlCall const& call) const noexcept
+    -> size_t {
+  // we do not know how many documents match
+  return call.getLimit();
+}
+
+std::tuple<ExecutorState, IndexStats, AqlCall> MergeJoinExecutor::produceRows(
+    AqlItemBlockInputRange& inputRange, OutputAqlItemRow& output) {
+  TRI_IF_FAILURE("MergeJoinExecutor::produceRows") {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+  }
+
+  IndexStats stats{};
+  AqlCall upstreamCall{};
+  upstreamCall.fullCount = output.getClientCall().fullCount;
+
+  _documentProducingFunctionContext.setOutputRow(&output);
+
+  while (inputRange.hasDataRow() && !output.isFull()) {
+    TRI_ASSERT(output.isInitialized());
+
+    if (!hasMoreMatches()) {
+      initializeNewRow(inputRange, stats);
+    }
+
+    if (hasMoreMatches()) {
+      TRI_ASSERT(_currentRow.isInitialized());
+      processMatches(_documentProducer, output.numRowsLeft(), stats);
+    }
+  }
+  if (!hasMoreMatches()) {
+    initializeNewRow(inputRange, stats);
+  }
+  return {inputRange.upstreamState(), stats, upstreamCall};
+}
+
+std::tuple<ExecutorState, IndexStats, size_t, AqlCall>
+MergeJoinExecutor::skipRowsRange(AqlItemBlockInputRange& inputRange,
+                                 AqlCall& call) {
+  AqlCall upstreamCall{};
+  IndexStats stats{};
+
+  while ((inputRange.hasDataRow() || hasMoreMatches()) && call.shouldSkip()) {
+    if (!hasMoreMatches()) {
+      initializeNewRow(inputRange, stats);
+    }
+
+    if (hasMoreMatches()) {
+      TRI_ASSERT(_currentRow.isInitialized());
+      // if offset is > 0, we're in offset skip phase, otherwise in
+      // fullCount phase
+      size_t toSkip = call.getOffset() > 0 ? call.getOffset()
+                                           : ExecutionBlock::SkipAllSize();
+      call.didSkip(processMatches(_documentSkipper, toSkip, stats));
+    }
+  }
+  if (hasMoreMatches()) {
+    return {ExecutorState::HASMORE, stats, call.getSkipCount(), upstreamCall};
+  }
+  if (!call.needsFullCount()) {
+    // Do not overfetch too much
+    upstreamCall.softLimit = call.getOffset();
+  }
+
+  return {inputRange.upstreamState(), stats, call.getSkipCount(), upstreamCall};
+}
+
+void MergeJoinExecutor::initializeCursor() {
+  _currentRow = InputAqlItemRow{CreateInvalidInputRowHint{}};
+  _documentProducingFunctionContext.reset();
+  _matches.clear();
+  _matchesPosition = 0;
+  _hasMatches = false;
+  _hasLookahead = false;
+  _cursorExhausted = false;
+  if (_cursor != nullptr) {
+    _cursor->reset();
+  }
+}
@@ -0,0 +1,185 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Aql/DocumentProducingHelper.h"
+#include "Aql/IndexExecutor.h"
+#include "Aql/InputAqlItemRow.h"
+#include "Aql/RegisterInfos.h"
+#include "Aql/Stats.h"
+#include "Transaction/Methods.h"
+#include "VocBase/Identifiers/LocalDocumentId.h"
+
+#include <velocypack/Builder.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace arangodb {
+class IndexIterator;
+
+namespace aql {
+
+struct AqlCall;
+class AqlItemBlockInputRange;
+class OutputAqlItemRow;
+
+template<BlockPassthrough>
+class SingleRowFetcher;
+
+class MergeJoinExecutorInfos : public IndexExecutorInfos {
+ public:
+  /// @brief register and attribute to read the i-th lookup value from, for
+  /// the i-th field of the index
+  using ProbeKey = std::pair<RegisterId, std::vector<std::string>>;
+
+  MergeJoinExecutorInfos(IndexExecutorInfos base,
+                         std::vector<ProbeKey> probeKeys, bool ascending);
+
+  MergeJoinExecutorInfos() = delete;
+  MergeJoinExecutorInfos(MergeJoinExecutorInfos&&) = default;
+  MergeJoinExecutorInfos(MergeJoinExecutorInfos const&) = delete;
+  ~MergeJoinExecutorInfos() = default;
+
+  std::vector<ProbeKey> const& getProbeKeys() const noexcept;
+
+  /// @brief whether the lookup values arrive in ascending or in descending
+  /// order. the index is read in the same direction
+  bool isAscending() const noexcept;
+
+ private:
+  std::vector<ProbeKey> _probeKeys;
+  bool _ascending;
+};
+
+/**
+ * @brief Implementation of an IndexNode that is executed as a merge join.
+ * Instead of looking up the index for every input row, a single iterator
+ * reads the whole index in index order, and is moved forward in lockstep
+ * with the lookup values of the input rows, which the optimizer guarantees
+ * to be sorted in the same order. The index entries matching the current
+ * lookup value are kept, so that subsequent input rows with the same lookup
+ * value can reuse them. The iterator starts again from the beginning after
+ * each shadow row. Lookup values that are out of order are an internal
+ * error, as the iterator would have to be reset for them.
+ */
+class MergeJoinExecutor {
+ public:
+  struct Properties {
+    static constexpr bool preservesOrder = true;
+    static constexpr BlockPassthrough allowsBlockPassthrough =
+        BlockPassthrough::Disable;
+    static constexpr bool inputSizeRestrictsOutputSize = false;
+  };
+
+  using Fetcher = SingleRowFetcher<Properties::allowsBlockPassthrough>;
+  using Infos = MergeJoinExecutorInfos;
+  using Stats = IndexStats;
+
+  MergeJoinExecutor() = delete;
+  MergeJoinExecutor(MergeJoinExecutor&&) = delete;
+  MergeJoinExecutor(MergeJoinExecutor const&) = delete;
+  MergeJoinExecutor(Fetcher& fetcher, Infos&);
+  ~MergeJoinExecutor();
+
+  [[nodiscard]] auto expectedNumberOfRowsNew(
+      AqlItemBlockInputRange const& input, AqlCall const& call) const noexcept
+      -> size_t;
+
+  /**
+   * @brief produce the next Rows of Aql Values.
+   *
+   * @return ExecutorState, the stats, and a new Call that needs to be send to
+   * upstream
+   */
+  [[nodiscard]] std::tuple<ExecutorState, Stats, AqlCall> produceRows(
+      AqlItemBlockInputRange& inputRange, OutputAqlItemRow& output);
+
+  /**
+   * @brief skip the next Row of Aql Values.
+   *
+   * @return ExecutorState, the stats, and a new Call that needs to be send to
+   * upstream
+   */
+  [[nodiscard]] std::tuple<ExecutorState, Stats, size_t, AqlCall> skipRowsRange(
+      AqlItemBlockInputRange& inputRange, AqlCall& call);
+
+  void initializeCursor();
+
+ private:
+  void initializeNewRow(AqlItemBlockInputRange& inputRange, IndexStats& stats);
+
+  /// @brief compare two lookup values in the direction the index is read in
+  int compare(velocypack::Slice lhs, velocypack::Slice rhs) const;
+
+  /// @brief move the index iterator forward to the first entry that is not
+  /// less than the current lookup value, and collect all entries that are
+  /// equal to it
+  void seek(IndexStats& stats);
+
+  /// @brief read the next index entry into the lookahead, if there is none
+  /// yet. returns false if the index is exhausted
+  bool fetchLookahead(IndexStats& stats);
+
+  bool hasMoreMatches() const noexcept;
+
+  /// @brief read the documents of the matching index entries, and check the
+  /// filter condition for them. returns the number of documents produced
+  /// or skipped
+  uint64_t processMatches(IndexIterator::DocumentCallback const& callback,
+                          uint64_t limit, IndexStats& stats);
+
+  transaction::Methods _trx;
+  Infos& _infos;
+  InputAqlItemRow _currentRow;
+  DocumentProducingFunctionContext _documentProducingFunctionContext;
+  IndexIterator::DocumentCallback _documentProducer;
+  IndexIterator::DocumentCallback _documentSkipper;
+
+  /// @brief iterator over the whole index, in the order of the lookup values
+  std::unique_ptr<IndexIterator> _cursor;
+
+  /// @brief lookup value of the current input row (an array with one member
+  /// per index field used)
+  velocypack::Builder _probeKey;
+
+  /// @brief index values and id of the next index entry, not yet compared
+  velocypack::Builder _lookaheadKey;
+  LocalDocumentId _lookaheadId;
+  bool _hasLookahead;
+  bool _cursorExhausted;
+
+  /// @brief index values and ids of the index entries equal to the current
+  /// lookup value
+  velocypack::Builder _matchesKey;
+  std::vector<LocalDocumentId> _matches;
+  bool _hasMatches;
+
+  /// @brief position in _matches for the current input row
+  size_t _matchesPosition;
+};
+
+}  // namespace aql
+}  // namespace arangodb
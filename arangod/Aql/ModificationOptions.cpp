@@ -65,6 +65,8 @@ ModificationOptions::ModificationOptions(velocypack::Slice slice)
       obj, "consultAqlWriteFilter", false);
   exclusive =
       basics::VelocyPackHelper::getBooleanValue(obj, "exclusive", false);
+  readOwnWrites = basics::VelocyPackHelper::getBooleanValue(
+      obj, StaticStrings::ReadOwnWrites, true);
 }
 
 void ModificationOptions::toVelocyPack(velocypack::Builder& builder) const {
@@ -96,4 +98,5 @@ void ModificationOptions::toVelocyPack(velocypack::Builder& builder) const {
   builder.add("ignoreDocumentNotFound", VPackValue(ignoreDocumentNotFound));
   builder.add("consultAqlWriteFilter", VPackValue(consultAqlWriteFilter));
   builder.add("exclusive", VPackValue(exclusive));
+  builder.add(StaticStrings::ReadOwnWrites, VPackValue(readOwnWrites));
 }
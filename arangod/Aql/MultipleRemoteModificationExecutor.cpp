@@ -125,7 +125,7 @@ auto MultipleRemoteModificationExecutor::doMultipleRemoteOperations(
 
   TRI_ASSERT(_info._input1RegisterId.isValid());
   AqlValue const& inDocument = input.getValue(_info._input1RegisterId);
-  if (_info._options.returnOld &&
+  if (_info._mode == ExecutionNode::INSERT && _info._options.returnOld &&
       !_info._options.isOverwriteModeUpdateReplace()) {
     THROW_ARANGO_EXCEPTION_MESSAGE(
         TRI_ERROR_QUERY_VARIABLE_NAME_UNKNOWN,
@@ -138,8 +138,45 @@ auto MultipleRemoteModificationExecutor::doMultipleRemoteOperations(
     THROW_ARANGO_EXCEPTION(res);
   }
 
-  auto result = _trx.insert(_info._aqlCollection->name(), inDocument.slice(),
-                            _info._options);
+  // all documents are sent in one go. the coordinator groups them by
+  // responsible shard and sends one request per shard, to all shards
+  // concurrently
+  auto result = [&]() {
+    std::string const& name = _info._aqlCollection->name();
+    switch (_info._mode) {
+      case ExecutionNode::INSERT:
+        return _trx.insert(name, inDocument.slice(), _info._options);
+      case ExecutionNode::UPDATE:
+        return _trx.update(name, inDocument.slice(), _info._options);
+      case ExecutionNode::REPLACE:
+        return _trx.replace(name, inDocument.slice(), _info._options);
+      case ExecutionNode::REMOVE:
+        return _trx.remove(name, inDocument.slice(), _info._options);
+      default:
+        THROW_ARANGO_EXCEPTION_MESSAGE(
+            TRI_ERROR_INTERNAL,
+            "unexpected modification type for "
+            "MultipleRemoteModificationExecutor");
+    }
+  }();
+  processOperationResult(result, _info._ignoreErrors,
+                         _info._ignoreDocumentNotFound, stats);
+
+  res = _trx.commit();
+  if (!res.ok()) {
+    THROW_ARANGO_EXCEPTION(res);
+  }
+
+  // the increment of index is not correct when the executor doesn't apply the
+  // multiple document optimization rule, but, as it was only incrementing for
+  // index lookup operations which don't apply this rule for now, we don't
+  // increment the index
+  return result;
+}
+
+auto MultipleRemoteModificationExecutor::processOperationResult(
+    OperationResult const& result, bool ignoreErrors,
+    bool ignoreDocumentNotFound, Stats& stats) -> void {
   if (result.fail()) {
     THROW_ARANGO_EXCEPTION(result.result);
   }
@@ -149,9 +186,13 @@ auto MultipleRemoteModificationExecutor::doMultipleRemoteOperations(
   }
 
   // check operation result
-  if (!_info._ignoreErrors) {
-    if (!result.countErrorCodes.empty()) {
-      THROW_ARANGO_EXCEPTION(result.countErrorCodes.begin()->first);
+  if (!ignoreErrors) {
+    for (auto const& [code, count] : result.countErrorCodes) {
+      if (code == TRI_ERROR_ARANGO_DOCUMENT_NOT_FOUND &&
+          ignoreDocumentNotFound) {
+        continue;
+      }
+      THROW_ARANGO_EXCEPTION(code);
     }
   }
 
@@ -168,18 +209,8 @@ auto MultipleRemoteModificationExecutor::doMultipleRemoteOperations(
     }
   }
 
-  res = _trx.commit();
-  if (!res.ok()) {
-    THROW_ARANGO_EXCEPTION(res);
-  }
-
   stats.incrWritesExecuted(writesExecuted);
   stats.incrWritesIgnored(writesIgnored);
-  // the increment of index is not correct when the executor doesn't apply the
-  // multiple document optimization rule, but, as it was only incrementing for
-  // index lookup operations which don't apply this rule for now, we don't
-  // increment the index
-  return result;
 }
 
 auto MultipleRemoteModificationExecutor::doMultipleRemoteModificationOutput(
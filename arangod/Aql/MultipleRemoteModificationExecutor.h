@@ -23,6 +23,7 @@
 
 #pragma once
 
+#include "Aql/ExecutionNode.h"
 #include "Aql/InputAqlItemRow.h"
 #include "Aql/ModificationExecutorHelpers.h"
 #include "Aql/ModificationExecutorInfos.h"
@@ -37,7 +38,8 @@ class ExecutionEngine;
 
 struct MultipleRemoteModificationInfos : ModificationExecutorInfos {
   MultipleRemoteModificationInfos(
-      ExecutionEngine* engine, RegisterId inputRegister,
+      ExecutionEngine* engine, ExecutionNode::NodeType mode,
+      RegisterId inputRegister,
       RegisterId outputNewRegisterId, RegisterId outputOldRegisterId,
       RegisterId outputRegisterId, arangodb::aql::QueryContext& query,
       OperationOptions options, aql::Collection const* aqlCollection,
@@ -51,10 +53,12 @@ struct MultipleRemoteModificationInfos : ModificationExecutorInfos {
             aqlCollection, ProducesResults(false), consultAqlWriteFilter,
             ignoreErrors, DoCount(true), IsReplace(false),
             ignoreDocumentNotFound),
+        _mode(mode),
         _hasParent(hasParent),
         _isExclusive(isExclusive) {}
 
-  bool _hasParent;  // node->hasParent();
+  ExecutionNode::NodeType _mode;  // INSERT, UPDATE, REPLACE or REMOVE
+  bool _hasParent;                // node->hasParent();
   bool _isExclusive;
 };
 
@@ -84,6 +88,13 @@ struct MultipleRemoteModificationExecutor {
   [[nodiscard]] auto skipRowsRange(AqlItemBlockInputRange& input, AqlCall& call)
       -> std::tuple<ExecutorState, Stats, size_t, AqlCall>;
 
+  // throws if the result of a batch operation contains errors that must not
+  // be ignored, and counts the executed and the ignored writes of the batch
+  static auto processOperationResult(OperationResult const& result,
+                                     bool ignoreErrors,
+                                     bool ignoreDocumentNotFound, Stats& stats)
+      -> void;
+
  protected:
   auto doMultipleRemoteOperations(InputAqlItemRow&, Stats&) -> OperationResult;
   auto doMultipleRemoteModificationOutput(InputAqlItemRow&, OutputAqlItemRow&,
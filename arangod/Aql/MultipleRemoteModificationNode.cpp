@@ -45,11 +45,13 @@ using namespace arangodb::basics;
 using namespace arangodb::aql;
 
 MultipleRemoteModificationNode::MultipleRemoteModificationNode(
-    ExecutionPlan* plan, ExecutionNodeId id, Collection const* collection,
-    ModificationOptions const& options, Variable const* inVariable,
-    Variable const* outVariable, Variable const* OLD, Variable const* NEW)
+    ExecutionPlan* plan, ExecutionNodeId id, NodeType mode,
+    Collection const* collection, ModificationOptions const& options,
+    Variable const* inVariable, Variable const* outVariable,
+    Variable const* OLD, Variable const* NEW)
     : ExecutionNode(plan, id),
       CollectionAccessingNode(collection),
+      _mode(mode),
       _inVariable(inVariable),
       _outVariable(outVariable),
       _outVariableOld(OLD),
@@ -90,7 +92,7 @@ std::unique_ptr<ExecutionBlock> MultipleRemoteModificationNode::createBlock(
                                            std::move(writableOutputRegisters));
 
   auto executorInfos = MultipleRemoteModificationInfos(
-      &engine, in, outputNew, outputOld, out, _plan->getAst()->query(),
+      &engine, _mode, in, outputNew, outputOld, out, _plan->getAst()->query(),
       std::move(options), collection(),
       ConsultAqlWriteFilter(_options.consultAqlWriteFilter),
       IgnoreErrors(_options.ignoreErrors),
@@ -107,6 +109,8 @@ void MultipleRemoteModificationNode::doToVelocyPack(VPackBuilder& nodes,
   // add collection information
   CollectionAccessingNode::toVelocyPack(nodes, flags);
 
+  nodes.add("mode", VPackValue(ExecutionNode::getTypeString(_mode)));
+
   // add out variables
   bool isAnyVarUsedLater = false;
   if (_outVariableOld != nullptr) {
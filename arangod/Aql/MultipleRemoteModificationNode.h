@@ -53,6 +53,7 @@ class MultipleRemoteModificationNode final : public ExecutionNode,
   /// @brief constructor with an id
  public:
   MultipleRemoteModificationNode(ExecutionPlan* plan, ExecutionNodeId id,
+                                 NodeType mode,
                                  aql::Collection const* collection,
                                  ModificationOptions const& options,
                                  Variable const* inVariable,
@@ -83,7 +84,7 @@ class MultipleRemoteModificationNode final : public ExecutionNode,
   ExecutionNode* clone(ExecutionPlan* plan, bool withDependencies,
                        bool withProperties) const override final {
     auto n = std::make_unique<MultipleRemoteModificationNode>(
-        plan, _id, collection(), _options, _inVariable, _outVariable,
+        plan, _id, _mode, collection(), _options, _inVariable, _outVariable,
         _outVariableOld, _outVariableNew);
     CollectionAccessingNode::cloneInto(*n);
     return cloneHelper(std::move(n), withDependencies, withProperties);
@@ -104,6 +105,9 @@ class MultipleRemoteModificationNode final : public ExecutionNode,
                       unsigned flags) const override final;
 
  private:
+  /// @brief the modification type: INSERT, UPDATE, REPLACE or REMOVE
+  NodeType _mode;
+
   Variable const* _inVariable;
   Variable const* _outVariable;
 
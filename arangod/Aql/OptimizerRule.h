@@ -303,6 +303,16 @@ struct OptimizerRule {
     // avoid copying large amounts of unneeded documents
     moveFiltersIntoEnumerateRule,
 
+    // execute EnumerateCollection nodes as hash joins if their filter
+    // condition contains an equality comparison with an outer loop variable.
+    // must run after moveFiltersIntoEnumerateRule
+    hashJoinRule,
+
+    // execute Index nodes as merge joins if their index condition only
+    // consists of equality comparisons with the attributes of an outer
+    // Index node that is sorted on the same attributes
+    mergeJoinRule,
+
     // remove calculations that are redundant
     // this is hidden and disabled by default version
     // used to cleanup calculation nodes after conditionally
@@ -331,6 +341,10 @@ struct OptimizerRule {
     // try to restrict fragments to a single shard if possible
     restrictToSingleShardRule,
 
+    // send the input rows of index lookups by shard key only to the
+    // responsible shard, instead of to all shards
+    distributeLookupsToShardsRule,
+
     // turns LENGTH(FOR doc IN collection ... RETURN doc) into an optimized
     // count
     // operation
@@ -368,10 +382,24 @@ struct OptimizerRule {
     lateMaterialiationOffsetInfoRule,
 #endif
 
+    // discard documents early that cannot make it into the heap of a SORT
+    // node with a limit. must run after late materialization, and after all
+    // cluster rules, as it only looks at nodes in the same snippet
+    sortLimitThresholdRule,
+
+    // scan collections in parallel. must run after the sort limit threshold
+    // rule, as scans with a threshold are not parallelized
+    parallelizeCollectionScansRule,
+
     // splice subquery into the place of a subquery node
     // enclosed by a SubqueryStartNode and a SubqueryEndNode
-    // Must run last.
-    spliceSubqueriesRule
+    // Must run after all other rules except memoizeSubqueriesRule.
+    spliceSubqueriesRule,
+
+    // memoize the results of spliced subqueries by the values they depend
+    // on. needs the SubqueryStartNodes and SubqueryEndNodes, so it must run
+    // after splicing
+    memoizeSubqueriesRule
   };
 
 #ifdef USE_ENTERPRISE
@@ -386,6 +414,24 @@ struct OptimizerRule {
 
   static_assert(scatterInClusterRule < parallelizeGatherRule);
 
+  // the hash join rule relies on the join condition being moved into the
+  // EnumerateCollectionNode already
+  static_assert(moveFiltersIntoEnumerateRule < hashJoinRule);
+
+  // the merge join rule relies on the sort order of the outer Index node,
+  // and on the post-filter conditions already being moved into the nodes
+  static_assert(useIndexForSortRule < mergeJoinRule);
+  static_assert(moveFiltersIntoEnumerateRule < mergeJoinRule);
+
+  // the threshold is not used for late-materialized index nodes, and the
+  // rule only looks at the top-level query, i.e. it needs unspliced plans
+  static_assert(lateDocumentMaterializationRule < sortLimitThresholdRule);
+  static_assert(applySortLimitRule < sortLimitThresholdRule);
+  static_assert(sortLimitThresholdRule < spliceSubqueriesRule);
+  static_assert(sortLimitThresholdRule < parallelizeCollectionScansRule);
+  static_assert(parallelizeCollectionScansRule < spliceSubqueriesRule);
+  static_assert(spliceSubqueriesRule < memoizeSubqueriesRule);
+
   static_assert(moveCalculationsUpRule < applySortLimitRule,
                 "sort-limit adds/moves limit nodes. And calculations should "
                 "not be moved up after that.");
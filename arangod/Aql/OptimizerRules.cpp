@@ -42,6 +42,7 @@
 #include "Aql/Function.h"
 #include "Aql/IResearchViewNode.h"
 #include "Aql/IndexNode.h"
+#include "Aql/JoinOrderEnumerator.h"
 #include "Aql/ModificationNodes.h"
 #include "Aql/Optimizer.h"
 #include "Aql/OptimizerUtils.h"
@@ -58,6 +59,7 @@
 #include "Aql/WindowNode.h"
 #include "Aql/types.h"
 #include "Basics/AttributeNameParser.h"
+#include "Basics/NumberOfCores.h"
 #include "Basics/NumberUtils.h"
 #include "Basics/ScopeGuard.h"
 #include "Basics/StaticStrings.h"
@@ -76,6 +78,8 @@
 #include "Utils/CollectionNameResolver.h"
 #include "VocBase/Methods/Collections.h"
 
+#include <algorithm>
+#include <cmath>
 #include <tuple>
 
 #include <absl/strings/str_cat.h>
@@ -3639,6 +3643,242 @@ void arangodb::aql::removeFiltersCoveredByIndexRule(
   }
 }
 
+namespace {
+
+/// @brief minimum number of adjacent EnumerateCollectionNodes for which the
+/// join order is computed from cost estimates instead of trying out all
+/// permutations. from here on, the number of permutations exceeds the
+/// default maximum number of plans
+constexpr size_t minNodesForJoinOrdering = 5;
+
+/// @brief reduction of the number of documents by an equality condition on
+/// an attribute without a selectivity estimate. this is the same guess as
+/// the one used for the first index attribute when estimating index costs
+constexpr double joinOrderingEqualityReduction = 20.0;
+
+/// @brief check if the node is an attribute access without expansions of
+/// the output variable of one of the loops, and return the loop
+std::optional<size_t> findJoinOrderingAccess(
+    AstNode const* node,
+    std::unordered_map<Variable const*, size_t> const& loops,
+    std::vector<arangodb::basics::AttributeName>& attribute) {
+  std::pair<Variable const*, std::vector<arangodb::basics::AttributeName>>
+      access;
+  if (!node->isAttributeAccessForVariable(access, false) ||
+      access.second.empty()) {
+    return std::nullopt;
+  }
+  for (auto const& it : access.second) {
+    if (it.shouldExpand) {
+      return std::nullopt;
+    }
+  }
+  auto it = loops.find(access.first);
+  if (it == loops.end()) {
+    return std::nullopt;
+  }
+  attribute = std::move(access.second);
+  return (*it).second;
+}
+
+/// @brief estimated number of documents of a collection with a specific
+/// value of the attribute, if there is an index to look them up with
+std::optional<double> estimateJoinOrderingLookup(
+    std::vector<std::shared_ptr<Index>> const& indexes,
+    std::vector<arangodb::basics::AttributeName> const& attribute,
+    double count) {
+  std::optional<double> result;
+  for (auto const& idx : indexes) {
+    auto const type = idx->type();
+    if ((type != Index::TRI_IDX_TYPE_PRIMARY_INDEX &&
+         type != Index::TRI_IDX_TYPE_EDGE_INDEX &&
+         type != Index::TRI_IDX_TYPE_PERSISTENT_INDEX &&
+         type != Index::TRI_IDX_TYPE_HASH_INDEX &&
+         type != Index::TRI_IDX_TYPE_SKIPLIST_INDEX) ||
+        idx->sparse() || idx->fields().empty() ||
+        idx->fields()[0] != attribute) {
+      continue;
+    }
+    double matches = count / joinOrderingEqualityReduction;
+    if (idx->fields().size() == 1) {
+      // the selectivity estimate of an index on multiple attributes does
+      // not tell anything about its first attribute
+      if (idx->unique()) {
+        matches = 1.0;
+      } else if (idx->hasSelectivityEstimate()) {
+        double estimate = idx->selectivityEstimate();
+        if (estimate > 0.0) {
+          matches = 1.0 / estimate;
+        }
+      }
+    }
+    matches = std::clamp(matches, std::min(1.0, count), count);
+    if (!result.has_value() || matches < *result) {
+      result = matches;
+    }
+  }
+  return result;
+}
+
+/// @brief compute the order of a run of adjacent EnumerateCollectionNodes
+/// from the collection sizes and the selectivity estimates of the indexes
+/// that can be used for the equality conditions in the FILTERs following
+/// the run. the nodes are passed from the innermost to the outermost loop,
+/// and the order is returned from the outermost to the innermost loop.
+/// returns nothing if the order cannot be computed from estimates
+std::optional<std::vector<ExecutionNode*>> findJoinOrder(
+    ExecutionPlan const& plan, std::vector<ExecutionNode*> const& nodes) {
+  if (nodes.size() > JoinOrderEnumerator::maxRelations) {
+    return std::nullopt;
+  }
+  transaction::Methods& trx = plan.getAst()->query().trxForOptimization();
+  if (trx.status() != transaction::Status::RUNNING) {
+    return std::nullopt;
+  }
+
+  // the loops, from the outermost to the innermost one
+  std::vector<EnumerateCollectionNode*> loops;
+  std::unordered_map<Variable const*, size_t> loopsByVariable;
+  for (auto it = nodes.rbegin(); it != nodes.rend(); ++it) {
+    if ((*it)->getType() != EN::ENUMERATE_COLLECTION) {
+      return std::nullopt;
+    }
+    auto* loop = ExecutionNode::castTo<EnumerateCollectionNode*>(*it);
+    if (!loop->isDeterministic()) {
+      // random iteration produces a single document only
+      return std::nullopt;
+    }
+    loopsByVariable.emplace(loop->outVariable(), loops.size());
+    loops.emplace_back(loop);
+  }
+
+  // collect the equality comparisons of the FILTERs following the run
+  VarSet filterVariables;
+  std::vector<CalculationNode const*> calculations;
+  for (auto* current = nodes[0]->getFirstParent();
+       current != nullptr && (current->getType() == EN::CALCULATION ||
+                              current->getType() == EN::FILTER);
+       current = current->getFirstParent()) {
+    if (current->getType() == EN::FILTER) {
+      filterVariables.emplace(
+          ExecutionNode::castTo<FilterNode const*>(current)->inVariable());
+    } else {
+      calculations.emplace_back(
+          ExecutionNode::castTo<CalculationNode const*>(current));
+    }
+  }
+
+  std::vector<AstNode const*> comparisons;
+  for (auto const* calculation : calculations) {
+    if (!filterVariables.contains(calculation->outVariable())) {
+      continue;
+    }
+    std::vector<AstNode const*> stack{calculation->expression()->node()};
+    while (!stack.empty()) {
+      auto const* node = stack.back();
+      stack.pop_back();
+      if (node->type == NODE_TYPE_OPERATOR_BINARY_AND ||
+          node->type == NODE_TYPE_OPERATOR_NARY_AND) {
+        for (size_t i = 0; i < node->numMembers(); ++i) {
+          stack.emplace_back(node->getMemberUnchecked(i));
+        }
+      } else if (node->type == NODE_TYPE_OPERATOR_BINARY_EQ) {
+        comparisons.emplace_back(node);
+      }
+    }
+  }
+
+  std::vector<double> counts;
+  std::vector<std::vector<std::shared_ptr<Index>>> indexes;
+  for (auto const* loop : loops) {
+    counts.emplace_back(static_cast<double>(
+        loop->collection()->count(&trx, transaction::CountType::TryCache)));
+    indexes.emplace_back(loop->collection()->indexes());
+  }
+
+  // conditions that only refer to a single loop reduce the number of rows
+  // it produces, and may allow looking up its documents by index
+  std::vector<double> rows = counts;
+  std::vector<double> scanCosts = counts;
+  struct JoinCondition {
+    size_t outer;
+    size_t inner;
+    std::vector<arangodb::basics::AttributeName> attribute;
+  };
+  std::vector<JoinCondition> joinConditions;
+  std::vector<arangodb::basics::AttributeName> attribute;
+  std::vector<arangodb::basics::AttributeName> otherAttribute;
+  for (auto const* comparison : comparisons) {
+    for (size_t side = 0; side < 2; ++side) {
+      auto loop = ::findJoinOrderingAccess(
+          comparison->getMemberUnchecked(side), loopsByVariable, attribute);
+      if (!loop.has_value()) {
+        continue;
+      }
+      auto const* value = comparison->getMemberUnchecked(1 - side);
+      auto other =
+          ::findJoinOrderingAccess(value, loopsByVariable, otherAttribute);
+      if (other.has_value()) {
+        if (*other != *loop) {
+          joinConditions.emplace_back(JoinCondition{*other, *loop, attribute});
+        }
+        continue;
+      }
+
+      VarSet used;
+      Ast::getReferencedVariables(value, used);
+      bool const usesLoops =
+          std::any_of(used.begin(), used.end(), [&](Variable const* var) {
+            return loopsByVariable.contains(var);
+          });
+      if (usesLoops || !value->isDeterministic()) {
+        continue;
+      }
+      double const count = counts[*loop];
+      auto matches =
+          ::estimateJoinOrderingLookup(indexes[*loop], attribute, count);
+      if (matches.has_value()) {
+        rows[*loop] = std::min(rows[*loop], *matches);
+        scanCosts[*loop] = std::min(scanCosts[*loop],
+                                    std::log2(count + 1.0) + *matches);
+      } else {
+        rows[*loop] =
+            std::min(rows[*loop], count / joinOrderingEqualityReduction);
+      }
+    }
+  }
+
+  JoinOrderEnumerator enumerator;
+  for (size_t i = 0; i < loops.size(); ++i) {
+    enumerator.addRelation(rows[i], scanCosts[i]);
+  }
+  for (auto const& condition : joinConditions) {
+    size_t const inner = condition.inner;
+    double const count = counts[inner];
+    // the conditions on the inner loop alone still apply to the documents
+    // found by the join condition
+    double const reduction = count > 0.0 ? rows[inner] / count : 1.0;
+    auto matches = ::estimateJoinOrderingLookup(indexes[inner],
+                                                condition.attribute, count);
+    if (matches.has_value()) {
+      enumerator.addJoin(condition.outer, inner, *matches * reduction,
+                         std::log2(count + 1.0) + *matches);
+    } else {
+      enumerator.addJoin(condition.outer, inner,
+                         rows[inner] / joinOrderingEqualityReduction,
+                         scanCosts[inner]);
+    }
+  }
+
+  std::vector<ExecutionNode*> result;
+  for (auto i : enumerator.findOrder()) {
+    result.emplace_back(loops[i]);
+  }
+  return result;
+}
+
+}  // namespace
+
 /// @brief helper to compute lots of permutation tuples
 /// a permutation tuple is represented as a single vector together with
 /// another vector describing the boundaries of the tuples.
@@ -3671,7 +3911,9 @@ static bool NextPermutationTuple(std::vector<size_t>& data,
   return false;
 }
 
-/// @brief interchange adjacent EnumerateCollectionNodes in all possible ways
+/// @brief interchange adjacent EnumerateCollectionNodes in all possible ways.
+/// long runs of EnumerateCollectionNodes are put into the order with the
+/// lowest estimated cost instead
 void arangodb::aql::interchangeAdjacentEnumerationsRule(
     Optimizer* opt, std::unique_ptr<ExecutionPlan> plan,
     OptimizerRule const& rule) {
@@ -3690,6 +3932,10 @@ void arangodb::aql::interchangeAdjacentEnumerationsRule(
   std::vector<size_t> permTuple;
   std::vector<size_t> starts;
   std::vector<ExecutionNode*> nn;
+  // runs of nodes with their new order, from the outermost to the innermost
+  std::vector<
+      std::pair<std::vector<ExecutionNode*>, std::vector<ExecutionNode*>>>
+      reorderings;
 
   VarSet inputVars;
 
@@ -3751,6 +3997,16 @@ void arangodb::aql::interchangeAdjacentEnumerationsRule(
         nodesSet.erase(nwalker);
       }
 
+      if (nn.size() >= ::minNodesForJoinOrdering) {
+        // too many permutations to try all of them. use the order with the
+        // lowest estimated cost instead
+        auto order = ::findJoinOrder(*plan, nn);
+        if (order.has_value()) {
+          reorderings.emplace_back(nn, std::move(*order));
+          continue;
+        }
+      }
+
       if (nn.size() > 1) {
         // Move it into the permutation tuple:
         starts.emplace_back(permTuple.size());
@@ -3763,6 +4019,26 @@ void arangodb::aql::interchangeAdjacentEnumerationsRule(
     }
   }
 
+  bool modified = false;
+  for (auto const& [run, order] : reorderings) {
+    if (std::equal(order.begin(), order.end(), run.rbegin())) {
+      continue;
+    }
+    if (!modified) {
+      // keep the original order as well, in case the estimates are off
+      opt->addPlan(std::unique_ptr<ExecutionPlan>(plan->clone()), rule, false);
+      modified = true;
+    }
+    auto parent = run[0]->getFirstParent();
+    TRI_ASSERT(parent != nullptr);
+    for (auto* node : run) {
+      plan->unlinkNode(node);
+    }
+    for (auto* node : order) {
+      plan->insertDependency(parent, node);
+    }
+  }
+
   // Now we have collected all the runs of EnumerateCollectionNodes in the
   // plan, we need to compute all possible permutations of all of them,
   // independently. This is why we need to compute all permutation tuples.
@@ -3818,7 +4094,7 @@ void arangodb::aql::interchangeAdjacentEnumerationsRule(
     } while (NextPermutationTuple(permTuple, starts));
   }
 
-  opt->addPlan(std::move(plan), rule, false);
+  opt->addPlan(std::move(plan), rule, modified);
 }
 
 auto extractVocbaseFromNode(ExecutionNode* at) -> TRI_vocbase_t* {
@@ -4724,11 +5000,15 @@ void arangodb::aql::collectInClusterRule(Optimizer* opt,
             collectNode->groupVariables(copy);
 
             replaceGatherNodeVariables(plan.get(), gatherNode, replacements);
-          } else if (  //! collectNode->groupVariables().empty() &&
-              !collectNode->hasOutVariable()) {
+          } else if (!collectNode->hasOutVariable() ||
+                     (collectNode->hasExpressionVariable() &&
+                      !collectNode->hasKeepVariables())) {
             // clone a COLLECT v1 = expr, v2 = expr ... operation from the
             // coordinator to the DB server(s), and leave an aggregate COLLECT
-            // node on the coordinator for total aggregation
+            // node on the coordinator for total aggregation.
+            // an INTO var = expr is turned into an aggregation which collects
+            // the values into an array on the DB servers, and concatenates
+            // the arrays on the coordinator
 
             std::vector<AggregateVarInfo> dbServerAggVars;
             for (auto const& it : collectNode->aggregateVariables()) {
@@ -4748,6 +5028,15 @@ void arangodb::aql::collectInClusterRule(Optimizer* opt,
               break;
             }
 
+            Variable const* intoVariable = nullptr;
+            if (collectNode->hasOutVariable()) {
+              intoVariable =
+                  plan->getAst()->variables()->createTemporaryVariable();
+              dbServerAggVars.emplace_back(AggregateVarInfo{
+                  intoVariable, collectNode->expressionVariable(),
+                  "PUSH_STEP1"});
+            }
+
             // create new group variables
             auto const& groupVars = collectNode->groupVariables();
             std::vector<GroupVarInfo> outVars;
@@ -4792,6 +5081,13 @@ void arangodb::aql::collectInClusterRule(Optimizer* opt,
               ++j;
             }
 
+            if (intoVariable != nullptr) {
+              collectNode->aggregateVariables().emplace_back(AggregateVarInfo{
+                  collectNode->outVariable(), intoVariable, "PUSH_STEP2"});
+              collectNode->clearOutVariable();
+              collectNode->clearExpressionVariable();
+            }
+
             removeGatherNodeSort = (dbCollectNode->aggregationMethod() !=
                                     CollectOptions::CollectMethod::SORTED);
 
@@ -5365,6 +5661,170 @@ void arangodb::aql::restrictToSingleShardRule(
   opt->addPlan(std::move(plan), rule, wasModified);
 }
 
+namespace {
+/// @brief look for equality comparisons `variable.key == value` in an AND
+/// condition, for the shard keys in values that have no value yet. the
+/// values must be deterministic and must not use any of the variables in
+/// forbidden
+void findShardKeyValues(
+    AstNode const* root, Variable const* variable, VarSet const& forbidden,
+    std::unordered_map<std::string, AstNode const*>& values) {
+  if (root == nullptr) {
+    return;
+  }
+
+  if (root->type == NODE_TYPE_OPERATOR_BINARY_AND ||
+      root->type == NODE_TYPE_OPERATOR_NARY_AND) {
+    for (size_t i = 0; i < root->numMembers(); ++i) {
+      findShardKeyValues(root->getMember(i), variable, forbidden, values);
+    }
+    return;
+  }
+
+  if (root->type != NODE_TYPE_OPERATOR_BINARY_EQ) {
+    return;
+  }
+
+  for (size_t i = 0; i < 2; ++i) {
+    AstNode const* attribute = root->getMember(i);
+    AstNode const* value = root->getMember(1 - i);
+
+    std::pair<Variable const*, std::vector<basics::AttributeName>> pair;
+    if (!attribute->isAttributeAccessForVariable(pair, false) ||
+        pair.first != variable || !value->isDeterministic()) {
+      continue;
+    }
+
+    VarSet used;
+    Ast::getReferencedVariables(value, used);
+    if (std::any_of(used.begin(), used.end(), [&](Variable const* v) {
+          return forbidden.contains(v);
+        })) {
+      continue;
+    }
+
+    std::string name;
+    TRI_AttributeNamesToString(pair.second, name, true);
+    auto it = values.find(name);
+    if (it != values.end() && it->second == nullptr) {
+      it->second = value;
+      return;
+    }
+  }
+}
+}  // namespace
+
+void arangodb::aql::distributeLookupsToShardsRule(
+    Optimizer* opt, std::unique_ptr<ExecutionPlan> plan,
+    OptimizerRule const& rule) {
+  TRI_ASSERT(arangodb::ServerState::instance()->isCoordinator());
+  bool wasModified = false;
+
+  containers::SmallVector<ExecutionNode*, 8> nodes;
+  plan->findNodesOfType(nodes, EN::SCATTER, true);
+
+  for (auto* n : nodes) {
+    auto* scatter = ExecutionNode::castTo<ScatterNode*>(n);
+    auto const& parents = scatter->getParents();
+    if (parents.size() != 1 || parents[0]->getType() != EN::REMOTE) {
+      continue;
+    }
+
+    // the DB-Server part must only consist of the lookup and of
+    // calculations and filters. other nodes may depend on seeing all rows,
+    // or may access other collections
+    IndexNode* indexNode = nullptr;
+    VarSet varsSetOnDBServer;
+    bool eligible = true;
+    ExecutionNode* current = parents[0]->getFirstParent();
+    while (current != nullptr && current->getType() != EN::REMOTE) {
+      if (current->getType() == EN::INDEX && indexNode == nullptr) {
+        indexNode = ExecutionNode::castTo<IndexNode*>(current);
+      } else if (current->getType() != EN::CALCULATION &&
+                 current->getType() != EN::FILTER) {
+        eligible = false;
+        break;
+      }
+      for (auto const* v : current->getVariablesSetHere()) {
+        varsSetOnDBServer.emplace(v);
+      }
+      current = current->getFirstParent();
+    }
+    if (!eligible || indexNode == nullptr || current == nullptr ||
+        current->getFirstParent() == nullptr ||
+        current->getFirstParent()->getType() != EN::GATHER) {
+      continue;
+    }
+
+    Collection const* collection = indexNode->collection();
+    if (collection == nullptr || collection->isSmart() ||
+        collection->isSatellite() || collection->numberOfShards() <= 1 ||
+        indexNode->isRestricted()) {
+      continue;
+    }
+
+    auto const* condition = indexNode->condition();
+    if (condition == nullptr || condition->root() == nullptr ||
+        condition->root()->numMembers() != 1) {
+      // no condition, or multiple OR branches (e.g. for an IN list)
+      continue;
+    }
+
+    std::unordered_map<std::string, AstNode const*> values;
+    for (auto const& key : collection->shardKeys(true)) {
+      if (key.find('.') != std::string::npos) {
+        // sub-attributes are not supported
+        eligible = false;
+        break;
+      }
+      values.emplace(key, nullptr);
+    }
+    if (!eligible) {
+      continue;
+    }
+
+    ::findShardKeyValues(condition->root()->getMember(0),
+                         indexNode->outVariable(), varsSetOnDBServer, values);
+    if (indexNode->hasFilter()) {
+      ::findShardKeyValues(indexNode->filter()->node(),
+                           indexNode->outVariable(), varsSetOnDBServer,
+                           values);
+    }
+    if (std::any_of(values.begin(), values.end(),
+                    [](auto const& it) { return it.second == nullptr; })) {
+      continue;
+    }
+
+    // compute an object with the shard key values on the Coordinator, and
+    // distribute the rows by it
+    Ast* ast = plan->getAst();
+    AstNode* object = ast->createNodeObject();
+    for (auto const& [key, value] : values) {
+      object->addMember(ast->createNodeObjectElement(
+          ast->resources().registerString(key), ast->clone(value)));
+    }
+    Variable* variable = ast->variables()->createTemporaryVariable();
+    auto* calculationNode = plan->createNode<CalculationNode>(
+        plan.get(), plan->nextId(), std::make_unique<Expression>(ast, object),
+        variable);
+
+    auto* distributeNode = plan->createNode<DistributeNode>(
+        plan.get(), plan->nextId(), scatter->getScatterType(), collection,
+        variable, indexNode->id());
+    distributeNode->copyClients(scatter->clients());
+    plan->replaceNode(scatter, distributeNode);
+    plan->insertBefore(distributeNode, calculationNode);
+    wasModified = true;
+  }
+
+  if (wasModified) {
+    plan->clearVarUsageComputed();
+    plan->findVarUsage();
+  }
+
+  opt->addPlan(std::move(plan), rule, wasModified);
+}
+
 /// WalkerWorker for undistributeRemoveAfterEnumColl
 class RemoveToEnumCollFinder final
     : public WalkerWorker<ExecutionNode, WalkerUniqueness::NonUnique> {
@@ -8044,6 +8504,501 @@ void arangodb::aql::moveFiltersIntoEnumerateRule(
 
 namespace {
 
+/// @brief extract the attribute names of an attribute access without
+/// expansions. returns false if the node is not such an attribute access
+bool extractHashJoinAttribute(
+    AstNode const* node, Variable const*& variable,
+    std::vector<std::string>& attribute) {
+  std::pair<Variable const*, std::vector<arangodb::basics::AttributeName>>
+      access;
+  if (!node->isAttributeAccessForVariable(access, false) ||
+      access.second.empty()) {
+    return false;
+  }
+  // _id values are stored as a custom type inside documents, so they cannot
+  // be hashed in the same way as the values they are compared to
+  if (access.second[0].name == StaticStrings::IdString) {
+    return false;
+  }
+  attribute.clear();
+  for (auto const& it : access.second) {
+    if (it.shouldExpand) {
+      return false;
+    }
+    attribute.emplace_back(it.name);
+  }
+  variable = access.first;
+  return true;
+}
+
+/// @brief find an equality comparison `outVariable.a == other.b` among the
+/// AND-combined parts of the condition
+bool findHashJoinCondition(AstNode const* node, Variable const* outVariable,
+                           std::vector<std::string>& buildAttribute,
+                           Variable const*& probeVariable,
+                           std::vector<std::string>& probeAttribute) {
+  if (node->type == NODE_TYPE_OPERATOR_BINARY_AND ||
+      node->type == NODE_TYPE_OPERATOR_NARY_AND) {
+    for (size_t i = 0; i < node->numMembers(); ++i) {
+      if (findHashJoinCondition(node->getMemberUnchecked(i), outVariable,
+                                buildAttribute, probeVariable,
+                                probeAttribute)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  if (node->type != NODE_TYPE_OPERATOR_BINARY_EQ) {
+    return false;
+  }
+
+  for (size_t i = 0; i < 2; ++i) {
+    Variable const* build = nullptr;
+    Variable const* probe = nullptr;
+    if (extractHashJoinAttribute(node->getMemberUnchecked(i), build,
+                                 buildAttribute) &&
+        build == outVariable &&
+        extractHashJoinAttribute(node->getMemberUnchecked(1 - i), probe,
+                                 probeAttribute) &&
+        probe != outVariable) {
+      probeVariable = probe;
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace
+
+void arangodb::aql::hashJoinRule(Optimizer* opt,
+                                 std::unique_ptr<ExecutionPlan> plan,
+                                 OptimizerRule const& rule) {
+  bool modified = false;
+
+  containers::SmallVector<ExecutionNode*, 8> nodes;
+  plan->findNodesOfType(nodes, EN::ENUMERATE_COLLECTION, true);
+
+  std::vector<std::string> buildAttribute;
+  std::vector<std::string> probeAttribute;
+
+  for (auto const& n : nodes) {
+    auto en = ExecutionNode::castTo<EnumerateCollectionNode*>(n);
+
+    if (!en->hasFilter() || en->isHashJoin() || !en->isDeterministic() ||
+        en->doCount()) {
+      continue;
+    }
+
+    if (n->getLoop() == nullptr) {
+      // no outer loop, so the collection is scanned only once anyway
+      continue;
+    }
+
+    Variable const* probeVariable = nullptr;
+    if (!::findHashJoinCondition(en->filter()->node(), en->outVariable(),
+                                 buildAttribute, probeVariable,
+                                 probeAttribute)) {
+      continue;
+    }
+
+    // the whole filter condition is still evaluated for the documents found
+    // in the hash table, so we do not need to remove the equality
+    // comparison from it
+    en->setHashJoin(buildAttribute, probeVariable, probeAttribute);
+    modified = true;
+  }
+
+  opt->addPlan(std::move(plan), rule, modified);
+}
+
+namespace {
+
+/// @brief whether or not the index is a persistent index that a merge join
+/// can read in the order of its fields. hash and skiplist indexes are
+/// persistent indexes too
+bool isMergeJoinIndex(transaction::Methods::IndexHandle const& index) {
+  auto const type = index->type();
+  return (type == Index::TRI_IDX_TYPE_PERSISTENT_INDEX ||
+          type == Index::TRI_IDX_TYPE_HASH_INDEX ||
+          type == Index::TRI_IDX_TYPE_SKIPLIST_INDEX) &&
+         index->isSorted() && !index->hasExpansion();
+}
+
+/// @brief whether or not the index field is the given attribute
+bool isMergeJoinField(std::vector<arangodb::basics::AttributeName> const& field,
+                      std::vector<std::string> const& attribute) {
+  if (field.size() != attribute.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < field.size(); ++i) {
+    if (field[i].shouldExpand || field[i].name != attribute[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/// @brief find the lookup values for the leading fields of the index node's
+/// index. the index condition must consist of equality comparisons only,
+/// one for each of the leading index fields, and all lookup values must be
+/// attributes of the same variable
+bool findMergeJoinKeys(IndexNode const* node,
+                       std::vector<IndexNode::MergeJoinKey>& keys) {
+  keys.clear();
+
+  AstNode const* root = node->condition()->root();
+  if (root == nullptr || root->type != NODE_TYPE_OPERATOR_NARY_OR ||
+      root->numMembers() != 1) {
+    return false;
+  }
+  AstNode const* andNode = root->getMemberUnchecked(0);
+  TRI_ASSERT(andNode->type == NODE_TYPE_OPERATOR_NARY_AND);
+
+  auto const& fields = node->getIndexes()[0]->fields();
+  size_t const numKeys = andNode->numMembers();
+  if (numKeys == 0 || numKeys > fields.size()) {
+    return false;
+  }
+  keys.resize(numKeys);
+
+  Variable const* lookupVariable = nullptr;
+  for (size_t i = 0; i < numKeys; ++i) {
+    AstNode const* op = andNode->getMemberUnchecked(i);
+    if (op->type != NODE_TYPE_OPERATOR_BINARY_EQ) {
+      return false;
+    }
+
+    bool found = false;
+    for (size_t j = 0; j < 2 && !found; ++j) {
+      Variable const* indexed = nullptr;
+      Variable const* lookup = nullptr;
+      std::vector<std::string> indexedAttribute;
+      std::vector<std::string> lookupAttribute;
+      if (!::extractHashJoinAttribute(op->getMemberUnchecked(j), indexed,
+                                      indexedAttribute) ||
+          indexed != node->outVariable() ||
+          !::extractHashJoinAttribute(op->getMemberUnchecked(1 - j), lookup,
+                                      lookupAttribute) ||
+          lookup == node->outVariable() ||
+          (lookupVariable != nullptr && lookup != lookupVariable)) {
+        continue;
+      }
+      for (size_t k = 0; k < numKeys; ++k) {
+        if (keys[k].variable == nullptr &&
+            isMergeJoinField(fields[k], indexedAttribute)) {
+          keys[k].variable = lookup;
+          keys[k].attribute = std::move(lookupAttribute);
+          lookupVariable = lookup;
+          found = true;
+          break;
+        }
+      }
+    }
+    if (!found) {
+      return false;
+    }
+  }
+
+  // as there are exactly as many comparisons as keys, all leading index
+  // fields are used now
+  return true;
+}
+
+/// @brief find the loop that produces the lookup variable of a merge join,
+/// and check that it provably produces the lookup values in index order.
+/// the direction of the loop is returned in ascending
+bool isSortedMergeJoinInput(IndexNode const* node,
+                            std::vector<IndexNode::MergeJoinKey> const& keys,
+                            bool& ascending) {
+  // only nodes that do not change the order of the rows may be in between
+  ExecutionNode const* current = node->getFirstDependency();
+  while (current != nullptr && current->getType() != EN::INDEX) {
+    if (current->getType() != EN::CALCULATION &&
+        current->getType() != EN::FILTER) {
+      return false;
+    }
+    current = current->getFirstDependency();
+  }
+  if (current == nullptr) {
+    return false;
+  }
+
+  auto outer = ExecutionNode::castTo<IndexNode const*>(current);
+  if (outer->outVariable() != keys[0].variable ||
+      outer->getIndexes().size() != 1 || outer->isLateMaterialized() ||
+      !isMergeJoinIndex(outer->getIndexes()[0]) || !outer->options().sorted) {
+    return false;
+  }
+  auto const& fields = outer->getIndexes()[0]->fields();
+  if (fields.size() < keys.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < keys.size(); ++i) {
+    if (!isMergeJoinField(fields[i], keys[i].attribute)) {
+      return false;
+    }
+  }
+
+  // the outer index is only read in index order if it is read once. it is
+  // read once per OR branch, and once per value of an IN list
+  AstNode const* root = outer->condition()->root();
+  if (root != nullptr) {
+    if (root->numMembers() > 1) {
+      return false;
+    }
+    if (root->numMembers() == 1) {
+      AstNode const* andNode = root->getMemberUnchecked(0);
+      for (size_t i = 0; i < andNode->numMembers(); ++i) {
+        if (andNode->getMemberUnchecked(i)->type ==
+            NODE_TYPE_OPERATOR_BINARY_IN) {
+          return false;
+        }
+      }
+    }
+  }
+
+  // the outer index must be read only once. otherwise each of its
+  // iterations starts again with the smallest values
+  if (outer->getLoop() != nullptr) {
+    return false;
+  }
+  for (current = outer->getFirstDependency(); current != nullptr;
+       current = current->getFirstDependency()) {
+    if (current->getType() == EN::SUBQUERY_START) {
+      return false;
+    }
+  }
+  ascending = outer->options().ascending;
+  return true;
+}
+
+}  // namespace
+
+void arangodb::aql::mergeJoinRule(Optimizer* opt,
+                                  std::unique_ptr<ExecutionPlan> plan,
+                                  OptimizerRule const& rule) {
+  bool modified = false;
+
+  containers::SmallVector<ExecutionNode*, 8> nodes;
+  plan->findNodesOfType(nodes, EN::INDEX, true);
+
+  std::vector<IndexNode::MergeJoinKey> keys;
+  bool ascending = true;
+
+  for (auto const& n : nodes) {
+    auto in = ExecutionNode::castTo<IndexNode*>(n);
+
+    if (in->isMergeJoin() || in->getIndexes().size() != 1 ||
+        !in->isDeterministic() || in->doCount() || in->isLateMaterialized()) {
+      continue;
+    }
+
+    auto const& index = in->getIndexes()[0];
+    // a sparse index does not contain the documents with null values, but
+    // they would be found by a lookup for null
+    if (!isMergeJoinIndex(index) || index->sparse()) {
+      continue;
+    }
+
+    // if the input is not provably sorted in index order, the node stays
+    // an index lookup per input row
+    if (!::findMergeJoinKeys(in, keys) ||
+        !::isSortedMergeJoinInput(in, keys, ascending)) {
+      continue;
+    }
+
+    // reading the whole index is only cheaper than one lookup per row of
+    // the outer loop if there are enough rows
+    double const lookupCost = in->getCost().estimatedCost;
+    in->setMergeJoin(std::move(keys), ascending);
+    in->invalidateCost();
+    if (in->getCost().estimatedCost >= lookupCost) {
+      in->setMergeJoin({}, true);
+      in->invalidateCost();
+      continue;
+    }
+    modified = true;
+  }
+
+  opt->addPlan(std::move(plan), rule, modified);
+}
+
+namespace {
+
+/// @brief find the node below the SORT node that produces the documents the
+/// first sort criterion refers to, and the attribute it refers to. only
+/// calculations and filters may be in between, as rows discarded by the
+/// producing node would have been discarded by the SORT node anyway
+DocumentProducingNode* findSortLimitThresholdProducer(
+    ExecutionPlan const* plan, SortNode const* sort,
+    std::vector<std::string>& attribute) {
+  auto const& element = sort->elements()[0];
+  if (!element.attributePath.empty()) {
+    return nullptr;
+  }
+
+  auto setter = plan->getVarSetBy(element.var->id);
+  if (setter == nullptr || setter->getType() != EN::CALCULATION) {
+    return nullptr;
+  }
+  auto calc = ExecutionNode::castTo<CalculationNode const*>(setter);
+  Variable const* variable = nullptr;
+  if (!::extractHashJoinAttribute(calc->expression()->node(), variable,
+                                  attribute)) {
+    return nullptr;
+  }
+
+  ExecutionNode* current = sort->getFirstDependency();
+  while (current != nullptr) {
+    auto const type = current->getType();
+    if (type == EN::ENUMERATE_COLLECTION || type == EN::INDEX) {
+      break;
+    }
+    // calculations must not be skipped if they have side effects
+    if ((type != EN::CALCULATION && type != EN::FILTER) ||
+        !current->isDeterministic()) {
+      return nullptr;
+    }
+    current = current->getFirstDependency();
+  }
+  if (current == nullptr) {
+    return nullptr;
+  }
+
+  if (current->getType() == EN::ENUMERATE_COLLECTION) {
+    auto ecn = ExecutionNode::castTo<EnumerateCollectionNode const*>(current);
+    if (ecn->isHashJoin()) {
+      return nullptr;
+    }
+  } else {
+    auto in = ExecutionNode::castTo<IndexNode const*>(current);
+    if (in->isMergeJoin() || in->isLateMaterialized()) {
+      return nullptr;
+    }
+  }
+
+  auto producer = dynamic_cast<DocumentProducingNode*>(current);
+  TRI_ASSERT(producer != nullptr);
+  if (producer->outVariable() != variable || producer->doCount() ||
+      producer->hasSortLimitThreshold()) {
+    return nullptr;
+  }
+
+  // if only projections are produced, the attribute must be among them
+  SortLimitThresholdFilter filter;
+  filter.attribute = attribute;
+  if (!producer->projections().empty() &&
+      !filter.isCoveredBy(producer->projections())) {
+    return nullptr;
+  }
+  return producer;
+}
+
+}  // namespace
+
+void arangodb::aql::sortLimitThresholdRule(Optimizer* opt,
+                                           std::unique_ptr<ExecutionPlan> plan,
+                                           OptimizerRule const& rule) {
+  bool modified = false;
+
+  // with fullCount, all rows need to make it into the SORT node
+  if (!plan->getAst()->query().queryOptions().fullCount) {
+    std::vector<std::string> attribute;
+
+    // only look at the top-level query. the SORT node of a subquery starts
+    // with an empty heap for every iteration of the subquery, while the
+    // producing node may already produce rows for the next iteration
+    for (ExecutionNode* current = plan->root(); current != nullptr;
+         current = current->getFirstDependency()) {
+      if (current->getType() != EN::SORT) {
+        continue;
+      }
+      auto sort = ExecutionNode::castTo<SortNode*>(current);
+      if (sort->sorterType() != SortNode::SorterType::ConstrainedHeap) {
+        continue;
+      }
+
+      auto producer = ::findSortLimitThresholdProducer(plan.get(), sort,
+                                                       attribute);
+      if (producer == nullptr) {
+        continue;
+      }
+      producer->setSortLimitThreshold(sort->id(), std::move(attribute),
+                                      sort->elements()[0].ascending);
+      modified = true;
+    }
+  }
+
+  opt->addPlan(std::move(plan), rule, modified);
+}
+
+void arangodb::aql::parallelizeCollectionScansRule(
+    Optimizer* opt, std::unique_ptr<ExecutionPlan> plan,
+    OptimizerRule const& rule) {
+  // number of documents each of the parallel scans should at least read
+  constexpr double minDocumentsPerScan = 10000.0;
+  constexpr size_t maxParallelism = 8;
+
+  bool modified = false;
+
+  // in a cluster, the scans can only be parallelized if the whole query
+  // is executed on a DB server
+  bool applicable = !ServerState::instance()->isCoordinator();
+#ifdef USE_ENTERPRISE
+  applicable |= plan->hasAppliedRule(
+      static_cast<int>(OptimizerRule::clusterOneShardRule));
+#endif
+
+  // the scans use clones of the query's transaction context, so only
+  // read-only queries without V8 usage are supported (same as for all other
+  // parallel nodes)
+  if (applicable && !plan->getAst()->willUseV8() &&
+      !plan->getAst()->containsModificationNode() &&
+      !plan->contains(EN::REMOVE) &&
+      !plan->contains(EN::INSERT) && !plan->contains(EN::UPDATE) &&
+      !plan->contains(EN::REPLACE) && !plan->contains(EN::UPSERT)) {
+    // two scans are allowed even with few cores, so that reading the
+    // documents of one range can overlap with processing those of another
+    size_t const cap = std::clamp<size_t>(NumberOfCores::getValue() / 2, 2,
+                                          maxParallelism);
+
+    // only look at the top-level query, and only at loops that are executed
+    // once. the ranges are computed when the execution engine is created
+    for (ExecutionNode* current = plan->root(); current != nullptr;
+         current = current->getFirstDependency()) {
+      if (current->getType() != EN::ENUMERATE_COLLECTION) {
+        continue;
+      }
+      auto ec = ExecutionNode::castTo<EnumerateCollectionNode*>(current);
+      if (!ec->isDeterministic() || ec->isHashJoin() || ec->doCount() ||
+          ec->hasSortLimitThreshold() ||
+          ec->getFirstDependency()->getType() != EN::SINGLETON) {
+        continue;
+      }
+
+      double const documents = ec->estimateCost().estimatedNrItems;
+      size_t const parallelism = std::min(
+          cap, static_cast<size_t>(documents / minDocumentsPerScan));
+      if (parallelism >= 2) {
+        ec->setParallelism(parallelism);
+        modified = true;
+      }
+    }
+  }
+
+  if (modified) {
+    // make the query hand out a cloned transaction context to each snippet
+    // and async task, so that the scans do not share a context
+    plan->getAst()->setContainsParallelNode();
+    TRI_ASSERT(plan->getAst()->canApplyParallelism());
+  }
+
+  opt->addPlan(std::move(plan), rule, modified);
+}
+
+namespace {
+
 /// @brief is the node parallelizable?
 struct ParallelizableFinder final
     : public WalkerWorker<ExecutionNode, WalkerUniqueness::NonUnique> {
@@ -8733,6 +9688,176 @@ void arangodb::aql::spliceSubqueriesRule(Optimizer* opt,
   opt->addPlan(std::move(plan), rule, modified);
 }
 
+namespace {
+// maximum number of outer variables a memoized subquery can depend on
+constexpr size_t maxMemoizationKeyVariables = 4;
+
+// returns whether the spliced subquery starting at the node is nested in
+// another spliced subquery
+bool isInSplicedSubquery(ExecutionNode const* start) {
+  size_t ends = 0;
+  for (auto const* current = start->getFirstDependency(); current != nullptr;
+       current = current->getFirstDependency()) {
+    if (current->getType() == EN::SUBQUERY_END) {
+      ++ends;
+    } else if (current->getType() == EN::SUBQUERY_START) {
+      if (ends == 0) {
+        return true;
+      }
+      --ends;
+    }
+  }
+  return false;
+}
+
+// returns the SubqueryEndNode of the spliced subquery starting at the node,
+// if all nodes of the subquery can be memoized, and nullptr otherwise. the
+// nodes in between are returned in body
+SubqueryEndNode* findMemoizableSubqueryEnd(
+    ExecutionNode* start, std::vector<ExecutionNode*>& body) {
+  size_t depth = 0;
+  for (auto* current = start->getFirstParent(); current != nullptr;
+       current = current->getFirstParent()) {
+    switch (current->getType()) {
+      case EN::SUBQUERY_START:
+        ++depth;
+        break;
+      case EN::SUBQUERY_END:
+        if (depth == 0) {
+          return ExecutionNode::castTo<SubqueryEndNode*>(current);
+        }
+        --depth;
+        break;
+      case EN::REMOTE:
+      case EN::REMOTESINGLE:
+      case EN::REMOTE_MULTIPLE:
+      case EN::SCATTER:
+      case EN::GATHER:
+      case EN::DISTRIBUTE:
+      case EN::DISTRIBUTE_CONSUMER:
+      case EN::ASYNC:
+      case EN::MUTEX:
+        // the start and the end of the subquery need to share their state,
+        // so they must be executed in the same snippet
+        return nullptr;
+      default:
+        if (!current->isDeterministic()) {
+          return nullptr;
+        }
+        break;
+    }
+    body.push_back(current);
+  }
+  TRI_ASSERT(false);
+  return nullptr;
+}
+}  // namespace
+
+/// @brief memoize the results of spliced subqueries by the values of the
+/// outer query they depend on, so that a subquery is not executed again for
+/// repeated values
+void arangodb::aql::memoizeSubqueriesRule(Optimizer* opt,
+                                          std::unique_ptr<ExecutionPlan> plan,
+                                          OptimizerRule const& rule) {
+  bool modified = false;
+
+  containers::SmallVector<ExecutionNode*, 8> nodes;
+  plan->findNodesOfType(nodes, EN::SUBQUERY_START, true);
+
+  // the subquery results might change if the query modifies documents
+  if (!nodes.empty() &&
+      (plan->contains(EN::INSERT) || plan->contains(EN::UPDATE) ||
+       plan->contains(EN::REPLACE) || plan->contains(EN::REMOVE) ||
+       plan->contains(EN::UPSERT))) {
+    nodes.clear();
+  }
+
+  std::vector<ExecutionNode*> body;
+  VarSet usedHere;
+  for (auto* n : nodes) {
+    // the SubqueryStartExecutor and the SubqueryEndExecutor track the runs
+    // of the subquery in the same order. for a nested subquery, runs can be
+    // dropped in between when the enclosing subquery is skipped
+    if (isInSplicedSubquery(n)) {
+      continue;
+    }
+
+    body.clear();
+    SubqueryEndNode* end = findMemoizableSubqueryEnd(n, body);
+    if (end == nullptr) {
+      continue;
+    }
+
+    // the variables of the outer query used in the subquery
+    VarSet used;
+    VarSet set;
+    for (auto* current : body) {
+      current->getVariablesUsedHere(used);
+      for (auto const* v : current->getVariablesSetHere()) {
+        set.emplace(v);
+      }
+    }
+    std::vector<Variable const*> outer;
+    for (auto const* v : used) {
+      if (!set.contains(v)) {
+        outer.push_back(v);
+      }
+    }
+    if (outer.size() > maxMemoizationKeyVariables) {
+      continue;
+    }
+    std::sort(outer.begin(), outer.end(),
+              [](Variable const* lhs, Variable const* rhs) {
+                return lhs->id < rhs->id;
+              });
+
+    std::vector<SubqueryStartNode::MemoizationKeyPart> key;
+    for (auto const* v : outer) {
+      // if the variable is only used for attribute accesses, only the
+      // accessed attributes need to be part of the key
+      containers::FlatHashSet<AttributeNamePath> attributes;
+      bool onlyAttributes = true;
+      for (auto* current : body) {
+        usedHere.clear();
+        current->getVariablesUsedHere(usedHere);
+        if (!usedHere.contains(v)) {
+          continue;
+        }
+        if (current->getType() != EN::CALCULATION ||
+            !Ast::getReferencedAttributesRecursive(
+                ExecutionNode::castTo<CalculationNode*>(current)
+                    ->expression()
+                    ->node(),
+                v, /*expectedAttribute*/ "", attributes,
+                plan->getAst()->query().resourceMonitor())) {
+          onlyAttributes = false;
+          break;
+        }
+      }
+
+      auto& part = key.emplace_back(
+          SubqueryStartNode::MemoizationKeyPart{v, {}});
+      if (onlyAttributes && !attributes.empty()) {
+        std::vector<AttributeNamePath> sorted(attributes.begin(),
+                                              attributes.end());
+        std::sort(sorted.begin(), sorted.end());
+        for (auto const& path : sorted) {
+          auto& names = part.attributes.emplace_back();
+          for (auto const& name : path.get()) {
+            names.emplace_back(name.data(), name.size());
+          }
+        }
+      }
+    }
+
+    ExecutionNode::castTo<SubqueryStartNode*>(n)->memoize(std::move(key));
+    end->memoize(n->id());
+    modified = true;
+  }
+
+  opt->addPlan(std::move(plan), rule, modified);
+}
+
 void arangodb::aql::decayUnnecessarySortedGather(
     Optimizer* opt, std::unique_ptr<ExecutionPlan> plan,
     OptimizerRule const& rule) {
@@ -8910,6 +10035,9 @@ void arangodb::aql::insertDistributeInputCalculation(ExecutionPlan& plan) {
         };
         break;
       }
+      case ExecutionNode::INDEX:
+        // the input was already built by distribute-lookups-to-shards
+        continue;
       default: {
         TRI_ASSERT(false);
         THROW_ARANGO_EXCEPTION_MESSAGE(
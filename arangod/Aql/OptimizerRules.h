@@ -215,6 +215,11 @@ void smartJoinsRule(Optimizer*, std::unique_ptr<ExecutionPlan>,
 void restrictToSingleShardRule(Optimizer*, std::unique_ptr<ExecutionPlan>,
                                OptimizerRule const&);
 
+/// @brief send the input rows of index lookups by shard key only to the
+/// responsible shard
+void distributeLookupsToShardsRule(Optimizer*, std::unique_ptr<ExecutionPlan>,
+                                   OptimizerRule const&);
+
 /// @brief move collect to the DB servers in cluster
 void collectInClusterRule(Optimizer*, std::unique_ptr<ExecutionPlan>,
                           OptimizerRule const&);
@@ -330,6 +335,26 @@ void replaceNearWithinFulltextRule(Optimizer*, std::unique_ptr<ExecutionPlan>,
 void moveFiltersIntoEnumerateRule(Optimizer*, std::unique_ptr<ExecutionPlan>,
                                   OptimizerRule const&);
 
+/// @brief execute EnumerateCollection nodes with an equality join condition
+/// as hash joins
+void hashJoinRule(Optimizer*, std::unique_ptr<ExecutionPlan>,
+                  OptimizerRule const&);
+
+/// @brief execute Index nodes with an equality join condition on a sorted
+/// outer index as merge joins
+void mergeJoinRule(Optimizer*, std::unique_ptr<ExecutionPlan>,
+                   OptimizerRule const&);
+
+/// @brief discard documents in EnumerateCollection and Index nodes that
+/// cannot make it into the heap of a downstream SORT node with a limit
+void sortLimitThresholdRule(Optimizer*, std::unique_ptr<ExecutionPlan>,
+                            OptimizerRule const&);
+
+/// @brief scan large collections in the top-level query in parallel, by
+/// splitting them into disjoint ranges of documents
+void parallelizeCollectionScansRule(Optimizer*, std::unique_ptr<ExecutionPlan>,
+                                    OptimizerRule const&);
+
 /// @brief turns LENGTH(FOR doc IN collection) subqueries into an optimized
 /// count operation
 void optimizeCountRule(Optimizer*, std::unique_ptr<ExecutionPlan>,
@@ -348,6 +373,11 @@ void asyncPrefetchRule(Optimizer*, std::unique_ptr<ExecutionPlan>,
 void spliceSubqueriesRule(Optimizer*, std::unique_ptr<ExecutionPlan>,
                           OptimizerRule const&);
 
+/// @brief memoize the results of spliced subqueries by the values of the
+/// outer query they depend on
+void memoizeSubqueriesRule(Optimizer*, std::unique_ptr<ExecutionPlan>,
+                           OptimizerRule const&);
+
 //// @brief reduces a sorted gather to an unsorted gather if only one shard is
 /// involved
 void decayUnnecessarySortedGather(Optimizer*, std::unique_ptr<ExecutionPlan>,
@@ -444,10 +444,12 @@ bool substituteClusterSingleDocumentOperationsNoIndex(
   return modified;
 }
 
-bool substituteClusterMultipleDocumentInsertOperations(
-    Optimizer* opt, ExecutionPlan* plan, OptimizerRule const& rule) {
+bool substituteClusterMultipleDocumentOperations(Optimizer* opt,
+                                                 ExecutionPlan* plan,
+                                                 OptimizerRule const& rule) {
   containers::SmallVector<ExecutionNode*, 8> nodes;
-  plan->findNodesOfType(nodes, {EN::INSERT}, false);
+  plan->findNodesOfType(
+      nodes, {EN::INSERT, EN::UPDATE, EN::REPLACE, EN::REMOVE}, false);
 
   if (plan->getAst()->query().trxForOptimization().state()->hasHint(
           transaction::Hints::Hint::GLOBAL_MANAGED)) {
@@ -469,7 +471,34 @@ bool substituteClusterMultipleDocumentInsertOperations(
   }
 
   bool modified = false;
-  auto mod = ExecutionNode::castTo<InsertNode*>(node);
+  auto mod = ExecutionNode::castTo<ModificationNode*>(node);
+
+  // the variable holding the document (INSERT, UPDATE, REPLACE) or the
+  // key (REMOVE) to process
+  Variable const* inVariable = nullptr;
+  switch (node->getType()) {
+    case EN::INSERT:
+      inVariable = ExecutionNode::castTo<InsertNode const*>(node)->inVariable();
+      break;
+    case EN::REMOVE:
+      inVariable = ExecutionNode::castTo<RemoveNode const*>(node)->inVariable();
+      break;
+    case EN::UPDATE:
+    case EN::REPLACE: {
+      auto* updateReplace =
+          ExecutionNode::castTo<UpdateReplaceNode const*>(node);
+      if (updateReplace->inKeyVariable() != nullptr) {
+        // UPDATE key WITH doc: the key and the document cannot be passed
+        // to the transaction methods as a single array
+        return false;
+      }
+      inVariable = updateReplace->inDocVariable();
+      break;
+    }
+    default:
+      TRI_ASSERT(false);
+      return false;
+  }
 
   // for now, not support smart graph
   if (mod->collection()->isSmart() &&
@@ -490,12 +519,13 @@ bool substituteClusterMultipleDocumentInsertOperations(
   }
 
   auto* enumerateNode = ExecutionNode::castTo<EnumerateListNode const*>(dep);
-  if (enumerateNode->outVariable() != mod->inVariable()) {
+  if (enumerateNode->outVariable() != inVariable) {
     return false;
   }
 
   if (enumerateNode->isInInnerLoop()) {
-    // FOR ... INSERT is contained in inner loop. cannot use optimization
+    // FOR ... INSERT/UPDATE/REPLACE/REMOVE is contained in inner loop.
+    // cannot use optimization
     return false;
   }
 
@@ -525,9 +555,9 @@ bool substituteClusterMultipleDocumentInsertOperations(
 
   ExecutionNode* multiOperationNode =
       plan->createNode<MultipleRemoteModificationNode>(
-          plan, plan->nextId(), mod->collection(), mod->getOptions(),
-          enumerateNode->inVariable() /*in*/, nullptr, mod->getOutVariableOld(),
-          mod->getOutVariableNew());
+          plan, plan->nextId(), node->getType(), mod->collection(),
+          mod->getOptions(), enumerateNode->inVariable() /*in*/, nullptr,
+          mod->getOutVariableOld(), mod->getOutVariableNew());
 
   ::replaceNode(plan, mod, multiOperationNode);
   plan->unlinkNode(dep);
@@ -569,7 +599,7 @@ void substituteClusterMultipleDocumentOperationsRule(
     Optimizer* opt, std::unique_ptr<ExecutionPlan> plan,
     OptimizerRule const& rule) {
   bool modified =
-      substituteClusterMultipleDocumentInsertOperations(opt, plan.get(), rule);
+      substituteClusterMultipleDocumentOperations(opt, plan.get(), rule);
   if (modified) {
     // turn off all other cluster optimization rules now as they are superfluous
     opt->disableRules(plan.get(), [](OptimizerRule const& rule) {
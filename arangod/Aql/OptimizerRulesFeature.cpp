@@ -268,7 +268,10 @@ optimizations.)");
       OptimizerRule::makeFlags(OptimizerRule::Flags::CanCreateAdditionalPlans,
                                OptimizerRule::Flags::CanBeDisabled),
       R"(Try out permutations of `FOR` statements in queries that contain
-multiple loops, which may enable further optimizations by other rules.)");
+multiple loops, which may enable further optimizations by other rules.
+For five or more adjacent loops over collections, the order with the lowest
+estimated cost is used instead, based on the collection sizes and the
+selectivity estimates of the indexes that can be used for join conditions.)");
 
   // "Pass 4": moving nodes "up" (potentially outside loops) (second try):
   // move calculations up the dependency chain (to pull them out of
@@ -462,7 +465,8 @@ DB-Servers.)");
                OptimizerRule::substituteMultipleDocumentOperations,
                OptimizerRule::makeFlags(OptimizerRule::Flags::CanBeDisabled,
                                         OptimizerRule::Flags::ClusterOnly),
-               R"(For bulk `INSERT` operations in cluster deployments, avoid
+               R"(For bulk `INSERT`, `UPDATE`, `REPLACE`, and `REMOVE` operations
+in cluster deployments, avoid
 unnecessary overhead that AQL queries typically require for the setup and
 shutdown in clusters, as well as for the internal batching.
 
@@ -477,19 +481,27 @@ The following patterns are recognized:
 - `LET docs = [ { … }, { … }, … ] FOR doc IN docs INSERT doc INTO collection`,
   where the `docs` variable is a static array of input documents known at
   query compile time
+- the same patterns with `UPDATE doc IN collection`,
+  `REPLACE doc IN collection`, or `REMOVE doc IN collection` instead of
+  `INSERT`, where the documents (or document keys for `REMOVE`) contain the
+  `_key` attributes. The `UPDATE key WITH doc` and `REPLACE key WITH doc`
+  forms are not supported
 
 If a query has such a pattern, and all of the following restrictions are met,
 then the optimization is triggered:
 
 - There are no following `RETURN` nodes (including any `RETURN OLD` or `RETURN NEW`)
 - The `FOR` loop is not contained in another outer `FOR` loop or subquery
-- There are no other operations (e.g. `LET`, `FILTER`) between `FOR` and `INSERT`
-- `INSERT` is not used on a SmartGraph edge collection
+- There are no other operations (e.g. `LET`, `FILTER`) between `FOR` and the
+  modification operation
+- The operation is not used on a SmartGraph edge collection
 - The `FOR` loop iterates over a constant, deterministic expression
 
-The optimization then replaces the `InsertNode` and `EnumerateListNode` with a
-`MultipleRemoteExecutionNode` in the query execution plan, which takes care of
-inserting all documents into the collection in one go. Further optimizer rules
+The optimization then replaces the modification node and `EnumerateListNode`
+with a `MultipleRemoteExecutionNode` in the query execution plan, which takes
+care of processing all documents in one go. The Coordinator groups the
+documents by responsible shard and sends one request per shard, to all shards
+concurrently. Further optimizer rules
 are skipped if the optimization is triggered.
 )");
 
@@ -694,6 +706,24 @@ apply this optimization if it can safely determine the values of all the
 collection's shard keys from the query, and when the shard keys are covered by
 a single index (this is always true if the shard key is the default `_key`).)");
 
+  registerRule("distribute-lookups-to-shards", distributeLookupsToShardsRule,
+               OptimizerRule::distributeLookupsToShardsRule,
+               OptimizerRule::makeFlags(OptimizerRule::Flags::CanBeDisabled,
+                                        OptimizerRule::Flags::DisabledByDefault,
+                                        OptimizerRule::Flags::ClusterOnly),
+               R"(Send each input row of a collection lookup only to the shard
+that is responsible for it, instead of to all shards, if the lookup uses an
+index and its condition contains equality comparisons for all shard keys of the
+collection with values that are only known at runtime, e.g. attributes of a
+variable from an outer loop.
+
+The `ScatterNode` in front of the lookup is replaced with a `DistributeNode`.
+This optimization is applied if the DB-Server part of the lookup only consists
+of the `IndexNode` and of `CalculationNode` and `FilterNode` nodes.
+
+This rule is disabled by default and needs to be enabled explicitly, e.g. via
+the `optimizer.rules` query option `["+distribute-lookups-to-shards"]`.)");
+
   registerRule("move-filters-into-enumerate", moveFiltersIntoEnumerateRule,
                OptimizerRule::moveFiltersIntoEnumerateRule,
                OptimizerRule::makeFlags(OptimizerRule::Flags::CanBeDisabled),
@@ -702,6 +732,33 @@ a single index (this is always true if the shard key is the default `_key`).)");
 non-matching documents. This optimization can help to avoid a lot of temporary
 document copies.)");
 
+  registerRule("hash-join", hashJoinRule, OptimizerRule::hashJoinRule,
+               OptimizerRule::makeFlags(OptimizerRule::Flags::CanBeDisabled),
+               R"(Execute a nested `FOR` loop over a collection as a hash join
+if its filter condition contains an equality comparison between an attribute of
+the collection's documents and an attribute of a variable from an outer loop,
+and if there is no index that can be used instead. The collection is read only
+once to build an in-memory hash table, which is then probed for every row of
+the outer loop.
+
+If the hash table would exceed the `spillOverThresholdNumRows` or
+`spillOverThresholdMemoryUsage` query options, the collection is scanned for
+every row of the outer loop instead.)");
+
+  registerRule("merge-join", mergeJoinRule, OptimizerRule::mergeJoinRule,
+               OptimizerRule::makeFlags(OptimizerRule::Flags::CanBeDisabled),
+               R"(Execute a nested `FOR` loop over a collection as a merge join
+if it uses a non-sparse persistent index, and the index condition consists of
+equality comparisons between the leading index attributes and the attributes of
+an outer `FOR` loop, which itself reads a persistent index on the same
+attributes in index order, ascending or descending, with a single lookup
+(no `OR` branches and no `IN` lists). Both indexes are then read only once, in
+lockstep and in the same direction, instead of doing a lookup in the inner
+index for every row of the outer loop.
+
+The rule is only applied if the estimated costs of reading the whole inner
+index are lower than the costs of the individual lookups.)");
+
   registerRule("optimize-count", optimizeCountRule,
                OptimizerRule::optimizeCountRule,
                OptimizerRule::makeFlags(OptimizerRule::Flags::CanBeDisabled),
@@ -768,13 +825,39 @@ involved attributes are covered by regular indexes.)");
 avoid unnecessary reads.)");
 #endif
 
+  registerRule("sort-limit-threshold", sortLimitThresholdRule,
+               OptimizerRule::sortLimitThresholdRule,
+               OptimizerRule::makeFlags(OptimizerRule::Flags::CanBeDisabled),
+               R"(Discard documents in a `FOR` loop over a collection or an
+index early, if they cannot make it into the result of a subsequent `SORT`
+with a `LIMIT`, because the value of the first sort criterion is worse than
+the one of all the documents kept so far. This saves copying the documents and
+evaluating further calculations and filters for them.
+
+The rule is not applied if the query uses the `fullCount` option.)");
+
+  registerRule("parallelize-collection-scans", parallelizeCollectionScansRule,
+               OptimizerRule::parallelizeCollectionScansRule,
+               OptimizerRule::makeFlags(OptimizerRule::Flags::CanBeDisabled,
+                                        OptimizerRule::Flags::DisabledByDefault),
+               R"(Scan a large collection in a top-level `FOR` loop with
+multiple threads, each reading a disjoint range of its documents. The
+documents are returned in no particular order. The rule is only applied to
+read-only queries, on single servers and in OneShard databases. The number of
+threads is limited by half the number of available CPU cores, but at least two
+threads are used.
+
+This rule is disabled by default, as the parallel scans share the state of
+the query's transaction.)");
+
   // add the storage-engine specific rules
   addStorageEngineRules();
 
   // Splice subqueries
   //
   // ***CAUTION***
-  // TL;DR: This rule (if activated) *must* run last.
+  // TL;DR: This rule (if activated) *must* run last, except for the
+  // memoize-subqueries rule, which is aware of spliced subqueries.
   //
   // It changes the structure of the query plan by "splicing", i.e. replacing
   // every SubqueryNode by a SubqueryStart and a SubqueryEnd node with the
@@ -796,6 +879,21 @@ return a few results at a time.
 This optimization is performed on all subqueries and is applied after all other
 optimizations.)");
 
+  // memoize the results of spliced subqueries. this works on the
+  // SubqueryStartNodes and SubqueryEndNodes, so it runs after splicing
+  registerRule("memoize-subqueries", memoizeSubqueriesRule,
+               OptimizerRule::memoizeSubqueriesRule,
+               OptimizerRule::makeFlags(OptimizerRule::Flags::CanBeDisabled),
+               R"(Appears if the results of subqueries are memoized by the
+values of the outer query they depend on, so that a subquery is executed only
+once for every distinct combination of these values. If a subquery only
+accesses attributes of an outer variable, only these attributes are considered.
+
+The rule is only applied to read-only queries, to subqueries that are not
+nested in other subqueries, that are deterministic, depend on at most 4 outer
+variables, and are executed in a single query snippet. Results are memoized
+up to a size of 16 MiB per subquery.)");
+
   // allow nodes to asynchronously prefetch the next batch while processing the
   // current batch. this effectively allows parts of the query to run in
   // parallel, but as some internal details are currently not guaranteed to be
@@ -570,6 +570,17 @@ RegisterCount OutputAqlItemRow::getNumRegisters() const {
   return block().numRegisters();
 }
 
+bool OutputAqlItemRow::hasContiguousColumns() const noexcept {
+  return block().hasContiguousColumns();
+}
+
+std::span<AqlValue const> OutputAqlItemRow::getColumnSpan(
+    RegisterId registerId) const noexcept {
+  TRI_ASSERT(registerId.isRegularRegister());
+  TRI_ASSERT(registerId < getNumRegisters());
+  return block().getColumn(registerId.value(), 0, _baseIndex);
+}
+
 template void OutputAqlItemRow::copyRow<InputAqlItemRow>(
     InputAqlItemRow const& sourceRow, bool ignoreMissing);
 template void OutputAqlItemRow::copyRow<ShadowAqlItemRow>(
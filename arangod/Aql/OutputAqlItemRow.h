@@ -33,6 +33,7 @@
 #include "Containers/HashSet.h"
 
 #include <memory>
+#include <span>
 
 namespace arangodb::aql {
 
@@ -132,6 +133,20 @@ class OutputAqlItemRow {
 
   [[nodiscard]] RegisterCount getNumRegisters() const;
 
+  /**
+   * @brief Whether the values of each register are stored contiguously in
+   *        the output block, so that getColumnSpan() can be used.
+   */
+  [[nodiscard]] bool hasContiguousColumns() const noexcept;
+
+  /**
+   * @brief Get the values already written to the given output register,
+   *        for all rows of the output block up to (excluding) the current
+   *        row. Requires hasContiguousColumns().
+   */
+  [[nodiscard]] std::span<AqlValue const> getColumnSpan(
+      RegisterId registerId) const noexcept;
+
   /**
    * @brief May only be called after all output values in the current row have
    * been set, or in case there are zero output registers, after copyRow has
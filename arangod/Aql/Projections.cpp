@@ -42,6 +42,51 @@ namespace {
 /// @brief velocypack attribute name for serializing/unserializing projections
 constexpr std::string_view projectionsKey("projections");
 
+/// @brief look up a top-level attribute in a document. documents of the same
+/// layout have their attributes at the same positions, so the position at
+/// which the attribute was found in the previous document is tried first.
+/// otherwise does a binary search over the object's sorted index table and
+/// remembers the attribute's position
+VPackSlice lookupAttribute(VPackSlice slice, std::string_view name,
+                           std::atomic<uint32_t>& hint) {
+  // only objects with a sorted index table (0x0b - 0x0e) allow accessing
+  // the attribute at a position in constant time
+  uint8_t const head = slice.head();
+  if (head < 0x0b || head > 0x0e) {
+    return slice.get(name);
+  }
+
+  VPackValueLength const n = slice.length();
+  uint32_t position = hint.load(std::memory_order_relaxed);
+  if (position < n) {
+    VPackSlice key = slice.keyAt(position, /*translate*/ true);
+    if (key.isString() && key.stringView() == name) {
+      return slice.valueAt(position);
+    }
+  }
+
+  VPackValueLength low = 0;
+  VPackValueLength high = n;
+  while (low < high) {
+    VPackValueLength mid = low + (high - low) / 2;
+    VPackSlice key = slice.keyAt(mid, /*translate*/ true);
+    if (!key.isString()) {
+      return slice.get(name);
+    }
+    int res = key.stringView().compare(name);
+    if (res == 0) {
+      hint.store(static_cast<uint32_t>(mid), std::memory_order_relaxed);
+      return slice.valueAt(mid);
+    }
+    if (res < 0) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  return VPackSlice::noneSlice();
+}
+
 }  // namespace
 
 namespace arangodb::aql {
@@ -141,7 +186,8 @@ void Projections::toVelocyPackFromDocument(
       // projection for any other top-level attribute
       TRI_ASSERT(levelsOpen == 0);
       TRI_ASSERT(it.path.size() == 1);
-      VPackSlice found = slice.get(it.path._path.at(0));
+      VPackSlice found =
+          lookupAttribute(slice, it.path[0], it.positionHint.value);
       if (found.isNone()) {
         // attribute not found
         b.add(it.path[0], VPackValue(VPackValueType::Null));
@@ -163,7 +209,9 @@ void Projections::toVelocyPackFromDocument(
       VPackSlice prev = found;
       size_t level = 0;
       while (level < it.path.size()) {
-        found = found.get(it.path[level]);
+        found = (level == 0) ? lookupAttribute(found, it.path[level],
+                                               it.positionHint.value)
+                             : found.get(it.path[level]);
         if (found.isNone() || level == it.path.size() - 1 ||
             !found.isObject()) {
           break;
@@ -350,7 +398,8 @@ void Projections::init(T paths) {
     _projections.emplace_back(
         Projection{std::move(path), kNoCoveringIndexPosition,
                    /*coveringIndexCutoff*/ 0, /*startsAtLevel*/ 0,
-                   /*levelsToClose*/ static_cast<uint16_t>(length - 1), type});
+                   /*levelsToClose*/ static_cast<uint16_t>(length - 1), type,
+                   /*positionHint*/ {}});
   }
 
   TRI_ASSERT(_projections.size() <= paths.size());
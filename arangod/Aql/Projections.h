@@ -27,6 +27,7 @@
 #include "Containers/FlatHashSet.h"
 #include "VocBase/Identifiers/DataSourceId.h"
 
+#include <atomic>
 #include <cstdint>
 #include <limits>
 #include <memory>
@@ -53,6 +54,22 @@ namespace aql {
 /// documents and index entries
 class Projections {
  public:
+  /// @brief position of an attribute in the last document it was extracted
+  /// from. only a hint, which is verified before it is used. thus it is fine
+  /// if multiple threads update it concurrently
+  struct PositionHint {
+    PositionHint() noexcept = default;
+    PositionHint(PositionHint const& other) noexcept
+        : value(other.value.load(std::memory_order_relaxed)) {}
+    PositionHint& operator=(PositionHint const& other) noexcept {
+      value.store(other.value.load(std::memory_order_relaxed),
+                  std::memory_order_relaxed);
+      return *this;
+    }
+
+    mutable std::atomic<uint32_t> value{0};
+  };
+
   /// @brief projection for a single top-level attribute or a nested attribute
   struct Projection {
     /// @brief the attribute path
@@ -68,6 +85,10 @@ class Projections {
     uint16_t levelsToClose;
     /// @brief attribute type
     AttributeNamePath::Type type;
+    /// @brief position of the top-level attribute in the last document.
+    /// documents with the same layout have their attributes at the same
+    /// positions, so this position is tried first
+    PositionHint positionHint;
   };
 
   static constexpr uint16_t kNoCoveringIndexPosition =
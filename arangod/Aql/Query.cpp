@@ -38,8 +38,10 @@
 #include "Aql/Parser.h"
 #include "Aql/ProfileLevel.h"
 #include "Aql/QueryCache.h"
+#include "Aql/QueryCacheUpdater.h"
 #include "Aql/QueryExecutionState.h"
 #include "Aql/QueryList.h"
+#include "Aql/QueryPlanCache.h"
 #include "Aql/QueryProfile.h"
 #include "Aql/QueryRegistry.h"
 #include "Aql/Timing.h"
@@ -90,6 +92,27 @@ constexpr std::string_view fullcountTrue("fullcount:true");
 constexpr std::string_view fullcountFalse("fullcount:false");
 constexpr std::string_view countTrue("count:true");
 constexpr std::string_view countFalse("count:false");
+
+/// @brief check the bind parameters of a query against the ones used by a
+/// cached plan, with the same errors that injecting them into the AST
+/// would produce
+void validateBindParameters(
+    BindParameters const& parameters,
+    std::unordered_set<std::string> const& usedParameters) {
+  for (auto const& name : usedParameters) {
+    if (parameters.get(name).first.isNone()) {
+      THROW_ARANGO_EXCEPTION_PARAMS(TRI_ERROR_QUERY_BIND_PARAMETER_MISSING,
+                                    name.c_str());
+    }
+  }
+  parameters.visit(
+      [&](std::string const& key, VPackSlice /*value*/, AstNode* /*node*/) {
+        if (!usedParameters.contains(key)) {
+          THROW_ARANGO_EXCEPTION_PARAMS(
+              TRI_ERROR_QUERY_BIND_PARAMETER_UNDECLARED, key.c_str());
+        }
+      });
+}
 }  // namespace
 
 /// @brief internal constructor, Used to construct a full query or a
@@ -168,6 +191,9 @@ Query::Query(QueryId id, std::shared_ptr<transaction::Context> ctx,
 
   // set memory limit for query
   _resourceMonitor.memoryLimit(_queryOptions.memoryLimit);
+  _itemBlockManager.setColumnarLayoutMinRegisters(static_cast<RegisterCount>(
+      std::min<size_t>(_queryOptions.columnarLayoutMinRegisters,
+                       RegisterId::maxRegisterId)));
   _warnings.updateOptions(_queryOptions);
 
   // store name of user that started the query
@@ -292,6 +318,10 @@ bool Query::killed() const {
          _queryKilled.load(std::memory_order_acquire);
 }
 
+velocypack::Slice Query::bindParameterValue(std::string_view name) const {
+  return _bindParameters.get(std::string(name)).first;
+}
+
 /// @brief set the query to killed
 void Query::kill() {
   auto const wasKilled = _queryKilled.exchange(true, std::memory_order_acq_rel);
@@ -399,13 +429,68 @@ std::unique_ptr<ExecutionPlan> Query::preparePlan() {
       << " this: " << (uintptr_t)this;
 
   TRI_ASSERT(_ast != nullptr);
-  Parser parser(*this, *_ast, _queryString);
-  parser.parse();
 
-  // put in bind parameters
-  parser.ast()->injectBindParameters(_bindParameters, this->resolver());
+  // look up the plan in the query plan cache first
+  bool usePlanCache = canUsePlanCache();
+  uint64_t planCacheGeneration = 0;
+  std::string planCacheQueryKey;
+  std::optional<std::unordered_set<std::string>> runtimeBindParameters;
+  std::optional<std::string> planCacheKey;
+  std::shared_ptr<QueryPlanCache::CachedPlan const> cachedPlan;
+  if (usePlanCache) {
+    auto* planCache = QueryPlanCache::instance();
+    planCacheGeneration = planCache->generation();
+    planCacheQueryKey = buildPlanCacheQueryKey();
+    runtimeBindParameters =
+        planCache->runtimeBindParameters(&_vocbase, planCacheQueryKey);
+    if (runtimeBindParameters.has_value()) {
+      planCacheKey = QueryPlanCache::buildPlanKey(_bindParameters,
+                                                  *runtimeBindParameters);
+      if (planCacheKey.has_value()) {
+        cachedPlan =
+            planCache->lookup(&_vocbase, planCacheQueryKey, *planCacheKey);
+      }
+    }
+  }
+
+  if (cachedPlan != nullptr) {
+    // the bind parameters are not injected into the AST, so they must be
+    // checked here
+    validateBindParameters(_bindParameters, cachedPlan->bindParameters);
+    // the cached plan contains all collections and variables used
+    ExecutionPlan::getCollectionsFromVelocyPack(_collections,
+                                                cachedPlan->plan->slice());
+    _ast->variables()->fromVelocyPack(cachedPlan->plan->slice());
+    // restore the properties of the AST that are needed for the execution
+    if (cachedPlan->containsParallelNode) {
+      _ast->setContainsParallelNode();
+    }
+  } else {
+    Parser parser(*this, *_ast, _queryString);
+    parser.parse();
+
+    if (usePlanCache && (_ast->containsModificationNode() ||
+                         _ast->containsTraversal())) {
+      // only the plans of simple read-only queries are cached
+      usePlanCache = false;
+      planCacheKey.reset();
+    }
+    if (usePlanCache && !runtimeBindParameters.has_value()) {
+      // first compilation of the query
+      runtimeBindParameters = _ast->runtimeBindParameters();
+      planCacheKey = QueryPlanCache::buildPlanKey(_bindParameters,
+                                                  *runtimeBindParameters);
+    }
+
+    // put in bind parameters. bind parameters evaluated at runtime are only
+    // used if the plan can be cached
+    parser.ast()->injectBindParameters(
+        _bindParameters, this->resolver(),
+        planCacheKey.has_value() ? *runtimeBindParameters
+                                 : std::unordered_set<std::string>{});
+  }
 
-  if (parser.ast()->containsUpsertNode()) {
+  if (_ast->containsUpsertNode()) {
     // UPSERTs and intermediate commits do not play nice together, because the
     // intermediate commit invalidates the read-own-write iterator required by
     // the subquery. Setting intermediateCommitSize and intermediateCommitCount
@@ -438,6 +523,23 @@ std::unique_ptr<ExecutionPlan> Query::preparePlan() {
   // As soon as we start to instantiate the plan we have to clean it
   // up before killing the unique_ptr
 
+  if (cachedPlan != nullptr) {
+    enterState(QueryExecutionState::ValueType::LOADING_COLLECTIONS);
+
+    Result res = _trx->begin();
+    if (!res.ok()) {
+      THROW_ARANGO_EXCEPTION(res);
+    }
+    TRI_ASSERT(_trx->status() == transaction::Status::RUNNING);
+
+    enterState(QueryExecutionState::ValueType::PLAN_INSTANTIATION);
+
+    auto plan = ExecutionPlan::instantiateFromVelocyPack(
+        _ast.get(), cachedPlan->plan->slice());
+    TRI_ASSERT(plan != nullptr);
+    return plan;
+  }
+
   // we have an AST, optimize the ast
   enterState(QueryExecutionState::ValueType::AST_OPTIMIZATION);
 
@@ -469,6 +571,25 @@ std::unique_ptr<ExecutionPlan> Query::preparePlan() {
 
   TRI_ASSERT(plan != nullptr);
 
+  if (planCacheKey.has_value() && canStorePlanInCache(*plan)) {
+    plan->findVarUsage();
+    auto serialized = std::make_shared<VPackBuilder>();
+    plan->toVelocyPack(*serialized, _ast.get(),
+                       ExecutionNode::SERIALIZE_DETAILS);
+    auto cached = std::make_shared<QueryPlanCache::CachedPlan>();
+    cached->plan = std::move(serialized);
+    // injecting the bind parameters has made sure that exactly the declared
+    // bind parameters were passed
+    _bindParameters.visit([&](std::string const& key, VPackSlice /*value*/,
+                              AstNode* /*node*/) {
+      cached->bindParameters.emplace(key);
+    });
+    cached->containsParallelNode = _ast->canApplyParallelism();
+    QueryPlanCache::instance()->store(
+        &_vocbase, planCacheGeneration, planCacheQueryKey,
+        std::move(*runtimeBindParameters), *planCacheKey, std::move(cached));
+  }
+
   // return the V8 context if we are in one
   exitV8Context();
 
@@ -619,6 +740,11 @@ ExecutionState Query::execute(QueryResult& queryResult) {
               hash(), _queryString, queryResult.data, bindParameters(),
               std::move(dataSources)  // query DataSources
           );
+          if (QueryCache::instance()->incremental() &&
+              _cacheEntry->_dataSources.size() == 1) {
+            _cacheEntry->_updater = QueryCacheUpdater::fromAst(*_ast);
+            _cacheEntry->_snapshotTick = _trx->state()->snapshotTick();
+          }
         }
 
         queryResult.context = _trx->transactionContext();
@@ -868,6 +994,11 @@ QueryResultV8 Query::executeV8(v8::Isolate* isolate) {
           hash(), _queryString, builder, bindParameters(),
           std::move(dataSources)  // query DataSources
       );
+      if (QueryCache::instance()->incremental() &&
+          _cacheEntry->_dataSources.size() == 1) {
+        _cacheEntry->_updater = QueryCacheUpdater::fromAst(*_ast);
+        _cacheEntry->_snapshotTick = _trx->state()->snapshotTick();
+      }
     }
 
     ss->resetWakeupHandler();
@@ -939,6 +1070,7 @@ ExecutionState Query::finalize(VPackBuilder& extras) {
     _execStats.requests += _numRequests.load(std::memory_order_relaxed);
     _execStats.setPeakMemoryUsage(_resourceMonitor.peak());
     _execStats.setExecutionTime(executionTime());
+    _execStats.cpuTime += _sharedState->cpuTime() / 1000000.0;
     _execStats.setIntermediateCommits(_trx->state()->numIntermediateCommits());
     for (auto& engine : _snippets) {
       engine->collectExecutionStats(_execStats);
@@ -1446,6 +1578,67 @@ bool Query::canUseQueryCache() const {
   return false;
 }
 
+/// @brief whether or not the query plan cache can be used for the query
+bool Query::canUsePlanCache() const {
+  if (!_queryOptions.usePlanCache || _queryString.empty()) {
+    return false;
+  }
+#ifdef USE_ENTERPRISE
+  if (_queryOptions.transactionOptions.skipInaccessibleCollections) {
+    // the plan depends on the permissions of the current user
+    return false;
+  }
+#endif
+  // cannot use the plan cache on a coordinator at the moment
+  return !ServerState::instance()->isRunningInCluster();
+}
+
+/// @brief whether or not the optimized plan can be stored in the query plan
+/// cache
+bool Query::canStorePlanInCache(ExecutionPlan const& plan) const {
+  if (_ast->willUseV8() || _ast->functionsMayAccessDocuments()) {
+    // the AST is not rebuilt when the plan is reused, so the properties of
+    // the AST must not be needed later on
+    return false;
+  }
+  if (!_warnings.empty()) {
+    // the warnings of the optimizer would be lost when the plan is reused
+    return false;
+  }
+  for (auto type : {ExecutionNode::TRAVERSAL, ExecutionNode::SHORTEST_PATH,
+                    ExecutionNode::ENUMERATE_PATHS,
+                    ExecutionNode::ENUMERATE_IRESEARCH_VIEW}) {
+    if (plan.contains(type)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/// @brief build the key of the query in the query plan cache, from the
+/// query string and the options that influence the plan
+std::string Query::buildPlanCacheQueryKey() const {
+  VPackBuilder builder;
+  builder.openObject();
+  builder.add("fullCount", VPackValue(_queryOptions.fullCount));
+  builder.add("count", VPackValue(_queryOptions.count));
+  builder.add("maxNumberOfPlans", VPackValue(_queryOptions.maxNumberOfPlans));
+  builder.add("maxDNFConditionMembers",
+              VPackValue(_queryOptions.maxDNFConditionMembers));
+  builder.add(VPackValue("rules"));
+  builder.openArray();
+  for (auto const& rule : _queryOptions.optimizerRules) {
+    builder.add(VPackValue(rule));
+  }
+  builder.close();
+  builder.close();
+
+  std::string key = builder.slice().toJson();
+  key.push_back('\n');
+  key.append(_queryString.data(), _queryString.size());
+  return key;
+}
+
 ErrorCode Query::resultCode() const noexcept {
   // never return negative value from here
   return _resultCode.value_or(TRI_ERROR_NO_ERROR);
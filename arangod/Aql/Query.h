@@ -111,6 +111,8 @@ class Query : public QueryContext, public std::enable_shared_from_this<Query> {
   /// @brief whether or not the query is killed
   bool killed() const final;
 
+  velocypack::Slice bindParameterValue(std::string_view name) const final;
+
   /// @brief set the query to killed
   void kill();
 
@@ -202,6 +204,9 @@ class Query : public QueryContext, public std::enable_shared_from_this<Query> {
 
   void addIntermediateCommits(uint64_t value);
 
+  /// @brief the query's profile. can be a nullptr
+  QueryProfile* profile() const noexcept { return _queryProfile.get(); }
+
 #ifdef ARANGODB_USE_GOOGLE_TESTS
   ExecutionPlan* plan() const {
     if (_plans.size() == 1) {
@@ -261,6 +266,16 @@ class Query : public QueryContext, public std::enable_shared_from_this<Query> {
   /// @brief whether or not the query cache can be used for the query
   bool canUseQueryCache() const;
 
+  /// @brief whether or not the query plan cache can be used for the query
+  bool canUsePlanCache() const;
+
+  /// @brief whether or not the optimized plan can be stored in the query
+  /// plan cache
+  bool canStorePlanInCache(ExecutionPlan const& plan) const;
+
+  /// @brief build the key of the query in the query plan cache
+  std::string buildPlanCacheQueryKey() const;
+
   /// @brief enter a new state
   void enterState(QueryExecutionState::ValueType);
 
@@ -63,6 +63,11 @@ static std::atomic<size_t> maxEntrySize(
 static std::atomic<bool> includeSystem(
     false);  // default value. can be changed later
 
+/// @brief whether or not to update the results of simple queries with the
+/// changes of transactions, instead of invalidating them
+static std::atomic<bool> incremental(
+    false);  // default value. can be changed later
+
 /// @brief whether or not the query cache will return bind vars in its list of
 /// cached results
 static bool showBindVars =
@@ -80,6 +85,7 @@ QueryCacheResultEntry::QueryCacheResultEntry(
       _queryResult(queryResult),
       _bindVars(bindVars),
       _dataSources(std::move(dataSources)),
+      _snapshotTick(0),
       _size(_queryString.size()),
       _rows(0),
       _hits(0),
@@ -356,6 +362,84 @@ void QueryCacheDatabaseEntry::invalidate(std::string const& dataSourceGuid) {
   _entriesByDataSourceGuid.erase(itr);
 }
 
+/// @brief apply the changes of a transaction to all entries for a data source
+/// in the database-specific cache. entries that cannot be updated are
+/// invalidated
+void QueryCacheDatabaseEntry::update(std::string const& dataSourceGuid,
+                                     QueryCacheChanges::Collection* changes,
+                                     TRI_voc_tick_t commitTick,
+                                     size_t allowedMaxEntrySize,
+                                     size_t allowedMaxResultsCount,
+                                     size_t allowedMaxResultsSize) {
+  if (changes == nullptr || !changes->complete()) {
+    invalidate(dataSourceGuid);
+    return;
+  }
+
+  auto itr = _entriesByDataSourceGuid.find(dataSourceGuid);
+
+  if (itr == _entriesByDataSourceGuid.end()) {
+    return;
+  }
+
+  VPackSlice changed = changes->changes();
+  // copy the hashes, as the entries are replaced while iterating
+  std::vector<uint64_t> hashes(itr->second.second.begin(),
+                               itr->second.second.end());
+
+  for (auto const& hash : hashes) {
+    auto it = _entriesByHash.find(hash);
+
+    if (it == _entriesByHash.end()) {
+      continue;
+    }
+
+    auto entry = (*it).second;
+    if (entry->_updater != nullptr && commitTick != 0 &&
+        entry->_snapshotTick >= commitTick) {
+      // the result was computed from a snapshot that already contains the
+      // changes, applying them again would duplicate them
+      continue;
+    }
+
+    std::shared_ptr<VPackBuilder> result;
+    if (entry->_updater != nullptr && entry->_dataSources.size() == 1 &&
+        entry->_snapshotTick != 0 && commitTick != 0) {
+      // without the ticks, we cannot tell whether the result already
+      // contains the changes, so the entry is invalidated
+      result = entry->_updater->apply(entry->_queryResult->slice(), changed);
+    }
+
+    removeDatasources(entry.get());
+    unlink(entry.get());
+    _entriesByHash.erase(it);
+
+    if (result == nullptr) {
+      // the entry could not be updated, so it stays invalidated
+      continue;
+    }
+
+    auto updated = std::make_shared<QueryCacheResultEntry>(
+        hash, QueryString(entry->_queryString), std::move(result),
+        entry->_bindVars,
+        std::unordered_map<std::string, std::string>(entry->_dataSources));
+    if (allowedMaxResultsCount == 0 ||
+        updated->_size > allowedMaxEntrySize ||
+        updated->_size > allowedMaxResultsSize) {
+      continue;
+    }
+    updated->_stats = entry->_stats;
+    updated->_updater = entry->_updater;
+    // the result now also contains the changes of this commit, but maybe
+    // not yet the ones of other transactions that committed earlier and are
+    // still to be applied. so the snapshot stays the same
+    updated->_snapshotTick = entry->_snapshotTick;
+    updated->_hits.store(entry->_hits.load());
+    updated->_stamp = entry->_stamp;
+    store(std::move(updated), allowedMaxResultsCount, allowedMaxResultsSize);
+  }
+}
+
 /// @brief enforce maximum number of results
 /// must be called under the shard's lock
 void QueryCacheDatabaseEntry::enforceMaxResults(size_t numResults,
@@ -496,6 +580,7 @@ void QueryCache::toVelocyPack(VPackBuilder& builder) const {
   builder.add("maxResultsSize", VPackValue(::maxResultsSize.load()));
   builder.add("maxEntrySize", VPackValue(::maxEntrySize.load()));
   builder.add("includeSystem", VPackValue(::includeSystem.load()));
+  builder.add("incremental", VPackValue(::incremental.load()));
   builder.close();
 }
 
@@ -505,7 +590,8 @@ QueryCacheProperties QueryCache::properties() const {
 
   return QueryCacheProperties{::mode.load(),           ::maxResultsCount.load(),
                               ::maxResultsSize.load(), ::maxEntrySize.load(),
-                              ::includeSystem.load(),  ::showBindVars};
+                              ::includeSystem.load(),  ::incremental.load(),
+                              ::showBindVars};
 }
 
 /// @brief set the cache properties
@@ -516,6 +602,7 @@ void QueryCache::properties(QueryCacheProperties const& properties) {
   setMaxResults(properties.maxResultsCount, properties.maxResultsSize);
   setMaxEntrySize(properties.maxEntrySize);
   setIncludeSystem(properties.includeSystem);
+  ::incremental.store(properties.incremental);
   ::showBindVars = properties.showBindVars;
 }
 
@@ -533,6 +620,7 @@ void QueryCache::properties(VPackSlice const& properties) {
   auto maxResultsSize = ::maxResultsSize.load();
   auto maxEntrySize = ::maxEntrySize.load();
   auto includeSystem = ::includeSystem.load();
+  auto incremental = ::incremental.load();
 
   VPackSlice v = properties.get("mode");
   if (v.isString()) {
@@ -574,10 +662,16 @@ void QueryCache::properties(VPackSlice const& properties) {
     includeSystem = v.getBoolean();
   }
 
+  v = properties.get("incremental");
+  if (v.isBoolean()) {
+    incremental = v.getBoolean();
+  }
+
   setMode(mode);
   setMaxResults(maxResultsCount, maxResultsSize);
   setMaxEntrySize(maxEntrySize);
   setIncludeSystem(includeSystem);
+  ::incremental.store(incremental);
 }
 
 /// @brief test whether the cache might be active
@@ -590,6 +684,12 @@ QueryCacheMode QueryCache::mode() const {
   return ::mode.load(std::memory_order_relaxed);
 }
 
+/// @brief return whether or not cached results of simple queries are updated
+/// with the changes of transactions instead of being invalidated
+bool QueryCache::incremental() const {
+  return ::incremental.load(std::memory_order_relaxed);
+}
+
 /// @brief return a string version of the mode
 std::string QueryCache::modeString(QueryCacheMode mode) {
   switch (mode) {
@@ -721,6 +821,34 @@ void QueryCache::invalidate(TRI_vocbase_t* vocbase,
   it->second->invalidate(dataSourceGuid);
 }
 
+/// @brief update all queries for the given data sources with the changes of
+/// a committed transaction
+void QueryCache::update(TRI_vocbase_t* vocbase,
+                        std::vector<std::string> const& dataSourceGuids,
+                        QueryCacheChanges& changes,
+                        TRI_voc_tick_t commitTick) {
+  size_t const allowedMaxEntrySize = ::maxEntrySize.load();
+  size_t const allowedMaxResultsCount = ::maxResultsCount.load();
+  size_t const allowedMaxResultsSize = ::maxResultsSize.load();
+
+  auto const part = getPart(vocbase);
+  WRITE_LOCKER(writeLocker, _entriesLock[part]);
+
+  auto& entry = _entries[part];
+  auto it = entry.find(vocbase);
+
+  if (it == entry.end()) {
+    return;
+  }
+
+  // update while holding the lock
+  for (auto const& guid : dataSourceGuids) {
+    it->second->update(guid, changes.find(guid), commitTick,
+                       allowedMaxEntrySize, allowedMaxResultsCount,
+                       allowedMaxResultsSize);
+  }
+}
+
 /// @brief invalidate all queries for a particular database
 void QueryCache::invalidate(TRI_vocbase_t* vocbase) {
   std::unique_ptr<QueryCacheDatabaseEntry> databaseQueryCache;
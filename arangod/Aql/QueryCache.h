@@ -29,9 +29,11 @@
 #include <unordered_set>
 #include <vector>
 
+#include "Aql/QueryCacheUpdater.h"
 #include "Aql/QueryString.h"
 #include "Basics/Common.h"
 #include "Basics/ReadWriteLock.h"
+#include "VocBase/voc-types.h"
 
 struct TRI_vocbase_t;
 
@@ -57,6 +59,7 @@ struct QueryCacheProperties {
   uint64_t maxResultsSize;
   uint64_t maxEntrySize;
   bool includeSystem;
+  bool incremental;
   bool showBindVars;
 };
 
@@ -78,6 +81,12 @@ struct QueryCacheResultEntry {
   // stores datasource guid -> datasource name
   std::unordered_map<std::string, std::string> const _dataSources;
   std::shared_ptr<arangodb::velocypack::Builder> _stats;
+  // patches the result with the changes of committed transactions. only set
+  // for simple queries on a single collection
+  std::shared_ptr<QueryCacheUpdater const> _updater;
+  // the result contains all changes committed up to this tick. 0 if unknown.
+  // only set if there is an updater
+  TRI_voc_tick_t _snapshotTick;
   size_t _size;
   size_t _rows;
   std::atomic<uint64_t> _hits;
@@ -121,6 +130,14 @@ struct QueryCacheDatabaseEntry {
   /// database-specific cache
   void invalidate(std::string const& dataSourceGuid);
 
+  /// @brief apply the changes of a transaction to all entries for a data
+  /// source in the database-specific cache. entries that cannot be updated
+  /// are invalidated
+  void update(std::string const& dataSourceGuid,
+              QueryCacheChanges::Collection* changes, TRI_voc_tick_t commitTick,
+              size_t allowedMaxEntrySize, size_t allowedMaxResultsCount,
+              size_t allowedMaxResultsSize);
+
   void queriesToVelocyPack(arangodb::velocypack::Builder& builder) const;
 
   /// @brief enforce maximum number of results
@@ -200,6 +217,10 @@ class QueryCache {
   /// @brief return whether or not the query cache is enabled
   QueryCacheMode mode() const;
 
+  /// @brief return whether or not cached results of simple queries are
+  /// updated with the changes of transactions instead of being invalidated
+  bool incremental() const;
+
   /// @brief return a string version of the mode
   static std::string modeString(QueryCacheMode);
 
@@ -222,6 +243,12 @@ class QueryCache {
   /// @brief invalidate all queries for a particular data source
   void invalidate(TRI_vocbase_t* vocbase, std::string const& dataSourceGuid);
 
+  /// @brief update all queries for the given data sources with the changes
+  /// of a transaction committed at the given tick
+  void update(TRI_vocbase_t* vocbase,
+              std::vector<std::string> const& dataSourceGuids,
+              QueryCacheChanges& changes, TRI_voc_tick_t commitTick);
+
   /// @brief invalidate all queries for a particular database
   void invalidate(TRI_vocbase_t* vocbase);
 
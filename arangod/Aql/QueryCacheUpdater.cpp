@@ -0,0 +1,466 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "QueryCacheUpdater.h"
+#include "Aql/Ast.h"
+#include "Aql/AstNode.h"
+#include "Aql/Variable.h"
+#include "Basics/AttributeNameParser.h"
+#include "Basics/StaticStrings.h"
+#include "Basics/VelocyPackHelper.h"
+#include "Basics/debugging.h"
+
+#include <velocypack/Iterator.h>
+
+#include <algorithm>
+#include <optional>
+#include <unordered_set>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+namespace {
+
+/// @brief the value of the attribute in the document, null if the document
+/// does not have the attribute
+VPackSlice attributeValue(VPackSlice document,
+                          std::vector<std::string> const& attribute) {
+  VPackSlice value = document;
+  for (auto const& name : attribute) {
+    if (!value.isObject()) {
+      return VPackSlice::nullSlice();
+    }
+    value = value.get(name);
+  }
+  return value.isNone() ? VPackSlice::nullSlice() : value;
+}
+
+bool isEqual(VPackSlice lhs, VPackSlice rhs) {
+  return basics::VelocyPackHelper::compare(lhs, rhs, true) == 0;
+}
+
+bool isContained(VPackSlice value, VPackSlice values) {
+  TRI_ASSERT(values.isArray());
+  for (VPackSlice it : VPackArrayIterator(values)) {
+    if (isEqual(value, it)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+std::optional<QueryCacheUpdater::Comparison> toComparison(AstNodeType type) {
+  using Comparison = QueryCacheUpdater::Comparison;
+  switch (type) {
+    case NODE_TYPE_OPERATOR_BINARY_EQ:
+      return Comparison::Equal;
+    case NODE_TYPE_OPERATOR_BINARY_NE:
+      return Comparison::NotEqual;
+    case NODE_TYPE_OPERATOR_BINARY_LT:
+      return Comparison::Less;
+    case NODE_TYPE_OPERATOR_BINARY_LE:
+      return Comparison::LessEqual;
+    case NODE_TYPE_OPERATOR_BINARY_GT:
+      return Comparison::Greater;
+    case NODE_TYPE_OPERATOR_BINARY_GE:
+      return Comparison::GreaterEqual;
+    case NODE_TYPE_OPERATOR_BINARY_IN:
+      return Comparison::In;
+    case NODE_TYPE_OPERATOR_BINARY_NIN:
+      return Comparison::NotIn;
+    default:
+      return std::nullopt;
+  }
+}
+
+/// @brief the attribute path of an attribute access on the variable
+std::optional<std::vector<std::string>> attributePath(
+    AstNode const* node, Variable const* variable) {
+  std::pair<Variable const*, std::vector<basics::AttributeName>> result;
+  if (!node->isAttributeAccessForVariable(result, false) ||
+      result.first != variable || result.second.empty()) {
+    return std::nullopt;
+  }
+
+  std::vector<std::string> path;
+  path.reserve(result.second.size());
+  for (auto const& it : result.second) {
+    if (it.shouldExpand) {
+      return std::nullopt;
+    }
+    path.emplace_back(it.name);
+  }
+  if (path.front() == StaticStrings::IdString) {
+    // _id is not stored as a string in the documents
+    return std::nullopt;
+  }
+  return path;
+}
+
+/// @brief collect the conditions of a filter expression. returns false if
+/// the expression contains something else than a conjunction of comparisons
+/// of attributes with constant values
+bool addConditions(AstNode const* node, Variable const* variable,
+                   std::vector<QueryCacheUpdater::Condition>& conditions) {
+  if (node->type == NODE_TYPE_OPERATOR_BINARY_AND ||
+      node->type == NODE_TYPE_OPERATOR_NARY_AND) {
+    for (size_t i = 0; i < node->numMembers(); ++i) {
+      if (!addConditions(node->getMemberUnchecked(i), variable, conditions)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  if (!toComparison(node->type).has_value() || node->numMembers() != 2) {
+    return false;
+  }
+
+  AstNodeType type = node->type;
+  AstNode const* lhs = node->getMemberUnchecked(0);
+  AstNode const* rhs = node->getMemberUnchecked(1);
+  if (!lhs->isAttributeAccessForVariable(variable, false)) {
+    // e.g. 5 < doc.value
+    if (type == NODE_TYPE_OPERATOR_BINARY_IN ||
+        type == NODE_TYPE_OPERATOR_BINARY_NIN) {
+      return false;
+    }
+    std::swap(lhs, rhs);
+    if (type != NODE_TYPE_OPERATOR_BINARY_NE) {
+      type = Ast::ReversedOperators.at(static_cast<int>(type));
+    }
+  }
+
+  auto attribute = ::attributePath(lhs, variable);
+  if (!attribute.has_value() || !rhs->isConstant()) {
+    return false;
+  }
+
+  auto& condition = conditions.emplace_back();
+  condition.attribute = std::move(attribute.value());
+  condition.comparison = toComparison(type).value();
+  rhs->toVelocyPackValue(condition.value);
+  return true;
+}
+
+}  // namespace
+
+QueryCacheChanges::Collection::Collection()
+    : _numberChanges(0), _complete(true) {
+  _changes.openArray();
+}
+
+void QueryCacheChanges::Collection::add(VPackSlice oldDocument,
+                                        VPackSlice newDocument,
+                                        velocypack::Options const* options) {
+  if (!_complete) {
+    return;
+  }
+  TRI_ASSERT(_changes.isOpenArray());
+
+  if (_numberChanges >= maxChanges ||
+      _changes.size() + oldDocument.byteSize() + newDocument.byteSize() >
+          maxSize) {
+    // too many changes. invalidating the cache entries is cheaper
+    abandon();
+    return;
+  }
+
+  // the documents are compared with and appended to cached query results,
+  // which do not contain custom types
+  auto addDocument = [&](VPackSlice document) {
+    if (document.isNone()) {
+      _changes.add(VPackSlice::nullSlice());
+    } else {
+      basics::VelocyPackHelper::sanitizeNonClientTypes(
+          document, VPackSlice::noneSlice(), _changes, options,
+          /*sanitizeExternals*/ true, /*sanitizeCustom*/ true);
+    }
+  };
+
+  _changes.openArray();
+  addDocument(oldDocument);
+  addDocument(newDocument);
+  _changes.close();
+  ++_numberChanges;
+}
+
+void QueryCacheChanges::Collection::abandon() noexcept {
+  _complete = false;
+  // free the memory of the recorded changes
+  _changes = velocypack::Builder();
+}
+
+VPackSlice QueryCacheChanges::Collection::changes() {
+  TRI_ASSERT(_complete);
+  if (_changes.isOpenArray()) {
+    _changes.close();
+  }
+  return _changes.slice();
+}
+
+void QueryCacheChanges::Collection::clear() {
+  if (!_complete) {
+    // e.g. a truncate may still be ongoing after an intermediate commit
+    return;
+  }
+  _changes.clear();
+  _changes.openArray();
+  _numberChanges = 0;
+}
+
+QueryCacheChanges::Collection& QueryCacheChanges::collection(
+    std::string const& guid) {
+  return _collections[guid];
+}
+
+QueryCacheChanges::Collection* QueryCacheChanges::find(
+    std::string const& guid) {
+  auto it = _collections.find(guid);
+  if (it == _collections.end()) {
+    return nullptr;
+  }
+  return &it->second;
+}
+
+void QueryCacheChanges::clear() {
+  // the collections are kept, as the transaction's operations still refer
+  // to them
+  for (auto& it : _collections) {
+    it.second.clear();
+  }
+}
+
+QueryCacheUpdater::QueryCacheUpdater(std::vector<Condition> conditions,
+                                     Projection projection)
+    : _conditions(std::move(conditions)), _projection(std::move(projection)) {
+  TRI_ASSERT(_projection.type != ProjectionType::Attribute ||
+             _projection.attributes.size() == 1);
+}
+
+std::shared_ptr<QueryCacheUpdater const> QueryCacheUpdater::fromAst(
+    Ast const& ast) {
+  AstNode const* root = ast.root();
+  if (root == nullptr || root->type != NODE_TYPE_ROOT ||
+      root->numMembers() < 2) {
+    return nullptr;
+  }
+
+  // FOR doc IN collection, without any options
+  AstNode const* loop = root->getMemberUnchecked(0);
+  if (loop->type != NODE_TYPE_FOR || loop->numMembers() != 3 ||
+      loop->getMemberUnchecked(1)->type != NODE_TYPE_COLLECTION ||
+      loop->getMemberUnchecked(2)->type != NODE_TYPE_NOP) {
+    return nullptr;
+  }
+  auto const* variable =
+      static_cast<Variable const*>(loop->getMemberUnchecked(0)->getData());
+  TRI_ASSERT(variable != nullptr);
+
+  std::vector<Condition> conditions;
+  size_t const n = root->numMembers();
+  for (size_t i = 1; i < n - 1; ++i) {
+    AstNode const* filter = root->getMemberUnchecked(i);
+    if (filter->type != NODE_TYPE_FILTER ||
+        !::addConditions(filter->getMember(0), variable, conditions)) {
+      return nullptr;
+    }
+  }
+
+  AstNode const* ret = root->getMemberUnchecked(n - 1);
+  if (ret->type != NODE_TYPE_RETURN) {
+    return nullptr;
+  }
+
+  Projection projection;
+  AstNode const* expression = ret->getMember(0);
+  if (expression->type == NODE_TYPE_REFERENCE) {
+    if (expression->getData() != variable) {
+      return nullptr;
+    }
+    projection.type = ProjectionType::Document;
+  } else if (expression->type == NODE_TYPE_OBJECT) {
+    projection.type = ProjectionType::Object;
+    std::unordered_set<std::string_view> names;
+    for (size_t i = 0; i < expression->numMembers(); ++i) {
+      AstNode const* element = expression->getMemberUnchecked(i);
+      if (element->type != NODE_TYPE_OBJECT_ELEMENT) {
+        // e.g. a calculated attribute name
+        return nullptr;
+      }
+      auto attribute = ::attributePath(element->getMember(0), variable);
+      if (!attribute.has_value() ||
+          !names.emplace(element->getStringView()).second) {
+        return nullptr;
+      }
+      projection.attributes.emplace_back(element->getString(),
+                                         std::move(attribute.value()));
+    }
+  } else {
+    auto attribute = ::attributePath(expression, variable);
+    if (!attribute.has_value()) {
+      return nullptr;
+    }
+    projection.type = ProjectionType::Attribute;
+    projection.attributes.emplace_back(std::string(),
+                                       std::move(attribute.value()));
+  }
+
+  return std::make_shared<QueryCacheUpdater const>(std::move(conditions),
+                                                   std::move(projection));
+}
+
+bool QueryCacheUpdater::matches(VPackSlice document) const {
+  for (auto const& condition : _conditions) {
+    VPackSlice value = ::attributeValue(document, condition.attribute);
+    VPackSlice other = condition.value.slice();
+
+    bool result;
+    switch (condition.comparison) {
+      case Comparison::Equal:
+        result = ::isEqual(value, other);
+        break;
+      case Comparison::NotEqual:
+        result = !::isEqual(value, other);
+        break;
+      case Comparison::Less:
+        result = basics::VelocyPackHelper::compare(value, other, true) < 0;
+        break;
+      case Comparison::LessEqual:
+        result = basics::VelocyPackHelper::compare(value, other, true) <= 0;
+        break;
+      case Comparison::Greater:
+        result = basics::VelocyPackHelper::compare(value, other, true) > 0;
+        break;
+      case Comparison::GreaterEqual:
+        result = basics::VelocyPackHelper::compare(value, other, true) >= 0;
+        break;
+      case Comparison::In:
+        result = other.isArray() && ::isContained(value, other);
+        break;
+      case Comparison::NotIn:
+        result = !other.isArray() || !::isContained(value, other);
+        break;
+    }
+    if (!result) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void QueryCacheUpdater::project(VPackSlice document,
+                                VPackBuilder& builder) const {
+  switch (_projection.type) {
+    case ProjectionType::Document:
+      builder.add(document);
+      break;
+    case ProjectionType::Attribute:
+      builder.add(
+          ::attributeValue(document, _projection.attributes.front().second));
+      break;
+    case ProjectionType::Object:
+      builder.openObject();
+      for (auto const& [name, attribute] : _projection.attributes) {
+        builder.add(name, ::attributeValue(document, attribute));
+      }
+      builder.close();
+      break;
+  }
+}
+
+bool QueryCacheUpdater::isResultFor(VPackSlice row, VPackSlice document,
+                                    VPackSlice projected) const {
+  if (_projection.type == ProjectionType::Document) {
+    // the revision identifies the version of the document
+    return row.isObject() &&
+           row.get(StaticStrings::KeyString)
+               .binaryEquals(document.get(StaticStrings::KeyString)) &&
+           row.get(StaticStrings::RevString)
+               .binaryEquals(document.get(StaticStrings::RevString));
+  }
+  // results of different documents may be equal. they are interchangeable
+  return basics::VelocyPackHelper::equal(row, projected, false);
+}
+
+std::shared_ptr<VPackBuilder> QueryCacheUpdater::apply(
+    VPackSlice result, VPackSlice changes) const {
+  if (!result.isArray() || !changes.isArray()) {
+    return nullptr;
+  }
+
+  try {
+    std::vector<VPackSlice> rows;
+    rows.reserve(result.length());
+    for (VPackSlice row : VPackArrayIterator(result)) {
+      rows.push_back(row);
+    }
+
+    // the results of new documents, referred to by rows
+    std::vector<std::unique_ptr<VPackBuilder>> added;
+    VPackBuilder projected;
+
+    for (VPackSlice change : VPackArrayIterator(changes)) {
+      VPackSlice oldDocument = change.at(0);
+      VPackSlice newDocument = change.at(1);
+
+      if (oldDocument.isObject() && matches(oldDocument)) {
+        projected.clear();
+        project(oldDocument, projected);
+        auto it = std::find_if(rows.begin(), rows.end(), [&](VPackSlice row) {
+          return isResultFor(row, oldDocument, projected.slice());
+        });
+        if (it == rows.end()) {
+          // the cached result was not computed from the version of the
+          // document that was modified
+          return nullptr;
+        }
+        rows.erase(it);
+      }
+
+      if (newDocument.isObject() && matches(newDocument)) {
+        if (_projection.type == ProjectionType::Document &&
+            std::any_of(rows.begin(), rows.end(), [&](VPackSlice row) {
+              return row.isObject() &&
+                     row.get(StaticStrings::KeyString)
+                         .binaryEquals(
+                             newDocument.get(StaticStrings::KeyString));
+            })) {
+          // the cached result was computed after the change already
+          return nullptr;
+        }
+        auto& builder = added.emplace_back(std::make_unique<VPackBuilder>());
+        project(newDocument, *builder);
+        rows.push_back(builder->slice());
+      }
+    }
+
+    auto builder = std::make_shared<VPackBuilder>();
+    builder->openArray();
+    for (VPackSlice row : rows) {
+      builder->add(row);
+    }
+    builder->close();
+    return builder;
+  } catch (...) {
+    return nullptr;
+  }
+}
@@ -0,0 +1,164 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <velocypack/Builder.h>
+#include <velocypack/Slice.h>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace arangodb {
+namespace aql {
+class Ast;
+
+/// @brief document changes of a transaction, recorded for incrementally
+/// maintaining the query cache entries of the modified collections when the
+/// transaction commits
+class QueryCacheChanges {
+ public:
+  /// @brief maximum number of changes recorded per collection. if a
+  /// transaction changes more documents, the query cache entries of the
+  /// collection are invalidated instead
+  static constexpr size_t maxChanges = 1024;
+
+  /// @brief maximum size of the changes recorded per collection
+  static constexpr size_t maxSize = 4 * 1024 * 1024;
+
+  /// @brief the changes of a single collection
+  class Collection {
+   public:
+    Collection();
+
+    /// @brief record a change. the old version is none for inserts, and the
+    /// new version is none for removals. the documents are stored without
+    /// custom types (i.e. with resolved _id values), as in query results
+    void add(velocypack::Slice oldDocument, velocypack::Slice newDocument,
+             velocypack::Options const* options);
+
+    /// @brief stop recording, because the collection was modified in a way
+    /// that is not recorded, e.g. by a truncate. recording is not resumed
+    /// for the rest of the transaction
+    void abandon() noexcept;
+
+    /// @brief whether or not all changes have been recorded
+    bool complete() const noexcept { return _complete; }
+
+    /// @brief the changes, as an array of [old, new] pairs. missing
+    /// versions are null. no more changes can be added afterwards, until
+    /// the changes are cleared
+    velocypack::Slice changes();
+
+    /// @brief remove the recorded changes, after they have been applied by
+    /// an intermediate commit
+    void clear();
+
+   private:
+    velocypack::Builder _changes;
+    size_t _numberChanges;
+    bool _complete;
+  };
+
+  /// @brief the changes of the collection with the given guid
+  Collection& collection(std::string const& guid);
+
+  /// @brief the changes of the collection with the given guid, or a nullptr
+  /// if none were recorded
+  Collection* find(std::string const& guid);
+
+  /// @brief remove the recorded changes of all collections
+  void clear();
+
+ private:
+  std::unordered_map<std::string, Collection> _collections;
+};
+
+/// @brief patches the cached result of a simple query with the changes to
+/// its collection, instead of invalidating it. supported are queries of the
+/// form `FOR doc IN collection FILTER ... RETURN ...`, with filter
+/// conditions that compare attributes of the document with constant values,
+/// and that return the document, one of its attributes or an object made of
+/// its attributes. as such queries do not guarantee any order of their
+/// results, new results are appended to the cached result
+class QueryCacheUpdater {
+ public:
+  enum class Comparison {
+    Equal,
+    NotEqual,
+    Less,
+    LessEqual,
+    Greater,
+    GreaterEqual,
+    In,
+    NotIn
+  };
+
+  /// @brief a comparison of an attribute of the document with a value
+  struct Condition {
+    std::vector<std::string> attribute;
+    Comparison comparison;
+    velocypack::Builder value;
+  };
+
+  enum class ProjectionType { Document, Attribute, Object };
+
+  /// @brief what the query returns for a document. for attribute
+  /// projections, the only attribute has an empty name
+  struct Projection {
+    ProjectionType type = ProjectionType::Document;
+    std::vector<std::pair<std::string, std::vector<std::string>>> attributes;
+  };
+
+  QueryCacheUpdater(std::vector<Condition> conditions, Projection projection);
+
+  /// @brief creates an updater for the query, or a nullptr if the query
+  /// is not simple enough. must be called with the injected bind parameters
+  static std::shared_ptr<QueryCacheUpdater const> fromAst(Ast const& ast);
+
+  /// @brief whether or not the document passes all filter conditions
+  bool matches(velocypack::Slice document) const;
+
+  /// @brief add the query result for the document to the builder
+  void project(velocypack::Slice document, velocypack::Builder& builder) const;
+
+  /// @brief apply the recorded changes to the cached result. returns a
+  /// nullptr if the result cannot be updated, so that the cache entry must
+  /// be invalidated
+  std::shared_ptr<velocypack::Builder> apply(velocypack::Slice result,
+                                             velocypack::Slice changes) const;
+
+ private:
+  /// @brief whether or not the cached row is the result for the document,
+  /// whose result is projected
+  bool isResultFor(velocypack::Slice row, velocypack::Slice document,
+                   velocypack::Slice projected) const;
+
+  std::vector<Condition> _conditions;
+  Projection _projection;
+};
+
+}  // namespace aql
+}  // namespace arangodb
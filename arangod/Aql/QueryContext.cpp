@@ -41,6 +41,8 @@
 #include "VocBase/ticks.h"
 #include "VocBase/vocbase.h"
 
+#include <velocypack/Slice.h>
+
 using namespace arangodb;
 using namespace arangodb::aql;
 
@@ -127,6 +129,11 @@ void QueryContext::addDataSource(  // track DataSource
 
 aql::Ast* QueryContext::ast() { return _ast.get(); }
 
+velocypack::Slice QueryContext::bindParameterValue(
+    std::string_view /*name*/) const {
+  return velocypack::Slice::noneSlice();
+}
+
 void QueryContext::enterV8Context() {
   THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_NOT_IMPLEMENTED,
                                  "V8 support not implemented");
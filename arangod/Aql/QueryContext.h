@@ -38,6 +38,7 @@
 #include <atomic>
 #include <mutex>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 
 struct TRI_vocbase_t;
@@ -53,7 +54,8 @@ class Methods;
 
 namespace velocypack {
 struct Options;
-}
+class Slice;
+}  // namespace velocypack
 
 namespace graph {
 class Graph;
@@ -152,6 +154,10 @@ class QueryContext {
 
   virtual bool hasEnteredV8Context() const { return false; }
 
+  /// @brief return the value of a bind parameter, or a none slice if there
+  /// is no such bind parameter
+  virtual velocypack::Slice bindParameterValue(std::string_view name) const;
+
   // base overhead for each query. the number used here is somewhat arbitrary.
   // it is just that all the basics data structures of a query are not totally
   // free, and there is not other accounting for them. note: this value is
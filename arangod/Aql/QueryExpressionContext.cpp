@@ -73,6 +73,11 @@ bool QueryExpressionContext::killed() const { return _query.killed(); }
 
 QueryContext& QueryExpressionContext::query() { return _query; }
 
+velocypack::Slice QueryExpressionContext::getBindParameterValue(
+    std::string_view name) const {
+  return _query.bindParameterValue(name);
+}
+
 void QueryExpressionContext::setVariable(Variable const* variable,
                                          arangodb::velocypack::Slice value) {
   _variables.emplace(variable, value);
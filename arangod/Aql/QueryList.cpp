@@ -102,6 +102,24 @@ void QueryEntryCopy::toVelocyPack(velocypack::Builder& out) const {
   out.close();
 }
 
+void QueryStatistics::toVelocyPack(velocypack::Builder& out,
+                                   std::string const& database,
+                                   std::string const& queryString) const {
+  out.add(VPackValue(VPackValueType::Object));
+  out.add("database", VPackValue(database));
+  out.add("query", VPackValue(queryString));
+  out.add("calls", VPackValue(calls));
+  out.add("failed", VPackValue(failed));
+  out.add("totalRunTime", VPackValue(totalRunTime));
+  out.add("averageRunTime",
+          VPackValue(calls > 0 ? totalRunTime / calls : 0.0));
+  out.add("maxRunTime", VPackValue(maxRunTime));
+  out.add("averagePeakMemoryUsage",
+          VPackValue(calls > 0 ? totalPeakMemoryUsage / calls : 0));
+  out.add("maxPeakMemoryUsage", VPackValue(maxPeakMemoryUsage));
+  out.close();
+}
+
 /// @brief create a query list
 QueryList::QueryList(QueryRegistryFeature& feature)
     : _queryRegistryFeature(feature),
@@ -113,7 +131,8 @@ QueryList::QueryList(QueryRegistryFeature& feature)
       _slowQueryThreshold(feature.slowQueryThreshold()),
       _slowStreamingQueryThreshold(feature.slowStreamingQueryThreshold()),
       _maxSlowQueries(defaultMaxSlowQueries),
-      _maxQueryStringLength(feature.maxQueryStringLength()) {
+      _maxQueryStringLength(feature.maxQueryStringLength()),
+      _maxStatistics(feature.maxQueryStatistics()) {
   _current.reserve(32);
 }
 
@@ -170,6 +189,10 @@ void QueryList::remove(Query& query) {
 
   _queryRegistryFeature.trackQueryEnd(elapsed);
 
+  if (trackStatistics()) {
+    trackStatistics(query, elapsed);
+  }
+
   if (!trackSlowQueries()) {
     return;
   }
@@ -378,6 +401,67 @@ void QueryList::clearSlow() {
   _slow.clear();
 }
 
+void QueryList::statisticsToVelocyPack(velocypack::Builder& out,
+                                       std::string const& database) {
+  out.openArray();
+  {
+    std::lock_guard guard(_statisticsMutex);
+    for (auto const& [queryString, statistics] : _statistics) {
+      statistics.toVelocyPack(out, database, queryString);
+    }
+  }
+  out.close();
+}
+
+void QueryList::clearStatistics() {
+  std::lock_guard guard(_statisticsMutex);
+  _statistics.clear();
+  _droppedStatistics = 0;
+}
+
+void QueryList::trackStatistics(Query& query, double elapsed) {
+  if (!trackQueryString()) {
+    // all query strings would be "<hidden>"
+    return;
+  }
+
+  try {
+    std::string q = query.extractQueryString(
+        _maxQueryStringLength.load(std::memory_order_relaxed), true);
+    size_t const peak = query.resourceMonitor().peak();
+    bool const failed =
+        query.killed() || query.resultCode() != TRI_ERROR_NO_ERROR;
+
+    std::lock_guard guard(_statisticsMutex);
+
+    auto it = _statistics.find(q);
+    if (it == _statistics.end()) {
+      if (_statistics.size() >= _maxStatistics) {
+        if (++_droppedStatistics == 1) {
+          LOG_TOPIC("3e0b1", INFO, Logger::QUERIES)
+              << "not aggregating statistics for more than " << _maxStatistics
+              << " distinct query strings in database '"
+              << query.vocbase().name() << "'";
+        }
+        return;
+      }
+      it = _statistics.emplace(std::move(q), QueryStatistics{}).first;
+    }
+
+    auto& statistics = it->second;
+    ++statistics.calls;
+    if (failed) {
+      ++statistics.failed;
+    }
+    statistics.totalRunTime += elapsed;
+    statistics.maxRunTime = std::max(statistics.maxRunTime, elapsed);
+    statistics.totalPeakMemoryUsage += peak;
+    statistics.maxPeakMemoryUsage =
+        std::max(statistics.maxPeakMemoryUsage, peak);
+  } catch (...) {
+  }
+}
+
 size_t QueryList::count() {
   READ_LOCKER(writeLocker, _lock);
   return _current.size();
@@ -26,6 +26,7 @@
 #include <cmath>
 #include <list>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <unordered_map>
 
@@ -71,6 +72,27 @@ struct QueryEntryCopy {
   bool stream;
 };
 
+/// @brief aggregated statistics for all executions of one query string in a
+/// database. bind parameters are not part of the query string, so all
+/// executions of a query that only differ in their bind parameter values are
+/// aggregated into the same entry
+struct QueryStatistics {
+  void toVelocyPack(arangodb::velocypack::Builder& out,
+                    std::string const& database,
+                    std::string const& queryString) const;
+
+  /// @brief number of finished executions
+  uint64_t calls = 0;
+  /// @brief number of executions that failed or were killed
+  uint64_t failed = 0;
+  /// @brief total and maximum run time of all executions (in seconds)
+  double totalRunTime = 0.0;
+  double maxRunTime = 0.0;
+  /// @brief total and maximum peak memory usage of all executions
+  uint64_t totalPeakMemoryUsage = 0;
+  size_t maxPeakMemoryUsage = 0;
+};
+
 class QueryList {
  public:
   /// @brief create a query list
@@ -217,11 +239,24 @@ class QueryList {
   /// @brief clear the list of slow queries
   void clearSlow();
 
+  /// @brief whether or not statistics are aggregated per query string
+  bool trackStatistics() const noexcept { return _maxStatistics > 0; }
+
+  /// @brief return the aggregated statistics per query string, as an array
+  void statisticsToVelocyPack(arangodb::velocypack::Builder& out,
+                              std::string const& database);
+
+  /// @brief clear the aggregated statistics per query string
+  void clearStatistics();
+
   size_t count();
 
  private:
   void killQuery(Query& query, size_t maxLength, bool silent);
 
+  /// @brief add the finished query to the aggregated statistics
+  void trackStatistics(Query& query, double elapsed);
+
   /// @brief default maximum number of slow queries to keep in list
   static constexpr size_t defaultMaxSlowQueries = 64;
 
@@ -263,6 +298,21 @@ class QueryList {
 
   /// @brief max length of query strings to return
   std::atomic<size_t> _maxQueryStringLength;
+
+  /// @brief maximum number of distinct query strings to aggregate statistics
+  /// for. 0 means that no statistics are aggregated
+  size_t const _maxStatistics;
+
+  /// @brief mutex for _statistics and _droppedStatistics. it is separate from
+  /// _lock so that aggregating never blocks the lists of queries
+  std::mutex _statisticsMutex;
+
+  /// @brief aggregated statistics, keyed by the (truncated) query string
+  std::unordered_map<std::string, QueryStatistics> _statistics;
+
+  /// @brief number of executions that were not aggregated because the
+  /// maximum number of distinct query strings had been reached
+  uint64_t _droppedStatistics = 0;
 };
 }  // namespace aql
 }  // namespace arangodb
@@ -60,6 +60,7 @@ QueryOptions::QueryOptions()
       spillOverThresholdMemoryUsage(
           QueryOptions::defaultSpillOverThresholdMemoryUsage),
       maxDNFConditionMembers(QueryOptions::defaultMaxDNFConditionMembers),
+      columnarLayoutMinRegisters(0),
       maxRuntime(0.0),
       satelliteSyncWait(std::chrono::seconds(60)),
       ttl(QueryOptions::defaultTtl),  // get global default ttl
@@ -75,6 +76,7 @@ QueryOptions::QueryOptions()
           QueryOptions::defaultFailOnWarning),  // use global "failOnWarning"
                                                 // value
       cache(false),
+      usePlanCache(false),
       fullCount(false),
       count(false),
       skipAudit(false),
@@ -165,6 +167,11 @@ void QueryOptions::fromVelocyPack(VPackSlice slice) {
     maxDNFConditionMembers = value.getNumber<size_t>();
   }
 
+  value = slice.get("columnarLayoutMinRegisters");
+  if (value.isNumber()) {
+    columnarLayoutMinRegisters = value.getNumber<size_t>();
+  }
+
   value = slice.get("maxRuntime");
   if (value.isNumber()) {
     maxRuntime = value.getNumber<double>();
@@ -222,6 +229,9 @@ void QueryOptions::fromVelocyPack(VPackSlice slice) {
   if (value = slice.get("cache"); value.isBool()) {
     cache = value.getBool();
   }
+  if (value = slice.get("usePlanCache"); value.isBool()) {
+    usePlanCache = value.getBool();
+  }
   if (value = slice.get("fullCount"); value.isBool()) {
     fullCount = value.getBool();
   }
@@ -295,6 +305,8 @@ void QueryOptions::toVelocyPack(VPackBuilder& builder,
   builder.add("spillOverThresholdMemoryUsage",
               VPackValue(spillOverThresholdMemoryUsage));
   builder.add("maxDNFConditionMembers", VPackValue(maxDNFConditionMembers));
+  builder.add("columnarLayoutMinRegisters",
+              VPackValue(columnarLayoutMinRegisters));
   builder.add("maxRuntime", VPackValue(maxRuntime));
   builder.add("satelliteSyncWait", VPackValue(satelliteSyncWait.count()));
   builder.add("ttl", VPackValue(ttl));
@@ -309,6 +321,7 @@ void QueryOptions::toVelocyPack(VPackBuilder& builder,
   builder.add("silent", VPackValue(silent));
   builder.add("failOnWarning", VPackValue(failOnWarning));
   builder.add("cache", VPackValue(cache));
+  builder.add("usePlanCache", VPackValue(usePlanCache));
   builder.add("fullCount", VPackValue(fullCount));
   builder.add("count", VPackValue(count));
   if (!forceOneShardAttributeValue.empty()) {
@@ -63,6 +63,9 @@ struct QueryOptions {
   size_t spillOverThresholdNumRows;
   size_t spillOverThresholdMemoryUsage;
   size_t maxDNFConditionMembers;
+  // number of registers from which on AqlItemBlocks are stored column by
+  // column instead of row by row. 0 = always use row-major blocks
+  size_t columnarLayoutMinRegisters;
   double maxRuntime;  // query has to execute within the given time or will be
                       // killed
   std::chrono::duration<double> satelliteSyncWait;
@@ -87,6 +90,9 @@ struct QueryOptions {
   // whether or not the query result is allowed to be stored in the
   // query results cache
   bool cache;
+  // whether or not the optimized execution plan is allowed to be stored in
+  // and reused from the query plan cache
+  bool usePlanCache;
   // whether or not the fullCount should be returned
   bool fullCount;
   bool count;
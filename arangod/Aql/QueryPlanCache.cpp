@@ -0,0 +1,173 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "QueryPlanCache.h"
+
+#include "Aql/BindParameters.h"
+#include "Basics/ReadLocker.h"
+#include "Basics/WriteLocker.h"
+#include "Basics/debugging.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Slice.h>
+
+#include <algorithm>
+#include <vector>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+namespace {
+/// @brief singleton instance of the plan cache
+static arangodb::aql::QueryPlanCache instance;
+}  // namespace
+
+QueryPlanCache::QueryPlanCache() : _generation(0) {}
+
+QueryPlanCache::~QueryPlanCache() = default;
+
+uint64_t QueryPlanCache::generation() const noexcept {
+  return _generation.load(std::memory_order_acquire);
+}
+
+std::optional<std::unordered_set<std::string>>
+QueryPlanCache::runtimeBindParameters(TRI_vocbase_t* vocbase,
+                                      std::string const& queryKey) const {
+  READ_LOCKER(readLocker, _lock);
+
+  auto it = _entries.find(vocbase);
+  if (it == _entries.end()) {
+    return std::nullopt;
+  }
+  auto it2 = (*it).second.find(queryKey);
+  if (it2 == (*it).second.end()) {
+    return std::nullopt;
+  }
+  return (*it2).second.runtimeBindParameters;
+}
+
+std::optional<std::string> QueryPlanCache::buildPlanKey(
+    BindParameters const& parameters,
+    std::unordered_set<std::string> const& runtimeBindParameters) {
+  std::vector<std::pair<std::string, velocypack::Slice>> values;
+  parameters.visit([&](std::string const& key, velocypack::Slice value,
+                       AstNode*) { values.emplace_back(key, value); });
+  std::sort(values.begin(), values.end(),
+            [](auto const& lhs, auto const& rhs) {
+              return lhs.first < rhs.first;
+            });
+
+  // the values of runtime bind parameters do not matter for the plan, but
+  // their names do, because a query with a different set of bind
+  // parameters will fail with a different error
+  velocypack::Builder builder;
+  builder.openObject();
+  for (auto const& [key, value] : values) {
+    if (runtimeBindParameters.contains(key)) {
+      builder.add(key, velocypack::Slice::nullSlice());
+    } else {
+      builder.add(key, value);
+    }
+    if (builder.bufferRef().byteSize() > maxKeySize) {
+      return std::nullopt;
+    }
+  }
+  builder.close();
+  return builder.slice().toJson();
+}
+
+std::shared_ptr<QueryPlanCache::CachedPlan const> QueryPlanCache::lookup(
+    TRI_vocbase_t* vocbase, std::string const& queryKey,
+    std::string const& planKey) const {
+  READ_LOCKER(readLocker, _lock);
+
+  auto it = _entries.find(vocbase);
+  if (it == _entries.end()) {
+    return nullptr;
+  }
+  auto it2 = (*it).second.find(queryKey);
+  if (it2 == (*it).second.end()) {
+    return nullptr;
+  }
+  auto it3 = (*it2).second.plans.find(planKey);
+  if (it3 == (*it2).second.plans.end()) {
+    return nullptr;
+  }
+  return (*it3).second;
+}
+
+void QueryPlanCache::store(
+    TRI_vocbase_t* vocbase, uint64_t generation, std::string const& queryKey,
+    std::unordered_set<std::string> runtimeBindParameters,
+    std::string const& planKey, std::shared_ptr<CachedPlan const> plan) {
+  TRI_ASSERT(plan != nullptr && plan->plan != nullptr);
+  if (plan->plan->slice().byteSize() > maxPlanSize) {
+    return;
+  }
+
+  WRITE_LOCKER(writeLocker, _lock);
+
+  if (generation != _generation.load(std::memory_order_relaxed)) {
+    // an index or collection may have been dropped while the plan was
+    // compiled
+    return;
+  }
+
+  auto& queries = _entries[vocbase];
+  auto it = queries.find(queryKey);
+  if (it == queries.end()) {
+    if (queries.size() >= maxQueriesPerDatabase) {
+      // make room for the new query. we do not track which of the queries
+      // is used least, so we throw out an arbitrary one
+      queries.erase(queries.begin());
+    }
+    it = queries
+             .emplace(queryKey,
+                      QueryEntry{std::move(runtimeBindParameters), {}})
+             .first;
+  } else {
+    // all compilations of the same query string come to the same result
+    TRI_ASSERT((*it).second.runtimeBindParameters == runtimeBindParameters);
+  }
+
+  auto& plans = (*it).second.plans;
+  if (plans.size() >= maxPlansPerQuery && !plans.contains(planKey)) {
+    // the query is used with too many different bind parameter values.
+    // start over
+    plans.clear();
+  }
+  plans.insert_or_assign(planKey, std::move(plan));
+}
+
+void QueryPlanCache::invalidate(TRI_vocbase_t* vocbase) {
+  WRITE_LOCKER(writeLocker, _lock);
+  _generation.fetch_add(1, std::memory_order_release);
+  _entries.erase(vocbase);
+}
+
+void QueryPlanCache::invalidate() {
+  WRITE_LOCKER(writeLocker, _lock);
+  _generation.fetch_add(1, std::memory_order_release);
+  _entries.clear();
+}
+
+/// @brief get the plan cache instance
+QueryPlanCache* QueryPlanCache::instance() { return &::instance; }
@@ -0,0 +1,142 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Basics/ReadWriteLock.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+struct TRI_vocbase_t;
+
+namespace arangodb {
+namespace velocypack {
+class Builder;
+}
+namespace aql {
+class BindParameters;
+
+/// @brief cache for optimized execution plans of read-only AQL queries.
+/// plans are looked up by the query string and the planning-relevant query
+/// options first. all queries with the same string share the same set of
+/// "runtime" bind parameters. these are bind parameters that are only used
+/// as comparison operands in FILTER conditions. they are not injected into
+/// the AST, but evaluated when the plan is executed, so their values do not
+/// influence the plan. all other bind parameters (including collection
+/// bind parameters) can be folded into the plan by the optimizer, so their
+/// values are part of the key of the plan.
+/// all cached plans of a database are invalidated when the database, one of
+/// its collections, views or indexes is dropped or renamed, or when an index
+/// is created.
+class QueryPlanCache {
+ public:
+  /// @brief maximum number of queries cached per database
+  static constexpr size_t maxQueriesPerDatabase = 256;
+
+  /// @brief maximum number of different plans per query
+  static constexpr size_t maxPlansPerQuery = 16;
+
+  /// @brief maximum size of a serialized plan
+  static constexpr size_t maxPlanSize = 1024 * 1024;
+
+  /// @brief maximum size of the bind parameter values folded into the key
+  static constexpr size_t maxKeySize = 4096;
+
+  /// @brief a serialized plan, plus the properties of the query that are
+  /// not contained in the plan
+  struct CachedPlan {
+    std::shared_ptr<velocypack::Builder const> plan;
+    /// @brief names of all bind parameters used by the query
+    std::unordered_set<std::string> bindParameters;
+    /// @brief whether the AST of the query contained a parallel node
+    bool containsParallelNode = false;
+  };
+
+  QueryPlanCache(QueryPlanCache const&) = delete;
+  QueryPlanCache& operator=(QueryPlanCache const&) = delete;
+
+  QueryPlanCache();
+  ~QueryPlanCache();
+
+  /// @brief return the current generation of the cache. must be fetched
+  /// before compiling a query, and passed to store() afterwards
+  uint64_t generation() const noexcept;
+
+  /// @brief return the runtime bind parameters for the query, if the query
+  /// was compiled before
+  std::optional<std::unordered_set<std::string>> runtimeBindParameters(
+      TRI_vocbase_t* vocbase, std::string const& queryKey) const;
+
+  /// @brief build the key of the plan from the bind parameters. returns
+  /// nothing if the plan must not be cached
+  static std::optional<std::string> buildPlanKey(
+      BindParameters const& parameters,
+      std::unordered_set<std::string> const& runtimeBindParameters);
+
+  /// @brief look up a serialized plan. returns a nullptr if there is none
+  std::shared_ptr<CachedPlan const> lookup(
+      TRI_vocbase_t* vocbase, std::string const& queryKey,
+      std::string const& planKey) const;
+
+  /// @brief store a serialized plan. does nothing if the cache was
+  /// invalidated since the generation was fetched
+  void store(TRI_vocbase_t* vocbase, uint64_t generation,
+             std::string const& queryKey,
+             std::unordered_set<std::string> runtimeBindParameters,
+             std::string const& planKey,
+             std::shared_ptr<CachedPlan const> plan);
+
+  /// @brief invalidate all plans for a particular database
+  void invalidate(TRI_vocbase_t* vocbase);
+
+  /// @brief invalidate all plans
+  void invalidate();
+
+  /// @brief get the pointer to the global plan cache
+  static QueryPlanCache* instance();
+
+ private:
+  struct QueryEntry {
+    std::unordered_set<std::string> runtimeBindParameters;
+    std::unordered_map<std::string, std::shared_ptr<CachedPlan const>> plans;
+  };
+
+  using DatabaseEntry = std::unordered_map<std::string, QueryEntry>;
+
+  /// @brief protects _entries
+  mutable basics::ReadWriteLock _lock;
+
+  /// @brief cached queries, per database
+  std::unordered_map<TRI_vocbase_t*, DatabaseEntry> _entries;
+
+  /// @brief increased on every invalidation, so that plans compiled before
+  /// an invalidation are not stored afterwards
+  std::atomic<uint64_t> _generation;
+};
+
+}  // namespace aql
+}  // namespace arangodb
@@ -32,6 +32,8 @@
 
 #include <velocypack/Builder.h>
 
+#include <algorithm>
+
 using namespace arangodb;
 using namespace arangodb::aql;
 
@@ -41,6 +43,7 @@ QueryProfile::QueryProfile(Query& query)
   for (auto& it : _timers) {
     it = 0.0;  // reset timers
   }
+  _clusterSetupTimers.fill(0.0);
 }
 
 /// @brief destroy a profile
@@ -95,13 +98,30 @@ void QueryProfile::setStateEnd(QueryExecutionState::ValueType state,
 
 /// @brief convert the profile to VelocyPack
 void QueryProfile::toVelocyPack(VPackBuilder& builder) const {
-  VPackObjectBuilder guard(&builder, "profile", true);
-  for (auto state : ENUM_ITERATOR(QueryExecutionState::ValueType,
-                                  INITIALIZATION, FINALIZATION)) {
-    double const value = _timers[static_cast<size_t>(state)];
-
-    if (value >= 0.0) {
-      builder.add(QueryExecutionState::toString(state), VPackValue(value));
+  {
+    VPackObjectBuilder guard(&builder, "profile", true);
+    for (auto state : ENUM_ITERATOR(QueryExecutionState::ValueType,
+                                    INITIALIZATION, FINALIZATION)) {
+      double const value = _timers[static_cast<size_t>(state)];
+
+      if (value >= 0.0) {
+        builder.add(QueryExecutionState::toString(state), VPackValue(value));
+      }
     }
   }
+
+  if (std::any_of(_clusterSetupTimers.begin(), _clusterSetupTimers.end(),
+                  [](double value) { return value > 0.0; })) {
+    // breakdown of "instantiating executors" for cluster queries
+    VPackObjectBuilder guard(&builder, "clusterSetup", true);
+    builder.add("building requests",
+                VPackValue(_clusterSetupTimers[static_cast<size_t>(
+                    ClusterSetupPhase::BuildingRequests)]));
+    builder.add("awaiting servers",
+                VPackValue(_clusterSetupTimers[static_cast<size_t>(
+                    ClusterSetupPhase::AwaitingServers)]));
+    builder.add("locking in order",
+                VPackValue(_clusterSetupTimers[static_cast<size_t>(
+                    ClusterSetupPhase::LockingInOrder)]));
+  }
 }
@@ -38,6 +38,19 @@ namespace aql {
 class Query;
 
 struct QueryProfile {
+  /// @brief phases of setting up the snippets of a cluster query on the
+  /// DB-Servers. these are all part of "instantiating executors"
+  enum class ClusterSetupPhase {
+    // building the setup requests for all DB-Servers
+    BuildingRequests = 0,
+    // waiting for the DB-Servers to lock the shards and to instantiate the
+    // snippets, after the last setup request was sent
+    AwaitingServers,
+    // locking the DB-Servers one after the other, after the parallel setup
+    // ran into a lock timeout
+    LockingInOrder,
+  };
+
   QueryProfile(QueryProfile const&) = delete;
   QueryProfile& operator=(QueryProfile const&) = delete;
 
@@ -60,6 +73,11 @@ struct QueryProfile {
     return _timers[QueryExecutionState::toNumber(t)];
   }
 
+  /// @brief add to the time spent in a phase of the cluster setup
+  void addClusterSetupTime(ClusterSetupPhase phase, double time) noexcept {
+    _clusterSetupTimers[static_cast<size_t>(phase)] += time;
+  }
+
   /// @brief convert the profile to VelocyPack
   void toVelocyPack(arangodb::velocypack::Builder&) const;
 
@@ -68,6 +86,9 @@ struct QueryProfile {
   std::array<double,
              static_cast<size_t>(QueryExecutionState::ValueType::INVALID_STATE)>
       _timers;
+  std::array<double,
+             static_cast<size_t>(ClusterSetupPhase::LockingInOrder) + 1>
+      _clusterSetupTimers;
   double _lastStamp;
   bool _tracked;
 };
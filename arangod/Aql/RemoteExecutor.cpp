@@ -51,6 +51,8 @@
 #include <velocypack/Builder.h>
 #include <velocypack/Iterator.h>
 
+#include <algorithm>
+
 using namespace arangodb;
 using namespace arangodb::aql;
 
@@ -75,6 +77,11 @@ ExecutionBlockImpl<RemoteExecutor>::ExecutionBlockImpl(
       _isResponsibleForInitializeCursor(
           node->isResponsibleForInitializeCursor()),
       _requestInFlight(false),
+      _allowPrefetch(ServerState::instance()->isCoordinator() &&
+                     !engine->getQuery().isModificationQuery()),
+      _isPrefetching(false),
+      _prefetchedRow(0),
+      _prefetchedState(ExecutionState::HASMORE),
       _lastTicket(0) {
   TRI_ASSERT(!queryId.empty());
   TRI_ASSERT((arangodb::ServerState::instance()->isCoordinator() &&
@@ -108,6 +115,16 @@ std::pair<ExecutionState, Result> ExecutionBlockImpl<
     return {ExecutionState::WAITING, TRI_ERROR_NO_ERROR};
   }
 
+  if (_isPrefetching) {
+    // the prefetched result is obsolete, as the remote side is reinitialized
+    _isPrefetching = false;
+    _lastResponse.reset();
+    _lastError.reset();
+  }
+  _prefetchedBlock = nullptr;
+  _prefetchedRow = 0;
+  _prefetchedState = ExecutionState::HASMORE;
+
   if (_lastResponse != nullptr) {
     // We have an open result still.
     auto response = std::move(_lastResponse);
@@ -243,7 +260,37 @@ auto ExecutionBlockImpl<RemoteExecutor>::executeWithoutTrace(
       THROW_ARANGO_EXCEPTION(result.result());
     }
 
-    return result->asTuple();
+    if (!_isPrefetching) {
+      // the response to this very call
+      if (result->state() == ExecutionState::HASMORE && canPrefetch(stack)) {
+        sendPrefetchRequest(stack);
+      }
+      return result->asTuple();
+    }
+
+    // the response to a prefetch, which requested neither an offset nor
+    // a fullCount
+    _isPrefetching = false;
+    TRI_ASSERT(result->skipped().nothingSkipped());
+    _prefetchedBlock = result->block();
+    _prefetchedRow = 0;
+    _prefetchedState = result->state();
+  }
+
+  if (_prefetchedBlock != nullptr) {
+    // prefetches are only sent for call stacks with a single call, and the
+    // consumer keeps the depth of its call stacks
+    TRI_ASSERT(stack.subqueryLevel() == 1);
+    auto result = executeFromPrefetched(stack.peek());
+    if (std::get<0>(result) == ExecutionState::HASMORE &&
+        _prefetchedBlock == nullptr && canPrefetch(stack)) {
+      sendPrefetchRequest(stack);
+    }
+    return result;
+  } else if (_prefetchedState == ExecutionState::DONE) {
+    // the prefetch returned DONE without any rows
+    _prefetchedState = ExecutionState::HASMORE;
+    return {ExecutionState::DONE, SkipResult{}, nullptr};
   }
 
   // We need to send a request here
@@ -296,6 +343,87 @@ auto ExecutionBlockImpl<RemoteExecutor>::serializeExecuteCallBody(
   return buffer;
 }
 
+auto ExecutionBlockImpl<RemoteExecutor>::canPrefetch(
+    AqlCallStack const& callStack) const -> bool {
+  if (!_allowPrefetch || callStack.subqueryLevel() != 1) {
+    return false;
+  }
+  // only prefetch for calls that simply produce rows. a call with an offset
+  // or a hard limit is usually followed by a different call
+  AqlCall const& call = callStack.peek();
+  return call.getOffset() == 0 && !call.hasHardLimit() &&
+         !call.needsFullCount() && call.getLimit() > 0;
+}
+
+void ExecutionBlockImpl<RemoteExecutor>::sendPrefetchRequest(
+    AqlCallStack const& callStack) {
+  TRI_ASSERT(!_requestInFlight && _prefetchedBlock == nullptr);
+  auto buffer = serializeExecuteCallBody(callStack);
+  this->traceExecuteRequest(VPackSlice(buffer.data()), callStack);
+
+  auto res =
+      sendAsyncRequest(fuerte::RestVerb::Put, RestAqlHandler::Route::execute(),
+                       std::move(buffer));
+  // if the request cannot be sent, the error is reported by the next
+  // regular request
+  _isPrefetching = res.ok();
+}
+
+#ifdef ARANGODB_USE_GOOGLE_TESTS
+void ExecutionBlockImpl<RemoteExecutor>::testInjectPrefetchedRows(
+    SharedAqlItemBlockPtr block, ExecutionState state) {
+  std::lock_guard<std::mutex> guard(_communicationMutex);
+  TRI_ASSERT(!_requestInFlight && !_isPrefetching);
+  TRI_ASSERT(block != nullptr);
+  _prefetchedBlock = std::move(block);
+  _prefetchedRow = 0;
+  _prefetchedState = state;
+}
+#endif
+
+auto ExecutionBlockImpl<RemoteExecutor>::executeFromPrefetched(
+    AqlCall const& call)
+    -> std::tuple<ExecutionState, SkipResult, SharedAqlItemBlockPtr> {
+  TRI_ASSERT(_prefetchedBlock != nullptr);
+  size_t const numRows = _prefetchedBlock->numRows();
+  TRI_ASSERT(_prefetchedRow <= numRows);
+
+  SkipResult skipped;
+  size_t toSkip = std::min(call.getOffset(), numRows - _prefetchedRow);
+  skipped.didSkip(toSkip);
+  _prefetchedRow += toSkip;
+
+  SharedAqlItemBlockPtr block = nullptr;
+  if (toSkip == call.getOffset()) {
+    size_t toProduce = std::min(call.getLimit(), numRows - _prefetchedRow);
+    if (toProduce > 0) {
+      if (_prefetchedRow == 0 && toProduce == numRows) {
+        block = _prefetchedBlock;
+      } else {
+        block = _prefetchedBlock->slice(_prefetchedRow,
+                                        _prefetchedRow + toProduce);
+      }
+      _prefetchedRow += toProduce;
+    }
+    if (call.hasHardLimit() && toProduce == call.getLimit()) {
+      // the hard limit is reached, the rest of the rows is not needed
+      if (call.needsFullCount()) {
+        skipped.didSkip(numRows - _prefetchedRow);
+      }
+      _prefetchedRow = numRows;
+    }
+  }
+
+  if (_prefetchedRow < numRows) {
+    return {ExecutionState::HASMORE, skipped, std::move(block)};
+  }
+  _prefetchedBlock = nullptr;
+  _prefetchedRow = 0;
+  auto state = _prefetchedState;
+  _prefetchedState = ExecutionState::HASMORE;
+  return {state, skipped, std::move(block)};
+}
+
 namespace {
 Result handleErrorResponse(network::EndpointSpec const& spec, fuerte::Error err,
                            fuerte::Response* response) {
@@ -27,6 +27,7 @@
 #include "Aql/ClusterNodes.h"
 #include "Aql/ExecutionBlockImpl.h"
 #include "Aql/RegisterInfos.h"
+#include "Aql/SharedAqlItemBlockPtr.h"
 #include "Basics/Result.h"
 
 #include <fuerte/message.h>
@@ -80,6 +81,13 @@ class ExecutionBlockImpl<RemoteExecutor> : public ExecutionBlock {
   std::string const& queryId() const noexcept { return _queryId; }
 #endif
 
+#ifdef ARANGODB_USE_GOOGLE_TESTS
+  // This is a helper method to inject rows in the tests, as if they had
+  // been prefetched from the remote side together with the given state.
+  void testInjectPrefetchedRows(SharedAqlItemBlockPtr block,
+                                ExecutionState state);
+#endif
+
  private:
   auto executeWithoutTrace(AqlCallStack const& stack)
       -> std::tuple<ExecutionState, SkipResult, SharedAqlItemBlockPtr>;
@@ -89,6 +97,19 @@ class ExecutionBlockImpl<RemoteExecutor> : public ExecutionBlock {
   [[nodiscard]] auto serializeExecuteCallBody(
       AqlCallStack const& callStack) const -> velocypack::Buffer<uint8_t>;
 
+  /// @brief whether the next batch can be requested from the remote side
+  /// before it is asked for, assuming the next call looks like this one
+  [[nodiscard]] auto canPrefetch(AqlCallStack const& callStack) const
+      -> bool;
+
+  /// @brief request the next batch from the remote side.
+  /// _communicationMutex *must* be locked for this!
+  void sendPrefetchRequest(AqlCallStack const& callStack);
+
+  /// @brief answer the call from the prefetched rows
+  auto executeFromPrefetched(AqlCall const& call)
+      -> std::tuple<ExecutionState, SkipResult, SharedAqlItemBlockPtr>;
+
   RegisterInfos const& registerInfos() const { return _registerInfos; }
 
   QueryContext const& getQuery() const { return _query; }
@@ -138,6 +159,21 @@ class ExecutionBlockImpl<RemoteExecutor> : public ExecutionBlock {
 
   bool _requestInFlight;
 
+  /// @brief whether the next batch may be requested from the remote side
+  /// while the current one is still processed. this saves a round trip
+  /// per batch. only done on coordinators for queries that do not modify
+  /// data, as the remote side may produce a batch too many
+  bool const _allowPrefetch;
+
+  /// @brief whether the request in flight (or _lastResponse) is a prefetch
+  bool _isPrefetching;
+
+  /// @brief prefetched rows which have not been returned yet, starting at
+  /// _prefetchedRow, and the remote state after them
+  SharedAqlItemBlockPtr _prefetchedBlock;
+  size_t _prefetchedRow;
+  ExecutionState _prefetchedState;
+
   unsigned _lastTicket;  /// used to check for canceled requests
 };
 
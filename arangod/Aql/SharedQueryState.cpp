@@ -26,6 +26,7 @@
 #include "ApplicationFeatures/ApplicationServer.h"
 #include "Basics/Exceptions.h"
 #include "Basics/ScopeGuard.h"
+#include "Basics/process-utils.h"
 #include "Cluster/ServerState.h"
 #include "RestServer/QueryRegistryFeature.h"
 #include "Scheduler/Scheduler.h"
@@ -47,9 +48,23 @@ SharedQueryState::SharedQueryState(ArangodServer& server, Scheduler* scheduler)
       _cbVersion(0),
       _maxTasks(static_cast<unsigned>(
           _server.getFeature<QueryRegistryFeature>().maxParallelism())),
+      _parallelismCpuTimeThreshold(static_cast<uint64_t>(
+          _server.getFeature<QueryRegistryFeature>()
+              .parallelismCpuTimeThreshold() *
+          1000000.0)),
       _numTasks(0),
       _valid(true) {}
 
+SharedQueryState::CpuTimeScope::CpuTimeScope(SharedQueryState& state) noexcept
+    : _state(state), _start(TRI_ThreadCpuTime()) {}
+
+SharedQueryState::CpuTimeScope::~CpuTimeScope() {
+  uint64_t now = TRI_ThreadCpuTime();
+  if (now > _start) {
+    _state._cpuTime.fetch_add(now - _start, std::memory_order_relaxed);
+  }
+}
+
 void SharedQueryState::invalidate() {
   {
     std::lock_guard<std::mutex> guard(_mutex);
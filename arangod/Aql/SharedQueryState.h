@@ -25,6 +25,7 @@
 
 #include <atomic>
 #include <condition_variable>
+#include <cstdint>
 #include <function2.hpp>
 
 #include "RestServer/arangod.h"
@@ -47,8 +48,29 @@ class SharedQueryState final
   SharedQueryState() = delete;
   ~SharedQueryState() = default;
 
+  /// @brief measures the CPU time the calling thread spends while the object
+  /// is alive, and adds it to the CPU time of the query
+  class CpuTimeScope {
+   public:
+    explicit CpuTimeScope(SharedQueryState& state) noexcept;
+    ~CpuTimeScope();
+
+    CpuTimeScope(CpuTimeScope const&) = delete;
+    CpuTimeScope& operator=(CpuTimeScope const&) = delete;
+
+   private:
+    SharedQueryState& _state;
+    uint64_t const _start;
+  };
+
   void invalidate();
 
+  /// @brief CPU time (in microseconds) spent executing the query on this
+  /// server so far
+  uint64_t cpuTime() const noexcept {
+    return _cpuTime.load(std::memory_order_relaxed);
+  }
+
   /// @brief executeAndWakeup is to be called on the query object to
   /// continue execution in this query part, if the query got paused
   /// because it is waiting for network responses. The idea is that a
@@ -102,7 +124,7 @@ class SharedQueryState final
   template<typename F>
   bool asyncExecuteAndWakeup(F&& cb) {
     unsigned num = _numTasks.fetch_add(1);
-    if (num + 1 > _maxTasks) {
+    if (num + 1 > _maxTasks || exceedsParallelismCpuTime()) {
       _numTasks.fetch_sub(1);  // revert
       std::forward<F>(cb)(false);
       return false;
@@ -111,6 +133,7 @@ class SharedQueryState final
         queueAsyncTask([cb(std::forward<F>(cb)), self(shared_from_this())] {
           if (self->_valid) {
             try {
+              CpuTimeScope cpuTime(*self);
               cb(true);
             } catch (...) {
               TRI_ASSERT(false);
@@ -142,6 +165,13 @@ class SharedQueryState final
 
   bool queueAsyncTask(fu2::unique_function<void()>);
 
+  /// @brief whether the query has used more CPU time than it may use before
+  /// it stops starting parallel tasks
+  bool exceedsParallelismCpuTime() const noexcept {
+    return _parallelismCpuTimeThreshold > 0 &&
+           cpuTime() > _parallelismCpuTimeThreshold;
+  }
+
  private:
   ArangodServer& _server;
   Scheduler* _scheduler;
@@ -157,8 +187,12 @@ class SharedQueryState final
   unsigned _cbVersion;   // increased once callstack is done
 
   const unsigned _maxTasks;
+  /// @brief CPU time (in microseconds) after which no parallel tasks are
+  /// started anymore, 0 = no limit
+  uint64_t const _parallelismCpuTimeThreshold;
   std::atomic<unsigned> _numTasks;
   std::atomic<bool> _valid;
+  std::atomic<uint64_t> _cpuTime{0};
 };
 
 }  // namespace aql
@@ -105,6 +105,15 @@ size_t SortExecutorInfos::spillOverThresholdMemoryUsage() const noexcept {
 
 size_t SortExecutorInfos::limit() const noexcept { return _limit; }
 
+void SortExecutorInfos::setSortLimitThreshold(
+    std::shared_ptr<SortLimitThreshold> threshold) {
+  _sortLimitThreshold = std::move(threshold);
+}
+
+SortLimitThreshold* SortExecutorInfos::sortLimitThreshold() const noexcept {
+  return _sortLimitThreshold.get();
+}
+
 SortExecutor::SortExecutor(Fetcher&, SortExecutorInfos& infos) : _infos(infos) {
   _storageBackend = std::make_unique<SortedRowsStorageBackendMemory>(_infos);
 
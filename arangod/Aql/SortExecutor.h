@@ -58,6 +58,7 @@ template<BlockPassthrough>
 class SingleRowFetcher;
 struct SortRegister;
 class SortedRowsStorageBackend;
+class SortLimitThreshold;
 
 class SortExecutorInfos {
  public:
@@ -101,6 +102,12 @@ class SortExecutorInfos {
 
   [[nodiscard]] TemporaryStorageFeature& getTemporaryStorageFeature() noexcept;
 
+  /// @brief threshold to publish to the node producing the documents, only
+  /// used by the ConstrainedSortExecutor. may be a nullptr
+  void setSortLimitThreshold(std::shared_ptr<SortLimitThreshold> threshold);
+
+  [[nodiscard]] SortLimitThreshold* sortLimitThreshold() const noexcept;
+
  private:
   RegisterCount _numInRegs;
   RegisterCount _numOutRegs;
@@ -114,6 +121,7 @@ class SortExecutorInfos {
   size_t _spillOverThresholdNumRows;
   size_t _spillOverThresholdMemoryUsage;
   bool _stable;
+  std::shared_ptr<SortLimitThreshold> _sortLimitThreshold;
 };
 
 /**
@@ -0,0 +1,118 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "SortLimitThreshold.h"
+
+#include "Aql/AqlValue.h"
+#include "Aql/Projections.h"
+#include "Basics/VelocyPackHelper.h"
+#include "Basics/debugging.h"
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+SortLimitThreshold::SortLimitThreshold(velocypack::Options const* options)
+    : _options(options), _version(0) {}
+
+void SortLimitThreshold::update(AqlValue const& value) {
+  if (!_value.isEmpty() &&
+      AqlValue::Compare(_options, value,
+                        AqlValue(AqlValueHintSliceNoCopy(_value.slice())),
+                        true) == 0) {
+    // the first element of the heap changed, but not its value. readers
+    // do not need to refresh their snapshots
+    return;
+  }
+
+  std::lock_guard guard(_mutex);
+  _value.clear();
+  value.toVelocyPack(_options, _value, /*resolveExternals*/ true,
+                     /*allowUnindexed*/ true);
+  _version.fetch_add(1, std::memory_order_release);
+}
+
+void SortLimitThreshold::reset() noexcept {
+  std::lock_guard guard(_mutex);
+  if (!_value.isEmpty()) {
+    _value.clear();
+    _version.fetch_add(1, std::memory_order_release);
+  }
+}
+
+bool SortLimitThreshold::excludes(velocypack::Slice value, bool ascending,
+                                  Snapshot& snapshot) const {
+  if (_version.load(std::memory_order_acquire) != snapshot.version) {
+    std::lock_guard guard(_mutex);
+    snapshot.value.clear();
+    if (!_value.isEmpty()) {
+      snapshot.value.add(_value.slice());
+    }
+    // the version cannot change while we hold the mutex
+    snapshot.version = _version.load(std::memory_order_relaxed);
+  }
+
+  if (snapshot.value.isEmpty()) {
+    return false;
+  }
+  // must compare in the same way as the ConstrainedSortExecutor does. equal
+  // values are never excluded, as the following sort criteria may still
+  // move the row into the heap
+  int cmp = basics::VelocyPackHelper::compare(value, snapshot.value.slice(),
+                                              true, _options);
+  return ascending ? cmp > 0 : cmp < 0;
+}
+
+bool SortLimitThresholdFilter::excludes(
+    velocypack::Slice document, SortLimitThreshold::Snapshot& snapshot) const {
+  TRI_ASSERT(threshold != nullptr);
+
+  // a non-existing attribute is null, as it would be in the sort expression
+  velocypack::Slice value = document.resolveExternals();
+  for (auto const& name : attribute) {
+    if (!value.isObject()) {
+      value = velocypack::Slice::nullSlice();
+      break;
+    }
+    value = value.get(name).resolveExternals();
+  }
+  if (value.isNone()) {
+    value = velocypack::Slice::nullSlice();
+  }
+  return threshold->excludes(value, ascending, snapshot);
+}
+
+bool SortLimitThresholdFilter::isCoveredBy(
+    Projections const& projections) const noexcept {
+  for (size_t i = 0; i < projections.size(); ++i) {
+    auto const& path = projections[i].path;
+    if (path.size() > attribute.size()) {
+      continue;
+    }
+    bool isPrefix = true;
+    for (size_t j = 0; j < path.size() && isPrefix; ++j) {
+      isPrefix = (path[j] == attribute[j]);
+    }
+    if (isPrefix) {
+      return true;
+    }
+  }
+  return false;
+}
@@ -0,0 +1,115 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <velocypack/Builder.h>
+#include <velocypack/Slice.h>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace arangodb {
+namespace velocypack {
+struct Options;
+}
+
+namespace aql {
+struct AqlValue;
+class Projections;
+
+/// @brief the value of the first sort criterion of the last row in the heap
+/// of a ConstrainedSortExecutor. once the heap is full, rows with a worse
+/// value can never make it into the heap, so the executors producing the
+/// documents can discard them early.
+/// the threshold is published by the ConstrainedSortExecutor and read by an
+/// upstream executor, which may run on a different thread. every change of
+/// the threshold bumps a version counter. readers keep a snapshot of the
+/// threshold, and only acquire the mutex to refresh it when the version has
+/// changed
+class SortLimitThreshold {
+ public:
+  /// @brief a reader's copy of the threshold. must not be shared between
+  /// threads
+  struct Snapshot {
+    velocypack::Builder value;
+    std::uint64_t version = 0;
+  };
+
+  explicit SortLimitThreshold(velocypack::Options const* options);
+
+  SortLimitThreshold(SortLimitThreshold const&) = delete;
+  SortLimitThreshold& operator=(SortLimitThreshold const&) = delete;
+
+  /// @brief set a new threshold. must only be called when the heap is full,
+  /// and only by the single writer. does nothing if the value compares
+  /// equal to the current threshold
+  void update(AqlValue const& value);
+
+  /// @brief remove the threshold, e.g. when the heap is emptied
+  void reset() noexcept;
+
+  /// @brief whether or not a row with this value can be discarded, because
+  /// it would be sorted after the threshold. refreshes the snapshot if the
+  /// threshold has changed since it was taken
+  bool excludes(velocypack::Slice value, bool ascending,
+                Snapshot& snapshot) const;
+
+ private:
+  velocypack::Options const* _options;
+
+  mutable std::mutex _mutex;
+
+  /// @brief modified under _mutex. the writer may read it without the
+  /// mutex, as it is the only one modifying it
+  velocypack::Builder _value;
+
+  /// @brief incremented under _mutex whenever _value changes
+  std::atomic<std::uint64_t> _version;
+};
+
+/// @brief compares an attribute of the produced documents with the
+/// threshold of a downstream ConstrainedSortExecutor
+struct SortLimitThresholdFilter {
+  std::shared_ptr<SortLimitThreshold const> threshold;
+
+  /// @brief document attribute that the first sort criterion refers to
+  std::vector<std::string> attribute;
+
+  bool ascending = true;
+
+  bool empty() const noexcept { return threshold == nullptr; }
+
+  /// @brief whether or not the document (or its projections) can be
+  /// discarded. the snapshot must belong to the calling thread
+  bool excludes(velocypack::Slice document,
+                SortLimitThreshold::Snapshot& snapshot) const;
+
+  /// @brief whether or not the projections contain the attribute
+  bool isCoveredBy(Projections const& projections) const noexcept;
+};
+
+}  // namespace aql
+}  // namespace arangodb
@@ -208,6 +208,9 @@ std::unique_ptr<ExecutionBlock> SortNode::createBlock(
     return std::make_unique<ExecutionBlockImpl<SortExecutor>>(
         &engine, this, std::move(registerInfos), std::move(executorInfos));
   } else {
+    // publish the threshold of the heap if an upstream node uses it
+    executorInfos.setSortLimitThreshold(
+        engine.sortLimitThreshold(id(), /*create*/ false));
     return std::make_unique<ExecutionBlockImpl<ConstrainedSortExecutor>>(
         &engine, this, std::move(registerInfos), std::move(executorInfos));
   }
@@ -33,7 +33,11 @@
 #include "Basics/ResourceUsage.h"
 #include "Basics/debugging.h"
 
+#include <velocypack/Slice.h>
+
 #include <algorithm>
+#include <cmath>
+#include <cstring>
 
 namespace {
 using namespace arangodb;
@@ -49,9 +53,17 @@ class OurLessThan {
 
   bool operator()(SortedRowsStorageBackendMemory::RowIndex const& a,
                   SortedRowsStorageBackendMemory::RowIndex const& b) const {
+    return less(a, b, 0);
+  }
+
+  // compares the rows by all sort registers starting at the given one
+  bool less(SortedRowsStorageBackendMemory::RowIndex const& a,
+            SortedRowsStorageBackendMemory::RowIndex const& b,
+            size_t firstRegister) const {
     auto const& left = _input[a.first].get();
     auto const& right = _input[b.first].get();
-    for (auto const& reg : _sortRegisters) {
+    for (size_t i = firstRegister; i < _sortRegisters.size(); ++i) {
+      auto const& reg = _sortRegisters[i];
       AqlValue const& lhs = left->getValueReference(a.second, reg.reg);
       AqlValue const& rhs = right->getValueReference(b.second, reg.reg);
       int const cmp = AqlValue::Compare(_vpackOptions, lhs, rhs, true);
@@ -72,6 +84,99 @@ class OurLessThan {
   std::vector<SortRegister> const& _sortRegisters;
 };  // OurLessThan
 
+// a row together with the normalized value of its first sort register.
+// the normalized value consists of the type weight used by
+// AqlValue::Compare and a key that compares like the value itself. it only
+// exists for null, boolean and numeric values that can be compared exactly
+// as doubles. all other values are compared with AqlValue::Compare.
+struct NormalizedRow {
+  static constexpr std::uint8_t noKey = 0xff;
+
+  SortedRowsStorageBackendMemory::RowIndex index;
+  std::uint64_t key;
+  std::uint8_t weight;
+};
+
+// integers with a larger magnitude cannot be compared exactly as doubles
+constexpr std::uint64_t maxExactInteger = std::uint64_t(1) << 53;
+
+bool normalizeValue(AqlValue const& value, std::uint8_t& weight,
+                    std::uint64_t& key) {
+  if (value.isRange()) {
+    return false;
+  }
+  velocypack::Slice s = value.slice().resolveExternals();
+  if (s.isNone() || s.isNull()) {
+    weight = 0;
+    key = 0;
+    return true;
+  }
+  if (s.isBool()) {
+    weight = 1;
+    key = s.getBool() ? 1 : 0;
+    return true;
+  }
+
+  double d;
+  if (s.isDouble()) {
+    d = s.getDouble();
+    if (std::isnan(d)) {
+      return false;
+    }
+  } else if (s.isUInt()) {
+    std::uint64_t u = s.getUInt();
+    if (u > maxExactInteger) {
+      return false;
+    }
+    d = static_cast<double>(u);
+  } else if (s.isInteger()) {
+    std::int64_t i = s.getInt();
+    if (i > static_cast<std::int64_t>(maxExactInteger) ||
+        i < -static_cast<std::int64_t>(maxExactInteger)) {
+      return false;
+    }
+    d = static_cast<double>(i);
+  } else {
+    return false;
+  }
+
+  if (d == 0.0) {
+    // -0.0 and 0.0 compare equal
+    d = 0.0;
+  }
+  std::uint64_t bits;
+  std::memcpy(&bits, &d, sizeof(bits));
+  // map the bits so that the keys compare like the doubles
+  key = (bits & (std::uint64_t(1) << 63)) ? ~bits
+                                          : bits | (std::uint64_t(1) << 63);
+  weight = 2;
+  return true;
+}
+
+class NormalizedLessThan {
+ public:
+  NormalizedLessThan(OurLessThan const& lessThan, bool ascending) noexcept
+      : _lessThan(lessThan), _ascending(ascending) {}
+
+  bool operator()(NormalizedRow const& a, NormalizedRow const& b) const {
+    if (a.weight != NormalizedRow::noKey && b.weight != NormalizedRow::noKey) {
+      if (a.weight != b.weight) {
+        return (a.weight < b.weight) == _ascending;
+      }
+      if (a.key != b.key) {
+        return (a.key < b.key) == _ascending;
+      }
+      // first sort register is equal
+      return _lessThan.less(a.index, b.index, 1);
+    }
+    return _lessThan.less(a.index, b.index, 0);
+  }
+
+ private:
+  OurLessThan const& _lessThan;
+  bool const _ascending;
+};
+
 }  // namespace
 
 namespace arangodb::aql {
@@ -200,6 +305,44 @@ void SortedRowsStorageBackendMemory::doSorting() {
   // comparison function
   OurLessThan ourLessThan(_infos.vpackOptions(), _inputBlocks,
                           _infos.sortRegisters());
+
+  if (!_infos.sortRegisters().empty() && _rowIndexes.size() > 1) {
+    // normalize the values of the first sort register once, so that most
+    // comparisons do not need to go through AqlValue::Compare
+    ResourceUsageScope guard(_infos.getResourceMonitor(),
+                             _rowIndexes.size() * sizeof(NormalizedRow));
+    RegisterId firstRegister = _infos.sortRegisters()[0].reg;
+
+    std::vector<NormalizedRow> rows;
+    rows.reserve(_rowIndexes.size());
+    size_t numKeys = 0;
+    for (auto const& index : _rowIndexes) {
+      NormalizedRow& row = rows.emplace_back(
+          NormalizedRow{index, 0, NormalizedRow::noKey});
+      AqlValue const& value = _inputBlocks[index.first]->getValueReference(
+          index.second, firstRegister);
+      if (normalizeValue(value, row.weight, row.key)) {
+        ++numKeys;
+      } else {
+        row.weight = NormalizedRow::noKey;
+      }
+    }
+
+    if (numKeys > 0) {
+      NormalizedLessThan normalizedLessThan(ourLessThan,
+                                            _infos.sortRegisters()[0].asc);
+      if (_infos.stable()) {
+        std::stable_sort(rows.begin(), rows.end(), normalizedLessThan);
+      } else {
+        std::sort(rows.begin(), rows.end(), normalizedLessThan);
+      }
+      for (size_t i = 0; i < rows.size(); ++i) {
+        _rowIndexes[i] = rows[i].index;
+      }
+      return;
+    }
+  }
+
   if (_infos.stable()) {
     std::stable_sort(_rowIndexes.begin(), _rowIndexes.end(), ourLessThan);
   } else {
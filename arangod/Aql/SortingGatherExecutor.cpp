@@ -100,51 +100,157 @@ class OurLessThan {
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @class HeapSorting
-/// @brief "Heap" sorting strategy
+/// @brief "Heap" sorting strategy, implemented as a loser tree. only the
+/// dependency that produced the last row is compared against its path to the
+/// root, which takes log(n) comparisons per row. the sort keys of each
+/// dependency's current row are extracted only once
 ////////////////////////////////////////////////////////////////////////////////
-class HeapSorting final : public SortingGatherExecutor::SortingStrategy,
-                          private OurLessThan {
+class HeapSorting final : public SortingGatherExecutor::SortingStrategy {
  public:
   HeapSorting(arangodb::aql::QueryContext& query,
               std::vector<SortRegister>& sortRegisters) noexcept
-      : OurLessThan(query, sortRegisters) {}
+      : _resolver(query.resolver()),
+        _vpackOptions(query.vpackOptions()),
+        _sortRegisters(sortRegisters),
+        _blockPos(nullptr) {}
+
+  ~HeapSorting() { reset(); }
 
   virtual SortingGatherExecutor::ValueType nextValue() override {
-    TRI_ASSERT(!_heap.empty());
-    std::push_heap(_heap.begin(), _heap.end(), *this);  // re-insert element
-    std::pop_heap(_heap.begin(), _heap.end(),
-                  *this);  // remove element from _heap but not from vector
-    return _heap.back();
+    TRI_ASSERT(_blockPos != nullptr);
+    TRI_ASSERT(!_tree.empty());
+    if (_lastWinner.has_value()) {
+      // the row of the last winner has been replaced by its next row
+      size_t const dependency = _lastWinner.value();
+      extractKeys(dependency);
+      replay(dependency);
+    }
+    _lastWinner = _tree[0];
+    return (*_blockPos)[_tree[0]];
   }
 
   virtual void prepare(
       std::vector<SortingGatherExecutor::ValueType>& blockPos) override {
     TRI_ASSERT(!blockPos.empty());
+    reset();
+    _blockPos = &blockPos;
 
-    if (_heap.size() == blockPos.size()) {
-      return;
+    size_t const n = blockPos.size();
+    _keys.resize(n * _sortRegisters.size());
+    for (size_t dependency = 0; dependency < n; ++dependency) {
+      extractKeys(dependency);
     }
+    _tree.resize(n);
+    _tree[0] = (n == 1) ? 0 : build(1);
+  }
 
-    _heap.clear();
-    std::copy(blockPos.begin(), blockPos.end(), std::back_inserter(_heap));
-    std::make_heap(
-        _heap.begin(), _heap.end() - 1,
-        *this);  // remain last element out of heap to maintain invariant
-    TRI_ASSERT(!_heap.empty());
+  virtual void reset() noexcept override {
+    for (auto& key : _keys) {
+      key.release();
+    }
+    _keys.clear();
+    _tree.clear();
+    _lastWinner.reset();
+    _blockPos = nullptr;
   }
 
-  virtual void reset() noexcept override { _heap.clear(); }
+ private:
+  /// @brief sort key of a row, destroyed when replaced
+  struct Key {
+    AqlValue value;
+    bool mustDestroy = false;
+
+    void release() noexcept {
+      if (mustDestroy) {
+        value.destroy();
+        mustDestroy = false;
+      }
+      value = AqlValue();
+    }
+  };
+
+  void extractKeys(size_t dependency) {
+    auto const& row = (*_blockPos)[dependency].row;
+    Key* keys = _keys.data() + dependency * _sortRegisters.size();
+    for (size_t i = 0; i < _sortRegisters.size(); ++i) {
+      auto const& reg = _sortRegisters[i];
+      keys[i].release();
+      if (!row) {
+        continue;
+      }
+      AqlValue const& value = row.getValue(reg.reg);
+      if (reg.attributePath.empty()) {
+        // the value stays valid as long as the row
+        keys[i].value = value;
+      } else {
+        keys[i].value = value.get(_resolver, reg.attributePath,
+                                  keys[i].mustDestroy, false);
+      }
+    }
+  }
 
-  // The STL heap (regarding push_heap, pop_heap, make_heap) is a max heap, but
-  // we want a min heap!
-  bool operator()(SortingGatherExecutor::ValueType const& left,
-                  SortingGatherExecutor::ValueType const& right) const {
-    // Note that right and left are swapped!
-    return OurLessThan::operator()(right, left);
+  /// @brief whether the current row of dependency a is sorted before the one
+  /// of dependency b. dependencies without a row are sorted last, ties are
+  /// broken by the dependency index
+  bool before(size_t a, size_t b) const {
+    bool const hasA = (*_blockPos)[a].row.isInitialized();
+    bool const hasB = (*_blockPos)[b].row.isInitialized();
+    if (!hasA || !hasB) {
+      return hasA || (!hasB && a < b);
+    }
+    Key const* keysA = _keys.data() + a * _sortRegisters.size();
+    Key const* keysB = _keys.data() + b * _sortRegisters.size();
+    for (size_t i = 0; i < _sortRegisters.size(); ++i) {
+      int cmp = AqlValue::Compare(&_vpackOptions, keysA[i].value,
+                                  keysB[i].value, true);
+      if (cmp < 0) {
+        return _sortRegisters[i].asc;
+      } else if (cmp > 0) {
+        return !_sortRegisters[i].asc;
+      }
+    }
+    return a < b;
   }
 
- private:
-  std::vector<std::reference_wrapper<SortingGatherExecutor::ValueType>> _heap;
+  /// @brief builds the subtree of a node and returns its winner. the leaves
+  /// of the tree are the nodes n to 2n-1, one for each dependency
+  size_t build(size_t node) {
+    size_t const n = _tree.size();
+    if (node >= n) {
+      return node - n;
+    }
+    size_t left = build(2 * node);
+    size_t right = build(2 * node + 1);
+    if (before(right, left)) {
+      std::swap(left, right);
+    }
+    _tree[node] = right;
+    return left;
+  }
+
+  /// @brief updates the path from a dependency's leaf to the root
+  void replay(size_t dependency) {
+    size_t const n = _tree.size();
+    size_t winner = dependency;
+    for (size_t node = (dependency + n) / 2; node > 0; node /= 2) {
+      if (before(_tree[node], winner)) {
+        std::swap(_tree[node], winner);
+      }
+    }
+    _tree[0] = winner;
+  }
+
+  arangodb::CollectionNameResolver const& _resolver;
+  arangodb::velocypack::Options const& _vpackOptions;
+  std::vector<SortRegister>& _sortRegisters;
+  std::vector<SortingGatherExecutor::ValueType> const* _blockPos;
+  /// @brief sort keys of the current rows, for each dependency
+  std::vector<Key> _keys;
+  /// @brief _tree[0] is the overall winner, the other nodes contain the
+  /// loser of the match at that node
+  std::vector<size_t> _tree;
+  /// @brief dependency of the row returned last
+  std::optional<size_t> _lastWinner;
 };  // HeapSorting
 
 ////////////////////////////////////////////////////////////////////////////////
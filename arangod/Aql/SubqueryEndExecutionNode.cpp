@@ -56,7 +56,10 @@ SubqueryEndNode::SubqueryEndNode(ExecutionPlan* plan,
       _inVariable(
           Variable::varFromVPack(plan->getAst(), base, "inVariable", true)),
       _outVariable(
-          Variable::varFromVPack(plan->getAst(), base, "outVariable")) {}
+          Variable::varFromVPack(plan->getAst(), base, "outVariable")),
+      _memoizationStartNode(
+          basics::VelocyPackHelper::getNumericValue<ExecutionNodeId::BaseType>(
+              base, "memoizedBy", 0)) {}
 
 SubqueryEndNode::SubqueryEndNode(ExecutionPlan* plan, ExecutionNodeId id,
                                  Variable const* inVariable,
@@ -77,6 +80,10 @@ void SubqueryEndNode::doToVelocyPack(VPackBuilder& nodes,
     nodes.add(VPackValue("inVariable"));
     _inVariable->toVelocyPack(nodes);
   }
+
+  if (isMemoized()) {
+    nodes.add("memoizedBy", VPackValue(_memoizationStartNode.id()));
+  }
 }
 
 std::unique_ptr<ExecutionBlock> SubqueryEndNode::createBlock(
@@ -100,6 +107,10 @@ std::unique_ptr<ExecutionBlock> SubqueryEndNode::createBlock(
   auto const& vpackOptions = engine.getQuery().vpackOptions();
   auto executorInfos = SubqueryEndExecutorInfos(
       &vpackOptions, engine.getQuery().resourceMonitor(), inReg, outReg);
+  if (isMemoized()) {
+    executorInfos.setResultCache(
+        engine.subqueryResultCache(_memoizationStartNode));
+  }
 
   return std::make_unique<ExecutionBlockImpl<SubqueryEndExecutor>>(
       &engine, this, std::move(registerInfos), std::move(executorInfos));
@@ -119,6 +130,7 @@ ExecutionNode* SubqueryEndNode::clone(ExecutionPlan* plan,
   }
   auto c =
       std::make_unique<SubqueryEndNode>(plan, _id, inVariable, outVariable);
+  c->memoize(_memoizationStartNode);
 
   return cloneHelper(std::move(c), withDependencies, withProperties);
 }
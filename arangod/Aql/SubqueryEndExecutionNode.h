@@ -70,6 +70,16 @@ class SubqueryEndNode : public ExecutionNode {
 
   void replaceOutVariable(Variable const* var);
 
+  /// @brief memoize the results of the subquery, which starts at the
+  /// SubqueryStartNode with the given id
+  void memoize(ExecutionNodeId startNode) noexcept {
+    _memoizationStartNode = startNode;
+  }
+
+  bool isMemoized() const noexcept {
+    return static_cast<bool>(_memoizationStartNode);
+  }
+
   // We only override this to TRI_ASSERT(false), because
   // noone should ever ask this node whether it is a modification
   // node
@@ -82,6 +92,10 @@ class SubqueryEndNode : public ExecutionNode {
  private:
   Variable const* _inVariable;
   Variable const* _outVariable;
+
+  /// @brief id of the SubqueryStartNode of a memoized subquery, which owns
+  /// the memoization key
+  ExecutionNodeId _memoizationStartNode{0};
 };
 
 }  // namespace aql
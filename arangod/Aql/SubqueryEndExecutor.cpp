@@ -27,6 +27,7 @@
 #include "Aql/OutputAqlItemRow.h"
 #include "Aql/RegisterPlan.h"
 #include "Aql/SingleRowFetcher.h"
+#include "Aql/SubqueryResultCache.h"
 #include "Basics/ResourceUsage.h"
 #include "Basics/ScopeGuard.h"
 
@@ -73,6 +74,15 @@ arangodb::ResourceMonitor& SubqueryEndExecutorInfos::getResourceMonitor()
   return _resourceMonitor;
 }
 
+void SubqueryEndExecutorInfos::setResultCache(
+    std::shared_ptr<SubqueryResultCache> cache) {
+  _resultCache = std::move(cache);
+}
+
+SubqueryResultCache* SubqueryEndExecutorInfos::resultCache() const noexcept {
+  return _resultCache.get();
+}
+
 SubqueryEndExecutor::SubqueryEndExecutor(Fetcher&,
                                          SubqueryEndExecutorInfos& infos)
     : _infos(infos),
@@ -132,8 +142,23 @@ auto SubqueryEndExecutor::skipRowsRange(AqlItemBlockInputRange& input,
 
 auto SubqueryEndExecutor::consumeShadowRow(ShadowAqlItemRow shadowRow,
                                            OutputAqlItemRow& output) -> void {
+  SubqueryResultCache* cache = _infos.resultCache();
+  if (cache != nullptr) {
+    if (AqlValue const* cached = cache->finish(); cached != nullptr) {
+      // the SubqueryStartExecutor has not executed the subquery body for
+      // this row, as its result is known already
+      _accumulator.reset();
+      AqlValue value = cached->clone();
+      AqlValueGuard guard(value, true);
+      output.consumeShadowRow(_infos.getOutputRegister(), shadowRow, guard);
+      return;
+    }
+  }
   AqlValue value;
   AqlValueGuard guard = _accumulator.stealValue(value);
+  if (cache != nullptr) {
+    cache->store(value);
+  }
   output.consumeShadowRow(_infos.getOutputRegister(), shadowRow, guard);
 }
 
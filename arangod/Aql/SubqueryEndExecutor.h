@@ -33,6 +33,8 @@
 
 #include <velocypack/Builder.h>
 
+#include <memory>
+
 namespace arangodb {
 struct ResourceMonitor;
 
@@ -42,6 +44,7 @@ class NoStats;
 class OutputAqlItemRow;
 template<BlockPassthrough>
 class SingleRowFetcher;
+class SubqueryResultCache;
 
 class SubqueryEndExecutorInfos {
  public:
@@ -60,11 +63,17 @@ class SubqueryEndExecutorInfos {
   [[nodiscard]] RegisterId getInputRegister() const noexcept;
   [[nodiscard]] arangodb::ResourceMonitor& getResourceMonitor() const noexcept;
 
+  /// @brief memoize the results of the subquery in the cache, which is
+  /// shared with the SubqueryStartExecutor of the subquery
+  void setResultCache(std::shared_ptr<SubqueryResultCache> cache);
+  [[nodiscard]] SubqueryResultCache* resultCache() const noexcept;
+
  private:
   velocypack::Options const* _vpackOptions;
   arangodb::ResourceMonitor& _resourceMonitor;
   RegisterId const _outReg;
   RegisterId const _inReg;
+  std::shared_ptr<SubqueryResultCache> _resultCache;
 };
 
 class SubqueryEndExecutor {
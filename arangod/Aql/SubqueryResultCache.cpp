@@ -0,0 +1,165 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include "SubqueryResultCache.h"
+
+#include "Aql/AqlValueMaterializer.h"
+#include "Aql/InputAqlItemRow.h"
+#include "Basics/Exceptions.h"
+#include "Basics/ResourceUsage.h"
+#include "Basics/StaticStrings.h"
+#include "Basics/debugging.h"
+#include "Basics/voc-errors.h"
+
+#include <velocypack/Builder.h>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+namespace {
+// approximate memory used by a cache entry besides key and value
+constexpr std::size_t kEntryOverhead = sizeof(std::string) + sizeof(AqlValue) +
+                                       4 * sizeof(void*);
+
+// adds the value of the attribute path to the key. a missing attribute, or
+// an attribute of a non-object, is added as null, just like attribute access
+// in AQL returns it. the _id attribute of a document is a custom type and
+// only contains the collection, so its _key attribute is added as well
+void addAttributeValue(velocypack::Slice value,
+                       std::vector<std::string> const& path,
+                       velocypack::Builder& key) {
+  velocypack::Slice parent;
+  for (auto const& name : path) {
+    if (!value.isObject()) {
+      value = velocypack::Slice::nullSlice();
+      break;
+    }
+    parent = value;
+    value = value.get(name).resolveExternal();
+  }
+  if (value.isNone()) {
+    value = velocypack::Slice::nullSlice();
+  }
+  key.add(value);
+  if (value.isCustom()) {
+    TRI_ASSERT(parent.isObject());
+    velocypack::Slice k = parent.get(StaticStrings::KeyString);
+    key.add(k.isNone() ? velocypack::Slice::nullSlice() : k);
+  }
+}
+}  // namespace
+
+SubqueryResultCache::SubqueryResultCache(ResourceMonitor& resourceMonitor,
+                                         std::size_t maxMemoryUsage)
+    : _resourceMonitor(resourceMonitor), _maxMemoryUsage(maxMemoryUsage) {}
+
+SubqueryResultCache::~SubqueryResultCache() {
+  for (auto& it : _results) {
+    it.second.destroy();
+  }
+  _resourceMonitor.decreaseMemoryUsage(_memoryUsage);
+}
+
+void SubqueryResultCache::buildKey(InputAqlItemRow const& input,
+                                   std::vector<KeyPart> const& parts,
+                                   velocypack::Options const* options,
+                                   velocypack::Builder& key) {
+  key.clear();
+  key.openArray(/*unindexed*/ true);
+  for (auto const& part : parts) {
+    AqlValue const& value = input.getValue(part.reg);
+    if (part.attributes.empty()) {
+      value.toVelocyPack(options, key, /*resolveExternals*/ true,
+                         /*allowUnindexed*/ true);
+      continue;
+    }
+    AqlValueMaterializer materializer(options);
+    velocypack::Slice slice =
+        materializer.slice(value, /*resolveExternals*/ true);
+    for (auto const& path : part.attributes) {
+      addAttributeValue(slice, path, key);
+    }
+  }
+  key.close();
+}
+
+bool SubqueryResultCache::start(velocypack::Slice key) {
+  std::string k(key.startAs<char>(), key.byteSize());
+
+  std::lock_guard guard(_mutex);
+  bool found = _results.contains(k);
+  _pending.emplace_back(std::move(k));
+  return found;
+}
+
+AqlValue const* SubqueryResultCache::finish() {
+  std::lock_guard guard(_mutex);
+  TRI_ASSERT(!_pending.empty());
+  _storeCurrent = false;
+  if (_pending.empty()) {
+    return nullptr;
+  }
+  _current = std::move(_pending.front());
+  _pending.pop_front();
+
+  if (auto it = _results.find(_current); it != _results.end()) {
+    return &it->second;
+  }
+  _storeCurrent = !_full;
+  return nullptr;
+}
+
+void SubqueryResultCache::store(AqlValue const& result) {
+  std::lock_guard guard(_mutex);
+  if (!_storeCurrent) {
+    return;
+  }
+  _storeCurrent = false;
+
+  std::size_t usage = _current.size() + result.memoryUsage() + kEntryOverhead;
+  if (_memoryUsage + usage > _maxMemoryUsage) {
+    _full = true;
+    return;
+  }
+
+  try {
+    ResourceUsageScope scope(_resourceMonitor, usage);
+    AqlValue copy = result.clone();
+    AqlValueGuard copyGuard(copy, true);
+    _results.emplace(std::move(_current), copy);
+    copyGuard.steal();
+    scope.steal();
+    _memoryUsage += usage;
+  } catch (basics::Exception const& ex) {
+    if (ex.code() != TRI_ERROR_RESOURCE_LIMIT) {
+      throw;
+    }
+    // the query's memory limit would be exceeded. the query can still
+    // succeed without caching any more results
+    _full = true;
+  }
+}
+
+std::size_t SubqueryResultCache::memoryUsage() const noexcept {
+  std::lock_guard guard(_mutex);
+  return _memoryUsage;
+}
@@ -0,0 +1,115 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+#include "Aql/AqlValue.h"
+#include "Aql/types.h"
+
+#include <velocypack/Slice.h>
+
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace arangodb {
+struct ResourceMonitor;
+
+namespace velocypack {
+class Builder;
+struct Options;
+}  // namespace velocypack
+
+namespace aql {
+class InputAqlItemRow;
+
+/// @brief results of a spliced subquery, by the values of the outer query
+/// the subquery depends on. shared by the SubqueryStartExecutor, which looks
+/// up the key for each input row and skips the subquery body if the result
+/// is known, and the SubqueryEndExecutor, which returns the known result or
+/// stores the one just produced. the two executors may run on different
+/// threads, so all methods are protected by a mutex.
+/// results are never evicted, so that a result which the SubqueryStartExecutor
+/// has found is still there when the SubqueryEndExecutor needs it. once the
+/// memory limit is reached, no further results are stored.
+class SubqueryResultCache {
+ public:
+  /// @brief an input register the subquery depends on, and the attribute
+  /// paths of its value that are used. if there are no attribute paths, the
+  /// entire value is used
+  struct KeyPart {
+    RegisterId reg;
+    std::vector<std::vector<std::string>> attributes;
+  };
+
+  static constexpr std::size_t kMaxMemoryUsage = 16 * 1024 * 1024;
+
+  explicit SubqueryResultCache(ResourceMonitor& resourceMonitor,
+                               std::size_t maxMemoryUsage = kMaxMemoryUsage);
+  ~SubqueryResultCache();
+
+  SubqueryResultCache(SubqueryResultCache const&) = delete;
+  SubqueryResultCache& operator=(SubqueryResultCache const&) = delete;
+
+  /// @brief builds the key for the input row into the builder
+  static void buildKey(InputAqlItemRow const& input,
+                       std::vector<KeyPart> const& parts,
+                       velocypack::Options const* options,
+                       velocypack::Builder& key);
+
+  /// @brief registers the start of a subquery run for the key. returns true
+  /// if the result for the key is known, so the subquery body does not need
+  /// to be executed
+  bool start(velocypack::Slice key);
+
+  /// @brief finishes the oldest pending subquery run. returns its result if
+  /// it was known, and nullptr otherwise. in the latter case, the result of
+  /// the run is expected to be passed to store() next
+  AqlValue const* finish();
+
+  /// @brief stores the result of the run finished last, if the memory limit
+  /// allows it
+  void store(AqlValue const& result);
+
+  std::size_t memoryUsage() const noexcept;
+
+ private:
+  ResourceMonitor& _resourceMonitor;
+  std::size_t const _maxMemoryUsage;
+
+  mutable std::mutex _mutex;
+  /// @brief keys of the runs that have started but not finished, in order
+  std::deque<std::string> _pending;
+  /// @brief key of the run finished last, if its result needs to be stored
+  std::string _current;
+  bool _storeCurrent = false;
+  /// @brief whether the memory limit has been reached
+  bool _full = false;
+  std::unordered_map<std::string, AqlValue> _results;
+  std::size_t _memoryUsage = 0;
+};
+
+}  // namespace aql
+}  // namespace arangodb
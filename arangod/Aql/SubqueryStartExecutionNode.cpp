@@ -25,6 +25,7 @@
 #include "Aql/Ast.h"
 #include "Aql/ExecutionBlock.h"
 #include "Aql/ExecutionBlockImpl.tpp"
+#include "Aql/ExecutionEngine.h"
 #include "Aql/ExecutionNode.h"
 #include "Aql/ExecutionPlan.h"
 #include "Aql/Query.h"
@@ -44,6 +45,19 @@ SubqueryStartNode::SubqueryStartNode(ExecutionPlan* plan,
   // On purpose exclude the _subqueryOutVariable
   // A query cannot be explained after nodes have been serialized and
   // deserialized
+  if (VPackSlice memoize = base.get("memoize"); memoize.isArray()) {
+    _memoized = true;
+    for (VPackSlice part : VPackArrayIterator(memoize)) {
+      auto& keyPart = _memoizationKey.emplace_back(MemoizationKeyPart{
+          Variable::varFromVPack(plan->getAst(), part, "variable"), {}});
+      for (VPackSlice path : VPackArrayIterator(part.get("attributes"))) {
+        auto& attributes = keyPart.attributes.emplace_back();
+        for (VPackSlice name : VPackArrayIterator(path)) {
+          attributes.emplace_back(name.copyString());
+        }
+      }
+    }
+  }
 }
 
 CostEstimate SubqueryStartNode::estimateCost() const {
@@ -67,6 +81,28 @@ void SubqueryStartNode::doToVelocyPack(VPackBuilder& nodes,
     nodes.add(VPackValue("subqueryOutVariable"));
     _subqueryOutVariable->toVelocyPack(nodes);
   }
+
+  if (_memoized) {
+    nodes.add(VPackValue("memoize"));
+    nodes.openArray();
+    for (auto const& part : _memoizationKey) {
+      nodes.openObject();
+      nodes.add(VPackValue("variable"));
+      part.variable->toVelocyPack(nodes);
+      nodes.add(VPackValue("attributes"));
+      nodes.openArray();
+      for (auto const& path : part.attributes) {
+        nodes.openArray();
+        for (auto const& name : path) {
+          nodes.add(VPackValue(name));
+        }
+        nodes.close();
+      }
+      nodes.close();
+      nodes.close();
+    }
+    nodes.close();
+  }
 }
 
 std::unique_ptr<ExecutionBlock> SubqueryStartNode::createBlock(
@@ -78,10 +114,23 @@ std::unique_ptr<ExecutionBlock> SubqueryStartNode::createBlock(
   auto outputRegisters = std::make_shared<std::unordered_set<RegisterId>>();
 
   auto registerInfos = createRegisterInfos({}, {});
+  auto executorInfos = SubqueryStartExecutorInfos{registerInfos};
+
+  if (_memoized) {
+    std::vector<SubqueryResultCache::KeyPart> keyParts;
+    keyParts.reserve(_memoizationKey.size());
+    for (auto const& part : _memoizationKey) {
+      keyParts.emplace_back(SubqueryResultCache::KeyPart{
+          variableToRegisterId(part.variable), part.attributes});
+    }
+    executorInfos.setResultCache(engine.subqueryResultCache(id()),
+                                 std::move(keyParts),
+                                 &engine.getQuery().vpackOptions());
+  }
 
   // On purpose exclude the _subqueryOutVariable
   return std::make_unique<ExecutionBlockImpl<SubqueryStartExecutor>>(
-      &engine, this, registerInfos, RegisterInfos{registerInfos});
+      &engine, this, registerInfos, std::move(executorInfos));
 }
 
 ExecutionNode* SubqueryStartNode::clone(ExecutionPlan* plan,
@@ -89,9 +138,30 @@ ExecutionNode* SubqueryStartNode::clone(ExecutionPlan* plan,
                                         bool withProperties) const {
   // On purpose exclude the _subqueryOutVariable
   auto c = std::make_unique<SubqueryStartNode>(plan, _id, nullptr);
+  if (_memoized) {
+    auto key = _memoizationKey;
+    if (withProperties) {
+      for (auto& part : key) {
+        part.variable =
+            plan->getAst()->variables()->createVariable(part.variable);
+      }
+    }
+    c->memoize(std::move(key));
+  }
   return cloneHelper(std::move(c), withDependencies, withProperties);
 }
 
+void SubqueryStartNode::getVariablesUsedHere(VarSet& usedVars) const {
+  for (auto const& part : _memoizationKey) {
+    usedVars.emplace(part.variable);
+  }
+}
+
+void SubqueryStartNode::memoize(std::vector<MemoizationKeyPart> key) {
+  _memoized = true;
+  _memoizationKey = std::move(key);
+}
+
 bool SubqueryStartNode::isEqualTo(ExecutionNode const& other) const {
   // On purpose exclude the _subqueryOutVariable
   if (other.getType() != ExecutionNode::SUBQUERY_START) {
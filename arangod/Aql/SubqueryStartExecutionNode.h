@@ -27,6 +27,9 @@
 #include "Aql/ExecutionNodeId.h"
 #include "Aql/ExecutionPlan.h"
 
+#include <string>
+#include <vector>
+
 namespace arangodb {
 namespace aql {
 
@@ -37,6 +40,14 @@ class SubqueryStartNode : public ExecutionNode {
   friend class ExecutionBlock;
 
  public:
+  /// @brief a variable of the outer query the subquery depends on, and the
+  /// attribute paths of it that the subquery uses. if there are no attribute
+  /// paths, the subquery uses the variable's entire value
+  struct MemoizationKeyPart {
+    Variable const* variable;
+    std::vector<std::vector<std::string>> attributes;
+  };
+
   SubqueryStartNode(ExecutionPlan*, arangodb::velocypack::Slice const& base);
   SubqueryStartNode(ExecutionPlan* plan, ExecutionNodeId id,
                     Variable const* subqueryOutVariable)
@@ -57,6 +68,15 @@ class SubqueryStartNode : public ExecutionNode {
 
   bool isEqualTo(ExecutionNode const& other) const override final;
 
+  void getVariablesUsedHere(VarSet& usedVars) const override final;
+
+  /// @brief memoize the results of the subquery by the values described by
+  /// the key. the key is empty if the subquery does not depend on the outer
+  /// query at all
+  void memoize(std::vector<MemoizationKeyPart> key);
+
+  bool isMemoized() const noexcept { return _memoized; }
+
  protected:
   void doToVelocyPack(arangodb::velocypack::Builder&,
                       unsigned flags) const override final;
@@ -66,6 +86,11 @@ class SubqueryStartNode : public ExecutionNode {
   ///        it has no practical usage other then to print this information
   ///        during explain.
   Variable const* _subqueryOutVariable;
+
+  /// @brief whether the results of the subquery are memoized, by the values
+  /// described by _memoizationKey
+  bool _memoized = false;
+  std::vector<MemoizationKeyPart> _memoizationKey;
 };
 
 }  // namespace aql
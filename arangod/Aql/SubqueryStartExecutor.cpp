@@ -33,7 +33,45 @@
 using namespace arangodb;
 using namespace arangodb::aql;
 
-SubqueryStartExecutor::SubqueryStartExecutor(Fetcher&, Infos&) {}
+SubqueryStartExecutorInfos::SubqueryStartExecutorInfos(
+    RegisterInfos registerInfos)
+    : RegisterInfos(std::move(registerInfos)) {}
+
+void SubqueryStartExecutorInfos::setResultCache(
+    std::shared_ptr<SubqueryResultCache> cache,
+    std::vector<SubqueryResultCache::KeyPart> keyParts,
+    velocypack::Options const* options) {
+  _resultCache = std::move(cache);
+  _keyParts = std::move(keyParts);
+  _vpackOptions = options;
+}
+
+SubqueryResultCache* SubqueryStartExecutorInfos::resultCache() const noexcept {
+  return _resultCache.get();
+}
+
+std::vector<SubqueryResultCache::KeyPart> const&
+SubqueryStartExecutorInfos::keyParts() const noexcept {
+  return _keyParts;
+}
+
+velocypack::Options const* SubqueryStartExecutorInfos::vpackOptions()
+    const noexcept {
+  return _vpackOptions;
+}
+
+SubqueryStartExecutor::SubqueryStartExecutor(Fetcher&, Infos& infos)
+    : _infos(infos) {}
+
+auto SubqueryStartExecutor::startRun(InputAqlItemRow const& input) -> bool {
+  SubqueryResultCache* cache = _infos.resultCache();
+  if (cache == nullptr) {
+    return false;
+  }
+  SubqueryResultCache::buildKey(input, _infos.keyParts(),
+                                _infos.vpackOptions(), _keyBuilder);
+  return cache->start(_keyBuilder.slice());
+}
 
 auto SubqueryStartExecutor::produceRows(AqlItemBlockInputRange& input,
                                         OutputAqlItemRow& output)
@@ -47,8 +85,13 @@ auto SubqueryStartExecutor::produceRows(AqlItemBlockInputRange& input,
   if (input.hasDataRow()) {
     TRI_ASSERT(!output.isFull());
     std::tie(_upstreamState, _inputRow) = input.peekDataRow();
-    output.copyRow(_inputRow);
-    output.advanceRow();
+    if (!startRun(_inputRow)) {
+      output.copyRow(_inputRow);
+      output.advanceRow();
+    }
+    // otherwise the result is memoized, and the subquery body does not get
+    // any data row to work on. the SubqueryEndExecutor will fill in the
+    // result for the shadow row
     return {ExecutorState::DONE, NoStats{}, AqlCall{}};
   }
   return {input.upstreamState(), NoStats{}, AqlCall{}};
@@ -68,6 +111,9 @@ auto SubqueryStartExecutor::skipRowsRange(AqlItemBlockInputRange& input,
     // Do not consume the row.
     // It needs to be reported in Produce.
     std::tie(_upstreamState, _inputRow) = input.peekDataRow();
+    // the SubqueryEndExecutor expects a result cache entry for every shadow
+    // row, whether the subquery is skipped or not
+    std::ignore = startRun(_inputRow);
     call.didSkip(1);
     return {ExecutorState::DONE, NoStats{}, call.getSkipCount(), AqlCall{}};
   }
@@ -27,8 +27,14 @@
 #include "Aql/AqlItemBlockInputRange.h"
 #include "Aql/ExecutionState.h"
 #include "Aql/InputAqlItemRow.h"
+#include "Aql/RegisterInfos.h"
+#include "Aql/SubqueryResultCache.h"
 
+#include <velocypack/Builder.h>
+
+#include <memory>
 #include <utility>
+#include <vector>
 
 namespace arangodb {
 namespace aql {
@@ -36,9 +42,32 @@ namespace aql {
 template<BlockPassthrough allowsPassThrough>
 class SingleRowFetcher;
 class NoStats;
-class RegisterInfos;
 class OutputAqlItemRow;
 
+class SubqueryStartExecutorInfos : public RegisterInfos {
+ public:
+  using RegisterInfos::RegisterInfos;
+  // implicit, so that plain RegisterInfos can be used for subqueries that
+  // are not memoized
+  SubqueryStartExecutorInfos(RegisterInfos registerInfos);
+
+  /// @brief memoize the results of the subquery in the cache, by the values
+  /// described by the key parts
+  void setResultCache(std::shared_ptr<SubqueryResultCache> cache,
+                      std::vector<SubqueryResultCache::KeyPart> keyParts,
+                      velocypack::Options const* options);
+
+  [[nodiscard]] SubqueryResultCache* resultCache() const noexcept;
+  [[nodiscard]] std::vector<SubqueryResultCache::KeyPart> const& keyParts()
+      const noexcept;
+  [[nodiscard]] velocypack::Options const* vpackOptions() const noexcept;
+
+ private:
+  std::shared_ptr<SubqueryResultCache> _resultCache;
+  std::vector<SubqueryResultCache::KeyPart> _keyParts;
+  velocypack::Options const* _vpackOptions = nullptr;
+};
+
 class SubqueryStartExecutor {
  public:
   struct Properties {
@@ -49,7 +78,7 @@ class SubqueryStartExecutor {
   };
 
   using Fetcher = SingleRowFetcher<Properties::allowsBlockPassthrough>;
-  using Infos = RegisterInfos;
+  using Infos = SubqueryStartExecutorInfos;
   using Stats = NoStats;
   SubqueryStartExecutor(Fetcher&, Infos& infos);
   ~SubqueryStartExecutor() = default;
@@ -77,11 +106,21 @@ class SubqueryStartExecutor {
       -> size_t;
 
  private:
+  // registers the start of a subquery run for the input row with the result
+  // cache, if any. returns true if the result of the run is known already,
+  // so the subquery body does not need to be executed for the row
+  auto startRun(InputAqlItemRow const& input) -> bool;
+
+  Infos& _infos;
+
   // Upstream state, used to determine if we are done with all subqueries
   ExecutorState _upstreamState{ExecutorState::HASMORE};
 
   // Cache for the input row we are currently working on
   InputAqlItemRow _inputRow{CreateInvalidInputRowHint{}};
+
+  // key of the current input row in the result cache, reused across rows
+  velocypack::Builder _keyBuilder;
 };
 }  // namespace aql
 }  // namespace arangodb
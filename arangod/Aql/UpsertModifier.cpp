@@ -161,6 +161,7 @@ void UpsertModifier::reset() {
   _updateResults.reset();
 
   _operations.clear();
+  _updatedKeys.clear();
 
   resetResult();
 }
@@ -188,27 +189,47 @@ UpsertModifier::OperationType UpsertModifier::updateReplaceCase(
       return UpsertModifier::OperationType::SkipRow;
     }
 
-    if (updateDoc.isObject()) {
-      VPackSlice toUpdate = updateDoc.slice();
-      _keyDocBuilder.clear();
-
-      buildKeyDocument(_keyDocBuilder, key);
-      auto merger = VPackCollection::merge(toUpdate, _keyDocBuilder.slice(),
-                                           false, false);
-      accu.add(merger.slice());
-
-      return UpsertModifier::OperationType::UpdateReturnIfAvailable;
-    } else {
-      THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_ARANGO_DOCUMENT_TYPE_INVALID,
-                                     absl::StrCat("expecting 'Object', got: ",
-                                                  updateDoc.slice().typeName(),
-                                                  " while handling: UPSERT"));
+    if (_batchSize > 1 && !_updatedKeys.emplace(key).second) {
+      // the lookup of an earlier row of the batch has found the same
+      // document. the update of this row was computed without seeing the
+      // earlier row's update
+      if (!_infos._ignoreErrors) {
+        THROW_ARANGO_EXCEPTION_MESSAGE(
+            TRI_ERROR_ARANGO_CONFLICT,
+            absl::StrCat("document '", key,
+                         "' is modified by multiple input rows of the same "
+                         "batch of an UPSERT with readOwnWrites: false"));
+      }
+      return UpsertModifier::OperationType::SkipRow;
     }
+
+    return updateReplaceKey(accu, key, updateDoc);
   } else {
     return UpsertModifier::OperationType::CopyRow;
   }
 }
 
+UpsertModifier::OperationType UpsertModifier::updateReplaceKey(
+    ModificationExecutorAccumulator& accu, std::string const& key,
+    AqlValue const& updateDoc) {
+  if (updateDoc.isObject()) {
+    VPackSlice toUpdate = updateDoc.slice();
+    _keyDocBuilder.clear();
+
+    buildKeyDocument(_keyDocBuilder, key);
+    auto merger = VPackCollection::merge(toUpdate, _keyDocBuilder.slice(),
+                                         false, false);
+    accu.add(merger.slice());
+
+    return UpsertModifier::OperationType::UpdateReturnIfAvailable;
+  } else {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_ARANGO_DOCUMENT_TYPE_INVALID,
+                                   absl::StrCat("expecting 'Object', got: ",
+                                                updateDoc.slice().typeName(),
+                                                " while handling: UPSERT"));
+  }
+}
+
 UpsertModifier::OperationType UpsertModifier::insertCase(
     ModificationExecutorAccumulator& accu, AqlValue const& insertDoc) {
   if (insertDoc.isObject()) {
@@ -264,6 +285,10 @@ void UpsertModifier::accumulate(InputAqlItemRow& row) {
     auto updateDoc = row.getValue(updateReg);
     result = updateReplaceCase(_updateAccumulator, inDoc, updateDoc);
   } else {
+    // if an earlier row of the same batch inserts a document with the same
+    // key, the bulk insert fails with a unique constraint violation for
+    // this row. the row cannot be turned into an update, because its UPDATE
+    // expression was computed without the inserted document as OLD
     auto insertDoc = row.getValue(insertReg);
     result = insertCase(_insertAccumulator, insertDoc);
   }
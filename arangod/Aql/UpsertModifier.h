@@ -31,7 +31,9 @@
 #include "Aql/UpdateReplaceModifier.h"
 
 #include <mutex>
+#include <string>
 
+#include <absl/container/flat_hash_set.h>
 #include <velocypack/Builder.h>
 
 namespace arangodb::aql {
@@ -97,10 +99,12 @@ class UpsertModifier {
         _insertResults(Result(), infos._options),
 
         // Batch size has to be 1 so that the upsert modifier sees its own
-        // writes.
-        // This behaviour could be improved, if we can prove that an UPSERT
-        // does not need to see its own writes
-        _batchSize(1),
+        // writes. If the UPSERT does not need to see its own writes, the
+        // lookups for a whole batch of input rows are done before the
+        // documents of the batch are inserted and updated in bulk.
+        _batchSize(infos._options.readOwnWrites
+                       ? 1
+                       : ExecutionBlock::DefaultBatchSize),
         _resultState(ModificationExecutorResultState::NoResult) {}
 
   ~UpsertModifier() = default;
@@ -134,6 +138,9 @@ class UpsertModifier {
   OperationType updateReplaceCase(ModificationExecutorAccumulator& accu,
                                   AqlValue const& inDoc,
                                   AqlValue const& updateDoc);
+  OperationType updateReplaceKey(ModificationExecutorAccumulator& accu,
+                                 std::string const& key,
+                                 AqlValue const& updateDoc);
   OperationType insertCase(ModificationExecutorAccumulator& accu,
                            AqlValue const& insertDoc);
 
@@ -147,6 +154,14 @@ class UpsertModifier {
 
   arangodb::velocypack::Builder _keyDocBuilder;
 
+  // keys of the documents updated by the current batch. only used if the
+  // batch size is > 1. all lookups of a batch are done before any of its
+  // writes, so a later row of the batch that finds the same document would
+  // compute its update from an outdated OLD value. such rows fail with a
+  // conflict. (a later row that inserts a document with the same key as an
+  // earlier row of the batch fails with a unique constraint violation)
+  absl::flat_hash_set<std::string> _updatedKeys;
+
   size_t const _batchSize;
 
   mutable std::mutex _resultStateMutex;
@@ -34,6 +34,7 @@
 #include "Aql/SingleRowFetcher.h"
 #include "Basics/Exceptions.h"
 
+#include <algorithm>
 #include <utility>
 
 using namespace arangodb;
@@ -98,7 +99,11 @@ BaseWindowExecutor::AggregatorList BaseWindowExecutor::createAggregators(
 }
 
 BaseWindowExecutor::BaseWindowExecutor(Infos& infos)
-    : _infos(infos), _aggregators(createAggregators(infos)) {}
+    : _infos(infos),
+      _aggregators(createAggregators(infos)),
+      _aggregatorsSupportRemoval(std::all_of(
+          _aggregators.begin(), _aggregators.end(),
+          [](auto const& agg) { return agg->supportsRemoval(); })) {}
 
 BaseWindowExecutor::~BaseWindowExecutor() = default;
 
@@ -119,6 +124,25 @@ void BaseWindowExecutor::applyAggregators(InputAqlItemRow& input) {
   }
 }
 
+bool BaseWindowExecutor::removeFromAggregators(InputAqlItemRow& input) {
+  TRI_ASSERT(_aggregators.size() == _infos.getAggregatedRegisters().size());
+  size_t j = 0;
+  for (auto const& r : _infos.getAggregatedRegisters()) {
+    bool removed;
+    if (r.second.value() == RegisterId::maxRegisterId) {  // e.g. LENGTH / COUNT
+      removed = _aggregators[j]->remove(::EmptyValue);
+    } else {
+      removed =
+          _aggregators[j]->remove(input.getValue(/*inRegister*/ r.second));
+    }
+    if (!removed) {
+      return false;
+    }
+    ++j;
+  }
+  return true;
+}
+
 void BaseWindowExecutor::resetAggregators() {
   for (auto& agg : _aggregators) {
     agg->reset();
@@ -219,7 +243,13 @@ auto AccuWindowExecutor::skipRowsRange(AqlItemBlockInputRange& inputRange,
 // -------------- WindowExecutor --------------
 
 WindowExecutor::WindowExecutor(Fetcher& fetcher, Infos& infos)
-    : BaseWindowExecutor(infos) {}
+    : BaseWindowExecutor(infos) {
+  if (_aggregatorsSupportRemoval) {
+    for (auto& agg : _aggregators) {
+      agg->enableRemoval();
+    }
+  }
+}
 
 WindowExecutor::~WindowExecutor() = default;
 
@@ -305,6 +335,47 @@ void WindowExecutor::trimBounds() {
   }
 }
 
+void WindowExecutor::moveWindow(size_t start, size_t end) {
+  TRI_ASSERT(_aggregatorsSupportRemoval);
+  TRI_ASSERT(start <= end && end <= _rows.size());
+
+  bool recompute = start < _windowStart || start >= _windowEnd ||
+                   end < _windowEnd;
+  if (!recompute) {
+    // windows overlap. add the new rows, then remove the rows that left
+    for (size_t i = _windowEnd; i < end; ++i) {
+      applyAggregators(_rows[i]);
+    }
+    for (size_t i = _windowStart; i < start; ++i) {
+      if (!removeFromAggregators(_rows[i])) {
+        recompute = true;
+        break;
+      }
+    }
+  }
+
+  if (recompute) {
+    resetAggregators();
+    for (size_t i = start; i < end; ++i) {
+      applyAggregators(_rows[i]);
+    }
+  }
+  _windowStart = start;
+  _windowEnd = end;
+}
+
+void WindowExecutor::adjustWindow(size_t removedRows) {
+  if (removedRows <= _windowStart) {
+    _windowStart -= removedRows;
+    _windowEnd -= removedRows;
+  } else {
+    // rows of the window are gone. start over with the next window
+    resetAggregators();
+    _windowStart = 0;
+    _windowEnd = 0;
+  }
+}
+
 /**
  * @brief Produce rows.
  *   We need to consume all rows from the inputRange
@@ -334,29 +405,47 @@ std::tuple<ExecutorState, NoStats, AqlCall> WindowExecutor::produceRows(
               numFollowing + _currentIdx < _rows.size());
     };
 
-    // simon; Fairly inefficient aggregation loop, would need a better
-    // Aggregation API allowing removal of values to avoid re-scanning entire
-    // range
+    // if all aggregators support removal of values, the window is moved
+    // incrementally. otherwise the whole window is scanned for every row
     while (!output.isFull() && haveRows()) {
       size_t start =
           _currentIdx > numPreceding ? _currentIdx - numPreceding : 0;
       size_t end = std::min(_rows.size(), _currentIdx + numFollowing + 1);
 
-      while (start != end) {
-        applyAggregators(_rows[start]);
-        start++;
+      if (_aggregatorsSupportRemoval) {
+        moveWindow(start, end);
+        produceOutputRow(_rows[_currentIdx], output, /*reset*/ false);
+      } else {
+        while (start != end) {
+          applyAggregators(_rows[start]);
+          start++;
+        }
+        produceOutputRow(_rows[_currentIdx], output, /*reset*/ true);
       }
-      produceOutputRow(_rows[_currentIdx], output, /*reset*/ true);
       _currentIdx++;
     }
 
+    if (_aggregatorsSupportRemoval && _windowStart < _windowEnd) {
+      // remove the rows that are not part of the next window, so that
+      // trimBounds() can drop them without invalidating the window
+      size_t start =
+          _currentIdx > numPreceding ? _currentIdx - numPreceding : 0;
+      moveWindow(std::min(start, _windowEnd), _windowEnd);
+    }
+
+    size_t numRows = _rows.size();
     trimBounds();
+    if (_aggregatorsSupportRemoval) {
+      adjustWindow(numRows - _rows.size());
+    }
 
   } else {  // range based WINDOW
 
     TRI_ASSERT(_rows.size() == _windowRows.size());
 
-    // fairly inefficient loop, see comment above
+    // the window is moved incrementally if all aggregators support removal
+    // and the rows in the window are contiguous. otherwise the window is
+    // scanned for every row
     size_t offset = 0;
     while (!output.isFull() && _currentIdx < _rows.size()) {
       auto const& row = _windowRows[_currentIdx];
@@ -366,8 +455,10 @@ std::tuple<ExecutorState, NoStats, AqlCall> WindowExecutor::produceRows(
         continue;
       }
 
+      size_t const scanStart = offset;
       size_t i = offset;
       bool foundLimit = false;
+      bool contiguous = true;
       for (; i < _windowRows.size(); i++) {
         if (!row.valid) {
           continue;  // skip
@@ -378,24 +469,49 @@ std::tuple<ExecutorState, NoStats, AqlCall> WindowExecutor::produceRows(
             foundLimit = true;
             break;  // do not consider higher values
           }
-          applyAggregators(_rows[size_t(i)]);
+          if (!_aggregatorsSupportRemoval) {
+            applyAggregators(_rows[size_t(i)]);
+          }
         } else {
           // lower index have _windowRows[i].value < row.lowBound
+          contiguous = contiguous && i == offset;
           offset = i + 1;
         }
       }
 
       if (foundLimit || state == ExecutorState::DONE) {
-        produceOutputRow(_rows[_currentIdx], output, /*reset*/ true);
+        bool reset = true;
+        if (_aggregatorsSupportRemoval) {
+          if (contiguous) {
+            moveWindow(offset, i);
+            reset = false;
+          } else {
+            resetAggregators();
+            _windowStart = 0;
+            _windowEnd = 0;
+            for (size_t j = scanStart; j < i; j++) {
+              if (row.lowBound <= _windowRows[j].value) {
+                applyAggregators(_rows[j]);
+              }
+            }
+          }
+        }
+        produceOutputRow(_rows[_currentIdx], output, reset);
         _currentIdx++;
         continue;
       }
       TRI_ASSERT(state == ExecutorState::HASMORE);
-      resetAggregators();
+      if (!_aggregatorsSupportRemoval) {
+        resetAggregators();
+      }
       break;  // need more data from upstream
     }
 
+    size_t numRows = _rows.size();
     trimBounds();
+    if (_aggregatorsSupportRemoval) {
+      adjustWindow(numRows - _rows.size());
+    }
   }
 
   if (_currentIdx < _rows.size()) {
@@ -427,7 +543,11 @@ WindowExecutor::skipRowsRange(AqlItemBlockInputRange& inputRange,
       call.didSkip(1);
     }
 
+    size_t numRows = _rows.size();
     trimBounds();
+    if (_aggregatorsSupportRemoval) {
+      adjustWindow(numRows - _rows.size());
+    }
   }
 
   ExecutorState state = inputRange.upstreamState();
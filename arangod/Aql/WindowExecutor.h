@@ -110,6 +110,9 @@ class BaseWindowExecutor {
       BaseWindowExecutor::Infos const& infos);
 
   void applyAggregators(InputAqlItemRow& input);
+  /// @brief removes the row from all aggregators. returns false if at least
+  /// one aggregator could not remove it, and must be recomputed
+  bool removeFromAggregators(InputAqlItemRow& input);
   void resetAggregators();
   void produceOutputRow(InputAqlItemRow& input, OutputAqlItemRow& output,
                         bool reset);
@@ -119,6 +122,8 @@ class BaseWindowExecutor {
  protected:
   Infos const& _infos;
   AggregatorList _aggregators;
+  /// @brief whether all aggregators support removing values
+  bool const _aggregatorsSupportRemoval;
 };
 
 /**
@@ -230,6 +235,11 @@ class WindowExecutor : public BaseWindowExecutor {
  private:
   ExecutorState consumeInputRange(AqlItemBlockInputRange& input);
   void trimBounds();
+  /// @brief updates the aggregators so that they contain the rows
+  /// [start, end), reusing the rows they already contain where possible
+  void moveWindow(size_t start, size_t end);
+  /// @brief adjusts the window after trimBounds() removed rows
+  void adjustWindow(size_t removedRows);
 
  private:
   /// @brief consumed rows that we need to keep track of
@@ -238,6 +248,10 @@ class WindowExecutor : public BaseWindowExecutor {
   std::deque<WindowBounds::Row> _windowRows;
   /// @brief index of row we need to copy to output next
   size_t _currentIdx = 0;
+  /// @brief the rows [_windowStart, _windowEnd) are currently contained in
+  /// the aggregators. only used if all aggregators support removal
+  size_t _windowStart = 0;
+  size_t _windowEnd = 0;
 };
 
 }  // namespace aql
@@ -53,7 +53,12 @@ constexpr std::string_view jwtString("JWT");
 }  // namespace
 
 auth::TokenCache::TokenCache(auth::UserManager* um, double timeout)
-    : _userManager(um), _jwtCache(16384), _authTimeout(timeout) {}
+    : _userManager(um), _authTimeout(timeout) {
+  for (auto& shard : _jwtCache) {
+    shard = std::make_unique<JwtCacheShard>(kJwtCacheShardSize,
+                                            kJwtRejectedShardSize);
+  }
+}
 
 auth::TokenCache::~TokenCache() {
   // properly clear structs while using the appropriate locks
@@ -61,10 +66,7 @@ auth::TokenCache::~TokenCache() {
     WRITE_LOCKER(readLocker, _basicLock);
     _basicCache.clear();
   }
-  {
-    WRITE_LOCKER(writeLocker, _jwtSecretLock);
-    _jwtCache.clear();
-  }
+  clearJwtCache();
 }
 
 #ifndef USE_ENTERPRISE
@@ -110,6 +112,19 @@ auth::TokenCache::Entry auth::TokenCache::checkAuthentication(
   }
 }
 
+auth::TokenCache::JwtCacheShard& auth::TokenCache::jwtCacheShard(
+    std::string const& jwt) const noexcept {
+  return *_jwtCache[std::hash<std::string>{}(jwt) % kJwtCacheShards];
+}
+
+void auth::TokenCache::clearJwtCache() {
+  for (auto& shard : _jwtCache) {
+    std::lock_guard<std::mutex> guard(shard->mutex);
+    shard->cache.clear();
+    shard->rejected.clear();
+  }
+}
+
 void auth::TokenCache::invalidateBasicCache() {
   WRITE_LOCKER(guard, _basicLock);
   _basicCache.clear();
@@ -180,18 +195,19 @@ auth::TokenCache::Entry auth::TokenCache::checkAuthenticationBasic(
 
 auth::TokenCache::Entry auth::TokenCache::checkAuthenticationJWT(
     std::string const& jwt) {
-  // note that we need the write lock here because it is an LRU
-  // cache. reading from it will move the read entry to the start of
-  // the cache's linked list. so acquiring just a read-lock is
-  // insufficient!!
+  JwtCacheShard& shard = jwtCacheShard(jwt);
+
+  // note that we need the mutex here because it is an LRU cache. reading
+  // from it will move the read entry to the start of the cache's linked
+  // list. so acquiring just a read-lock is insufficient!!
   {
-    std::lock_guard<std::mutex> guard(_jwtCacheMutex);
+    std::lock_guard<std::mutex> guard(shard.mutex);
     // intentionally copy the entry from the cache
-    auth::TokenCache::Entry const* entry = _jwtCache.get(jwt);
+    auth::TokenCache::Entry const* entry = shard.cache.get(jwt);
     if (entry != nullptr) {
       // would have thrown if not found
       if (entry->expired()) {
-        _jwtCache.remove(jwt);
+        shard.cache.remove(jwt);
         LOG_TOPIC("65e15", TRACE, Logger::AUTHENTICATION)
             << "JWT Token expired";
         return auth::TokenCache::Entry::Unauthenticated();
@@ -202,12 +218,31 @@ auth::TokenCache::Entry auth::TokenCache::checkAuthenticationJWT(
       }
       return *entry;
     }
+
+    double const* rejectedUntil = shard.rejected.get(jwt);
+    if (rejectedUntil != nullptr) {
+      if (*rejectedUntil >= TRI_microtime()) {
+        return auth::TokenCache::Entry::Unauthenticated();
+      }
+      // a failed verification timed out. verify the token again
+      shard.rejected.remove(jwt);
+    }
   }
+
+  // remember tokens that can never become valid with the current secret.
+  // they go into a separate, smaller LRU, so that a flood of invalid tokens
+  // cannot evict the entries of valid tokens
+  auto const rejectToken = [&]() {
+    std::lock_guard<std::mutex> guard(shard.mutex);
+    shard.rejected.put(jwt, TRI_microtime() + kJwtNegativeCacheTimeout);
+    return auth::TokenCache::Entry::Unauthenticated();
+  };
+
   std::vector<std::string> const parts = StringUtils::split(jwt, '.');
   if (parts.size() != 3) {
     LOG_TOPIC("94a73", TRACE, arangodb::Logger::AUTHENTICATION)
         << "Secret contains " << parts.size() << " parts";
-    return auth::TokenCache::Entry::Unauthenticated();
+    return rejectToken();
   }
 
   std::string const& header = parts[0];
@@ -217,14 +252,17 @@ auth::TokenCache::Entry auth::TokenCache::checkAuthenticationJWT(
   if (!validateJwtHeader(header)) {
     LOG_TOPIC("2eb8a", TRACE, arangodb::Logger::AUTHENTICATION)
         << "Couldn't validate jwt header: SENSITIVE_DETAILS_HIDDEN";
-    return auth::TokenCache::Entry::Unauthenticated();
+    return rejectToken();
   }
 
   std::string const message = header + "." + body;
+#ifdef ARANGODB_USE_GOOGLE_TESTS
+  _testNumJwtSignatureChecks.fetch_add(1, std::memory_order_relaxed);
+#endif
   if (!validateJwtHMAC256Signature(message, signature)) {
     LOG_TOPIC("176c4", TRACE, arangodb::Logger::AUTHENTICATION)
         << "Couldn't validate jwt signature against given secret";
-    return auth::TokenCache::Entry::Unauthenticated();
+    return rejectToken();
   }
 
   auth::TokenCache::Entry newEntry = validateJwtBody(body);
@@ -235,8 +273,8 @@ auth::TokenCache::Entry auth::TokenCache::checkAuthenticationJWT(
   }
 
   {
-    std::lock_guard<std::mutex> guard(_jwtCacheMutex);
-    _jwtCache.put(jwt, newEntry);
+    std::lock_guard<std::mutex> guard(shard.mutex);
+    shard.cache.put(jwt, newEntry);
   }
   return newEntry;
 }
@@ -402,4 +440,6 @@ bool auth::TokenCache::validateJwtHMAC256Signature(
 void auth::TokenCache::generateSuperToken() {
   std::string sid = ServerState::instance()->getId();
   _jwtSuperToken = fuerte::jwt::generateInternalToken(jwtSecret(), sid);
+  // the secrets have changed, so cached verification results may be wrong
+  clearJwtCache();
 }
@@ -35,7 +35,9 @@
 #include <velocypack/Builder.h>
 #include <velocypack/Slice.h>
 
+#include <array>
 #include <atomic>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <unordered_map>
@@ -112,6 +114,13 @@ class TokenCache {
 
   std::string jwtSecret() const;
 
+#ifdef ARANGODB_USE_GOOGLE_TESTS
+  /// number of JWT signatures verified so far, only used for testing
+  uint64_t testNumJwtSignatureChecks() const noexcept {
+    return _testNumJwtSignatureChecks.load(std::memory_order_relaxed);
+  }
+#endif
+
  private:
   /// Check basic HTTP Authentication header
   TokenCache::Entry checkAuthenticationBasic(std::string const& secret);
@@ -143,8 +152,38 @@ class TokenCache {
   std::string _jwtActiveSecret;
   std::string _jwtSuperToken;  /// token for internal use
 
-  mutable std::mutex _jwtCacheMutex;
-  arangodb::basics::LruCache<std::string, TokenCache::Entry> _jwtCache;
+  /// the JWT cache is split into shards, each with its own mutex and LRU
+  /// list, so that concurrent requests rarely wait for each other. every
+  /// lookup modifies the LRU list, so a read-write lock would not help
+  struct alignas(64) JwtCacheShard {
+    JwtCacheShard(std::size_t capacity, std::size_t rejectedCapacity)
+        : cache(capacity), rejected(rejectedCapacity) {}
+
+    std::mutex mutex;
+    /// tokens that were verified successfully
+    arangodb::basics::LruCache<std::string, TokenCache::Entry> cache;
+    /// tokens that failed verification, with the time until which they are
+    /// rejected without verifying them again
+    arangodb::basics::LruCache<std::string, double> rejected;
+  };
+
+  /// shard of the JWT cache that holds the token
+  JwtCacheShard& jwtCacheShard(std::string const& jwt) const noexcept;
+  /// remove all entries from the JWT cache
+  void clearJwtCache();
+
+  static constexpr std::size_t kJwtCacheShards = 16;
+  /// number of valid tokens per shard
+  static constexpr std::size_t kJwtCacheShardSize = 1024;
+  /// number of rejected tokens per shard
+  static constexpr std::size_t kJwtRejectedShardSize = 64;
+  /// tokens that failed verification are remembered for this many seconds,
+  /// so that repeated attempts with them do not verify the signature again
+  static constexpr double kJwtNegativeCacheTimeout = 60.0;
+  std::array<std::unique_ptr<JwtCacheShard>, kJwtCacheShards> _jwtCache;
+#ifdef ARANGODB_USE_GOOGLE_TESTS
+  std::atomic<uint64_t> _testNumJwtSignatureChecks{0};
+#endif
 
   /// Timeout in seconds
   double const _authTimeout;
@@ -63,6 +63,10 @@ bool BucketState::lock(std::uint64_t maxTries) noexcept {
                                                     std::memory_order_acq_rel,
                                                     std::memory_order_relaxed);
       if (success) {
+        // optimistic readers may read the protected data concurrently. they
+        // must not see any of the following modifications without also
+        // seeing the lock bit when they validate their read
+        std::atomic_thread_fence(std::memory_order_release);
         return true;
       }
     }
@@ -75,7 +79,11 @@ bool BucketState::lock(std::uint64_t maxTries) noexcept {
 
 void BucketState::unlock() noexcept {
   TRI_ASSERT(isLocked());
-  _state.fetch_and(static_cast<FlagType>(~static_cast<FlagType>(Flag::locked)),
+  // clears the lock bit and increases the version in one go: the lock bit is
+  // set, so adding (kVersionIncrement - locked) carries into the version bits
+  // without touching the other flags
+  _state.fetch_add(static_cast<FlagType>(kVersionIncrement -
+                                         static_cast<FlagType>(Flag::locked)),
                    std::memory_order_release);
 }
 
@@ -92,6 +100,20 @@ void BucketState::toggleFlag(BucketState::Flag flag) noexcept {
 
 void BucketState::clear() noexcept {
   TRI_ASSERT(isLocked());
-  _state = static_cast<FlagType>(Flag::locked);
+  // keep the version, so that concurrent optimistic reads notice the change
+  _state = static_cast<FlagType>(
+      (_state.load() & ~static_cast<FlagType>(kVersionIncrement - 1)) |
+      static_cast<FlagType>(Flag::locked));
+}
+
+BucketState::FlagType BucketState::beginOptimisticRead() const noexcept {
+  return _state.load(std::memory_order_acquire);
+}
+
+bool BucketState::validateOptimisticRead(FlagType snapshot) const noexcept {
+  // order the preceding reads of the protected data before the reload
+  std::atomic_thread_fence(std::memory_order_acquire);
+  return !isSet(snapshot, Flag::locked) &&
+         _state.load(std::memory_order_relaxed) == snapshot;
 }
 }  // namespace arangodb::cache
@@ -41,6 +41,12 @@ namespace arangodb::cache {
 /// state is locked and, of course, to lock it. Any flags besides the lock flag
 /// are treated uniformly, and can be checked or toggled. Each flag is defined
 /// via an enum and must correspond to exactly one set bit.
+///
+/// The bits above the flags hold a version counter, which is increased
+/// whenever the state is unlocked. This allows optimistic (seqlock-style)
+/// reads without locking: a reader takes a snapshot of the state, reads the
+/// protected data, and then validates that the state has neither been
+/// locked nor changed in the meantime.
 ////////////////////////////////////////////////////////////////////////////////
 struct BucketState {
   //////////////////////////////////////////////////////////////////////////////
@@ -60,6 +66,12 @@ struct BucketState {
 
   using FlagType = std::underlying_type<Flag>::type;
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Increment of the version counter in the bits above the flags.
+  //////////////////////////////////////////////////////////////////////////////
+  static constexpr FlagType kVersionIncrement = 0x0008;
+  static_assert(static_cast<FlagType>(Flag::migrated) < kVersionIncrement);
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief Initializes state with no flags set and unlocked
   //////////////////////////////////////////////////////////////////////////////
@@ -122,6 +134,27 @@ struct BucketState {
   //////////////////////////////////////////////////////////////////////////////
   void clear() noexcept;
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Starts an optimistic read without locking the state. Returns a
+  /// snapshot of the state, which must be handed to validateOptimisticRead()
+  /// after reading the protected data.
+  //////////////////////////////////////////////////////////////////////////////
+  FlagType beginOptimisticRead() const noexcept;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Checks whether the data read since beginOptimisticRead() returned
+  /// the snapshot is consistent, i.e. the state was not locked at the start of
+  /// the read and has not been locked since then.
+  //////////////////////////////////////////////////////////////////////////////
+  bool validateOptimisticRead(FlagType snapshot) const noexcept;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Checks whether the given flag is set in a snapshot of the state.
+  //////////////////////////////////////////////////////////////////////////////
+  static bool isSet(FlagType snapshot, BucketState::Flag flag) noexcept {
+    return (snapshot & static_cast<FlagType>(flag)) != 0;
+  }
+
  private:
   std::atomic<FlagType> _state;
 };
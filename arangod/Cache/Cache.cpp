@@ -65,7 +65,8 @@ Cache::Cache(
           std::chrono::steady_clock::now().time_since_epoch().count()),
       _resizeRequestTime(
           std::chrono::steady_clock::now().time_since_epoch().count()),
-      _enableWindowedStats(enableWindowedStats) {
+      _enableWindowedStats(enableWindowedStats),
+      _enableAdmissionFilter(manager->admissionFilterEnabled()) {
   TRI_ASSERT(_table != nullptr);
   _table->setTypeSpecifics(_bucketClearer, _slotsPerBucket);
   _table->enable();
@@ -93,6 +94,10 @@ Cache::~Cache() {
     memoryUsage += sizeof(decltype(_evictionStats)::element_type);
   }
 
+  if (_sketch != nullptr) {
+    memoryUsage += _sketch->memoryUsage();
+  }
+
   _manager->adjustGlobalAllocation(-static_cast<std::int64_t>(memoryUsage));
 }
 
@@ -404,6 +409,29 @@ bool Cache::reportInsert(bool hadEviction) {
   return shouldMigrate;
 }
 
+void Cache::recordAccess(std::uint32_t hash) noexcept {
+  if (!_enableAdmissionFilter) {
+    return;
+  }
+  if (FrequencySketch* sketch = ensureSketch(); sketch != nullptr) {
+    sketch->record(hash);
+  }
+}
+
+bool Cache::admit(std::uint32_t hash, std::uint32_t victimHash) noexcept {
+  if (!_enableAdmissionFilter) {
+    return true;
+  }
+  FrequencySketch* sketch = ensureSketch();
+  if (sketch == nullptr) {
+    return true;
+  }
+  // only replace the victim if the new value is more popular. this keeps
+  // frequently accessed values in the cache during scans over many keys
+  // that are each accessed only once
+  return sketch->estimate(hash) > sketch->estimate(victimHash);
+}
+
 void Cache::ensureFindStats() {
   absl::call_once(_findStatsOnceFlag, [this]() {
     TRI_ASSERT(!_findStatsCreated.load(std::memory_order_relaxed));
@@ -438,6 +466,21 @@ void Cache::ensureEvictionStats() {
   TRI_ASSERT(_evictionStats != nullptr);
 }
 
+FrequencySketch* Cache::ensureSketch() noexcept {
+  TRI_ASSERT(_enableAdmissionFilter);
+  absl::call_once(_sketchOnceFlag, [this]() noexcept {
+    try {
+      _sketch =
+          std::make_unique<FrequencySketch>(Manager::kAdmissionSketchCounters);
+      _manager->adjustGlobalAllocation(
+          static_cast<std::int64_t>(_sketch->memoryUsage()));
+    } catch (...) {
+      // in case we run out of memory, we simply admit all values
+    }
+  });
+  return _sketch.get();
+}
+
 Metadata& Cache::metadata() { return _metadata; }
 
 std::shared_ptr<Table> Cache::table() const {
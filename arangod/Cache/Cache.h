@@ -30,6 +30,7 @@
 #include "Cache/Common.h"
 #include "Cache/Finding.h"
 #include "Cache/FrequencyBuffer.h"
+#include "Cache/FrequencySketch.h"
 #include "Cache/Manager.h"
 #include "Cache/ManagerTasks.h"
 #include "Cache/Metadata.h"
@@ -40,6 +41,8 @@
 #include <functional>
 #include <limits>
 #include <memory>
+#include <string>
+#include <vector>
 
 #include <absl/base/call_once.h>
 
@@ -103,6 +106,7 @@ class Cache : public std::enable_shared_from_this<Cache> {
   virtual ::ErrorCode insert(CachedValue* value) = 0;
   virtual ::ErrorCode remove(void const* key, std::uint32_t keySize) = 0;
   virtual ::ErrorCode banish(void const* key, std::uint32_t keySize) = 0;
+  virtual std::vector<std::string> recentKeys(std::size_t maxKeys) = 0;
 
   // inform the manager about additional (global) memory usage.
   // this is necessary so that the cache does not only count its own memory,
@@ -244,6 +248,13 @@ class Cache : public std::enable_shared_from_this<Cache> {
 
   bool reportInsert(bool hadEviction);
 
+  // TinyLFU admission filter. recordAccess() must be called for every
+  // lookup. admit() returns whether a new value with the given hash should
+  // replace the eviction victim with victimHash. both are no-ops if the
+  // admission filter is turned off
+  void recordAccess(std::uint32_t hash) noexcept;
+  bool admit(std::uint32_t hash, std::uint32_t victimHash) noexcept;
+
   // management
   Metadata& metadata();
   std::shared_ptr<Table> table() const;
@@ -294,6 +305,7 @@ class Cache : public std::enable_shared_from_this<Cache> {
 
  private:
   void ensureEvictionStats();
+  FrequencySketch* ensureSketch() noexcept;
 
   // manage the actual table - note: MUST be used only with atomic_load and
   // atomic_store!
@@ -339,6 +351,14 @@ class Cache : public std::enable_shared_from_this<Cache> {
 
   bool const _enableWindowedStats;
 
+  bool const _enableAdmissionFilter;
+  // this is a control variable that ensures that the _sketch is created
+  // lazily and exactly once per Cache object.
+  absl::once_flag _sketchOnceFlag;
+  // access frequencies for the admission filter. only created if
+  // _enableAdmissionFilter is set. may be a nullptr if creation failed
+  std::unique_ptr<FrequencySketch> _sketch;
+
   static constexpr std::uint64_t kEvictionMask =
       4095;  // check roughly every 4096 insertions
   static constexpr double kEvictionRateThreshold =
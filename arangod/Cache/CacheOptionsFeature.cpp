@@ -177,6 +177,29 @@ try to free up memory by evicting the oldest entries.)")
               arangodb::options::Flags::OnDBServer,
               arangodb::options::Flags::OnSingle))
       .setIntroducedIn(31200);
+
+  options
+      ->addOption("--cache.admission-filter",
+                  "Whether to only admit new entries into a full in-memory "
+                  "cache bucket if they are accessed more often than the "
+                  "entry they replace.",
+                  new BooleanParameter(&_options.enableAdmissionFilter),
+                  arangodb::options::makeFlags(
+                      arangodb::options::Flags::Uncommon,
+                      arangodb::options::Flags::DefaultNoComponents,
+                      arangodb::options::Flags::OnDBServer,
+                      arangodb::options::Flags::OnSingle))
+      .setIntroducedIn(31200)
+      .setLongDescription(R"(If enabled, each cache estimates how often keys
+have been looked up recently, using a small frequency sketch (TinyLFU). When
+a new entry is to be stored in a full cache bucket, it only replaces the
+least recently used entry of the bucket if the new entry's key has been
+looked up more often recently.
+
+This protects frequently used entries from being evicted by large scans over
+many keys that are each looked up only once, e.g. by batch traversals. The
+downside is that entries that are inserted without being looked up before
+are only stored in buckets that have free slots.)");
 }
 
 void CacheOptionsFeature::validateOptions(
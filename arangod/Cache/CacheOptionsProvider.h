@@ -55,6 +55,9 @@ struct CacheOptions {
   // whether or not we want recent hit rates. if this is turned off,
   // we only get global hit rates over the entire lifetime of a cache
   bool enableWindowedStats = true;
+  // whether new values are only admitted into a full cache bucket if they
+  // have recently been accessed more often than the value they replace
+  bool enableAdmissionFilter = false;
 };
 
 struct CacheOptionsProvider {
@@ -0,0 +1,145 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "Basics/debugging.h"
+
+namespace arangodb::cache {
+
+/// @brief Lockless count-min sketch to estimate how often a key has been
+/// accessed recently (TinyLFU).
+///
+/// Each key hash is mapped to one 4-bit counter in each of kDepth rows. The
+/// estimate for a key is the minimum of its counters. Counters are packed
+/// into 64-bit words, 16 counters per word. After a number of recorded
+/// accesses proportional to the sketch size, all counters are halved, so
+/// that the estimates reflect recent accesses only.
+class FrequencySketch {
+ public:
+  static constexpr std::size_t kDepth = 4;
+  static constexpr std::uint8_t kMaxCount = 15;
+
+  /// @brief Initialize with (at least) the given number of counters per row.
+  explicit FrequencySketch(std::size_t counters)
+      : _words(powerOf2(std::max<std::size_t>(counters / 16, 1))),
+        _mask(_words - 1),
+        _sampleSize(10 * 16 * _words),
+        _table(_words * kDepth),
+        _additions(0) {
+    for (auto& word : _table) {
+      word.store(0, std::memory_order_relaxed);
+    }
+  }
+
+  /// @brief Reports the hidden allocation size (not captured by sizeof).
+  static std::size_t allocationSize(std::size_t counters) {
+    return powerOf2(std::max<std::size_t>(counters / 16, 1)) * kDepth *
+           sizeof(std::uint64_t);
+  }
+
+  /// @brief Reports the memory usage in bytes.
+  std::size_t memoryUsage() const noexcept {
+    return _table.size() * sizeof(std::uint64_t) + sizeof(FrequencySketch);
+  }
+
+  /// @brief Record an access to the key with the given hash.
+  void record(std::uint32_t hash) noexcept {
+    bool added = false;
+    for (std::size_t row = 0; row < kDepth; ++row) {
+      auto [index, shift] = position(hash, row);
+      auto& word = _table[index];
+      std::uint64_t current = word.load(std::memory_order_relaxed);
+      while (((current >> shift) & 0xfULL) < kMaxCount) {
+        if (word.compare_exchange_weak(current, current + (1ULL << shift),
+                                       std::memory_order_relaxed)) {
+          added = true;
+          break;
+        }
+      }
+    }
+
+    if (added && _additions.fetch_add(1, std::memory_order_relaxed) + 1 ==
+                     _sampleSize) {
+      // only one thread sees the exact sample size
+      age();
+    }
+  }
+
+  /// @brief Returns the estimated number of recent accesses to the key with
+  /// the given hash (at most kMaxCount).
+  std::uint8_t estimate(std::uint32_t hash) const noexcept {
+    std::uint8_t result = kMaxCount;
+    for (std::size_t row = 0; row < kDepth; ++row) {
+      auto [index, shift] = position(hash, row);
+      auto count = static_cast<std::uint8_t>(
+          (_table[index].load(std::memory_order_relaxed) >> shift) & 0xfULL);
+      result = std::min(result, count);
+    }
+    return result;
+  }
+
+ private:
+  /// @brief halves all counters
+  void age() noexcept {
+    for (auto& word : _table) {
+      std::uint64_t current = word.load(std::memory_order_relaxed);
+      while (!word.compare_exchange_weak(
+          current, (current >> 1) & 0x7777777777777777ULL,
+          std::memory_order_relaxed)) {
+      }
+    }
+    _additions.fetch_sub(_sampleSize / 2, std::memory_order_relaxed);
+  }
+
+  /// @brief returns the word index and the bit offset of the counter for the
+  /// hash in the row
+  std::pair<std::size_t, std::uint32_t> position(
+      std::uint32_t hash, std::size_t row) const noexcept {
+    TRI_ASSERT(row < kDepth);
+    static constexpr std::uint64_t seeds[kDepth] = {
+        0x9e3779b97f4a7c15ULL, 0xc2b2ae3d27d4eb4fULL, 0x165667b19e3779f9ULL,
+        0x27d4eb2f165667c5ULL};
+    std::uint64_t h = (static_cast<std::uint64_t>(hash) + 1) * seeds[row];
+    h ^= h >> 32;
+    return {row * _words + (static_cast<std::size_t>(h >> 4) & _mask),
+            static_cast<std::uint32_t>(h & 0xfULL) * 4};
+  }
+
+  static std::size_t powerOf2(std::size_t value) {
+    std::size_t bitPos = static_cast<std::size_t>(std::ceil(std::log2(value)));
+    return (static_cast<std::size_t>(1) << bitPos);
+  }
+
+  std::size_t const _words;
+  std::size_t const _mask;
+  std::uint64_t const _sampleSize;
+  std::vector<std::atomic<std::uint64_t>> _table;
+  std::atomic<std::uint64_t> _additions;
+};
+
+};  // end namespace arangodb::cache
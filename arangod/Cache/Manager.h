@@ -92,6 +92,7 @@ class Manager {
   };
 
   static constexpr std::size_t kFindStatsCapacity = 8192;
+  static constexpr std::size_t kAdmissionSketchCounters = 16384;
   static constexpr std::uint64_t kMinSize = 1024 * 1024;
   static constexpr std::uint64_t kMaxSpareTablesTotal = 16;
   // use sizeof(uint64_t) + sizeof(std::shared_ptr<Cache>) + 64 for upper bound
@@ -204,6 +205,13 @@ class Manager {
 
   SharedPRNGFeature& sharedPRNG() const noexcept { return _sharedPRNG; }
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Whether caches use a TinyLFU admission filter for inserts.
+  //////////////////////////////////////////////////////////////////////////////
+  bool admissionFilterEnabled() const noexcept {
+    return _options.enableAdmissionFilter;
+  }
+
 #ifdef ARANGODB_ENABLE_FAILURE_TESTS
   void freeUnusedTablesForTesting();
 #endif
@@ -21,6 +21,7 @@
 /// @author Dan Larkin-York
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
 #include <cstdint>
 
 #include "Cache/PlainBucket.h"
@@ -56,7 +57,30 @@ bool PlainBucket::isMigrated() const noexcept {
 
 bool PlainBucket::isFull() const noexcept {
   TRI_ASSERT(isLocked());
-  return _slotsUsed == kSlotsData;
+  return _slotsUsed.load(std::memory_order_relaxed) == kSlotsData;
+}
+
+bool PlainBucket::mayContain(std::uint32_t hash) const noexcept {
+  auto const snapshot = _state.beginOptimisticRead();
+  if (BucketState::isSet(snapshot, BucketState::Flag::locked) ||
+      BucketState::isSet(snapshot, BucketState::Flag::migrated)) {
+    return true;
+  }
+
+  // the slots may be modified concurrently. in this case the validation
+  // below fails, but until then the values read must stay in bounds. the
+  // members are atomic, so that reading them while they are modified is
+  // not a data race
+  std::size_t const slotsUsed = std::min(
+      static_cast<std::size_t>(_slotsUsed.load(std::memory_order_relaxed)),
+      kSlotsData);
+  for (std::size_t slot = 0; slot < slotsUsed; ++slot) {
+    if (_cachedHashes[slot].load(std::memory_order_relaxed) == hash) {
+      return true;
+    }
+  }
+
+  return !_state.validateOptimisticRead(snapshot);
 }
 
 template<typename Hasher>
@@ -66,10 +90,11 @@ CachedValue* PlainBucket::find(std::uint32_t hash, void const* key,
   CachedValue* result = nullptr;
 
   // check from the front, so more frequently accessed items are found quicker
-  for (std::size_t slot = 0; slot < _slotsUsed; ++slot) {
+  std::size_t const slotsUsed = _slotsUsed.load(std::memory_order_relaxed);
+  for (std::size_t slot = 0; slot < slotsUsed; ++slot) {
     TRI_ASSERT(_cachedData[slot] != nullptr);
 
-    if (_cachedHashes[slot] == hash &&
+    if (_cachedHashes[slot].load(std::memory_order_relaxed) == hash &&
         Hasher::sameKey(_cachedData[slot]->key(), _cachedData[slot]->keySize(),
                         key, keySize)) {
       result = _cachedData[slot];
@@ -87,17 +112,19 @@ CachedValue* PlainBucket::find(std::uint32_t hash, void const* key,
 // requires there to be an open slot, otherwise will not be inserted
 void PlainBucket::insert(std::uint32_t hash, CachedValue* value) noexcept {
   TRI_ASSERT(isLocked());
-  if (_slotsUsed < kSlotsData) {
+  std::size_t const slotsUsed = _slotsUsed.load(std::memory_order_relaxed);
+  if (slotsUsed < kSlotsData) {
     // found an empty slot.
     // insert at the end
-    TRI_ASSERT(_cachedData[_slotsUsed] == nullptr);
-    _cachedHashes[_slotsUsed] = hash;
-    _cachedData[_slotsUsed] = value;
-    if (_slotsUsed != 0) {
-      moveSlotToFront(_slotsUsed);
+    TRI_ASSERT(_cachedData[slotsUsed] == nullptr);
+    _cachedHashes[slotsUsed].store(hash, std::memory_order_relaxed);
+    _cachedData[slotsUsed] = value;
+    if (slotsUsed != 0) {
+      moveSlotToFront(slotsUsed);
     }
-    ++_slotsUsed;
-    TRI_ASSERT(_slotsUsed <= kSlotsData);
+    _slotsUsed.store(static_cast<std::uint16_t>(slotsUsed + 1),
+                     std::memory_order_relaxed);
+    TRI_ASSERT(slotsUsed + 1 <= kSlotsData);
     checkInvariants();
   }
 }
@@ -110,8 +137,9 @@ CachedValue* PlainBucket::remove(std::uint32_t hash, void const* key,
 
   // check from the front to the back. the order does not really
   // matter, as we have no idea where the to-be-removed item is.
-  for (std::size_t slot = 0; slot < _slotsUsed; ++slot) {
-    if (_cachedHashes[slot] == hash &&
+  std::size_t const slotsUsed = _slotsUsed.load(std::memory_order_relaxed);
+  for (std::size_t slot = 0; slot < slotsUsed; ++slot) {
+    if (_cachedHashes[slot].load(std::memory_order_relaxed) == hash &&
         Hasher::sameKey(_cachedData[slot]->key(), _cachedData[slot]->keySize(),
                         key, keySize)) {
       result = _cachedData[slot];
@@ -126,7 +154,7 @@ CachedValue* PlainBucket::remove(std::uint32_t hash, void const* key,
 std::uint64_t PlainBucket::evictCandidate() noexcept {
   TRI_ASSERT(isLocked());
   // try to find a freeable slot from the back.
-  std::size_t slot = _slotsUsed;
+  std::size_t slot = _slotsUsed.load(std::memory_order_relaxed);
   while (slot-- > 0) {
     TRI_ASSERT(_cachedData[slot] != nullptr);
     if (!_cachedData[slot]->isFreeable()) {
@@ -147,7 +175,7 @@ std::uint64_t PlainBucket::evictCandidate() noexcept {
 CachedValue* PlainBucket::evictionCandidate() const noexcept {
   TRI_ASSERT(isLocked());
   // try to find a freeable slot from the back.
-  std::size_t slot = _slotsUsed;
+  std::size_t slot = _slotsUsed.load(std::memory_order_relaxed);
   while (slot-- > 0) {
     TRI_ASSERT(_cachedData[slot] != nullptr);
     if (_cachedData[slot]->isFreeable()) {
@@ -160,7 +188,8 @@ CachedValue* PlainBucket::evictionCandidate() const noexcept {
 
 void PlainBucket::evict(CachedValue* value) noexcept {
   TRI_ASSERT(isLocked());
-  for (std::size_t slot = 0; slot < _slotsUsed; ++slot) {
+  std::size_t const slotsUsed = _slotsUsed.load(std::memory_order_relaxed);
+  for (std::size_t slot = 0; slot < slotsUsed; ++slot) {
     if (_cachedData[slot] == value) {
       // found a match
       closeGap(slot);
@@ -173,9 +202,9 @@ void PlainBucket::clear() noexcept {
   TRI_ASSERT(isLocked());
   _state.clear();  // "clear" will keep the lock!
 
-  _slotsUsed = 0;
+  _slotsUsed.store(0, std::memory_order_relaxed);
   for (std::size_t i = 0; i < kSlotsData; ++i) {
-    _cachedHashes[i] = 0;
+    _cachedHashes[i].store(0, std::memory_order_relaxed);
   }
   for (std::size_t i = 0; i < kSlotsData; ++i) {
     _cachedData[i] = nullptr;
@@ -186,28 +215,35 @@ void PlainBucket::clear() noexcept {
 }
 
 void PlainBucket::closeGap(std::size_t slot) noexcept {
-  _cachedHashes[slot] = _cachedHashes[_slotsUsed - 1];
-  _cachedData[slot] = _cachedData[_slotsUsed - 1];
-  _cachedHashes[_slotsUsed - 1] = 0;
-  _cachedData[_slotsUsed - 1] = nullptr;
-  TRI_ASSERT(_slotsUsed > 0);
-  --_slotsUsed;
+  std::size_t const slotsUsed = _slotsUsed.load(std::memory_order_relaxed);
+  TRI_ASSERT(slotsUsed > 0);
+  std::size_t const last = slotsUsed - 1;
+  _cachedHashes[slot].store(
+      _cachedHashes[last].load(std::memory_order_relaxed),
+      std::memory_order_relaxed);
+  _cachedData[slot] = _cachedData[last];
+  _cachedHashes[last].store(0, std::memory_order_relaxed);
+  _cachedData[last] = nullptr;
+  _slotsUsed.store(static_cast<std::uint16_t>(last),
+                   std::memory_order_relaxed);
   checkInvariants();
 }
 
 void PlainBucket::moveSlotToFront(std::size_t slot) noexcept {
   TRI_ASSERT(isLocked());
-  std::uint32_t hash = _cachedHashes[slot];
+  std::uint32_t hash = _cachedHashes[slot].load(std::memory_order_relaxed);
   CachedValue* value = _cachedData[slot];
   // move slot to front
   while (slot != 0) {
     TRI_ASSERT(_cachedData[slot - 1] != nullptr);
-    _cachedHashes[slot] = _cachedHashes[slot - 1];
+    _cachedHashes[slot].store(
+        _cachedHashes[slot - 1].load(std::memory_order_relaxed),
+        std::memory_order_relaxed);
     _cachedData[slot] = _cachedData[slot - 1];
     --slot;
   }
   TRI_ASSERT(slot == 0);
-  _cachedHashes[0] = hash;
+  _cachedHashes[0].store(hash, std::memory_order_relaxed);
   _cachedData[0] = value;
 }
 
@@ -219,13 +255,14 @@ void PlainBucket::checkInvariants() const noexcept {
   // or removed.
   // it is not compiled in non-maintainer mode, so it does not affect
   // the performance of release builds.
-  TRI_ASSERT(_slotsUsed <= kSlotsData);
+  std::size_t const slotsUsed = _slotsUsed.load(std::memory_order_relaxed);
+  TRI_ASSERT(slotsUsed <= kSlotsData);
   for (std::size_t slot = 0; slot < kSlotsData; ++slot) {
-    if (slot < _slotsUsed) {
-      TRI_ASSERT(_cachedHashes[slot] != 0);
+    if (slot < slotsUsed) {
+      TRI_ASSERT(_cachedHashes[slot].load(std::memory_order_relaxed) != 0);
       TRI_ASSERT(_cachedData[slot] != nullptr);
     } else {
-      TRI_ASSERT(_cachedHashes[slot] == 0);
+      TRI_ASSERT(_cachedHashes[slot].load(std::memory_order_relaxed) == 0);
       TRI_ASSERT(_cachedData[slot] == nullptr);
     }
   }
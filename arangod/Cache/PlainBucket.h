@@ -23,6 +23,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <cstdint>
 
 #include "Cache/BucketState.h"
@@ -46,12 +47,15 @@ namespace arangodb::cache {
 ////////////////////////////////////////////////////////////////////////////////
 struct PlainBucket {
   BucketState _state;
-  std::uint16_t _slotsUsed;
+  // atomic, because mayContain() reads it without locking the bucket
+  std::atomic<std::uint16_t> _slotsUsed;
   std::uint32_t _paddingExplicit;  // fill 4-byte gap for alignment purposes
 
-  // actual cached entries
+  // actual cached entries. the hashes are atomic, because mayContain() reads
+  // them without locking the bucket. all accesses are relaxed: the bucket's
+  // lock or the validation of the optimistic read provide the ordering
   static constexpr std::size_t kSlotsData = 10;
-  std::uint32_t _cachedHashes[kSlotsData];
+  std::atomic<std::uint32_t> _cachedHashes[kSlotsData];
   CachedValue* _cachedData[kSlotsData];
 
   //////////////////////////////////////////////////////////////////////////////
@@ -99,6 +103,17 @@ struct PlainBucket {
   CachedValue* find(std::uint32_t hash, void const* key, std::size_t keySize,
                     bool moveToFront = true) noexcept;
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Checks whether the bucket may contain an entry with the given
+  /// hash, without locking the bucket.
+  ///
+  /// Returns false only if the bucket definitely contains no such entry. If
+  /// the bucket is locked or modified concurrently, or has been migrated, it
+  /// returns true, and the caller has to lock the bucket and use find().
+  /// Values are never dereferenced, as they may be freed concurrently.
+  //////////////////////////////////////////////////////////////////////////////
+  bool mayContain(std::uint32_t hash) const noexcept;
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief Inserts a given value. Requires state to be locked.
   ///
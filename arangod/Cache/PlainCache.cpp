@@ -47,6 +47,16 @@ Finding PlainCache<Hasher>::find(void const* key, std::uint32_t keySize) {
   TRI_ASSERT(key != nullptr);
   Finding result;
   Table::BucketHash hash{Hasher::hashKey(key, keySize)};
+  recordAccess(hash.value);
+
+  if (!mayContain(hash)) {
+    // definitely not cached. this avoids locking the bucket, which would
+    // bounce its cache line between all cores reading from it
+    _manager->reportAccess(_id);
+    recordMiss();
+    result.reportError(TRI_ERROR_ARANGO_DOCUMENT_NOT_FOUND);
+    return result;
+  }
 
   ::ErrorCode status = TRI_ERROR_NO_ERROR;
   Table::BucketLocker guard;
@@ -94,6 +104,13 @@ template<typename Hasher>
       if (candidate == nullptr) {
         allowed = false;
         status = TRI_ERROR_ARANGO_BUSY;
+      } else if (!admit(hash.value, Hasher::hashKey(candidate->key(),
+                                                     candidate->keySize()))) {
+        // keep the more frequently accessed value. this still counts as
+        // an eviction, so that the table can grow
+        allowed = false;
+        status = TRI_ERROR_ARANGO_BUSY;
+        maybeMigrate = reportInsert(true);
       }
     }
 
@@ -188,6 +205,47 @@ template<typename Hasher>
   return TRI_ERROR_NOT_IMPLEMENTED;
 }
 
+template<typename Hasher>
+std::vector<std::string> PlainCache<Hasher>::recentKeys(
+    std::size_t maxKeys) {
+  std::vector<std::string> keys;
+
+  std::shared_ptr<cache::Table> table = this->table();
+  if (!table) {
+    return keys;
+  }
+
+  std::size_t const n = table->size();
+  // entries are kept in LRU order inside each bucket. so scan all buckets
+  // once per slot position to get the most recently used entries first
+  for (std::size_t slot = 0; slot < PlainBucket::kSlotsData; ++slot) {
+    bool found = false;
+    for (std::size_t i = 0; i < n && keys.size() < maxKeys; ++i) {
+      auto [status, guard] = getBucket(Table::BucketId{i}, Cache::triesFast,
+                                       /*singleOperation*/ false);
+
+      if (status != TRI_ERROR_NO_ERROR) {
+        continue;
+      }
+
+      PlainBucket& bucket = guard.template bucket<PlainBucket>();
+      if (slot < bucket._slotsUsed.load(std::memory_order_relaxed)) {
+        CachedValue const* value = bucket._cachedData[slot];
+        TRI_ASSERT(value != nullptr);
+        keys.emplace_back(reinterpret_cast<char const*>(value->key()),
+                          value->keySize());
+        found = true;
+      }
+    }
+    if (!found || keys.size() >= maxKeys) {
+      // no bucket has any more entries, or we have enough keys
+      break;
+    }
+  }
+
+  return keys;
+}
+
 /// @brief returns the hasher name
 template<typename Hasher>
 std::string_view PlainCache<Hasher>::hasherName() const noexcept {
@@ -294,10 +352,11 @@ void PlainCache<Hasher>::migrateBucket(void* sourcePtr,
     std::uint64_t filled = 0;
     std::uint64_t emptied = 0;
 
-    std::size_t slot = source._slotsUsed;
+    std::size_t slot = source._slotsUsed.load(std::memory_order_relaxed);
     while (slot-- > 0) {
       if (source._cachedData[slot] != nullptr) {
-        std::uint32_t hash = source._cachedHashes[slot];
+        std::uint32_t hash =
+            source._cachedHashes[slot].load(std::memory_order_relaxed);
         CachedValue* value = source._cachedData[slot];
 
         auto targetBucket =
@@ -321,10 +380,10 @@ void PlainCache<Hasher>::migrateBucket(void* sourcePtr,
           totalSize += size;
         }
 
-        source._cachedHashes[slot] = 0;
+        source._cachedHashes[slot].store(0, std::memory_order_relaxed);
         source._cachedData[slot] = nullptr;
-        TRI_ASSERT(source._slotsUsed > 0);
-        --source._slotsUsed;
+        TRI_ASSERT(source._slotsUsed.load(std::memory_order_relaxed) > 0);
+        source._slotsUsed.fetch_sub(1, std::memory_order_relaxed);
       }
     }
     reclaimMemory(totalSize);
@@ -359,6 +418,18 @@ std::pair<::ErrorCode, Table::BucketLocker> PlainCache<Hasher>::getBucket(
   return std::make_pair(status, std::move(guard));
 }
 
+template<typename Hasher>
+bool PlainCache<Hasher>::mayContain(Table::BucketHash hash) const noexcept {
+  std::shared_ptr<Table> table = this->table();
+  if (ADB_UNLIKELY(isShutdown() || table == nullptr)) {
+    // let the regular lookup report the error
+    return true;
+  }
+  return static_cast<PlainBucket const*>(
+             table->primaryBucketForOptimisticRead(hash))
+      ->mayContain(hash.value);
+}
+
 template<typename Hasher>
 Table::BucketClearer PlainCache<Hasher>::bucketClearer(Cache* cache,
                                                        Metadata* metadata) {
@@ -92,6 +92,15 @@ class PlainCache final : public Cache {
   //////////////////////////////////////////////////////////////////////////////
   ::ErrorCode banish(void const* key, std::uint32_t keySize) override;
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Returns copies of up to maxKeys keys stored in the cache.
+  ///
+  /// The most recently used entries of all buckets are returned first, then
+  /// the second most recently used entries etc. Buckets that cannot be locked
+  /// in a timely fashion are skipped, so the result is best effort only.
+  //////////////////////////////////////////////////////////////////////////////
+  std::vector<std::string> recentKeys(std::size_t maxKeys) override;
+
   /// @brief returns the name of the hasher
   std::string_view hasherName() const noexcept;
 
@@ -114,6 +123,10 @@ class PlainCache final : public Cache {
                              Table& newTable) override;
 
   // helpers
+  /// @brief checks without locking whether the bucket for the hash may
+  /// contain the key. returns false only if it definitely does not
+  bool mayContain(Table::BucketHash hash) const noexcept;
+
   std::pair<::ErrorCode, Table::BucketLocker> getBucket(
       Table::HashOrId bucket, std::uint64_t maxTries,
       bool singleOperation = true);
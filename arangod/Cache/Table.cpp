@@ -197,6 +197,13 @@ Table::Table(std::uint32_t logSize, Manager* manager)
       _bucketClearer(defaultClearer),
       _slotsTotal(_size),
       _slotsUsed(static_cast<std::uint64_t>(0)) {
+  // note: this touches all buckets from the current thread, so with the
+  // default first-touch policy on NUMA systems, the whole table is placed
+  // on the current thread's node. keys are spread uniformly over all
+  // buckets, so no placement of the table can make the lookups of all
+  // threads local. running the server with interleaved memory
+  // (`numactl --interleave=all`) at least balances the tables over all
+  // nodes, so that no node's memory bandwidth becomes a bottleneck.
   for (std::size_t i = 0; i < _size; i++) {
     // use placement new in order to properly initialize the bucket
     new (_buckets + i) GenericBucket();
@@ -269,6 +276,11 @@ void* Table::primaryBucket(uint64_t index) noexcept {
   return &_buckets[index];
 }
 
+void const* Table::primaryBucketForOptimisticRead(
+    BucketHash hash) const noexcept {
+  return &_buckets[(hash.value & _mask) >> _shift];
+}
+
 std::unique_ptr<Table::Subtable> Table::auxiliaryBuckets(std::uint32_t index) {
   if (!isEnabled()) {
     return std::unique_ptr<Subtable>();
@@ -189,6 +189,15 @@ class Table : public std::enable_shared_from_this<Table> {
   //////////////////////////////////////////////////////////////////////////////
   void* primaryBucket(std::uint64_t index) noexcept;
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Returns a pointer to the bucket in the primary table mapped by the
+  /// given hash, without locking the table or the bucket.
+  ///
+  /// Only to be used for optimistic reads of the bucket, which must detect
+  /// migration and concurrent modifications of the bucket themselves.
+  //////////////////////////////////////////////////////////////////////////////
+  void const* primaryBucketForOptimisticRead(BucketHash hash) const noexcept;
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief Returns a subtable in the auxiliary index which corresponds to the
   /// specified bucket in the primary table.
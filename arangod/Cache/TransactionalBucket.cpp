@@ -21,6 +21,7 @@
 /// @author Dan Larkin-York
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
 #include <atomic>
 #include <cstdint>
 
@@ -64,7 +65,30 @@ bool TransactionalBucket::isFullyBanished() const noexcept {
 
 bool TransactionalBucket::isFull() const noexcept {
   TRI_ASSERT(isLocked());
-  return _slotsUsed == kSlotsData;
+  return _slotsUsed.load(std::memory_order_relaxed) == kSlotsData;
+}
+
+bool TransactionalBucket::mayContain(std::uint32_t hash) const noexcept {
+  auto const snapshot = _state.beginOptimisticRead();
+  if (BucketState::isSet(snapshot, BucketState::Flag::locked) ||
+      BucketState::isSet(snapshot, BucketState::Flag::migrated)) {
+    return true;
+  }
+
+  // the slots may be modified concurrently. in this case the validation
+  // below fails, but until then the values read must stay in bounds. the
+  // members are atomic, so that reading them while they are modified is
+  // not a data race
+  std::size_t const slotsUsed = std::min(
+      static_cast<std::size_t>(_slotsUsed.load(std::memory_order_relaxed)),
+      kSlotsData);
+  for (std::size_t slot = 0; slot < slotsUsed; ++slot) {
+    if (_cachedHashes[slot].load(std::memory_order_relaxed) == hash) {
+      return true;
+    }
+  }
+
+  return !_state.validateOptimisticRead(snapshot);
 }
 
 template<typename Hasher>
@@ -75,8 +99,9 @@ CachedValue* TransactionalBucket::find(std::uint32_t hash, void const* key,
   CachedValue* result = nullptr;
 
   // check from the front, so more frequently accessed items are found quicker
-  for (std::size_t slot = 0; slot < _slotsUsed; ++slot) {
-    if (_cachedHashes[slot] == hash &&
+  std::size_t const slotsUsed = _slotsUsed.load(std::memory_order_relaxed);
+  for (std::size_t slot = 0; slot < slotsUsed; ++slot) {
+    if (_cachedHashes[slot].load(std::memory_order_relaxed) == hash &&
         Hasher::sameKey(_cachedData[slot]->key(), _cachedData[slot]->keySize(),
                         key, keySize)) {
       result = _cachedData[slot];
@@ -96,17 +121,19 @@ void TransactionalBucket::insert(std::uint32_t hash,
   TRI_ASSERT(isLocked());
   TRI_ASSERT(!isBanished(hash));  // check needs to be done outside
 
-  if (_slotsUsed < kSlotsData) {
+  std::size_t const slotsUsed = _slotsUsed.load(std::memory_order_relaxed);
+  if (slotsUsed < kSlotsData) {
     // found an empty slot.
     // insert at the end
-    TRI_ASSERT(_cachedData[_slotsUsed] == nullptr);
-    _cachedHashes[_slotsUsed] = hash;
-    _cachedData[_slotsUsed] = value;
-    if (_slotsUsed != 0) {
-      moveSlotToFront(_slotsUsed);
+    TRI_ASSERT(_cachedData[slotsUsed] == nullptr);
+    _cachedHashes[slotsUsed].store(hash, std::memory_order_relaxed);
+    _cachedData[slotsUsed] = value;
+    if (slotsUsed != 0) {
+      moveSlotToFront(slotsUsed);
     }
-    ++_slotsUsed;
-    TRI_ASSERT(_slotsUsed <= kSlotsData);
+    _slotsUsed.store(static_cast<std::uint16_t>(slotsUsed + 1),
+                     std::memory_order_relaxed);
+    TRI_ASSERT(slotsUsed + 1 <= kSlotsData);
     checkInvariants();
   }
 }
@@ -119,8 +146,9 @@ CachedValue* TransactionalBucket::remove(std::uint32_t hash, void const* key,
 
   // check from the front to the back. the order does not really
   // matter, as we have no idea where the to-be-removed item is.
-  for (std::size_t slot = 0; slot < _slotsUsed; ++slot) {
-    if (_cachedHashes[slot] == hash &&
+  std::size_t const slotsUsed = _slotsUsed.load(std::memory_order_relaxed);
+  for (std::size_t slot = 0; slot < slotsUsed; ++slot) {
+    if (_cachedHashes[slot].load(std::memory_order_relaxed) == hash &&
         Hasher::sameKey(_cachedData[slot]->key(), _cachedData[slot]->keySize(),
                         key, keySize)) {
       result = _cachedData[slot];
@@ -185,7 +213,7 @@ bool TransactionalBucket::isBanished(std::uint32_t hash) const noexcept {
 std::uint64_t TransactionalBucket::evictCandidate() noexcept {
   TRI_ASSERT(isLocked());
   // try to find a freeable slot from the back.
-  std::size_t slot = _slotsUsed;
+  std::size_t slot = _slotsUsed.load(std::memory_order_relaxed);
   while (slot-- > 0) {
     TRI_ASSERT(_cachedData[slot] != nullptr);
     if (!_cachedData[slot]->isFreeable()) {
@@ -206,7 +234,7 @@ std::uint64_t TransactionalBucket::evictCandidate() noexcept {
 CachedValue* TransactionalBucket::evictionCandidate() const noexcept {
   TRI_ASSERT(isLocked());
   // try to find a freeable slot from the back.
-  std::size_t slot = _slotsUsed;
+  std::size_t slot = _slotsUsed.load(std::memory_order_relaxed);
   while (slot-- > 0) {
     TRI_ASSERT(_cachedData[slot] != nullptr);
     if (_cachedData[slot]->isFreeable()) {
@@ -219,7 +247,8 @@ CachedValue* TransactionalBucket::evictionCandidate() const noexcept {
 
 void TransactionalBucket::evict(CachedValue* value) noexcept {
   TRI_ASSERT(isLocked());
-  for (std::size_t slot = 0; slot < _slotsUsed; ++slot) {
+  std::size_t const slotsUsed = _slotsUsed.load(std::memory_order_relaxed);
+  for (std::size_t slot = 0; slot < slotsUsed; ++slot) {
     if (_cachedData[slot] == value) {
       // found a match
       closeGap(slot);
@@ -231,13 +260,13 @@ void TransactionalBucket::evict(CachedValue* value) noexcept {
 void TransactionalBucket::clear() noexcept {
   TRI_ASSERT(isLocked());
   _state.clear();  // "clear" will keep the lock!
-  _slotsUsed = 0;
+  _slotsUsed.store(0, std::memory_order_relaxed);
   for (std::size_t slot = 0; slot < kSlotsBanish; ++slot) {
     _banishHashes[slot] = 0;
   }
   _banishTerm = 0;
   for (std::size_t slot = 0; slot < kSlotsData; ++slot) {
-    _cachedHashes[slot] = 0;
+    _cachedHashes[slot].store(0, std::memory_order_relaxed);
   }
   for (std::size_t slot = 0; slot < kSlotsData; ++slot) {
     _cachedData[slot] = nullptr;
@@ -262,28 +291,35 @@ void TransactionalBucket::updateBanishTerm(std::uint64_t term) noexcept {
 }
 
 void TransactionalBucket::closeGap(std::size_t slot) noexcept {
-  _cachedHashes[slot] = _cachedHashes[_slotsUsed - 1];
-  _cachedData[slot] = _cachedData[_slotsUsed - 1];
-  _cachedHashes[_slotsUsed - 1] = 0;
-  _cachedData[_slotsUsed - 1] = nullptr;
-  TRI_ASSERT(_slotsUsed > 0);
-  --_slotsUsed;
+  std::size_t const slotsUsed = _slotsUsed.load(std::memory_order_relaxed);
+  TRI_ASSERT(slotsUsed > 0);
+  std::size_t const last = slotsUsed - 1;
+  _cachedHashes[slot].store(
+      _cachedHashes[last].load(std::memory_order_relaxed),
+      std::memory_order_relaxed);
+  _cachedData[slot] = _cachedData[last];
+  _cachedHashes[last].store(0, std::memory_order_relaxed);
+  _cachedData[last] = nullptr;
+  _slotsUsed.store(static_cast<std::uint16_t>(last),
+                   std::memory_order_relaxed);
   checkInvariants();
 }
 
 void TransactionalBucket::moveSlotToFront(std::size_t slot) noexcept {
   TRI_ASSERT(isLocked());
-  std::uint32_t hash = _cachedHashes[slot];
+  std::uint32_t hash = _cachedHashes[slot].load(std::memory_order_relaxed);
   CachedValue* value = _cachedData[slot];
   // move slot to front
   while (slot != 0) {
     TRI_ASSERT(_cachedData[slot - 1] != nullptr);
-    _cachedHashes[slot] = _cachedHashes[slot - 1];
+    _cachedHashes[slot].store(
+        _cachedHashes[slot - 1].load(std::memory_order_relaxed),
+        std::memory_order_relaxed);
     _cachedData[slot] = _cachedData[slot - 1];
     --slot;
   }
   TRI_ASSERT(slot == 0);
-  _cachedHashes[0] = hash;
+  _cachedHashes[0].store(hash, std::memory_order_relaxed);
   _cachedData[0] = value;
 }
 
@@ -301,13 +337,14 @@ void TransactionalBucket::checkInvariants() const noexcept {
   // or removed.
   // it is not compiled in non-maintainer mode, so it does not affect
   // the performance of release builds.
-  TRI_ASSERT(_slotsUsed <= kSlotsData);
+  std::size_t const slotsUsed = _slotsUsed.load(std::memory_order_relaxed);
+  TRI_ASSERT(slotsUsed <= kSlotsData);
   for (std::size_t slot = 0; slot < kSlotsData; ++slot) {
-    if (slot < _slotsUsed) {
-      TRI_ASSERT(_cachedHashes[slot] != 0);
+    if (slot < slotsUsed) {
+      TRI_ASSERT(_cachedHashes[slot].load(std::memory_order_relaxed) != 0);
       TRI_ASSERT(_cachedData[slot] != nullptr);
     } else {
-      TRI_ASSERT(_cachedHashes[slot] == 0);
+      TRI_ASSERT(_cachedHashes[slot].load(std::memory_order_relaxed) == 0);
       TRI_ASSERT(_cachedData[slot] == nullptr);
     }
   }
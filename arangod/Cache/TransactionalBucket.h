@@ -49,16 +49,19 @@ namespace arangodb::cache {
 ////////////////////////////////////////////////////////////////////////////////
 struct TransactionalBucket {
   BucketState _state;
-  std::uint16_t _slotsUsed;
+  // atomic, because mayContain() reads it without locking the bucket
+  std::atomic<std::uint16_t> _slotsUsed;
 
   // banish entries for transactional semantics
   static constexpr std::size_t kSlotsBanish = 5;
   std::uint32_t _banishHashes[kSlotsBanish];
   std::uint64_t _banishTerm;
 
-  // actual cached entries
+  // actual cached entries. the hashes are atomic, because mayContain() reads
+  // them without locking the bucket. all accesses are relaxed: the bucket's
+  // lock or the validation of the optimistic read provide the ordering
   static constexpr std::size_t kSlotsData = 8;
-  std::uint32_t _cachedHashes[kSlotsData];
+  std::atomic<std::uint32_t> _cachedHashes[kSlotsData];
   CachedValue* _cachedData[kSlotsData];
 
   //////////////////////////////////////////////////////////////////////////////
@@ -112,6 +115,17 @@ struct TransactionalBucket {
   CachedValue* find(std::uint32_t hash, void const* key, std::size_t keySize,
                     bool moveToFront = true) noexcept;
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Checks whether the bucket may contain an entry with the given
+  /// hash, without locking the bucket.
+  ///
+  /// Returns false only if the bucket definitely contains no such entry. If
+  /// the bucket is locked or modified concurrently, or has been migrated, it
+  /// returns true, and the caller has to lock the bucket and use find().
+  /// Values are never dereferenced, as they may be freed concurrently.
+  //////////////////////////////////////////////////////////////////////////////
+  bool mayContain(std::uint32_t hash) const noexcept;
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief Inserts a given value if it is not banished. Requires state to
   /// be locked.
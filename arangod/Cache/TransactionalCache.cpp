@@ -48,6 +48,15 @@ Finding TransactionalCache<Hasher>::find(void const* key,
   TRI_ASSERT(key != nullptr);
   Finding result;
   Table::BucketHash hash{Hasher::hashKey(key, keySize)};
+  recordAccess(hash.value);
+
+  if (!mayContain(hash)) {
+    // definitely not cached. this avoids locking the bucket, which would
+    // bounce its cache line between all cores reading from it
+    recordMiss();
+    result.reportError(TRI_ERROR_ARANGO_DOCUMENT_NOT_FOUND);
+    return result;
+  }
 
   ::ErrorCode status = TRI_ERROR_NO_ERROR;
   Table::BucketLocker guard;
@@ -96,6 +105,14 @@ template<typename Hasher>
         if (candidate == nullptr) {
           allowed = false;
           status = TRI_ERROR_ARANGO_BUSY;
+        } else if (!admit(hash.value,
+                          Hasher::hashKey(candidate->key(),
+                                          candidate->keySize()))) {
+          // keep the more frequently accessed value. this still counts as
+          // an eviction, so that the table can grow
+          allowed = false;
+          status = TRI_ERROR_ARANGO_BUSY;
+          maybeMigrate = reportInsert(true);
         }
       }
 
@@ -239,6 +256,48 @@ template<typename Hasher>
   return status;
 }
 
+template<typename Hasher>
+std::vector<std::string> TransactionalCache<Hasher>::recentKeys(
+    std::size_t maxKeys) {
+  std::vector<std::string> keys;
+
+  std::shared_ptr<cache::Table> table = this->table();
+  if (!table) {
+    return keys;
+  }
+
+  std::size_t const n = table->size();
+  // entries are kept in LRU order inside each bucket. so scan all buckets
+  // once per slot position to get the most recently used entries first
+  for (std::size_t slot = 0; slot < TransactionalBucket::kSlotsData; ++slot) {
+    bool found = false;
+    for (std::size_t i = 0; i < n && keys.size() < maxKeys; ++i) {
+      auto [status, guard] = getBucket(Table::BucketId{i}, Cache::triesFast,
+                                       /*singleOperation*/ false);
+
+      if (status != TRI_ERROR_NO_ERROR) {
+        continue;
+      }
+
+      TransactionalBucket& bucket =
+          guard.template bucket<TransactionalBucket>();
+      if (slot < bucket._slotsUsed.load(std::memory_order_relaxed)) {
+        CachedValue const* value = bucket._cachedData[slot];
+        TRI_ASSERT(value != nullptr);
+        keys.emplace_back(reinterpret_cast<char const*>(value->key()),
+                          value->keySize());
+        found = true;
+      }
+    }
+    if (!found || keys.size() >= maxKeys) {
+      // no bucket has any more entries, or we have enough keys
+      break;
+    }
+  }
+
+  return keys;
+}
+
 /// @brief returns the hasher name
 template<typename Hasher>
 std::string_view TransactionalCache<Hasher>::hasherName() const noexcept {
@@ -393,7 +452,8 @@ void TransactionalCache<Hasher>::migrateBucket(
     std::uint64_t filled = 0;
     for (std::size_t j = 0; j < TransactionalBucket::kSlotsData; j++) {
       if (source._cachedData[j] != nullptr) {
-        std::uint32_t hash = source._cachedHashes[j];
+        std::uint32_t hash =
+            source._cachedHashes[j].load(std::memory_order_relaxed);
         CachedValue* value = source._cachedData[j];
 
         auto targetBucket =
@@ -423,10 +483,10 @@ void TransactionalCache<Hasher>::migrateBucket(
           }
         }
 
-        source._cachedHashes[j] = 0;
+        source._cachedHashes[j].store(0, std::memory_order_relaxed);
         source._cachedData[j] = nullptr;
-        TRI_ASSERT(source._slotsUsed > 0);
-        --source._slotsUsed;
+        TRI_ASSERT(source._slotsUsed.load(std::memory_order_relaxed) > 0);
+        source._slotsUsed.fetch_sub(1, std::memory_order_relaxed);
       }
     }
     reclaimMemory(totalSize);
@@ -466,6 +526,19 @@ TransactionalCache<Hasher>::getBucket(Table::HashOrId bucket,
   return std::make_tuple(status, std::move(guard));
 }
 
+template<typename Hasher>
+bool TransactionalCache<Hasher>::mayContain(
+    Table::BucketHash hash) const noexcept {
+  std::shared_ptr<Table> table = this->table();
+  if (ADB_UNLIKELY(isShutdown() || table == nullptr)) {
+    // let the regular lookup report the error
+    return true;
+  }
+  return static_cast<TransactionalBucket const*>(
+             table->primaryBucketForOptimisticRead(hash))
+      ->mayContain(hash.value);
+}
+
 template<typename Hasher>
 Table::BucketClearer TransactionalCache<Hasher>::bucketClearer(
     Cache* cache, Metadata* metadata) {
@@ -38,6 +38,8 @@
 #include "Scheduler/Scheduler.h"
 #include "Scheduler/SchedulerFeature.h"
 
+#include <unordered_map>
+
 using namespace arangodb;
 using namespace arangodb::consensus;
 
@@ -672,8 +674,37 @@ void AgencyCache::invokeCallbackNoLock(uint64_t id,
 }
 
 void AgencyCache::invokeCallbacks(std::vector<uint64_t> const& toCall) const {
+  // local callbacks which need a value are grouped by key, so that the value
+  // for each key is read from the cache only once
+  std::unordered_map<std::string, std::vector<std::shared_ptr<AgencyCallback>>>
+      byKey;
   for (auto i : toCall) {
-    invokeCallbackNoLock(i);
+    auto cb = _callbackRegistry.getCallback(i);
+    if (cb != nullptr && cb->local() && cb->needsValue()) {
+      byKey[cb->key].emplace_back(std::move(cb));
+    } else {
+      invokeCallbackNoLock(i);
+    }
+  }
+
+  for (auto const& [key, callbacks] : byKey) {
+    auto [builder, idx] =
+        read(std::vector<std::string>{AgencyCommHelper::path(key)});
+    for (auto const& cb : callbacks) {
+      try {
+        if (builder->slice().isArray()) {
+          cb->updateFromCache(builder->slice(), idx);
+        } else {
+          // logs the error
+          cb->refetchAndUpdate(true, false);
+        }
+        LOG_TOPIC("a8c1e", TRACE, Logger::CLUSTER)
+            << "Agency callback for " << key << " has been triggered";
+      } catch (arangodb::basics::Exception const& e) {
+        LOG_TOPIC("5b2f7", WARN, Logger::AGENCYCOMM)
+            << "Error executing callback: " << e.message();
+      }
+    }
   }
 }
 
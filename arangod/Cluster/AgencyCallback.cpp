@@ -120,6 +120,22 @@ void AgencyCallback::refetchAndUpdate(bool needToAcquireMutex,
     result = tmp.slice();
   }
 
+  update(result, idx, needToAcquireMutex, forceCheck);
+}
+
+void AgencyCallback::updateFromCache(velocypack::Slice result,
+                                     consensus::index_t idx) {
+  TRI_ASSERT(_local);
+  if (!_needsValue) {
+    std::lock_guard locker{_cv.mutex};
+    executeEmpty();
+    return;
+  }
+  update(result, idx, /*needToAcquireMutex*/ true, /*forceCheck*/ false);
+}
+
+void AgencyCallback::update(velocypack::Slice result, consensus::index_t idx,
+                            bool needToAcquireMutex, bool forceCheck) {
   std::vector<std::string> kv =
       basics::StringUtils::split(AgencyCommHelper::path(key), '/');
   kv.erase(std::remove(kv.begin(), kv.end(), ""), kv.end());
@@ -122,6 +122,15 @@ class AgencyCallback {
 
   void refetchAndUpdate(bool needToAcquireMutex, bool forceCheck);
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief call the callback function with a value that has already been
+  /// read from the agency cache for this callback's key, at the given commit
+  /// index. This allows reading the value only once for all local callbacks
+  /// on the same key.
+  //////////////////////////////////////////////////////////////////////////////
+
+  void updateFromCache(velocypack::Slice result, consensus::index_t idx);
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief wait until a callback is received or a timeout has happened
   ///
@@ -139,6 +148,8 @@ class AgencyCallback {
 
   bool needsInitialValue() const noexcept { return _needsInitialValue; }
 
+  bool needsValue() const noexcept { return _needsValue; }
+
  private:
   // execute callback with current value data:
   bool execute(velocypack::Slice data, consensus::index_t raftIndex);
@@ -151,6 +162,10 @@ class AgencyCallback {
   void checkValue(std::shared_ptr<velocypack::Builder>,
                   consensus::index_t raftIndex, bool forceCheck);
 
+  // extract the value for the key from a read result, and check it:
+  void update(velocypack::Slice result, consensus::index_t idx,
+              bool needToAcquireMutex, bool forceCheck);
+
  private:
   ArangodServer& _server;
   std::unique_ptr<AgencyComm> _agency;
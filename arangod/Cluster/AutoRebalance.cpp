@@ -25,6 +25,7 @@
 #include "Basics/debugging.h"
 
 #include <algorithm>
+#include <numeric>
 #include <queue>
 #include <random>
 #include <string_view>
@@ -140,6 +141,36 @@ uint64_t AutoRebalanceProblem::createCollection(std::string const& name,
   return collId;
 }
 
+void AutoRebalanceProblem::applyShardLoads(
+    std::unordered_map<std::string, ShardLoad> const& loads) {
+  if (loads.empty() || shards.empty()) {
+    return;
+  }
+  std::vector<uint64_t> writes(shards.size(), 0);
+  for (auto& shard : shards) {
+    if (auto it = loads.find(shard.name); it != loads.end()) {
+      if (it->second.size > 0) {
+        shard.size = it->second.size;
+      }
+      writes[shard.id] = it->second.writes;
+    }
+  }
+
+  // scale the leadership weights by the observed write load. a shard with
+  // the average number of writes keeps its weight, a shard without writes
+  // gets half of it, and hot shards get proportionally more, so that their
+  // leaderships are spread across the DBServers
+  double const mean =
+      static_cast<double>(
+          std::accumulate(writes.begin(), writes.end(), uint64_t{0})) /
+      static_cast<double>(writes.size());
+  if (mean > 0.0) {
+    for (auto& shard : shards) {
+      shard.weight *= 0.5 + 0.5 * static_cast<double>(writes[shard.id]) / mean;
+    }
+  }
+}
+
 #ifdef ARANGODB_USE_GOOGLE_TESTS
 void AutoRebalanceProblem::createRandomDatabasesAndCollections(
     uint32_t nrDBs, uint32_t nrColls, uint32_t minReplFactor,
@@ -61,6 +61,12 @@ struct Shard {
   bool isSystem;        // flag, if shard is from a system collection
 };
 
+/// @brief observed load of a shard, as reported by the DBServers
+struct ShardLoad {
+  uint64_t size = 0;    // bytes, approximate size of data and indexes
+  uint64_t writes = 0;  // document operations committed since server start
+};
+
 struct Collection {
   std::vector<uint32_t> shards{};
   std::string name;
@@ -187,6 +193,11 @@ struct AutoRebalanceProblem {
   uint64_t createCollection(std::string const& name, std::string const& dbName,
                             uint32_t numberOfShards, uint32_t replicationFactor,
                             double weight = 1.0);
+  // applies the observed loads, keyed by shard name, to the shards: reported
+  // sizes replace the default size, and the leadership weights are scaled by
+  // the write load. shards without a reported load count as idle
+  void applyShardLoads(
+      std::unordered_map<std::string, ShardLoad> const& loads);
 #ifdef ARANGODB_USE_GOOGLE_TESTS
   void createCluster(uint32_t nrDBserver, bool withZones = false);
   void createRandomDatabasesAndCollections(uint32_t nrDBs, uint32_t nrColls,
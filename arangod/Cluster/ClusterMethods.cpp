@@ -45,6 +45,7 @@
 #include "Metrics/Counter.h"
 #include "Metrics/Types.h"
 #include "Network/ClusterUtils.h"
+#include "Network/DocumentReadCoalescer.h"
 #include "Network/Methods.h"
 #include "Network/NetworkFeature.h"
 #include "Network/Utils.h"
@@ -1949,6 +1950,30 @@ Future<OperationResult> getDocumentOnCoordinator(
     // All shard keys are known in all documents.
     // Contact all shards directly with the correct information.
 
+    network::DocumentReadCoalescer* coalescer =
+        trx.vocbase()
+            .server()
+            .getFeature<NetworkFeature>()
+            .documentReadCoalescer();
+    if (coalescer != nullptr && api != transaction::MethodsApi::Synchronous &&
+        !useMultiple && !options.silent && !allowDirtyReads &&
+        !ClusterTrxMethods::isElCheapo(trx) &&
+        (options.ignoreRevs || !slice.isObject() ||
+         !slice.hasKey(StaticStrings::RevString))) {
+      // a plain lookup by key outside of a larger transaction, which can be
+      // combined with concurrent lookups from the same shard. synchronous
+      // lookups block their scheduler thread, so they are never held back
+      // for a batch that another scheduler thread sends
+      TRI_ASSERT(opCtx.shardMap.size() == 1);
+      VPackSlice keySlice = slice;
+      if (slice.isObject()) {
+        keySlice = slice.get(StaticStrings::KeyString);
+      }
+      return coalescer->read(trx.vocbase().name(),
+                             opCtx.shardMap.begin()->first,
+                             keySlice.stringView(), options);
+    }
+
     Future<Result> f = makeFuture(Result());
     if (isManaged &&
         opCtx.shardMap.size() > 1) {  // lazily begin the transaction
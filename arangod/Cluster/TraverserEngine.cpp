@@ -44,6 +44,7 @@
 #endif
 
 #include <string_view>
+#include <vector>
 
 using namespace arangodb;
 using namespace arangodb::graph;
@@ -283,10 +284,11 @@ graph::EdgeCursor* BaseTraverserEngine::getCursor(std::string_view nextVertex,
 void BaseTraverserEngine::getEdges(VPackSlice vertex, size_t depth,
                                    VPackBuilder& builder) {
   auto outputVertex = [this](VPackBuilder& builder, VPackSlice vertex,
-                             size_t depth) {
+                             size_t depth) -> size_t {
     TRI_ASSERT(vertex.isString());
 
     graph::EdgeCursor* cursor = getCursor(vertex.stringView(), depth);
+    size_t count = 0;
 
     cursor->readAll(
         [&](EdgeDocumentToken&& eid, VPackSlice edge, size_t cursorId) {
@@ -298,6 +300,7 @@ void BaseTraverserEngine::getEdges(VPackSlice vertex, size_t depth,
           }
           if (_opts->evaluateEdgeExpression(edge, vertex.stringView(), depth,
                                             cursorId)) {
+            ++count;
             if (!options().getEdgeProjections().empty()) {
               VPackObjectBuilder guard(&builder);
               options().getEdgeProjections().toVelocyPackFromDocument(
@@ -307,15 +310,20 @@ void BaseTraverserEngine::getEdges(VPackSlice vertex, size_t depth,
             }
           }
         });
+    return count;
   };
 
   TRI_ASSERT(vertex.isString() || vertex.isArray());
+  // for multiple vertices, the number of edges of each vertex, so that the
+  // caller can tell which edges belong to which vertex
+  std::vector<size_t> counts;
   builder.openObject();
   builder.add(VPackValue(StaticStrings::GraphQueryEdges));
   builder.openArray(true);
   if (vertex.isArray()) {
+    counts.reserve(vertex.length());
     for (VPackSlice v : VPackArrayIterator(vertex)) {
-      outputVertex(builder, v, depth);
+      counts.push_back(outputVertex(builder, v, depth));
     }
   } else if (vertex.isString()) {
     outputVertex(builder, vertex, depth);
@@ -324,6 +332,14 @@ void BaseTraverserEngine::getEdges(VPackSlice vertex, size_t depth,
     THROW_ARANGO_EXCEPTION(TRI_ERROR_BAD_PARAMETER);
   }
   builder.close();
+  if (vertex.isArray()) {
+    builder.add(VPackValue(StaticStrings::GraphQueryEdgeCounts));
+    builder.openArray(true);
+    for (size_t count : counts) {
+      builder.add(VPackValue(count));
+    }
+    builder.close();
+  }
   // statistics
   builder.add("readIndex",
               VPackValue(_opts->cache()->getAndResetInsertedDocuments()));
@@ -408,15 +424,19 @@ void ShortestPathEngine::getEdges(VPackSlice vertex, bool backward,
                                   VPackBuilder& builder) {
   TRI_ASSERT(vertex.isString() || vertex.isArray());
 
+  // for multiple vertices, the number of edges of each vertex
+  std::vector<size_t> counts;
   builder.openObject();
   builder.add(StaticStrings::GraphQueryEdges,
               VPackValue(VPackValueType::Array));
   if (vertex.isArray()) {
+    counts.reserve(vertex.length());
     for (VPackSlice v : VPackArrayIterator(vertex)) {
       if (!v.isString()) {
+        counts.push_back(0);
         continue;
       }
-      addEdgeData(builder, backward, v.stringView());
+      counts.push_back(addEdgeData(builder, backward, v.stringView()));
       // Result now contains all valid edges, probably multiples.
     }
   } else if (vertex.isString()) {
@@ -426,6 +446,14 @@ void ShortestPathEngine::getEdges(VPackSlice vertex, bool backward,
     THROW_ARANGO_EXCEPTION(TRI_ERROR_BAD_PARAMETER);
   }
   builder.close();
+  if (vertex.isArray()) {
+    builder.add(StaticStrings::GraphQueryEdgeCounts,
+                VPackValue(VPackValueType::Array));
+    for (size_t count : counts) {
+      builder.add(VPackValue(count));
+    }
+    builder.close();
+  }
 
   // statistics
   builder.add("readIndex",
@@ -446,12 +474,13 @@ graph::BaseOptions const& ShortestPathEngine::options() const {
   return *_opts;
 }
 
-void ShortestPathEngine::addEdgeData(VPackBuilder& builder, bool backward,
-                                     std::string_view v) {
+size_t ShortestPathEngine::addEdgeData(VPackBuilder& builder, bool backward,
+                                       std::string_view v) {
   graph::EdgeCursor* cursor =
       backward ? _backwardCursor.get() : _forwardCursor.get();
   cursor->rearm(v, 0);
 
+  size_t count = 0;
   cursor->readAll(
       [&](EdgeDocumentToken&& eid, VPackSlice edge, size_t /*cursorId*/) {
         if (edge.isString()) {
@@ -460,6 +489,7 @@ void ShortestPathEngine::addEdgeData(VPackBuilder& builder, bool backward,
         if (edge.isNull()) {
           return;
         }
+        ++count;
         if (!options().getEdgeProjections().empty()) {
           VPackObjectBuilder guard(&builder);
           options().getEdgeProjections().toVelocyPackFromDocument(builder, edge,
@@ -468,6 +498,7 @@ void ShortestPathEngine::addEdgeData(VPackBuilder& builder, bool backward,
           builder.add(edge);
         }
       });
+  return count;
 }
 
 TraverserEngine::TraverserEngine(TRI_vocbase_t& vocbase,
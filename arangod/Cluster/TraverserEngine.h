@@ -163,8 +163,9 @@ class ShortestPathEngine : public BaseEngine {
   graph::BaseOptions const& options() const override;
 
  private:
-  void addEdgeData(arangodb::velocypack::Builder& builder, bool backward,
-                   std::string_view v);
+  // returns the number of edges added
+  size_t addEdgeData(arangodb::velocypack::Builder& builder, bool backward,
+                     std::string_view v);
 
  protected:
   std::unique_ptr<graph::ShortestPathOptions> _opts;
@@ -46,19 +46,20 @@ Acceptor::Acceptor(rest::GeneralServer& server, rest::IoContext& context,
 
 std::unique_ptr<Acceptor> Acceptor::factory(rest::GeneralServer& server,
                                             rest::IoContext& context,
-                                            Endpoint* endpoint) {
+                                            Endpoint* endpoint,
+                                            bool reusePort) {
 #ifdef ARANGODB_HAVE_DOMAIN_SOCKETS
   if (endpoint->domainType() == Endpoint::DomainType::UNIX) {
     return std::make_unique<AcceptorUnixDomain>(server, context, endpoint);
   }
 #endif
   if (endpoint->encryption() == Endpoint::EncryptionType::SSL) {
-    return std::make_unique<AcceptorTcp<rest::SocketType::Ssl>>(server, context,
-                                                                endpoint);
+    return std::make_unique<AcceptorTcp<rest::SocketType::Ssl>>(
+        server, context, endpoint, reusePort);
   } else {
     TRI_ASSERT(endpoint->encryption() == Endpoint::EncryptionType::NONE);
-    return std::make_unique<AcceptorTcp<rest::SocketType::Tcp>>(server, context,
-                                                                endpoint);
+    return std::make_unique<AcceptorTcp<rest::SocketType::Tcp>>(
+        server, context, endpoint, reusePort);
   }
 }
 
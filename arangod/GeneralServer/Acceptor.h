@@ -48,8 +48,12 @@ class Acceptor {
   virtual void asyncAccept() = 0;
 
  public:
+  /// if reusePort is set, the listening socket of a TCP endpoint is opened
+  /// with SO_REUSEPORT, and accepted connections are served by the acceptor's
+  /// own io context
   static std::unique_ptr<Acceptor> factory(rest::GeneralServer& server,
-                                           rest::IoContext& context, Endpoint*);
+                                           rest::IoContext& context, Endpoint*,
+                                           bool reusePort);
 
  protected:
   void handleError(asio_ns::error_code const&);
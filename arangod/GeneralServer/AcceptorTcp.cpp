@@ -99,6 +99,15 @@ void AcceptorTcp<T>::open() {
 #else
   _acceptor.set_option(asio_ns::ip::tcp::acceptor::reuse_address(
       ((EndpointIp*)_endpoint)->reuseAddress()));
+#if defined(__linux__) && defined(SO_REUSEPORT)
+  if (_reusePort) {
+    // the kernel distributes incoming connections across all sockets bound to
+    // the same address with this option
+    using ReusePort =
+        asio_ns::detail::socket_option::boolean<SOL_SOCKET, SO_REUSEPORT>;
+    _acceptor.set_option(ReusePort(true));
+  }
+#endif
 #endif
 
   _acceptor.bind(asioEndpoint, ec);
@@ -145,7 +154,8 @@ void AcceptorTcp<SocketType::Tcp>::asyncAccept() {
   TRI_ASSERT(_endpoint->encryption() == Endpoint::EncryptionType::NONE);
 
   auto asioSocket =
-      std::make_unique<AsioSocket<SocketType::Tcp>>(_server.selectIoContext());
+      std::make_unique<AsioSocket<SocketType::Tcp>>(
+          _reusePort ? _ctx : _server.selectIoContext());
   auto& socket = asioSocket->socket;
   auto& peer = asioSocket->peer;
   auto handler = [this, asioSocket = std::move(asioSocket)](
@@ -256,7 +266,7 @@ void AcceptorTcp<SocketType::Ssl>::asyncAccept() {
   TRI_ASSERT(_endpoint->encryption() == Endpoint::EncryptionType::SSL);
 
   // select the io context for this socket
-  auto& ctx = _server.selectIoContext();
+  auto& ctx = _reusePort ? _ctx : _server.selectIoContext();
 
   auto asioSocket =
       std::make_unique<AsioSocket<SocketType::Ssl>>(ctx, _server.sslContexts());
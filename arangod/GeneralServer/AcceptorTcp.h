@@ -35,8 +35,10 @@ template<SocketType T>
 class AcceptorTcp final : public Acceptor {
  public:
   AcceptorTcp(rest::GeneralServer& server, rest::IoContext& ctx,
-              Endpoint* endpoint)
-      : Acceptor(server, ctx, endpoint), _acceptor(ctx.io_context) {}
+              Endpoint* endpoint, bool reusePort)
+      : Acceptor(server, ctx, endpoint),
+        _acceptor(ctx.io_context),
+        _reusePort(reusePort) {}
 
  public:
   void open() override;
@@ -49,6 +51,9 @@ class AcceptorTcp final : public Acceptor {
 
  private:
   asio_ns::ip::tcp::acceptor _acceptor;
+  /// @brief whether the socket is one of several listening on the same port.
+  /// accepted connections are then served by this acceptor's io context
+  bool const _reusePort;
 };
 }  // namespace rest
 }  // namespace arangodb
@@ -23,17 +23,28 @@
 
 #include "AsyncJobManager.h"
 
+#include "Basics/EncodingUtils.h"
+#include "Basics/FileUtils.h"
 #include "Basics/ReadLocker.h"
+#include "Basics/ScopeGuard.h"
+#include "Basics/StaticStrings.h"
+#include "Basics/StringBuffer.h"
 #include "Basics/WriteLocker.h"
+#include "Basics/files.h"
 #include "Basics/system-functions.h"
 #include "Basics/voc-errors.h"
 #include "Cluster/ServerState.h"
 #include "GeneralServer/RestHandler.h"
+#include "Logger/LogMacros.h"
 #include "Logger/Logger.h"
 #include "Rest/GeneralResponse.h"
+#include "Rest/HttpResponse.h"
 #include "RestServer/SoftShutdownFeature.h"
+#include "RestServer/TemporaryStorageFeature.h"
 #include "Utils/ExecContext.h"
 
+#include <velocypack/Builder.h>
+
 namespace {
 bool authorized(
     std::pair<std::string, arangodb::rest::AsyncJobResult> const& job) {
@@ -44,6 +55,9 @@ bool authorized(
 
   return (job.first == exec.user());
 }
+
+// bodies larger than this cannot be uncompressed again
+constexpr uint64_t maxSpillSize = 512 * 1024 * 1024;
 }  // namespace
 
 using namespace arangodb;
@@ -51,7 +65,12 @@ using namespace arangodb::basics;
 using namespace arangodb::rest;
 
 AsyncJobResult::AsyncJobResult()
-    : _jobId(0), _response(nullptr), _stamp(0.0), _status(JOB_UNDEFINED) {}
+    : _jobId(0),
+      _response(nullptr),
+      _stamp(0.0),
+      _status(JOB_UNDEFINED),
+      _memoryUsage(0),
+      _spillFileSize(0) {}
 
 AsyncJobResult::AsyncJobResult(IdType jobId, Status status,
                                std::shared_ptr<RestHandler>&& handler)
@@ -59,12 +78,23 @@ AsyncJobResult::AsyncJobResult(IdType jobId, Status status,
       _response(nullptr),
       _stamp(TRI_microtime()),
       _status(status),
-      _handler(std::move(handler)) {}
+      _handler(std::move(handler)),
+      _memoryUsage(0),
+      _spillFileSize(0) {}
 
 AsyncJobResult::~AsyncJobResult() = default;
 
-AsyncJobManager::AsyncJobManager()
-    : _lock(), _jobs(), _softShutdownOngoing(false) {}
+AsyncJobManager::AsyncJobManager() : AsyncJobManager(0, 0, nullptr) {}
+
+AsyncJobManager::AsyncJobManager(uint64_t memoryLimit, uint64_t spillThreshold,
+                                 TemporaryStorageFeature* temporaryStorage)
+    : _memoryLimit(memoryLimit),
+      _spillThreshold(spillThreshold),
+      _temporaryStorage(temporaryStorage),
+      _lock(),
+      _jobs(),
+      _memoryUsage(0),
+      _softShutdownOngoing(false) {}
 
 AsyncJobManager::~AsyncJobManager() {
   // remove all results that haven't been fetched
@@ -99,7 +129,18 @@ GeneralResponse* AsyncJobManager::getJobResult(AsyncJobResult::IdType jobId,
   }
 
   // remove the job from the list
+  AsyncJobResult result = std::move((*it).second.second);
   _jobs.erase(it);
+  TRI_ASSERT(_memoryUsage >= result._memoryUsage);
+  _memoryUsage -= result._memoryUsage;
+  writeLocker.unlock();
+
+  if (!result._spillFile.empty()) {
+    std::unique_ptr<GeneralResponse> guard(response);
+    auto sg = scopeGuard([&]() noexcept { removeSpillFile(result); });
+    restoreResponse(result, *response);
+    guard.release();
+  }
   return response;
 }
 
@@ -116,11 +157,7 @@ bool AsyncJobManager::deleteJobResult(AsyncJobResult::IdType jobId) {
     return false;
   }
 
-  GeneralResponse* response = (*it).second.second._response;
-
-  if (response != nullptr) {
-    delete response;
-  }
+  releaseResult((*it).second.second);
 
   // remove the job from the list
   _jobs.erase(it);
@@ -138,10 +175,7 @@ void AsyncJobManager::deleteJobs() {
 
   while (it != _jobs.end()) {
     if (::authorized(it->second)) {
-      GeneralResponse* response = (*it).second.second._response;
-      if (response != nullptr) {
-        delete response;
-      }
+      releaseResult((*it).second.second);
       _jobs.erase(it++);
     } else {
       ++it;
@@ -156,15 +190,10 @@ void AsyncJobManager::deleteExpiredJobResults(double stamp) {
 
   while (it != _jobs.end()) {
     if (::authorized(it->second)) {
-      AsyncJobResult ajr = (*it).second.second;
+      AsyncJobResult& ajr = (*it).second.second;
 
       if (ajr._stamp < stamp) {
-        GeneralResponse* response = ajr._response;
-
-        if (response != nullptr) {
-          delete response;
-        }
-
+        releaseResult(ajr);
         _jobs.erase(it++);
       } else {
         ++it;
@@ -211,6 +240,7 @@ Result AsyncJobManager::clearAllJobs() {
     if (handler != nullptr) {
       handler->cancel();
     }
+    releaseResult(it.second.second);
   }
   _jobs.clear();
 
@@ -311,16 +341,175 @@ void AsyncJobManager::finishAsyncJob(RestHandler* handler) {
   AsyncJobResult::IdType jobId = handler->handlerId();
   std::unique_ptr<GeneralResponse> response = handler->stealResponse();
 
-  {
-    WRITE_LOCKER(writeLocker, _lock);
-    auto it = _jobs.find(jobId);
+  uint64_t bodySize = 0;
+  if (response != nullptr &&
+      response->transportType() == Endpoint::TransportType::HTTP) {
+    bodySize = static_cast<HttpResponse&>(*response).bodySize();
+  }
 
-    if (it == _jobs.end()) {
-      return;  // job is already canceled
+  std::string spillFile;
+  uint64_t spillFileSize = 0;
+  if (bodySize > 0 && (_spillThreshold > 0 || _memoryLimit > 0)) {
+    bool spill = (_spillThreshold > 0 && bodySize >= _spillThreshold);
+    if (!spill && _memoryLimit > 0) {
+      READ_LOCKER(readLocker, _lock);
+      spill = (_memoryUsage + bodySize > _memoryLimit);
+    }
+    if (spill && spillResponse(jobId, *response, spillFile, spillFileSize)) {
+      bodySize = 0;
     }
+  }
 
-    it->second.second._response = response.release();
-    it->second.second._status = AsyncJobResult::JOB_DONE;
-    it->second.second._stamp = TRI_microtime();
+  WRITE_LOCKER(writeLocker, _lock);
+  auto it = _jobs.find(jobId);
+
+  if (it == _jobs.end()) {
+    // job is already canceled
+    writeLocker.unlock();
+    if (!spillFile.empty()) {
+      AsyncJobResult canceled;
+      canceled._spillFile = std::move(spillFile);
+      canceled._spillFileSize = spillFileSize;
+      removeSpillFile(canceled);
+    }
+    return;
   }
+
+  if (bodySize > 0 && _memoryLimit > 0 &&
+      _memoryUsage + bodySize > _memoryLimit) {
+    // cannot keep the result. replace it with an error, which has a small
+    // body
+    LOG_TOPIC("2f8a1", WARN, Logger::REQUESTS)
+        << "dropping result of async job " << jobId << " with a body of "
+        << bodySize << " bytes, because async job results would use more "
+        << "memory than the configured limit of " << _memoryLimit << " bytes";
+    ErrorCode errorNumber = TRI_ERROR_RESOURCE_LIMIT;
+    auto code = GeneralResponse::responseCode(errorNumber);
+    response->reset(code);
+    velocypack::Builder builder;
+    builder.openObject();
+    builder.add(StaticStrings::Code, velocypack::Value(static_cast<int>(code)));
+    builder.add(StaticStrings::Error, velocypack::Value(true));
+    builder.add(StaticStrings::ErrorMessage,
+                velocypack::Value("result of async job is too large to be "
+                                  "stored"));
+    builder.add(StaticStrings::ErrorNum, velocypack::Value(errorNumber));
+    builder.close();
+    response->setContentType(ContentType::JSON);
+    response->setPayload(builder.slice());
+    bodySize = 0;
+  }
+
+  _memoryUsage += bodySize;
+  it->second.second._memoryUsage = bodySize;
+  it->second.second._spillFile = std::move(spillFile);
+  it->second.second._spillFileSize = spillFileSize;
+  it->second.second._response = response.release();
+  it->second.second._status = AsyncJobResult::JOB_DONE;
+  it->second.second._stamp = TRI_microtime();
+}
+
+uint64_t AsyncJobManager::memoryUsage() {
+  READ_LOCKER(readLocker, _lock);
+  return _memoryUsage;
+}
+
+bool AsyncJobManager::spillResponse(AsyncJobResult::IdType jobId,
+                                    GeneralResponse& response,
+                                    std::string& file,
+                                    uint64_t& fileSize) noexcept {
+  TRI_ASSERT(response.transportType() == Endpoint::TransportType::HTTP);
+  StorageUsageTracker* usageTracker = nullptr;
+  if (_temporaryStorage != nullptr) {
+    usageTracker = _temporaryStorage->usageTracker();
+  }
+  if (usageTracker == nullptr) {
+    // no directory for intermediate results configured
+    return false;
+  }
+
+  auto& body = static_cast<HttpResponse&>(response).body();
+  if (body.size() > ::maxSpillSize) {
+    return false;
+  }
+
+  try {
+    basics::StringBuffer compressed(false);
+    if (encoding::gzipCompress(reinterpret_cast<uint8_t const*>(body.data()),
+                               body.size(),
+                               compressed) != TRI_ERROR_NO_ERROR) {
+      return false;
+    }
+
+    // throws if the disk capacity for intermediate results is exhausted
+    usageTracker->increaseUsage(compressed.size());
+    auto sg = scopeGuard([&]() noexcept {
+      usageTracker->decreaseUsage(compressed.size());
+    });
+
+    std::string name = basics::FileUtils::buildFilename(
+        _temporaryStorage->asyncJobResultsPath(),
+        "job-" + std::to_string(jobId) + ".gz");
+    basics::FileUtils::spit(name, compressed.data(), compressed.size());
+    sg.cancel();
+
+    fileSize = compressed.size();
+    file = std::move(name);
+
+    // free the memory of the body
+    basics::StringBuffer empty(false);
+    body.swap(&empty);
+    return true;
+  } catch (std::exception const& ex) {
+    LOG_TOPIC("7c3d0", INFO, Logger::REQUESTS)
+        << "unable to spill result of async job " << jobId << ": "
+        << ex.what();
+  } catch (...) {
+  }
+  return false;
+}
+
+void AsyncJobManager::restoreResponse(AsyncJobResult const& result,
+                                      GeneralResponse& response) {
+  TRI_ASSERT(response.transportType() == Endpoint::TransportType::HTTP);
+  std::string compressed = basics::FileUtils::slurp(result._spillFile);
+
+  auto& httpResponse = static_cast<HttpResponse&>(response);
+  httpResponse.clearBody();
+  ErrorCode res = encoding::gzipUncompress(
+      reinterpret_cast<uint8_t const*>(compressed.data()), compressed.size(),
+      httpResponse.body());
+  if (res != TRI_ERROR_NO_ERROR) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(
+        res, "unable to read spilled result of async job " +
+                 std::to_string(result._jobId));
+  }
+}
+
+void AsyncJobManager::removeSpillFile(AsyncJobResult& result) noexcept {
+  if (result._spillFile.empty()) {
+    return;
+  }
+  ErrorCode res = TRI_UnlinkFile(result._spillFile.c_str());
+  if (res != TRI_ERROR_NO_ERROR) {
+    LOG_TOPIC("e41b5", WARN, Logger::REQUESTS)
+        << "unable to remove spilled result of async job '"
+        << result._spillFile << "': " << TRI_errno_string(res);
+  }
+  TRI_ASSERT(_temporaryStorage != nullptr);
+  StorageUsageTracker* usageTracker = _temporaryStorage->usageTracker();
+  if (usageTracker != nullptr) {
+    usageTracker->decreaseUsage(result._spillFileSize);
+  }
+  result._spillFile.clear();
+  result._spillFileSize = 0;
+}
+
+void AsyncJobManager::releaseResult(AsyncJobResult& result) noexcept {
+  delete result._response;
+  result._response = nullptr;
+  TRI_ASSERT(_memoryUsage >= result._memoryUsage);
+  _memoryUsage -= result._memoryUsage;
+  result._memoryUsage = 0;
+  removeSpillFile(result);
 }
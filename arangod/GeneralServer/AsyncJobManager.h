@@ -32,6 +32,7 @@
 
 namespace arangodb {
 class GeneralResponse;
+class TemporaryStorageFeature;
 
 namespace rest {
 class RestHandler;
@@ -59,6 +60,11 @@ struct AsyncJobResult {
   double _stamp;
   Status _status;
   std::shared_ptr<RestHandler> _handler;
+  // size of the response body kept in memory
+  uint64_t _memoryUsage;
+  // file with the compressed response body, if the body has been spilled
+  std::string _spillFile;
+  uint64_t _spillFileSize;
 };
 
 // -----------------------------------------------------------------------------
@@ -66,6 +72,11 @@ struct AsyncJobResult {
 // -----------------------------------------------------------------------------
 
 /// @brief Manages responses which will be fetched later by clients.
+/// Response bodies of at least spillThreshold bytes, and bodies which would
+/// make the stored bodies use more than memoryLimit bytes in total, are
+/// moved into compressed files in the directory for intermediate results,
+/// if that is configured. If a body does not fit into the memory limit and
+/// cannot be spilled, the response is replaced by an error.
 class AsyncJobManager {
   AsyncJobManager(AsyncJobManager const&) = delete;
   AsyncJobManager& operator=(AsyncJobManager const&) = delete;
@@ -77,6 +88,8 @@ class AsyncJobManager {
 
  public:
   AsyncJobManager();
+  AsyncJobManager(uint64_t memoryLimit, uint64_t spillThreshold,
+                  TemporaryStorageFeature* temporaryStorage);
   ~AsyncJobManager();
 
  public:
@@ -104,9 +117,29 @@ class AsyncJobManager {
     _softShutdownOngoing.store(true, std::memory_order_relaxed);
   }
 
+  /// @brief total size of the response bodies kept in memory
+  uint64_t memoryUsage();
+
  private:
+  /// @brief writes the compressed response body into a file, and frees the
+  /// body. returns false if the body could not be spilled
+  bool spillResponse(AsyncJobResult::IdType, GeneralResponse&,
+                     std::string& file, uint64_t& fileSize) noexcept;
+  /// @brief reads the response body back from the spill file
+  void restoreResponse(AsyncJobResult const&, GeneralResponse&);
+  void removeSpillFile(AsyncJobResult&) noexcept;
+  /// @brief frees the response and its spill file. must be called under
+  /// the write lock
+  void releaseResult(AsyncJobResult&) noexcept;
+
+  uint64_t const _memoryLimit;
+  uint64_t const _spillThreshold;
+  TemporaryStorageFeature* _temporaryStorage;
+
   basics::ReadWriteLock _lock;
   JobList _jobs;
+  // total size of the response bodies kept in memory, protected by _lock
+  uint64_t _memoryUsage;
 
   ////////////////////////////////////////////////////////////////////////////
   /// @brief flag, if a soft shutdown is ongoing, this is used for the soft
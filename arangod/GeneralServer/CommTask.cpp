@@ -1053,6 +1053,9 @@ bool CommTask::handleContentEncoding(GeneralRequest& req) {
       }
       req.setPayload(std::move(dst));
       return true;
+    } else if (encoding == StaticStrings::EncodingIdentity) {
+      // not encoded
+      return true;
     }
     return false;
   };
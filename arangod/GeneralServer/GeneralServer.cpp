@@ -98,14 +98,29 @@ void GeneralServer::unregisterTask(CommTask* task) {
 
 void GeneralServer::startListening(EndpointList& list) {
   unsigned int i = 0;
+  bool reusePort = false;
+#ifdef __linux__
+  reusePort = _feature.reusePort() && _contexts.size() > 1;
+#endif
 
-  list.apply([&i, this](std::string const& specification, Endpoint& ep) {
+  list.apply([&i, reusePort, this](std::string const& specification,
+                                   Endpoint& ep) {
     LOG_TOPIC("e62e0", TRACE, arangodb::Logger::FIXME)
         << "trying to bind to endpoint '" << specification << "' for requests";
 
-    // distribute endpoints across all io contexts
-    IoContext& ioContext = _contexts[i++ % _contexts.size()];
-    bool ok = openEndpoint(ioContext, &ep);
+    bool ok = true;
+    if (reusePort && ep.domainType() != Endpoint::DomainType::UNIX &&
+        ep.port() != 0) {
+      // one listening socket per io context, so that connection attempts
+      // are accepted by all io threads in parallel
+      for (IoContext& ioContext : _contexts) {
+        ok = ok && openEndpoint(ioContext, &ep, /*reusePort*/ true);
+      }
+    } else {
+      // distribute endpoints across all io contexts
+      IoContext& ioContext = _contexts[i++ % _contexts.size()];
+      ok = openEndpoint(ioContext, &ep, /*reusePort*/ false);
+    }
 
     if (ok) {
       LOG_TOPIC("dc45a", DEBUG, arangodb::Logger::FIXME)
@@ -167,8 +182,10 @@ void GeneralServer::stopWorking() {
 // --SECTION--                                                 protected methods
 // -----------------------------------------------------------------------------
 
-bool GeneralServer::openEndpoint(IoContext& ioContext, Endpoint* endpoint) {
-  auto acceptor = rest::Acceptor::factory(*this, ioContext, endpoint);
+bool GeneralServer::openEndpoint(IoContext& ioContext, Endpoint* endpoint,
+                                 bool reusePort) {
+  auto acceptor =
+      rest::Acceptor::factory(*this, ioContext, endpoint, reusePort);
   try {
     acceptor->open();
   } catch (...) {
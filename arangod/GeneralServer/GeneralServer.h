@@ -71,7 +71,7 @@ class GeneralServer {
   Result reloadTLS();
 
  protected:
-  bool openEndpoint(IoContext& ioContext, Endpoint* endpoint);
+  bool openEndpoint(IoContext& ioContext, Endpoint* endpoint, bool reusePort);
 
  private:
   GeneralServerFeature& _feature;
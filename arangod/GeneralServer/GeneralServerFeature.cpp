@@ -118,6 +118,7 @@
 #include "Metrics/GaugeBuilder.h"
 #include "Metrics/MetricsFeature.h"
 #include "RestServer/QueryRegistryFeature.h"
+#include "RestServer/TemporaryStorageFeature.h"
 #include "RestServer/UpgradeFeature.h"
 #include "Scheduler/Scheduler.h"
 #include "Scheduler/SchedulerFeature.h"
@@ -197,6 +198,7 @@ GeneralServerFeature::GeneralServerFeature(Server& server)
   startsAfter<HttpEndpointProvider>();
   startsAfter<SslServerFeature>();
   startsAfter<SchedulerFeature>();
+  startsAfter<TemporaryStorageFeature>();
   startsAfter<UpgradeFeature>();
 
   _numIoThreads =
@@ -313,6 +315,91 @@ current queueing/dequeuing time for requests in the scheduler (in seconds).
 Client applications and drivers can use this value to control the server load
 and also react on overload.)");
 
+  options
+      ->addOption("--http.compress-response-threshold",
+                  "The HTTP response body size (in bytes) from which on "
+                  "responses are compressed if the client accepts it "
+                  "(0 = only for APIs that always allow compression).",
+                  new UInt64Parameter(&_compressResponseThreshold))
+      .setIntroducedIn(31200)
+      .setLongDescription(R"(Responses are compressed with gzip or deflate,
+depending on the `Accept-Encoding` header sent by the client. Compression
+happens on the thread that executed the request, not on the I/O threads.
+Responses of asynchronous requests and responses via VelocyStream are never
+compressed.)");
+
+  options
+      ->addOption("--http.async-job-results-memory-limit",
+                  "The maximum memory usage (in bytes) for the response "
+                  "bodies of async jobs that have not been fetched yet "
+                  "(0 = unlimited).",
+                  new UInt64Parameter(&_asyncJobResultsMemoryLimit))
+      .setIntroducedIn(31200)
+      .setLongDescription(R"(Results of requests sent with the
+`x-arango-async: store` header are kept until they are fetched via the
+`/_api/job` API. If storing a response body would exceed this limit, the body
+is written into a compressed file in the directory for intermediate results
+(`--temp.intermediate-results-path`) instead. If no such directory is
+configured, or its capacity is exhausted, the result is replaced by an error.
+
+The limit applies to HTTP/1 and HTTP/2 responses.)");
+
+  options
+      ->addOption("--http.async-job-results-spill-threshold",
+                  "The response body size (in bytes) from which on results "
+                  "of async jobs are written into compressed files "
+                  "(0 = only when exceeding the memory limit).",
+                  new UInt64Parameter(&_asyncJobResultsSpillThreshold))
+      .setIntroducedIn(31200)
+      .setLongDescription(R"(Writing large results of async jobs into files
+in the directory for intermediate results (`--temp.intermediate-results-path`)
+keeps long-running exports from using lots of memory until their results are
+fetched. Results are only written into files if the directory is configured.)");
+
+  options
+      ->addOption("--http.batch-concurrency",
+                  "The maximum number of parts of a batch request that are "
+                  "executed concurrently.",
+                  new UInt64Parameter(&_batchConcurrency, /*base*/ 1,
+                                      /*minValue*/ 1),
+                  arangodb::options::makeFlags(
+                      arangodb::options::Flags::DefaultNoComponents,
+                      arangodb::options::Flags::OnCoordinator,
+                      arangodb::options::Flags::OnSingle,
+                      arangodb::options::Flags::Uncommon))
+      .setIntroducedIn(31200)
+      .setLongDescription(R"(The parts of a request to the `/_api/batch`
+endpoint are executed one after the other by default. If this option is set to
+a value greater than 1, consecutive parts with the `GET` or `HEAD` method are
+executed concurrently, up to the configured number at a time. A part with any
+other method is still executed on its own: only after all previous parts have
+finished, and before any later part starts. The responses of all parts are
+returned in the order of the parts in the request.
+
+Note that `GET` requests to Foxx services may have side effects. Only increase
+this value if no batch request relies on the order of such requests.)");
+
+  options
+      ->addOption("--http.reuse-port",
+                  "Open one listening socket per I/O thread for each TCP "
+                  "endpoint, using `SO_REUSEPORT` (Linux only).",
+                  new BooleanParameter(&_reusePort),
+                  arangodb::options::makeFlags(
+                      arangodb::options::Flags::DefaultNoOs,
+                      arangodb::options::Flags::OsLinux))
+      .setIntroducedIn(31200)
+      .setLongDescription(R"(If enabled, every I/O thread accepts connections
+on its own socket, and the kernel distributes incoming connections across
+these sockets. Connections are then served by the I/O thread that accepted
+them. This avoids funneling all connection attempts through a single accepting
+thread, which can help when many clients connect at the same time.
+
+If disabled, each endpoint is served by a single listening socket, and accepted
+connections are assigned to the I/O thread with the fewest connections.
+
+Endpoints using Unix domain sockets and endpoints with port 0 always use a
+single listening socket.)");
+
   options
       ->addOption("--server.early-connections",
                   "Allow requests to a limited set of APIs early during the "
@@ -409,7 +496,11 @@ void GeneralServerFeature::prepare() {
     _enableTelemetrics = false;
   }
 
-  _jobManager = std::make_unique<AsyncJobManager>();
+  _jobManager = std::make_unique<AsyncJobManager>(
+      _asyncJobResultsMemoryLimit, _asyncJobResultsSpillThreshold,
+      server().hasFeature<TemporaryStorageFeature>()
+          ? &server().getFeature<TemporaryStorageFeature>()
+          : nullptr);
 
   // create an initial, very stripped-down RestHandlerFactory.
   // this initial factory only knows a few selected RestHandlers.
@@ -503,6 +594,16 @@ bool GeneralServerFeature::returnQueueTimeHeader() const noexcept {
   return _returnQueueTimeHeader;
 }
 
+uint64_t GeneralServerFeature::compressResponseThreshold() const noexcept {
+  return _compressResponseThreshold;
+}
+
+uint64_t GeneralServerFeature::batchConcurrency() const noexcept {
+  return _batchConcurrency;
+}
+
+bool GeneralServerFeature::reusePort() const noexcept { return _reusePort; }
+
 std::vector<std::string> GeneralServerFeature::trustedProxies() const {
   return _trustedProxies;
 }
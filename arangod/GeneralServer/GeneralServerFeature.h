@@ -59,6 +59,9 @@ class GeneralServerFeature final : public ArangodFeature {
   double keepAliveTimeout() const noexcept;
   bool proxyCheck() const noexcept;
   bool returnQueueTimeHeader() const noexcept;
+  uint64_t compressResponseThreshold() const noexcept;
+  uint64_t batchConcurrency() const noexcept;
+  bool reusePort() const noexcept;
   std::vector<std::string> trustedProxies() const;
   std::vector<std::string> const& accessControlAllowOrigins() const;
   Result reloadTLS();
@@ -106,6 +109,10 @@ class GeneralServerFeature final : public ArangodFeature {
 
   double _keepAliveTimeout = 300.0;
   uint64_t _telemetricsMaxRequestsPerInterval;
+  uint64_t _compressResponseThreshold = 0;
+  uint64_t _asyncJobResultsMemoryLimit = 0;
+  uint64_t _asyncJobResultsSpillThreshold = 0;
+  uint64_t _batchConcurrency = 1;
 #ifdef ARANGODB_ENABLE_MAINTAINER_MODE
   bool _startedListening;
 #endif
@@ -114,6 +121,7 @@ class GeneralServerFeature final : public ArangodFeature {
   bool _proxyCheck;
   bool _returnQueueTimeHeader;
   bool _permanentRootRedirect;
+  bool _reusePort = false;
   std::vector<std::string> _trustedProxies;
   std::vector<std::string> _accessControlAllowOrigins;
   std::string _redirectRootTo;
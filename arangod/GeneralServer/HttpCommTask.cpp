@@ -41,6 +41,7 @@
 #include "Statistics/RequestStatistics.h"
 
 #include <cstring>
+#include <string_view>
 
 using namespace arangodb;
 using namespace arangodb::basics;
@@ -207,16 +208,10 @@ int HttpCommTask<T>::on_header_complete(llhttp_t* p) try {
   if (found && StringUtils::trim(expect) == "100-continue") {
     LOG_TOPIC("2b604", TRACE, arangodb::Logger::REQUESTS)
         << "received a 100-continue request";
-    char const* response = "HTTP/1.1 100 Continue\r\n\r\n";
-    auto buff = asio_ns::buffer(response, strlen(response));
-    asio_ns::async_write(
-        me->_protocol->socket, buff,
-        [self = me->shared_from_this()](asio_ns::error_code const& ec,
-                                        std::size_t) {
-          if (ec) {
-            static_cast<HttpCommTask<T>*>(self.get())->close(ec);
-          }
-        });
+    // the response to the previous request may still be being written
+    if (me->_writeQueue.addContinue(me->_writing)) {
+      me->writeContinue();
+    }
     return HPE_OK;
   }
 
@@ -376,7 +371,8 @@ void HttpCommTask<T>::setIOTimeout() {
 
   const bool wasReading = this->_reading;
   const bool wasWriting = this->_writing;
-  TRI_ASSERT((wasReading && !wasWriting) || (!wasReading && wasWriting));
+  // we may read the next pipelined request while writing a response
+  TRI_ASSERT(wasReading || wasWriting);
 
   auto millis = std::chrono::milliseconds(static_cast<int64_t>(secs * 1000));
   this->_protocol->timer.expires_after(millis);
@@ -512,8 +508,10 @@ void HttpCommTask<T>::doProcessRequest() {
              // already been closed
   }
 
-  // we may have gotten an H2 Upgrade request
-  if (ADB_UNLIKELY(_parser.upgrade)) {
+  // we may have gotten an H2 Upgrade request. a pipelined request cannot
+  // upgrade the connection while we are still writing the response to the
+  // previous request, so its Upgrade header is ignored then
+  if (ADB_UNLIKELY(_parser.upgrade) && !this->_writing) {
     LOG_TOPIC("5a660", INFO, Logger::REQUESTS)
         << "detected an 'Upgrade' header";
     bool found;
@@ -789,23 +787,39 @@ static void DTraceHttpCommTaskResponseWritten(size_t) {}
 // called on IO context thread
 template<SocketType T>
 void HttpCommTask<T>::writeResponse(RequestStatistics::Item stat) {
+  // we may still be writing the response to the previous request
+  auto toWrite = _writeQueue.addResponse(this->_writing, std::move(stat));
+  if (!toWrite.has_value()) {
+    return;
+  }
+
   DTraceHttpCommTaskWriteResponse((size_t)this);
 
   TRI_ASSERT(!_header.empty());
 
-  stat.SET_WRITE_START();
+  toWrite->SET_WRITE_START();
+
+  // move the response out of the way, so that the next request can be
+  // processed while we are writing
+  _writeHeader = std::move(_header);
+  _header.clear();
+  _writeBody = std::move(_response);
 
   std::array<asio_ns::const_buffer, 2> buffers;
-  buffers[0] = asio_ns::buffer(_header.data(), _header.size());
+  buffers[0] = asio_ns::buffer(_writeHeader.data(), _writeHeader.size());
   if (HTTP_HEAD != _parser.method) {
-    buffers[1] = asio_ns::buffer(_response->data(), _response->size());
+    buffers[1] = asio_ns::buffer(_writeBody->data(), _writeBody->size());
   }
 
+  llhttp_errno_t err = llhttp_get_errno(&_parser);
+  bool const keepAlive = _shouldKeepAlive && err == HPE_PAUSED;
+
   this->_writing = true;
   asio_ns::async_write(
       this->_protocol->socket, buffers,
-      withLogContext([self = this->shared_from_this(), stat = std::move(stat)](
-                         asio_ns::error_code ec, size_t nwrite) {
+      withLogContext([self = this->shared_from_this(),
+                      stat = std::move(*toWrite),
+                      keepAlive](asio_ns::error_code ec, size_t nwrite) {
         DTraceHttpCommTaskResponseWritten((size_t)self.get());
 
         auto& me = static_cast<HttpCommTask<T>&>(*self);
@@ -814,18 +828,65 @@ void HttpCommTask<T>::writeResponse(RequestStatistics::Item stat) {
         stat.SET_WRITE_END();
         stat.ADD_SENT_BYTES(nwrite);
 
-        me._response.reset();
+        me._writeBody.reset();
+
+        if (ec || !keepAlive) {
+          me.close(ec);
+        } else {
+          me.writePending();
+        }
+      }));
+
+  if (keepAlive) {
+    // read and process the next (pipelined) request while the response is
+    // being written
+    llhttp_resume(&_parser);
+    this->asyncReadSome();
+  }
+}
+
+template<SocketType T>
+void HttpCommTask<T>::writeContinue() {
+  static constexpr std::string_view response =
+      "HTTP/1.1 100 Continue\r\n\r\n";
+
+  TRI_ASSERT(!this->_writing);
 
-        llhttp_errno_t err = llhttp_get_errno(&me._parser);
-        if (ec || !me._shouldKeepAlive || err != HPE_PAUSED) {
+  this->_writing = true;
+  asio_ns::async_write(
+      this->_protocol->socket,
+      asio_ns::buffer(response.data(), response.size()),
+      withLogContext([self = this->shared_from_this()](
+                         asio_ns::error_code const& ec, std::size_t) {
+        auto& me = static_cast<HttpCommTask<T>&>(*self);
+        me._writing = false;
+        if (ec) {
           me.close(ec);
-        } else {  // ec == HPE_PAUSED
-          llhttp_resume(&me._parser);
-          me.asyncReadSome();
+        } else {
+          me.writePending();
         }
       }));
 }
 
+template<SocketType T>
+void HttpCommTask<T>::writePending() {
+  TRI_ASSERT(!this->_writing);
+  if (this->stopped()) {
+    return;
+  }
+  switch (_writeQueue.next()) {
+    case HttpWriteQueue<RequestStatistics::Item>::Write::CONTINUE:
+      _writeQueue.popContinue();
+      writeContinue();
+      break;
+    case HttpWriteQueue<RequestStatistics::Item>::Write::RESPONSE:
+      writeResponse(_writeQueue.popResponse());
+      break;
+    case HttpWriteQueue<RequestStatistics::Item>::Write::NOTHING:
+      break;
+  }
+}
+
 template<SocketType T>
 std::unique_ptr<GeneralResponse> HttpCommTask<T>::createResponse(
     rest::ResponseCode responseCode, uint64_t mid) {
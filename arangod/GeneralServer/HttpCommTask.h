@@ -24,6 +24,7 @@
 #pragma once
 
 #include "GeneralServer/GeneralCommTask.h"
+#include "GeneralServer/HttpWriteQueue.h"
 
 #include <llhttp.h>
 #include <memory>
@@ -79,6 +80,12 @@ class HttpCommTask final : public GeneralCommTask<T> {
   // called on IO context thread
   void writeResponse(RequestStatistics::Item stat);
 
+  // called on IO context thread
+  void writeContinue();
+
+  // called on IO context thread, after a write has finished
+  void writePending();
+
   std::string url() const;
 
   /// the node http-parser
@@ -87,6 +94,13 @@ class HttpCommTask final : public GeneralCommTask<T> {
 
   velocypack::Buffer<uint8_t> _header;
 
+  // ==== write state, only accessed on the IO context thread ====
+  // while a response is written, the next pipelined request is already
+  // parsed and executed. its response waits until the write has finished
+  velocypack::Buffer<uint8_t> _writeHeader;
+  std::unique_ptr<basics::StringBuffer> _writeBody;
+  HttpWriteQueue<RequestStatistics::Item> _writeQueue;
+
   // ==== parser state ====
   std::string _lastHeaderField;
   std::string _lastHeaderValue;
@@ -0,0 +1,92 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Basics/debugging.h"
+
+#include <optional>
+#include <utility>
+
+namespace arangodb::rest {
+
+/// @brief keeps the writes of a pipelined HTTP/1.1 connection in order.
+/// while a response is written, the next request is already read and
+/// executed. its "100 Continue" and its response wait here until the write
+/// has finished. there is at most one of each, because the request after
+/// that one is only read once the waiting response is written.
+template<typename Response>
+class HttpWriteQueue {
+ public:
+  enum class Write { NOTHING, CONTINUE, RESPONSE };
+
+  /// @brief a "100 Continue" is to be written. returns whether it can be
+  /// written right away, otherwise it is written after the current write
+  bool addContinue(bool writing) noexcept {
+    if (writing) {
+      _continuePending = true;
+      return false;
+    }
+    return true;
+  }
+
+  /// @brief a response is to be written. returns it if it can be written
+  /// right away, otherwise it is written after the current write
+  std::optional<Response> addResponse(bool writing, Response response) {
+    if (writing) {
+      TRI_ASSERT(!_pendingResponse.has_value());
+      _pendingResponse.emplace(std::move(response));
+      return std::nullopt;
+    }
+    return std::optional<Response>(std::move(response));
+  }
+
+  /// @brief returns what to write after a write has finished. a waiting
+  /// "100 Continue" belongs to the request of the waiting response, so it
+  /// is written first
+  Write next() const noexcept {
+    if (_continuePending) {
+      return Write::CONTINUE;
+    }
+    if (_pendingResponse.has_value()) {
+      return Write::RESPONSE;
+    }
+    return Write::NOTHING;
+  }
+
+  void popContinue() noexcept {
+    TRI_ASSERT(_continuePending);
+    _continuePending = false;
+  }
+
+  Response popResponse() {
+    TRI_ASSERT(_pendingResponse.has_value());
+    Response response = std::move(*_pendingResponse);
+    _pendingResponse.reset();
+    return response;
+  }
+
+ private:
+  std::optional<Response> _pendingResponse;
+  bool _continuePending = false;
+};
+
+}  // namespace arangodb::rest
@@ -392,6 +392,7 @@ void RestHandler::runHandlerStateMachine() {
       case HandlerState::EXECUTE: {
         executeEngine(/*isContinue*/ false);
         if (_state == HandlerState::PAUSED) {
+          _statistics.SET_SUSPEND_START();
           shutdownExecute(false);
           LOG_TOPIC("23a33", DEBUG, Logger::COMMUNICATION)
               << "Pausing rest handler execution " << this;
@@ -403,6 +404,7 @@ void RestHandler::runHandlerStateMachine() {
       case HandlerState::CONTINUED: {
         executeEngine(/*isContinue*/ true);
         if (_state == HandlerState::PAUSED) {
+          _statistics.SET_SUSPEND_START();
           shutdownExecute(/*isFinalized*/ false);
           LOG_TOPIC("23727", DEBUG, Logger::COMMUNICATION)
               << "Pausing rest handler execution " << this;
@@ -414,6 +416,7 @@ void RestHandler::runHandlerStateMachine() {
       case HandlerState::PAUSED:
         LOG_TOPIC("ae26f", DEBUG, Logger::COMMUNICATION)
             << "Resuming rest handler execution " << this;
+        _statistics.SET_SUSPEND_END();
         _state = HandlerState::CONTINUED;
         break;
 
@@ -604,23 +607,41 @@ void RestHandler::generateError(rest::ResponseCode code, ErrorCode errorNumber,
 }
 
 void RestHandler::compressResponse() {
-  if (!_isAsyncRequest && _response->isCompressionAllowed()) {
-    switch (_request->acceptEncoding()) {
-      case rest::EncodingType::DEFLATE:
-        _response->deflate();
+  if (_isAsyncRequest ||
+      _request->acceptEncoding() == rest::EncodingType::UNSET) {
+    return;
+  }
+
+  if (!_response->isCompressionAllowed()) {
+    // responses of all APIs are compressed if they are large enough
+    uint64_t threshold = server()
+                             .getFeature<GeneralServerFeature>()
+                             .compressResponseThreshold();
+    if (threshold == 0 ||
+        _response->transportType() != Endpoint::TransportType::HTTP ||
+        _response->headers().contains(StaticStrings::ContentEncoding) ||
+        static_cast<HttpResponse&>(*_response).bodySize() < threshold) {
+      return;
+    }
+  }
+
+  switch (_request->acceptEncoding()) {
+    case rest::EncodingType::DEFLATE:
+      if (_response->deflate() == TRI_ERROR_NO_ERROR) {
         _response->setHeaderNC(StaticStrings::ContentEncoding,
                                StaticStrings::EncodingDeflate);
-        break;
+      }
+      break;
 
-      case rest::EncodingType::GZIP:
-        _response->gzip();
+    case rest::EncodingType::GZIP:
+      if (_response->gzip() == TRI_ERROR_NO_ERROR) {
         _response->setHeaderNC(StaticStrings::ContentEncoding,
                                StaticStrings::EncodingGzip);
-        break;
+      }
+      break;
 
-      default:
-        break;
-    }
+    default:
+      break;
   }
 }
 
@@ -21,6 +21,8 @@
 /// @author Dr. Frank Celler
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <chrono>
+#include <cstring>
 #include <exception>
 #include <stdexcept>
 #include <unordered_set>
@@ -31,10 +33,14 @@
 
 #include <openssl/asn1.h>
 #include <openssl/bio.h>
+#include <openssl/core_names.h>
 #include <openssl/ec.h>
+#include <openssl/evp.h>
 #include <openssl/objects.h>
 #include <openssl/opensslv.h>
 #include <openssl/ossl_typ.h>
+#include <openssl/params.h>
+#include <openssl/rand.h>
 #include <openssl/safestack.h>
 #include <openssl/ssl3.h>
 #include <openssl/x509.h>
@@ -43,6 +49,7 @@
 
 #include "ApplicationFeatures/ApplicationServer.h"
 #include "Basics/FileUtils.h"
+#include "Basics/StringUtils.h"
 #include "Basics/application-exit.h"
 #include "Basics/files.h"
 #include "Logger/LogLevel.h"
@@ -54,6 +61,7 @@
 #include "ProgramOptions/ProgramOptions.h"
 #include "ProgramOptions/Section.h"
 #include "Random/UniformCharacter.h"
+#include "Ssl/SslInterface.h"
 #include "Ssl/ssl-helper.h"
 
 // Work-around for nghttp2 non-standard definition ssize_t under windows
@@ -237,6 +245,27 @@ http://www.openssl.org/docs/ssl/SSL_CTX_set_options.html))");
                      "Allows to let the server prefer HTTP/1.1 over HTTP/2 in "
                      "ALPN protocol negotiations",
                      new BooleanParameter(&_preferHttp11InAlpn));
+
+  options
+      ->addOption("--ssl.session-ticket-secret-file",
+                  "A file containing the secret from which the keys for "
+                  "TLS session tickets are derived.",
+                  new StringParameter(&_sessionTicketSecretFile))
+      .setIntroducedIn(31200)
+      .setLongDescription(R"(By default, the keys for encrypting TLS session
+tickets are random and known only to the server process that created them.
+Clients can then only resume their TLS sessions with the same server, and only
+until it is restarted or its TLS data is reloaded.
+
+If you specify a file with a secret, the session ticket keys are derived from
+the secret instead. The keys are rotated every hour, and tickets encrypted
+with the previous key are still accepted. If you use the same secret on all
+Coordinators, clients can resume their sessions with any of them, saving the
+costly full TLS handshake. This requires the clocks of the servers to be
+roughly in sync.
+
+Keep the file secret, like the private key. Anyone knowing the secret can
+decrypt the session tickets and thus the traffic of resumed sessions.)");
 }
 
 void SslServerFeature::validateOptions(
@@ -262,6 +291,24 @@ void SslServerFeature::prepare() {
   UniformCharacter r(
       "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789");
   _rctx = r.random(SSL_MAX_SSL_SESSION_ID_LENGTH);
+
+  if (!_sessionTicketSecretFile.empty()) {
+    try {
+      _sessionTicketSecret =
+          StringUtils::trim(FileUtils::slurp(_sessionTicketSecretFile));
+    } catch (std::exception const& ex) {
+      LOG_TOPIC("e0b1c", FATAL, arangodb::Logger::SSL)
+          << "unable to read session ticket secret from '"
+          << _sessionTicketSecretFile << "': " << ex.what();
+      FATAL_ERROR_EXIT();
+    }
+    if (_sessionTicketSecret.empty()) {
+      LOG_TOPIC("2d6c4", FATAL, arangodb::Logger::SSL)
+          << "session ticket secret file '" << _sessionTicketSecretFile
+          << "' is empty";
+      FATAL_ERROR_EXIT();
+    }
+  }
 }
 
 void SslServerFeature::unprepare() {
@@ -319,6 +366,104 @@ class BIOGuard {
  public:
   BIO* _bio;
 };
+
+// interval after which the session ticket keys derived from a secret change
+constexpr std::chrono::seconds ticketKeyRotation = std::chrono::hours(1);
+
+struct TicketKey {
+  unsigned char name[16];
+  unsigned char aesKey[32];
+  unsigned char hmacKey[32];
+};
+
+// index of the session ticket secret in the ex data of an SSL_CTX
+int ticketSecretIndex() {
+  static int const index =
+      SSL_CTX_get_ex_new_index(0, nullptr, nullptr, nullptr, nullptr);
+  return index;
+}
+
+// derives the session ticket key of the epoch from the secret. all servers
+// with the same secret derive the same keys. this is cheap compared to a
+// full TLS handshake, so the keys are not cached
+void deriveTicketKey(std::string const& secret, uint64_t epoch,
+                     TicketKey& key) {
+  auto derive = [&](std::string_view purpose, unsigned char* out,
+                    size_t length) {
+    std::string message;
+    message.append(purpose).push_back(':');
+    message.append(std::to_string(epoch));
+    std::string digest = rest::SslInterface::sslHMAC(
+        secret.data(), secret.size(), message.data(), message.size(),
+        rest::SslInterface::Algorithm::ALGORITHM_SHA256);
+    TRI_ASSERT(digest.size() >= length);
+    memcpy(out, digest.data(), length);
+  };
+  derive("name", &key.name[0], sizeof(key.name));
+  derive("aes", &key.aesKey[0], sizeof(key.aesKey));
+  derive("hmac", &key.hmacKey[0], sizeof(key.hmacKey));
+}
+
+bool setTicketMacKey(EVP_MAC_CTX* macCtx, TicketKey& key) {
+  OSSL_PARAM params[] = {
+      OSSL_PARAM_construct_octet_string(OSSL_MAC_PARAM_KEY, &key.hmacKey[0],
+                                        sizeof(key.hmacKey)),
+      OSSL_PARAM_construct_utf8_string(OSSL_MAC_PARAM_DIGEST,
+                                       const_cast<char*>("SHA256"), 0),
+      OSSL_PARAM_construct_end()};
+  return EVP_MAC_CTX_set_params(macCtx, params) == 1;
+}
+
+int sessionTicketKeyCallback(SSL* ssl, unsigned char keyName[16],
+                             unsigned char* iv, EVP_CIPHER_CTX* cipherCtx,
+                             EVP_MAC_CTX* macCtx, int enc) noexcept {
+  auto const* secret = static_cast<std::string const*>(
+      SSL_CTX_get_ex_data(SSL_get_SSL_CTX(ssl), ticketSecretIndex()));
+  if (secret == nullptr) {
+    return -1;
+  }
+
+  try {
+    auto now = std::chrono::system_clock::now().time_since_epoch();
+    uint64_t epoch = static_cast<uint64_t>(now / ticketKeyRotation);
+    TicketKey key;
+
+    if (enc == 1) {
+      // issue a new ticket with the current key
+      deriveTicketKey(*secret, epoch, key);
+      EVP_CIPHER const* cipher = EVP_aes_256_cbc();
+      if (RAND_bytes(iv, EVP_CIPHER_iv_length(cipher)) != 1) {
+        return -1;
+      }
+      memcpy(keyName, &key.name[0], sizeof(key.name));
+      if (EVP_EncryptInit_ex(cipherCtx, cipher, nullptr, &key.aesKey[0], iv) !=
+              1 ||
+          !setTicketMacKey(macCtx, key)) {
+        return -1;
+      }
+      return 1;
+    }
+
+    // accept tickets encrypted with the current or the previous key
+    for (uint64_t e : {epoch, epoch - 1}) {
+      deriveTicketKey(*secret, e, key);
+      if (memcmp(keyName, &key.name[0], sizeof(key.name)) != 0) {
+        continue;
+      }
+      if (!setTicketMacKey(macCtx, key) ||
+          EVP_DecryptInit_ex(cipherCtx, EVP_aes_256_cbc(), nullptr,
+                             &key.aesKey[0], iv) != 1) {
+        return -1;
+      }
+      // let the client renew a ticket encrypted with the previous key
+      return e == epoch ? 1 : 2;
+    }
+    // unknown key, needs a full handshake
+    return 0;
+  } catch (...) {
+    return -1;
+  }
+}
 }  // namespace
 
 static inline bool searchForProtocol(const unsigned char** out,
@@ -389,6 +534,20 @@ asio_ns::ssl::context SslServerFeature::createSslContextInternal(
           << "using SSL session caching";
     }
 
+    if (!_sessionTicketSecret.empty()) {
+      // derive session ticket keys from the shared secret, so that sessions
+      // can be resumed with all servers using the same secret
+      if (SSL_CTX_set_ex_data(nativeContext, ticketSecretIndex(),
+                              &_sessionTicketSecret) != 1 ||
+          SSL_CTX_set_tlsext_ticket_key_evp_cb(
+              nativeContext, sessionTicketKeyCallback) != 1) {
+        LOG_TOPIC("0b7e2", ERR, arangodb::Logger::SSL)
+            << "cannot set SSL session ticket key callback: "
+            << lastSSLError();
+        throw std::runtime_error("cannot create SSL context");
+      }
+    }
+
     // set options
     sslContext.set_options(static_cast<long>(_sslOptions));
 
@@ -83,6 +83,9 @@ class SslServerFeature : public ArangodFeature {
   std::string _ecdhCurve;
   bool _sessionCache;
   bool _preferHttp11InAlpn;
+  // file containing the secret from which session ticket keys are derived
+  std::string _sessionTicketSecretFile;
+  std::string _sessionTicketSecret;
 
  private:
   asio_ns::ssl::context createSslContextInternal(std::string keyfileName,
@@ -51,6 +51,8 @@
 #include <velocypack/Iterator.h>
 #include <velocypack/Slice.h>
 
+#include <algorithm>
+
 using namespace arangodb;
 using namespace arangodb::aql;
 using namespace arangodb::graph;
@@ -62,7 +64,8 @@ BaseOptions::LookupInfo::LookupInfo(TRI_edge_direction_e direction)
     : indexCondition(nullptr),
       direction(direction),
       conditionNeedUpdate(false),
-      conditionMemberToUpdate(0) {
+      conditionMemberToUpdate(0),
+      estimatedItems(0) {
   // NOTE: We need exactly one in this case for the optimizer to update
   idxHandles.resize(1);
   TRI_ASSERT(direction == TRI_EDGE_IN || direction == TRI_EDGE_OUT);
@@ -96,6 +99,8 @@ BaseOptions::LookupInfo::LookupInfo(arangodb::aql::QueryContext& query,
   conditionMemberToUpdate =
       arangodb::basics::VelocyPackHelper::getNumericValue<size_t>(
           info, "condMemberToUpdate", 0);
+  estimatedItems = arangodb::basics::VelocyPackHelper::getNumericValue<size_t>(
+      info, "estimatedItems", 0);
 
   VPackSlice read = info.get("handle");
   if (!read.isObject()) {
@@ -150,7 +155,8 @@ BaseOptions::LookupInfo::LookupInfo(LookupInfo const& other)
       indexCondition(other.indexCondition),
       direction(other.direction),
       conditionNeedUpdate(other.conditionNeedUpdate),
-      conditionMemberToUpdate(other.conditionMemberToUpdate) {
+      conditionMemberToUpdate(other.conditionMemberToUpdate),
+      estimatedItems(other.estimatedItems) {
   if (other.expression != nullptr) {
     expression = other.expression->clone(nullptr);
   }
@@ -191,6 +197,7 @@ void BaseOptions::LookupInfo::buildEngineInfo(VPackBuilder& result) const {
   indexCondition->toVelocyPack(result, true);
   result.add("condNeedUpdate", VPackValue(conditionNeedUpdate));
   result.add("condMemberToUpdate", VPackValue(conditionMemberToUpdate));
+  result.add("estimatedItems", VPackValue(estimatedItems));
   result.add(VPackValue("nonConstContainer"));
   _nonConstContainer.toVelocyPack(result);
 }
@@ -199,6 +206,12 @@ double BaseOptions::LookupInfo::estimateCost(size_t& nrItems) const {
   // If we do not have an index yet we cannot do anything.
   // Should NOT be the case
   TRI_ASSERT(!idxHandles.empty());
+  if (estimatedItems > 0) {
+    // the index' estimate for the full condition. this also takes into
+    // account attributes other than _from / _to that the index covers
+    nrItems += estimatedItems;
+    return static_cast<double>(estimatedItems);
+  }
   std::shared_ptr<Index> const& idx = idxHandles[0];
   if (idx->hasSelectivityEstimate()) {
     double s = idx->selectivityEstimate();
@@ -400,11 +413,14 @@ void BaseOptions::injectLookupInfoInList(std::vector<LookupInfo>& list,
     THROW_ARANGO_EXCEPTION(TRI_ERROR_ARANGO_DATA_SOURCE_NOT_FOUND);
   }
 
-  // arbitrary value for "number of edges in collection" used here. the
-  // actual value does not matter much. 1000 has historically worked fine.
-  constexpr size_t itemsInCollection = 1000;
-
   auto& trx = plan->getAst()->query().trxForOptimization();
+  // estimate for the number of edges in the collection. may be outdated...
+  // the lookup costs of the candidate indexes (e.g. the edge index, or a
+  // persistent index on _from plus attributes used in the edge conditions)
+  // are compared based on it.
+  size_t const itemsInCollection =
+      std::max<size_t>(coll->count(&trx, transaction::CountType::TryCache), 1);
+
   bool res = aql::utils::getBestIndexHandleForFilterCondition(
       trx, *coll, info.indexCondition, _tmpVar, itemsInCollection,
       aql::IndexHint(), info.idxHandles[0], onlyEdgeIndexes);
@@ -414,6 +430,17 @@ void BaseOptions::injectLookupInfoInList(std::vector<LookupInfo>& list,
                                    "expected edge index not found");
   }
 
+  // remember the chosen index' estimate for the whole condition. it is more
+  // precise than its selectivity estimate if the index covers only some of
+  // its attributes, and is then used for the traversal's cost estimate
+  {
+    Index::FilterCosts costs = info.idxHandles[0]->supportsFilterCondition(
+        trx, coll->indexes(), info.indexCondition, _tmpVar, itemsInCollection);
+    if (costs.supportsCondition) {
+      info.estimatedItems = std::max<size_t>(costs.estimatedItems, 1);
+    }
+  }
+
   // We now have to check if we need _from / _to inside the index lookup and
   // which position
   // it is used in. Such that the traverser can update the respective string
@@ -89,6 +89,9 @@ struct BaseOptions {
     bool conditionNeedUpdate;
     // Position of _from / _to in the index search condition
     size_t conditionMemberToUpdate;
+    // Expected number of edges per lookup, as estimated by the index for the
+    // full index condition. 0 if unknown
+    size_t estimatedItems;
 
     aql::NonConstExpressionContainer _nonConstContainer;
 
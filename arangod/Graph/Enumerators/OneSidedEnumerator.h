@@ -162,6 +162,11 @@ class OneSidedEnumerator final : public TraversalEnumerator {
  private:
   [[nodiscard]] auto searchDone() const -> bool;
 
+  // Expands one vertex at a time, on the calling thread. Expansion cannot
+  // be spread over multiple threads: the provider's cursors and caches, the
+  // validator's expression context and the PathStore are all owned by this
+  // enumerator, and all of them read through the query's transaction, which
+  // must only be used by one thread at a time.
   auto computeNeighbourhoodOfNextVertex() -> void;
 
   // Ensure that we have fetched all vertices in the _results list.
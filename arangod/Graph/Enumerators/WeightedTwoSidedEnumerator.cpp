@@ -336,21 +336,29 @@ auto WeightedTwoSidedEnumerator<QueueType, PathStoreType, ProviderType,
 template<class QueueType, class PathStoreType, class ProviderType,
          class PathValidator>
 WeightedTwoSidedEnumerator<QueueType, PathStoreType, ProviderType,
-                           PathValidator>::ResultCache::ResultCache(Ball& left,
-                                                                    Ball& right)
-    : _internalLeft(left), _internalRight(right), _internalResultsCache{} {}
+                           PathValidator>::ResultCache::
+    ResultCache(Ball& left, Ball& right,
+                arangodb::ResourceMonitor& resourceMonitor)
+    : _internalLeft(left),
+      _internalRight(right),
+      _resourceMonitor(resourceMonitor),
+      _internalResultsCache{} {}
 
 template<class QueueType, class PathStoreType, class ProviderType,
          class PathValidator>
 WeightedTwoSidedEnumerator<QueueType, PathStoreType, ProviderType,
-                           PathValidator>::ResultCache::~ResultCache() =
-    default;
+                           PathValidator>::ResultCache::~ResultCache() {
+  clear();
+}
 
 template<class QueueType, class PathStoreType, class ProviderType,
          class PathValidator>
 auto WeightedTwoSidedEnumerator<QueueType, PathStoreType, ProviderType,
                                 PathValidator>::ResultCache::clear() -> void {
   _internalResultsCache.clear();
+  _positionsByHash.clear();
+  _resourceMonitor.decreaseMemoryUsage(_memoryUsage);
+  _memoryUsage = 0;
 };
 
 template<class QueueType, class PathStoreType, class ProviderType,
@@ -366,14 +374,35 @@ auto WeightedTwoSidedEnumerator<QueueType, PathStoreType, ProviderType,
   // then checks whether we do have a path duplicate or not.
   _internalLeft.buildPath(first, resultPathCandidate);
   _internalRight.buildPath(second, resultPathCandidate);
-  for (auto const& pathToCheck : _internalResultsCache) {
-    bool foundDuplicate =
-        resultPathCandidate.isEqualEdgeRepresentation(pathToCheck);
+  std::size_t hash = resultPathCandidate.hashEdgeRepresentation();
+  auto [it, end] = _positionsByHash.equal_range(hash);
+  for (; it != end; ++it) {
+    bool foundDuplicate = resultPathCandidate.isEqualEdgeRepresentation(
+        _internalResultsCache[it->second]);
     if (foundDuplicate) {
       return false;
     }
   }
-  _internalResultsCache.push_back(std::move(resultPathCandidate));
+
+  // the hash table entry is counted with a rough estimate of its size
+  std::size_t memoryUsage =
+      resultPathCandidate.memoryUsage() + 4 * sizeof(std::size_t);
+  ResourceUsageScope guard(_resourceMonitor, memoryUsage);
+  _positionsByHash.emplace(hash, _internalResultsCache.size());
+  try {
+    _internalResultsCache.push_back(std::move(resultPathCandidate));
+  } catch (...) {
+    auto [begin, end] = _positionsByHash.equal_range(hash);
+    for (auto it = begin; it != end; ++it) {
+      if (it->second == _internalResultsCache.size()) {
+        _positionsByHash.erase(it);
+        break;
+      }
+    }
+    throw;
+  }
+  // now we are responsible for tracking the memory
+  _memoryUsage += guard.trackedAndSteal();
   return true;
 };
 
@@ -395,7 +424,7 @@ WeightedTwoSidedEnumerator<QueueType, PathStoreType, ProviderType,
             validatorOptions, resourceMonitor},
       _right{Direction::BACKWARD, std::move(backwardProvider), _options,
              std::move(validatorOptions), resourceMonitor},
-      _resultsCache(_left, _right),
+      _resultsCache(_left, _right, resourceMonitor),
       _resultPath{_left.provider(), _right.provider()} {}
 
 template<class QueueType, class PathStoreType, class ProviderType,
@@ -33,6 +33,7 @@
 
 #include <set>
 #include <deque>
+#include <unordered_map>
 
 namespace arangodb {
 
@@ -204,7 +205,8 @@ class WeightedTwoSidedEnumerator {
    */
   class ResultCache {
    public:
-    ResultCache(Ball& left, Ball& right);
+    ResultCache(Ball& left, Ball& right,
+                arangodb::ResourceMonitor& resourceMonitor);
     ~ResultCache();
 
     // @brief: returns whether a path could be inserted or not.
@@ -217,7 +219,14 @@ class WeightedTwoSidedEnumerator {
    private:
     Ball& _internalLeft;
     Ball& _internalRight;
+    arangodb::ResourceMonitor& _resourceMonitor;
     std::vector<PathResult<ProviderType, Step>> _internalResultsCache{};
+    // positions in _internalResultsCache by hash of the path's edges, so
+    // that a candidate only needs to be compared with the paths that have
+    // the same hash, instead of with all paths found so far
+    std::unordered_multimap<std::size_t, std::size_t> _positionsByHash{};
+    // memory usage of the cached paths, tracked in _resourceMonitor
+    std::size_t _memoryUsage{0};
   };
 
  public:
@@ -38,6 +38,8 @@
 
 #include <velocypack/Builder.h>
 
+#include <iterator>
+
 using namespace arangodb;
 using namespace arangodb::graph;
 
@@ -84,6 +86,19 @@ auto PathResult<ProviderType, Step>::prependEdge(typename Step::Edge e)
   _edges.insert(_edges.begin(), std::move(e));
 }
 
+template<class ProviderType, class Step>
+auto PathResult<ProviderType, Step>::prependReversed(
+    std::vector<typename Step::Vertex>& vertices,
+    std::vector<typename Step::Edge>& edges) -> void {
+  _numVerticesFromSourceProvider += vertices.size();
+  _numEdgesFromSourceProvider += edges.size();
+  _vertices.insert(_vertices.begin(),
+                   std::make_move_iterator(vertices.rbegin()),
+                   std::make_move_iterator(vertices.rend()));
+  _edges.insert(_edges.begin(), std::make_move_iterator(edges.rbegin()),
+                std::make_move_iterator(edges.rend()));
+}
+
 template<class ProviderType, class Step>
 auto PathResult<ProviderType, Step>::addWeight(double weight) -> void {
   _pathWeight += weight;
@@ -148,6 +163,25 @@ auto PathResult<ProviderType, Step>::isEqualEdgeRepresentation(
   return false;
 }
 
+template<class ProviderType, class Step>
+auto PathResult<ProviderType, Step>::hashEdgeRepresentation() const
+    -> std::size_t {
+  std::size_t hash = _edges.size();
+  for (auto const& edge : _edges) {
+    // same combination as boost::hash_combine
+    hash ^= edge.getID().hash() + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+  }
+  return hash;
+}
+
+template<class ProviderType, class Step>
+auto PathResult<ProviderType, Step>::memoryUsage() const noexcept
+    -> std::size_t {
+  return sizeof(PathResult) +
+         _vertices.capacity() * sizeof(typename Step::Vertex) +
+         _edges.capacity() * sizeof(typename Step::Edge);
+}
+
 template<class ProviderType, class Step>
 auto PathResult<ProviderType, Step>::lastVertexToVelocyPack(
     arangodb::velocypack::Builder& builder) -> void {
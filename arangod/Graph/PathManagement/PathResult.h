@@ -28,6 +28,7 @@
 #include "Containers/HashSet.h"
 
 #include <numeric>
+#include <vector>
 
 namespace arangodb {
 
@@ -50,11 +51,20 @@ class PathResult {
   auto prependVertex(typename Step::Vertex v) -> void;
   auto appendEdge(typename Step::Edge e) -> void;
   auto prependEdge(typename Step::Edge e) -> void;
+  // prepend all vertices and edges at once. both are given in reverse
+  // order, i.e. the last element becomes the first of the path. cheaper
+  // than prepending them one by one, as the path is only shifted once
+  auto prependReversed(std::vector<typename Step::Vertex>& vertices,
+                       std::vector<typename Step::Edge>& edges) -> void;
   auto addWeight(double weight) -> void;
   auto toVelocyPack(arangodb::velocypack::Builder& builder,
                     WeightType addWeight = WeightType::NONE) -> void;
   auto isEqualEdgeRepresentation(PathResult<ProviderType, Step> const& other)
       -> bool;
+  // hash over the edges, consistent with isEqualEdgeRepresentation
+  auto hashEdgeRepresentation() const -> std::size_t;
+  // approximate memory usage of the path, in bytes
+  auto memoryUsage() const noexcept -> std::size_t;
   auto lastVertexToVelocyPack(arangodb::velocypack::Builder& builder) -> void;
   auto lastEdgeToVelocyPack(arangodb::velocypack::Builder& builder) -> void;
 
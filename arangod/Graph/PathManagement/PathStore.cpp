@@ -114,15 +114,25 @@ auto PathStore<Step>::buildPath(Step const& vertex, PathResultType& path) const
   // this only needs to be added once.
   path.addWeight(vertex.getWeight());
 
+  // we walk the path backwards. prepending every vertex and edge to the
+  // path on its own would shift the path for each of them, so collect them
+  // first and prepend them all at once
+  size_t length = vertex.getDepth();
+  std::vector<typename Step::Vertex> vertices;
+  vertices.reserve(length + 1);
+  std::vector<typename Step::Edge> edges;
+  edges.reserve(length);
+
   while (!myStep->isFirst()) {
-    path.prependVertex(myStep->getVertex());
+    vertices.emplace_back(myStep->getVertex());
     TRI_ASSERT(myStep->getEdge().isValid());
-    path.prependEdge(myStep->getEdge());
+    edges.emplace_back(myStep->getEdge());
 
     TRI_ASSERT(size() > myStep->getPrevious());
     myStep = &_schreier[myStep->getPrevious()];
   }
-  path.prependVertex(myStep->getVertex());
+  vertices.emplace_back(myStep->getVertex());
+  path.prependReversed(vertices, edges);
 }
 
 template<class Step>
@@ -36,9 +36,12 @@
 #include "Basics/ScopeGuard.h"
 #include "Basics/StringUtils.h"
 #include "Basics/VelocyPackHelper.h"
+#include "Containers/FlatHashSet.h"
 
 #include "Logger/LogMacros.h"
 
+#include <limits>
+#include <map>
 #include <utility>
 #include <vector>
 
@@ -299,10 +302,14 @@ void ClusterProvider<StepImpl>::destroyEngines() {
 }
 
 template<class StepImpl>
-Result ClusterProvider<StepImpl>::fetchEdgesFromEngines(Step* step) {
+Result ClusterProvider<StepImpl>::fetchEdgesFromEngines(
+    std::vector<Step*> const& steps) {
+  TRI_ASSERT(!steps.empty());
+  Step* step = steps.front();
   TRI_ASSERT(step != nullptr);
   LOG_TOPIC("fa7dc", TRACE, Logger::GRAPHS)
-      << "<ClusterProvider> Expanding " << step->getVertex().getID();
+      << "<ClusterProvider> Expanding " << step->getVertex().getID()
+      << " and " << (steps.size() - 1) << " more vertices";
   auto const* engines = _opts.engines();
   transaction::BuilderLeaser leased(trx());
   leased->openObject(true);
@@ -322,7 +329,19 @@ Result ClusterProvider<StepImpl>::fetchEdgesFromEngines(Step* step) {
   }
   /* Needed for TRAVERSALS only - End */
 
-  leased->add("keys", VPackValue(step->getVertex().getID().toString()));
+  if (steps.size() == 1) {
+    leased->add("keys", VPackValue(step->getVertex().getID().toString()));
+  } else {
+    // the engines send the number of edges per vertex along with the edges
+    leased->add("keys", VPackValue(VPackValueType::Array));
+    for (Step const* s : steps) {
+      TRI_ASSERT(s->getDepth() == step->getDepth());
+      auto const& vertexId = s->getVertex().getID();
+      leased->add(VPackValuePair(vertexId.data(), vertexId.size(),
+                                 VPackValueType::String));
+    }
+    leased->close();  // 'keys' Array
+  }
   leased->close();
 
   auto* pool =
@@ -353,7 +372,10 @@ Result ClusterProvider<StepImpl>::fetchEdgesFromEngines(Step* step) {
         reqOpts));
   }
 
-  std::vector<std::pair<EdgeType, VertexType>> connectedEdges;
+  // the connected edges of each step
+  std::vector<std::vector<std::pair<EdgeType, VertexType>>> connectedEdges(
+      steps.size());
+  bool missingCounts = false;
   for (Future<network::Response>& f : futures) {
     network::Response const& r = f.get();
 
@@ -384,9 +406,41 @@ Result ClusterProvider<StepImpl>::fetchEdgesFromEngines(Step* step) {
     _stats.incrCacheMisses(
         Helper::getNumericValue<size_t>(resSlice, "cacheMisses", 0));
 
-    bool allCached = true;
+    VPackSlice counts = resSlice.get(StaticStrings::GraphQueryEdgeCounts);
+    if (steps.size() > 1 &&
+        (!counts.isArray() || counts.length() != steps.size())) {
+      // the engine does not tell which edge belongs to which vertex, e.g.
+      // because it runs an older version
+      missingCounts = true;
+      continue;
+    }
     VPackSlice edges = resSlice.get("edges");
+    if (!edges.isArray()) {
+      return TRI_ERROR_HTTP_CORRUPTED_JSON;
+    }
+    if (steps.size() > 1) {
+      size_t total = 0;
+      for (VPackSlice count : VPackArrayIterator(counts)) {
+        total += count.getNumber<size_t>();
+      }
+      if (total != edges.length()) {
+        return TRI_ERROR_HTTP_CORRUPTED_JSON;
+      }
+    }
+    size_t index = 0;
+    size_t remaining = steps.size() == 1 ? std::numeric_limits<size_t>::max()
+                                         : counts.at(0).getNumber<size_t>();
+
+    bool allCached = true;
     for (VPackSlice e : VPackArrayIterator(edges)) {
+      while (remaining == 0) {
+        ++index;
+        TRI_ASSERT(index < steps.size());
+        remaining = counts.at(index).getNumber<size_t>();
+      }
+      --remaining;
+      step = steps[index];
+
       VPackSlice id = e.get(StaticStrings::IdString);
       if (!id.isString()) {
         // invalid id type
@@ -410,7 +464,7 @@ Result ClusterProvider<StepImpl>::fetchEdgesFromEngines(Step* step) {
           edgeIdRef,
           VertexType{getEdgeDestination(edge, step->getVertex().getID())});
 
-      connectedEdges.emplace_back(edgeToEmplace);
+      connectedEdges[index].emplace_back(edgeToEmplace);
     }
 
     if (!allCached) {
@@ -420,15 +474,29 @@ Result ClusterProvider<StepImpl>::fetchEdgesFromEngines(Step* step) {
   // Note: This disables the ScopeGuard
   futures.clear();
 
-  std::uint64_t memoryPerItem =
-      costPerVertexOrEdgeType +
-      (connectedEdges.size() * (costPerVertexOrEdgeType * 2));
-  ResourceUsageScope guard(*_resourceMonitor, memoryPerItem);
+  if (missingCounts) {
+    // fall back to one request per vertex
+    for (Step* s : steps) {
+      auto res = fetchEdgesFromEngines(std::vector<Step*>{s});
+      _stats.incrHttpRequests(engines->size());
+      if (res.fail()) {
+        return res;
+      }
+    }
+    return TRI_ERROR_NO_ERROR;
+  }
+
+  for (size_t i = 0; i < steps.size(); ++i) {
+    std::uint64_t memoryPerItem =
+        costPerVertexOrEdgeType +
+        (connectedEdges[i].size() * (costPerVertexOrEdgeType * 2));
+    ResourceUsageScope guard(*_resourceMonitor, memoryPerItem);
 
-  auto [it, inserted] = _vertexConnectedEdges.emplace(
-      step->getVertex().getID(), std::move(connectedEdges));
-  if (inserted) {
-    guard.steal();
+    auto [it, inserted] = _vertexConnectedEdges.emplace(
+        steps[i]->getVertex().getID(), std::move(connectedEdges[i]));
+    if (inserted) {
+      guard.steal();
+    }
   }
 
   return TRI_ERROR_NO_ERROR;
@@ -463,17 +531,31 @@ auto ClusterProvider<StepImpl>::fetchVertices(
 template<class StepImpl>
 auto ClusterProvider<StepImpl>::fetchEdges(
     std::vector<Step*> const& fetchedVertices) -> Result {
+  // the edges of all vertices with the same depth are fetched with one
+  // request per engine, as the engines evaluate the edge filter conditions
+  // per depth. collect the vertices we have not fetched yet by depth, each
+  // vertex only once
+  std::map<size_t, std::vector<Step*>> stepsByDepth;
+  containers::FlatHashSet<VertexType> vertices;
   for (auto const& step : fetchedVertices) {
-    if (!_vertexConnectedEdges.contains(step->getVertex().getID())) {
-      auto res = fetchEdgesFromEngines(step);
-      _stats.incrHttpRequests(_opts.engines()->size());
-
-      if (res.fail()) {
-        THROW_ARANGO_EXCEPTION(res);
-      }
+    auto const& vertexId = step->getVertex().getID();
+    if (!_vertexConnectedEdges.contains(vertexId) &&
+        vertices.emplace(vertexId).second) {
+      stepsByDepth[step->getDepth()].emplace_back(step);
     }
     // else: We already fetched this vertex.
+  }
+
+  for (auto const& [depth, steps] : stepsByDepth) {
+    auto res = fetchEdgesFromEngines(steps);
+    _stats.incrHttpRequests(_opts.engines()->size());
+
+    if (res.fail()) {
+      THROW_ARANGO_EXCEPTION(res);
+    }
+  }
 
+  for (auto const& step : fetchedVertices) {
     // mark a looseEnd as fetched as vertex fetch + edges fetch was a success
     step->setEdgesFetched();
   }
@@ -115,8 +115,10 @@ class ClusterProvider {
   auto fetchVerticesFromEngines(std::vector<Step*> const& looseEnds,
                                 std::vector<Step*>& result) -> void;
 
-  // fetch edges and store in cache
-  auto fetchEdgesFromEngines(Step* step) -> Result;
+  // fetch edges of the steps and store in cache, with one request per
+  // engine for all steps. all steps must have the same depth and distinct
+  // vertices
+  auto fetchEdgesFromEngines(std::vector<Step*> const& steps) -> Result;
 
   void destroyEngines();
 
@@ -54,6 +54,7 @@
 #include "Basics/StringUtils.h"
 #include "Basics/VelocyPackHelper.h"
 #include "Basics/FunctionUtils.h"
+#include "Basics/NumberOfCores.h"
 #include "Basics/application-exit.h"
 #include "Cluster/ClusterFeature.h"
 #include "Cluster/ClusterInfo.h"
@@ -824,6 +825,16 @@ getAnalyzerMeta(irs::analysis::analyzer const* analyzer) noexcept {
   return {AnalyzerValueType::String, AnalyzerValueType::String, nullptr};
 }
 
+// number of analyzer instances an AnalyzerPool keeps for reuse. instances
+// released while the pool is full are destroyed, and creating them again can
+// be expensive (e.g. ICU based 'text' analyzers with stemming and stopwords).
+// indexing and queries use an analyzer concurrently from many threads, so
+// keep at least one instance per core. instances are only created on demand,
+// so pools of rarely used analyzers do not use more memory
+size_t analyzerPoolSize() {
+  return std::max(DEFAULT_POOL_SIZE, NumberOfCores::getValue());
+}
+
 }  // namespace
 
 namespace arangodb {
@@ -897,7 +908,7 @@ AnalyzerPool::Builder::ptr AnalyzerPool::Builder::make(std::string_view type,
 }
 
 AnalyzerPool::AnalyzerPool(std::string_view const& name)
-    : _cache(DEFAULT_POOL_SIZE), _name(name) {
+    : _cache(analyzerPoolSize()), _name(name) {
 #ifdef ARANGODB_ENABLE_MAINTAINER_MODE
   // validation for name - should  be only normalized or static!
   auto splitted = IResearchAnalyzerFeature::splitAnalyzerName(_name);
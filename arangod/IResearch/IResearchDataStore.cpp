@@ -58,6 +58,7 @@
 #include <store/store_utils.hpp>
 #include <utils/encryption.hpp>
 #include <utils/singleton.hpp>
+#include <algorithm>
 #include <chrono>
 #include <string>
 
@@ -407,6 +408,8 @@ struct CommitTask : Task<CommitTask> {
   size_t cleanupIntervalCount{};
   std::chrono::milliseconds commitIntervalMsec{};
   std::chrono::milliseconds consolidationIntervalMsec{};
+  // duration of the last commit
+  std::chrono::milliseconds commitDuration{};
   size_t cleanupIntervalStep{};
 };
 
@@ -417,7 +420,15 @@ void CommitTask::finalize(IResearchDataStore& link,
 
   if (code != IResearchDataStore::CommitResult::NO_CHANGES) {
     state->pendingCommits.fetch_add(1, std::memory_order_release);
-    schedule(commitIntervalMsec);
+    // the writer keeps indexing while we commit, so count the interval from
+    // the start of the last commit. otherwise a slow commit delays every
+    // following one by its duration, and search results lag behind more
+    // and more under high write load
+    auto delay = commitIntervalMsec;
+    if (code == IResearchDataStore::CommitResult::DONE) {
+      delay -= std::min(commitDuration, commitIntervalMsec);
+    }
+    schedule(delay);
 
     if (code == IResearchDataStore::CommitResult::DONE) {
       state->noopCommitCount.store(0, std::memory_order_release);
@@ -497,6 +508,7 @@ void CommitTask::operator()() {
   }
   // run commit ('_asyncSelf' locked by async task)
   auto [res, timeMs] = linkLock->commitUnsafe(false, nullptr, code);
+  commitDuration = std::chrono::milliseconds(timeMs);
 
   if (res.ok()) {
     LOG_TOPIC("7e323", TRACE, TOPIC)
@@ -604,12 +616,20 @@ void ConsolidationTask::operator()() {
   }
   constexpr size_t kMaxNoopCommits = 10;
   constexpr size_t kMaxNoopConsolidations = 10;
+  // consolidations that found nothing to merge are repeated less often,
+  // up to 8 times the interval, so that the policy is not evaluated over
+  // and over while the index is in a steady state. the interval is reset
+  // by the first consolidation that merges segments again, or by a commit
+  // with changes
+  constexpr size_t kMaxConsolidationBackoff = 3;
+  auto const noopConsolidations =
+      state->noopConsolidationCount.load(std::memory_order_acquire);
   if (state->noopCommitCount.load(std::memory_order_acquire) <
           kMaxNoopCommits &&
-      state->noopConsolidationCount.load(std::memory_order_acquire) <
-          kMaxNoopConsolidations) {
+      noopConsolidations < kMaxNoopConsolidations) {
     state->pendingConsolidations.fetch_add(1, std::memory_order_release);
-    schedule(consolidationIntervalMsec);
+    schedule(consolidationIntervalMsec *
+             (1 << std::min(noopConsolidations, kMaxConsolidationBackoff)));
   }
   TRI_IF_FAILURE("IResearchConsolidationTask::consolidateUnsafe") {
     THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
@@ -112,13 +112,18 @@ bool IndexIterator::nextImpl(LocalDocumentIdCallback const&,
 
 bool IndexIterator::nextDocumentImpl(DocumentCallback const& cb,
                                      uint64_t limit) {
-  return nextImpl(
-      [this, &cb](LocalDocumentId const& token) {
-        return _collection->getPhysical()
-            ->read(_trx, token, cb, _readOwnWrites)
-            .ok();
+  _documentIds.clear();
+  bool hasMore = nextImpl(
+      [this](LocalDocumentId const& token) {
+        _documentIds.emplace_back(token);
+        return true;
       },
       limit);
+  // errors are ignored here, as they would have been for reading the
+  // documents one by one
+  _collection->getPhysical()->readMany(_trx, _documentIds, cb,
+                                       _readOwnWrites);
+  return hasMore;
 }
 
 /// @brief default implementation for nextCovering
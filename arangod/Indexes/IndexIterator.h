@@ -54,6 +54,7 @@
 #include <cstdint>
 #include <functional>
 #include <string_view>
+#include <vector>
 #include <function2/function2.hpp>
 #include <velocypack/Slice.h>
 #include <velocypack/velocypack-common.h>
@@ -368,6 +369,10 @@ class IndexIterator {
 
  private:
   ReadOwnWrites const _readOwnWrites;
+
+  // document ids buffered by the default nextDocumentImpl, so that the
+  // documents can be read from the collection in one go
+  std::vector<LocalDocumentId> _documentIds;
 };
 
 /// @brief Special iterator if the condition cannot have any result
@@ -22,6 +22,7 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include <cmath>
+#include <optional>
 
 #include "SortedIndexAttributeMatcher.h"
 
@@ -32,6 +33,9 @@
 #include "Basics/StaticStrings.h"
 #include "Indexes/Index.h"
 #include "Indexes/SimpleAttributeEqualityMatcher.h"
+#include "StorageEngine/PhysicalCollection.h"
+#include "VocBase/CollectionStatistics.h"
+#include "VocBase/LogicalCollection.h"
 #include "VocBase/vocbase.h"
 
 using namespace arangodb;
@@ -96,6 +100,75 @@ std::tuple<size_t, size_t, double, double> analyzeConditions(
                          equalityReductionFactor, nonEqualityReductionFactor);
 }
 
+/// @brief estimated fraction of the documents satisfying the range conditions
+/// on the index attribute at the given position, using the collection's
+/// attribute statistics. only comparisons with numeric constants can be
+/// estimated this way
+std::optional<double> estimateRangeSelectivity(
+    arangodb::Index const* idx,
+    arangodb::containers::FlatHashMap<
+        size_t, std::vector<arangodb::aql::AstNode const*>> const& found,
+    size_t position, arangodb::aql::Variable const* reference) {
+  auto it = found.find(position);
+  if (it == found.end()) {
+    return std::nullopt;
+  }
+
+  auto* physical = idx->collection().getPhysical();
+  if (physical == nullptr) {
+    return std::nullopt;
+  }
+  auto statistics = physical->statistics();
+  if (statistics == nullptr) {
+    return std::nullopt;
+  }
+  auto const* attribute = statistics->get(idx->fields()[position]);
+  if (attribute == nullptr) {
+    return std::nullopt;
+  }
+
+  std::optional<double> lower;
+  std::optional<double> upper;
+  for (auto const* op : (*it).second) {
+    TRI_ASSERT(op->numMembers() == 2);
+    auto const* value = op->getMemberUnchecked(1);
+    // whether the attribute is on the right-hand side of the comparison
+    bool reversed = false;
+    if (!op->getMemberUnchecked(0)->isAttributeAccessForVariable(reference,
+                                                                 false)) {
+      value = op->getMemberUnchecked(0);
+      reversed = true;
+    }
+    if (!value->isConstant() ||
+        !(value->isIntValue() || value->isDoubleValue())) {
+      return std::nullopt;
+    }
+    double v = value->getDoubleValue();
+
+    bool isLowerBound;
+    switch (op->type) {
+      case arangodb::aql::NODE_TYPE_OPERATOR_BINARY_GT:
+      case arangodb::aql::NODE_TYPE_OPERATOR_BINARY_GE:
+        isLowerBound = !reversed;
+        break;
+      case arangodb::aql::NODE_TYPE_OPERATOR_BINARY_LT:
+      case arangodb::aql::NODE_TYPE_OPERATOR_BINARY_LE:
+        isLowerBound = reversed;
+        break;
+      default:
+        return std::nullopt;
+    }
+
+    if (isLowerBound) {
+      lower = lower.has_value() ? std::max(*lower, v) : v;
+    } else {
+      upper = upper.has_value() ? std::min(*upper, v) : v;
+    }
+  }
+
+  return attribute->rangeSelectivity(lower, upper);
+}
+
 }  // namespace
 
 bool SortedIndexAttributeMatcher::accessFitsIndex(
@@ -421,7 +494,20 @@ Index::FilterCosts SortedIndexAttributeMatcher::supportsFilterCondition(
           estimatedItems /= equalityReductionFactor;
         }
 
-        estimatedItems /= nonEqualityReductionFactor;
+        auto selectivity = ::estimateRangeSelectivity(
+            idx, found, attributesCoveredByEquality, reference);
+        if (attributesCovered > attributesCoveredByEquality &&
+            selectivity.has_value()) {
+          estimatedItems *= *selectivity;
+        } else {
+          estimatedItems /= nonEqualityReductionFactor;
+        }
+      } else if (auto selectivity =
+                     ::estimateRangeSelectivity(idx, found, 0, reference);
+                 selectivity.has_value()) {
+        // range lookup on the first index attribute. without statistics,
+        // this is not assumed to reduce the number of results at all
+        estimatedItems *= *selectivity;
       }
 
       costs.estimatedItems = static_cast<size_t>(estimatedItems);
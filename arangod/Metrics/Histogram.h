@@ -25,10 +25,24 @@
 #include "Metrics/Metric.h"
 
 #include <atomic>
+#include <cstddef>
+#include <memory>
 #include <ostream>  // TODO(MBkkt) replace to iosfwd, compile error now
 #include <vector>
 
 namespace arangodb::metrics {
+namespace detail {
+
+/// @brief returns the histogram stripe the current thread counts into.
+/// threads are assigned to the stripes round-robin
+inline std::size_t histogramStripe(std::size_t stripes) noexcept {
+  static std::atomic<std::size_t> next{0};
+  thread_local std::size_t const stripe =
+      next.fetch_add(1, std::memory_order_relaxed);
+  return stripe % stripes;
+}
+
+}  // namespace detail
 
 /**
  * @brief Histogram functionality
@@ -38,21 +52,28 @@ class Histogram : public Metric {
  public:
   using ValueType = typename Scale::Value;
 
+  /// @brief number of stripes. observations of different threads go to
+  /// different stripes, which are only summed up when the histogram is read.
+  /// this avoids that all threads contend on the same cache lines
+  static constexpr std::size_t kStripes = 8;
+
   Histogram(Scale&& scale, std::string_view name, std::string_view help,
             std::string_view labels)
       : Metric(name, help, labels),
-        _c(HistType(scale.n())),
         _scale(std::move(scale)),
         _n(_scale.n() - 1),
-        _sum(0) {}
+        _linesPerStripe((_scale.n() + kBucketsPerLine - 1) / kBucketsPerLine),
+        _buckets(std::make_unique<BucketLine[]>(kStripes * _linesPerStripe)),
+        _sums(std::make_unique<SumLine[]>(kStripes)) {}
 
   Histogram(Scale const& scale, std::string_view name, std::string_view help,
             std::string_view labels)
       : Metric(name, help, labels),
-        _c(HistType(scale.n())),
         _scale(scale),
         _n(_scale.n() - 1),
-        _sum(0) {}
+        _linesPerStripe((_scale.n() + kBucketsPerLine - 1) / kBucketsPerLine),
+        _buckets(std::make_unique<BucketLine[]>(kStripes * _linesPerStripe)),
+        _sums(std::make_unique<SumLine[]>(kStripes)) {}
 
   void track_extremes(ValueType val) noexcept {
 #ifdef ARANGODB_ENABLE_MAINTAINER_MODE
@@ -84,19 +105,23 @@ class Histogram : public Metric {
   void count(ValueType t) noexcept { count(t, 1); }
 
   void count(ValueType t, uint64_t n) noexcept {
+    std::size_t stripe = detail::histogramStripe(kStripes);
+    std::size_t i;
     if (t < _scale.delims().front()) {
-      _c[0] += n;
+      i = 0;
     } else if (t >= _scale.delims().back()) {
-      _c[_n] += n;
+      i = _n;
     } else {
-      _c[pos(t)] += n;
+      i = pos(t);
     }
+    bucket(stripe, i).fetch_add(n, std::memory_order_relaxed);
+    auto& sum = _sums[stripe].value;
     if constexpr (std::is_integral_v<ValueType>) {
-      _sum.fetch_add(static_cast<ValueType>(n) * t);
+      sum.fetch_add(static_cast<ValueType>(n) * t, std::memory_order_relaxed);
     } else {
-      ValueType tmp = _sum.load(std::memory_order_relaxed);
+      ValueType tmp = sum.load(std::memory_order_relaxed);
       do {
-      } while (!_sum.compare_exchange_weak(
+      } while (!sum.compare_exchange_weak(
           tmp, tmp + static_cast<ValueType>(n) * t, std::memory_order_relaxed,
           std::memory_order_relaxed));
     }
@@ -106,7 +131,8 @@ class Histogram : public Metric {
   ValueType low() const { return _scale.low(); }
   ValueType high() const { return _scale.high(); }
 
-  HistType::value_type& operator[](size_t n) { return _c[n]; }
+  /// @brief returns the count of bucket n, summed up over all stripes
+  uint64_t operator[](size_t n) const { return load(n); }
 
   std::vector<uint64_t> load() const {
     std::vector<uint64_t> v(size());
@@ -116,9 +142,15 @@ class Histogram : public Metric {
     return v;
   }
 
-  uint64_t load(size_t i) const { return _c.load(i); }
+  uint64_t load(size_t i) const {
+    uint64_t value = 0;
+    for (std::size_t stripe = 0; stripe < kStripes; ++stripe) {
+      value += bucket(stripe, i).load(std::memory_order_relaxed);
+    }
+    return value;
+  }
 
-  size_t size() const { return _c.size(); }
+  size_t size() const { return _n + 1; }
 
   void toPrometheus(std::string& result, std::string_view globals,
                     bool ensureWhitespace) const final {
@@ -153,7 +185,7 @@ class Histogram : public Metric {
     if (ensureWhitespace) {
       result.push_back(' ');
     }
-    result.append(std::to_string(_sum.load(std::memory_order_relaxed))) += '\n';
+    result.append(std::to_string(loadSum())) += '\n';
   }
 
   std::ostream& print(std::ostream& o) const {
@@ -165,10 +197,35 @@ class Histogram : public Metric {
   }
 
  private:
-  HistType _c;
+  static constexpr std::size_t kBucketsPerLine = 8;
+
+  struct alignas(64) BucketLine {
+    std::atomic<uint64_t> values[kBucketsPerLine] = {};
+  };
+
+  struct alignas(64) SumLine {
+    std::atomic<ValueType> value{0};
+  };
+
+  std::atomic<uint64_t>& bucket(std::size_t stripe, std::size_t i) const {
+    return _buckets[stripe * _linesPerStripe + i / kBucketsPerLine]
+        .values[i % kBucketsPerLine];
+  }
+
+  ValueType loadSum() const {
+    ValueType sum = 0;
+    for (std::size_t stripe = 0; stripe < kStripes; ++stripe) {
+      sum += _sums[stripe].value.load(std::memory_order_relaxed);
+    }
+    return sum;
+  }
+
   Scale const _scale;
   size_t const _n;
-  std::atomic<ValueType> _sum;
+  std::size_t const _linesPerStripe;
+  /// @brief kStripes stripes of _linesPerStripe cache lines with the buckets
+  std::unique_ptr<BucketLine[]> const _buckets;
+  std::unique_ptr<SumLine[]> const _sums;
 #ifdef ARANGODB_ENABLE_MAINTAINER_MODE
   std::atomic<ValueType> _lowr{std::numeric_limits<ValueType>::max()};
   std::atomic<ValueType> _highr{std::numeric_limits<ValueType>::min()};
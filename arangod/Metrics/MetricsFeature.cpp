@@ -45,6 +45,28 @@
 #include "StorageEngine/EngineSelectorFeature.h"
 
 namespace arangodb::metrics {
+namespace {
+
+/// @brief append the lines of the Prometheus output in input which belong to
+/// metrics whose names start with prefix
+void appendFiltered(std::string& result, std::string_view input,
+                    std::string_view prefix) {
+  while (!input.empty()) {
+    auto end = input.find('\n');
+    std::string_view line = input.substr(0, end);
+    input.remove_prefix(end == std::string_view::npos ? input.size()
+                                                      : end + 1);
+    std::string_view name = line;
+    if (name.starts_with("# HELP ") || name.starts_with("# TYPE ")) {
+      name.remove_prefix(7);
+    }
+    if (name.starts_with(prefix)) {
+      result.append(line) += '\n';
+    }
+  }
+}
+
+}  // namespace
 
 MetricsFeature::MetricsFeature(Server& server)
     : ArangodFeature{server, *this},
@@ -132,10 +154,16 @@ void MetricsFeature::validateOptions(std::shared_ptr<options::ProgramOptions>) {
   }
 }
 
-void MetricsFeature::toPrometheus(std::string& result, CollectMode mode) const {
+void MetricsFeature::toPrometheus(std::string& result, CollectMode mode,
+                                  std::string_view prefix) const {
   // minimize reallocs
   result.reserve(64 * 1024);
 
+  // metrics from the registry are filtered before rendering them. all other
+  // sources render several metrics at once, their output is filtered by line
+  std::string unfiltered;
+  std::string& other = prefix.empty() ? result : unfiltered;
+
   // QueryRegistryFeature
   auto& q = server().getFeature<QueryRegistryFeature>();
   q.updateMetrics();
@@ -148,6 +176,9 @@ void MetricsFeature::toPrometheus(std::string& result, CollectMode mode) const {
     for (auto const& i : _registry) {
       TRI_ASSERT(i.second);
       curr = i.second->name();
+      if (!curr.starts_with(prefix)) {
+        continue;
+      }
       if (last != curr) {
         last = curr;
         Metric::addInfo(result, curr, i.second->help(), i.second->type());
@@ -157,22 +188,26 @@ void MetricsFeature::toPrometheus(std::string& result, CollectMode mode) const {
     for (auto const& [_, batch] : _batch) {
       TRI_ASSERT(batch);
       // TODO(MBkkt) merge vector::reserve's between IBatch::toPrometheus
-      batch->toPrometheus(result, _globals, _ensureWhitespace);
+      batch->toPrometheus(other, _globals, _ensureWhitespace);
     }
   }
   auto& sf = server().getFeature<StatisticsFeature>();
   auto time = std::chrono::duration<double, std::milli>(
       std::chrono::system_clock::now().time_since_epoch());
-  sf.toPrometheus(result, time.count(), _ensureWhitespace);
+  sf.toPrometheus(other, time.count(), _ensureWhitespace);
   auto& es = server().getFeature<EngineSelectorFeature>().engine();
   if (es.typeName() == RocksDBEngine::kEngineName) {
-    es.getStatistics(result);
+    es.getStatistics(other);
   }
   auto& cm = server().getFeature<ClusterMetricsFeature>();
   if (hasGlobals && cm.isEnabled() && mode != CollectMode::Local) {
-    cm.toPrometheus(result, _globals, _ensureWhitespace);
+    cm.toPrometheus(other, _globals, _ensureWhitespace);
+  }
+  consensus::Node::toPrometheus(other);
+
+  if (!prefix.empty()) {
+    appendFiltered(result, unfiltered, prefix);
   }
-  consensus::Node::toPrometheus(result);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -64,7 +64,12 @@ class MetricsFeature final : public ArangodFeature {
   Metric* get(MetricKeyView const& key);
   bool remove(Builder const& builder);
 
-  void toPrometheus(std::string& result, CollectMode mode) const;
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief render the metrics in Prometheus format. with a non-empty prefix,
+  /// only the metrics whose names start with the prefix are rendered
+  //////////////////////////////////////////////////////////////////////////////
+  void toPrometheus(std::string& result, CollectMode mode,
+                    std::string_view prefix = {}) const;
 
   //////////////////////////////////////////////////////////////////////////////
   /// @brief That used for collect some metrics
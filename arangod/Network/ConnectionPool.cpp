@@ -40,6 +40,7 @@
 #include "Metrics/MetricsFeature.h"
 
 #include <fuerte/connection.h>
+#include <algorithm>
 #include <memory>
 
 DECLARE_GAUGE(arangodb_connection_pool_connections_current, uint64_t,
@@ -77,6 +78,10 @@ struct ConnectionPool::Context {
 struct ConnectionPool::Bucket {
   mutable std::mutex mutex;
   containers::SmallVector<std::shared_ptr<Context>, 4> list;
+  /// most connections needed at once since the last pruning run
+  size_t peakConnections = 0;
+  /// number of idle connections to keep beyond their lifetime
+  size_t targetConnections = 0;
 };
 
 struct ConnectionPool::Impl {
@@ -160,6 +165,17 @@ struct ConnectionPool::Impl {
       // get under lock
       auto now = std::chrono::steady_clock::now();
 
+      // adapt the number of connections to keep to the recent demand
+      size_t keep = 0;
+      if (_config.adaptiveIdleConnections) {
+        buck.targetConnections =
+            std::min<size_t>(std::max(buck.peakConnections,
+                                      buck.targetConnections / 2),
+                             _config.maxOpenConnections);
+        buck.peakConnections = 0;
+        keep = buck.targetConnections;
+      }
+
       // this loop removes broken connections, and closes the ones we don't
       // need anymore
       size_t aliveCount = 0;
@@ -174,7 +190,7 @@ struct ConnectionPool::Impl {
           remove = true;
         } else if ((*it)->leases.load() == 0 &&
                    (*it)->fuerte->requestsLeft() == 0) {
-          if ((now - (*it)->lastLeased) > ttl ||
+          if (((now - (*it)->lastLeased) > ttl && aliveCount >= keep) ||
               aliveCount >= _config.maxOpenConnections) {
             // connection hasn't been used for a while, or there are too many
             // connections
@@ -249,9 +265,14 @@ struct ConnectionPool::Impl {
     // exclusively lock the bucket
     std::unique_lock<std::mutex> guard(bucket.mutex);
 
+    // connections kept beyond their lifetime by the adaptive sizing are
+    // still good to use, pruning removes all others
+    bool const checkTtl = !_config.adaptiveIdleConnections;
+    size_t position = 0;
     for (std::shared_ptr<Context>& c : bucket.list) {
+      ++position;
       if (c->fuerte->state() == fuerte::Connection::State::Closed ||
-          (start - c->lastLeased) > ttl) {
+          (checkTtl && (start - c->lastLeased) > ttl)) {
         continue;
       }
 
@@ -277,6 +298,9 @@ struct ConnectionPool::Impl {
           if (c->fuerte->requestsLeft() <= limit &&
               c->fuerte->state() != fuerte::Connection::State::Closed) {
             c->lastLeased = std::chrono::steady_clock::now();
+            // all connections before this one were busy
+            bucket.peakConnections =
+                std::max(bucket.peakConnections, position);
             ++_successSelect;
             _leaseHistMSec.count(
                 duration<float, std::micro>(c->lastLeased - start).count());
@@ -303,6 +327,8 @@ struct ConnectionPool::Impl {
     auto c = std::make_shared<Context>(_pool.createConnection(builder), now,
                                        1 /* leases*/);
     bucket.list.push_back(c);
+    bucket.peakConnections =
+        std::max(bucket.peakConnections, bucket.list.size());
 
     guard.unlock();
     // continue without the bucket lock
@@ -60,6 +60,10 @@ class ConnectionPool final {
     uint64_t idleConnectionMilli = 120000;  /// unused connection lifetime
     unsigned int numIOThreads = 1;          /// number of IO threads
     bool verifyHosts = false;
+    /// keep idle connections to an endpoint beyond their lifetime, as long
+    /// as recent bursts needed that many connections at once. the number of
+    /// kept connections halves with each pruning run without such a burst
+    bool adaptiveIdleConnections = false;
     fuerte::ProtocolType protocol = fuerte::ProtocolType::Http;
     // name must remain valid for the lifetime of the Config object.
     char const* name = "";
@@ -0,0 +1,257 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "DocumentReadCoalescer.h"
+
+#include "Basics/StaticStrings.h"
+#include "Basics/StringUtils.h"
+#include "Basics/debugging.h"
+#include "Network/ClusterUtils.h"
+#include "Network/Methods.h"
+#include "Network/NetworkFeature.h"
+#include "Network/Utils.h"
+#include "Scheduler/Scheduler.h"
+#include "Scheduler/SchedulerFeature.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Iterator.h>
+#include <velocypack/Slice.h>
+
+#include <atomic>
+#include <utility>
+#include <vector>
+
+using namespace arangodb;
+using namespace arangodb::network;
+
+struct DocumentReadCoalescer::Batch {
+  std::string key;
+  std::string database;
+  std::string shard;
+  /// @brief whether the batch has been sent or failed. only changed under
+  /// the mutex. the scheduled flush checks it without the mutex first, so
+  /// that it does not touch the coalescer after shutdown()
+  std::atomic<bool> sent = false;
+
+  /// @brief the keys of all documents to read, an open array
+  velocypack::Builder documentKeys;
+  std::vector<std::pair<OperationOptions, futures::Promise<OperationResult>>>
+      reads;
+
+  Scheduler::WorkHandle workItem;
+};
+
+DocumentReadCoalescer::DocumentReadCoalescer(NetworkFeature& feature,
+                                             std::chrono::microseconds window)
+    : _feature(feature), _window(window) {}
+
+DocumentReadCoalescer::~DocumentReadCoalescer() { shutdown(); }
+
+futures::Future<OperationResult> DocumentReadCoalescer::read(
+    std::string const& database, std::string const& shard,
+    std::string_view key, OperationOptions const& options) {
+  std::string batchKey;
+  batchKey.append(database).push_back('/');
+  batchKey.append(shard);
+
+  futures::Promise<OperationResult> promise;
+  auto future = promise.getFuture();
+
+  std::shared_ptr<Batch> full;
+  {
+    std::lock_guard guard(_mutex);
+
+    if (_stopping) {
+      return futures::makeFuture(
+          OperationResult(Result(TRI_ERROR_SHUTTING_DOWN), options));
+    }
+
+    auto& batch = _batches[batchKey];
+    if (batch == nullptr) {
+      batch = std::make_shared<Batch>();
+      batch->key = batchKey;
+      batch->database = database;
+      batch->shard = shard;
+      batch->documentKeys.openArray(/*unindexed*/ true);
+
+      Scheduler* scheduler = SchedulerFeature::SCHEDULER;
+      if (scheduler != nullptr) {
+        batch->workItem = scheduler->queueDelayed(
+            "coalesce-document-reads", RequestLane::CLUSTER_INTERNAL, _window,
+            [this, batch](bool canceled) {
+              if (!batch->sent.load()) {
+                flush(batch, canceled);
+              }
+            });
+      }
+    }
+
+    batch->documentKeys.add(velocypack::Value(key));
+    batch->reads.emplace_back(options, std::move(promise));
+
+    if (batch->reads.size() >= maxBatchSize || batch->workItem == nullptr) {
+      // batch is full, or we could not schedule sending it later
+      batch->sent = true;
+      full = std::move(batch);
+      _batches.erase(batchKey);
+    }
+  }
+
+  if (full != nullptr) {
+    // drops the scheduled flush. it would not do anything anymore
+    full->workItem.reset();
+    send(std::move(full));
+  }
+  return future;
+}
+
+void DocumentReadCoalescer::shutdown() {
+  std::unordered_map<std::string, std::shared_ptr<Batch>> batches;
+  {
+    std::lock_guard guard(_mutex);
+    _stopping = true;
+    batches.swap(_batches);
+    for (auto& [key, batch] : batches) {
+      batch->sent = true;
+    }
+  }
+
+  for (auto& [key, batch] : batches) {
+    // the canceled flush will find the batch sent and do nothing
+    batch->workItem.reset();
+    for (auto& [options, promise] : batch->reads) {
+      promise.setValue(
+          OperationResult(Result(TRI_ERROR_SHUTTING_DOWN), options));
+    }
+  }
+}
+
+void DocumentReadCoalescer::flush(std::shared_ptr<Batch> const& batch,
+                                  bool canceled) {
+  {
+    std::lock_guard guard(_mutex);
+    if (batch->sent) {
+      return;
+    }
+    batch->sent = true;
+    auto it = _batches.find(batch->key);
+    if (it != _batches.end() && it->second == batch) {
+      _batches.erase(it);
+    }
+  }
+  if (canceled) {
+    // the scheduler is shutting down
+    for (auto& [options, promise] : batch->reads) {
+      promise.setValue(
+          OperationResult(Result(TRI_ERROR_SHUTTING_DOWN), options));
+    }
+    return;
+  }
+  send(batch);
+}
+
+futures::Future<network::Response> DocumentReadCoalescer::sendRequest(
+    std::string const& database, std::string const& shard,
+    velocypack::Buffer<uint8_t> keys) {
+  RequestOptions reqOpts;
+  reqOpts.database = database;
+  reqOpts.retryNotFound = true;
+  reqOpts.param(StaticStrings::IgnoreRevsString, "true");
+  reqOpts.param(StaticStrings::SilentString, "false");
+  reqOpts.param("onlyget", "true");
+
+  std::string url = "/_api/document/";
+  url.append(basics::StringUtils::urlEncode(shard));
+
+  return sendRequestRetry(_feature.pool(), "shard:" + shard,
+                          fuerte::RestVerb::Put, std::move(url),
+                          std::move(keys), reqOpts);
+}
+
+void DocumentReadCoalescer::send(std::shared_ptr<Batch> batch) {
+  TRI_ASSERT(batch->sent);
+  TRI_ASSERT(!batch->reads.empty());
+  batch->documentKeys.close();
+
+  sendRequest(batch->database, batch->shard,
+              std::move(*batch->documentKeys.steal()))
+      .thenFinal([batch](futures::Try<Response>&& tryResponse) {
+        auto& reads = batch->reads;
+
+        if (tryResponse.hasException()) {
+          for (auto& [options, promise] : reads) {
+            promise.setException(tryResponse.exception());
+          }
+          return;
+        }
+
+        Response& res = tryResponse.get();
+        if (res.error != fuerte::Error::NoError) {
+          for (auto& [options, promise] : reads) {
+            promise.setValue(
+                OperationResult(fuerteToArangoErrorCode(res), options));
+          }
+          return;
+        }
+
+        if (res.statusCode() != fuerte::StatusOK) {
+          // the whole request failed, so all reads fail the same way
+          auto body = res.response().stealPayload();
+          for (auto& [options, promise] : reads) {
+            promise.setValue(clusterResultDocument(
+                res.statusCode(),
+                std::make_shared<velocypack::Buffer<uint8_t>>(*body), options,
+                {}));
+          }
+          return;
+        }
+
+        velocypack::Slice documents = res.slice();
+        if (!documents.isArray() || documents.length() != reads.size()) {
+          for (auto& [options, promise] : reads) {
+            promise.setValue(OperationResult(
+                Result(TRI_ERROR_INTERNAL,
+                       "unexpected response for coalesced document reads"),
+                options));
+          }
+          return;
+        }
+
+        size_t i = 0;
+        for (velocypack::Slice document :
+             velocypack::ArrayIterator(documents)) {
+          auto body = std::make_shared<velocypack::Buffer<uint8_t>>();
+          body->append(document.start(), document.byteSize());
+          auto& [options, promise] = reads[i++];
+          if (document.isObject() &&
+              document.get(StaticStrings::Error).isTrue()) {
+            // an error for this document only, e.g. "document not found".
+            // the error object contains the error number
+            promise.setValue(opResultFromBody(std::move(body),
+                                              TRI_ERROR_INTERNAL,
+                                              OperationOptions(options)));
+          } else {
+            promise.setValue(
+                OperationResult(Result(), std::move(body), options));
+          }
+        }
+      });
+}
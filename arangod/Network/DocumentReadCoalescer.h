@@ -0,0 +1,106 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Basics/Common.h"
+#include "Futures/Future.h"
+#include "Network/Methods.h"
+#include "Utils/OperationOptions.h"
+#include "Utils/OperationResult.h"
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace arangodb {
+class NetworkFeature;
+
+namespace network {
+
+/// @brief combines concurrent single-document reads from the same shard into
+/// one multi-document read. the first read for a shard opens a batch, which
+/// is sent after a short window. all reads for the shard that arrive in the
+/// meantime are added to the batch, and get their individual results from
+/// the batch's response.
+/// only reads that are not part of a larger transaction, that do not check
+/// the document revision and that read from the leader may be coalesced, as
+/// only for these reads the results do not depend on being executed on
+/// their own. synchronous reads must not be coalesced either: they block a
+/// scheduler thread, and the batch is sent from another scheduler thread.
+#ifdef ARANGODB_USE_GOOGLE_TESTS
+class DocumentReadCoalescer {
+#else
+class DocumentReadCoalescer final {
+#endif
+ public:
+  /// @brief batches are sent right away once they contain this many reads
+  static constexpr std::size_t maxBatchSize = 1000;
+
+  DocumentReadCoalescer(NetworkFeature& feature,
+                        std::chrono::microseconds window);
+  TEST_VIRTUAL ~DocumentReadCoalescer();
+
+  DocumentReadCoalescer(DocumentReadCoalescer const&) = delete;
+  DocumentReadCoalescer& operator=(DocumentReadCoalescer const&) = delete;
+
+  /// @brief read the document with the key from the shard's leader. the
+  /// result is the same as for a single-document read of the document
+  futures::Future<OperationResult> read(std::string const& database,
+                                        std::string const& shard,
+                                        std::string_view key,
+                                        OperationOptions const& options);
+
+  /// @brief fail all reads that have not been sent yet, and all future
+  /// reads, with TRI_ERROR_SHUTTING_DOWN
+  void shutdown();
+
+ protected:
+  /// @brief send the multi-document read with the keys to the shard
+  TEST_VIRTUAL futures::Future<network::Response> sendRequest(
+      std::string const& database, std::string const& shard,
+      velocypack::Buffer<uint8_t> keys);
+
+ private:
+  struct Batch;
+
+  /// @brief send the batch, unless it has been sent already. fails the reads
+  /// of the batch instead if the scheduled flush was canceled
+  void flush(std::shared_ptr<Batch> const& batch, bool canceled);
+
+  void send(std::shared_ptr<Batch> batch);
+
+  NetworkFeature& _feature;
+  std::chrono::microseconds const _window;
+
+  std::mutex _mutex;
+  /// @brief batches that are still open for more reads
+  std::unordered_map<std::string, std::shared_ptr<Batch>> _batches;
+  /// @brief set by shutdown(), protected by the mutex
+  bool _stopping = false;
+};
+
+}  // namespace network
+}  // namespace arangodb
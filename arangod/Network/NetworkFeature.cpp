@@ -34,6 +34,7 @@
 #include "Cluster/ClusterInfo.h"
 #include "GeneralServer/GeneralServerFeature.h"
 #include "Network/ConnectionPool.h"
+#include "Network/DocumentReadCoalescer.h"
 #include "Network/Methods.h"
 #include "ProgramOptions/ProgramOptions.h"
 #include "ProgramOptions/Section.h"
@@ -120,6 +121,7 @@ NetworkFeature::NetworkFeature(Server& server,
       _idleTtlMilli(config.idleConnectionMilli),
       _numIOThreads(config.numIOThreads),
       _verifyHosts(config.verifyHosts),
+      _documentReadCoalescingWindow(0),
       _prepared(false),
       _forwardedRequests(server.getFeature<metrics::MetricsFeature>().add(
           arangodb_network_forwarded_requests_total{})),
@@ -145,6 +147,8 @@ NetworkFeature::NetworkFeature(Server& server,
   startsAfter<EngineSelectorFeature>();
 }
 
+NetworkFeature::~NetworkFeature() = default;
+
 void NetworkFeature::collectOptions(
     std::shared_ptr<options::ProgramOptions> options) {
   options->addSection("network", "cluster-internal networking");
@@ -194,6 +198,29 @@ void NetworkFeature::collectOptions(
                   new options::UInt64Parameter(&_maxInFlight),
                   options::makeDefaultFlags(options::Flags::Uncommon))
       .setIntroducedIn(30800);
+
+  options
+      ->addOption("--network.document-read-coalescing-window",
+                  "The time window (in microseconds) in which concurrent "
+                  "single-document reads from the same shard are combined "
+                  "into a single cluster-internal request (0 = off).",
+                  new options::UInt64Parameter(&_documentReadCoalescingWindow),
+                  options::makeFlags(options::Flags::DefaultNoComponents,
+                                     options::Flags::OnCoordinator,
+                                     options::Flags::Uncommon))
+      .setIntroducedIn(31200)
+      .setLongDescription(R"(Reads of single documents by key from
+different requests are normally sent as separate requests to the DB-Servers.
+If you set this option to a value greater than 0, a Coordinator collects the
+reads from the same shard for up to the given time and sends them as one
+request. This reduces the number of cluster-internal requests for workloads
+with many concurrent key lookups, at the expense of adding up to the window
+to the latency of each read.
+
+Only reads outside of Stream Transactions and JavaScript Transactions that
+do not check the document revision and do not read from followers are
+combined. Reads that block their thread until the result arrives, e.g. reads
+from JavaScript code, are never combined.)");
 }
 
 void NetworkFeature::validateOptions(
@@ -235,6 +262,9 @@ void NetworkFeature::prepare() {
   config.maxOpenConnections = _maxOpenConnections;
   config.idleConnectionMilli = _idleTtlMilli;
   config.verifyHosts = _verifyHosts;
+  // keep enough connections around for recurring bursts, so that these do
+  // not have to open (and TLS handshake) lots of new connections each time
+  config.adaptiveIdleConnections = true;
   config.clusterInfo = ci;
   config.name = "ClusterComm";
 
@@ -263,6 +293,11 @@ void NetworkFeature::prepare() {
   _pool = std::make_unique<network::ConnectionPool>(config);
   _poolPtr.store(_pool.get(), std::memory_order_relaxed);
 
+  if (_documentReadCoalescingWindow > 0) {
+    _documentReadCoalescer = std::make_unique<network::DocumentReadCoalescer>(
+        *this, std::chrono::microseconds(_documentReadCoalescingWindow));
+  }
+
   _gcfunc = [this, ci](bool canceled) {
     if (canceled) {
       return;
@@ -308,6 +343,10 @@ void NetworkFeature::beginShutdown() {
     }
     _retryRequests.clear();
   }
+  if (_documentReadCoalescer) {
+    // fail the reads which are waiting for their batch to be sent
+    _documentReadCoalescer->shutdown();
+  }
   _poolPtr.store(nullptr, std::memory_order_relaxed);
   if (_pool) {  // first cancel all connections
     _pool->shutdownConnections();
@@ -340,6 +379,11 @@ network::ConnectionPool* NetworkFeature::pool() const noexcept {
   return _poolPtr.load(std::memory_order_relaxed);
 }
 
+network::DocumentReadCoalescer* NetworkFeature::documentReadCoalescer()
+    const noexcept {
+  return _documentReadCoalescer.get();
+}
+
 #ifdef ARANGODB_USE_GOOGLE_TESTS
 void NetworkFeature::setPoolTesting(network::ConnectionPool* pool) {
   _poolPtr.store(pool, std::memory_order_release);
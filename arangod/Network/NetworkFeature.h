@@ -35,6 +35,7 @@
 
 namespace arangodb {
 namespace network {
+class DocumentReadCoalescer;
 struct RequestOptions;
 
 struct RetryableRequest {
@@ -54,6 +55,7 @@ class NetworkFeature final : public ArangodFeature {
 
   explicit NetworkFeature(Server& server);
   NetworkFeature(Server& server, network::ConnectionPool::Config);
+  ~NetworkFeature();
 
   void collectOptions(std::shared_ptr<options::ProgramOptions>) override;
   void validateOptions(std::shared_ptr<options::ProgramOptions>) override;
@@ -68,6 +70,10 @@ class NetworkFeature final : public ArangodFeature {
   /// @brief global connection pool
   network::ConnectionPool* pool() const noexcept;
 
+  /// @brief coalescer for single-document reads. returns a nullptr if
+  /// reads are not coalesced
+  network::DocumentReadCoalescer* documentReadCoalescer() const noexcept;
+
 #ifdef ARANGODB_USE_GOOGLE_TESTS
   void setPoolTesting(network::ConnectionPool* pool);
 #endif
@@ -101,6 +107,9 @@ class NetworkFeature final : public ArangodFeature {
   uint64_t _idleTtlMilli;
   uint32_t _numIOThreads;
   bool _verifyHosts;
+  /// @brief window for coalescing single-document reads (in microseconds),
+  /// 0 turns coalescing off
+  uint64_t _documentReadCoalescingWindow;
   std::atomic<bool> _prepared;
 
   std::mutex _workItemMutex;
@@ -111,6 +120,8 @@ class NetworkFeature final : public ArangodFeature {
   std::unique_ptr<network::ConnectionPool> _pool;
   std::atomic<network::ConnectionPool*> _poolPtr;
 
+  std::unique_ptr<network::DocumentReadCoalescer> _documentReadCoalescer;
+
   std::unordered_map<std::shared_ptr<network::RetryableRequest>,
                      Scheduler::WorkHandle>
       _retryRequests;
@@ -24,6 +24,7 @@
 #include "Pregel/Conductor/Messages.h"
 #include "VocBase/vocbase.h"
 #include "Pregel/AlgoRegistry.h"
+#include "Pregel/Algos/BalancedPartitioning/BalancedPartitioning.h"
 #include "Pregel/Algos/ColorPropagation/ColorPropagation.h"
 #include "Pregel/Algos/ConnectedComponents/ConnectedComponents.h"
 #include "Pregel/Algos/DMID/DMID.h"
@@ -79,6 +80,8 @@ IAlgorithm* AlgoRegistry::createAlgorithm(std::string const& algorithm,
     return new algos::WCC(userParams);
   } else if (algorithm == "colorpropagation") {
     return new algos::ColorPropagation(userParams);
+  } else if (algorithm == "balancedpartitioning") {
+    return new algos::BalancedPartitioning(userParams);
   }
 #if defined(ARANGODB_ENABLE_MAINTAINER_MODE)
   else if (algorithm == "readwrite") {
@@ -123,6 +126,8 @@ auto AlgoRegistry::createAlgorithmNew(std::string const& algorithm,
     return std::make_unique<algos::WCC>(userParams);
   } else if (algorithm == "colorpropagation") {
     return std::make_unique<algos::ColorPropagation>(userParams);
+  } else if (algorithm == "balancedpartitioning") {
+    return std::make_unique<algos::BalancedPartitioning>(userParams);
   }
 #if defined(ARANGODB_ENABLE_MAINTAINER_MODE)
   else if (algorithm == "readwrite") {
@@ -192,6 +197,9 @@ std::shared_ptr<IWorker> AlgoRegistry::createWorker(
   } else if (algorithm == "colorpropagation") {
     return createWorker(vocbase, new algos::ColorPropagation(userParams),
                         parameters, feature);
+  } else if (algorithm == "balancedpartitioning") {
+    return createWorker(vocbase, new algos::BalancedPartitioning(userParams),
+                        parameters, feature);
   }
 #if defined(ARANGODB_ENABLE_MAINTAINER_MODE)
   else if (algorithm == "readwrite") {
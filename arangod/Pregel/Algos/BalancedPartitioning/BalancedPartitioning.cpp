@@ -0,0 +1,265 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include "BalancedPartitioning.h"
+
+#include "Basics/Exceptions.h"
+#include "Logger/LogMacros.h"
+#include "Pregel/Aggregator.h"
+#include "Pregel/GraphFormat.h"
+#include "Pregel/Iterators.h"
+#include "Pregel/MasterContext.h"
+#include "Pregel/VertexComputation.h"
+#include "Pregel/WorkerContext.h"
+#include "Random/RandomGenerator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using namespace arangodb;
+using namespace arangodb::pregel;
+using namespace arangodb::pregel::algos;
+
+namespace {
+// number of vertices that moved in the superstep
+std::string const kMoves = "moves";
+// number of edges between different partitions
+std::string const kCut = "cut";
+// prefix for the number of vertices in a partition
+std::string const kSizePrefix = "size-";
+// prefix for the number of vertices that want to move into a partition
+std::string const kDemandPrefix = "demand-";
+
+std::vector<std::string> aggregatorNames(std::string const& prefix,
+                                         uint64_t numPartitions) {
+  std::vector<std::string> names;
+  names.reserve(numPartitions);
+  for (uint64_t p = 0; p < numPartitions; ++p) {
+    names.emplace_back(prefix + std::to_string(p));
+  }
+  return names;
+}
+}  // namespace
+
+BalancedPartitioning::BalancedPartitioning(VPackSlice userParams)
+    : SimpleAlgorithm<LPValue, int8_t, uint64_t>(userParams),
+      _numPartitions(0),
+      _maxImbalance(0.05) {
+  VPackSlice val = userParams.get("numberOfPartitions");
+  if (!val.isInteger() || val.getInt() < 1 ||
+      val.getUInt() > maxPartitions) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(
+        TRI_ERROR_BAD_PARAMETER,
+        "numberOfPartitions must be an integer between 1 and " +
+            std::to_string(maxPartitions));
+  }
+  _numPartitions = val.getUInt();
+
+  val = userParams.get("maxImbalance");
+  if (val.isNumber()) {
+    _maxImbalance = std::clamp(val.getNumber<double>(), 0.0, 1.0);
+  }
+}
+
+struct BalancedPartitioningComputation
+    : public VertexComputation<LPValue, int8_t, uint64_t> {
+  BalancedPartitioningComputation(uint64_t numPartitions, double maxImbalance)
+      : _numPartitions(numPartitions),
+        _maxImbalance(maxImbalance),
+        _sizeNames(aggregatorNames(kSizePrefix, numPartitions)),
+        _demandNames(aggregatorNames(kDemandPrefix, numPartitions)),
+        _counts(numPartitions, 0) {}
+
+  void compute(MessageIterator<uint64_t> const& messages) override {
+    LPValue* value = mutableVertexData();
+
+    if (globalSuperstep() == 0) {
+      value->currentCommunity = RandomGenerator::interval(_numPartitions - 1);
+    } else {
+      uint64_t const current = value->currentCommunity;
+      std::fill(_counts.begin(), _counts.end(), 0);
+      for (uint64_t const* msg : messages) {
+        if (*msg < _numPartitions) {
+          ++_counts[*msg];
+        }
+      }
+      aggregate<uint64_t>(kCut, messages.size() - _counts[current]);
+
+      // the partition most neighbors are in. stay if it is a tie
+      uint64_t best = current;
+      for (uint64_t p = 0; p < _numPartitions; ++p) {
+        if (_counts[p] > _counts[best]) {
+          best = p;
+        }
+      }
+
+      if (best != current) {
+        aggregate<uint64_t>(_demandNames[best], 1);
+        if (tryMove(best)) {
+          value->lastCommunity = current;
+          value->currentCommunity = best;
+          value->stabilizationRounds = 0;
+          aggregate<uint64_t>(kMoves, 1);
+        }
+      } else {
+        ++value->stabilizationRounds;
+      }
+    }
+
+    aggregate<uint64_t>(_sizeNames[value->currentCommunity], 1);
+    sendMessageToAllNeighbours(value->currentCommunity);
+    // stay active, so that all vertices keep sending their partition. the
+    // master stops the computation
+  }
+
+ private:
+  /// @brief whether the vertex may move into the partition, based on the
+  /// partition sizes and the demand of the previous superstep
+  bool tryMove(uint64_t partition) {
+    uint64_t const capacity = static_cast<uint64_t>(
+        std::ceil((1.0 + _maxImbalance) *
+                  static_cast<double>(context()->vertexCount()) /
+                  static_cast<double>(_numPartitions)));
+    uint64_t const size =
+        getAggregatedValueRef<uint64_t>(_sizeNames[partition]);
+    if (size >= capacity) {
+      return false;
+    }
+    uint64_t const demand =
+        getAggregatedValueRef<uint64_t>(_demandNames[partition]);
+    if (demand == 0) {
+      // no one wanted to move here before. only register the demand, so
+      // that the moves in the next superstep can be spread evenly
+      return false;
+    }
+    uint64_t const free = capacity - size;
+    return free >= demand || RandomGenerator::interval(demand - 1) < free;
+  }
+
+  uint64_t const _numPartitions;
+  double const _maxImbalance;
+  std::vector<std::string> const _sizeNames;
+  std::vector<std::string> const _demandNames;
+  // number of messages received per partition
+  std::vector<uint64_t> _counts;
+};
+
+VertexComputation<LPValue, int8_t, uint64_t>*
+BalancedPartitioning::createComputation(
+    std::shared_ptr<WorkerConfig const> config) const {
+  return new BalancedPartitioningComputation(_numPartitions, _maxImbalance);
+}
+
+struct BalancedPartitioningGraphFormat : public GraphFormat<LPValue, int8_t> {
+  std::string _resultField;
+
+  explicit BalancedPartitioningGraphFormat(std::string const& result)
+      : GraphFormat<LPValue, int8_t>(), _resultField(result) {}
+
+  size_t estimatedVertexSize() const override { return sizeof(LPValue); }
+  size_t estimatedEdgeSize() const override { return 0; }
+
+  void copyVertexData(arangodb::velocypack::Options const&,
+                      std::string const& /*documentId*/,
+                      arangodb::velocypack::Slice /*document*/, LPValue& value,
+                      uint64_t /*vertexId*/) const override {
+    // the partition is chosen randomly in the first superstep
+    value.currentCommunity = 0;
+  }
+
+  bool buildVertexDocument(arangodb::velocypack::Builder& b,
+                           LPValue const* ptr) const override {
+    b.add(_resultField, VPackValue(ptr->currentCommunity));
+    return true;
+  }
+};
+
+std::shared_ptr<GraphFormat<LPValue, int8_t> const>
+BalancedPartitioning::inputFormat() const {
+  return std::make_shared<BalancedPartitioningGraphFormat>(_resultField);
+}
+
+struct BalancedPartitioningWorkerContext : public WorkerContext {
+  BalancedPartitioningWorkerContext(
+      std::unique_ptr<AggregatorHandler> readAggregators,
+      std::unique_ptr<AggregatorHandler> writeAggregators)
+      : WorkerContext(std::move(readAggregators),
+                      std::move(writeAggregators)){};
+};
+[[nodiscard]] auto BalancedPartitioning::workerContext(
+    std::unique_ptr<AggregatorHandler> readAggregators,
+    std::unique_ptr<AggregatorHandler> writeAggregators,
+    velocypack::Slice userParams) const -> WorkerContext* {
+  return new BalancedPartitioningWorkerContext(std::move(readAggregators),
+                                               std::move(writeAggregators));
+}
+[[nodiscard]] auto BalancedPartitioning::workerContextUnique(
+    std::unique_ptr<AggregatorHandler> readAggregators,
+    std::unique_ptr<AggregatorHandler> writeAggregators,
+    velocypack::Slice userParams) const -> std::unique_ptr<WorkerContext> {
+  return std::make_unique<BalancedPartitioningWorkerContext>(
+      std::move(readAggregators), std::move(writeAggregators));
+}
+
+struct BalancedPartitioningMasterContext : public MasterContext {
+  BalancedPartitioningMasterContext(
+      uint64_t vertexCount, uint64_t edgeCount,
+      std::unique_ptr<AggregatorHandler> aggregators)
+      : MasterContext(vertexCount, edgeCount, std::move(aggregators)){};
+
+  bool postGlobalSuperstep() override {
+    if (globalSuperstep() < 2) {
+      // the first supersteps only choose the initial partitions and collect
+      // the demand
+      return true;
+    }
+    uint64_t const moves = *getAggregatedValue<uint64_t>(kMoves);
+    LOG_TOPIC("4e2b7", DEBUG, Logger::PREGEL)
+        << "balanced partitioning superstep " << globalSuperstep()
+        << ": moved vertices: " << moves
+        << ", cut edges: " << *getAggregatedValue<uint64_t>(kCut);
+    return moves > 0;
+  }
+};
+
+[[nodiscard]] auto BalancedPartitioning::masterContext(
+    std::unique_ptr<AggregatorHandler> aggregators,
+    arangodb::velocypack::Slice userParams) const -> MasterContext* {
+  return new BalancedPartitioningMasterContext(0, 0, std::move(aggregators));
+}
+[[nodiscard]] auto BalancedPartitioning::masterContextUnique(
+    uint64_t vertexCount, uint64_t edgeCount,
+    std::unique_ptr<AggregatorHandler> aggregators,
+    arangodb::velocypack::Slice userParams) const
+    -> std::unique_ptr<MasterContext> {
+  return std::make_unique<BalancedPartitioningMasterContext>(
+      vertexCount, edgeCount, std::move(aggregators));
+}
+
+IAggregator* BalancedPartitioning::aggregator(std::string const& name) const {
+  if (name == kMoves || name == kCut || name.starts_with(kSizePrefix) ||
+      name.starts_with(kDemandPrefix)) {
+    return new SumAggregator<uint64_t>(0, false);
+  }
+  return nullptr;
+}
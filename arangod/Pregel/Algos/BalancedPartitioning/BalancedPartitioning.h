@@ -0,0 +1,104 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+#include <velocypack/Slice.h>
+#include "Pregel/Algorithm.h"
+#include "Pregel/Algos/LabelPropagation/LPValue.h"
+
+namespace arangodb::pregel::algos {
+
+/// Assigns every vertex to one of a fixed number of partitions, so that the
+/// partitions have about the same size and as few edges as possible connect
+/// vertices of different partitions. The partition number is stored in the
+/// result field, and can be used as shard key for collections with as many
+/// shards as there are partitions, so that traversals cross fewer shards.
+///
+/// This is label propagation with a size constraint: vertices start in a
+/// random partition, and in each superstep move to the partition most of the
+/// vertices with edges pointing to them are in. A move is only made if the
+/// target partition is below its capacity, which is
+/// (1 + maxImbalance) * number of vertices / numberOfPartitions. Since all
+/// vertices decide at the same time, a vertex that wants to move into a
+/// partition does so with the probability (remaining capacity) / (number of
+/// vertices that wanted to move into the partition in the previous
+/// superstep). The computation stops when no vertex moves anymore, or after
+/// maxGSS supersteps.
+///
+/// Like LabelPropagation, only incoming edges are taken into account, and
+/// the partition of a vertex is stored in LPValue::currentCommunity.
+struct BalancedPartitioningType {
+  using Vertex = LPValue;
+  using Edge = int8_t;
+  using Message = uint64_t;
+};
+
+struct BalancedPartitioning
+    : public SimpleAlgorithm<LPValue, int8_t, uint64_t> {
+  static constexpr uint64_t maxPartitions = 1024;
+
+  explicit BalancedPartitioning(VPackSlice userParams);
+
+  [[nodiscard]] auto name() const -> std::string_view override {
+    return "balancedpartitioning";
+  };
+
+  std::shared_ptr<GraphFormat<LPValue, int8_t> const> inputFormat()
+      const override;
+  MessageFormat<uint64_t>* messageFormat() const override {
+    return new NumberMessageFormat<uint64_t>();
+  }
+  [[nodiscard]] auto messageFormatUnique() const
+      -> std::unique_ptr<message_format> override {
+    return std::make_unique<NumberMessageFormat<uint64_t>>();
+  }
+
+  VertexComputation<LPValue, int8_t, uint64_t>* createComputation(
+      std::shared_ptr<WorkerConfig const>) const override;
+
+  [[nodiscard]] auto workerContext(
+      std::unique_ptr<AggregatorHandler> readAggregators,
+      std::unique_ptr<AggregatorHandler> writeAggregators,
+      velocypack::Slice userParams) const -> WorkerContext* override;
+  [[nodiscard]] auto workerContextUnique(
+      std::unique_ptr<AggregatorHandler> readAggregators,
+      std::unique_ptr<AggregatorHandler> writeAggregators,
+      velocypack::Slice userParams) const
+      -> std::unique_ptr<WorkerContext> override;
+
+  [[nodiscard]] auto masterContext(
+      std::unique_ptr<AggregatorHandler> aggregators,
+      arangodb::velocypack::Slice userParams) const -> MasterContext* override;
+  [[nodiscard]] auto masterContextUnique(
+      uint64_t vertexCount, uint64_t edgeCount,
+      std::unique_ptr<AggregatorHandler> aggregators,
+      arangodb::velocypack::Slice userParams) const
+      -> std::unique_ptr<MasterContext> override;
+
+  IAggregator* aggregator(std::string const& name) const override;
+
+ private:
+  uint64_t _numPartitions;
+  double _maxImbalance;
+};
+}  // namespace arangodb::pregel::algos
@@ -149,7 +149,7 @@ auto GraphLoader<V, E>::load() -> futures::Future<Magazine<V, E>> {
                           update.fn(message::GraphLoadingUpdate{
                               .verticesLoaded = result.numberOfVertices(),
                               .edgesLoaded = result.numberOfEdges(),
-                              .memoryBytesUsed = 0});
+                              .memoryBytesUsed = result.memoryUsage()});
                         },
                         [](OldLoadingUpdate const& update) {
                           SchedulerFeature::SCHEDULER->queue(
@@ -206,10 +206,10 @@ auto GraphLoader<V, E>::loadVertices(LoadableVertexShard loadableVertexShard)
   auto cb = [&](LocalDocumentId const& token, VPackSlice slice) {
     Vertex<V, E> ventry;
     auto keySlice = transaction::helpers::extractKeyFromDocument(slice);
-    auto key = keySlice.copyString();
+    auto key = keySlice.stringView();
 
     ventry.setShard(sourceShard);
-    ventry.setKey(key.c_str(), key.size());
+    ventry.setKey(key.data(), key.size());
     ventry.setActive(true);
 
     // load vertex data
@@ -231,6 +231,10 @@ auto GraphLoader<V, E>::loadVertices(LoadableVertexShard loadableVertexShard)
       auto& info = *edgeCollectionInfos[i];
       loadEdges(trx, ventry, documentId, info);
     }
+    // the edges were added one by one, so the edge vector may have up to
+    // twice the capacity it needs. for large graphs this adds up to a good
+    // part of the memory of the graph
+    ventry.getEdges().shrink_to_fit();
     result->emplace(std::move(ventry));
     return true;
   };
@@ -245,7 +249,7 @@ auto GraphLoader<V, E>::loadVertices(LoadableVertexShard loadableVertexShard)
                           update.fn(message::GraphLoadingUpdate{
                               .verticesLoaded = result->numberOfVertices(),
                               .edgesLoaded = result->numberOfEdges(),
-                              .memoryBytesUsed = 0  // TODO
+                              .memoryBytesUsed = result->memoryUsage()
                           });
                         },
                         [](OldLoadingUpdate const& update) {
@@ -70,8 +70,10 @@ auto GraphStorer<V, E>::storeQuiver(std::shared_ptr<Quiver<V, E>> quiver)
   VPackBuilder builder;
   uint64_t numDocs = 0;
 
-  auto commitTransaction = [&]() {
-    if (trx) {
+  // updates the documents in the builder, in the current transaction
+  auto flushBatch = [&]() {
+    if (numDocs > 0) {
+      TRI_ASSERT(trx != nullptr);
       builder.close();
 
       OperationResult opRes = trx->update(shard, builder.slice(), options);
@@ -94,29 +96,42 @@ auto GraphStorer<V, E>::storeQuiver(std::shared_ptr<Quiver<V, E>> quiver)
             << "conflict while storing " << builder.toJson();
       }
 
-      res = trx->finish(res);
-      if (!res.ok()) {
-        THROW_ARANGO_EXCEPTION(res);
-      }
-
       if (vocbaseGuard.database().server().isStopping()) {
         LOG_PREGEL("73ec2", WARN) << "Storing data was canceled prematurely";
         THROW_ARANGO_EXCEPTION(TRI_ERROR_SHUTTING_DOWN);
       }
 
       numDocs = 0;
+      builder.clear();
+      builder.openArray(true);
     }
+  };
+
+  auto commitTransaction = [&]() {
+    if (trx) {
+      flushBatch();
 
-    builder.clear();
-    builder.openArray(true);
+      res = trx->finish(res);
+      if (!res.ok()) {
+        THROW_ARANGO_EXCEPTION(res);
+      }
+      trx.reset();
+    }
   };
 
+  builder.openArray(true);
+
   // loop over vertices
   // This loop will fill a buffer of vertices until we run into a new
   // collection
-  // or there are no more vertices for to store (or the buffer is full)
+  // or there are no more vertices for to store (or the buffer is full).
+  // there is one transaction per shard, which commits intermediately when
+  // it gets large, instead of one transaction per buffer
   for (auto& vertex : *quiver) {
-    if (vertex.shard() != currentShard || numDocs >= 1000) {
+    if (numDocs >= 1000) {
+      flushBatch();
+    }
+    if (vertex.shard() != currentShard) {
       commitTransaction();
       currentShard = vertex.shard();
       shard = graphSerdeConfig.shardID(currentShard);
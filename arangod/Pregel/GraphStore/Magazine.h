@@ -66,6 +66,13 @@ struct Magazine {
     }
     return sum;
   }
+  auto memoryUsage() const -> size_t {
+    auto sum = quivers.capacity() * sizeof(typename Storage::value_type);
+    for (auto const& quiver : quivers) {
+      sum += sizeof(Quiver<V, E>) + quiver->memoryUsage();
+    }
+    return sum;
+  }
 };
 
 template<typename V, typename E, typename Inspector>
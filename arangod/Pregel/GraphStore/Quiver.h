@@ -26,6 +26,9 @@
 #include "Pregel/GraphStore/Edge.h"
 #include "Pregel/GraphStore/Vertex.h"
 
+#include <string>
+#include <vector>
+
 namespace arangodb::pregel {
 
 /*
@@ -41,10 +44,19 @@ struct Quiver {
 
   auto emplace(VertexType&& v) -> void {
     edgeCounter += v._edges.size();
+    allocatedBytes += heapSize(v._key) + v._edges.capacity() * sizeof(EdgeType);
+    for (auto const& edge : v._edges) {
+      allocatedBytes += heapSize(edge._to.key);
+    }
     vertices.emplace_back(std::move(v));
   }
   auto numberOfVertices() const -> size_t { return vertices.size(); }
   auto numberOfEdges() const -> size_t { return edgeCounter; }
+  // estimated memory usage in bytes. does not include memory allocated by
+  // the vertex and edge data types themselves
+  auto memoryUsage() const -> size_t {
+    return vertices.capacity() * sizeof(VertexType) + allocatedBytes;
+  }
 
   auto begin() const { return std::begin(vertices); }
   auto end() const { return std::end(vertices); }
@@ -54,6 +66,14 @@ struct Quiver {
 
   std::vector<VertexType> vertices;
   std::size_t edgeCounter{0};
+  // memory allocated by the vertices for their keys and edges
+  std::size_t allocatedBytes{0};
+
+ private:
+  static auto heapSize(std::string const& s) -> size_t {
+    // strings that fit into the small string buffer do not allocate
+    return s.capacity() > std::string().capacity() ? s.capacity() + 1 : 0;
+  }
 };
 
 template<typename V, typename E, typename Inspector>
@@ -59,6 +59,14 @@ OutCache<M>::OutCache(std::shared_ptr<WorkerConfig const> state,
       _format(format),
       _baseUrl(Utils::baseUrl(Utils::workerPrefix)) {}
 
+template<typename M>
+void OutCache<M>::_waitForPendingResponses() {
+  if (!_pendingResponses.empty()) {
+    futures::collectAll(_pendingResponses).wait();
+    _pendingResponses.clear();
+  }
+}
+
 // ================= ArrayOutCache ==================
 
 template<typename M>
@@ -79,7 +87,7 @@ void ArrayOutCache<M>::appendMessage(PregelShard shard,
   } else {
     _shardMap[shard][std::string(key)].push_back(data);
     if (++(this->_containedMessages) >= this->_batchSize) {
-      flushMessages();
+      _sendMessages();
     }
   }
 }
@@ -107,9 +115,17 @@ auto ArrayOutCache<M>::messagesToVPack(
 
 template<typename M>
 void ArrayOutCache<M>::flushMessages() {
+  _sendMessages();
+  this->_waitForPendingResponses();
+}
+
+template<typename M>
+void ArrayOutCache<M>::_sendMessages() {
   if (this->_containedMessages == 0) {
     return;
   }
+  // at most one batch is in flight
+  this->_waitForPendingResponses();
 
   // LOG_TOPIC("7af7f", INFO, Logger::PREGEL) << "Beginning to send messages to
   // other machines";
@@ -121,7 +137,6 @@ void ArrayOutCache<M>::flushMessages() {
   reqOpts.database = this->_config->database();
   reqOpts.skipScheduler = true;
 
-  std::vector<futures::Future<network::Response>> responses;
   for (auto const& [shard, vertexMessageMap] : _shardMap) {
     if (vertexMessageMap.size() == 0) {
       continue;
@@ -141,7 +156,7 @@ void ArrayOutCache<M>::flushMessages() {
     VPackBuffer<uint8_t> buffer;
     buffer.append(serialized.get().slice().begin(),
                   serialized.get().slice().byteSize());
-    responses.emplace_back(network::sendRequest(
+    this->_pendingResponses.emplace_back(network::sendRequest(
         pool, "shard:" + this->_config->graphSerdeConfig().shardID(shard),
         fuerte::RestVerb::Post, this->_baseUrl + Utils::messagesPath,
         std::move(buffer), reqOpts));
@@ -149,8 +164,6 @@ void ArrayOutCache<M>::flushMessages() {
     this->_sendCount += shardMessageCount;
   }
 
-  futures::collectAll(responses).wait();
-
   this->_removeContainedMessages();
 }
 
@@ -180,7 +193,7 @@ void CombiningOutCache<M>::appendMessage(PregelShard shard,
       vertexMap.try_emplace(key, data);
 
       if (++(this->_containedMessages) >= this->_batchSize) {
-        flushMessages();
+        _sendMessages();
       }
     }
   }
@@ -204,9 +217,17 @@ auto CombiningOutCache<M>::messagesToVPack(
 
 template<typename M>
 void CombiningOutCache<M>::flushMessages() {
+  _sendMessages();
+  this->_waitForPendingResponses();
+}
+
+template<typename M>
+void CombiningOutCache<M>::_sendMessages() {
   if (this->_containedMessages == 0) {
     return;
   }
+  // at most one batch is in flight
+  this->_waitForPendingResponses();
 
   uint64_t gss = this->_config->globalSuperstep();
 
@@ -218,7 +239,6 @@ void CombiningOutCache<M>::flushMessages() {
   reqOpts.timeout = network::Timeout(180);
   reqOpts.skipScheduler = true;
 
-  std::vector<futures::Future<network::Response>> responses;
   for (auto const& [shard, vertexMessageMap] : _shardMap) {
     if (vertexMessageMap.size() == 0) {
       continue;
@@ -237,7 +257,7 @@ void CombiningOutCache<M>::flushMessages() {
     VPackBuffer<uint8_t> buffer;
     buffer.append(serialized.get().slice().begin(),
                   serialized.get().slice().byteSize());
-    responses.emplace_back(network::sendRequest(
+    this->_pendingResponses.emplace_back(network::sendRequest(
         pool, "shard:" + this->_config->graphSerdeConfig().shardID(shard),
         fuerte::RestVerb::Post, this->_baseUrl + Utils::messagesPath,
         std::move(buffer), reqOpts));
@@ -245,8 +265,6 @@ void CombiningOutCache<M>::flushMessages() {
     this->_sendCount += vertexMessageMap.size();
   }
 
-  futures::collectAll(responses).wait();
-
   _removeContainedMessages();
 }
 
@@ -29,6 +29,8 @@
 #include "Containers/FlatHashMap.h"
 #include "Containers/FlatHashSet.h"
 #include "Containers/NodeHashMap.h"
+#include "Futures/Future.h"
+#include "Network/Methods.h"
 #include "Pregel/Worker/Messages.h"
 #include "VocBase/voc-types.h"
 
@@ -68,7 +70,12 @@ class OutCache {
   /// @brief current number of vertices stored
   size_t _containedMessages = 0;
   size_t _sendCount = 0;
+  /// @brief responses to the last batch of messages sent. we only wait for
+  /// them when sending the next batch, so that computing the next batch
+  /// overlaps with sending this one
+  std::vector<futures::Future<network::Response>> _pendingResponses;
   virtual void _removeContainedMessages() = 0;
+  void _waitForPendingResponses();
   virtual auto _clearSendCountPerActor() -> void{};
 
   bool isLocalShard(PregelShard pregelShard) {
@@ -130,6 +137,10 @@ class ArrayOutCache : public OutCache<M> {
   void appendMessage(PregelShard shard, std::string_view const& key,
                      M const& data) override;
   void flushMessages() override;
+
+ private:
+  /// @brief send all contained messages, without waiting for the responses
+  void _sendMessages();
 };
 
 template<typename M>
@@ -160,6 +171,10 @@ class CombiningOutCache : public OutCache<M> {
   void appendMessage(PregelShard shard, std::string_view const& key,
                      M const& data) override;
   void flushMessages() override;
+
+ private:
+  /// @brief send all contained messages, without waiting for the responses
+  void _sendMessages();
 };
 
 template<typename M>
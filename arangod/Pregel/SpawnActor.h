@@ -34,6 +34,7 @@
 #include "VocBase/vocbase.h"
 #include "fmt/core.h"
 
+#include "Pregel/Algos/BalancedPartitioning/BalancedPartitioning.h"
 #include "Pregel/Algos/ColorPropagation/ColorPropagation.h"
 #include "Pregel/Algos/ConnectedComponents/ConnectedComponents.h"
 #include "Pregel/Algos/DMID/DMID.h"
@@ -169,6 +170,12 @@ struct SpawnHandler : actor::HandlerBase<Runtime, SpawnState> {
                   algos::ColorPropagationType::Message>(
           std::make_unique<algos::ColorPropagation>(userParams),
           std::move(msg));
+    } else if (algorithm == "balancedpartitioning") {
+      spawnWorker<algos::BalancedPartitioningType::Vertex,
+                  algos::BalancedPartitioningType::Edge,
+                  algos::BalancedPartitioningType::Message>(
+          std::make_unique<algos::BalancedPartitioning>(userParams),
+          std::move(msg));
     }
 #if defined(ARANGODB_ENABLE_MAINTAINER_MODE)
     else if (algorithm == "readwrite") {
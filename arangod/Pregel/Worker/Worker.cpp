@@ -64,6 +64,8 @@
 
 #include <velocypack/Builder.h>
 
+#include <algorithm>
+
 #include "fmt/core.h"
 
 using namespace arangodb;
@@ -156,6 +158,7 @@ void Worker<V, E, M>::setupWorker() {
   auto self = shared_from_this();
   loader->load().thenFinal([self, this](auto&& r) {
     _magazine = r.get();
+    _buildWorkUnits();
 
     LOG_PREGEL("52062", WARN)
         << fmt::format("Worker for execution number {} has finished loading.",
@@ -302,16 +305,63 @@ void Worker<V, E, M>::cancelGlobalStep(VPackSlice const& data) {
   _workHandle.reset();
 }
 
+template<typename V, typename E, typename M>
+void Worker<V, E, M>::_buildWorkUnits() {
+  // a quiver holds all vertices of a shard. processing it as a whole would
+  // leave threads idle if there are fewer shards than threads, or if the
+  // shards differ in size. the work is therefore split into units of about
+  // the same number of vertices plus edges. a vertex with very many edges
+  // gets a unit of its own, and as the most expensive units are processed
+  // first, it does not delay the end of the superstep as much
+  constexpr size_t minUnitCost = 1000;
+  size_t const totalCost =
+      _magazine.numberOfVertices() + _magazine.numberOfEdges();
+  size_t const targetCost = std::max(
+      totalCost / (std::max<size_t>(_config->parallelism(), 1) * 16),
+      minUnitCost);
+
+  _workUnits.clear();
+  for (auto& quiver : _magazine) {
+    auto& vertices = quiver->vertices;
+    WorkUnit unit{quiver.get(), 0, 0, 0};
+    for (size_t i = 0; i < vertices.size(); ++i) {
+      size_t const cost = 1 + vertices[i].getEdgeCount();
+      if (cost >= targetCost && unit.end > unit.begin) {
+        // a vertex with many edges: close the current unit
+        _workUnits.push_back(unit);
+        unit = WorkUnit{quiver.get(), i, i, 0};
+      }
+      unit.end = i + 1;
+      unit.cost += cost;
+      if (unit.cost >= targetCost) {
+        _workUnits.push_back(unit);
+        unit = WorkUnit{quiver.get(), i + 1, i + 1, 0};
+      }
+    }
+    if (unit.end > unit.begin) {
+      _workUnits.push_back(unit);
+    }
+  }
+  std::stable_sort(
+      _workUnits.begin(), _workUnits.end(),
+      [](WorkUnit const& a, WorkUnit const& b) { return a.cost > b.cost; });
+
+  LOG_PREGEL("a7431", DEBUG) << fmt::format(
+      "Split {} vertices and {} edges into {} work units",
+      _magazine.numberOfVertices(), _magazine.numberOfEdges(),
+      _workUnits.size());
+}
+
 template<typename V, typename E, typename M>
 void Worker<V, E, M>::_startProcessing() {
   TRI_ASSERT(SchedulerFeature::SCHEDULER != nullptr);
   auto self = shared_from_this();
   auto futures = std::vector<futures::Future<VertexProcessorResult>>();
-  auto quiverIdx = std::make_shared<std::atomic<size_t>>(0);
+  auto unitIdx = std::make_shared<std::atomic<size_t>>(0);
 
   for (auto futureN = size_t{0}; futureN < _config->parallelism(); ++futureN) {
     futures.emplace_back(SchedulerFeature::SCHEDULER->queueWithFuture(
-        RequestLane::INTERNAL_LOW, [self, this, quiverIdx, futureN]() {
+        RequestLane::INTERNAL_LOW, [self, this, unitIdx, futureN]() {
           LOG_PREGEL("ee2ac", DEBUG) << fmt::format(
               "Starting vertex processor number {} with batch size", futureN,
               _messageBatchSize);
@@ -320,13 +370,15 @@ void Worker<V, E, M>::_startProcessing() {
               _messageFormat, _messageBatchSize);
 
           while (true) {
-            auto myCurrentQuiver = quiverIdx->fetch_add(1);
-            if (myCurrentQuiver >= _magazine.size()) {
+            auto myCurrentUnit = unitIdx->fetch_add(1);
+            if (myCurrentUnit >= _workUnits.size()) {
               LOG_PREGEL("ee215", DEBUG) << fmt::format(
                   "No more work left in vertex processor number {}", futureN);
               break;
             }
-            for (auto& vertex : *_magazine.quivers.at(myCurrentQuiver)) {
+            auto const& unit = _workUnits[myCurrentUnit];
+            for (size_t i = unit.begin; i < unit.end; ++i) {
+              auto& vertex = unit.quiver->vertices[i];
               auto messages =
                   _readCache->getMessages(vertex.shard(), vertex.key());
               processor.process(&vertex, messages);
@@ -110,6 +110,17 @@ class Worker : public IWorker {
   std::unique_ptr<AggregatorHandler> _conductorAggregators;
   std::unique_ptr<AggregatorHandler> _workerAggregators;
   Magazine<V, E> _magazine;
+  /// a range of vertices of one quiver, processed by one thread
+  struct WorkUnit {
+    Quiver<V, E>* quiver;
+    size_t begin;
+    size_t end;
+    // number of vertices plus number of their edges
+    size_t cost;
+  };
+  /// the vertices of all quivers split into work units of about the same
+  /// cost, most expensive first. built once the graph is loaded
+  std::vector<WorkUnit> _workUnits;
   std::unique_ptr<MessageFormat<M>> _messageFormat;
   std::unique_ptr<MessageCombiner<M>> _messageCombiner;
 
@@ -129,6 +140,7 @@ class Worker : public IWorker {
   size_t _runningThreads = 0;
   Scheduler::WorkHandle _workHandle;
 
+  void _buildWorkUnits();
   void _startProcessing();
   void _finishedProcessing();
   void _callConductor(std::string const& path,
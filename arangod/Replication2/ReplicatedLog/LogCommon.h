@@ -285,11 +285,15 @@ struct ReplicatedLogGlobalSettings {
   static inline constexpr std::size_t minThresholdRocksDBWriteBatchSize{1024 *
                                                                         1024};
   static inline constexpr std::size_t defaultThresholdLogCompaction{1000};
+  // 0 means payloads are never compressed
+  static inline constexpr std::size_t defaultThresholdPayloadCompression{0};
 
   std::size_t _thresholdNetworkBatchSize{defaultThresholdNetworkBatchSize};
   std::size_t _thresholdRocksDBWriteBatchSize{
       defaultThresholdRocksDBWriteBatchSize};
   std::size_t _thresholdLogCompaction{defaultThresholdLogCompaction};
+  std::size_t _thresholdPayloadCompression{
+      defaultThresholdPayloadCompression};
 };
 
 namespace replicated_log {
@@ -43,22 +43,38 @@ void LogEntry::toVelocyPack(velocypack::Builder& builder) const {
   builder.openObject();
   builder.add(StaticStrings::LogIndex,
               velocypack::Value(_termIndex.index.value));
-  entriesWithoutIndexToVelocyPack(builder);
+  entriesWithoutIndexToVelocyPack(builder, /*uncompress*/ true);
+  builder.close();
+}
+
+void LogEntry::toVelocyPack(velocypack::Builder& builder,
+                            LogEntry::KeepCompressed) const {
+  builder.openObject();
+  builder.add(StaticStrings::LogIndex,
+              velocypack::Value(_termIndex.index.value));
+  entriesWithoutIndexToVelocyPack(builder, /*uncompress*/ false);
   builder.close();
 }
 
 void LogEntry::toVelocyPack(velocypack::Builder& builder,
                             LogEntry::OmitLogIndex) const {
   builder.openObject();
-  entriesWithoutIndexToVelocyPack(builder);
+  entriesWithoutIndexToVelocyPack(builder, /*uncompress*/ false);
   builder.close();
 }
 
-void LogEntry::entriesWithoutIndexToVelocyPack(
-    velocypack::Builder& builder) const {
+void LogEntry::entriesWithoutIndexToVelocyPack(velocypack::Builder& builder,
+                                               bool uncompress) const {
   builder.add(StaticStrings::LogTerm, velocypack::Value(_termIndex.term.value));
   if (std::holds_alternative<LogPayload>(_payload)) {
-    builder.add(StaticStrings::Payload, std::get<LogPayload>(_payload).slice());
+    auto slice = std::get<LogPayload>(_payload).slice();
+    if (uncompress) {
+      LogPayload::BufferType buffer;
+      builder.add(StaticStrings::Payload,
+                  LogPayload::uncompress(slice, buffer));
+    } else {
+      builder.add(StaticStrings::Payload, slice);
+    }
   } else {
     TRI_ASSERT(std::holds_alternative<LogMetaPayload>(_payload));
     builder.add(velocypack::Value(StaticStrings::Meta));
@@ -54,7 +54,13 @@ class LogEntry {
 
   class OmitLogIndex {};
   constexpr static auto omitLogIndex = OmitLogIndex();
+  class KeepCompressed {};
+  constexpr static auto keepCompressed = KeepCompressed();
+  // Compressed payloads are uncompressed, unless `KeepCompressed` is passed.
+  // The `OmitLogIndex` variant is used for persisting the entry, and keeps
+  // payloads compressed as well.
   void toVelocyPack(velocypack::Builder& builder) const;
+  void toVelocyPack(velocypack::Builder& builder, KeepCompressed) const;
   void toVelocyPack(velocypack::Builder& builder, OmitLogIndex) const;
   static auto fromVelocyPack(velocypack::Slice slice) -> LogEntry;
 
@@ -62,7 +68,8 @@ class LogEntry {
       -> bool = default;
 
  private:
-  void entriesWithoutIndexToVelocyPack(velocypack::Builder& builder) const;
+  void entriesWithoutIndexToVelocyPack(velocypack::Builder& builder,
+                                       bool uncompress) const;
 
   TermIndexPair _termIndex;
   // TODO It seems impractical to not copy persisting log entries, so we
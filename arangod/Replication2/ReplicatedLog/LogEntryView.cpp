@@ -44,7 +44,8 @@ auto LogEntryView::logPayload() const noexcept -> velocypack::Slice {
 void LogEntryView::toVelocyPack(velocypack::Builder& builder) const {
   auto og = velocypack::ObjectBuilder(&builder);
   builder.add(StaticStrings::LogIndex, velocypack::Value(_index));
-  builder.add(StaticStrings::Payload, _payload);
+  LogPayload::BufferType buffer;
+  builder.add(StaticStrings::Payload, LogPayload::uncompress(_payload, buffer));
 }
 
 auto LogEntryView::fromVelocyPack(velocypack::Slice slice) -> LogEntryView {
@@ -664,6 +664,8 @@ auto replicated_log::LogLeader::insert(LogPayload payload, bool waitForSync)
 auto replicated_log::LogLeader::insert(LogPayload payload, bool waitForSync,
                                        DoNotTriggerAsyncReplication)
     -> LogIndex {
+  payload = LogPayload::compress(std::move(payload),
+                                 _options->_thresholdPayloadCompression);
   return insertInternal(std::move(payload), waitForSync);
 }
 
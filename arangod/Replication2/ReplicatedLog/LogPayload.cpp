@@ -25,10 +25,19 @@
 
 #include "Basics/Exceptions.h"
 
+#include <snappy.h>
 #include <velocypack/Builder.h>
 
+#include <string>
+
 namespace arangodb::replication2 {
 
+namespace {
+// first byte of the binary value of a compressed payload. identifies the
+// compression algorithm.
+constexpr std::uint8_t kSnappyMarker = 0x01;
+}  // namespace
+
 auto operator==(LogPayload const& left, LogPayload const& right) -> bool {
   if (left.slice().isString() and right.slice().isString()) {
     return left.slice().stringView() == right.slice().stringView();
@@ -53,6 +62,57 @@ auto LogPayload::createFromString(std::string_view string) -> LogPayload {
   return LogPayload{*builder.steal()};
 }
 
+auto LogPayload::compress(LogPayload payload, std::size_t threshold)
+    -> LogPayload {
+  if (threshold == 0 || payload.byteSize() < threshold) {
+    return payload;
+  }
+
+  std::string compressed;
+  compressed.push_back(static_cast<char>(kSnappyMarker));
+  std::string scratch;
+  snappy::Compress(reinterpret_cast<char const*>(payload.buffer.data()),
+                   payload.buffer.size(), &scratch);
+  compressed.append(scratch);
+
+  VPackBuilder builder;
+  builder.add(VPackValuePair(compressed.data(), compressed.size(),
+                             velocypack::ValueType::Binary));
+  if (builder.size() >= payload.byteSize()) {
+    // not worth it
+    return payload;
+  }
+  return LogPayload{*builder.steal()};
+}
+
+auto LogPayload::isCompressed(velocypack::Slice slice) noexcept -> bool {
+  if (!slice.isBinary()) {
+    return false;
+  }
+  velocypack::ValueLength length;
+  auto data = slice.getBinary(length);
+  return length > 0 && data[0] == kSnappyMarker;
+}
+
+auto LogPayload::uncompress(velocypack::Slice slice, BufferType& buffer)
+    -> velocypack::Slice {
+  if (!isCompressed(slice)) {
+    return slice;
+  }
+  velocypack::ValueLength length;
+  auto data = reinterpret_cast<char const*>(slice.getBinary(length)) + 1;
+  --length;
+
+  std::string uncompressed;
+  if (!snappy::Uncompress(data, length, &uncompressed)) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL,
+                                   "invalid compressed log payload");
+  }
+  buffer.clear();
+  buffer.append(uncompressed.data(), uncompressed.size());
+  return VPackSlice(buffer.data());
+}
+
 auto LogPayload::copyBuffer() const -> velocypack::UInt8Buffer {
   velocypack::UInt8Buffer result;
   result.append(buffer.data(), buffer.size());
@@ -41,6 +41,22 @@ struct LogPayload {
   [[nodiscard]] static auto createFromString(std::string_view string)
       -> LogPayload;
 
+  // Returns a Snappy-compressed copy of the payload if the payload is at least
+  // `threshold` bytes large and compression makes it smaller. Otherwise, the
+  // payload is returned unchanged. A threshold of 0 disables compression.
+  // Compressed payloads are stored as a velocypack binary value, prefixed with
+  // a marker byte.
+  [[nodiscard]] static auto compress(LogPayload payload, std::size_t threshold)
+      -> LogPayload;
+  [[nodiscard]] static auto isCompressed(velocypack::Slice slice) noexcept
+      -> bool;
+  // Returns the uncompressed payload. If the slice is compressed, it is
+  // uncompressed into `buffer`, and the returned slice points into it.
+  // Otherwise, the slice is returned as is. Throws if the compressed data is
+  // corrupt.
+  [[nodiscard]] static auto uncompress(velocypack::Slice slice,
+                                       BufferType& buffer) -> velocypack::Slice;
+
   friend auto operator==(LogPayload const&, LogPayload const&) -> bool;
 
   [[nodiscard]] auto byteSize() const noexcept -> std::size_t;
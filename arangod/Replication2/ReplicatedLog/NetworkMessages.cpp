@@ -305,7 +305,8 @@ void replicated_log::AppendEntriesRequest::toVelocyPack(
     builder.add("waitForSync", VPackValue(waitForSync));
     builder.add("entries", VPackValue(VPackValueType::Array));
     for (auto const& it : entries) {
-      it.entry().toVelocyPack(builder);
+      // followers store the payloads as they are
+      it.entry().toVelocyPack(builder, LogEntry::keepCompressed);
     }
     builder.close();  // close entries
   }
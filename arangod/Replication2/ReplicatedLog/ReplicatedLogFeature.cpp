@@ -79,9 +79,26 @@ void ReplicatedLogFeature::prepare() {
 
 void ReplicatedLogFeature::collectOptions(
     std::shared_ptr<ProgramOptions> options) {
-#if defined(ARANGODB_ENABLE_MAINTAINER_MODE)
   options->addSection("replicated-log", "Options for replicated logs");
 
+  options
+      ->addOption(
+          "--replicated-log.threshold-payload-compression",
+          "Compress log entry payloads of at least this size (in bytes). "
+          "0 disables compression.",
+          new SizeTParameter(&_options->_thresholdPayloadCompression,
+                             /*base*/ 1, /*minValue*/ 0))
+      .setIntroducedIn(31200)
+      .setLongDescription(R"(If set to a value greater than 0, the leader of
+a replicated log compresses the payloads of log entries that are at least this
+large before replicating and persisting them. Payloads are uncompressed again
+when they are applied or returned by the log APIs.
+
+Only enable compression once all servers of the deployment run a version
+that supports it, as older followers cannot read compressed log entries.)");
+
+#if defined(ARANGODB_ENABLE_MAINTAINER_MODE)
+
   options->addOption(
       "--replicated-log.threshold-network-batch-size",
       "send a batch of log updates early when threshold "
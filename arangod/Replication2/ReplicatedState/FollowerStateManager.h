@@ -75,6 +75,8 @@ struct FollowerStateManager
   [[nodiscard]] auto getStateMachine() const
       -> std::shared_ptr<IReplicatedFollowerState<S>>;
   [[nodiscard]] auto waitForApplied(LogIndex) -> WaitForQueue::WaitForFuture;
+  // number of committed entries that have not been applied yet
+  [[nodiscard]] auto getApplyLag() const -> std::uint64_t;
 
  private:
   LoggerContext const _loggerContext;
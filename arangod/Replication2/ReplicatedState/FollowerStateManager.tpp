@@ -439,4 +439,14 @@ auto FollowerStateManager<S>::waitForApplied(LogIndex index)
   return _guardedData.getLockedGuard()->waitForApplied(index);
 }
 
+template<typename S>
+auto FollowerStateManager<S>::getApplyLag() const -> std::uint64_t {
+  auto guard = _guardedData.getLockedGuard();
+  auto const appliedIndex = guard->_lastAppliedPosition.index();
+  if (guard->_commitIndex <= appliedIndex) {
+    return 0;
+  }
+  return guard->_commitIndex.value - appliedIndex.value;
+}
+
 }  // namespace arangodb::replication2::replicated_state
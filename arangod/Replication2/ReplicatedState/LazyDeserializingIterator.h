@@ -24,6 +24,7 @@
 #pragma once
 
 #include "Replication2/ReplicatedLog/LogEntryView.h"
+#include "Replication2/ReplicatedLog/LogPayload.h"
 #include "Replication2/Streams/Streams.h"
 
 namespace arangodb::replication2 {
@@ -40,7 +41,10 @@ struct LazyDeserializingIterator
 
   auto next() -> std::optional<streams::StreamEntryView<To>> override {
     if (auto&& current = _iterator->next(); current.has_value()) {
-      auto slice = current->logPayload();
+      // the previous value may refer to the buffer
+      _current.reset();
+      // compressed payloads are uncompressed transparently
+      auto slice = LogPayload::uncompress(current->logPayload(), _buffer);
       auto value = std::invoke(
           Deserializer{}, streams::serializer_tag<std::decay_t<To>>, slice);
       _current.emplace(std::move(value));
@@ -58,6 +62,7 @@ struct LazyDeserializingIterator
  private:
   std::unique_ptr<TypedLogRangeIterator<From>> _iterator;
   std::optional<std::remove_reference_t<To>> _current;
+  LogPayload::BufferType _buffer;
 };
 
 }  // namespace arangodb::replication2
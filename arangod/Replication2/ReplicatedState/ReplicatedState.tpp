@@ -73,6 +73,15 @@ auto IReplicatedFollowerState<S>::waitForApplied(LogIndex index)
   }
 }
 
+template<typename S>
+auto IReplicatedFollowerState<S>::getApplyLag() const
+    -> std::optional<std::uint64_t> {
+  if (auto manager = _manager.lock(); manager != nullptr) {
+    return manager->getApplyLag();
+  }
+  return std::nullopt;
+}
+
 template<typename S>
 ReplicatedState<S>::ReplicatedState(
     GlobalLogIdentifier gid, std::shared_ptr<replicated_log::ReplicatedLog> log,
@@ -28,6 +28,9 @@
 #include "Replication2/ReplicatedState/WaitForQueue.h"
 #include "Replication2/Streams/Streams.h"
 
+#include <cstdint>
+#include <optional>
+
 namespace arangodb::futures {
 struct Unit;
 template<typename T>
@@ -118,6 +121,13 @@ struct IReplicatedFollowerState : IReplicatedStateImplBase<S>,
   using WaitForAppliedFuture = futures::Future<futures::Unit>;
   [[nodiscard]] auto waitForApplied(LogIndex index) -> WaitForAppliedFuture;
 
+  /**
+   * Returns the number of log entries that are known to be committed, but
+   * have not yet been applied to the state machine. Returns std::nullopt if
+   * the follower has resigned.
+   */
+  [[nodiscard]] auto getApplyLag() const -> std::optional<std::uint64_t>;
+
  protected:
   /**
    * Called by the state machine manager if new log entries have been committed
@@ -394,6 +394,16 @@ auto DocumentFollowerState::handleSnapshotTransfer(
           currentShard = snapshotRes->shardId;
         }
 
+        // Request the next batch right away, so that the leader reads it
+        // while this batch is being inserted locally.
+        std::optional<futures::Future<ResultT<SnapshotBatch>>> nextBatch;
+        if (snapshotRes->hasMore) {
+          LOG_CTX("a732f", DEBUG, self->loggerContext)
+              << "Trying to fetch the next batch of snapshot: "
+              << snapshotRes->snapshotId;
+          nextBatch.emplace(leader->nextSnapshotBatch(snapshotId));
+        }
+
         if (snapshotRes->shardId.has_value()) {
           bool reportingFailure = false;
           auto insertRes = self->_guardedData.doUnderLock([&self, &snapshotRes,
@@ -444,14 +454,10 @@ auto DocumentFollowerState::handleSnapshotTransfer(
           TRI_ASSERT(!snapshotRes->hasMore);
         }
 
-        if (snapshotRes->hasMore) {
-          LOG_CTX("a732f", DEBUG, self->loggerContext)
-              << "Trying to fetch the next batch of snapshot: "
-              << snapshotRes->snapshotId;
-          auto fut = leader->nextSnapshotBatch(snapshotId);
+        if (nextBatch.has_value()) {
           return self->handleSnapshotTransfer(
               snapshotId, std::move(leader), snapshotVersion,
-              std::move(currentShard), std::move(fut));
+              std::move(currentShard), std::move(*nextBatch));
         }
 
         LOG_CTX("742df", DEBUG, self->loggerContext)
@@ -84,6 +84,9 @@ auto DocumentFactory::constructCleanupHandler()
 
 template struct arangodb::replication2::replicated_state::ReplicatedState<
     DocumentState>;
+template auto arangodb::replication2::replicated_state::
+    IReplicatedFollowerState<DocumentState>::getApplyLag() const
+    -> std::optional<std::uint64_t>;
 
 void DocumentCleanupHandler::drop(std::unique_ptr<DocumentCore> core) {
   core->drop();
@@ -115,6 +115,17 @@ void AsyncLogWriteBatcher::runPersistorWorker(Lane& lane) noexcept {
                 return left.objectId < right.objectId;
               });
 
+    // resolve all promises in [nextReqToResolve, nextReqToWrite)
+    auto resolvePromises = [&](SequenceNumber seq) {
+      for (; nextReqToResolve != nextReqToWrite; ++nextReqToResolve) {
+        _executor->operator()(
+            [seq,
+             reqToResolve = std::move(*nextReqToResolve)]() mutable noexcept {
+              reqToResolve.promise.setValue(ResultT{seq});
+            });
+      }
+    };
+
     auto result = basics::catchToResult([&] {
       ::rocksdb::WriteBatch wb;
 
@@ -144,29 +155,28 @@ void AsyncLogWriteBatcher::runPersistorWorker(Lane& lane) noexcept {
               return rocksutils::convertStatus(s);
             }
           }
-          if (lane._waitForSync) {
-            {
-              MeasureTimeGuard metricsGuard(*_metrics->rocksdbSyncTimeInUs);
-              if (auto s = _db->SyncWAL(); !s.ok()) {
-                // At this point we have to make sure that every previous log
-                // entry is synced as well. Otherwise we might get holes in the
-                // log.
-                return rocksutils::convertStatus(s);
-              }
-            }
-          }
         }
 
-        auto seq = _db->GetLatestSequenceNumber();
+        if (!lane._waitForSync) {
+          resolvePromises(_db->GetLatestSequenceNumber());
+        }
+      }
 
-        // resolve all promises in [nextReqToResolve, nextReqToWrite)
-        for (; nextReqToResolve != nextReqToWrite; ++nextReqToResolve) {
-          _executor->operator()(
-              [seq,
-               reqToResolve = std::move(*nextReqToResolve)]() mutable noexcept {
-                reqToResolve.promise.setValue(ResultT{seq});
-              });
+      if (lane._waitForSync) {
+        // All write batches of this group are synced together, so that the
+        // requests of all logs that were queued in the meantime share a
+        // single SyncWAL, instead of one per write batch.
+        _metrics->syncGroupSize->count(pendingRequests.size());
+        {
+          MeasureTimeGuard metricsGuard(*_metrics->rocksdbSyncTimeInUs);
+          if (auto s = _db->SyncWAL(); !s.ok()) {
+            // At this point we have to make sure that every previous log
+            // entry is synced as well. Otherwise we might get holes in the
+            // log.
+            return rocksutils::convertStatus(s);
+          }
         }
+        resolvePromises(_db->GetLatestSequenceNumber());
       }
 
       return Result{TRI_ERROR_NO_ERROR};
@@ -40,6 +40,8 @@ struct AsyncLogWriteBatcherMetrics {
 
   metrics::Histogram<metrics::LogScale<std::uint64_t>>* rocksdbWriteTimeInUs;
   metrics::Histogram<metrics::LogScale<std::uint64_t>>* rocksdbSyncTimeInUs;
+  // number of requests (of any logs) that share one SyncWAL
+  metrics::Histogram<metrics::LogScale<std::uint64_t>>* syncGroupSize;
 
   metrics::Histogram<metrics::LogScale<std::uint64_t>>* operationLatencyInsert;
   metrics::Histogram<metrics::LogScale<std::uint64_t>>*
@@ -55,6 +55,16 @@ DECLARE_HISTOGRAM(arangodb_replication2_rocksdb_write_time,
                   "Replicated log batches write time[us]");
 DECLARE_HISTOGRAM(arangodb_replication2_rocksdb_sync_time, ApplyEntriesRttScale,
                   "Replicated log batches sync time[us]");
+struct SyncGroupSizeScale {
+  using scale_t = metrics::LogScale<std::uint64_t>;
+  static scale_t scale() {
+    // number of requests, smallest bucket is up to 1
+    return {scale_t::kSupplySmallestBucket, 2, 0, 1, 16};
+  }
+};
+DECLARE_HISTOGRAM(arangodb_replication2_rocksdb_sync_group_size,
+                  SyncGroupSizeScale,
+                  "Number of replicated log operations per WAL sync");
 DECLARE_HISTOGRAM(arangodb_replication2_storage_operation_latency,
                   ApplyEntriesRttScale,
                   "Replicated log storage operation latency[us]");
@@ -23,6 +23,7 @@
 
 #include "RestAdminClusterHandler.h"
 
+#include <algorithm>
 #include <chrono>
 
 #include <boost/functional/hash.hpp>
@@ -56,8 +57,10 @@
 #include "Logger/LoggerStream.h"
 #include "Network/Methods.h"
 #include "Network/NetworkFeature.h"
+#include "RestServer/DatabaseFeature.h"
 #include "Scheduler/SchedulerFeature.h"
 #include "Sharding/ShardDistributionReporter.h"
+#include "StorageEngine/PhysicalCollection.h"
 #include "Utils/ExecContext.h"
 #include "VocBase/LogicalCollection.h"
 #include "VocBase/Methods/Databases.h"
@@ -293,6 +296,7 @@ std::string const RestAdminClusterHandler::RemoveServer = "removeServer";
 std::string const RestAdminClusterHandler::RebalanceShards = "rebalanceShards";
 std::string const RestAdminClusterHandler::Rebalance = "rebalance";
 std::string const RestAdminClusterHandler::ShardStatistics = "shardStatistics";
+std::string const RestAdminClusterHandler::ShardLoad = "shardLoad";
 
 RestStatus RestAdminClusterHandler::execute() {
   // here we first do a glboal check, which is based on the setting in startup
@@ -368,6 +372,8 @@ RestStatus RestAdminClusterHandler::execute() {
       return handleRebalance();
     } else if (command == ShardStatistics) {
       return handleShardStatistics();
+    } else if (command == ShardLoad) {
+      return handleShardLoad();
     } else {
       generateError(rest::ResponseCode::BAD, TRI_ERROR_HTTP_BAD_PARAMETER,
                     std::string("invalid command '") + command + "'");
@@ -644,6 +650,88 @@ RestStatus RestAdminClusterHandler::handleShardStatistics() {
   return RestStatus::DONE;
 }
 
+RestStatus RestAdminClusterHandler::handleShardLoad() {
+  if (!ExecContext::current().isAdminUser()) {
+    generateError(rest::ResponseCode::FORBIDDEN, TRI_ERROR_HTTP_FORBIDDEN);
+    return RestStatus::DONE;
+  }
+
+  if (request()->requestType() != rest::RequestType::GET) {
+    generateError(rest::ResponseCode::METHOD_NOT_ALLOWED,
+                  TRI_ERROR_HTTP_METHOD_NOT_ALLOWED);
+    return RestStatus::DONE;
+  }
+
+  if (!ServerState::instance()->isDBServer()) {
+    generateError(rest::ResponseCode::NOT_IMPLEMENTED,
+                  TRI_ERROR_CLUSTER_ONLY_ON_DBSERVER);
+    return RestStatus::DONE;
+  }
+
+  // shard names are unique across all databases
+  VPackBuilder builder;
+  builder.openObject();
+  auto& databaseFeature = server().getFeature<DatabaseFeature>();
+  databaseFeature.enumerate([&](TRI_vocbase_t* vocbase) {
+    vocbase->processCollections([&](LogicalCollection* collection) {
+      auto* physical = collection->getPhysical();
+      builder.add(VPackValue(collection->name()));
+      builder.openObject();
+      builder.add("size", VPackValue(physical->approximateSize()));
+      builder.add("writes", VPackValue(physical->numberWrites()));
+      builder.close();
+    });
+  });
+  builder.close();
+
+  generateOk(rest::ResponseCode::OK, builder.slice());
+  return RestStatus::DONE;
+}
+
+futures::Future<RestAdminClusterHandler::ShardLoads>
+RestAdminClusterHandler::fetchShardLoads() {
+  auto& ci = server().getFeature<ClusterFeature>().clusterInfo();
+  auto* pool = server().getFeature<NetworkFeature>().pool();
+
+  network::RequestOptions opt;
+  opt.timeout = 10s;
+
+  std::vector<futures::Future<network::Response>> fs;
+  for (auto const& server : ci.getCurrentDBServers()) {
+    fs.emplace_back(network::sendRequest(
+        pool, "server:" + server, fuerte::RestVerb::Get,
+        "/_admin/cluster/shardLoad", VPackBuffer<uint8_t>(), opt));
+  }
+
+  return futures::collectAll(fs).thenValue(
+      [](std::vector<futures::Try<network::Response>>&& responses) {
+        ShardLoads loads;
+        for (auto const& response : responses) {
+          if (!response.hasValue() || response.get().fail() ||
+              response.get().statusCode() != fuerte::StatusOK) {
+            // the shards of this server keep the default load
+            LOG_TOPIC("9a7e2", INFO, Logger::CLUSTER)
+                << "could not fetch shard load from DBServer";
+            continue;
+          }
+          VPackSlice result = response.get().slice().get("result");
+          if (!result.isObject()) {
+            continue;
+          }
+          for (auto [shard, value] : VPackObjectIterator(result)) {
+            // leader and followers report their own values, which differ
+            // only slightly. use the larger ones
+            auto& load = loads[shard.copyString()];
+            load.size = std::max(load.size,
+                                 value.get("size").getNumber<uint64_t>());
+            load.writes = std::max(load.writes,
+                                   value.get("writes").getNumber<uint64_t>());
+          }
+        }
+        return loads;
+      });
+}
+
 RestStatus RestAdminClusterHandler::handleCleanoutServer() {
   return handleSingleServerJob("cleanOutServer");
 }
@@ -2385,6 +2473,9 @@ struct RebalanceOptions {
   bool moveLeaders;
   bool moveFollowers;
   bool excludeSystemCollections;
+  // whether to take the observed size and write load of the shards into
+  // account
+  bool loadAware;
   double piFactor;
   std::vector<DatabaseID> databasesExcluded;
 };
@@ -2400,6 +2491,7 @@ auto inspect(Inspector& f, RebalanceOptions& x) {
       f.field("moveFollowers", x.moveFollowers).fallback(false),
       f.field("excludeSystemCollections", x.excludeSystemCollections)
           .fallback(false),
+      f.field("loadAware", x.loadAware).fallback(false),
       f.field("piFactor", x.piFactor).fallback(1.0),
       f.field("databasesExcluded", x.databasesExcluded)
           .fallback(std::vector<DatabaseID>{}));
@@ -2578,102 +2670,118 @@ RestStatus RestAdminClusterHandler::handleRebalancePlan() {
     return opts;
   };
 
-  std::vector<MoveShardJob> moves;
-
   auto options = readRebalanceOptions();
   if (!options) {
     return RestStatus::DONE;
   }
 
-  auto p = collectRebalanceInformation(options->databasesExcluded,
-                                       options->excludeSystemCollections);
-  auto const imbalanceLeaderBefore = p.computeLeaderImbalance();
-  auto const imbalanceShardsBefore = p.computeShardImbalance();
+  bool const loadAware = options->loadAware;
 
-  moves.reserve(options->maximumNumberOfMoves);
-  p.setPiFactor(options->piFactor);
-  p.optimize(options->leaderChanges, options->moveFollowers,
-             options->moveLeaders, options->maximumNumberOfMoves, moves);
+  // computes the moves for the rebalance plan, and executes them for PUT
+  // requests. shardLoads may be a nullptr, if the load of the shards is
+  // unknown
+  auto planRebalance = [this, options = std::move(*options)](
+                           ShardLoads const* shardLoads) -> FutureVoid {
+    std::vector<MoveShardJob> moves;
 
-  for (auto const& move : moves) {
-    p.applyMoveShardJob(move, false, nullptr, nullptr);
-  }
+    auto p = collectRebalanceInformation(options.databasesExcluded,
+                                         options.excludeSystemCollections,
+                                         shardLoads);
+    auto const imbalanceLeaderBefore = p.computeLeaderImbalance();
+    auto const imbalanceShardsBefore = p.computeShardImbalance();
 
-  auto const imbalanceLeaderAfter = p.computeLeaderImbalance();
-  auto const imbalanceShardsAfter = p.computeShardImbalance();
+    moves.reserve(options.maximumNumberOfMoves);
+    p.setPiFactor(options.piFactor);
+    p.optimize(options.leaderChanges, options.moveFollowers,
+               options.moveLeaders, options.maximumNumberOfMoves, moves);
 
-  auto const buildResponse = [&](rest::ResponseCode responseCode) {
-    {
-      VPackBuilder builder;
+    for (auto const& move : moves) {
+      p.applyMoveShardJob(move, false, nullptr, nullptr);
+    }
+
+    auto const imbalanceLeaderAfter = p.computeLeaderImbalance();
+    auto const imbalanceShardsAfter = p.computeShardImbalance();
+
+    auto const buildResponse = [&](rest::ResponseCode responseCode) {
       {
-        VPackObjectBuilder ob1(&builder);
-        {
-          VPackObjectBuilder ob(&builder, "imbalanceBefore");
-          builder.add(VPackValue("leader"));
-          velocypack::serialize(builder, imbalanceLeaderBefore);
-          builder.add(VPackValue("shards"));
-          velocypack::serialize(builder, imbalanceShardsBefore);
-        }
-        {
-          VPackObjectBuilder ob(&builder, "imbalanceAfter");
-          builder.add(VPackValue("leader"));
-          velocypack::serialize(builder, imbalanceLeaderAfter);
-          builder.add(VPackValue("shards"));
-          velocypack::serialize(builder, imbalanceShardsAfter);
-        }
+        VPackBuilder builder;
         {
-          VPackArrayBuilder ab(&builder, "moves");
-          for (auto const& move : moves) {
-            auto const& shard = p.shards[move.shardId];
-            auto const& collection = p.collections[shard.collectionId];
-            VPackObjectBuilder ob(&builder);
-            builder.add("from", VPackValue(p.dbServers[move.from].id));
-            builder.add("to", VPackValue(p.dbServers[move.to].id));
-            builder.add("shard", VPackValue(shard.name));
-            builder.add("collection", VPackValue(collection.name));
-            builder.add("database",
-                        VPackValue(p.databases[collection.dbId].name));
-            builder.add("isLeader", VPackValue(move.isLeader));
+          VPackObjectBuilder ob1(&builder);
+          {
+            VPackObjectBuilder ob(&builder, "imbalanceBefore");
+            builder.add(VPackValue("leader"));
+            velocypack::serialize(builder, imbalanceLeaderBefore);
+            builder.add(VPackValue("shards"));
+            velocypack::serialize(builder, imbalanceShardsBefore);
+          }
+          {
+            VPackObjectBuilder ob(&builder, "imbalanceAfter");
+            builder.add(VPackValue("leader"));
+            velocypack::serialize(builder, imbalanceLeaderAfter);
+            builder.add(VPackValue("shards"));
+            velocypack::serialize(builder, imbalanceShardsAfter);
+          }
+          {
+            VPackArrayBuilder ab(&builder, "moves");
+            for (auto const& move : moves) {
+              auto const& shard = p.shards[move.shardId];
+              auto const& collection = p.collections[shard.collectionId];
+              VPackObjectBuilder ob(&builder);
+              builder.add("from", VPackValue(p.dbServers[move.from].id));
+              builder.add("to", VPackValue(p.dbServers[move.to].id));
+              builder.add("shard", VPackValue(shard.name));
+              builder.add("collection", VPackValue(collection.name));
+              builder.add("database",
+                          VPackValue(p.databases[collection.dbId].name));
+              builder.add("isLeader", VPackValue(move.isLeader));
+            }
           }
         }
+        generateOk(responseCode, builder.slice());
       }
-      generateOk(responseCode, builder.slice());
-    }
-  };
-  auto& ci = server().getFeature<ClusterFeature>().clusterInfo();
+    };
+    auto& ci = server().getFeature<ClusterFeature>().clusterInfo();
 
-  auto const moveShardConverter = [&](MoveShardJob const& job) {
-    auto& shard = p.shards[job.shardId];
-    auto& col = p.collections[shard.collectionId];
+    auto const moveShardConverter = [&](MoveShardJob const& job) {
+      auto& shard = p.shards[job.shardId];
+      auto& col = p.collections[shard.collectionId];
 
-    return MoveShardDescription{p.databases[col.dbId].name,
-                                col.name,
-                                shard.name,
-                                p.dbServers[job.from].id,
-                                p.dbServers[job.to].id,
-                                job.isLeader};
-  };
+      return MoveShardDescription{p.databases[col.dbId].name,
+                                  col.name,
+                                  shard.name,
+                                  p.dbServers[job.from].id,
+                                  p.dbServers[job.to].id,
+                                  job.isLeader};
+    };
 
-  switch (request()->requestType()) {
-    case rest::RequestType::POST: {
-      buildResponse(rest::ResponseCode::OK);
-      return RestStatus::DONE;
-    }
-    case rest::RequestType::PUT: {
-      buildResponse(rest::ResponseCode::ACCEPTED);
-      return waitForFuture(
-          executeMoveShardOperations(moves, ci, moveShardConverter)
-              .thenValue([&](auto&& result) {
-                if (!result.ok()) {
-                  generateError(result);
-                }
-              }));
+    switch (request()->requestType()) {
+      case rest::RequestType::POST: {
+        buildResponse(rest::ResponseCode::OK);
+        return futures::makeFuture();
+      }
+      case rest::RequestType::PUT: {
+        buildResponse(rest::ResponseCode::ACCEPTED);
+        return executeMoveShardOperations(moves, ci, moveShardConverter)
+            .thenValue([this](auto&& result) {
+              if (!result.ok()) {
+                generateError(result);
+              }
+            });
+      }
+      default:
+        generateError(rest::ResponseCode::METHOD_NOT_ALLOWED,
+                      TRI_ERROR_HTTP_METHOD_NOT_ALLOWED);
+        return futures::makeFuture();
     }
-    default:
-      generateError(rest::ResponseCode::METHOD_NOT_ALLOWED,
-                    TRI_ERROR_HTTP_METHOD_NOT_ALLOWED);
-      return RestStatus::DONE;
+  };
+
+  if (loadAware) {
+    return waitForFuture(fetchShardLoads().thenValue(
+        [planRebalance = std::move(planRebalance)](ShardLoads&& loads) {
+          return planRebalance(&loads);
+        }));
   }
+  return waitForFuture(planRebalance(nullptr));
 }
 
 RestStatus RestAdminClusterHandler::handleRebalance() {
@@ -2713,7 +2821,7 @@ RestStatus RestAdminClusterHandler::handleRebalance() {
 cluster::rebalance::AutoRebalanceProblem
 RestAdminClusterHandler::collectRebalanceInformation(
     std::vector<std::string> const& excludedDatabases,
-    bool excludeSystemCollections) {
+    bool excludeSystemCollections, ShardLoads const* shardLoads) {
   auto& ci = server().getFeature<ClusterFeature>().clusterInfo();
 
   cluster::rebalance::AutoRebalanceProblem p;
@@ -2844,5 +2952,9 @@ RestAdminClusterHandler::collectRebalanceInformation(
     }
   }
 
+  if (shardLoads != nullptr) {
+    p.applyShardLoads(*shardLoads);
+  }
+
   return p;
 }
@@ -31,11 +31,13 @@
 
 #include <cstdint>
 #include <map>
+#include <unordered_map>
 #include <utility>
 
 namespace arangodb {
 namespace cluster::rebalance {
 struct AutoRebalanceProblem;
+struct ShardLoad;
 }
 class RestAdminClusterHandler : public RestVocbaseBaseHandler {
  public:
@@ -66,6 +68,7 @@ class RestAdminClusterHandler : public RestVocbaseBaseHandler {
   static std::string const RebalanceShards;
   static std::string const Rebalance;
   static std::string const ShardStatistics;
+  static std::string const ShardLoad;
 
   RestStatus handleHealth();
   RestStatus handleNumberOfServers();
@@ -93,6 +96,7 @@ class RestAdminClusterHandler : public RestVocbaseBaseHandler {
   RestStatus handleShardDistribution();
   RestStatus handleCollectionShardDistribution();
   RestStatus handleShardStatistics();
+  RestStatus handleShardLoad();
 
   RestStatus handleCleanoutServer();
   RestStatus handleResignLeadership();
@@ -206,9 +210,17 @@ class RestAdminClusterHandler : public RestVocbaseBaseHandler {
  private:
   FutureVoid handlePostRebalanceShards(const ReshardAlgorithm&);
 
+  // shard name => load
+  using ShardLoads =
+      std::unordered_map<std::string, cluster::rebalance::ShardLoad>;
+
+  // shardLoads may be a nullptr, if the load of the shards is unknown
   cluster::rebalance::AutoRebalanceProblem collectRebalanceInformation(
       std::vector<std::string> const& excludedDatabases,
-      bool excludeSystemCollections);
+      bool excludeSystemCollections, ShardLoads const* shardLoads = nullptr);
+
+  // fetches the load of their shards from all DBServers
+  futures::Future<ShardLoads> fetchShardLoads();
 
   struct MoveShardCount {
     std::size_t todo;
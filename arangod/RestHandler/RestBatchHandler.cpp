@@ -45,7 +45,13 @@ using namespace arangodb::rest;
 RestBatchHandler::RestBatchHandler(ArangodServer& server,
                                    GeneralRequest* request,
                                    GeneralResponse* response)
-    : RestVocbaseBaseHandler(server, request, response), _errors(0) {}
+    : RestVocbaseBaseHandler(server, request, response),
+      _errors(0),
+      _nextToExecute(0),
+      _nextToAppend(0),
+      _running(0),
+      _concurrency(1),
+      _failed(false) {}
 
 RestBatchHandler::~RestBatchHandler() = default;
 
@@ -74,16 +80,16 @@ RestStatus RestBatchHandler::executeVst() {
   return RestStatus::DONE;
 }
 
-void RestBatchHandler::processSubHandlerResult(RestHandler const& handler) {
+bool RestBatchHandler::appendPartResponse(Part const& part) {
   HttpResponse* httpResponse = dynamic_cast<HttpResponse*>(_response.get());
 
-  HttpResponse* partResponse = dynamic_cast<HttpResponse*>(handler.response());
+  HttpResponse* partResponse =
+      dynamic_cast<HttpResponse*>(part.handler->response());
 
   if (partResponse == nullptr) {
     generateError(rest::ResponseCode::BAD, TRI_ERROR_INTERNAL,
                   "could not create a response for batch part request");
-    wakeupHandler();
-    return;
+    return false;
   }
 
   rest::ResponseCode const code = partResponse->responseCode();
@@ -98,10 +104,9 @@ void RestBatchHandler::processSubHandlerResult(RestHandler const& handler) {
   httpResponse->body().appendText(StaticStrings::BatchContentType);
 
   // append content-id if it is present
-  if (_helper.contentId != nullptr) {
-    httpResponse->body().appendText(
-        "\r\nContent-Id: " +
-        std::string(_helper.contentId, _helper.contentIdLength));
+  if (!part.contentId.empty()) {
+    httpResponse->body().appendText("\r\nContent-Id: " +
+                                    std::string(part.contentId));
   }
 
   httpResponse->body().appendText(std::string_view("\r\n\r\n"));
@@ -115,28 +120,103 @@ void RestBatchHandler::processSubHandlerResult(RestHandler const& handler) {
   // append the part response body
   httpResponse->body().appendText(partResponse->body());
   httpResponse->body().appendText(std::string_view("\r\n"));
+  return true;
+}
 
-  // we've read the last part
-  if (!_helper.containsMore) {
-    // complete the handler
+void RestBatchHandler::processSubHandlerResult(size_t index) {
+  bool wakeup = false;
+  {
+    std::lock_guard guard(_mutex);
+    TRI_ASSERT(_running > 0);
+    --_running;
+    _parts[index].done = true;
+
+    if (!_failed) {
+      // append the responses of all finished parts, in the order of the
+      // parts in the request
+      while (_nextToAppend < _parts.size() && _parts[_nextToAppend].done) {
+        if (!appendPartResponse(_parts[_nextToAppend])) {
+          _failed = true;
+          break;
+        }
+        _parts[_nextToAppend].handler.reset();
+        ++_nextToAppend;
+      }
 
-    // append final boundary + "--"
-    httpResponse->body().appendText(_boundary + "--");
+      if (_nextToAppend == _parts.size()) {
+        // we've appended the last part. complete the handler
+        HttpResponse* httpResponse =
+            dynamic_cast<HttpResponse*>(_response.get());
 
-    if (_errors > 0) {
-      httpResponse->setHeaderNC(
-          StaticStrings::Errors,
-          StringUtils::itoa(static_cast<uint64_t>(_errors)));
+        // append final boundary + "--"
+        httpResponse->body().appendText(_boundary + "--");
+
+        if (_errors > 0) {
+          httpResponse->setHeaderNC(
+              StaticStrings::Errors,
+              StringUtils::itoa(static_cast<uint64_t>(_errors)));
+        }
+      } else if (!_failed) {
+        _failed = !executeParts();
+      }
     }
+
+    // do not continue while other parts are still executing, as they refer
+    // to this handler
+    wakeup = _running == 0 && (_failed || _nextToAppend == _parts.size());
+  }
+
+  if (wakeup) {
     wakeupHandler();
-  } else {
-    if (!executeNextHandler()) {
-      wakeupHandler();
+  }
+}
+
+bool RestBatchHandler::executeParts() {
+  while (_nextToExecute < _parts.size() && _running < _concurrency) {
+    // a part that modifies data is executed on its own, after all previous
+    // parts have finished and before any later part starts
+    if (_running > 0 && (!_parts[_nextToExecute].readOnly ||
+                         !_parts[_nextToExecute - 1].readOnly)) {
+      break;
     }
+
+    size_t index = _nextToExecute;
+
+    // assume a bad lane, so the request is definitely executed via the queues
+    auto const lane = RequestLane::CLIENT_V8;
+
+    // now schedule the real handler
+    bool ok = SchedulerFeature::SCHEDULER->tryBoundedQueue(
+        lane, [this, self = shared_from_this(), handler = _parts[index].handler,
+               index]() {
+          // start to work for this handler
+          // ignore any errors here, will be handled later by inspecting the
+          // response
+          try {
+            // workaround because of assertions
+            ExecContextScope scope(nullptr);
+            handler->runHandler([this, self, index](RestHandler* /*handler*/) {
+              processSubHandlerResult(index);
+            });
+          } catch (...) {
+            processSubHandlerResult(index);
+          }
+        });
+
+    if (!ok) {
+      generateError(rest::ResponseCode::SERVICE_UNAVAILABLE,
+                    TRI_ERROR_QUEUE_FULL);
+      return false;
+    }
+
+    ++_running;
+    ++_nextToExecute;
   }
+
+  return true;
 }
 
-bool RestBatchHandler::executeNextHandler() {
+bool RestBatchHandler::createNextHandler() {
   // get authorization header. we will inject this into the subparts
   std::string const& authorization =
       _request->header(StaticStrings::Authorization);
@@ -233,31 +313,16 @@ bool RestBatchHandler::executeNextHandler() {
     handler->setIsAsyncRequest();
   }
 
-  // assume a bad lane, so the request is definitely executed via the queues
-  auto const lane = RequestLane::CLIENT_V8;
-
-  // now schedule the real handler
-  bool ok = SchedulerFeature::SCHEDULER->tryBoundedQueue(
-      lane, [this, self = shared_from_this(), handler]() {
-        // start to work for this handler
-        // ignore any errors here, will be handled later by inspecting the
-        // response
-        try {
-          ExecContextScope scope(nullptr);  // workaround because of assertions
-          handler->runHandler([this, self](RestHandler* handler) {
-            processSubHandlerResult(*handler);
-          });
-        } catch (...) {
-          processSubHandlerResult(*handler);
-        }
-      });
-
-  if (!ok) {
-    generateError(rest::ResponseCode::SERVICE_UNAVAILABLE,
-                  TRI_ERROR_QUEUE_FULL);
-    return false;
-  }
-
+  auto const type = handler->request()->requestType();
+  _parts.push_back(Part{
+      .handler = std::move(handler),
+      .contentId = _helper.contentId == nullptr
+                       ? std::string_view()
+                       : std::string_view(_helper.contentId,
+                                          _helper.contentIdLength),
+      .readOnly = type == rest::RequestType::GET ||
+                  type == rest::RequestType::HEAD,
+      .done = false});
   return true;
 }
 
@@ -300,8 +365,27 @@ RestStatus RestBatchHandler::executeHttp() {
   _helper.message = _multipartMessage;
   _helper.searchStart = _multipartMessage.messageStart;
 
+  // create the handlers for all parts first, so that a malformed message is
+  // rejected before any of its parts is executed
+  do {
+    if (!createNextHandler()) {
+      return RestStatus::DONE;
+    }
+  } while (_helper.containsMore);
+
+  std::lock_guard guard(_mutex);
+  _concurrency = std::max<size_t>(
+      server().getFeature<GeneralServerFeature>().batchConcurrency(), 1);
+
+  if (!executeParts()) {
+    _failed = true;
+    if (_running == 0) {
+      return RestStatus::DONE;
+    }
+  }
+
   // and wait for completion
-  return executeNextHandler() ? RestStatus::WAITING : RestStatus::DONE;
+  return RestStatus::WAITING;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -26,6 +26,11 @@
 #include "Basics/Common.h"
 #include "RestHandler/RestVocbaseBaseHandler.h"
 
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
 namespace arangodb {
 
 // container for complete multipart message
@@ -83,12 +88,46 @@ class RestBatchHandler : public RestVocbaseBaseHandler {
   bool extractPart(SearchHelper&);
 
  private:
-  bool executeNextHandler();
-  void processSubHandlerResult(RestHandler const& handler);
+  // a part of the multipart message, and the handler that executes it
+  struct Part {
+    std::shared_ptr<RestHandler> handler;
+    // points into the body of the batch request
+    std::string_view contentId;
+    // whether the part does not modify any data, so that it can be executed
+    // concurrently with other such parts
+    bool readOnly;
+    bool done;
+  };
+
+  // create the handler for the next part of the multipart message
+  bool createNextHandler();
+
+  // start executing further parts, as far as the concurrency limit and the
+  // order of modifying parts allow. must be called with _mutex held
+  bool executeParts();
+
+  void processSubHandlerResult(size_t index);
+
+  // append the response of a finished part to the batch response
+  bool appendPartResponse(Part const& part);
 
   MultipartMessage _multipartMessage;
   SearchHelper _helper;
   size_t _errors;
   std::string _boundary;
+
+  // protects all members below
+  std::mutex _mutex;
+  std::vector<Part> _parts;
+  // index of the next part to execute
+  size_t _nextToExecute;
+  // index of the next part whose response is to be appended
+  size_t _nextToAppend;
+  // number of parts currently executing
+  size_t _running;
+  // maximum number of parts to execute concurrently
+  size_t _concurrency;
+  // whether the batch failed, so that results of parts are ignored
+  bool _failed;
 };
 }  // namespace arangodb
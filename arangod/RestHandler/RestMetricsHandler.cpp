@@ -248,7 +248,7 @@ RestStatus RestMetricsHandler::execute() {
 
   if (!leader) {
     std::string result;
-    metrics.toPrometheus(result, mode);
+    metrics.toPrometheus(result, mode, _request->value("prefix"));
     _response->setResponseCode(rest::ResponseCode::OK);
     _response->setContentType(rest::ContentType::TEXT);
     _response->addRawPayload(result);
@@ -147,6 +147,21 @@ void RestQueryHandler::readQuery(bool slow) {
   }
 }
 
+void RestQueryHandler::readQueryStatistics() {
+  // the statistics are not fanned out to other coordinators. every
+  // coordinator reports the queries it has executed itself
+  auto queryList = _vocbase.queryList();
+
+  VPackBuilder result;
+  result.openObject();
+  result.add("enabled", VPackValue(queryList->trackStatistics()));
+  result.add(VPackValue("queries"));
+  queryList->statisticsToVelocyPack(result, _vocbase.name());
+  result.close();
+
+  generateResult(rest::ResponseCode::OK, result.slice());
+}
+
 /// @brief returns AQL query tracking
 void RestQueryHandler::readQuery() {
   auto const& suffixes = _request->suffixes();
@@ -165,10 +180,13 @@ void RestQueryHandler::readQuery() {
     readQuery(false);
   } else if (name == "properties") {
     readQueryProperties();
+  } else if (name == "statistics") {
+    readQueryStatistics();
   } else {
     generateError(rest::ResponseCode::NOT_FOUND, TRI_ERROR_HTTP_NOT_FOUND,
                   "unknown type '" + name +
-                      "', expecting 'slow', 'current', or 'properties'");
+                      "', expecting 'slow', 'current', 'properties', or "
+                      "'statistics'");
   }
 }
 
@@ -186,6 +204,11 @@ void RestQueryHandler::deleteQuerySlow() {
   }
 }
 
+void RestQueryHandler::deleteQueryStatistics() {
+  _vocbase.queryList()->clearStatistics();
+  generateOk(rest::ResponseCode::OK, velocypack::Slice::noneSlice());
+}
+
 void RestQueryHandler::killQuery(std::string const& id) {
   bool const allDatabases = _request->parsedValue("all", false);
   Result res =
@@ -204,7 +227,8 @@ void RestQueryHandler::deleteQuery() {
 
   if (suffixes.size() != 1) {
     generateError(rest::ResponseCode::BAD, TRI_ERROR_HTTP_BAD_PARAMETER,
-                  "expecting DELETE /_api/query/<id> or /_api/query/slow");
+                  "expecting DELETE /_api/query/<id>, /_api/query/slow or "
+                  "/_api/query/statistics");
     return;
   }
 
@@ -212,6 +236,8 @@ void RestQueryHandler::deleteQuery() {
 
   if (id == "slow") {
     deleteQuerySlow();
+  } else if (id == "statistics") {
+    deleteQueryStatistics();
   } else {
     killQuery(id);
   }
@@ -372,7 +398,7 @@ ResultT<std::pair<std::string, bool>> RestQueryHandler::forwardingTarget() {
     auto const& suffixes = _request->suffixes();
     TRI_ASSERT(suffixes.size() >= 1);
     auto const& id = suffixes[0];
-    if (id != "slow") {
+    if (id != "slow" && id != "statistics") {
       uint64_t tick = basics::StringUtils::uint64(id);
       uint32_t sourceServer = TRI_ExtractServerIdFromTick(tick);
       if (sourceServer != ServerState::instance()->getShortId()) {
@@ -51,9 +51,15 @@ class RestQueryHandler : public RestVocbaseBaseHandler {
   /// @brief returns AQL query tracking
   void readQuery();
 
+  /// @brief returns the aggregated statistics per query string
+  void readQueryStatistics();
+
   /// @brief removes the slow log
   void deleteQuerySlow();
 
+  /// @brief removes the aggregated statistics per query string
+  void deleteQueryStatistics();
+
   /// @brief interrupts a query
   void deleteQuery();
 
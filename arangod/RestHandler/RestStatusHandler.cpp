@@ -44,9 +44,12 @@
 #include "Cluster/AgencyCache.h"
 #include "Cluster/ClusterFeature.h"
 #include "Cluster/ServerState.h"
+#include "CrashHandler/CpuProfiler.h"
 #include "GeneralServer/ServerSecurityFeature.h"
 #include "Rest/Version.h"
 #include "RestServer/ServerFeature.h"
+#include "Scheduler/Scheduler.h"
+#include "Scheduler/SchedulerFeature.h"
 #include "StorageEngine/StorageEngine.h"
 #include "StorageEngine/EngineSelectorFeature.h"
 
@@ -77,6 +80,8 @@ RestStatus RestStatusHandler::execute() {
     return executeOverview();
   } else if (_request->parsedValue("memory", false)) {
     return executeMemoryProfile();
+  } else if (_request->parsedValue("cpu", false)) {
+    return executeCpuProfile();
   } else {
     return executeStandard(security);
   }
@@ -354,3 +359,56 @@ RestStatus RestStatusHandler::executeMemoryProfile() {
 
   return RestStatus::DONE;
 }
+
+RestStatus RestStatusHandler::executeCpuProfile() {
+  // sampling duration in seconds
+  double const duration = _request->parsedValue("duration", 10.0);
+  // samples per second of CPU time
+  uint64_t const frequency = _request->parsedValue<uint64_t>("frequency", 99);
+
+  if (duration <= 0.0 || duration > 60.0) {
+    generateError(rest::ResponseCode::BAD, TRI_ERROR_BAD_PARAMETER,
+                  "invalid value for 'duration', expecting a value between "
+                  "0 and 60 seconds");
+    return RestStatus::DONE;
+  }
+  if (frequency == 0 || frequency > 1000) {
+    generateError(rest::ResponseCode::BAD, TRI_ERROR_BAD_PARAMETER,
+                  "invalid value for 'frequency', expecting a value between "
+                  "1 and 1000");
+    return RestStatus::DONE;
+  }
+
+  auto res = CpuProfiler::start(static_cast<uint32_t>(frequency));
+
+  if (res == TRI_ERROR_NOT_IMPLEMENTED) {
+    generateError(rest::ResponseCode::NOT_IMPLEMENTED, res,
+                  "CPU profiles are not supported on this platform");
+    return RestStatus::DONE;
+  } else if (res == TRI_ERROR_LOCKED) {
+    generateError(rest::ResponseCode::CONFLICT, res,
+                  "a CPU profile is already being taken");
+    return RestStatus::DONE;
+  } else if (res != TRI_ERROR_NO_ERROR) {
+    generateError(rest::ResponseCode::SERVER_ERROR, res);
+    return RestStatus::DONE;
+  }
+
+  // do not block a scheduler thread while sampling. instead, suspend the
+  // handler and continue when the sampling duration has passed
+  auto delay = std::chrono::duration_cast<Scheduler::clock::duration>(
+      std::chrono::duration<double>(duration));
+  return waitForFuture(
+      SchedulerFeature::SCHEDULER->delay("cpu-profile", delay)
+          .then([this](futures::Try<futures::Unit>&& result) {
+            // always stop sampling, even if the delay was cancelled
+            std::string content;
+            CpuProfiler::stop(content);
+            result.throwIfFailed();
+
+            resetResponse(rest::ResponseCode::OK);
+
+            _response->setContentType(rest::ContentType::TEXT);
+            _response->addRawPayload(content);
+          }));
+}
@@ -41,5 +41,6 @@ class RestStatusHandler : public arangodb::RestBaseHandler {
   RestStatus executeStandard(ServerSecurityFeature&);
   RestStatus executeOverview();
   RestStatus executeMemoryProfile();
+  RestStatus executeCpuProfile();
 };
 }  // namespace arangodb
@@ -26,6 +26,7 @@
 
 #include "ApplicationFeatures/ApplicationServer.h"
 #include "Aql/QueryCache.h"
+#include "Aql/QueryPlanCache.h"
 #include "Aql/QueryList.h"
 #include "Aql/QueryRegistry.h"
 #include "Basics/ArangoGlobalContext.h"
@@ -64,6 +65,7 @@
 #include "Utils/Events.h"
 #include "V8Server/V8DealerFeature.h"
 #include "VocBase/LogicalCollection.h"
+#include "VocBase/Methods/AqlUserFunctions.h"
 #include "VocBase/ticks.h"
 #include "VocBase/vocbase.h"
 
@@ -482,10 +484,12 @@ void DatabaseFeature::stop() {
       .maxResultsSize = 0,
       .maxEntrySize = 0,
       .includeSystem = false,
+      .incremental = false,
       .showBindVars = false,
   };
   aql::QueryCache::instance()->properties(p);
   aql::QueryCache::instance()->invalidate();
+  aql::QueryPlanCache::instance()->invalidate();
 
   StorageEngine& engine = server().getFeature<EngineSelectorFeature>().engine();
   engine.cleanupReplicationContexts();
@@ -549,6 +553,7 @@ void DatabaseFeature::stop() {
 
   // flush again so we are sure no query is left in the cache here
   aql::QueryCache::instance()->invalidate();
+  aql::QueryPlanCache::instance()->invalidate();
 }
 
 void DatabaseFeature::unprepare() {
@@ -826,6 +831,8 @@ ErrorCode DatabaseFeature::dropDatabase(std::string_view name) {
 
     // invalidate all entries for the database
     aql::QueryCache::instance()->invalidate(vocbase);
+    aql::QueryPlanCache::instance()->invalidate(vocbase);
+    invalidateNativeUserFunctions(*vocbase);
 
     if (server().hasFeature<iresearch::IResearchAnalyzerFeature>()) {
       server().getFeature<iresearch::IResearchAnalyzerFeature>().invalidate(
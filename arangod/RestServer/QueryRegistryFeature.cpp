@@ -173,6 +173,7 @@ QueryRegistryFeature::QueryRegistryFeature(Server& server)
       _failOnWarning(aql::QueryOptions::defaultFailOnWarning),
       _requireWith(false),
       _queryCacheIncludeSystem(false),
+      _queryCacheIncremental(false),
       _queryMemoryLimitOverride(true),
 #ifdef USE_ENTERPRISE
       _smartJoins(true),
@@ -181,6 +182,7 @@ QueryRegistryFeature::QueryRegistryFeature(Server& server)
       _allowCollectionsInExpressions(false),
       _logFailedQueries(false),
       _maxQueryStringLength(4096),
+      _maxQueryStatistics(0),
       _maxCollectionsPerQuery(2048),
       _peakMemoryUsageThreshold(1073741824),  // 1GB
       _queryGlobalMemoryLimit(
@@ -195,6 +197,7 @@ QueryRegistryFeature::QueryRegistryFeature(Server& server)
       _queryCacheMaxResultsSize(0),
       _queryCacheMaxEntrySize(0),
       _maxParallelism(4),
+      _parallelismCpuTimeThreshold(0.0),
       _slowQueryThreshold(10.0),
       _slowStreamingQueryThreshold(10.0),
       _queryRegistryTTL(0.0),
@@ -230,6 +233,7 @@ QueryRegistryFeature::QueryRegistryFeature(Server& server)
   _queryCacheMaxResultsSize = properties.maxResultsSize;
   _queryCacheMaxEntrySize = properties.maxEntrySize;
   _queryCacheIncludeSystem = properties.includeSystem;
+  _queryCacheIncremental = properties.incremental;
 }
 
 void QueryRegistryFeature::collectOptions(
@@ -402,6 +406,28 @@ option to `false`.)");
                   new BooleanParameter(&_trackDataSources))
       .setIntroducedIn(30704);
 
+  options
+      ->addOption("--query.tracking-statistics-size",
+                  "The maximum number of distinct query strings per database "
+                  "to aggregate execution statistics for (0 = disabled).",
+                  new SizeTParameter(&_maxQueryStatistics),
+                  arangodb::options::makeFlags(
+                      arangodb::options::Flags::DefaultNoComponents,
+                      arangodb::options::Flags::OnCoordinator,
+                      arangodb::options::Flags::OnSingle))
+      .setIntroducedIn(31200)
+      .setLongDescription(R"(If set to a value greater than zero, the number
+of executions, the total and maximum run time and the peak memory usage of all
+AQL queries are aggregated per query string and database. Executions that only
+differ in their bind parameter values are aggregated into the same entry.
+The statistics can be retrieved via the `GET /_api/query/statistics` endpoint,
+and cleared via `DELETE /_api/query/statistics`.
+
+Once the statistics of a database contain the configured number of distinct
+query strings, executions of other query strings are not aggregated anymore.
+This option only has an effect if `--query.tracking` and
+`--query.tracking-with-querystring` are set to `true`.)");
+
   options
       ->addOption("--query.fail-on-warning",
                   "Whether AQL queries should fail with errors even for "
@@ -514,6 +540,25 @@ their size does not exceed this setting's value.)");
 if you use the query results cache, as queries on system collections are
 internal to ArangoDB and use space in the query results cache unnecessarily.)");
 
+  options
+      ->addOption("--query.cache-incremental",
+                  "Whether to update the query results cache with the "
+                  "changes of transactions instead of invalidating it.",
+                  new BooleanParameter(&_queryCacheIncremental))
+      .setIntroducedIn(31200)
+      .setLongDescription(R"(If enabled, committing a transaction that modifies
+a collection patches the cached results of simple queries on the collection
+instead of removing them from the query results cache. This applies to queries
+of the form `FOR doc IN collection FILTER ... RETURN ...` that only compare
+document attributes with constant values in their filter conditions, and that
+return the document, one of its attributes, or an object made of its
+attributes. The results of other queries are still invalidated, as are all
+results if a transaction modifies more than 1024 documents of a collection.
+
+Updated results contain new matching documents at their end, so this option
+should only be enabled if applications do not rely on the order of results of
+such queries, which is unspecified without a `SORT` operation anyway.)");
+
   options
       ->addOption(
           "--query.optimizer-max-plans",
@@ -586,6 +631,33 @@ The value can still be adjusted on a per-query basis by setting the
       .setIntroducedIn(30701);
 #endif
 
+  options
+      ->addOption("--query.parallelism-cpu-time-threshold",
+                  "The CPU time (in seconds) a query can use on a server "
+                  "before it stops executing parts of it in parallel "
+                  "(0 = no limit).",
+                  new DoubleParameter(&_parallelismCpuTimeThreshold),
+                  arangodb::options::makeFlags(
+                      arangodb::options::Flags::DefaultNoComponents,
+                      arangodb::options::Flags::OnCoordinator,
+                      arangodb::options::Flags::OnDBServer,
+                      arangodb::options::Flags::OnSingle,
+                      arangodb::options::Flags::Uncommon))
+      .setIntroducedIn(31200)
+      .setLongDescription(R"(Parts of AQL queries, for example the scans of
+large collections, can be executed by several threads in parallel. A single
+large query can thereby occupy many scheduler threads, so that other queries
+have to wait for a free thread.
+
+If this option is set to a value greater than zero, the CPU time that each
+query spends executing on a server is tracked. Once a query has used more CPU
+time than configured on a server, it no longer starts parallel tasks there, and
+executes the remaining work in the thread that runs the query. This leaves more
+threads to other, smaller queries.
+
+The CPU time used by a query is reported as `cpuTime` in the query statistics
+regardless of this option.)");
+
   options
       ->addOption("--query.allow-collections-in-expressions",
                   "Allow full collections to be used in AQL expressions.",
@@ -689,10 +761,11 @@ logical branches (AND, OR, NOT) can take a large amount of processing time and
 memory. This startup option limits the computation time and memory usage for
 such conditions.
 
-Once the threshold value is reached during the DNF conversion of a FILTER
-condition, the conversion is aborted, and the query continues with a simplified
-internal representation of the condition, which cannot be used for index
-lookups.)");
+The threshold is checked before each expansion step of the DNF conversion. If
+expanding an OR that is combined with other conditions via AND would reach the
+threshold, the OR is not expanded but kept as a residual filter condition. The
+residual condition cannot be used for index lookups, but the other parts of
+the FILTER condition still can.)");
 
   options
       ->addOption(
@@ -724,6 +797,7 @@ void QueryRegistryFeature::validateOptions(
   _maxParallelism =
       std::clamp(_maxParallelism, static_cast<uint64_t>(1),
                  static_cast<uint64_t>(NumberOfCores::getValue()));
+  _parallelismCpuTimeThreshold = std::max(_parallelismCpuTimeThreshold, 0.0);
 
   if (_queryRegistryTTL <= 0) {
     TRI_ASSERT(ServerState::instance()->getRole() !=
@@ -779,6 +853,7 @@ void QueryRegistryFeature::prepare() {
       _queryCacheMaxResultsSize,
       _queryCacheMaxEntrySize,
       _queryCacheIncludeSystem,
+      _queryCacheIncremental,
       _trackBindVars};
   arangodb::aql::QueryCache::instance()->properties(properties);
   // create the query registry
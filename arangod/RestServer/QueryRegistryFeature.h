@@ -66,6 +66,7 @@ class QueryRegistryFeature final : public ArangodFeature {
     return _slowStreamingQueryThreshold;
   }
   size_t maxQueryStringLength() const noexcept { return _maxQueryStringLength; }
+  size_t maxQueryStatistics() const noexcept { return _maxQueryStatistics; }
   uint64_t peakMemoryUsageThreshold() const noexcept {
     return _peakMemoryUsageThreshold;
   }
@@ -92,6 +93,9 @@ class QueryRegistryFeature final : public ArangodFeature {
     return _queryRegistry.get();
   }
   uint64_t maxParallelism() const noexcept { return _maxParallelism; }
+  double parallelismCpuTimeThreshold() const noexcept {
+    return _parallelismCpuTimeThreshold;
+  }
 
  private:
   bool _trackingEnabled;
@@ -102,6 +106,7 @@ class QueryRegistryFeature final : public ArangodFeature {
   bool _failOnWarning;
   bool _requireWith;
   bool _queryCacheIncludeSystem;
+  bool _queryCacheIncremental;
   bool _queryMemoryLimitOverride;
 #ifdef USE_ENTERPRISE
   bool _smartJoins;
@@ -110,6 +115,7 @@ class QueryRegistryFeature final : public ArangodFeature {
   bool _allowCollectionsInExpressions;
   bool _logFailedQueries;
   size_t _maxQueryStringLength;
+  size_t _maxQueryStatistics;
   size_t _maxCollectionsPerQuery;
   uint64_t _peakMemoryUsageThreshold;
   uint64_t _queryGlobalMemoryLimit;
@@ -122,6 +128,7 @@ class QueryRegistryFeature final : public ArangodFeature {
   uint64_t _queryCacheMaxResultsSize;
   uint64_t _queryCacheMaxEntrySize;
   uint64_t _maxParallelism;
+  double _parallelismCpuTimeThreshold;
   double _slowQueryThreshold;
   double _slowStreamingQueryThreshold;
   double _queryRegistryTTL;
@@ -238,6 +238,8 @@ void TemporaryStorageFeature::validateOptions(
   }
 
   _basePath = ourPath;
+  _asyncJobResultsPath =
+      basics::FileUtils::buildFilename(_basePath, "async-jobs");
   // configure defaults for query options
   aql::QueryOptions::defaultSpillOverThresholdNumRows =
       _spillOverThresholdNumRows;
@@ -284,6 +286,21 @@ void TemporaryStorageFeature::start() {
     return;
   }
 
+  {
+    std::string systemErrorStr;
+    long errorNo;
+
+    auto res = TRI_CreateRecursiveDirectory(_asyncJobResultsPath.c_str(),
+                                            errorNo, systemErrorStr);
+
+    if (res != TRI_ERROR_NO_ERROR) {
+      LOG_TOPIC("5e1c2", FATAL, Logger::FIXME)
+          << "cannot create directory for async job results ('"
+          << _asyncJobResultsPath << "'): " << systemErrorStr;
+      FATAL_ERROR_EXIT();
+    }
+  }
+
   _usageTracker = std::make_unique<StorageUsageTracker>(_maxDiskCapacity);
 
   auto backend = std::make_unique<RocksDBTempStorage>(
@@ -24,6 +24,8 @@
 #pragma once
 
 #include "ApplicationFeatures/ApplicationFeature.h"
+#include "Basics/Common.h"
+#include "RocksDBEngine/HashedCollectSpillBackendRocksDB.h"
 #include "RocksDBEngine/SortedRowsStorageBackendRocksDB.h"
 #include "RestServer/arangod.h"
 
@@ -85,7 +87,19 @@ class TemporaryStorageFeature : public ArangodFeature {
   void stop() override final;
   void unprepare() override final;
 
-  bool canBeUsed() const noexcept;
+  TEST_VIRTUAL bool canBeUsed() const noexcept;
+
+  // returns the tracker for the disk usage of intermediate results. returns
+  // a nullptr if the feature is not used or not started
+  TEST_VIRTUAL StorageUsageTracker* usageTracker() const noexcept {
+    return _usageTracker.get();
+  }
+
+  // returns the directory for spilled results of async jobs. the directory
+  // exists only while the feature is started
+  TEST_VIRTUAL std::string const& asyncJobResultsPath() const noexcept {
+    return _asyncJobResultsPath;
+  }
 
   template<typename... Args>
   std::unique_ptr<aql::SortedRowsStorageBackend> getSortedRowsStorage(
@@ -94,6 +108,11 @@ class TemporaryStorageFeature : public ArangodFeature {
         *_backend, std::forward<Args>(args)...);
   }
 
+  TEST_VIRTUAL std::unique_ptr<aql::HashedCollectSpillBackend>
+  getHashedCollectSpillBackend() {
+    return std::make_unique<HashedCollectSpillBackendRocksDB>(*_backend);
+  }
+
  private:
   void cleanupDirectory();
 
@@ -106,6 +125,9 @@ class TemporaryStorageFeature : public ArangodFeature {
   size_t _spillOverThresholdNumRows;
   size_t _spillOverThresholdMemoryUsage;
 
+  // subdirectory of _basePath for spilled async job results
+  std::string _asyncJobResultsPath;
+
   // populated only if !_path.empty()
   std::unique_ptr<RocksDBTempStorage> _backend;
   // populated only if !_path.empty()
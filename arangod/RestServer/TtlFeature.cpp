@@ -38,18 +38,27 @@
 #include "Logger/LogMacros.h"
 #include "Logger/Logger.h"
 #include "Logger/LoggerStream.h"
+#include "Metrics/GaugeBuilder.h"
+#include "Metrics/MetricsFeature.h"
 #include "ProgramOptions/Parameters.h"
 #include "ProgramOptions/ProgramOptions.h"
 #include "RestServer/DatabaseFeature.h"
 #include "Transaction/StandaloneContext.h"
+#include "Utils/DatabaseGuard.h"
 #include "VocBase/LogicalCollection.h"
 #include "VocBase/vocbase.h"
 
 #include <velocypack/Builder.h>
 #include <velocypack/Slice.h>
 
+#include <algorithm>
 #include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <thread>
+#include <vector>
 
 using namespace arangodb;
 using namespace arangodb::options;
@@ -61,8 +70,18 @@ std::string const removeQuery(
     "indexHint: @indexHint } FILTER doc.@indexAttribute >= 0 && "
     "doc.@indexAttribute <= @stamp SORT doc.@indexAttribute LIMIT @limit "
     "REMOVE doc IN @@collection OPTIONS { ignoreErrors: true }");
+
+// the AQL query to find the oldest expired document
+std::string const oldestQuery(
+    "/*ttl lag*/ FOR doc IN @@collection OPTIONS { forceIndexHint: true, "
+    "indexHint: @indexHint } FILTER doc.@indexAttribute >= 0 && "
+    "doc.@indexAttribute <= @stamp SORT doc.@indexAttribute LIMIT @limit "
+    "RETURN doc.@indexAttribute");
 }  // namespace
 
+DECLARE_GAUGE(arangodb_ttl_expiry_lag, double,
+              "Age of the oldest expired document not yet removed");
+
 namespace arangodb {
 
 TtlStatistics& TtlStatistics::operator+=(VPackSlice const& other) {
@@ -157,12 +176,36 @@ Result TtlProperties::fromVelocyPack(VPackSlice const& slice) {
   }
 }
 
+/// @brief helper thread that removes expired documents together with the
+/// TTL thread, for the duration of a single run
+class TtlWorkerThread final : public ServerThread<ArangodServer> {
+ public:
+  TtlWorkerThread(ArangodServer& server, std::function<void()> work)
+      : ServerThread<ArangodServer>(server, "TTLWorker"),
+        _work(std::move(work)) {}
+
+  ~TtlWorkerThread() final { shutdown(); }
+
+ protected:
+  void run() final { _work(); }
+
+ private:
+  std::function<void()> const _work;
+};
+
 class TtlThread final : public ServerThread<ArangodServer> {
  public:
-  explicit TtlThread(ArangodServer& server, TtlFeature& ttlFeature)
+  explicit TtlThread(ArangodServer& server, TtlFeature& ttlFeature,
+                     std::size_t numThreads, uint64_t maxRemovesPerSecond,
+                     metrics::Gauge<double>& expiryLag)
       : ServerThread<ArangodServer>(server, "TTL"),
         _ttlFeature(ttlFeature),
-        _working(false) {}
+        _numThreads(numThreads),
+        _maxRemovesPerSecond(maxRemovesPerSecond),
+        _expiryLag(expiryLag),
+        _working(false) {
+    TRI_ASSERT(_numThreads > 0);
+  }
 
   ~TtlThread() final { shutdown(); }
 
@@ -189,6 +232,29 @@ class TtlThread final : public ServerThread<ArangodServer> {
   }
 
  private:
+  /// @brief a collection with a TTL index
+  struct WorkItem {
+    TRI_vocbase_t& vocbase;
+    std::shared_ptr<LogicalCollection> collection;
+    std::shared_ptr<Index> index;
+    double expireAfter;
+  };
+
+  /// @brief state of a single run, shared by all threads of the run
+  struct RunState {
+    RunState(double stamp, TtlProperties const& properties)
+        : stamp(stamp),
+          properties(properties),
+          limitLeft(properties.maxTotalRemoves) {}
+
+    double const stamp;
+    TtlProperties const properties;
+    /// @brief number of documents that may still be removed in this run
+    std::atomic<uint64_t> limitLeft;
+    /// @brief set once limitLeft has been used up
+    std::atomic<bool> limitReached{false};
+  };
+
   void run() final {
     TtlProperties properties = _ttlFeature.properties();
     setNextStart(properties.frequency);
@@ -198,7 +264,8 @@ class TtlThread final : public ServerThread<ArangodServer> {
         << properties.frequency
         << " milliseconds, max removals per run: " << properties.maxTotalRemoves
         << ", max removals per collection per run "
-        << properties.maxCollectionRemoves;
+        << properties.maxCollectionRemoves << ", threads: " << _numThreads
+        << ", max removals per second: " << _maxRemovesPerSecond;
 
     while (true) {
       while (true) {
@@ -257,16 +324,96 @@ class TtlThread final : public ServerThread<ArangodServer> {
 
     stats.runs++;
 
-    double const stamp = TRI_microtime();
-    uint64_t limitLeft = properties.maxTotalRemoves;
+    RunState state(TRI_microtime(), properties);
+
+    // keeps the databases of all work items in use until the run is over
+    std::vector<VocbasePtr> databases;
+    std::vector<WorkItem> items;
+    if (!collectWork(databases, items)) {
+      return;
+    }
+
+    // collections are independent of each other, so their expired
+    // documents can be removed concurrently
+    std::atomic<std::size_t> next{0};
+    std::mutex resultMutex;
+    // age (in seconds) of the oldest expired document that is still present
+    double lag = 0.0;
+
+    auto removeAll = [&]() noexcept {
+      TtlStatistics localStats;
+      double localLag = 0.0;
+      while (!state.limitReached.load(std::memory_order_relaxed)) {
+        std::size_t i = next.fetch_add(1, std::memory_order_relaxed);
+        if (i >= items.size()) {
+          break;
+        }
+        if (!isActive()) {
+          // feature deactivated (for example, due to running on current
+          // follower in active failover setup), or server shutdown
+          break;
+        }
+        try {
+          localLag = std::max(localLag,
+                              removeExpired(items[i], state, localStats));
+        } catch (std::exception const& ex) {
+          LOG_TOPIC("7a1c4", WARN, Logger::TTL)
+              << "caught exception during TTL document removal for "
+                 "collection '"
+              << items[i].collection->name() << "': " << ex.what();
+        } catch (...) {
+          LOG_TOPIC("b3e91", WARN, Logger::TTL)
+              << "caught unknown exception during TTL document removal for "
+                 "collection '"
+              << items[i].collection->name() << "'";
+        }
+      }
+      std::lock_guard guard{resultMutex};
+      stats += localStats;
+      lag = std::max(lag, localLag);
+    };
+
+    std::size_t numThreads = std::min(_numThreads, items.size());
+    std::vector<std::unique_ptr<TtlWorkerThread>> workers;
+    // destroying a worker waits until it has finished. workers that have
+    // not even begun when the current thread is done do not run at all
+    auto joinWorkers = scopeGuard([&]() noexcept { workers.clear(); });
+    try {
+      // the current thread is one of the removing threads
+      workers.reserve(numThreads - 1);
+      for (std::size_t i = 1; i < numThreads; ++i) {
+        auto worker = std::make_unique<TtlWorkerThread>(server(), removeAll);
+        if (!worker->start()) {
+          break;
+        }
+        workers.emplace_back(std::move(worker));
+      }
+    } catch (...) {
+      // we could not start all threads. the ones that were started and the
+      // current thread process all collections
+    }
+    removeAll();
+    joinWorkers.fire();
+
+    if (state.limitReached.load()) {
+      // removed as much as we are allowed to. remove more in next iteration
+      ++stats.limitReached;
+    }
+    if (isActive()) {
+      _expiryLag = lag;
+    }
+  }
 
-    // iterate over all databases
+  /// @brief determines the collections with TTL indexes of all databases.
+  /// returns false if the thread should stop working
+  bool collectWork(std::vector<VocbasePtr>& databases,
+                   std::vector<WorkItem>& items) {
     auto& db = server().getFeature<DatabaseFeature>();
     for (auto const& name : db.getDatabaseNames()) {
       if (!isActive()) {
         // feature deactivated (for example, due to running on current follower
         // in active failover setup)
-        return;
+        return false;
       }
 
       auto vocbase = db.useDatabase(name);
@@ -282,12 +429,6 @@ class TtlThread final : public ServerThread<ArangodServer> {
           vocbase->collections(false);
 
       for (auto const& collection : collections) {
-        if (!isActive()) {
-          // feature deactivated (for example, due to running on current
-          // follower in active failover setup)
-          return;
-        }
-
         if (ServerState::instance()->isDBServer() &&
             !collection->followers()->getLeader().empty()) {
           // we are a follower for this shard. do not remove any data here, but
@@ -308,108 +449,247 @@ class TtlThread final : public ServerThread<ArangodServer> {
           _builder.clear();
           index->toVelocyPack(_builder, Index::makeFlags());
           VPackSlice ea = _builder.slice().get(StaticStrings::IndexExpireAfter);
-          if (!ea.isNumber()) {
-            // index description somehow invalid
-            continue;
-          }
-
-          double expireAfter = ea.getNumericValue<double>();
-          LOG_TOPIC("5cca5", DEBUG, Logger::TTL)
-              << "TTL thread going to work for collection '"
-              << collection->name()
-              << "', expireAfter: " << Logger::FIXED(expireAfter, 0)
-              << ", stamp: " << (stamp - expireAfter) << ", limit: "
-              << std::min(properties.maxCollectionRemoves, limitLeft);
-
-          auto bindVars = std::make_shared<VPackBuilder>();
-          bindVars->openObject();
-          bindVars->add("indexHint", VPackValue(index->name()));
-          bindVars->add("@collection", VPackValue(collection->name()));
-          bindVars->add(VPackValue("indexAttribute"));
-          bindVars->openArray();
-          for (auto const& it : index->fields()[0]) {
-            bindVars->add(VPackValue(it.name));
-          }
-          bindVars->close();
-          bindVars->add("stamp", VPackValue(stamp - expireAfter));
-          bindVars->add(
-              "limit",
-              VPackValue(std::min(properties.maxCollectionRemoves, limitLeft)));
-          bindVars->close();
-
-          auto query = aql::Query::create(
-              transaction::StandaloneContext::Create(*vocbase),
-              aql::QueryString(::removeQuery), std::move(bindVars));
-          query->collections().add(collection->name(), AccessMode::Type::WRITE,
-                                   aql::Collection::Hint::Shard);
-          aql::QueryResult queryResult = query->executeSync();
-
-          if (queryResult.result.fail()) {
-            // we can probably live with an error here...
-            // the thread will try to remove the documents again on next
-            // iteration
-            if (!queryResult.result.is(TRI_ERROR_ARANGO_READ_ONLY) &&
-                !queryResult.result.is(TRI_ERROR_ARANGO_CONFLICT) &&
-                !queryResult.result.is(TRI_ERROR_LOCKED) &&
-                !queryResult.result.is(
-                    TRI_ERROR_ARANGO_DATA_SOURCE_NOT_FOUND)) {
-              LOG_TOPIC("08300", WARN, Logger::TTL)
-                  << "error during TTL document removal for collection '"
-                  << collection->name()
-                  << "': " << queryResult.result.errorMessage();
-            }
-          } else {
-            auto extra = queryResult.extra;
-            if (extra != nullptr) {
-              VPackSlice v = extra->slice().get("stats");
-              if (v.isObject()) {
-                v = v.get("writesExecuted");
-                if (v.isNumber()) {
-                  uint64_t removed = v.getNumericValue<uint64_t>();
-                  stats.documentsRemoved += removed;
-                  if (removed > 0) {
-                    LOG_TOPIC("2455e", DEBUG, Logger::TTL)
-                        << "TTL thread removed " << removed
-                        << " documents for collection '" << collection->name()
-                        << "'";
-                    if (limitLeft >= removed) {
-                      limitLeft -= removed;
-                    } else {
-                      limitLeft = 0;
-                    }
-                  }
-                }
-              }
-            }
+          if (ea.isNumber()) {
+            items.push_back(WorkItem{*vocbase, collection, index,
+                                     ea.getNumericValue<double>()});
           }
 
           // there can only be one TTL index per collection, so we can abort the
           // loop here
           break;
         }
+      }
 
-        if (limitLeft == 0) {
-          // removed as much as we are allowed to. now stop and remove more in
-          // next iteration
-          ++stats.limitReached;
-          return;
-        }
+      databases.emplace_back(std::move(vocbase));
+    }
+    return true;
+  }
 
-        if (isStopping()) {
-          // server has been stopped, so abort our loop(s)
-          return;
+  /// @brief removes the expired documents of one collection, in batches in
+  /// the order of the TTL index. returns the age (in seconds) of the oldest
+  /// expired document left in the collection, or 0 if there is none (or it
+  /// is unknown)
+  double removeExpired(WorkItem const& item, RunState& state,
+                       TtlStatistics& stats) {
+    double const maxStamp = state.stamp - item.expireAfter;
+    uint64_t collectionLeft = state.properties.maxCollectionRemoves;
+    // with a rate limit, smaller batches let the threads take turns
+    uint64_t batchSize = collectionLeft;
+    if (_maxRemovesPerSecond > 0) {
+      batchSize = std::min(
+          batchSize, std::max<uint64_t>(_maxRemovesPerSecond / _numThreads, 1));
+    }
+
+    LOG_TOPIC("5cca5", DEBUG, Logger::TTL)
+        << "TTL thread going to work for collection '"
+        << item.collection->name()
+        << "', expireAfter: " << Logger::FIXED(item.expireAfter, 0)
+        << ", stamp: " << maxStamp << ", limit: "
+        << std::min(collectionLeft,
+                    state.limitLeft.load(std::memory_order_relaxed));
+
+    // whether there can be more expired documents in the collection
+    bool more = true;
+    while (more && collectionLeft > 0) {
+      uint64_t limit =
+          reserve(state.limitLeft, std::min(collectionLeft, batchSize));
+      if (limit == 0) {
+        state.limitReached.store(true, std::memory_order_relaxed);
+        break;
+      }
+      bool const allowed = waitForRateLimit();
+      std::optional<uint64_t> removed;
+      if (allowed) {
+        removed = removeBatch(item, maxStamp, limit);
+      }
+      uint64_t const numRemoved = removed.value_or(0);
+      // give back what we did not use
+      state.limitLeft.fetch_add(limit - std::min(limit, numRemoved),
+                                std::memory_order_relaxed);
+      if (!removed.has_value()) {
+        // stopped working, or the removal failed. the thread will try to
+        // remove the documents again on next iteration
+        return 0.0;
+      }
+
+      consumeRateLimit(numRemoved);
+      stats.documentsRemoved += numRemoved;
+      collectionLeft -= std::min(collectionLeft, numRemoved);
+      more = (numRemoved >= limit);
+
+      if (!isActive()) {
+        return 0.0;
+      }
+    }
+
+    if (!more) {
+      return 0.0;
+    }
+
+    std::optional<double> oldest = oldestExpired(item, maxStamp);
+    return oldest.has_value() ? std::max(maxStamp - *oldest, 0.0) : 0.0;
+  }
+
+  /// @brief takes up to wanted documents from the removal budget, and
+  /// returns the number taken
+  static uint64_t reserve(std::atomic<uint64_t>& limitLeft,
+                          uint64_t wanted) noexcept {
+    uint64_t current = limitLeft.load(std::memory_order_relaxed);
+    uint64_t taken;
+    do {
+      taken = std::min(current, wanted);
+    } while (taken > 0 &&
+             !limitLeft.compare_exchange_weak(current, current - taken,
+                                              std::memory_order_relaxed));
+    return taken;
+  }
+
+  /// @brief waits until the rate limit allows removing more documents.
+  /// returns false if the thread should stop working instead
+  bool waitForRateLimit() {
+    if (_maxRemovesPerSecond == 0) {
+      return isActive();
+    }
+    while (isActive()) {
+      auto const now = std::chrono::steady_clock::now();
+      std::chrono::steady_clock::time_point nextRemoval;
+      {
+        std::lock_guard guard{_rateLimitMutex};
+        nextRemoval = _nextRemoval;
+      }
+      if (now >= nextRemoval) {
+        return true;
+      }
+      // wake up regularly to check whether we should stop
+      std::this_thread::sleep_for(
+          std::min<std::chrono::steady_clock::duration>(
+              nextRemoval - now, std::chrono::milliseconds(100)));
+    }
+    return false;
+  }
+
+  /// @brief accounts the removed documents against the rate limit
+  void consumeRateLimit(uint64_t removed) {
+    if (_maxRemovesPerSecond == 0 || removed == 0) {
+      return;
+    }
+    auto const cost =
+        std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(static_cast<double>(removed) /
+                                          _maxRemovesPerSecond));
+    std::lock_guard guard{_rateLimitMutex};
+    _nextRemoval =
+        std::max(_nextRemoval, std::chrono::steady_clock::now()) + cost;
+  }
+
+  static std::shared_ptr<VPackBuilder> bindParameters(WorkItem const& item,
+                                                      double maxStamp,
+                                                      uint64_t limit) {
+    auto bindVars = std::make_shared<VPackBuilder>();
+    bindVars->openObject();
+    bindVars->add("indexHint", VPackValue(item.index->name()));
+    bindVars->add("@collection", VPackValue(item.collection->name()));
+    bindVars->add(VPackValue("indexAttribute"));
+    bindVars->openArray();
+    for (auto const& it : item.index->fields()[0]) {
+      bindVars->add(VPackValue(it.name));
+    }
+    bindVars->close();
+    bindVars->add("stamp", VPackValue(maxStamp));
+    bindVars->add("limit", VPackValue(limit));
+    bindVars->close();
+    return bindVars;
+  }
+
+  /// @brief removes up to limit expired documents, oldest first. returns the
+  /// number of removed documents, or nothing if the removal failed
+  std::optional<uint64_t> removeBatch(WorkItem const& item, double maxStamp,
+                                      uint64_t limit) {
+    auto query = aql::Query::create(
+        transaction::StandaloneContext::Create(item.vocbase),
+        aql::QueryString(::removeQuery),
+        bindParameters(item, maxStamp, limit));
+    query->collections().add(item.collection->name(), AccessMode::Type::WRITE,
+                             aql::Collection::Hint::Shard);
+    aql::QueryResult queryResult = query->executeSync();
+
+    if (queryResult.result.fail()) {
+      // we can probably live with an error here...
+      if (!queryResult.result.is(TRI_ERROR_ARANGO_READ_ONLY) &&
+          !queryResult.result.is(TRI_ERROR_ARANGO_CONFLICT) &&
+          !queryResult.result.is(TRI_ERROR_LOCKED) &&
+          !queryResult.result.is(TRI_ERROR_ARANGO_DATA_SOURCE_NOT_FOUND)) {
+        LOG_TOPIC("08300", WARN, Logger::TTL)
+            << "error during TTL document removal for collection '"
+            << item.collection->name()
+            << "': " << queryResult.result.errorMessage();
+      }
+      return std::nullopt;
+    }
+
+    uint64_t removed = 0;
+    auto extra = queryResult.extra;
+    if (extra != nullptr) {
+      VPackSlice v = extra->slice().get("stats");
+      if (v.isObject()) {
+        v = v.get("writesExecuted");
+        if (v.isNumber()) {
+          removed = v.getNumericValue<uint64_t>();
         }
       }
     }
+    if (removed > 0) {
+      LOG_TOPIC("2455e", DEBUG, Logger::TTL)
+          << "TTL thread removed " << removed << " documents for collection '"
+          << item.collection->name() << "'";
+    }
+    return removed;
+  }
+
+  /// @brief returns the TTL index value of the oldest expired document in
+  /// the collection, if there is one
+  std::optional<double> oldestExpired(WorkItem const& item, double maxStamp) {
+    auto query = aql::Query::create(
+        transaction::StandaloneContext::Create(item.vocbase),
+        aql::QueryString(::oldestQuery), bindParameters(item, maxStamp, 1));
+    query->collections().add(item.collection->name(), AccessMode::Type::READ,
+                             aql::Collection::Hint::Shard);
+    aql::QueryResult queryResult = query->executeSync();
+
+    if (queryResult.result.fail() || queryResult.data == nullptr) {
+      return std::nullopt;
+    }
+    VPackSlice data = queryResult.data->slice();
+    if (!data.isArray() || data.length() == 0 || !data.at(0).isNumber()) {
+      return std::nullopt;
+    }
+    return data.at(0).getNumericValue<double>();
   }
 
   TtlFeature& _ttlFeature;
 
+  /// @brief maximum number of threads removing documents concurrently
+  std::size_t const _numThreads;
+
+  /// @brief maximum number of documents to remove per second, 0 = unlimited
+  uint64_t const _maxRemovesPerSecond;
+
+  /// @brief age (in seconds) of the oldest expired document not yet removed,
+  /// as of the last run
+  metrics::Gauge<double>& _expiryLag;
+
   arangodb::basics::ConditionVariable _condition;
 
   /// @brief next time the thread should run
   std::chrono::time_point<std::chrono::steady_clock> _nextStart;
 
+  /// @brief protects _nextRemoval
+  std::mutex _rateLimitMutex;
+
+  /// @brief earliest time the next batch of documents may be removed, when
+  /// rate-limited
+  std::chrono::steady_clock::time_point _nextRemoval;
+
   /// @brief a builder object we reuse to save a few memory allocations
   VPackBuilder _builder;
 
@@ -421,7 +701,13 @@ class TtlThread final : public ServerThread<ArangodServer> {
 }  // namespace arangodb
 
 TtlFeature::TtlFeature(Server& server)
-    : ArangodFeature{server, *this}, _allowRunning(true), _active(true) {
+    : ArangodFeature{server, *this},
+      _numThreads(1),
+      _maxRemovesPerSecond(0),
+      _expiryLag(server.getFeature<metrics::MetricsFeature>().add(
+          arangodb_ttl_expiry_lag{})),
+      _allowRunning(true),
+      _active(true) {
   startsAfter<application_features::DatabaseFeaturePhase>();
   startsAfter<application_features::ServerFeaturePhase>();
 }
@@ -466,6 +752,36 @@ removal, they are removed in subsequent runs of the background thread.)");
 total removal amount so that the per-collection time window for locking and
 potential write-write conflicts can be reduced.)");
 
+  options
+      ->addOption("--ttl.threads",
+                  "The maximum number of threads removing expired documents "
+                  "from different collections concurrently.",
+                  new SizeTParameter(&_numThreads, /*base*/ 1, /*minValue*/ 1,
+                                     /*maxValue*/ 64))
+      .setIntroducedIn(31200)
+      .setLongDescription(R"(Each collection (or shard) with a TTL index is
+processed by one thread at a time, but different collections are processed
+concurrently. The limits set by `--ttl.max-total-removes` and
+`--ttl.max-collection-removes` apply to all threads together.
+
+With the default value of 1, the TTL background thread removes all expired
+documents by itself. Higher values make it start additional threads for the
+duration of each run.)");
+
+  options
+      ->addOption("--ttl.max-removes-per-second",
+                  "The maximum number of documents to remove per second, "
+                  "across all collections (0 = unlimited).",
+                  new UInt64Parameter(&_maxRemovesPerSecond))
+      .setIntroducedIn(31200)
+      .setLongDescription(R"(If set, expired documents are removed in smaller
+batches, and the TTL threads pause between batches so that the removal rate
+does not exceed the configured value. This limits the write load caused by
+expiring documents, at the expense of expired documents staying around longer.
+
+The `arangodb_ttl_expiry_lag` metric shows the age of the oldest expired
+document that was left in place in the last run.)");
+
   // the following option was obsoleted in 3.8
   options->addObsoleteOption(
       "--ttl.only-loaded-collection",
@@ -523,7 +839,8 @@ void TtlFeature::start() {
     return;
   }
 
-  _thread = std::make_unique<TtlThread>(server(), *this);
+  _thread = std::make_unique<TtlThread>(server(), *this, _numThreads,
+                                        _maxRemovesPerSecond, _expiryLag);
 
   if (!_thread->start()) {
     LOG_TOPIC("33c33", FATAL, Logger::TTL)
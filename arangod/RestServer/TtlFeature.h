@@ -23,6 +23,7 @@
 
 #pragma once
 
+#include "Metrics/Fwd.h"
 #include "RestServer/arangod.h"
 #include <mutex>
 
@@ -112,6 +113,15 @@ class TtlFeature final : public ArangodFeature {
   void shutdownThread() noexcept;
 
  private:
+  /// @brief maximum number of threads removing documents concurrently
+  std::size_t _numThreads;
+
+  /// @brief maximum number of documents to remove per second, 0 = unlimited
+  uint64_t _maxRemovesPerSecond;
+
+  /// @brief age of the oldest expired document not yet removed
+  metrics::Gauge<double>& _expiryLag;
+
   /// @brief protects _properties and _active
   mutable std::mutex _propertiesMutex;
   TtlProperties _properties;
@@ -0,0 +1,133 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "HashedCollectSpillBackendRocksDB.h"
+
+#include "Basics/Exceptions.h"
+#include "Basics/debugging.h"
+#include "RocksDBEngine/RocksDBFormat.h"
+#include "RocksDBEngine/RocksDBKey.h"
+#include "RocksDBEngine/RocksDBSortedRowsStorageContext.h"
+#include "RocksDBEngine/RocksDBTempStorage.h"
+
+#include <rocksdb/iterator.h>
+
+#include <velocypack/Builder.h>
+#include <velocypack/Slice.h>
+#include <velocypack/Value.h>
+
+namespace {
+// keys are built as the context's 8 byte prefix, followed by the 8 byte
+// row number and the partition number as a single sort value. the keys
+// comparator of the temporary storage compares the sort values before the
+// row numbers, so the rows are returned partition by partition, in
+// insertion order.
+constexpr size_t partitionOffset = 2 * sizeof(std::uint64_t);
+}  // namespace
+
+namespace arangodb {
+
+HashedCollectSpillBackendRocksDB::HashedCollectSpillBackendRocksDB(
+    RocksDBTempStorage& storage)
+    : _tempStorage(storage), _rowNumberForInsert(0) {}
+
+HashedCollectSpillBackendRocksDB::~HashedCollectSpillBackendRocksDB() {
+  try {
+    cleanup();
+  } catch (...) {
+  }
+}
+
+void HashedCollectSpillBackendRocksDB::storeRow(size_t partition,
+                                                velocypack::Slice values) {
+  TRI_ASSERT(_iterator == nullptr);
+  if (_context == nullptr) {
+    // create context on the fly
+    _context = _tempStorage.getSortedRowsStorageContext();
+  }
+
+  _keyBuffer.clear();
+  rocksutils::uintToPersistentBigEndian<std::uint64_t>(_keyBuffer,
+                                                       _context->keyPrefix());
+  rocksutils::uintToPersistentBigEndian<std::uint64_t>(_keyBuffer,
+                                                       ++_rowNumberForInsert);
+  velocypack::Builder partitionBuilder;
+  partitionBuilder.add(velocypack::Value(partition));
+  _keyBuffer.append(partitionBuilder.slice().startAs<char const>(),
+                    partitionBuilder.slice().byteSize());
+  // ascending order
+  _keyBuffer.push_back('1');
+
+  RocksDBKey rocksDBKey;
+  rocksDBKey.constructFromBuffer(_keyBuffer);
+
+  auto res = _context->storeRow(rocksDBKey, values);
+  if (res.fail()) {
+    THROW_ARANGO_EXCEPTION(res);
+  }
+}
+
+void HashedCollectSpillBackendRocksDB::seal() {
+  TRI_ASSERT(_iterator == nullptr);
+  if (_context == nullptr) {
+    // nothing was stored
+    return;
+  }
+
+  _context->ingestAll();
+
+  _iterator = _context->getIterator();
+}
+
+bool HashedCollectSpillBackendRocksDB::hasMore() const {
+  return _iterator != nullptr && _iterator->Valid();
+}
+
+size_t HashedCollectSpillBackendRocksDB::currentPartition() const {
+  TRI_ASSERT(hasMore());
+  auto key = _iterator->key();
+  TRI_ASSERT(key.size() > partitionOffset);
+  velocypack::Slice slice(
+      reinterpret_cast<uint8_t const*>(key.data() + partitionOffset));
+  return slice.getNumber<size_t>();
+}
+
+velocypack::Slice HashedCollectSpillBackendRocksDB::currentRow() const {
+  TRI_ASSERT(hasMore());
+  return velocypack::Slice(
+      reinterpret_cast<uint8_t const*>(_iterator->value().data()));
+}
+
+void HashedCollectSpillBackendRocksDB::next() {
+  TRI_ASSERT(hasMore());
+  _iterator->Next();
+}
+
+void HashedCollectSpillBackendRocksDB::cleanup() {
+  _iterator.reset();
+  if (_context == nullptr) {
+    return;
+  }
+
+  _context->cleanup();
+}
+
+}  // namespace arangodb
@@ -34,6 +34,14 @@ DECLARE_COUNTER(
     "Number of times RocksDB has entered a stalled (slowed) write state");
 DECLARE_COUNTER(arangodb_rocksdb_write_stops_total,
                 "Number of times RocksDB has entered a stopped write state");
+DECLARE_COUNTER(arangodb_rocksdb_flush_written_bytes_total,
+                "Number of bytes written by RocksDB flushes per column family");
+DECLARE_COUNTER(
+    arangodb_rocksdb_compaction_read_bytes_total,
+    "Number of bytes read by RocksDB compactions per column family");
+DECLARE_COUNTER(
+    arangodb_rocksdb_compaction_written_bytes_total,
+    "Number of bytes written by RocksDB compactions per column family");
 
 namespace arangodb {
 
@@ -42,7 +50,25 @@ RocksDBMetricsListener::RocksDBMetricsListener(ArangodServer& server)
     : _writeStalls(server.getFeature<metrics::MetricsFeature>().add(
           arangodb_rocksdb_write_stalls_total{})),
       _writeStops(server.getFeature<metrics::MetricsFeature>().add(
-          arangodb_rocksdb_write_stops_total{})) {}
+          arangodb_rocksdb_write_stops_total{})) {
+  auto& metricsFeature = server.getFeature<metrics::MetricsFeature>();
+  for (size_t i = 0; i < _columnFamilyMetrics.size(); ++i) {
+    auto family = static_cast<RocksDBColumnFamilyManager::Family>(i);
+    std::string_view label = RocksDBColumnFamilyManager::name(
+        family, RocksDBColumnFamilyManager::NameMode::External);
+
+    auto& cf = _columnFamilyMetrics[i];
+    cf.name = RocksDBColumnFamilyManager::name(
+        family, RocksDBColumnFamilyManager::NameMode::Internal);
+    cf.flushWrittenBytes = &metricsFeature.add(
+        arangodb_rocksdb_flush_written_bytes_total{}.withLabel("cf", label));
+    cf.compactionReadBytes = &metricsFeature.add(
+        arangodb_rocksdb_compaction_read_bytes_total{}.withLabel("cf", label));
+    cf.compactionWrittenBytes = &metricsFeature.add(
+        arangodb_rocksdb_compaction_written_bytes_total{}.withLabel("cf",
+                                                                    label));
+  }
+}
 
 void RocksDBMetricsListener::OnFlushBegin(rocksdb::DB*,
                                           rocksdb::FlushJobInfo const& info) {
@@ -52,6 +78,12 @@ void RocksDBMetricsListener::OnFlushBegin(rocksdb::DB*,
 void RocksDBMetricsListener::OnFlushCompleted(
     rocksdb::DB*, rocksdb::FlushJobInfo const& info) {
   handleFlush("completed", info);
+
+  if (auto cf = columnFamilyMetrics(info.cf_name); cf != nullptr) {
+    cf->flushWrittenBytes->count(info.table_properties.data_size +
+                                 info.table_properties.index_size +
+                                 info.table_properties.filter_size);
+  }
 }
 
 void RocksDBMetricsListener::OnCompactionBegin(
@@ -62,6 +94,11 @@ void RocksDBMetricsListener::OnCompactionBegin(
 void RocksDBMetricsListener::OnCompactionCompleted(
     rocksdb::DB*, rocksdb::CompactionJobInfo const& info) {
   handleCompaction("completed", info);
+
+  if (auto cf = columnFamilyMetrics(info.cf_name); cf != nullptr) {
+    cf->compactionReadBytes->count(info.stats.total_input_bytes);
+    cf->compactionWrittenBytes->count(info.stats.total_output_bytes);
+  }
 }
 
 void RocksDBMetricsListener::OnStallConditionsChanged(
@@ -230,4 +267,15 @@ void RocksDBMetricsListener::handleCompaction(
       << ", reason: " << buildReason(info);
 }
 
+RocksDBMetricsListener::ColumnFamilyMetrics const*
+RocksDBMetricsListener::columnFamilyMetrics(
+    std::string_view name) const noexcept {
+  for (auto const& cf : _columnFamilyMetrics) {
+    if (cf.name == name) {
+      return &cf;
+    }
+  }
+  return nullptr;
+}
+
 }  // namespace arangodb
@@ -28,7 +28,9 @@
 
 #include "Metrics/Fwd.h"
 #include "RestServer/arangod.h"
+#include "RocksDBEngine/RocksDBColumnFamilyManager.h"
 
+#include <array>
 #include <string_view>
 
 namespace rocksdb {
@@ -59,15 +61,34 @@ class RocksDBMetricsListener : public rocksdb::EventListener {
   void OnStallConditionsChanged(rocksdb::WriteStallInfo const& info) override;
 
  private:
+  /// @brief bytes written by flushes and read/written by compactions in one
+  /// column family
+  struct ColumnFamilyMetrics {
+    std::string_view name;
+    metrics::Counter* flushWrittenBytes = nullptr;
+    metrics::Counter* compactionReadBytes = nullptr;
+    metrics::Counter* compactionWrittenBytes = nullptr;
+  };
+
   void handleFlush(std::string_view phase,
                    rocksdb::FlushJobInfo const& info) const;
 
   void handleCompaction(std::string_view phase,
                         rocksdb::CompactionJobInfo const& info) const;
 
+  /// @brief returns the counters for the column family with the given
+  /// (internal) name, or a nullptr for an unknown column family
+  ColumnFamilyMetrics const* columnFamilyMetrics(
+      std::string_view name) const noexcept;
+
  protected:
   metrics::Counter& _writeStalls;
   metrics::Counter& _writeStops;
+
+ private:
+  std::array<ColumnFamilyMetrics,
+             RocksDBColumnFamilyManager::numberOfColumnFamilies>
+      _columnFamilyMetrics;
 };
 
 }  // namespace arangodb
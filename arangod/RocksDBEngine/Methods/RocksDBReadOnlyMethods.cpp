@@ -59,6 +59,19 @@ rocksdb::Status RocksDBReadOnlyMethods::Get(rocksdb::ColumnFamilyHandle* cf,
   return _db->Get(_readOptions, cf, key, val);
 }
 
+void RocksDBReadOnlyMethods::MultiGet(rocksdb::ColumnFamilyHandle* cf,
+                                      size_t count, rocksdb::Slice const* keys,
+                                      rocksdb::PinnableSlice* values,
+                                      rocksdb::Status* statuses,
+                                      ReadOwnWrites) {
+  TRI_ASSERT(cf != nullptr);
+  TRI_ASSERT(_readOptions.snapshot != nullptr);
+  rocksdb::ReadOptions ro = _readOptions;
+  // let RocksDB read the data blocks of different keys concurrently
+  ro.async_io = true;
+  _db->MultiGet(ro, cf, count, keys, values, statuses, /*sorted_input*/ true);
+}
+
 std::unique_ptr<rocksdb::Iterator> RocksDBReadOnlyMethods::NewIterator(
     rocksdb::ColumnFamilyHandle* cf, ReadOptionsCallback readOptionsCallback) {
   TRI_ASSERT(cf != nullptr);
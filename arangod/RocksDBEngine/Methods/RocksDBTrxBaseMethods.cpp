@@ -26,7 +26,9 @@
 #include "ApplicationFeatures/ApplicationServer.h"
 #include "Containers/SmallVector.h"
 #include "Logger/LogMacros.h"
+#include "Metrics/Gauge.h"
 #include "Random/RandomGenerator.h"
+#include "RocksDBEngine/RocksDBEngine.h"
 #include "RocksDBEngine/RocksDBLogValue.h"
 #include "RocksDBEngine/RocksDBSettingsManager.h"
 #include "RocksDBEngine/RocksDBSyncThread.h"
@@ -40,29 +42,38 @@
 
 using namespace arangodb;
 
-// dummy implementation to track memory allocations during a
-// transaction. currently only counts memory. will be replaced
-// with an alternative implementation that will count memory
-// against different sinks (depending on transaction invocation type),
-// e.g. the current AQL query's ResourceMonitor instance or different
-// metrics for non-AQL transactions.
+// implementation to track memory allocations during a transaction.
+// counts memory for the transaction and publishes it to a metric for the
+// memory usage of all transactions. the metric is updated only after the
+// memory usage has changed by more than a few KB, so that the many small
+// changes of a transaction do not all go to the shared atomic.
+// may later be replaced with an alternative implementation that will count
+// memory against different sinks (depending on transaction invocation
+// type), e.g. the current AQL query's ResourceMonitor instance.
 class TrxMemoryTracker final : public RocksDBMethodsMemoryTracker {
  public:
-  TrxMemoryTracker() : _memoryUsage(0) {}
-  ~TrxMemoryTracker() { TRI_ASSERT(_memoryUsage == 0); }
+  explicit TrxMemoryTracker(metrics::Gauge<uint64_t>& metric)
+      : _metric(metric), _memoryUsage(0), _reportedMemoryUsage(0) {}
+  ~TrxMemoryTracker() {
+    TRI_ASSERT(_memoryUsage == 0);
+    publish(/*force*/ true);
+  }
 
   void reset() noexcept override {
     _memoryUsage = 0;
     _savePoints.clear();
+    publish(/*force*/ true);
   }
 
   void increaseMemoryUsage(std::uint64_t value) override {
     _memoryUsage += value;
+    publish(/*force*/ false);
   }
 
   void decreaseMemoryUsage(std::uint64_t value) noexcept override {
     TRI_ASSERT(_memoryUsage >= value);
     _memoryUsage -= value;
+    publish(/*force*/ false);
   }
 
   void setSavePoint() override { _savePoints.push_back(_memoryUsage); }
@@ -71,6 +82,7 @@ class TrxMemoryTracker final : public RocksDBMethodsMemoryTracker {
     TRI_ASSERT(!_savePoints.empty());
     _memoryUsage = _savePoints.back();
     _savePoints.pop_back();
+    publish(/*force*/ false);
   }
 
   void popSavePoint() noexcept override {
@@ -81,7 +93,29 @@ class TrxMemoryTracker final : public RocksDBMethodsMemoryTracker {
   size_t memoryUsage() const noexcept override { return _memoryUsage; }
 
  private:
+  // memory usage changes smaller than this are not published to the metric
+  static constexpr std::uint64_t kPublishGranularity = 4096;
+
+  void publish(bool force) noexcept {
+    if (_memoryUsage >= _reportedMemoryUsage) {
+      std::uint64_t diff = _memoryUsage - _reportedMemoryUsage;
+      if (force || diff >= kPublishGranularity) {
+        _metric.fetch_add(diff);
+        _reportedMemoryUsage = _memoryUsage;
+      }
+    } else {
+      std::uint64_t diff = _reportedMemoryUsage - _memoryUsage;
+      if (force || diff >= kPublishGranularity) {
+        _metric.fetch_sub(diff);
+        _reportedMemoryUsage = _memoryUsage;
+      }
+    }
+  }
+
+  metrics::Gauge<uint64_t>& _metric;
   std::uint64_t _memoryUsage;
+  // memory usage as last published to the metric
+  std::uint64_t _reportedMemoryUsage;
   containers::SmallVector<std::uint64_t, 4> _savePoints;
 };
 
@@ -93,7 +127,12 @@ RocksDBTrxBaseMethods::RocksDBTrxBaseMethods(
   _readOptions.prefix_same_as_start = true;  // should always be true
   _readOptions.fill_cache = _state->options().fillBlockCache;
 
-  _memoryTracker = std::make_unique<TrxMemoryTracker>();
+  auto& engine = _state->vocbase()
+                     .server()
+                     .getFeature<EngineSelectorFeature>()
+                     .engine<RocksDBEngine>();
+  _memoryTracker = std::make_unique<TrxMemoryTracker>(
+      engine.transactionsWriteMemoryUsageMetric());
 }
 
 RocksDBTrxBaseMethods::~RocksDBTrxBaseMethods() {
@@ -231,6 +270,24 @@ rocksdb::Status RocksDBTrxBaseMethods::Get(rocksdb::ColumnFamilyHandle* cf,
   return _db->Get(ro, cf, key, val);
 }
 
+void RocksDBTrxBaseMethods::MultiGet(rocksdb::ColumnFamilyHandle* cf,
+                                     size_t count, rocksdb::Slice const* keys,
+                                     rocksdb::PinnableSlice* values,
+                                     rocksdb::Status* statuses,
+                                     ReadOwnWrites readOwnWrites) {
+  TRI_ASSERT(cf != nullptr);
+  rocksdb::ReadOptions ro = _readOptions;
+  TRI_ASSERT(ro.snapshot != nullptr || _state->options().delaySnapshot);
+  // let RocksDB read the data blocks of different keys concurrently
+  ro.async_io = true;
+  if (readOwnWrites == ReadOwnWrites::yes) {
+    _rocksTransaction->MultiGet(ro, cf, count, keys, values, statuses,
+                                /*sorted_input*/ true);
+  } else {
+    _db->MultiGet(ro, cf, count, keys, values, statuses, /*sorted_input*/ true);
+  }
+}
+
 rocksdb::Status RocksDBTrxBaseMethods::GetForUpdate(
     rocksdb::ColumnFamilyHandle* cf, rocksdb::Slice const& key,
     rocksdb::PinnableSlice* val) {
@@ -563,7 +620,8 @@ Result RocksDBTrxBaseMethods::doCommitImpl() {
     auto& engine = selector.engine<RocksDBEngine>();
     if (engine.syncThread()) {
       // we do have a sync thread
-      return engine.syncThread()->syncWal();
+      // concurrent commits are synced together
+      return engine.syncThread()->syncWal(postCommitSeq);
     } else {
       // no sync thread present... this may be the case if automatic
       // syncing is completely turned off. in this case, use the
@@ -96,6 +96,9 @@ class RocksDBTrxBaseMethods : public RocksDBTransactionMethods {
                                   rocksdb::Snapshot const* snapshot) override;
   rocksdb::Status Get(rocksdb::ColumnFamilyHandle*, rocksdb::Slice const&,
                       rocksdb::PinnableSlice*, ReadOwnWrites) override;
+  void MultiGet(rocksdb::ColumnFamilyHandle*, size_t count,
+                rocksdb::Slice const* keys, rocksdb::PinnableSlice* values,
+                rocksdb::Status* statuses, ReadOwnWrites) override;
   rocksdb::Status GetForUpdate(rocksdb::ColumnFamilyHandle*,
                                rocksdb::Slice const&,
                                rocksdb::PinnableSlice*) final override;
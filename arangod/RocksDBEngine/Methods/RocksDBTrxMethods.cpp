@@ -127,6 +127,30 @@ rocksdb::Status RocksDBTrxMethods::Get(rocksdb::ColumnFamilyHandle* cf,
   return _rocksTransaction->Get(ro, cf, key, val);
 }
 
+void RocksDBTrxMethods::MultiGet(rocksdb::ColumnFamilyHandle* cf,
+                                 size_t count, rocksdb::Slice const* keys,
+                                 rocksdb::PinnableSlice* values,
+                                 rocksdb::Status* statuses,
+                                 ReadOwnWrites readOwnWrites) {
+  TRI_ASSERT(cf != nullptr);
+  TRI_ASSERT(_rocksTransaction);
+  rocksdb::ReadOptions ro = _readOptions;
+  // let RocksDB read the data blocks of different keys concurrently
+  ro.async_io = true;
+  if (readOwnWrites == ReadOwnWrites::no) {
+    if (_readWriteBatch) {
+      _readWriteBatch->MultiGetFromBatchAndDB(_db, ro, cf, count, keys, values,
+                                              statuses, /*sorted_input*/ true);
+    } else {
+      _db->MultiGet(ro, cf, count, keys, values, statuses,
+                    /*sorted_input*/ true);
+    }
+    return;
+  }
+  _rocksTransaction->MultiGet(ro, cf, count, keys, values, statuses,
+                              /*sorted_input*/ true);
+}
+
 std::unique_ptr<rocksdb::Iterator> RocksDBTrxMethods::NewIterator(
     rocksdb::ColumnFamilyHandle* cf, ReadOptionsCallback readOptionsCallback) {
   TRI_ASSERT(cf != nullptr);
@@ -24,7 +24,10 @@
 #include "ReplicatedRocksDBTransactionCollection.h"
 
 #include "ApplicationFeatures/ApplicationServer.h"
+#include "Replication2/ReplicatedState/ReplicatedState.h"
+#include "Replication2/StateMachines/Document/DocumentFollowerState.h"
 #include "Replication2/StateMachines/Document/DocumentLeaderState.h"
+#include "Replication2/StateMachines/Document/DocumentStateMachine.h"
 #include "RocksDBEngine/Methods/RocksDBReadOnlyMethods.h"
 #include "RocksDBEngine/Methods/RocksDBSingleOperationReadOnlyMethods.h"
 #include "RocksDBEngine/Methods/RocksDBSingleOperationTrxMethods.h"
@@ -215,9 +218,46 @@ auto ReplicatedRocksDBTransactionCollection::ensureCollection() -> Result {
     ADB_PROD_ASSERT(_leaderState != nullptr);
   }
 
+  if (accessType() == AccessMode::Type::READ) {
+    auto const& options = _transaction->options();
+    if (options.allowDirtyReads && options.maxDirtyReadLag.has_value()) {
+      res = checkDirtyReadLag(*options.maxDirtyReadLag);
+    }
+  }
+
   return res;
 }
 
+auto ReplicatedRocksDBTransactionCollection::checkDirtyReadLag(
+    std::uint64_t maxLag) -> Result {
+  auto stateMachine = _collection->getDocumentState();
+  if (stateMachine->getLeader() != nullptr) {
+    // the leader is always up to date
+    return {};
+  }
+
+  auto follower = stateMachine->getFollower();
+  if (follower == nullptr) {
+    // not (yet) an established follower, e.g. still waiting for a snapshot
+    return {TRI_ERROR_REPLICATION_REPLICATED_STATE_NOT_AVAILABLE,
+            "shard " + _collection->name() +
+                " is not available for dirty reads on this server"};
+  }
+
+  auto lag = follower->getApplyLag();
+  if (!lag.has_value()) {
+    return {TRI_ERROR_REPLICATION_REPLICATED_LOG_FOLLOWER_RESIGNED};
+  }
+  if (*lag > maxLag) {
+    return {TRI_ERROR_CLUSTER_FOLLOWER_TOO_FAR_BEHIND,
+            "follower of shard " + _collection->name() + " is " +
+                std::to_string(*lag) +
+                " log entries behind, which exceeds maxDirtyReadLag of " +
+                std::to_string(maxLag)};
+  }
+  return {};
+}
+
 futures::Future<Result>
 ReplicatedRocksDBTransactionCollection::performIntermediateCommitIfRequired() {
   if (_rocksMethods->isIntermediateCommitNeeded()) {
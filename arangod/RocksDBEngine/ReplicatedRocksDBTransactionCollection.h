@@ -90,6 +90,10 @@ class ReplicatedRocksDBTransactionCollection final
  private:
   void maybeDisableIndexing();
 
+  // checks whether this server can serve dirty reads for the shard within
+  // the bound set via the maxDirtyReadLag transaction option
+  auto checkDirtyReadLag(std::uint64_t maxLag) -> Result;
+
   std::shared_ptr<replication2::replicated_state::document::DocumentLeaderState>
       _leaderState;
   /// @brief wrapper to use outside this class to access rocksdb
@@ -203,6 +203,12 @@ void RocksDBBackgroundThread::run() {
         // the following operations
       }
 
+      try {
+        _engine.adjustRateLimit();
+      } catch (...) {
+        // same as above
+      }
+
       bool canPrune =
           TRI_microtime() >= startTime + _engine.pruneWaitTimeInitial();
       TRI_IF_FAILURE("BuilderIndex::purgeWal") { canPrune = true; }
@@ -24,7 +24,9 @@
 #include "RocksDBBuilderIndex.h"
 
 #include "ApplicationFeatures/ApplicationServer.h"
+#include "Basics/Exceptions.h"
 #include "Basics/FileUtils.h"
+#include "Basics/ScopeGuard.h"
 #include "Basics/VelocyPackHelper.h"
 #include "Basics/application-exit.h"
 #include "Basics/debugging.h"
@@ -35,8 +37,10 @@
 #endif
 #include "Logger/LogMacros.h"
 #include "RestServer/FlushFeature.h"
+#include "RestServer/TemporaryStorageFeature.h"
 #include "RocksDBEngine/Methods/RocksDBBatchedMethods.h"
 #include "RocksDBEngine/Methods/RocksDBBatchedWithIndexMethods.h"
+#include "RocksDBEngine/Methods/RocksDBSstFileMethods.h"
 #include "RocksDBEngine/RocksDBCollection.h"
 #include "RocksDBEngine/RocksDBColumnFamilyManager.h"
 #include "RocksDBEngine/RocksDBCommon.h"
@@ -60,7 +64,10 @@
 
 #include <velocypack/Builder.h>
 #include <velocypack/Iterator.h>
+
+#include <mutex>
 #include <stdexcept>
+#include <thread>
 
 using namespace arangodb;
 using namespace arangodb::rocksutils;
@@ -77,24 +84,11 @@ constexpr size_t getBatchSize(size_t numDocsHint) noexcept {
   }
 }
 
-}  // namespace
-
-namespace arangodb {
-Result partiallyCommitInsertions(rocksdb::WriteBatchBase& batch,
-                                 rocksdb::DB* rootDB,
-                                 RocksDBTransactionCollection* trxColl,
-                                 std::atomic<uint64_t>& docsProcessed,
-                                 RocksDBIndex& ridx, bool isForeground) {
-  auto docsInBatch = batch.GetWriteBatch()->Count();
-  if (docsInBatch > 0) {
-    rocksdb::WriteOptions wo;
-    rocksdb::Status s = rootDB->Write(wo, batch.GetWriteBatch());
-    if (!s.ok()) {
-      return rocksutils::convertStatus(s, rocksutils::StatusHint::index);
-    }
-  }
-  batch.Clear();
-
+/// @brief apply the index operations tracked by the transaction to the
+/// index's selectivity estimator
+void applyTrackedIndexOperations(RocksDBTransactionCollection* trxColl,
+                                 rocksdb::DB* rootDB, RocksDBIndex& ridx,
+                                 bool isForeground) {
   auto ops = trxColl->stealTrackedIndexOperations();
   if (!ops.empty()) {
     TRI_ASSERT(ridx.hasSelectivityEstimate() && ops.size() == 1);
@@ -114,6 +108,27 @@ Result partiallyCommitInsertions(rocksdb::WriteBatchBase& batch,
       }
     }
   }
+}
+
+}  // namespace
+
+namespace arangodb {
+Result partiallyCommitInsertions(rocksdb::WriteBatchBase& batch,
+                                 rocksdb::DB* rootDB,
+                                 RocksDBTransactionCollection* trxColl,
+                                 std::atomic<uint64_t>& docsProcessed,
+                                 RocksDBIndex& ridx, bool isForeground) {
+  auto docsInBatch = batch.GetWriteBatch()->Count();
+  if (docsInBatch > 0) {
+    rocksdb::WriteOptions wo;
+    rocksdb::Status s = rootDB->Write(wo, batch.GetWriteBatch());
+    if (!s.ok()) {
+      return rocksutils::convertStatus(s, rocksutils::StatusHint::index);
+    }
+  }
+  batch.Clear();
+
+  ::applyTrackedIndexOperations(trxColl, rootDB, ridx, isForeground);
 
   docsProcessed.fetch_add(docsInBatch, std::memory_order_relaxed);
   return {};
@@ -209,8 +224,355 @@ Result fillIndexSingleThreaded(
   return res;
 }
 
+std::vector<std::string> splitDocumentKeyRange(std::string_view firstKey,
+                                               std::string_view lastKey,
+                                               size_t numRanges) {
+  // the keys are the object id followed by the document id. the document
+  // ids are split as the bytes in the keys are ordered, independent of the
+  // endianness of the key format
+  auto documentIdBytes = [](std::string_view key) {
+    TRI_ASSERT(key.size() == 2 * sizeof(uint64_t));
+    uint64_t value = 0;
+    for (size_t i = sizeof(uint64_t); i < 2 * sizeof(uint64_t); ++i) {
+      value = (value << 8) | static_cast<uint8_t>(key[i]);
+    }
+    return value;
+  };
+  TRI_ASSERT(firstKey.substr(0, sizeof(uint64_t)) ==
+             lastKey.substr(0, sizeof(uint64_t)));
+  TRI_ASSERT(numRanges > 0);
+
+  uint64_t first = documentIdBytes(firstKey);
+  uint64_t last = documentIdBytes(lastKey);
+  TRI_ASSERT(first <= last);
+
+  // the ranges are equally wide, but may contain different numbers of
+  // documents. there are more ranges than threads, so that threads which
+  // are done early can take over another range
+  std::vector<std::string> boundaries;
+  uint64_t step = (last - first) / numRanges;
+  if (step > 0) {
+    boundaries.reserve(numRanges - 1);
+    std::string key(firstKey.substr(0, sizeof(uint64_t)));
+    for (size_t i = 1; i < numRanges; ++i) {
+      key.resize(sizeof(uint64_t));
+      uint64_t value = first + i * step;
+      for (size_t j = 0; j < sizeof(uint64_t); ++j) {
+        key.push_back(static_cast<char>(
+            (value >> (8 * (sizeof(uint64_t) - 1 - j))) & 0xffU));
+      }
+      boundaries.emplace_back(key);
+    }
+  }
+  return boundaries;
+}
+
 }  // namespace arangodb
 
+#ifndef USE_ENTERPRISE
+namespace {
+
+/// @brief whether the index can be filled by multiple threads. every thread
+/// writes its index entries into separate sst files, which are ingested at
+/// the end. this is only possible for indexes without uniqueness checks,
+/// which do not need to read back their own writes
+bool canFillIndexInParallel(RocksDBIndex const& ridx) {
+  switch (ridx.type()) {
+    case Index::TRI_IDX_TYPE_HASH_INDEX:
+    case Index::TRI_IDX_TYPE_SKIPLIST_INDEX:
+    case Index::TRI_IDX_TYPE_PERSISTENT_INDEX:
+      return !ridx.unique();
+    default:
+      return false;
+  }
+}
+
+/// @brief split the collection's documents into numRanges key ranges.
+/// returns the range boundaries, i.e. the keys the ranges start with,
+/// followed by the end of the last range
+std::vector<std::string> splitDocumentRange(rocksdb::DB* rootDB,
+                                            rocksdb::Snapshot const* snap,
+                                            uint64_t objectId,
+                                            size_t numRanges) {
+  auto bounds = RocksDBKeyBounds::CollectionDocuments(objectId);
+  rocksdb::Slice lower(bounds.start());
+  rocksdb::Slice upper(bounds.end());
+
+  std::vector<std::string> boundaries;
+  boundaries.emplace_back(lower.data(), lower.size());
+
+  rocksdb::ReadOptions ro(/*cksum*/ false, /*cache*/ false);
+  ro.snapshot = snap;
+  ro.total_order_seek = true;
+  ro.iterate_lower_bound = &lower;
+  ro.iterate_upper_bound = &upper;
+
+  std::unique_ptr<rocksdb::Iterator> it(rootDB->NewIterator(
+      ro, RocksDBColumnFamilyManager::get(
+              RocksDBColumnFamilyManager::Family::Documents)));
+  it->SeekToFirst();
+  if (it->Valid()) {
+    std::string firstKey = it->key().ToString();
+    it->SeekToLast();
+    TRI_ASSERT(it->Valid());
+    for (auto& key : splitDocumentKeyRange(firstKey, it->key().ToStringView(),
+                                           numRanges)) {
+      boundaries.emplace_back(std::move(key));
+    }
+  }
+
+  boundaries.emplace_back(upper.data(), upper.size());
+  return boundaries;
+}
+
+/// @brief state shared by all threads that fill an index in parallel
+struct ParallelIndexFiller {
+  bool const foreground;
+  AccessMode::Type const mode;
+  RocksDBIndex& ridx;
+  rocksdb::DB* const rootDB;
+  rocksdb::Snapshot const* const snap;
+  rocksdb::Options const& dbOptions;
+  std::string const& idxPath;
+  std::atomic<uint64_t>& docsProcessed;
+  uint64_t const count;
+  std::shared_ptr<std::function<arangodb::Result(double)>> progress;
+  StorageUsageTracker usageTracker{/*maxCapacity*/ 0};
+
+  /// @brief range boundaries, see splitDocumentRange()
+  std::vector<std::string> boundaries;
+  /// @brief the next range that is not yet taken by a thread
+  std::atomic<size_t> nextRange{0};
+  /// @brief set by the first thread that fails, to stop the others
+  std::atomic<bool> failed{false};
+  std::mutex progressMutex;
+
+  /// @brief fill the index for the ranges this thread gets, and return the
+  /// names of the sst files written
+  Result fillRanges(std::vector<std::string>& fileNames);
+
+  /// @brief called by the threads after every batch of documents
+  Result batchDone(RocksDBTransactionCollection* trxColl, uint64_t numDocs);
+};
+
+Result ParallelIndexFiller::fillRanges(std::vector<std::string>& fileNames) {
+  LogicalCollection& coll = ridx.collection();
+  transaction::Options trxOpts;
+  trxOpts.requiresReplication = false;
+  trx::BuilderTrx trx(transaction::StandaloneContext::Create(coll.vocbase()),
+                      coll, mode, trxOpts);
+  if (mode == AccessMode::Type::EXCLUSIVE) {
+    trx.addHint(transaction::Hints::Hint::LOCK_NEVER);
+  }
+  trx.addHint(transaction::Hints::Hint::INDEX_CREATION);
+
+  Result res = trx.begin();
+  if (res.fail()) {
+    return res;
+  }
+  RocksDBTransactionCollection* trxColl = trx.resolveTrxCollection();
+
+  RocksDBSstFileMethods methods(rootDB, ridx.columnFamily(), dbOptions,
+                                idxPath, usageTracker);
+  rocksdb::ColumnFamilyHandle* docCF = RocksDBColumnFamilyManager::get(
+      RocksDBColumnFamilyManager::Family::Documents);
+  OperationOptions options;
+
+  while (res.ok()) {
+    size_t range = nextRange.fetch_add(1, std::memory_order_relaxed);
+    if (range + 1 >= boundaries.size()) {
+      break;
+    }
+
+    rocksdb::Slice upper(boundaries[range + 1]);
+    rocksdb::ReadOptions ro(/*cksum*/ false, /*cache*/ false);
+    ro.snapshot = snap;
+    ro.prefix_same_as_start = true;
+    ro.iterate_upper_bound = &upper;
+    std::unique_ptr<rocksdb::Iterator> it(rootDB->NewIterator(ro, docCF));
+
+    uint64_t numDocs = 0;
+    for (it->Seek(boundaries[range]); it->Valid(); it->Next()) {
+      res = ridx.insert(
+          trx, &methods, RocksDBKey::documentId(it->key()),
+          VPackSlice(reinterpret_cast<uint8_t const*>(it->value().data())),
+          options, /*performChecks*/ true);
+      if (res.fail()) {
+        break;
+      }
+      if (++numDocs == 1024) {
+        res = batchDone(trxColl, numDocs);
+        numDocs = 0;
+        if (res.fail()) {
+          break;
+        }
+      }
+    }
+
+    if (!it->status().ok() && res.ok()) {
+      res = rocksutils::convertStatus(it->status(),
+                                      rocksutils::StatusHint::index);
+    }
+    if (res.ok()) {
+      res = batchDone(trxColl, numDocs);
+    }
+  }
+
+  if (res.ok()) {
+    res = methods.stealFileNames(fileNames);
+  }
+  if (res.ok()) {
+    res = trx.commit();
+  }
+  if (res.fail()) {
+    failed.store(true, std::memory_order_relaxed);
+  }
+  return res;
+}
+
+Result ParallelIndexFiller::batchDone(RocksDBTransactionCollection* trxColl,
+                                      uint64_t numDocs) {
+  ::applyTrackedIndexOperations(trxColl, rootDB, ridx, foreground);
+  uint64_t processed =
+      docsProcessed.fetch_add(numDocs, std::memory_order_relaxed) + numDocs;
+
+  if (count > 0) {
+    // only one thread reports the progress at a time. the others don't
+    // need to wait for it
+    std::unique_lock guard(progressMutex, std::try_to_lock);
+    if (guard.owns_lock()) {
+      double p = processed * 100.0 / count;
+      ridx.progress(p);
+      if (progress != nullptr) {
+        (*progress)(p);
+      }
+    }
+  }
+
+  if (failed.load(std::memory_order_relaxed)) {
+    // another thread has failed. its error is reported
+    return Result(TRI_ERROR_REQUEST_CANCELED);
+  }
+  if (ridx.collection().vocbase().server().isStopping()) {
+    return Result(TRI_ERROR_SHUTTING_DOWN);
+  }
+  if (ridx.collection().vocbase().isDropped()) {
+    // database dropped
+    return Result(TRI_ERROR_ARANGO_DATABASE_NOT_FOUND);
+  }
+  if (ridx.collection().deleted()) {
+    // collection dropped
+    return Result(TRI_ERROR_ARANGO_DATA_SOURCE_NOT_FOUND);
+  }
+  return {};
+}
+
+/// @brief fill the index with numThreads threads, which read disjoint
+/// ranges of the collection's documents
+Result fillIndexParallel(
+    bool foreground, AccessMode::Type mode, size_t numThreads,
+    rocksdb::Options const& dbOptions,
+    std::atomic<std::uint64_t>& docsProcessed, trx::BuilderTrx& trx,
+    RocksDBIndex& ridx, rocksdb::Snapshot const* snap, rocksdb::DB* rootDB,
+    std::string const& idxPath,
+    std::shared_ptr<std::function<arangodb::Result(double)>> progress) {
+  TRI_ASSERT(numThreads > 1);
+  auto rcoll = static_cast<RocksDBCollection*>(ridx.collection().getPhysical());
+
+  ParallelIndexFiller filler{
+      .foreground = foreground,
+      .mode = mode,
+      .ridx = ridx,
+      .rootDB = rootDB,
+      .snap = snap,
+      .dbOptions = dbOptions,
+      .idxPath = idxPath,
+      .docsProcessed = docsProcessed,
+      .count = rcoll->numberDocuments(&trx),
+      .progress = std::move(progress),
+  };
+  filler.boundaries =
+      ::splitDocumentRange(rootDB, snap, rcoll->objectId(), 4 * numThreads);
+
+  std::vector<Result> results(numThreads);
+  std::vector<std::vector<std::string>> fileNames(numThreads);
+  std::vector<std::thread> threads;
+  threads.reserve(numThreads);
+  auto joinThreads = scopeGuard([&]() noexcept {
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  });
+
+  try {
+    for (size_t i = 0; i < numThreads; ++i) {
+      threads.emplace_back([&, i]() {
+        results[i] = basics::catchToResult(
+            [&]() { return filler.fillRanges(fileNames[i]); });
+        if (results[i].fail()) {
+          filler.failed.store(true, std::memory_order_relaxed);
+        }
+      });
+    }
+  } catch (...) {
+    // we could not start all threads. the ones that were started fill
+    // the whole index
+    if (threads.empty()) {
+      throw;
+    }
+  }
+  joinThreads.fire();
+
+  Result res;
+  for (auto const& r : results) {
+    if (r.fail() && (res.ok() || res.is(TRI_ERROR_REQUEST_CANCELED))) {
+      res = r;
+    }
+  }
+
+  std::vector<std::string> allFileNames;
+  for (auto& names : fileNames) {
+    allFileNames.insert(allFileNames.end(), names.begin(), names.end());
+  }
+
+  if (res.ok() && !allFileNames.empty()) {
+    // the files of different threads overlap, so RocksDB assigns them
+    // increasing sequence numbers
+    rocksdb::IngestExternalFileOptions ingestOptions;
+    ingestOptions.move_files = true;
+    ingestOptions.failed_move_fall_back_to_copy = true;
+    ingestOptions.snapshot_consistency = false;
+    ingestOptions.write_global_seqno = false;
+    ingestOptions.verify_checksums_before_ingest = false;
+
+    rocksdb::Status s = rootDB->IngestExternalFile(
+        ridx.columnFamily(), allFileNames, std::move(ingestOptions));
+    if (!s.ok()) {
+      res = rocksutils::convertStatus(s, rocksutils::StatusHint::index);
+    }
+  }
+  if (res.fail()) {
+    RocksDBSstFileMethods::cleanUpFiles(allFileNames);
+  }
+
+  if (res.ok()) {
+    res = trx.commit();
+
+    if (ridx.estimator() != nullptr) {
+      ridx.estimator()->setAppliedSeq(rootDB->GetLatestSequenceNumber());
+    }
+  }
+
+  LOG_TOPIC("c61e5", DEBUG, Logger::ENGINES)
+      << "filled index with " << numThreads << " threads, "
+      << filler.boundaries.size() - 1 << " ranges, " << allFileNames.size()
+      << " files: " << res.errorMessage();
+  return res;
+}
+
+}  // namespace
+#endif
+
 RocksDBBuilderIndex::RocksDBBuilderIndex(std::shared_ptr<RocksDBIndex> wp,
                                          uint64_t numDocsHint, size_t numTheads)
     : RocksDBIndex{wp->id(), wp->collection(), wp->name(), wp->fields(),
@@ -327,9 +689,16 @@ static Result fillIndex(
                           std::move(progress));
   res = indexFiller.fillIndex();
 #else
-  res = fillIndexSingleThreaded(foreground, batched, dbOptions, batch,
-                                docsProcessed, trx, ridx, snap, rootDB,
-                                std::move(it), std::move(progress));
+  if (numThreads > 1 && ::canFillIndexInParallel(ridx)) {
+    it.reset();
+    res = fillIndexParallel(foreground, mode, numThreads, dbOptions,
+                            docsProcessed, trx, ridx, snap, rootDB, idxPath,
+                            std::move(progress));
+  } else {
+    res = fillIndexSingleThreaded(foreground, batched, dbOptions, batch,
+                                  docsProcessed, trx, ridx, snap, rootDB,
+                                  std::move(it), std::move(progress));
+  }
 #endif
   return res;
 }
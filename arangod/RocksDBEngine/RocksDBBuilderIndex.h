@@ -30,6 +30,9 @@
 #include "RocksDBEngine/RocksDBTransactionCollection.h"
 
 #include <atomic>
+#include <string>
+#include <string_view>
+#include <vector>
 
 namespace arangodb {
 
@@ -61,6 +64,15 @@ Result partiallyCommitInsertions(rocksdb::WriteBatchBase& batch,
                                  std::atomic<uint64_t>& docsProcessed,
                                  RocksDBIndex& ridx, bool isForeground);
 
+/// @brief splits the document keys from firstKey to lastKey (both keys of
+/// documents of the same collection) into numRanges equally wide ranges.
+/// returns the keys the ranges after the first one start with, in ascending
+/// order. returns fewer keys if there are not enough document ids to split
+/// into numRanges ranges
+std::vector<std::string> splitDocumentKeyRange(std::string_view firstKey,
+                                               std::string_view lastKey,
+                                               size_t numRanges);
+
 Result fillIndexSingleThreaded(
     bool foreground, RocksDBMethods& batched, rocksdb::Options const& dbOptions,
     rocksdb::WriteBatchBase& batch, std::atomic<std::uint64_t>& docsProcessed,
@@ -58,6 +58,7 @@
 #include "RocksDBEngine/RocksDBCommon.h"
 #include "RocksDBEngine/RocksDBComparator.h"
 #include "RocksDBEngine/RocksDBEngine.h"
+#include "RocksDBEngine/RocksDBFormat.h"
 #include "RocksDBEngine/RocksDBIterators.h"
 #include "RocksDBEngine/RocksDBKey.h"
 #include "RocksDBEngine/RocksDBLogValue.h"
@@ -696,6 +697,95 @@ std::unique_ptr<IndexIterator> RocksDBCollection::getAnyIterator(
   return rocksdb_iterators::createAnyIterator(&_logicalCollection, trx);
 }
 
+std::unique_ptr<IndexIterator> RocksDBCollection::getRangeIterator(
+    transaction::Methods* trx, ReadOwnWrites readOwnWrites,
+    LocalDocumentId lower, LocalDocumentId upper) const {
+  return rocksdb_iterators::createRangeIterator(
+      &_logicalCollection, trx, readOwnWrites,
+      RocksDBKeyBounds::CollectionDocuments(
+          objectId(), lower.id(), upper.isSet() ? upper.id() : UINT64_MAX));
+}
+
+std::vector<LocalDocumentId> RocksDBCollection::partitionDocuments(
+    size_t partitions) const {
+  std::vector<LocalDocumentId> result;
+  if (partitions <= 1 || rocksutils::getRocksDBKeyFormatEndianness() !=
+                             RocksDBEndianness::Big) {
+    // with little-endian keys, the order of the keys is not the order of
+    // the LocalDocumentIds, so ranges of ids are not ranges of keys
+    return result;
+  }
+
+  auto& selector =
+      _logicalCollection.vocbase().server().getFeature<EngineSelectorFeature>();
+  rocksdb::TransactionDB* db = selector.engine<RocksDBEngine>().db();
+  RocksDBKeyBounds const bounds = this->bounds();
+  rocksdb::ColumnFamilyHandle* const cf = bounds.columnFamily();
+
+  // find the lowest and the highest document id. the partitions do not
+  // need to be computed from a snapshot, as their bounds are only used to
+  // split the key space of the collection
+  rocksdb::Slice const upper(bounds.end());
+  rocksdb::ReadOptions ro;
+  ro.prefix_same_as_start = true;
+  ro.iterate_upper_bound = &upper;
+  ro.fill_cache = false;
+  std::unique_ptr<rocksdb::Iterator> it(db->NewIterator(ro, cf));
+  it->Seek(bounds.start());
+  if (!it->Valid()) {
+    return result;
+  }
+  uint64_t const lowest = RocksDBKey::documentId(it->key()).id();
+  it->SeekForPrev(bounds.end());
+  if (!it->Valid()) {
+    return result;
+  }
+  uint64_t const highest = RocksDBKey::documentId(it->key()).id();
+  if (highest - lowest < partitions) {
+    return result;
+  }
+
+  rocksdb::SizeApproximationOptions options{.include_memtables = true,
+                                            .include_files = true};
+  auto sizeBelow = [&](uint64_t id) {
+    auto range = RocksDBKeyBounds::CollectionDocuments(objectId(), lowest, id);
+    rocksdb::Range r(range.start(), range.end());
+    uint64_t out = 0;
+    db->GetApproximateSizes(options, cf, &r, 1, &out);
+    return out;
+  };
+
+  uint64_t const total = sizeBelow(highest);
+  for (size_t i = 1; i < partitions; ++i) {
+    uint64_t const previous = result.empty() ? lowest : result.back().id();
+    uint64_t bound;
+    if (total == 0) {
+      // no size information available. assume that the ids are distributed
+      // evenly
+      bound = lowest + (highest - lowest) / partitions * i;
+    } else {
+      // find the lowest id so that the documents below it make up the
+      // wanted share of the total size
+      uint64_t const wanted = total / partitions * i;
+      uint64_t low = previous;
+      uint64_t high = highest;
+      while (low < high) {
+        uint64_t mid = low + (high - low) / 2;
+        if (sizeBelow(mid) < wanted) {
+          low = mid + 1;
+        } else {
+          high = mid;
+        }
+      }
+      bound = low;
+    }
+    if (bound > previous && bound < highest) {
+      result.emplace_back(bound);
+    }
+  }
+  return result;
+}
+
 std::unique_ptr<ReplicationIterator> RocksDBCollection::getReplicationIterator(
     ReplicationIterator::Ordering order, uint64_t batchId) {
   if (order != ReplicationIterator::Ordering::Revision) {
@@ -1058,7 +1148,6 @@ Result RocksDBCollection::read(transaction::Methods* trx, std::string_view key,
       [](TransactionStatistics::ReadWriteMetrics& metrics,
          float time) noexcept { metrics.rocksdb_read_sec.count(time); });
 
-  rocksdb::PinnableSlice ps;
   Result res;
   LocalDocumentId documentId;
   do {
@@ -1075,11 +1164,10 @@ Result RocksDBCollection::read(transaction::Methods* trx, std::string_view key,
           std::chrono::milliseconds(RandomGenerator::interval(uint32_t(2000))));
     }
 
-    res = lookupDocumentVPack(trx, documentId, ps, /*readCache*/ true,
-                              /*fillCache*/ true, readOwnWrites);
-    if (res.ok()) {
-      cb(documentId, VPackSlice(reinterpret_cast<uint8_t const*>(ps.data())));
-    }
+    // documents found in the document cache are passed to the callback
+    // directly from the cache, without copying them
+    res = lookupDocumentVPack(trx, documentId, cb, /*withCache*/ true,
+                              readOwnWrites);
   } while (res.is(TRI_ERROR_ARANGO_DOCUMENT_NOT_FOUND) &&
            RocksDBTransactionState::toState(trx)->ensureSnapshot());
   if (res.is(TRI_ERROR_ARANGO_DOCUMENT_NOT_FOUND)) {
@@ -1109,6 +1197,123 @@ Result RocksDBCollection::read(transaction::Methods* trx,
                              readOwnWrites);
 }
 
+// read multiple documents using their local document ids
+Result RocksDBCollection::readMany(transaction::Methods* trx,
+                                   std::span<LocalDocumentId const> tokens,
+                                   IndexIterator::DocumentCallback const& cb,
+                                   ReadOwnWrites readOwnWrites) const {
+  if (tokens.size() <= 1) {
+    return PhysicalCollection::readMany(trx, tokens, cb, readOwnWrites);
+  }
+
+  ::ReadTimeTracker timeTracker(
+      _statistics._readWriteMetrics,
+      [](TransactionStatistics::ReadWriteMetrics& metrics,
+         float time) noexcept { metrics.rocksdb_read_sec.count(time); });
+
+  TRI_ASSERT(trx->state()->isRunning());
+  TRI_ASSERT(objectId() != 0);
+
+  // the keys of all documents, stored back to back
+  constexpr size_t keySize = 2 * sizeof(uint64_t);
+  std::string keys;
+  keys.reserve(tokens.size() * keySize);
+  {
+    RocksDBKeyLeaser key(trx);
+    for (auto const& token : tokens) {
+      key->constructDocument(objectId(), token);
+      TRI_ASSERT(key->string().size() == keySize);
+      keys.append(key->string().data(), key->string().size());
+    }
+  }
+  auto keyAt = [&keys](size_t i) {
+    return rocksdb::Slice(keys.data() + i * keySize, keySize);
+  };
+
+  // documents found in the cache. the findings keep the cached values alive
+  std::vector<cache::Finding> cached(tokens.size());
+  // positions of the documents that need to be read from RocksDB
+  std::vector<size_t> positions;
+  positions.reserve(tokens.size());
+  for (size_t i = 0; i < tokens.size(); ++i) {
+    if (!tokens[i].isSet()) {
+      continue;
+    }
+    if (useCache()) {
+      TRI_ASSERT(_cache != nullptr);
+      rocksdb::Slice key = keyAt(i);
+      cached[i] = _cache->find(key.data(), static_cast<uint32_t>(key.size()));
+      if (cached[i].found()) {
+        continue;
+      }
+    }
+    positions.emplace_back(i);
+  }
+
+  // MultiGet is most efficient for sorted keys
+  std::sort(positions.begin(), positions.end(), [&](size_t lhs, size_t rhs) {
+    return keyAt(lhs).compare(keyAt(rhs)) < 0;
+  });
+
+  std::vector<rocksdb::Slice> readKeys;
+  readKeys.reserve(positions.size());
+  for (size_t i : positions) {
+    readKeys.emplace_back(keyAt(i));
+  }
+  std::vector<rocksdb::PinnableSlice> values(positions.size());
+  std::vector<rocksdb::Status> statuses(positions.size());
+  if (!positions.empty()) {
+    RocksDBMethods* mthd =
+        RocksDBTransactionState::toMethods(trx, _logicalCollection.id());
+    mthd->MultiGet(RocksDBColumnFamilyManager::get(
+                       RocksDBColumnFamilyManager::Family::Documents),
+                   positions.size(), readKeys.data(), values.data(),
+                   statuses.data(), readOwnWrites);
+  }
+
+  // index into values for every document, or SIZE_MAX if it was not read
+  std::vector<size_t> valueIndexes(tokens.size(), SIZE_MAX);
+  for (size_t i = 0; i < positions.size(); ++i) {
+    valueIndexes[positions[i]] = i;
+  }
+
+  Result res;
+  for (size_t i = 0; i < tokens.size(); ++i) {
+    if (cached[i].found()) {
+      auto const* value = cached[i].value()->value();
+      cb(tokens[i], VPackSlice(reinterpret_cast<uint8_t const*>(value)));
+      continue;
+    }
+    size_t index = valueIndexes[i];
+    if (index == SIZE_MAX) {
+      // invalid document id
+      continue;
+    }
+    rocksdb::Status const& s = statuses[index];
+    if (!s.ok()) {
+      if (!s.IsNotFound() && res.ok()) {
+        res = rocksutils::convertStatus(s);
+      }
+      continue;
+    }
+
+    rocksdb::PinnableSlice const& ps = values[index];
+    TRI_ASSERT(ps.size() > 0);
+    cb(tokens[i], VPackSlice(reinterpret_cast<uint8_t const*>(ps.data())));
+
+    if (useCache()) {
+      TRI_ASSERT(_cache != nullptr);
+      // write entry back to cache
+      rocksdb::Slice key = keyAt(i);
+      cache::Cache::SimpleInserter<DocumentCacheType>{
+          static_cast<DocumentCacheType&>(*_cache), key.data(),
+          static_cast<uint32_t>(key.size()), ps.data(),
+          static_cast<uint64_t>(ps.size())};
+    }
+  }
+  return res;
+}
+
 Result RocksDBCollection::insert(transaction::Methods& trx,
                                  IndexesSnapshot const& indexesSnapshot,
                                  RevisionId newRevisionId,
@@ -1980,6 +2185,7 @@ Result RocksDBCollection::lookupDocumentVPack(
   RocksDBKeyLeaser key(trx);
   key->constructDocument(objectId(), documentId);
 
+  bool lockTimeout = false;
   if (withCache && useCache()) {
     TRI_ASSERT(_cache != nullptr);
     // check cache first for fast path
@@ -1990,6 +2196,11 @@ Result RocksDBCollection::lookupDocumentVPack(
          VPackSlice(reinterpret_cast<uint8_t const*>(f.value()->value())));
       return {};
     }
+    if (f.result() == TRI_ERROR_LOCK_TIMEOUT) {
+      // assuming someone is currently holding a write lock, which
+      // is why we cannot access the TransactionalBucket.
+      lockTimeout = true;  // we skip the insert in this case
+    }
   }
 
   transaction::StringLeaser buffer(trx);
@@ -2007,13 +2218,13 @@ Result RocksDBCollection::lookupDocumentVPack(
                            key->string(), &ps, readOwnWrites);
 
   if (!s.ok()) {
-    return rocksutils::convertStatus(s);
+    return rocksutils::convertStatus(s, rocksutils::document);
   }
 
   TRI_ASSERT(ps.size() > 0);
   cb(documentId, VPackSlice(reinterpret_cast<uint8_t const*>(ps.data())));
 
-  if (withCache && useCache()) {
+  if (withCache && useCache() && !lockTimeout) {
     TRI_ASSERT(_cache != nullptr);
     // write entry back to cache
     cache::Cache::SimpleInserter<DocumentCacheType>{
@@ -76,6 +76,12 @@ class RocksDBCollection final : public RocksDBMetaCollection {
       transaction::Methods* trx, ReadOwnWrites readOwnWrites) const override;
   std::unique_ptr<IndexIterator> getAnyIterator(
       transaction::Methods* trx) const override;
+  std::unique_ptr<IndexIterator> getRangeIterator(
+      transaction::Methods* trx, ReadOwnWrites readOwnWrites,
+      LocalDocumentId lower, LocalDocumentId upper) const override;
+
+  std::vector<LocalDocumentId> partitionDocuments(
+      size_t partitions) const override;
 
   std::unique_ptr<ReplicationIterator> getReplicationIterator(
       ReplicationIterator::Ordering, uint64_t batchId) override;
@@ -119,6 +125,11 @@ class RocksDBCollection final : public RocksDBMetaCollection {
               IndexIterator::DocumentCallback const& cb,
               ReadOwnWrites readOwnWrites) const override;
 
+  Result readMany(transaction::Methods* trx,
+                  std::span<LocalDocumentId const> tokens,
+                  IndexIterator::DocumentCallback const& cb,
+                  ReadOwnWrites readOwnWrites) const override;
+
   Result insert(transaction::Methods& trx,
                 IndexesSnapshot const& indexesSnapshot,
                 RevisionId newRevisionId, velocypack::Slice newDocument,
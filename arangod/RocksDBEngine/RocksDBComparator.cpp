@@ -37,6 +37,18 @@ using namespace arangodb;
 
 namespace {
 
+/// @brief whether the two VelocyPack values are byte-wise identical.
+/// identical values always compare equal, so the (much more expensive)
+/// type-aware comparison can be skipped for them. note that the reverse
+/// is not true: e.g. the same number can be stored with different
+/// VelocyPack types, and strings are compared by their collation
+bool isIdentical(arangodb::velocypack::Slice lhs,
+                 arangodb::velocypack::Slice rhs) {
+  auto const size = lhs.byteSize();
+  return size == rhs.byteSize() &&
+         memcmp(lhs.start(), rhs.start(), static_cast<size_t>(size)) == 0;
+}
+
 int compareIndexedValues(arangodb::velocypack::Slice const& lhs,
                          arangodb::velocypack::Slice const& rhs) {
   TRI_ASSERT(lhs.isArray());
@@ -53,6 +65,13 @@ int compareIndexedValues(arangodb::velocypack::Slice const& lhs,
       return static_cast<int>(lhsIter.size() - rhsIter.size());
     }
 
+    if (lhsValid && rhsValid && isIdentical(*lhsIter, *rhsIter)) {
+      // common for the leading attributes of combined indexes
+      ++lhsIter;
+      ++rhsIter;
+      continue;
+    }
+
     int res = arangodb::basics::VelocyPackHelper::compare(
         (lhsValid ? *lhsIter : VPackSlice::noneSlice()),
         (rhsValid ? *rhsIter : VPackSlice::noneSlice()), true);
@@ -94,7 +113,11 @@ int RocksDBVPackComparator::compareIndexValues(
   VPackSlice const rSlice = VPackSlice(
       reinterpret_cast<uint8_t const*>(rhs.data()) + sizeof(uint64_t));
 
-  r = ::compareIndexedValues(lSlice, rSlice);
+  // in non-unique indexes, keys with identical index values that only
+  // differ in their LocalDocumentId are very common
+  if (!::isIdentical(lSlice, rSlice)) {
+    r = ::compareIndexedValues(lSlice, rSlice);
+  }
 
   if (r != 0) {
     // comparison of index values produced an unambiguous result
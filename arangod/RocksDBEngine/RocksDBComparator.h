@@ -47,6 +47,11 @@ class RocksDBVPackComparator final : public rocksdb::Comparator {
 
   bool Equal(rocksdb::Slice const& lhs,
              rocksdb::Slice const& rhs) const override {
+    if (lhs.size() == rhs.size() &&
+        memcmp(lhs.data(), rhs.data(), lhs.size()) == 0) {
+      // byte-wise identical keys are always equal
+      return true;
+    }
     return (compareIndexValues(lhs, rhs) == 0);
   }
 
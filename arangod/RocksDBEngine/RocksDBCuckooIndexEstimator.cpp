@@ -85,6 +85,7 @@ RocksDBCuckooIndexEstimator<Key>::~RocksDBCuckooIndexEstimator() {
 template<class Key>
 void RocksDBCuckooIndexEstimator<Key>::drain() {
   WRITE_LOCKER(locker, _lock);
+  std::lock_guard bufferLocker{_bufferLock};
   drainNoLock();
 }
 
@@ -183,6 +184,7 @@ void RocksDBCuckooIndexEstimator<Key>::serialize(
       serialized.append(scratch);
     }
 
+    std::lock_guard bufferLocker{_bufferLock};
     bool havePendingUpdates = !_insertBuffers.empty() ||
                               !_removalBuffers.empty() ||
                               !_truncateBuffer.empty();
@@ -249,7 +251,7 @@ template<class Key>
 Result RocksDBCuckooIndexEstimator<Key>::bufferTruncate(
     rocksdb::SequenceNumber seq) {
   Result res = basics::catchVoidToResult([&]() -> void {
-    WRITE_LOCKER(locker, _lock);
+    std::lock_guard bufferLocker{_bufferLock};
     _truncateBuffer.emplace(seq);
     _needToPersist.store(true, std::memory_order_release);
     increaseMemoryUsage(bufferedEntrySize());
@@ -464,7 +466,7 @@ Result RocksDBCuckooIndexEstimator<Key>::bufferUpdates(
     std::vector<Key>&& removals) {
   TRI_ASSERT(!inserts.empty() || !removals.empty());
   Result res = basics::catchVoidToResult([&]() -> void {
-    WRITE_LOCKER(locker, _lock);
+    std::lock_guard bufferLocker{_bufferLock};
 
     if (!inserts.empty()) {
       uint64_t memoryUsage =
@@ -491,91 +493,85 @@ rocksdb::SequenceNumber RocksDBCuckooIndexEstimator<Key>::applyUpdates(
     rocksdb::SequenceNumber commitSeq) {
   rocksdb::SequenceNumber appliedSeq = 0;
   Result res = basics::catchVoidToResult([&]() -> void {
-    std::vector<Key> inserts;
-    std::vector<Key> removals;
-
-    // truncate will increase this sequence
-    rocksdb::SequenceNumber ignoreSeq = 0;
-    while (true) {
-      bool foundTruncate = false;
-      // find out if we have buffers to apply
+    // all buffers up to commitSeq, taken out of the buffers at once. updates
+    // for sequence numbers up to commitSeq are not buffered anymore by now
+    std::multimap<rocksdb::SequenceNumber, std::vector<Key>> inserts;
+    std::multimap<rocksdb::SequenceNumber, std::vector<Key>> removals;
+    size_t numInserts = 0;
+    size_t numRemovals = 0;
+    bool foundTruncate = false;
+
+    {
+      std::lock_guard bufferLocker{_bufferLock};
+
+      uint64_t memoryUsage = 0;
+      // truncate will increase this sequence
+      rocksdb::SequenceNumber ignoreSeq = 0;
       {
-        WRITE_LOCKER(locker, _lock);
-
-        uint64_t memoryUsage = 0;
-        {
-          // check for a truncate marker
-          auto it = _truncateBuffer.begin();  // sorted ASC
-          while (it != _truncateBuffer.end() && *it <= commitSeq) {
-            ignoreSeq = *it;
-            TRI_ASSERT(ignoreSeq != 0);
-            foundTruncate = true;
-            appliedSeq = std::max(appliedSeq, ignoreSeq);
-            memoryUsage += bufferedEntrySize();
-            it = _truncateBuffer.erase(it);
-          }
+        // check for a truncate marker
+        auto it = _truncateBuffer.begin();  // sorted ASC
+        while (it != _truncateBuffer.end() && *it <= commitSeq) {
+          ignoreSeq = *it;
+          TRI_ASSERT(ignoreSeq != 0);
+          foundTruncate = true;
+          appliedSeq = std::max(appliedSeq, ignoreSeq);
+          memoryUsage += bufferedEntrySize();
+          it = _truncateBuffer.erase(it);
         }
-        TRI_ASSERT(ignoreSeq <= commitSeq);
+      }
+      TRI_ASSERT(ignoreSeq <= commitSeq);
 
-        // check for inserts
-        auto it = _insertBuffers.begin();  // sorted ASC
-        while (it != _insertBuffers.end() && it->first <= commitSeq) {
+      auto take = [&](auto& buffers, auto& target, size_t& numItems) {
+        auto it = buffers.begin();  // sorted ASC
+        while (it != buffers.end() && it->first <= commitSeq) {
+          memoryUsage += bufferedEntrySize() +
+                         bufferedEntryItemSize() * it->second.size();
           if (it->first <= ignoreSeq) {
+            // superseded by the truncate
             TRI_ASSERT(it->first <= appliedSeq);
-            memoryUsage += bufferedEntrySize() +
-                           bufferedEntryItemSize() * it->second.size();
-            it = _insertBuffers.erase(it);
+          } else {
+            TRI_ASSERT(!it->second.empty());
+            appliedSeq = std::max(appliedSeq, it->first);
+            numItems += it->second.size();
+            target.insert(buffers.extract(it++));
             continue;
           }
-          inserts = std::move(it->second);
-          TRI_ASSERT(!inserts.empty());
-          appliedSeq = std::max(appliedSeq, it->first);
-          memoryUsage +=
-              bufferedEntrySize() + bufferedEntryItemSize() * inserts.size();
-          _insertBuffers.erase(it);
-          break;
+          it = buffers.erase(it);
         }
+      };
+      take(_insertBuffers, inserts, numInserts);
+      take(_removalBuffers, removals, numRemovals);
 
-        // check for removals
-        it = _removalBuffers.begin();  // sorted ASC
-        while (it != _removalBuffers.end() && it->first <= commitSeq) {
-          if (it->first <= ignoreSeq) {
-            TRI_ASSERT(it->first <= appliedSeq);
-            memoryUsage += bufferedEntrySize() +
-                           bufferedEntryItemSize() * it->second.size();
-            it = _removalBuffers.erase(it);
-            continue;
-          }
-          removals = std::move(it->second);
-          TRI_ASSERT(!removals.empty());
-          appliedSeq = std::max(appliedSeq, it->first);
-          memoryUsage +=
-              bufferedEntrySize() + bufferedEntryItemSize() * removals.size();
-          _removalBuffers.erase(it);
-          break;
-        }
+      decreaseMemoryUsage(memoryUsage);
+      checkInvariants();
+    }
 
-        decreaseMemoryUsage(memoryUsage);
-        checkInvariants();
-      }
+    if (foundTruncate) {
+      clear();  // clear estimates
+    }
 
-      if (foundTruncate) {
-        clear();  // clear estimates
+    // apply all inserts and then all removals, each under a single
+    // acquisition of the lock
+    auto apply = [](auto& buffers, size_t numItems, auto&& cb) {
+      if (buffers.empty()) {
+        return;
       }
-
-      // no inserts or removals left to apply, drop out of loop
-      if (inserts.empty() && removals.empty()) {
-        break;
+      if (buffers.size() == 1) {
+        cb(buffers.begin()->second);
+        return;
       }
-
-      // apply inserts
-      insert(inserts);
-      inserts.clear();
-
-      // apply removals
-      remove(removals);
-      removals.clear();
-    }  // </while(true)>
+      std::vector<Key> keys;
+      keys.reserve(numItems);
+      for (auto const& it : buffers) {
+        keys.insert(keys.end(), it.second.begin(), it.second.end());
+      }
+      buffers.clear();
+      cb(keys);
+    };
+    apply(inserts, numInserts,
+          [this](std::vector<Key> const& keys) { insert(keys); });
+    apply(removals, numRemovals,
+          [this](std::vector<Key> const& keys) { remove(keys); });
   });
   return appliedSeq;
 }
@@ -806,6 +802,10 @@ void RocksDBCuckooIndexEstimator<Key>::drainNoLock() {
 template<class Key>
 void RocksDBCuckooIndexEstimator<Key>::freeMemory() {
   WRITE_LOCKER(locker, _lock);
+  // writers buffer their updates while holding only the buffer lock. hold it
+  // until the end, so that no update can be buffered after draining and
+  // invalidate the check below
+  std::lock_guard bufferLocker{_bufferLock};
 
   drainNoLock();
 
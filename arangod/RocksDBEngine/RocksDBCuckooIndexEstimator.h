@@ -24,9 +24,11 @@
 
 #pragma once
 
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <map>
+#include <mutex>
 #include <set>
 #include <type_traits>
 #include <utility>
@@ -540,7 +542,7 @@ class RocksDBCuckooIndexEstimator {
   // free all underlying memory
   void freeMemory();
 
-  // helper function for drain()
+  // helper function for drain(). requires _lock and _bufferLock
   void drainNoLock();
 
 #ifdef ARANGODB_ENABLE_MAINTAINER_MODE
@@ -575,7 +577,13 @@ class RocksDBCuckooIndexEstimator {
   std::atomic<rocksdb::SequenceNumber> _appliedSeq;
   std::atomic<bool> _needToPersist;
 
-  uint64_t _memoryUsage;
+  std::atomic<uint64_t> _memoryUsage;
+
+  // protects the buffered updates below. kept separate from _lock, so that
+  // buffering updates on the write path neither waits for readers of the
+  // estimate nor for applying earlier updates. if both locks are needed,
+  // _lock must be acquired first
+  std::mutex mutable _bufferLock;
   std::multimap<rocksdb::SequenceNumber, std::vector<Key>> _insertBuffers;
   std::multimap<rocksdb::SequenceNumber, std::vector<Key>> _removalBuffers;
 
@@ -563,18 +563,24 @@ class RocksDBEdgeIndexLookupIterator final : public IndexIterator {
     ResourceUsageScope scope(_resourceMonitor, expectedIteratorMemoryUsage);
 
     {
-      std::unique_ptr<rocksdb::Iterator> iterator =
-          mthds->NewIterator(_index->columnFamily(), [this](ReadOptions& ro) {
+      _bounds = RocksDBKeyBounds::EdgeIndexVertex(_index->objectId(), fromTo);
+      rocksdb::Comparator const* cmp = _index->comparator();
+      auto end = _bounds.end();
+
+      // the upper bound lets RocksDB stop right at the end of the vertex's
+      // edges, instead of reading into the next data block to find the
+      // first key beyond them. we still need to compare keys below, because
+      // iterators over in-flight writes of the transaction may not respect
+      // the bound
+      std::unique_ptr<rocksdb::Iterator> iterator = mthds->NewIterator(
+          _index->columnFamily(), [this, &end](ReadOptions& ro) {
             ro.fill_cache = EdgeIndexFillBlockCache;
             ro.readOwnWrites = canReadOwnWrites() == ReadOwnWrites::yes;
+            ro.iterate_upper_bound = &end;
           });
 
       TRI_ASSERT(iterator != nullptr);
 
-      _bounds = RocksDBKeyBounds::EdgeIndexVertex(_index->objectId(), fromTo);
-      rocksdb::Comparator const* cmp = _index->comparator();
-      auto end = _bounds.end();
-
       resetInplaceMemory();
       _builder.openArray(true);
       for (iterator->Seek(_bounds.start());
@@ -897,6 +903,28 @@ void RocksDBEdgeIndex::refillCache(transaction::Methods& trx,
   }
 }
 
+std::vector<std::string> RocksDBEdgeIndex::recentCacheKeys(
+    std::size_t maxKeys) const {
+  std::shared_ptr<cache::Cache> cache = _cache;
+  if (cache == nullptr) {
+    return {};
+  }
+
+  std::vector<std::string> keys = cache->recentKeys(maxKeys);
+
+  // undo the prefix compression of the cache keys, as refillCache()
+  // expects full _from / _to values
+  std::string const* collection = _cacheKeyCollectionName.get();
+  if (collection != nullptr) {
+    for (auto& key : keys) {
+      if (key.starts_with('/')) {
+        key.insert(0, *collection);
+      }
+    }
+  }
+  return keys;
+}
+
 void RocksDBEdgeIndex::handleCacheInvalidation(transaction::Methods& trx,
                                                OperationOptions const& options,
                                                std::string_view fromToRef) {
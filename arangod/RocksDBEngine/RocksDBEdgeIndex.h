@@ -121,6 +121,8 @@ class RocksDBEdgeIndex final : public RocksDBIndex {
   void refillCache(transaction::Methods& trx,
                    std::vector<std::string> const& keys) override;
 
+  std::vector<std::string> recentCacheKeys(std::size_t maxKeys) const override;
+
   // build a potentially prefix compressed lookup key for cache lookups.
   // the return value is either
   // - an empty std::string_view if the lookup value is syntactically
@@ -31,6 +31,7 @@
 #include "Basics/ReadLocker.h"
 #include "Basics/Result.h"
 #include "Basics/RocksDBLogger.h"
+#include "Basics/ScopeGuard.h"
 #include "Basics/StaticStrings.h"
 #include "Basics/Thread.h"
 #include "Basics/VelocyPackHelper.h"
@@ -79,6 +80,7 @@
 #include "RocksDBEngine/Listeners/RocksDBThrottle.h"
 #include "RocksDBEngine/ReplicatedRocksDBTransactionState.h"
 #include "RocksDBEngine/RocksDBBackgroundThread.h"
+#include "RocksDBEngine/RocksDBRateLimitController.h"
 #include "RocksDBEngine/RocksDBChecksumEnv.h"
 #include "RocksDBEngine/RocksDBCollection.h"
 #include "RocksDBEngine/RocksDBColumnFamilyManager.h"
@@ -123,6 +125,7 @@
 #include <rocksdb/filter_policy.h>
 #include <rocksdb/iterator.h>
 #include <rocksdb/options.h>
+#include <rocksdb/rate_limiter.h>
 #include <rocksdb/slice_transform.h>
 #include <rocksdb/sst_file_reader.h>
 #include <rocksdb/statistics.h>
@@ -136,8 +139,14 @@
 #include <velocypack/Collection.h>
 #include <velocypack/Iterator.h>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
 #include <iomanip>
 #include <limits>
+#include <mutex>
+#include <thread>
 #include <utility>
 
 // we will not use the multithreaded index creation that uses rocksdb's sst
@@ -176,6 +185,12 @@ DECLARE_GAUGE(
     "Total memory consumed by buffered updates for all revision trees");
 DECLARE_GAUGE(arangodb_index_estimates_memory_usage, uint64_t,
               "Total memory consumed by all index selectivity estimates");
+DECLARE_GAUGE(arangodb_transactions_write_memory_usage, uint64_t,
+              "Total memory consumed by the write batches and locks of all "
+              "running RocksDB transactions");
+DECLARE_COUNTER(arangodb_collection_metadata_loading_time_msec_total,
+                "Total time for loading collection metadata when opening "
+                "databases [ms]");
 DECLARE_COUNTER(arangodb_revision_tree_rebuilds_success_total,
                 "Number of successful revision tree rebuilds");
 DECLARE_COUNTER(arangodb_revision_tree_rebuilds_failure_total,
@@ -184,6 +199,15 @@ DECLARE_COUNTER(arangodb_revision_tree_hibernations_total,
                 "Number of revision tree hibernations");
 DECLARE_COUNTER(arangodb_revision_tree_resurrections_total,
                 "Number of revision tree resurrections");
+DECLARE_GAUGE(rocksdb_rate_limit, uint64_t,
+              "Current rate limit for RocksDB flushes and compactions (in "
+              "bytes per second, 0 = unlimited)");
+DECLARE_COUNTER(rocksdb_rate_limit_increases_total,
+                "Number of times the rate limit for RocksDB flushes and "
+                "compactions was raised");
+DECLARE_COUNTER(rocksdb_rate_limit_decreases_total,
+                "Number of times the rate limit for RocksDB flushes and "
+                "compactions was lowered");
 DECLARE_COUNTER(rocksdb_cache_edge_inserts_uncompressed_entries_size_total,
                 "Total gross memory size of all edge cache entries ever stored "
                 "in memory");
@@ -270,12 +294,16 @@ RocksDBEngine::RocksDBEngine(Server& server,
       _intermediateCommitCount(
           transaction::Options::defaultIntermediateCommitCount),
       _maxParallelCompactions(2),
+      _metadataLoadingThreads(std::clamp<uint64_t>(
+          NumberOfCores::getValue(), 1, 16)),
+      _revisionTreeMemoryLimit(0),
       _pruneWaitTime(10.0),
       _pruneWaitTimeInitial(60.0),
       _maxWalArchiveSizeLimit(0),
       _releasedTick(0),
       _syncInterval(100),
       _syncDelayThreshold(5000),
+      _syncGroupDelay(0),
       _requiredDiskFreePercentage(0.01),
       _requiredDiskFreeBytes(16 * 1024 * 1024),
       _useThrottle(true),
@@ -322,6 +350,9 @@ RocksDBEngine::RocksDBEngine(Server& server,
       _metricsTreeBufferedMemoryUsage(
           server.getFeature<metrics::MetricsFeature>().add(
               arangodb_revision_tree_buffered_memory_usage{})),
+      _metricsTransactionsWriteMemoryUsage(
+          server.getFeature<metrics::MetricsFeature>().add(
+              arangodb_transactions_write_memory_usage{})),
       _metricsTreeRebuildsSuccess(
           server.getFeature<metrics::MetricsFeature>().add(
               arangodb_revision_tree_rebuilds_success_total{})),
@@ -333,6 +364,17 @@ RocksDBEngine::RocksDBEngine(Server& server,
       _metricsTreeResurrections(
           server.getFeature<metrics::MetricsFeature>().add(
               arangodb_revision_tree_resurrections_total{})),
+      _metricsMetadataLoadingTime(
+          server.getFeature<metrics::MetricsFeature>().add(
+              arangodb_collection_metadata_loading_time_msec_total{})),
+      _metricsRateLimit(server.getFeature<metrics::MetricsFeature>().add(
+          rocksdb_rate_limit{})),
+      _metricsRateLimitIncreases(
+          server.getFeature<metrics::MetricsFeature>().add(
+              rocksdb_rate_limit_increases_total{})),
+      _metricsRateLimitDecreases(
+          server.getFeature<metrics::MetricsFeature>().add(
+              rocksdb_rate_limit_decreases_total{})),
       _metricsEdgeCacheEntriesSizeInitial(
           server.getFeature<metrics::MetricsFeature>().add(
               rocksdb_cache_edge_inserts_uncompressed_entries_size_total{})),
@@ -434,6 +476,59 @@ void RocksDBEngine::flushOpenFilesIfRequired() {
   }
 }
 
+void RocksDBEngine::adjustRateLimit() {
+  if (_rateLimitController == nullptr) {
+    return;
+  }
+  TRI_ASSERT(_dbOptions.rate_limiter != nullptr);
+  TRI_ASSERT(_dbOptions.statistics != nullptr);
+
+  // average latency of reads and writes since the last adjustment
+  uint64_t count = 0;
+  uint64_t latencySum = 0;
+  for (auto type : {rocksdb::DB_GET, rocksdb::DB_WRITE}) {
+    rocksdb::HistogramData data;
+    _dbOptions.statistics->histogramData(type, &data);
+    count += data.count;
+    latencySum += data.sum;
+  }
+  double latency = 0.0;
+  if (count > _rateLimitLastCount && latencySum >= _rateLimitLastLatencySum) {
+    latency = static_cast<double>(latencySum - _rateLimitLastLatencySum) /
+              static_cast<double>(count - _rateLimitLastCount);
+  }
+  _rateLimitLastCount = count;
+  _rateLimitLastLatencySum = latencySum;
+
+  uint64_t pendingCompactionBytes = 0;
+  for (auto cfh : RocksDBColumnFamilyManager::allHandles()) {
+    uint64_t value = 0;
+    if (_db->GetIntProperty(
+            cfh, rocksdb::DB::Properties::kEstimatePendingCompactionBytes,
+            &value)) {
+      pendingCompactionBytes += value;
+    }
+  }
+
+  auto decision =
+      _rateLimitController->adjust(latency, pendingCompactionBytes);
+  if (decision == RocksDBRateLimitController::Decision::kKeep) {
+    return;
+  }
+  if (decision == RocksDBRateLimitController::Decision::kIncrease) {
+    ++_metricsRateLimitIncreases;
+  } else {
+    ++_metricsRateLimitDecreases;
+  }
+  uint64_t rate = _rateLimitController->rate();
+  LOG_TOPIC("5d7e2", DEBUG, Logger::ENGINES)
+      << "setting RocksDB rate limit to " << rate
+      << " bytes/s. average latency: " << Logger::FIXED(latency, 1)
+      << " us, pending compaction bytes: " << pendingCompactionBytes;
+  _dbOptions.rate_limiter->SetBytesPerSecond(static_cast<int64_t>(rate));
+  _metricsRateLimit.store(rate, std::memory_order_relaxed);
+}
+
 // inherited from ApplicationFeature
 // ---------------------------------
 
@@ -502,6 +597,50 @@ RAM than this threshold value are aborted automatically with error 32
                   new UInt64Parameter(&_maxParallelCompactions))
       .setIntroducedIn(30711);
 
+  options
+      ->addOption("--rocksdb.metadata-loading-threads",
+                  "The maximum number of threads used for loading the "
+                  "metadata of collections when opening a database on "
+                  "startup.",
+                  new UInt64Parameter(&_metadataLoadingThreads, /*base*/ 1,
+                                      /*minValue*/ 1),
+                  arangodb::options::makeFlags(
+                      arangodb::options::Flags::Dynamic,
+                      arangodb::options::Flags::DefaultNoComponents,
+                      arangodb::options::Flags::OnDBServer,
+                      arangodb::options::Flags::OnSingle))
+      .setIntroducedIn(31200)
+      .setLongDescription(R"(When opening a database, the document counts,
+key generator states, index selectivity estimates and revision trees of all
+its collections are loaded. Rebuilding a missing revision tree or index
+estimate requires a full scan of the collection or index. With many
+collections, loading this metadata in parallel can speed up the server start
+considerably. The default value depends on the number of available cores.)");
+
+  options
+      ->addOption("--rocksdb.revision-tree-memory-limit",
+                  "The memory usage of all revision trees (in bytes) above "
+                  "which idle revision trees are hibernated eagerly "
+                  "(0 = no limit).",
+                  new UInt64Parameter(&_revisionTreeMemoryLimit),
+                  arangodb::options::makeFlags(
+                      arangodb::options::Flags::Dynamic,
+                      arangodb::options::Flags::DefaultNoComponents,
+                      arangodb::options::Flags::OnDBServer,
+                      arangodb::options::Flags::OnSingle))
+      .setIntroducedIn(31200)
+      .setLongDescription(R"(Every collection that uses revision-based
+replication keeps a revision tree in memory. Revision trees of collections
+that have not been modified for a while are hibernated, i.e. kept in a
+compressed form only, and are inflated again when they are needed. By default,
+this happens only after a tree has been idle for a considerable time.
+
+If the memory usage of all revision trees exceeds the configured value, trees
+that have not been used for at least 10 seconds are hibernated right away, and
+trees loaded on startup are kept in hibernated form. This can reduce the
+memory usage considerably on servers with many shards, at the expense of
+inflating trees more often.)");
+
   options
       ->addOption(
           "--rocksdb.sync-interval",
@@ -532,6 +671,30 @@ attribute.)");
       .setIntroducedIn(30608)
       .setIntroducedIn(30705);
 
+  options
+      ->addOption(
+          "--rocksdb.sync-group-delay",
+          "The time a WAL disk sync for a transaction with `waitForSync` "
+          "waits for other transactions to commit, so that they are synced "
+          "together (in microseconds, 0 = no waiting).",
+          new UInt64Parameter(&_syncGroupDelay),
+          arangodb::options::makeFlags(
+              arangodb::options::Flags::DefaultNoComponents,
+              arangodb::options::Flags::OnDBServer,
+              arangodb::options::Flags::OnSingle,
+              arangodb::options::Flags::Uncommon))
+      .setIntroducedIn(31200)
+      .setLongDescription(R"(Concurrent transactions that commit with
+`waitForSync` are always grouped: while one of them syncs the write-ahead log
+to disk, the others wait for this sync, and only sync again if their writes
+were not covered by it.
+
+With a value greater than 0, a transaction that needs to sync the write-ahead
+log first waits for the configured time, so that more concurrent commits can
+be covered by the same disk sync. This increases the throughput of many small
+transactions with `waitForSync` on disks with slow syncs, at the cost of
+additional latency for each such transaction.)");
+
   options
       ->addOption("--rocksdb.wal-file-timeout",
                   "The timeout after which unused WAL files are deleted "
@@ -861,6 +1024,13 @@ void RocksDBEngine::validateOptions(
     }
   }
 
+  if (_syncGroupDelay > 1000 * 1000) {
+    LOG_TOPIC("4b9d2", FATAL, arangodb::Logger::CONFIG)
+        << "invalid value for --rocksdb.sync-group-delay. Please use a value "
+        << "of at most 1000000 microseconds";
+    FATAL_ERROR_EXIT();
+  }
+
   if (_pruneWaitTimeInitial < 10) {
     LOG_TOPIC("a9667", WARN, arangodb::Logger::ENGINES)
         << "consider increasing the value for "
@@ -949,6 +1119,8 @@ struct RocksDBAsyncLogWriteBatcherMetricsImpl
         &metricsFeature->add(arangodb_replication2_rocksdb_write_time{});
     rocksdbSyncTimeInUs =
         &metricsFeature->add(arangodb_replication2_rocksdb_sync_time{});
+    syncGroupSize = &metricsFeature->add(
+        arangodb_replication2_rocksdb_sync_group_size{});
 
     operationLatencyInsert = &metricsFeature->add(
         arangodb_replication2_storage_operation_latency{}.withLabel("op",
@@ -1239,7 +1411,8 @@ void RocksDBEngine::start() {
   if (_syncInterval > 0) {
     _syncThread = std::make_unique<RocksDBSyncThread>(
         *this, std::chrono::milliseconds(_syncInterval),
-        std::chrono::milliseconds(_syncDelayThreshold));
+        std::chrono::milliseconds(_syncDelayThreshold),
+        std::chrono::microseconds(_syncGroupDelay));
     if (!_syncThread->start()) {
       LOG_TOPIC("63919", FATAL, Logger::ENGINES)
           << "could not start rocksdb sync thread";
@@ -1289,6 +1462,17 @@ void RocksDBEngine::start() {
 
   _settingsManager->retrieveInitialValues();
 
+  if (_dbOptions.rate_limiter != nullptr) {
+    uint64_t rate =
+        static_cast<uint64_t>(_dbOptions.rate_limiter->GetBytesPerSecond());
+    _metricsRateLimit.store(rate, std::memory_order_relaxed);
+    if (_optionsProvider.rateLimitTargetLatency() > 0) {
+      _rateLimitController = std::make_unique<RocksDBRateLimitController>(
+          rate, _optionsProvider.rateLimitTargetLatency(),
+          _optionsProvider.getOptions().soft_pending_compaction_bytes_limit);
+    }
+  }
+
   double const counterSyncSeconds = 2.5;
   _backgroundThread =
       std::make_unique<RocksDBBackgroundThread>(*this, counterSyncSeconds);
@@ -1404,6 +1588,11 @@ void RocksDBEngine::trackRevisionTreeMemoryDecrease(
   TRI_ASSERT(old >= value);
 }
 
+bool RocksDBEngine::revisionTreeMemoryLimitExceeded() const noexcept {
+  return _revisionTreeMemoryLimit > 0 &&
+         _metricsTreeMemoryUsage.load() > _revisionTreeMemoryLimit;
+}
+
 void RocksDBEngine::trackRevisionTreeBufferedMemoryIncrease(
     std::uint64_t value) noexcept {
   _metricsTreeBufferedMemoryUsage.fetch_add(value);
@@ -3027,6 +3216,79 @@ void RocksDBEngine::addSystemDatabase() {
 }
 
 /// @brief open an existing database. internal function
+void RocksDBEngine::loadCollectionsMetadata(
+    TRI_vocbase_t& vocbase,
+    std::vector<std::shared_ptr<LogicalCollection>> const& collections) {
+  auto const start = std::chrono::steady_clock::now();
+
+  // the metadata of different collections is independent, so it can be
+  // loaded in any order
+  std::atomic<std::size_t> next{0};
+  // the first exception thrown by any thread, rethrown at the end
+  std::mutex exceptionMutex;
+  std::exception_ptr exception;
+
+  auto loadMetadata = [&]() noexcept {
+    std::size_t i;
+    while ((i = next.fetch_add(1, std::memory_order_relaxed)) <
+           collections.size()) {
+      auto const& collection = collections[i];
+      auto phy = static_cast<RocksDBCollection*>(collection->getPhysical());
+      TRI_ASSERT(phy != nullptr);
+      try {
+        Result r = phy->meta().deserializeMeta(_db, *collection);
+        if (r.fail()) {
+          LOG_TOPIC("4a404", ERR, arangodb::Logger::ENGINES)
+              << "error while "
+              << "loading metadata of collection '" << vocbase.name() << "/"
+              << collection->name() << "': " << r.errorMessage();
+        }
+      } catch (...) {
+        std::lock_guard guard{exceptionMutex};
+        if (exception == nullptr) {
+          exception = std::current_exception();
+        }
+        // make all threads stop
+        next.store(collections.size(), std::memory_order_relaxed);
+      }
+    }
+  };
+
+  std::size_t numThreads = std::min<std::size_t>(
+      _metadataLoadingThreads, collections.size() / 4);
+  std::vector<std::thread> threads;
+  threads.reserve(numThreads);
+  auto joinThreads = scopeGuard([&]() noexcept {
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  });
+  try {
+    // the current thread is one of the loading threads
+    for (std::size_t i = 1; i < numThreads; ++i) {
+      threads.emplace_back(loadMetadata);
+    }
+  } catch (...) {
+    // we could not start all threads. the ones that were started and the
+    // current thread load the metadata of all collections
+  }
+  loadMetadata();
+  joinThreads.fire();
+
+  if (exception != nullptr) {
+    std::rethrow_exception(exception);
+  }
+
+  auto const elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - start);
+  _metricsMetadataLoadingTime += static_cast<uint64_t>(elapsed.count());
+  LOG_TOPIC("1c8e4", DEBUG, arangodb::Logger::ENGINES)
+      << "loaded metadata of " << collections.size()
+      << " collection(s) in database '" << vocbase.name() << "' with "
+      << (threads.size() + 1) << " thread(s) in "
+      << elapsed.count() << " ms";
+}
+
 std::unique_ptr<TRI_vocbase_t> RocksDBEngine::openExistingDatabase(
     CreateDatabaseInfo&& info, bool wasCleanShutdown, bool isUpgrade) {
   auto vocbase = std::make_unique<TRI_vocbase_t>(std::move(info));
@@ -3126,6 +3388,9 @@ std::unique_ptr<TRI_vocbase_t> RocksDBEngine::openExistingDatabase(
         << "processing collections metadata in database '" << vocbase->name()
         << "': " << slice.toJson();
 
+    std::vector<std::shared_ptr<LogicalCollection>> collections;
+    collections.reserve(slice.length());
+
     for (VPackSlice it : VPackArrayIterator(slice)) {
       // we found a collection that is still active
       LOG_TOPIC("b2ef2", TRACE, arangodb::Logger::ENGINES)
@@ -3137,16 +3402,7 @@ std::unique_ptr<TRI_vocbase_t> RocksDBEngine::openExistingDatabase(
 
       auto collection = vocbase->createCollectionObject(it, /*isAStub*/ false);
       TRI_ASSERT(collection != nullptr);
-
-      auto phy = static_cast<RocksDBCollection*>(collection->getPhysical());
-      TRI_ASSERT(phy != nullptr);
-      Result r = phy->meta().deserializeMeta(_db, *collection);
-      if (r.fail()) {
-        LOG_TOPIC("4a404", ERR, arangodb::Logger::ENGINES)
-            << "error while "
-            << "loading metadata of collection '" << vocbase->name() << "/"
-            << collection->name() << "': " << r.errorMessage();
-      }
+      collections.emplace_back(collection);
 
       StorageEngine::registerCollection(*vocbase, collection);
       LOG_TOPIC("39404", DEBUG, arangodb::Logger::ENGINES)
@@ -3159,6 +3415,8 @@ std::unique_ptr<TRI_vocbase_t> RocksDBEngine::openExistingDatabase(
             collection->replicatedStateId(), collection);
       }
     }
+
+    loadCollectionsMetadata(*vocbase, collections);
   } catch (std::exception const& ex) {
     LOG_TOPIC("8d427", ERR, arangodb::Logger::ENGINES)
         << "error while opening database '" << vocbase->name()
@@ -3535,6 +3793,28 @@ void RocksDBEngine::getStatistics(VPackBuilder& builder) const {
 #endif
 
   addIntAllCf(rocksdb::DB::Properties::kTotalSstFilesSize);
+
+  if (!_dbOptions.db_paths.empty()) {
+    // sizes of the live .sst files per data path
+    std::vector<uint64_t> sizes(_dbOptions.db_paths.size(), 0);
+    std::vector<rocksdb::LiveFileMetaData> files;
+    _db->GetLiveFilesMetaData(&files);
+    for (auto const& file : files) {
+      for (size_t i = 0; i < _dbOptions.db_paths.size(); ++i) {
+        if (file.db_path == _dbOptions.db_paths[i].path) {
+          sizes[i] += file.size;
+          break;
+        }
+      }
+    }
+    for (size_t i = 0; i < _dbOptions.db_paths.size(); ++i) {
+      builder.add(absl::StrCat("rocksdb.data-path-", i, "-live-sst-files-size"),
+                  VPackValue(sizes[i]));
+      builder.add(absl::StrCat("rocksdb.data-path-", i, "-target-size"),
+                  VPackValue(_dbOptions.db_paths[i].target_size));
+    }
+  }
+
   addInt(rocksdb::DB::Properties::kActualDelayedWriteRate);
   addInt(rocksdb::DB::Properties::kIsWriteStopped);
 
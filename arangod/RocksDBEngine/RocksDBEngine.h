@@ -71,6 +71,7 @@ struct IAsyncLogWriteBatcher;
 class PhysicalCollection;
 class RocksDBBackgroundErrorListener;
 class RocksDBBackgroundThread;
+class RocksDBRateLimitController;
 class RocksDBDumpManager;
 class RocksDBKey;
 class RocksDBLogValue;
@@ -171,6 +172,9 @@ class RocksDBEngine final : public StorageEngine {
   void unprepare() override;
 
   void flushOpenFilesIfRequired();
+  // adjust the rate limit for flushes and compactions to the latency of
+  // foreground operations, if configured
+  void adjustRateLimit();
   HealthData healthCheck() override;
 
   std::unique_ptr<transaction::Manager> createTransactionManager(
@@ -394,6 +398,10 @@ class RocksDBEngine final : public StorageEngine {
   void trackRevisionTreeMemoryIncrease(std::uint64_t value) noexcept;
   void trackRevisionTreeMemoryDecrease(std::uint64_t value) noexcept;
 
+  /// @brief whether the revision trees of all collections together use more
+  /// memory than configured via --rocksdb.revision-tree-memory-limit
+  bool revisionTreeMemoryLimitExceeded() const noexcept;
+
   void trackRevisionTreeBufferedMemoryIncrease(std::uint64_t value) noexcept;
   void trackRevisionTreeBufferedMemoryDecrease(std::uint64_t value) noexcept;
 
@@ -404,6 +412,11 @@ class RocksDBEngine final : public StorageEngine {
     return _metricsIndexEstimatorMemoryUsage;
   }
 
+  metrics::Gauge<uint64_t>& transactionsWriteMemoryUsageMetric()
+      const noexcept {
+    return _metricsTransactionsWriteMemoryUsage;
+  }
+
 #ifdef USE_ENTERPRISE
   bool encryptionKeyRotationEnabled() const;
 
@@ -525,6 +538,11 @@ class RocksDBEngine final : public StorageEngine {
   std::unique_ptr<TRI_vocbase_t> openExistingDatabase(CreateDatabaseInfo&& info,
                                                       bool wasCleanShutdown,
                                                       bool isUpgrade);
+  /// @brief load counts, key generator state, index estimates and revision
+  /// trees of the collections, using up to _metadataLoadingThreads threads
+  void loadCollectionsMetadata(
+      TRI_vocbase_t& vocbase,
+      std::vector<std::shared_ptr<LogicalCollection>> const& collections);
 
   std::string getCompressionSupport() const;
 
@@ -582,6 +600,14 @@ class RocksDBEngine final : public StorageEngine {
 
   uint64_t _maxParallelCompactions;
 
+  // maximum number of threads used for loading collection metadata when
+  // opening a database
+  uint64_t _metadataLoadingThreads;
+
+  // memory usage of all revision trees above which idle trees are
+  // hibernated eagerly (0 = no limit)
+  uint64_t _revisionTreeMemoryLimit;
+
   // hook-ins for recovery process
   static std::vector<std::shared_ptr<RocksDBRecoveryHelper>> _recoveryHelpers;
 
@@ -623,6 +649,11 @@ class RocksDBEngine final : public StorageEngine {
   // will trigger a warning (in milliseconds)
   uint64_t _syncDelayThreshold;
 
+  // time a WAL sync for a transaction with waitForSync waits for other
+  // transactions to commit, so that they are synced together (in
+  // microseconds)
+  uint64_t _syncGroupDelay;
+
   /// @brief minimum required percentage of free disk space for considering the
   /// server "healthy". this is expressed as a floating point value between 0
   /// and 1! if set to 0.0, the % amount of free disk is ignored in checks.
@@ -735,6 +766,14 @@ class RocksDBEngine final : public StorageEngine {
   // an auto-flush
   uint64_t _autoFlushMinWalFiles;
 
+  // adjusts the rate limit for flushes and compactions. only set if
+  // --rocksdb.rate-limit-target-latency is used
+  std::unique_ptr<RocksDBRateLimitController> _rateLimitController;
+  // number and total latency of reads and writes at the last rate limit
+  // adjustment
+  uint64_t _rateLimitLastCount = 0;
+  uint64_t _rateLimitLastLatencySum = 0;
+
   metrics::Gauge<uint64_t>& _metricsIndexEstimatorMemoryUsage;
   metrics::Gauge<uint64_t>& _metricsWalReleasedTickFlush;
   metrics::Gauge<uint64_t>& _metricsWalSequenceLowerBound;
@@ -746,10 +785,15 @@ class RocksDBEngine final : public StorageEngine {
   metrics::Gauge<uint64_t>& _metricsWalPruningActive;
   metrics::Gauge<uint64_t>& _metricsTreeMemoryUsage;
   metrics::Gauge<uint64_t>& _metricsTreeBufferedMemoryUsage;
+  metrics::Gauge<uint64_t>& _metricsTransactionsWriteMemoryUsage;
   metrics::Counter& _metricsTreeRebuildsSuccess;
   metrics::Counter& _metricsTreeRebuildsFailure;
   metrics::Counter& _metricsTreeHibernations;
   metrics::Counter& _metricsTreeResurrections;
+  metrics::Counter& _metricsMetadataLoadingTime;
+  metrics::Gauge<uint64_t>& _metricsRateLimit;
+  metrics::Counter& _metricsRateLimitIncreases;
+  metrics::Counter& _metricsRateLimitDecreases;
 
   // total size of uncompressed values for the edge cache
   metrics::Counter& _metricsEdgeCacheEntriesSizeInitial;
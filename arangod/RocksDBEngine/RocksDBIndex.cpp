@@ -306,6 +306,11 @@ Result RocksDBIndex::update(transaction::Methods& trx, RocksDBMethods* mthd,
 void RocksDBIndex::refillCache(transaction::Methods& trx,
                                std::vector<std::string> const& /*keys*/) {}
 
+std::vector<std::string> RocksDBIndex::recentCacheKeys(
+    std::size_t /*maxKeys*/) const {
+  return {};
+}
+
 /// @brief return the memory usage of the index
 size_t RocksDBIndex::memory() const {
   rocksdb::TransactionDB* db = _engine.db();
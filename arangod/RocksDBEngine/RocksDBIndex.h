@@ -152,6 +152,10 @@ class RocksDBIndex : public Index {
   virtual void refillCache(transaction::Methods& trx,
                            std::vector<std::string> const& keys);
 
+  // returns up to maxKeys of the most recently used keys in the in-memory
+  // cache, in the format that refillCache() expects
+  virtual std::vector<std::string> recentCacheKeys(std::size_t maxKeys) const;
+
   rocksdb::ColumnFamilyHandle* columnFamily() const { return _cf; }
 
   rocksdb::Comparator const* comparator() const;
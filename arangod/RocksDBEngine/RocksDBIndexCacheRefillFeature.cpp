@@ -25,8 +25,11 @@
 
 #include "ApplicationFeatures/ApplicationServer.h"
 #include "Basics/Exceptions.h"
+#include "Basics/FileUtils.h"
 #include "Basics/NumberOfCores.h"
 #include "Basics/ScopeGuard.h"
+#include "Basics/StringUtils.h"
+#include "Basics/VelocyPackHelper.h"
 #include "Basics/application-exit.h"
 #include "Basics/voc-errors.h"
 #include "Cluster/ServerState.h"
@@ -38,7 +41,9 @@
 #include "ProgramOptions/ProgramOptions.h"
 #include "RestServer/BootstrapFeature.h"
 #include "RestServer/DatabaseFeature.h"
+#include "RestServer/DatabasePathFeature.h"
 #include "RocksDBEngine/RocksDBEngine.h"
+#include "RocksDBEngine/RocksDBIndex.h"
 #include "RocksDBEngine/RocksDBIndexCacheRefillThread.h"
 #include "Scheduler/Scheduler.h"
 #include "Scheduler/SchedulerFeature.h"
@@ -47,6 +52,13 @@
 #include "VocBase/Methods/Collections.h"
 #include "VocBase/Methods/Databases.h"
 
+#include <velocypack/Builder.h>
+#include <velocypack/Iterator.h>
+#include <velocypack/Slice.h>
+
+#include <algorithm>
+#include <chrono>
+
 using namespace arangodb;
 
 namespace {
@@ -58,6 +70,17 @@ size_t defaultConcurrentIndexFillTasks() {
   return 1;
 }
 
+// name of the file in the database directory that keeps the most recently
+// used index cache keys between a shutdown and the next startup
+constexpr std::string_view savedCacheKeysFilename = "index-cache-keys.json";
+
+// number of saved keys that are handed over to the refill thread at once.
+// this is capped, so the regular refilling after modifications can still
+// queue keys while the saved keys are being refilled
+size_t savedCacheKeysChunkSize(size_t maxCapacity) noexcept {
+  return std::max<size_t>(1, std::min<size_t>(1000, maxCapacity / 4));
+}
+
 }  // namespace
 
 DECLARE_COUNTER(rocksdb_cache_full_index_refills_total,
@@ -71,6 +94,8 @@ RocksDBIndexCacheRefillFeature::RocksDBIndexCacheRefillFeature(Server& server)
       _autoRefill(false),
       _fillOnStartup(false),
       _autoRefillOnFollowers(true),
+      _saveCacheKeys(false),
+      _maxSavedCacheKeys(128 * 1024),
       _totalFullIndexRefills(server.getFeature<metrics::MetricsFeature>().add(
           rocksdb_cache_full_index_refills_total{})),
       _currentlyRunningIndexFillTasks(0) {
@@ -180,6 +205,42 @@ index cache filling, but the longer it takes to complete.)");
       .setLongDescription(R"(Set this to `false` to only (re-)fill in-memory
 index caches on leaders and save memory on followers. 
 Note that the value of this option should be identical for all DBServers.)");
+
+  options
+      ->addOption("--rocksdb.save-index-cache-keys",
+                  "Whether to save the most recently used keys of the "
+                  "in-memory edge index caches on shutdown, and to refill the "
+                  "caches with them on the next startup.",
+                  new options::BooleanParameter(&_saveCacheKeys),
+                  arangodb::options::makeFlags(
+                      options::Flags::DefaultNoComponents,
+                      options::Flags::OnDBServer, options::Flags::OnSingle))
+      .setIntroducedIn(31200)
+      .setLongDescription(R"(After a restart, the in-memory index caches are
+empty, and graph traversals are slow until the caches are warm again. Filling
+the caches completely on startup via
+`--rocksdb.auto-fill-index-caches-on-startup` can take long for large edge
+collections, and fills the caches with entries that are never used.
+
+If this option is enabled, the most recently used keys of every edge index
+cache are written to a file in the database directory on shutdown. On the next
+startup, these keys are handed over to the background refill thread in chunks,
+most recently used keys first and in turns for all indexes. The refilling only
+proceeds while the refill thread is not busy, so that it does not slow down
+the refilling after document modifications.
+
+The saved keys are not used if `--rocksdb.auto-fill-index-caches-on-startup`
+is enabled, as the caches are then filled completely anyway.)");
+
+  options
+      ->addOption("--rocksdb.max-saved-index-cache-keys",
+                  "The maximum number of keys to save per index on shutdown "
+                  "if `--rocksdb.save-index-cache-keys` is enabled.",
+                  new options::SizeTParameter(&_maxSavedCacheKeys),
+                  arangodb::options::makeFlags(
+                      options::Flags::DefaultNoComponents,
+                      options::Flags::OnDBServer, options::Flags::OnSingle))
+      .setIntroducedIn(31200);
 }
 
 void RocksDBIndexCacheRefillFeature::beginShutdown() {
@@ -187,6 +248,11 @@ void RocksDBIndexCacheRefillFeature::beginShutdown() {
     std::unique_lock lock(_indexFillTasksMutex);
     _indexFillTasks.clear();
   }
+  {
+    std::lock_guard guard(_savedCacheKeysMutex);
+    _savedCacheKeys.clear();
+    _savedCacheKeysWorkItem.reset();
+  }
   if (_refillThread != nullptr) {
     _refillThread->beginShutdown();
   }
@@ -207,13 +273,35 @@ void RocksDBIndexCacheRefillFeature::start() {
     FATAL_ERROR_EXIT();
   }
 
+  if (_saveCacheKeys) {
+    loadSavedCacheKeys();
+  }
+
   if (_fillOnStartup) {
     buildStartupIndexRefillTasks();
     scheduleIndexRefillTasks();
+  } else {
+    refillSavedCacheKeys();
   }
 }
 
-void RocksDBIndexCacheRefillFeature::stop() { stopThread(); }
+void RocksDBIndexCacheRefillFeature::stop() {
+  {
+    // reset again, as there may be a race between beginShutdown and
+    // the execution of the deferred _savedCacheKeysWorkItem
+    std::lock_guard guard(_savedCacheKeysMutex);
+    _savedCacheKeys.clear();
+    _savedCacheKeysWorkItem.reset();
+  }
+
+  if (_saveCacheKeys && !ServerState::instance()->isCoordinator()) {
+    // the caches are still intact here, as the cache manager is stopped
+    // later
+    saveCacheKeys();
+  }
+
+  stopThread();
+}
 
 bool RocksDBIndexCacheRefillFeature::autoRefill() const noexcept {
   return _autoRefill;
@@ -360,6 +448,206 @@ void RocksDBIndexCacheRefillFeature::scheduleIndexRefillTasks() {
   }
 }
 
+std::string RocksDBIndexCacheRefillFeature::savedCacheKeysFile() const {
+  return server().getFeature<DatabasePathFeature>().subdirectoryName(
+      std::string{::savedCacheKeysFilename});
+}
+
+void RocksDBIndexCacheRefillFeature::saveCacheKeys() {
+  TRI_ASSERT(!ServerState::instance()->isCoordinator());
+
+  velocypack::Builder builder;
+  size_t total = 0;
+
+  builder.openArray();
+  for (auto const& database : methods::Databases::list(server(), "")) {
+    try {
+      DatabaseGuard guard(_databaseFeature, database);
+
+      methods::Collections::enumerate(
+          &guard.database(),
+          [&](std::shared_ptr<LogicalCollection> const& collection) {
+            auto indexes = collection->getIndexes();
+            for (auto const& index : indexes) {
+              if (!index->canWarmup()) {
+                // index has no cache
+                continue;
+              }
+
+              auto keys = static_cast<RocksDBIndex const*>(index.get())
+                              ->recentCacheKeys(_maxSavedCacheKeys);
+              if (keys.empty()) {
+                continue;
+              }
+
+              builder.openObject();
+              builder.add("database", velocypack::Value(database));
+              builder.add("collection", velocypack::Value(collection->name()));
+              builder.add("index", velocypack::Value(
+                                       std::to_string(index->id().id())));
+              builder.add("keys",
+                          velocypack::Value(velocypack::ValueType::Array));
+              for (auto const& key : keys) {
+                builder.add(velocypack::Value(key));
+              }
+              builder.close();
+              builder.close();
+              total += keys.size();
+            }
+          });
+    } catch (...) {
+      // must ignore any errors here in case a database or collection
+      // got deleted in the meantime
+    }
+  }
+  builder.close();
+
+  if (total == 0) {
+    return;
+  }
+
+  std::string file = savedCacheKeysFile();
+  if (!basics::VelocyPackHelper::velocyPackToFile(file, builder.slice(),
+                                                  /*syncFile*/ true)) {
+    LOG_TOPIC("3a9c1", WARN, Logger::ENGINES)
+        << "unable to save index cache keys to file '" << file << "'";
+    return;
+  }
+
+  LOG_TOPIC("c82d0", INFO, Logger::ENGINES)
+      << "saved " << total << " index cache keys to file '" << file << "'";
+}
+
+void RocksDBIndexCacheRefillFeature::loadSavedCacheKeys() {
+  TRI_ASSERT(!ServerState::instance()->isCoordinator());
+
+  std::string file = savedCacheKeysFile();
+  if (!basics::FileUtils::exists(file)) {
+    return;
+  }
+
+  velocypack::Builder builder;
+  try {
+    builder = basics::VelocyPackHelper::velocyPackFromFile(file);
+  } catch (std::exception const& ex) {
+    LOG_TOPIC("e2b57", WARN, Logger::ENGINES)
+        << "unable to load index cache keys from file '" << file
+        << "': " << ex.what();
+  }
+
+  // the keys are only valid for the next startup. if we kept the file,
+  // a later startup could use keys from a much older shutdown
+  if (auto res = basics::FileUtils::remove(file); res != TRI_ERROR_NO_ERROR) {
+    LOG_TOPIC("95dfe", WARN, Logger::ENGINES)
+        << "unable to remove index cache keys file '" << file << "'";
+  }
+
+  velocypack::Slice entries = builder.slice();
+  if (_fillOnStartup || !entries.isArray()) {
+    return;
+  }
+
+  size_t const chunkSize = ::savedCacheKeysChunkSize(_maxCapacity);
+
+  // split the keys of all indexes into chunks, and interleave the chunks of
+  // all indexes. the keys of each index are sorted from most recently used
+  // to least recently used, so the hottest keys of all indexes come first
+  std::vector<SavedCacheKeys> chunks;
+  size_t total = 0;
+  for (size_t offset = 0; /* will break */; offset += chunkSize) {
+    bool added = false;
+    for (velocypack::Slice entry : velocypack::ArrayIterator(entries)) {
+      if (!entry.isObject()) {
+        continue;
+      }
+      velocypack::Slice database = entry.get("database");
+      velocypack::Slice collection = entry.get("collection");
+      velocypack::Slice iid = entry.get("index");
+      velocypack::Slice keys = entry.get("keys");
+      if (!database.isString() || !collection.isString() || !iid.isString() ||
+          !keys.isArray() || keys.length() <= offset) {
+        continue;
+      }
+
+      SavedCacheKeys chunk{database.copyString(), collection.copyString(),
+                           IndexId{basics::StringUtils::uint64(
+                               iid.stringView())},
+                           {}};
+      size_t const end = std::min<size_t>(offset + chunkSize, keys.length());
+      for (size_t i = offset; i < end; ++i) {
+        velocypack::Slice key = keys.at(i);
+        if (key.isString()) {
+          chunk.keys.emplace_back(key.copyString());
+        }
+      }
+      added = true;
+      if (!chunk.keys.empty()) {
+        total += chunk.keys.size();
+        chunks.emplace_back(std::move(chunk));
+      }
+    }
+    if (!added) {
+      break;
+    }
+  }
+
+  LOG_TOPIC("0f4a6", INFO, Logger::ENGINES)
+      << "refilling index caches with " << total
+      << " keys saved on last shutdown";
+
+  // the next chunk to refill must be at the back
+  std::reverse(chunks.begin(), chunks.end());
+
+  std::lock_guard guard(_savedCacheKeysMutex);
+  _savedCacheKeys = std::move(chunks);
+}
+
+void RocksDBIndexCacheRefillFeature::refillSavedCacheKeys() {
+  TRI_ASSERT(!ServerState::instance()->isCoordinator());
+
+  size_t const chunkSize = ::savedCacheKeysChunkSize(_maxCapacity);
+
+  while (!server().isStopping()) {
+    size_t numQueued = _refillThread->numQueued();
+    if (numQueued > 0 && numQueued + chunkSize > _maxCapacity / 2) {
+      // the refill thread is busy. try again later, so that we do not use
+      // up the capacity for the refilling after document modifications
+      std::lock_guard guard(_savedCacheKeysMutex);
+      if (!_savedCacheKeys.empty()) {
+        _savedCacheKeysWorkItem = SchedulerFeature::SCHEDULER->queueDelayed(
+            "refill-saved-index-cache-keys", RequestLane::INTERNAL_LOW,
+            std::chrono::milliseconds(100), [this](bool canceled) {
+              if (!canceled) {
+                refillSavedCacheKeys();
+              }
+            });
+      }
+      return;
+    }
+
+    SavedCacheKeys chunk;
+    {
+      std::lock_guard guard(_savedCacheKeysMutex);
+      if (_savedCacheKeys.empty()) {
+        return;
+      }
+      chunk = std::move(_savedCacheKeys.back());
+      _savedCacheKeys.pop_back();
+    }
+
+    try {
+      DatabaseGuard guard(_databaseFeature, chunk.database);
+      auto collection = guard.database().lookupCollection(chunk.collection);
+      if (collection != nullptr) {
+        trackRefill(collection, chunk.iid, std::move(chunk.keys));
+      }
+    } catch (...) {
+      // must ignore any errors here in case a database or collection
+      // got deleted in the meantime
+    }
+  }
+}
+
 Result RocksDBIndexCacheRefillFeature::warmupIndex(
     std::string const& database, std::string const& collection, IndexId iid) {
   auto& df = server().getFeature<DatabaseFeature>();
@@ -26,6 +26,7 @@
 #include "Basics/Result.h"
 #include "Metrics/Fwd.h"
 #include "RestServer/arangod.h"
+#include "Scheduler/Scheduler.h"
 #include "VocBase/Identifiers/IndexId.h"
 
 #include <memory>
@@ -94,6 +95,20 @@ class RocksDBIndexCacheRefillFeature final : public ArangodFeature {
   Result warmupIndex(std::string const& database, std::string const& collection,
                      IndexId iid);
 
+  std::string savedCacheKeysFile() const;
+
+  // save the most recently used keys of all index caches to a file
+  void saveCacheKeys();
+
+  // load the keys saved on the last shutdown into _savedCacheKeys, and
+  // remove the file
+  void loadSavedCacheKeys();
+
+  // hand the saved keys over to the refill thread, in chunks and only while
+  // the refill thread is not busy. reschedules itself until all saved keys
+  // have been handed over
+  void refillSavedCacheKeys();
+
   DatabaseFeature& _databaseFeature;
 
   // index refill thread used for auto-refilling after insert/update/replace
@@ -121,6 +136,13 @@ class RocksDBIndexCacheRefillFeature final : public ArangodFeature {
   // refilled on followers
   bool _autoRefillOnFollowers;
 
+  // whether or not the most recently used keys of the in-memory index caches
+  // are saved on shutdown and used to refill the caches on startup
+  bool _saveCacheKeys;
+
+  // maximum number of keys to save per index
+  size_t _maxSavedCacheKeys;
+
   // total number of full index refills completed
   metrics::Counter& _totalFullIndexRefills;
 
@@ -135,5 +157,20 @@ class RocksDBIndexCacheRefillFeature final : public ArangodFeature {
   std::vector<IndexFillTask> _indexFillTasks;
 
   size_t _currentlyRunningIndexFillTasks;
+
+  // protects _savedCacheKeys and _savedCacheKeysWorkItem
+  std::mutex _savedCacheKeysMutex;
+
+  struct SavedCacheKeys {
+    std::string database;
+    std::string collection;
+    IndexId iid;
+    std::vector<std::string> keys;
+  };
+  // chunks of saved keys that still need to be refilled. the chunk to refill
+  // next is at the back
+  std::vector<SavedCacheKeys> _savedCacheKeys;
+
+  Scheduler::WorkHandle _savedCacheKeysWorkItem;
 };
 }  // namespace arangodb
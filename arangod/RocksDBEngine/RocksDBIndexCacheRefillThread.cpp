@@ -140,6 +140,11 @@ void RocksDBIndexCacheRefillThread::waitForCatchup() {
   }
 }
 
+size_t RocksDBIndexCacheRefillThread::numQueued() {
+  std::lock_guard guard{_condition.mutex};
+  return _numQueued;
+}
+
 void RocksDBIndexCacheRefillThread::refill(TRI_vocbase_t& vocbase,
                                            DataSourceId cid,
                                            IndexValues const& data) {
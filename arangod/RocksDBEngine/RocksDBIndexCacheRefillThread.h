@@ -57,6 +57,9 @@ class RocksDBIndexCacheRefillThread final : public ServerThread<ArangodServer> {
 
   void waitForCatchup();
 
+  // number of keys currently queued for refilling
+  size_t numQueued();
+
  protected:
   void run() override;
 
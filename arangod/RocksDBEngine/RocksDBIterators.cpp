@@ -50,10 +50,9 @@ class RocksDBAllIndexIterator final : public IndexIterator {
  public:
   RocksDBAllIndexIterator(LogicalCollection* collection,
                           transaction::Methods* trx,
-                          ReadOwnWrites readOwnWrites)
+                          ReadOwnWrites readOwnWrites, RocksDBKeyBounds bounds)
       : IndexIterator(collection, trx, readOwnWrites),
-        _bounds(static_cast<RocksDBMetaCollection*>(collection->getPhysical())
-                    ->bounds()),
+        _bounds(std::move(bounds)),
         _upperBound(_bounds.end()),
         _cmp(_bounds.columnFamily()->GetComparator()),
         _mustSeek(true) {
@@ -471,15 +470,24 @@ namespace arangodb::rocksdb_iterators {
 std::unique_ptr<IndexIterator> createAllIterator(LogicalCollection* collection,
                                                  transaction::Methods* trx,
                                                  ReadOwnWrites readOwnWrites) {
+  return createRangeIterator(
+      collection, trx, readOwnWrites,
+      static_cast<RocksDBMetaCollection*>(collection->getPhysical())
+          ->bounds());
+}
+
+std::unique_ptr<IndexIterator> createRangeIterator(
+    LogicalCollection* collection, transaction::Methods* trx,
+    ReadOwnWrites readOwnWrites, RocksDBKeyBounds bounds) {
   bool mustCheckBounds =
       RocksDBTransactionState::toState(trx)->iteratorMustCheckBounds(
           collection->id(), readOwnWrites);
   if (mustCheckBounds) {
-    return std::make_unique<RocksDBAllIndexIterator<true>>(collection, trx,
-                                                           readOwnWrites);
+    return std::make_unique<RocksDBAllIndexIterator<true>>(
+        collection, trx, readOwnWrites, std::move(bounds));
   }
-  return std::make_unique<RocksDBAllIndexIterator<false>>(collection, trx,
-                                                          readOwnWrites);
+  return std::make_unique<RocksDBAllIndexIterator<false>>(
+      collection, trx, readOwnWrites, std::move(bounds));
 }
 
 std::unique_ptr<IndexIterator> createAnyIterator(LogicalCollection* collection,
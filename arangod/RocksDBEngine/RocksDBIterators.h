@@ -80,6 +80,12 @@ std::unique_ptr<IndexIterator> createAllIterator(LogicalCollection* collection,
                                                  transaction::Methods* trx,
                                                  ReadOwnWrites readOwnWrites);
 
+/// @brief iterator over the documents of the collection within the bounds,
+/// in the order of their LocalDocumentIds
+std::unique_ptr<IndexIterator> createRangeIterator(
+    LogicalCollection* collection, transaction::Methods* trx,
+    ReadOwnWrites readOwnWrites, RocksDBKeyBounds bounds);
+
 std::unique_ptr<IndexIterator> createAnyIterator(LogicalCollection* collection,
                                                  transaction::Methods* trx);
 }  // namespace rocksdb_iterators
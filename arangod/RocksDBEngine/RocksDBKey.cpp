@@ -316,6 +316,18 @@ void RocksDBKey::constructRevisionTreeValue(uint64_t collectionObjectId) {
   TRI_ASSERT(_buffer->size() == keyLength);
 }
 
+void RocksDBKey::constructCollectionStatisticsValue(
+    uint64_t collectionObjectId) {
+  TRI_ASSERT(collectionObjectId != 0);
+  _type = RocksDBEntryType::CollectionStatisticsValue;
+  size_t keyLength = sizeof(char) + sizeof(uint64_t);
+  _buffer->clear();
+  _buffer->reserve(keyLength);
+  _buffer->push_back(static_cast<char>(_type));
+  uint64ToPersistent(*_buffer, collectionObjectId);
+  TRI_ASSERT(_buffer->size() == keyLength);
+}
+
 void RocksDBKey::constructLogEntry(uint64_t objectId,
                                    replication2::LogIndex idx) {
   TRI_ASSERT(objectId != 0);
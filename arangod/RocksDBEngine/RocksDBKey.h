@@ -179,6 +179,12 @@ class RocksDBKey {
   //////////////////////////////////////////////////////////////////////////////
   void constructRevisionTreeValue(uint64_t objectId);
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Create a fully-specified key for the attribute statistics of a
+  ///        collection
+  //////////////////////////////////////////////////////////////////////////////
+  void constructCollectionStatisticsValue(uint64_t objectId);
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief Create a fully-specified key for zkd index
   //////////////////////////////////////////////////////////////////////////////
@@ -340,6 +346,7 @@ class RocksDBKey {
       case RocksDBEntryType::ReplicationApplierConfig:
       case RocksDBEntryType::IndexEstimateValue:
       case RocksDBEntryType::KeyGeneratorValue:
+      case RocksDBEntryType::CollectionStatisticsValue:
       case RocksDBEntryType::View:
       case RocksDBEntryType::ReplicatedState:
         return type;
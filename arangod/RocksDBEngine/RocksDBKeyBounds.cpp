@@ -261,6 +261,7 @@ rocksdb::ColumnFamilyHandle* RocksDBKeyBounds::columnFamily() const {
     case RocksDBEntryType::ReplicationApplierConfig:
     case RocksDBEntryType::IndexEstimateValue:
     case RocksDBEntryType::KeyGeneratorValue:
+    case RocksDBEntryType::CollectionStatisticsValue:
     case RocksDBEntryType::RevisionTreeValue:
     case RocksDBEntryType::View:
     case RocksDBEntryType::ReplicatedState:
@@ -322,7 +323,8 @@ RocksDBKeyBounds::RocksDBKeyBounds(RocksDBEntryType type) : _type(type) {
     }
     case RocksDBEntryType::CounterValue:
     case RocksDBEntryType::IndexEstimateValue:
-    case RocksDBEntryType::KeyGeneratorValue: {
+    case RocksDBEntryType::KeyGeneratorValue:
+    case RocksDBEntryType::CollectionStatisticsValue: {
       _internals.reserve(2 * (sizeof(char) + sizeof(uint64_t)));
       _internals.push_back(static_cast<char>(_type));
       uint64ToPersistent(_internals.buffer(), 0);
@@ -31,8 +31,10 @@
 #include "Basics/hashes.h"
 #include "Basics/system-functions.h"
 #include "Cluster/ServerState.h"
+#include "Containers/FlatHashSet.h"
 #include "Logger/LogMacros.h"
 #include "Random/RandomGenerator.h"
+#include "RestServer/DatabaseFeature.h"
 #include "RocksDBEngine/RocksDBColumnFamilyManager.h"
 #include "RocksDBEngine/RocksDBEngine.h"
 #include "RocksDBEngine/RocksDBFormat.h"
@@ -44,13 +46,17 @@
 #include "RocksDBEngine/RocksDBSettingsManager.h"
 #include "RocksDBEngine/RocksDBTransactionCollection.h"
 #include "RocksDBEngine/RocksDBTransactionState.h"
+#include "RocksDBEngine/RocksDBValue.h"
+#include "Scheduler/SchedulerFeature.h"
 #include "StorageEngine/EngineSelectorFeature.h"
 #include "Transaction/Context.h"
 #include "Transaction/Methods.h"
 #include "Transaction/StandaloneContext.h"
 #include "Utils/CollectionGuard.h"
+#include "Utils/DatabaseGuard.h"
 #include "Utils/OperationOptions.h"
 #include "Utils/SingleCollectionTransaction.h"
+#include "VocBase/CollectionStatistics.h"
 
 #include <velocypack/Iterator.h>
 
@@ -68,6 +74,31 @@ rocksdb::SequenceNumber forceWrite(RocksDBEngine& engine) {
   return engine.db()->GetLatestSequenceNumber();
 }
 
+void analyzeCollectionStatistics(ArangodServer& server,
+                                 TRI_voc_tick_t databaseId,
+                                 DataSourceId collectionId) {
+  if (server.isStopping()) {
+    return;
+  }
+  try {
+    DatabaseGuard guard(server.getFeature<DatabaseFeature>(), databaseId);
+    CollectionGuard collGuard(&guard.database(), collectionId);
+    auto* physical = static_cast<RocksDBMetaCollection*>(
+        collGuard.collection()->getPhysical());
+    physical->analyzeStatistics();
+  } catch (basics::Exception const& ex) {
+    if (ex.code() != TRI_ERROR_ARANGO_DATABASE_NOT_FOUND &&
+        ex.code() != TRI_ERROR_ARANGO_DATA_SOURCE_NOT_FOUND &&
+        ex.code() != TRI_ERROR_SHUTTING_DOWN) {
+      LOG_TOPIC("f3a27", WARN, Logger::ENGINES)
+          << "failed to analyze attribute statistics: " << ex.what();
+    }
+  } catch (std::exception const& ex) {
+    LOG_TOPIC("29c6e", WARN, Logger::ENGINES)
+        << "failed to analyze attribute statistics: " << ex.what();
+  }
+}
+
 }  // namespace
 
 RocksDBMetaCollection::RocksDBMetaCollection(LogicalCollection& collection,
@@ -286,6 +317,142 @@ uint64_t RocksDBMetaCollection::recalculateCounts() {
   return _meta.numberDocuments();
 }
 
+std::shared_ptr<CollectionStatistics const> RocksDBMetaCollection::statistics()
+    const {
+  auto stats = _meta.statistics();
+  if (!CollectionStatistics::needsAnalysis(stats.get(),
+                                           _meta.numberDocuments()) ||
+      _statisticsAnalysisQueued.exchange(true)) {
+    return stats;
+  }
+
+  TRI_vocbase_t& vocbase = _logicalCollection.vocbase();
+  bool queued = SchedulerFeature::SCHEDULER != nullptr &&
+                SchedulerFeature::SCHEDULER->tryBoundedQueue(
+                    RequestLane::INTERNAL_LOW,
+                    [&server = vocbase.server(), databaseId = vocbase.id(),
+                     collectionId = _logicalCollection.id()]() {
+                      ::analyzeCollectionStatistics(server, databaseId,
+                                                    collectionId);
+                    });
+  if (!queued) {
+    // try again later
+    _statisticsAnalysisQueued.store(false);
+  }
+  return stats;
+}
+
+void RocksDBMetaCollection::analyzeStatistics() {
+  auto releaser = scopeGuard(
+      [this]() noexcept { _statisticsAnalysisQueued.store(false); });
+
+  // statistics are collected for all top-level attributes and additionally
+  // for the (possibly nested) attributes of sorted and hash indexes
+  std::vector<std::vector<std::string>> attributes;
+  for (auto const& index : getIndexes()) {
+    auto type = index->type();
+    if (type != Index::TRI_IDX_TYPE_PERSISTENT_INDEX &&
+        type != Index::TRI_IDX_TYPE_HASH_INDEX &&
+        type != Index::TRI_IDX_TYPE_SKIPLIST_INDEX) {
+      continue;
+    }
+    for (auto const& field : index->fields()) {
+      if (field.size() <= 1 || basics::TRI_AttributeNamesHaveExpansion(field)) {
+        continue;
+      }
+      std::vector<std::string> attribute;
+      for (auto const& part : field) {
+        attribute.emplace_back(part.name);
+      }
+      attributes.emplace_back(std::move(attribute));
+    }
+  }
+
+  CollectionStatisticsBuilder builder(std::move(attributes));
+
+  rocksdb::TransactionDB* db = _engine.db();
+  rocksdb::Snapshot const* snapshot = db->GetSnapshot();
+  auto snapshotGuard =
+      scopeGuard([&]() noexcept { db->ReleaseSnapshot(snapshot); });
+
+  uint64_t numberDocuments = _meta.numberDocuments();
+
+  RocksDBKeyBounds bounds = this->bounds();
+  rocksdb::Slice const upper(bounds.end());
+  rocksdb::ReadOptions ro;
+  ro.snapshot = snapshot;
+  ro.prefix_same_as_start = true;
+  ro.iterate_upper_bound = &upper;
+  ro.verify_checksums = false;
+  ro.fill_cache = false;
+
+  rocksdb::ColumnFamilyHandle* const cf = bounds.columnFamily();
+  std::unique_ptr<rocksdb::Iterator> it(db->NewIterator(ro, cf));
+
+  ArangodServer& server = _logicalCollection.vocbase().server();
+  auto checkAbort = [&]() {
+    if (server.isStopping()) {
+      THROW_ARANGO_EXCEPTION(TRI_ERROR_SHUTTING_DOWN);
+    }
+    if (_logicalCollection.deleted()) {
+      THROW_ARANGO_EXCEPTION(TRI_ERROR_ARANGO_DATA_SOURCE_NOT_FOUND);
+    }
+  };
+
+  constexpr uint64_t sampleSize = 2048;
+  constexpr uint64_t documentsPerSeek = 8;
+
+  if (numberDocuments <= sampleSize) {
+    // small collection: look at all documents
+    for (it->Seek(bounds.start()); it->Valid(); it->Next()) {
+      builder.add(RocksDBValue::data(it->value()));
+    }
+  } else {
+    // large collection: seek to random positions between the lowest and
+    // the highest document id and read a few documents from each of them.
+    // this is biased towards documents following gaps in the ids, which is
+    // good enough for the purpose
+    it->Seek(bounds.start());
+    if (!it->Valid()) {
+      return;
+    }
+    uint64_t const lowest = RocksDBKey::documentId(it->key()).id();
+    it->SeekForPrev(bounds.end());
+    if (!it->Valid()) {
+      return;
+    }
+    uint64_t const highest = RocksDBKey::documentId(it->key()).id();
+    TRI_ASSERT(lowest <= highest);
+
+    containers::FlatHashSet<uint64_t> seen;
+    RocksDBKey key;
+    for (uint64_t i = 0; i < sampleSize / documentsPerSeek; ++i) {
+      checkAbort();
+      uint64_t id =
+          lowest + RandomGenerator::interval(uint64_t(highest - lowest));
+      key.constructDocument(objectId(), LocalDocumentId(id));
+      it->Seek(key.string());
+      for (uint64_t j = 0; j < documentsPerSeek && it->Valid();
+           ++j, it->Next()) {
+        if (seen.emplace(RocksDBKey::documentId(it->key()).id()).second) {
+          builder.add(RocksDBValue::data(it->value()));
+        }
+      }
+    }
+  }
+
+  if (!it->status().ok()) {
+    THROW_ARANGO_EXCEPTION(rocksutils::convertStatus(it->status()));
+  }
+
+  _meta.setStatistics(builder.finish(numberDocuments));
+
+  LOG_TOPIC("8b1f4", DEBUG, Logger::ENGINES)
+      << "analyzed attribute statistics of "
+      << _logicalCollection.vocbase().name() << "/"
+      << _logicalCollection.name();
+}
+
 void RocksDBMetaCollection::compact() {
   _engine.compactRange(bounds());
 
@@ -325,6 +492,23 @@ void RocksDBMetaCollection::estimateSize(velocypack::Builder& builder) {
   builder.close();
 }
 
+uint64_t RocksDBMetaCollection::approximateSize() {
+  rocksdb::TransactionDB* db = _engine.db();
+  RocksDBKeyBounds bounds = this->bounds();
+  rocksdb::Range r(bounds.start(), bounds.end());
+  uint64_t total = 0;
+
+  rocksdb::SizeApproximationOptions options{.include_memtables = true,
+                                            .include_files = true};
+  db->GetApproximateSizes(options, bounds.columnFamily(), &r, 1, &total);
+
+  RECURSIVE_READ_LOCKER(_indexesLock, _indexesLockWriteOwner);
+  for (std::shared_ptr<Index> i : _indexes) {
+    total += static_cast<RocksDBIndex*>(i.get())->memory();
+  }
+  return total;
+}
+
 void RocksDBMetaCollection::setRevisionTree(
     std::unique_ptr<containers::RevisionTree>&& tree, uint64_t seq) {
   TRI_ASSERT(_logicalCollection.useSyncByRevision());
@@ -336,6 +520,10 @@ void RocksDBMetaCollection::setRevisionTree(
 
   _revisionTree = std::make_unique<RevisionTreeAccessor>(std::move(tree),
                                                          _logicalCollection);
+  if (_engine.revisionTreeMemoryLimitExceeded()) {
+    // keep only the compressed form until the tree is needed
+    _revisionTree->hibernate(/*force*/ true);
+  }
   _revisionTreeApplied = seq;
   _revisionTreeCreationSeq = seq;
   _revisionTreeSerializedSeq = seq;
@@ -1768,7 +1956,8 @@ RocksDBMetaCollection::RevisionTreeAccessor::RevisionTreeAccessor(
       _logicalCollection(collection),
       _depth(_tree->depth()),
       _hibernationRequests(0),
-      _compressible(true) {
+      _compressible(true),
+      _lastAccess(std::chrono::steady_clock::now()) {
   TRI_ASSERT(_depth == revisionTreeDepth);
   TRI_ASSERT(_tree != nullptr);
 
@@ -1895,6 +2084,24 @@ void RocksDBMetaCollection::RevisionTreeAccessor::hibernate(bool force) {
   std::uint64_t count = _tree->count();
   auto oldMemoryUsage = _tree->memoryUsage();
 
+  RocksDBEngine& engine = _logicalCollection.vocbase()
+                              .server()
+                              .getFeature<EngineSelectorFeature>()
+                              .engine<RocksDBEngine>();
+
+  if (!force) {
+    auto now = std::chrono::steady_clock::now();
+
+    if (revisionTreeHibernationOverdue(
+            engine.revisionTreeMemoryLimitExceeded(), oldMemoryUsage,
+            _lastAccess, _lastHibernateAttempt, now)) {
+      // too much memory is used by revision trees, and this one has not
+      // been used for a while. hibernate it right away
+      force = true;
+      _lastHibernateAttempt = now;
+    }
+  }
+
   if (!force) {
     if (count >= 5'000'000) {
       // we have so many values in the tree that compressibility
@@ -1950,10 +2157,6 @@ void RocksDBMetaCollection::RevisionTreeAccessor::hibernate(bool force) {
   if (_compressed.size() * 2 < _tree->memoryUsage()) {
     // compression ratio ok.
     // remove tree from memory. now we only have _compressed
-    RocksDBEngine& engine = _logicalCollection.vocbase()
-                                .server()
-                                .getFeature<EngineSelectorFeature>()
-                                .engine<RocksDBEngine>();
     engine.trackRevisionTreeHibernation();
     engine.trackRevisionTreeMemoryIncrease(_compressed.size());
     engine.trackRevisionTreeMemoryDecrease(oldMemoryUsage);
@@ -1991,6 +2194,8 @@ void RocksDBMetaCollection::RevisionTreeAccessor::ensureTree() const {
   TRI_ASSERT((_tree == nullptr && !_compressed.empty()) ||
              (_tree != nullptr && _compressed.empty()));
 
+  _lastAccess = std::chrono::steady_clock::now();
+
   if (_tree == nullptr) {
     // build tree from compressed state
     TRI_ASSERT(!_compressed.empty());
@@ -2030,3 +2235,14 @@ void RocksDBMetaCollection::RevisionTreeAccessor::ensureTree() const {
   TRI_ASSERT(_tree != nullptr);
   TRI_ASSERT(_compressed.empty());
 }
+
+bool arangodb::revisionTreeHibernationOverdue(
+    bool memoryLimitExceeded, std::uint64_t treeMemoryUsage,
+    std::chrono::steady_clock::time_point lastAccess,
+    std::chrono::steady_clock::time_point lastHibernateAttempt,
+    std::chrono::steady_clock::time_point now) noexcept {
+  return memoryLimitExceeded && now - lastAccess >= std::chrono::seconds(10) &&
+         treeMemoryUsage > 256 &&
+         (lastHibernateAttempt.time_since_epoch().count() == 0 ||
+          now - lastHibernateAttempt >= std::chrono::minutes(1));
+}
@@ -33,6 +33,7 @@
 #include "VocBase/AccessMode.h"
 #include "VocBase/LogicalCollection.h"
 
+#include <atomic>
 #include <chrono>
 #include <functional>
 #include <map>
@@ -70,6 +71,14 @@ class RocksDBMetaCollection : public PhysicalCollection {
   /// for a short period
   uint64_t recalculateCounts() override;
 
+  /// @brief returns the current attribute statistics. if there are none yet
+  /// or they are outdated, an analysis is scheduled in the background
+  std::shared_ptr<CollectionStatistics const> statistics() const override;
+
+  /// @brief computes the attribute statistics from a sample of the
+  /// documents and stores them in the collection metadata
+  void analyzeStatistics();
+
   /// @brief compact-data operation
   /// triggers rocksdb compaction for documentDB and indexes
   void compact() override final;
@@ -77,6 +86,12 @@ class RocksDBMetaCollection : public PhysicalCollection {
   /// estimate size of collection and indexes
   void estimateSize(velocypack::Builder& builder);
 
+  uint64_t approximateSize() override;
+
+  uint64_t numberWrites() const noexcept override {
+    return _meta.numberWrites();
+  }
+
   void setRevisionTree(std::unique_ptr<containers::RevisionTree>&& tree,
                        uint64_t seq);
   std::unique_ptr<containers::RevisionTree> revisionTree(
@@ -195,6 +210,8 @@ class RocksDBMetaCollection : public PhysicalCollection {
   mutable basics::ReadWriteLock _exclusiveLock;
   /// @brief collection lock used for recalculation count values
   mutable std::mutex _recalculationLock;
+  /// @brief whether or not an analysis of the statistics is scheduled
+  mutable std::atomic<bool> _statisticsAnalysisQueued{false};
 
   /// @brief depth for all revision trees.
   /// depth is large from the beginning so that the trees are always
@@ -276,6 +293,9 @@ class RocksDBMetaCollection : public PhysicalCollection {
     /// @brief when we last tried to hibernate/compress the revision tree
     std::chrono::time_point<
         std::chrono::steady_clock> mutable _lastHibernateAttempt;
+
+    /// @brief when the tree was last accessed
+    std::chrono::time_point<std::chrono::steady_clock> mutable _lastAccess;
   };
 
   // The following rules/definitions apply:
@@ -324,4 +344,14 @@ class RocksDBMetaCollection : public PhysicalCollection {
   uint64_t _revisionsBufferedMemoryUsage;
 };
 
+/// @brief whether a revision tree is hibernated right away, because the
+/// revision trees of all collections use more memory than configured. only
+/// trees that have not been accessed for 10 seconds are hibernated, and
+/// only once per minute each
+bool revisionTreeHibernationOverdue(
+    bool memoryLimitExceeded, std::uint64_t treeMemoryUsage,
+    std::chrono::steady_clock::time_point lastAccess,
+    std::chrono::steady_clock::time_point lastHibernateAttempt,
+    std::chrono::steady_clock::time_point now) noexcept;
+
 }  // namespace arangodb
@@ -43,6 +43,7 @@
 #include "RocksDBEngine/RocksDBSettingsManager.h"
 #include "StorageEngine/EngineSelectorFeature.h"
 #include "Transaction/Context.h"
+#include "VocBase/CollectionStatistics.h"
 #include "VocBase/KeyGenerator.h"
 #include "VocBase/LogicalCollection.h"
 
@@ -537,10 +538,36 @@ Result RocksDBMetadata::serializeMeta(rocksdb::WriteBatch& batch,
     }
   }
 
+  // Step 4. store the attribute statistics
+  std::shared_ptr<CollectionStatistics const> statistics;
+  {
+    std::lock_guard guard{_statisticsLock};
+    if (_statisticsNeedToPersist || force) {
+      statistics = _statistics;
+      _statisticsNeedToPersist = false;
+    }
+  }
+  if (statistics != nullptr) {
+    tmp.clear();
+    statistics->toVelocyPack(tmp);
+    key.constructCollectionStatisticsValue(rcoll->objectId());
+    RocksDBValue value = RocksDBValue::CollectionStatisticsValue(tmp.slice());
+    rocksdb::Status s = batch.Put(cf, key.string(), value.string());
+    if (!s.ok()) {
+      LOG_TOPIC("5e1d2", WARN, Logger::ENGINES)
+          << context << ": writing attribute statistics failed";
+      {
+        std::lock_guard guard{_statisticsLock};
+        _statisticsNeedToPersist = true;
+      }
+      return res.reset(rocksutils::convertStatus(s));
+    }
+  }
+
   TRI_ASSERT(res.ok());
 
   if (coll.useSyncByRevision()) {
-    // Step 4. Take care of revision tree, either serialize or persist
+    // Step 5. Take care of revision tree, either serialize or persist
     // it, or at least check if we can move forward the seq number when
     // it was last serialized (in case there have been no writes to the
     // collection for some time). In either case, the resulting sequence
@@ -687,7 +714,10 @@ Result RocksDBMetadata::deserializeMeta(rocksdb::DB* db,
     }
   }
 
-  // Step 4. load the revision tree
+  // Step 4. load the attribute statistics
+  loadStatistics(db, rcoll->objectId(), context);
+
+  // Step 5. load the revision tree
   if (!coll.useSyncByRevision()) {
     LOG_TOPIC("92ca9", TRACE, Logger::ENGINES)
         << context << ": no need to recover revision tree for "
@@ -813,6 +843,52 @@ Result RocksDBMetadata::deserializeMeta(rocksdb::DB* db,
   return {};
 }
 
+std::shared_ptr<CollectionStatistics const> RocksDBMetadata::statistics()
+    const {
+  std::lock_guard guard{_statisticsLock};
+  return _statistics;
+}
+
+void RocksDBMetadata::setStatistics(
+    std::shared_ptr<CollectionStatistics const> statistics) {
+  std::lock_guard guard{_statisticsLock};
+  _statistics = std::move(statistics);
+  _statisticsNeedToPersist = true;
+}
+
+void RocksDBMetadata::loadStatistics(rocksdb::DB* db, uint64_t objectId,
+                                     std::string const& context) {
+  auto cf = RocksDBColumnFamilyManager::get(
+      RocksDBColumnFamilyManager::Family::Definitions);
+  rocksdb::ReadOptions ro;
+  ro.fill_cache = false;
+
+  RocksDBKey key;
+  key.constructCollectionStatisticsValue(objectId);
+
+  rocksdb::PinnableSlice value;
+  rocksdb::Status s = db->Get(ro, cf, key.string(), &value);
+  if (!s.ok()) {
+    // the statistics are recomputed later. there is no need to fail here
+    if (!s.IsNotFound()) {
+      LOG_TOPIC("a7b31", WARN, Logger::ENGINES)
+          << context << ": unable to load attribute statistics: "
+          << rocksutils::convertStatus(s).errorMessage();
+    }
+    return;
+  }
+
+  VPackSlice slice = RocksDBValue::data(value);
+  if (!slice.isObject()) {
+    LOG_TOPIC("c0f4d", WARN, Logger::ENGINES)
+        << context << ": unsupported attribute statistics format";
+    return;
+  }
+  std::lock_guard guard{_statisticsLock};
+  _statistics = std::make_shared<CollectionStatistics const>(slice);
+  _statisticsNeedToPersist = false;
+}
+
 void RocksDBMetadata::loadInitialNumberDocuments() {
   TRI_ASSERT(_count._added >= _count._removed);
   _numberDocuments.store(_count._added - _count._removed);
@@ -884,6 +960,14 @@ void RocksDBMetadata::loadInitialNumberDocuments() {
     return rocksutils::convertStatus(s);
   }
 
+  key.constructCollectionStatisticsValue(objectId);
+  s = db->Delete(wo, cf, key.string());
+  if (!s.ok() && !s.IsNotFound()) {
+    LOG_TOPIC("6d8e9", ERR, Logger::ENGINES)
+        << "could not delete attribute statistics value: " << s.ToString();
+    return rocksutils::convertStatus(s);
+  }
+
   return Result();
 }
 
@@ -24,6 +24,7 @@
 #pragma once
 
 #include <map>
+#include <memory>
 #include <mutex>
 #include <set>
 #include <atomic>
@@ -46,6 +47,7 @@ class WriteBatch;
 
 namespace arangodb {
 
+class CollectionStatistics;
 class LogicalCollection;
 class RocksDBRecoveryManager;
 
@@ -186,6 +188,16 @@ struct RocksDBMetadata final {
     return _numberDocuments.load(std::memory_order_acquire);
   }
 
+  /// @brief count committed document operations
+  void addWrites(uint64_t writes) noexcept {
+    _numberWrites.fetch_add(writes, std::memory_order_relaxed);
+  }
+
+  /// @brief number of document operations committed since startup
+  uint64_t numberWrites() const noexcept {
+    return _numberWrites.load(std::memory_order_relaxed);
+  }
+
   rocksdb::SequenceNumber countCommitted() const {
     std::lock_guard lock{_bufferLock};
     return _count._committedSeq;
@@ -195,6 +207,13 @@ struct RocksDBMetadata final {
     return _revisionId.load(std::memory_order_acquire);
   }
 
+  /// @brief attribute statistics of the collection. may be a nullptr
+  std::shared_ptr<CollectionStatistics const> statistics() const;
+
+  /// @brief set new attribute statistics, which are persisted by the next
+  /// call to serializeMeta()
+  void setStatistics(std::shared_ptr<CollectionStatistics const> statistics);
+
   // static helper methods to modify collection meta entries in rocksdb
 
   /// @brief load collection document count
@@ -207,6 +226,10 @@ struct RocksDBMetadata final {
   static Result deleteIndexEstimate(rocksdb::DB*, uint64_t objectId);
 
  private:
+  /// @brief load the persisted attribute statistics, if there are any
+  void loadStatistics(rocksdb::DB*, uint64_t objectId,
+                      std::string const& context);
+
   /// @brief apply counter adjustments, only call from sync thread
   bool applyAdjustments(rocksdb::SequenceNumber commitSeq);
 
@@ -246,6 +269,14 @@ struct RocksDBMetadata final {
   // below values are updated immediately, but are not serialized
   std::atomic<uint64_t> _numberDocuments;
   std::atomic<RevisionId> _revisionId;
+  std::atomic<uint64_t> _numberWrites{0};
+
+  mutable std::mutex _statisticsLock;
+  /// @brief attribute statistics, protected by _statisticsLock
+  std::shared_ptr<CollectionStatistics const> _statistics;
+  /// @brief whether or not the statistics were changed since they were
+  /// persisted, protected by _statisticsLock
+  bool _statisticsNeedToPersist = false;
 
 #ifdef ARANGODB_ENABLE_FAILURE_TESTS
   // whether document counts are tainted during testing
@@ -57,6 +57,18 @@ class RocksDBMethods {
                                           ReadOwnWrites,
                                           rocksdb::Snapshot const*) = 0;
 
+  /// @brief read multiple keys at once. the keys must be sorted. the
+  /// default implementation reads the keys one by one
+  virtual void MultiGet(rocksdb::ColumnFamilyHandle* cf, size_t count,
+                        rocksdb::Slice const* keys,
+                        rocksdb::PinnableSlice* values,
+                        rocksdb::Status* statuses,
+                        ReadOwnWrites readOwnWrites) {
+    for (size_t i = 0; i < count; ++i) {
+      statuses[i] = Get(cf, keys[i], &values[i], readOwnWrites);
+    }
+  }
+
   virtual rocksdb::Status GetForUpdate(rocksdb::ColumnFamilyHandle*,
                                        rocksdb::Slice const&,
                                        rocksdb::PinnableSlice*) = 0;
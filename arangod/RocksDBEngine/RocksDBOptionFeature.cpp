@@ -33,6 +33,7 @@
 #include "Agency/AgencyFeature.h"
 #include "Basics/NumberOfCores.h"
 #include "Basics/PhysicalMemory.h"
+#include "Basics/StringUtils.h"
 #include "Basics/application-exit.h"
 #include "Basics/process-utils.h"
 #include "Basics/system-functions.h"
@@ -47,13 +48,16 @@
 
 #include <rocksdb/advanced_options.h>
 #include <rocksdb/cache.h>
+#include <rocksdb/convenience.h>
 #include <rocksdb/filter_policy.h>
 #include <rocksdb/memory_allocator.h>
 #include <rocksdb/options.h>
+#include <rocksdb/rate_limiter.h>
 #include <rocksdb/slice_transform.h>
 #include <rocksdb/sst_partitioner.h>
 #include <rocksdb/statistics.h>
 #include <rocksdb/table.h>
+#include <rocksdb/utilities/table_properties_collectors.h>
 #include <rocksdb/utilities/transaction_db.h>
 
 using namespace arangodb;
@@ -65,12 +69,14 @@ namespace {
 std::string const kCompressionTypeSnappy = "snappy";
 std::string const kCompressionTypeLZ4 = "lz4";
 std::string const kCompressionTypeLZ4HC = "lz4hc";
+std::string const kCompressionTypeZstd = "zstd";
 std::string const kCompressionTypeNone = "none";
 
 std::unordered_set<std::string> const compressionTypes = {
     {kCompressionTypeSnappy},
     {kCompressionTypeLZ4},
     {kCompressionTypeLZ4HC},
+    {kCompressionTypeZstd},
     {kCompressionTypeNone}};
 
 rocksdb::CompressionType compressionTypeFromString(std::string_view type) {
@@ -86,6 +92,9 @@ rocksdb::CompressionType compressionTypeFromString(std::string_view type) {
   if (type == kCompressionTypeLZ4HC) {
     return rocksdb::kLZ4HCCompression;
   }
+  if (type == kCompressionTypeZstd) {
+    return rocksdb::kZSTD;
+  }
   TRI_ASSERT(false);
   LOG_TOPIC("edc91", FATAL, arangodb::Logger::STARTUP)
       << "unexpected compression type '" << type << "'";
@@ -229,6 +238,8 @@ RocksDBOptionFeature::RocksDBOptionFeature(Server& server)
       _maxWriteBufferSizeToMaintain(0),
       _maxTotalWalSize(80 << 20),
       _delayedWriteRate(rocksDBDefaults.delayed_write_rate),
+      _rateLimit(0),
+      _rateLimitTargetLatency(0),
       _minWriteBufferNumberToMerge(defaultMinWriteBufferNumberToMerge(
           _totalWriteBufferSize, _writeBufferSize, _maxWriteBufferNumber)),
       _numLevels(rocksDBDefaults.num_levels),
@@ -273,6 +284,10 @@ RocksDBOptionFeature::RocksDBOptionFeature(Server& server)
       // note: this is a default value from RocksDB (db/column_family.cc,
       // kAdjustedTtl):
       _periodicCompactionTtl(30 * 24 * 60 * 60),
+      _compactOnDeletionWindow(32 * 1024),
+      _compactOnDeletionTrigger(16 * 1024),
+      _documentsCompressionDictionarySize(0),
+      _documentsCompressionDictionaryTrainingSize(0),
       _recycleLogFileNum(rocksDBDefaults.recycle_log_file_num),
       _compressionType(::kCompressionTypeLZ4),
       _blobCompressionType(::kCompressionTypeLZ4),
@@ -319,7 +334,8 @@ RocksDBOptionFeature::RocksDBOptionFeature(Server& server)
       _partitionFilesForPrimaryIndexCf(false),
       _partitionFilesForEdgeIndexCf(false),
       _partitionFilesForVPackIndexCf(false),
-      _maxWriteBufferNumberCf{0, 0, 0, 0, 0, 0, 0} {
+      _maxWriteBufferNumberCf{0, 0, 0, 0, 0, 0, 0},
+      _bloomBitsPerKeyCf{} {
   // setting the number of background jobs to
   _maxBackgroundJobs = static_cast<int32_t>(
       std::max(static_cast<size_t>(2), NumberOfCores::getValue()));
@@ -354,6 +370,43 @@ void RocksDBOptionFeature::collectOptions(
                          arangodb::options::Flags::OnDBServer,
                          arangodb::options::Flags::OnSingle));
 
+  options
+      ->addOption("--rocksdb.data-paths",
+                  "Absolute paths for RocksDB .sst files with their target "
+                  "sizes (in bytes), in the format `<directory>=<size>`. Can "
+                  "be specified multiple times.",
+                  new VectorParameter<StringParameter>(&_dataPaths),
+                  arangodb::options::makeFlags(
+                      arangodb::options::Flags::DefaultNoComponents,
+                      arangodb::options::Flags::OnAgent,
+                      arangodb::options::Flags::OnDBServer,
+                      arangodb::options::Flags::OnSingle))
+      .setIntroducedIn(31200)
+      .setLongDescription(R"(By default, all .sst files are stored in the
+`engine-rocksdb` subdirectory of the database directory. With this option,
+they can be spread over several directories, for example on devices with
+different speed and cost.
+
+RocksDB places newer data into the directories specified first, and older data
+into the directories specified later. With level-style compaction, each level
+is placed into the first directory whose target size can hold the expected
+size of the level together with the levels before it. So the small, frequently
+accessed upper levels stay in the first directories and the large bottommost
+levels end up in the last one. The target sizes are applied to each column
+family on its own. The target size of the last directory is not enforced.
+
+For example, use `--rocksdb.data-paths /nvme/arangodb=200000000000` and
+`--rocksdb.data-paths /hdd/arangodb=50000000000000` to keep up to 200 GB on
+a fast device and the rest on a large one.
+
+The database directory still holds all other RocksDB files, such as the
+MANIFEST and OPTIONS files. Once the option has been used, all of the
+directories must be specified on every restart, because RocksDB does not
+find .sst files in directories it does not know about.
+
+The sizes of the live .sst files in each directory are reported in the
+`rocksdb.data-path-<i>-live-sst-files-size` statistics.)");
+
   options
       ->addOption("--rocksdb.target-file-size-base",
                   "Per-file target file size for compaction (in bytes). The "
@@ -530,6 +583,55 @@ prevent WAL files from being moved to the archive and being removed.)");
   options->addOldOption("rocksdb.delayed_write_rate",
                         "rocksdb.delayed-write-rate");
 
+  options
+      ->addOption("--rocksdb.rate-limit",
+                  "Limit the rate of writes by flushes and compactions (in "
+                  "bytes per second, 0 = unlimited).",
+                  new UInt64Parameter(&_rateLimit),
+                  arangodb::options::makeFlags(
+                      arangodb::options::Flags::Uncommon,
+                      arangodb::options::Flags::DefaultNoComponents,
+                      arangodb::options::Flags::OnAgent,
+                      arangodb::options::Flags::OnDBServer,
+                      arangodb::options::Flags::OnSingle))
+      .setIntroducedIn(31200)
+      .setLongDescription(R"(Background writes by flushes and compactions can
+saturate the disks, which slows down foreground reads and writes. Setting a
+rate limit keeps some of the disk bandwidth available for foreground
+operations. Note that flushes and compactions which are too slow to keep up
+with the incoming writes eventually lead to write stalls.)");
+
+  options
+      ->addOption(
+          "--rocksdb.rate-limit-target-latency",
+          "Adjust the rate limit for flushes and compactions dynamically, so "
+          "that the average latency of reads and writes stays below this "
+          "value (in microseconds, 0 = use a fixed rate limit).",
+          new UInt64Parameter(&_rateLimitTargetLatency),
+          arangodb::options::makeFlags(
+              arangodb::options::Flags::Uncommon,
+              arangodb::options::Flags::DefaultNoComponents,
+              arangodb::options::Flags::OnAgent,
+              arangodb::options::Flags::OnDBServer,
+              arangodb::options::Flags::OnSingle))
+      .setIntroducedIn(31200)
+      .setLongDescription(R"(If set, the rate limit configured via
+`--rocksdb.rate-limit` is treated as the maximum rate. Every few seconds, the
+average latency of RocksDB reads and writes since the last check is compared
+to the target latency:
+
+- If it is above the target, the rate limit is lowered.
+- If it is below half of the target, the rate limit is raised again.
+- If the pending compaction bytes reach half of
+  `--rocksdb.pending-compactions-slowdown-trigger`, the rate limit is set
+  to the maximum rate, so that compactions can catch up before writes are
+  slowed down.
+
+The rate limit is not lowered below 1/16th of the maximum rate.
+
+The current rate limit is reported in the `rocksdb_rate_limit` metric.
+Requires `--rocksdb.rate-limit` and `--rocksdb.enable-statistics`.)");
+
   options->addOption("--rocksdb.min-write-buffer-number-to-merge",
                      "The minimum number of write buffers that are merged "
                      "together before writing to storage.",
@@ -1380,6 +1482,95 @@ support (which is the default on Linux).)");
 avoid periodic auto-compaction and the I/O caused by it, you can set this
 option to `0`.)");
 
+  options
+      ->addOption("--rocksdb.compact-on-deletion-window",
+                  "The size of the sliding window (number of entries) in "
+                  "which deletions in .sst files are counted (0 = do not "
+                  "compact files because of deletions).",
+                  new UInt64Parameter(&_compactOnDeletionWindow),
+                  arangodb::options::makeFlags(
+                      arangodb::options::Flags::Uncommon,
+                      arangodb::options::Flags::DefaultNoComponents,
+                      arangodb::options::Flags::OnAgent,
+                      arangodb::options::Flags::OnDBServer,
+                      arangodb::options::Flags::OnSingle))
+      .setIntroducedIn(31200)
+      .setLongDescription(R"(Removing many documents, e.g. via the TTL
+background thread or by removal queries, leaves lots of tombstones in the
+.sst files, which slow down reads and range scans until the files are
+eventually compacted.
+
+If the number of deletions in any window of this many consecutive entries of
+an .sst file reaches `--rocksdb.compact-on-deletion-trigger`, RocksDB marks
+the file for compaction right away, so that the tombstones are removed
+early.)");
+
+  options
+      ->addOption("--rocksdb.compact-on-deletion-trigger",
+                  "The number of deletions within the sliding window of "
+                  "`--rocksdb.compact-on-deletion-window` entries after which "
+                  "an .sst file is marked for compaction.",
+                  new UInt64Parameter(&_compactOnDeletionTrigger),
+                  arangodb::options::makeFlags(
+                      arangodb::options::Flags::Uncommon,
+                      arangodb::options::Flags::DefaultNoComponents,
+                      arangodb::options::Flags::OnAgent,
+                      arangodb::options::Flags::OnDBServer,
+                      arangodb::options::Flags::OnSingle))
+      .setIntroducedIn(31200);
+
+  options
+      ->addOption("--rocksdb.documents-compression-dictionary-size",
+                  "The maximum size (in bytes) of the compression dictionary "
+                  "for each .sst file of the documents column family "
+                  "(0 = no dictionary).",
+                  new UInt64Parameter(&_documentsCompressionDictionarySize),
+                  arangodb::options::makeFlags(
+                      arangodb::options::Flags::Uncommon,
+                      arangodb::options::Flags::DefaultNoComponents,
+                      arangodb::options::Flags::OnAgent,
+                      arangodb::options::Flags::OnDBServer,
+                      arangodb::options::Flags::OnSingle))
+      .setIntroducedIn(31200)
+      .setLongDescription(R"(Documents of the same collection usually repeat
+the same attribute names, and block compression can only make use of the
+repetitions within a single data block. If you set this option to a value
+greater than 0, RocksDB samples the data of each .sst file of the documents
+column family and builds a dictionary of up to this size, which it stores in
+the file and uses for compressing all of the file's data blocks. This
+reduces the size of the stored documents on disk, in particular for
+collections with small documents and a fixed schema.
+
+Values between 16 KiB and 64 KiB are typical. Requires a compression type
+other than `none` for the documents column family.
+
+If you also enable `--rocksdb.partition-files-for-documents`, each .sst file
+only contains the documents of a single collection, so that each dictionary
+is specific to one collection.)");
+
+  options
+      ->addOption(
+          "--rocksdb.documents-compression-dictionary-training-size",
+          "The maximum size (in bytes) of the data sampled for training the "
+          "compression dictionary of each .sst file of the documents column "
+          "family (0 = use the samples as dictionary without training).",
+          new UInt64Parameter(&_documentsCompressionDictionaryTrainingSize),
+          arangodb::options::makeFlags(
+              arangodb::options::Flags::Uncommon,
+              arangodb::options::Flags::DefaultNoComponents,
+              arangodb::options::Flags::OnAgent,
+              arangodb::options::Flags::OnDBServer,
+              arangodb::options::Flags::OnSingle))
+      .setIntroducedIn(31200)
+      .setLongDescription(R"(Only has an effect with the `zstd` compression
+type for the documents column family and a non-zero
+`--rocksdb.documents-compression-dictionary-size`. Instead of using the raw
+samples as dictionary, RocksDB then trains a zstd dictionary from up to this
+amount of sampled data whenever it writes an .sst file. As files are rewritten
+by compactions, their dictionaries are retrained on the current data.
+
+Training data of about 100 times the dictionary size gives good results.)");
+
   options
       ->addOption("--rocksdb.partition-files-for-documents",
                   "If enabled, the document data for different "
@@ -1540,6 +1731,48 @@ limited number of edge collections/shards/indexes.)");
   for (auto family : families) {
     addMaxWriteBufferNumberCf(family);
   }
+
+  // compression, compaction style and bloom filter overrides, so that e.g.
+  // the documents column family can use a stronger compression than the
+  // index column families
+  for (auto family : families) {
+    std::string name = RocksDBColumnFamilyManager::name(
+        family, RocksDBColumnFamilyManager::NameMode::External);
+    std::size_t index = static_cast<
+        std::underlying_type<RocksDBColumnFamilyManager::Family>::type>(
+        family);
+    options
+        ->addOption("--rocksdb.compression-type-" + name,
+                    "If non-empty, overrides the value of "
+                    "`--rocksdb.compression-type` for the " +
+                        name + " column family",
+                    new StringParameter(&_compressionTypeCf[index]),
+                    arangodb::options::makeDefaultFlags(
+                        arangodb::options::Flags::Uncommon))
+        .setIntroducedIn(31200);
+    options
+        ->addOption("--rocksdb.compaction-style-" + name,
+                    "If non-empty, overrides the value of "
+                    "`--rocksdb.compaction-style` for the " +
+                        name + " column family",
+                    new StringParameter(&_compactionStyleCf[index]),
+                    arangodb::options::makeDefaultFlags(
+                        arangodb::options::Flags::Uncommon))
+        .setIntroducedIn(31200);
+    if (family == RocksDBColumnFamilyManager::Family::VPackIndex) {
+      // intentionally uses no bloom filter
+      continue;
+    }
+    options
+        ->addOption("--rocksdb.bloom-filter-bits-per-key-" + name,
+                    "If non-zero, overrides the value of "
+                    "`--rocksdb.bloom-filter-bits-per-key` for the " +
+                        name + " column family",
+                    new DoubleParameter(&_bloomBitsPerKeyCf[index]),
+                    arangodb::options::makeDefaultFlags(
+                        arangodb::options::Flags::Uncommon))
+        .setIntroducedIn(31200);
+  }
 }
 
 void RocksDBOptionFeature::validateOptions(
@@ -1561,6 +1794,99 @@ void RocksDBOptionFeature::validateOptions(
     FATAL_ERROR_EXIT();
   }
 
+  if (_compactOnDeletionWindow > 0 &&
+      (_compactOnDeletionTrigger == 0 ||
+       _compactOnDeletionTrigger > _compactOnDeletionWindow)) {
+    LOG_TOPIC("0b7e3", FATAL, arangodb::Logger::ENGINES)
+        << "invalid value for '--rocksdb.compact-on-deletion-trigger'. it "
+           "must be between 1 and the value of "
+           "'--rocksdb.compact-on-deletion-window'";
+    FATAL_ERROR_EXIT();
+  }
+
+  if (_documentsCompressionDictionarySize > 16 * 1024 * 1024) {
+    LOG_TOPIC("5e0d2", FATAL, arangodb::Logger::ENGINES)
+        << "invalid value for "
+           "'--rocksdb.documents-compression-dictionary-size'. it must not "
+           "be larger than 16 MiB";
+    FATAL_ERROR_EXIT();
+  }
+
+  if (_documentsCompressionDictionaryTrainingSize > 0 &&
+      (_documentsCompressionDictionaryTrainingSize <
+           _documentsCompressionDictionarySize ||
+       _documentsCompressionDictionaryTrainingSize > 256 * 1024 * 1024)) {
+    LOG_TOPIC("8b1f6", FATAL, arangodb::Logger::ENGINES)
+        << "invalid value for "
+           "'--rocksdb.documents-compression-dictionary-training-size'. it "
+           "must not be smaller than the value of "
+           "'--rocksdb.documents-compression-dictionary-size', and not be "
+           "larger than 256 MiB";
+    FATAL_ERROR_EXIT();
+  }
+
+  if (_rateLimitTargetLatency > 0 && (_rateLimit == 0 || !_enableStatistics)) {
+    LOG_TOPIC("c61d4", FATAL, arangodb::Logger::ENGINES)
+        << "'--rocksdb.rate-limit-target-latency' requires "
+           "'--rocksdb.rate-limit' and '--rocksdb.enable-statistics'";
+    FATAL_ERROR_EXIT();
+  }
+
+  _dbPaths.clear();
+  for (auto const& dataPath : _dataPaths) {
+    auto pos = dataPath.rfind('=');
+    uint64_t targetSize = 0;
+    if (pos != std::string::npos) {
+      targetSize = basics::StringUtils::uint64(dataPath.substr(pos + 1));
+    }
+    if (pos == std::string::npos || pos == 0 || targetSize == 0) {
+      LOG_TOPIC("a3e71", FATAL, arangodb::Logger::ENGINES)
+          << "invalid value '" << dataPath
+          << "' for '--rocksdb.data-paths'. expecting "
+             "`<directory>=<size>`, with a size greater than 0";
+      FATAL_ERROR_EXIT();
+    }
+    _dbPaths.emplace_back(dataPath.substr(0, pos), targetSize);
+  }
+
+  for (std::size_t i = 0; i < _compressionTypeCf.size(); ++i) {
+    if (!_compressionTypeCf[i].empty() &&
+        !::compressionTypes.contains(_compressionTypeCf[i])) {
+      LOG_TOPIC("d2a4e", FATAL, arangodb::Logger::ENGINES)
+          << "invalid compression type '" << _compressionTypeCf[i]
+          << "' for column family";
+      FATAL_ERROR_EXIT();
+    }
+    if (!_compactionStyleCf[i].empty() &&
+        !::compactionStyles.contains(_compactionStyleCf[i])) {
+      LOG_TOPIC("7c3b0", FATAL, arangodb::Logger::ENGINES)
+          << "invalid compaction style '" << _compactionStyleCf[i]
+          << "' for column family";
+      FATAL_ERROR_EXIT();
+    }
+    if (_bloomBitsPerKeyCf[i] < 0.0) {
+      LOG_TOPIC("e81f9", FATAL, arangodb::Logger::ENGINES)
+          << "invalid value for bloom filter bits per key of column family";
+      FATAL_ERROR_EXIT();
+    }
+  }
+
+  // zstd is only available if RocksDB was built with it
+  bool usesZstd = (_compressionType == ::kCompressionTypeZstd ||
+                   _blobCompressionType == ::kCompressionTypeZstd);
+  for (auto const& type : _compressionTypeCf) {
+    usesZstd |= (type == ::kCompressionTypeZstd);
+  }
+  if (usesZstd) {
+    auto supported = rocksdb::GetSupportedCompressions();
+    if (std::find(supported.begin(), supported.end(), rocksdb::kZSTD) ==
+        supported.end()) {
+      LOG_TOPIC("c4e07", FATAL, arangodb::Logger::ENGINES)
+          << "compression type 'zstd' is not supported by this build";
+      FATAL_ERROR_EXIT();
+    }
+  }
+
   _minWriteBufferNumberToMergeTouched = options->processingResult().touched(
       "--rocksdb.min-write-buffer-number-to-merge");
 
@@ -1847,6 +2173,7 @@ rocksdb::Options RocksDBOptionFeature::doGetOptions() const {
   result.max_total_wal_size = 4 * 1024 * 1024;
 
   result.wal_dir = _walDirectory;
+  result.db_paths = _dbPaths;
 
   if (_skipCorrupted) {
     result.wal_recovery_mode =
@@ -1914,6 +2241,11 @@ rocksdb::Options RocksDBOptionFeature::doGetOptions() const {
     // result.stats_dump_period_sec = 1;
   }
 
+  if (_rateLimit > 0) {
+    result.rate_limiter.reset(
+        rocksdb::NewGenericRateLimiter(static_cast<int64_t>(_rateLimit)));
+  }
+
   result.table_factory.reset(
       rocksdb::NewBlockBasedTableFactory(getTableOptions()));
 
@@ -2074,6 +2406,16 @@ rocksdb::ColumnFamilyOptions RocksDBOptionFeature::getColumnFamilyOptions(
       RocksDBOptionsProvider::getColumnFamilyOptions(family);
 
   if (family == RocksDBColumnFamilyManager::Family::Documents) {
+    // dictionary compression, so that attribute names repeated across the
+    // documents of a file are compressed well. the dictionary is sampled
+    // from the file's data, and trained from the samples if zstd is used
+    result.compression_opts.max_dict_bytes =
+        static_cast<uint32_t>(_documentsCompressionDictionarySize);
+    result.compression_opts.zstd_max_train_bytes =
+        (_documentsCompressionDictionarySize > 0)
+            ? static_cast<uint32_t>(
+                  _documentsCompressionDictionaryTrainingSize)
+            : 0;
     result.enable_blob_files = _enableBlobFiles;
     result.min_blob_size = _minBlobSize;
     result.blob_file_size = _blobFileSize;
@@ -2126,6 +2468,17 @@ rocksdb::ColumnFamilyOptions RocksDBOptionFeature::getColumnFamilyOptions(
     }
   }
 
+  if (_compactOnDeletionWindow > 0 &&
+      family != RocksDBColumnFamilyManager::Family::Definitions &&
+      family != RocksDBColumnFamilyManager::Family::ReplicatedLogs) {
+    // mark .sst files with many tombstones for compaction, so that reads
+    // do not need to skip over them for a long time after mass removals.
+    // the replicated logs are removed via range deletions anyway
+    result.table_properties_collector_factories.emplace_back(
+        rocksdb::NewCompactOnDeletionCollectorFactory(
+            _compactOnDeletionWindow, _compactOnDeletionTrigger));
+  }
+
   // override
   std::size_t index = static_cast<
       std::underlying_type<RocksDBColumnFamilyManager::Family>::type>(family);
@@ -2134,6 +2487,36 @@ rocksdb::ColumnFamilyOptions RocksDBOptionFeature::getColumnFamilyOptions(
     result.max_write_buffer_number =
         static_cast<int>(_maxWriteBufferNumberCf[index]);
   }
+  if (!_compressionTypeCf[index].empty()) {
+    rocksdb::CompressionType compressionType =
+        ::compressionTypeFromString(_compressionTypeCf[index]);
+    result.compression_per_level.resize(result.num_levels);
+    for (int level = 0; level < result.num_levels; ++level) {
+      result.compression_per_level[level] =
+          ((static_cast<uint64_t>(level) >= _numUncompressedLevels)
+               ? compressionType
+               : rocksdb::kNoCompression);
+    }
+  }
+  if (!_compactionStyleCf[index].empty()) {
+    result.compaction_style =
+        ::compactionStyleFromString(_compactionStyleCf[index]);
+  }
+  if (_bloomBitsPerKeyCf[index] > 0.0 &&
+      family != RocksDBColumnFamilyManager::Family::VPackIndex) {
+    auto const* current =
+        result.table_factory->GetOptions<rocksdb::BlockBasedTableOptions>();
+    TRI_ASSERT(current != nullptr);
+    if (current != nullptr) {
+      // keep all other table options of the column family, e.g. the index
+      // type of the edge index
+      rocksdb::BlockBasedTableOptions tableOptions(*current);
+      tableOptions.filter_policy.reset(
+          rocksdb::NewBloomFilterPolicy(_bloomBitsPerKeyCf[index], true));
+      result.table_factory = std::shared_ptr<rocksdb::TableFactory>(
+          rocksdb::NewBlockBasedTableFactory(tableOptions));
+    }
+  }
   if (!_minWriteBufferNumberToMergeTouched) {
     result.min_write_buffer_number_to_merge =
         static_cast<int>(defaultMinWriteBufferNumberToMerge(
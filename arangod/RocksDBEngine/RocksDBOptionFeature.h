@@ -26,6 +26,7 @@
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <rocksdb/options.h>
 #include <rocksdb/table.h>
@@ -79,6 +80,9 @@ class RocksDBOptionFeature final : public ArangodFeature,
   uint64_t periodicCompactionTtl() const noexcept override {
     return _periodicCompactionTtl;
   }
+  uint64_t rateLimitTargetLatency() const noexcept override {
+    return _rateLimitTargetLatency;
+  }
 
  protected:
   rocksdb::Options doGetOptions() const override;
@@ -88,6 +92,10 @@ class RocksDBOptionFeature final : public ArangodFeature,
   uint64_t _transactionLockStripes;
   int64_t _transactionLockTimeout;
   std::string _walDirectory;
+  /// directories for .sst files with their target sizes, in the format
+  /// `<directory>=<target size>`
+  std::vector<std::string> _dataPaths;
+  std::vector<rocksdb::DbPath> _dbPaths;
   uint64_t _totalWriteBufferSize;
   uint64_t _writeBufferSize;
   // Update max_write_buffer_number above if you change number of families used
@@ -95,6 +103,8 @@ class RocksDBOptionFeature final : public ArangodFeature,
   int64_t _maxWriteBufferSizeToMaintain;
   uint64_t _maxTotalWalSize;
   uint64_t _delayedWriteRate;
+  uint64_t _rateLimit;
+  uint64_t _rateLimitTargetLatency;
   uint64_t _minWriteBufferNumberToMerge;
   uint64_t _numLevels;
   uint64_t _numUncompressedLevels;
@@ -132,6 +142,10 @@ class RocksDBOptionFeature final : public ArangodFeature,
   uint64_t _pendingCompactionBytesSlowdownTrigger;
   uint64_t _pendingCompactionBytesStopTrigger;
   uint64_t _periodicCompactionTtl;
+  uint64_t _compactOnDeletionWindow;
+  uint64_t _compactOnDeletionTrigger;
+  uint64_t _documentsCompressionDictionarySize;
+  uint64_t _documentsCompressionDictionaryTrainingSize;
   size_t _recycleLogFileNum;
   std::string _compressionType;
   std::string _blobCompressionType;
@@ -176,6 +190,15 @@ class RocksDBOptionFeature final : public ArangodFeature,
   /// per column family write buffer limits
   std::array<uint64_t, RocksDBColumnFamilyManager::numberOfColumnFamilies>
       _maxWriteBufferNumberCf;
+
+  /// per column family compression types, compaction styles and bloom
+  /// filter sizes. empty values/0 mean the global values are used
+  std::array<std::string, RocksDBColumnFamilyManager::numberOfColumnFamilies>
+      _compressionTypeCf;
+  std::array<std::string, RocksDBColumnFamilyManager::numberOfColumnFamilies>
+      _compactionStyleCf;
+  std::array<double, RocksDBColumnFamilyManager::numberOfColumnFamilies>
+      _bloomBitsPerKeyCf;
 };
 
 }  // namespace arangodb
@@ -94,7 +94,13 @@ rocksdb::ColumnFamilyOptions RocksDBOptionsProvider::getColumnFamilyOptions(
     case RocksDBColumnFamilyManager::Family::VPackIndex: {
       // velocypack based index variants with custom comparator
       rocksdb::BlockBasedTableOptions tableOptions(getTableOptions());
-      tableOptions.filter_policy.reset();  // intentionally no bloom filter here
+      // intentionally no bloom filter here: keys that are equal according
+      // to the vpack comparator can have different byte representations
+      // (e.g. the numbers 1 and 1.0), and bloom filters (also prefix bloom
+      // filters) only work on the key bytes. in addition, the array header
+      // at the start of the indexed values depends on all values, so there
+      // is no byte prefix that covers just the leading index values
+      tableOptions.filter_policy.reset();
       result.table_factory = std::shared_ptr<rocksdb::TableFactory>(
           rocksdb::NewBlockBasedTableFactory(tableOptions));
       result.comparator = _vpackCmp.get();
@@ -51,6 +51,9 @@ struct RocksDBOptionsProvider {
   virtual uint32_t numThreadsHigh() const noexcept = 0;
   virtual uint32_t numThreadsLow() const noexcept = 0;
   virtual uint64_t periodicCompactionTtl() const noexcept = 0;
+  // target latency (in microseconds) for adjusting the rate limit of flushes
+  // and compactions. 0 = do not adjust the rate limit
+  virtual uint64_t rateLimitTargetLatency() const noexcept { return 0; }
 
  protected:
   virtual rocksdb::Options doGetOptions() const = 0;
@@ -0,0 +1,77 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include "RocksDBRateLimitController.h"
+
+#include "Basics/debugging.h"
+
+#include <algorithm>
+
+using namespace arangodb;
+
+namespace {
+// factors for lowering and raising the rate. lowering is more aggressive
+// than raising, so that the rate backs off quickly when foreground
+// operations suffer, and probes upwards carefully
+constexpr double decreaseFactor = 0.7;
+constexpr double increaseFactor = 1.2;
+}  // namespace
+
+RocksDBRateLimitController::RocksDBRateLimitController(
+    std::uint64_t maxRate, std::uint64_t targetLatency,
+    std::uint64_t pendingCompactionBytesLimit)
+    : _maxRate(maxRate),
+      _minRate(std::max<std::uint64_t>(maxRate / kMinRateDivisor, 1)),
+      _targetLatency(static_cast<double>(targetLatency)),
+      _pendingCompactionBytesLimit(pendingCompactionBytesLimit),
+      _rate(maxRate) {
+  TRI_ASSERT(_maxRate > 0);
+  TRI_ASSERT(_targetLatency > 0.0);
+}
+
+RocksDBRateLimitController::Decision RocksDBRateLimitController::adjust(
+    double latency, std::uint64_t pendingCompactionBytes) {
+  std::uint64_t rate = _rate;
+  if (_pendingCompactionBytesLimit > 0 &&
+      pendingCompactionBytes >= _pendingCompactionBytesLimit / 2) {
+    // compaction debt is growing too large. go at full speed, otherwise
+    // writes will be slowed down or stopped soon
+    rate = _maxRate;
+  } else if (latency > _targetLatency) {
+    rate = static_cast<std::uint64_t>(static_cast<double>(rate) *
+                                      decreaseFactor);
+  } else if (latency < _targetLatency / 2.0) {
+    rate = static_cast<std::uint64_t>(static_cast<double>(rate) *
+                                      increaseFactor) +
+           1;
+  }
+  rate = std::clamp(rate, _minRate, _maxRate);
+
+  Decision decision = Decision::kKeep;
+  if (rate > _rate) {
+    decision = Decision::kIncrease;
+  } else if (rate < _rate) {
+    decision = Decision::kDecrease;
+  }
+  _rate = rate;
+  return decision;
+}
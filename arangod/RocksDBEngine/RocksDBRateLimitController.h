@@ -0,0 +1,69 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+#include <cstdint>
+
+namespace arangodb {
+
+/// @brief adjusts the RocksDB rate limit for flushes and compactions.
+/// While foreground operations are slower than the target latency, the rate
+/// is lowered, so that background I/O leaves more room for them. While they
+/// are clearly faster than the target, the rate is raised again, so that
+/// compactions can catch up during quiet periods. If the compaction debt gets
+/// close to the point where RocksDB starts to slow down writes, the rate is
+/// raised regardless of the latency, because stalled writes hurt more than
+/// slower reads.
+/// The rate stays between the maximum rate and a fixed fraction of it.
+class RocksDBRateLimitController {
+ public:
+  enum class Decision { kKeep, kIncrease, kDecrease };
+
+  /// @brief the rate is never lowered below maxRate / kMinRateDivisor
+  static constexpr std::uint64_t kMinRateDivisor = 16;
+
+  /// @brief maxRate is in bytes per second, targetLatency in microseconds.
+  /// pendingCompactionBytesLimit is the number of pending compaction bytes at
+  /// which RocksDB slows down writes (0 = unlimited)
+  RocksDBRateLimitController(std::uint64_t maxRate,
+                             std::uint64_t targetLatency,
+                             std::uint64_t pendingCompactionBytesLimit);
+
+  /// @brief adjust the rate based on the average latency of foreground
+  /// operations (in microseconds) and the pending compaction bytes since the
+  /// last call
+  Decision adjust(double latency, std::uint64_t pendingCompactionBytes);
+
+  std::uint64_t rate() const noexcept { return _rate; }
+  std::uint64_t minRate() const noexcept { return _minRate; }
+  std::uint64_t maxRate() const noexcept { return _maxRate; }
+
+ private:
+  std::uint64_t const _maxRate;
+  std::uint64_t const _minRate;
+  double const _targetLatency;
+  std::uint64_t const _pendingCompactionBytesLimit;
+  std::uint64_t _rate;
+};
+
+}  // namespace arangodb
@@ -34,6 +34,7 @@
 #include "Basics/application-exit.h"
 #include "Basics/exitcodes.h"
 #include "Basics/files.h"
+#include "Containers/FlatHashMap.h"
 #include "Logger/Logger.h"
 #include "Logger/LogMacros.h"
 #include "RestServer/DatabaseFeature.h"
@@ -168,6 +169,14 @@ class WBReader final : public rocksdb::WriteBatch::Handler {
   // whether we are currently at the start of a batch
   bool _startOfBatch = false;
 
+  // collections and indexes by object id. almost every WAL entry needs a
+  // lookup, and the object ids do not change during recovery. unknown
+  // object ids are cached as nullptr
+  containers::FlatHashMap<uint64_t, RocksDBCollection*> _collections;
+  containers::FlatHashMap<uint64_t, RocksDBIndex*> _indexes;
+  // the databases of the cached collections and indexes, keeps them alive
+  containers::FlatHashMap<TRI_voc_tick_t, VocbasePtr> _databases;
+
  public:
   /// @param seqs sequence number from which to count operations
   explicit WBReader(ArangodServer& server,
@@ -258,47 +267,60 @@ class WBReader final : public rocksdb::WriteBatch::Handler {
     }
   }
 
+  TRI_vocbase_t* useDatabase(TRI_voc_tick_t id) {
+    auto it = _databases.find(id);
+    if (it == _databases.end()) {
+      DatabaseFeature& df = _server.getFeature<DatabaseFeature>();
+      it = _databases.emplace(id, df.useDatabase(id)).first;
+    }
+    return it->second.get();
+  }
+
   // find estimator for index
   RocksDBCollection* findCollection(uint64_t objectId) {
+    auto it = _collections.find(objectId);
+    if (it != _collections.end()) {
+      return it->second;
+    }
+
+    RocksDBCollection* collection = nullptr;
     // now adjust the counter in collections which are already loaded
     RocksDBEngine::CollectionPair dbColPair =
         _engine.mapObjectToCollection(objectId);
-    if (dbColPair.second.empty() || dbColPair.first == 0) {
-      // collection with this objectID not known.Skip.
-      return nullptr;
-    }
-    DatabaseFeature& df = _server.getFeature<DatabaseFeature>();
-    auto vocbase = df.useDatabase(dbColPair.first);
-    if (vocbase == nullptr) {
-      return nullptr;
+    // a collection with this objectID may not be known. skip it then
+    if (!dbColPair.second.empty() && dbColPair.first != 0) {
+      if (auto* vocbase = useDatabase(dbColPair.first); vocbase != nullptr) {
+        auto coll = vocbase->lookupCollection(dbColPair.second);
+        if (coll != nullptr) {
+          collection = static_cast<RocksDBCollection*>(coll->getPhysical());
+        }
+      }
     }
-    return static_cast<RocksDBCollection*>(
-        vocbase->lookupCollection(dbColPair.second)->getPhysical());
+    _collections.emplace(objectId, collection);
+    return collection;
   }
 
   RocksDBIndex* findIndex(uint64_t objectId) {
-    RocksDBEngine::IndexTriple triple = _engine.mapObjectToIndex(objectId);
-    if (std::get<0>(triple) == 0 && std::get<1>(triple).empty()) {
-      return nullptr;
-    }
-
-    DatabaseFeature& df = _server.getFeature<DatabaseFeature>();
-    auto vb = df.useDatabase(std::get<0>(triple));
-    if (vb == nullptr) {
-      return nullptr;
+    auto it = _indexes.find(objectId);
+    if (it != _indexes.end()) {
+      return it->second;
     }
 
-    auto coll = vb->lookupCollection(std::get<1>(triple));
-
-    if (coll == nullptr) {
-      return nullptr;
-    }
-
-    std::shared_ptr<Index> index = coll->lookupIndex(std::get<2>(triple));
-    if (index == nullptr) {
-      return nullptr;
+    RocksDBIndex* index = nullptr;
+    RocksDBEngine::IndexTriple triple = _engine.mapObjectToIndex(objectId);
+    if (std::get<0>(triple) != 0 || !std::get<1>(triple).empty()) {
+      if (auto* vocbase = useDatabase(std::get<0>(triple));
+          vocbase != nullptr) {
+        auto coll = vocbase->lookupCollection(std::get<1>(triple));
+        if (coll != nullptr) {
+          // the collection keeps the index alive
+          index = static_cast<RocksDBIndex*>(
+              coll->lookupIndex(std::get<2>(triple)).get());
+        }
+      }
     }
-    return static_cast<RocksDBIndex*>(index.get());
+    _indexes.emplace(objectId, index);
+    return index;
   }
 
   void updateMaxTick(uint32_t column_family_id, const rocksdb::Slice& key,
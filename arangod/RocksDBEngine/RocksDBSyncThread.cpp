@@ -24,6 +24,7 @@
 #include "ApplicationFeatures/ApplicationServer.h"
 #include "RocksDBSyncThread.h"
 #include "Basics/RocksDBUtils.h"
+#include "Basics/ScopeGuard.h"
 #include "Logger/LogMacros.h"
 #include "Logger/Logger.h"
 #include "Logger/LoggerStream.h"
@@ -32,30 +33,68 @@
 #include <rocksdb/status.h>
 #include <rocksdb/utilities/transaction_db.h>
 
+#include <thread>
+
 using namespace arangodb;
 
 RocksDBSyncThread::RocksDBSyncThread(RocksDBEngine& engine,
                                      std::chrono::milliseconds interval,
-                                     std::chrono::milliseconds delayThreshold)
+                                     std::chrono::milliseconds delayThreshold,
+                                     std::chrono::microseconds groupDelay)
     : Thread(engine.server(), "RocksDBSync"),
       _engine(engine),
       _interval(interval),
       _lastSyncTime(std::chrono::steady_clock::now()),
       _lastSequenceNumber(0),
-      _delayThreshold(delayThreshold) {}
+      _delayThreshold(delayThreshold),
+      _groupDelay(groupDelay),
+      _syncInProgress(false) {}
 
 RocksDBSyncThread::~RocksDBSyncThread() { shutdown(); }
 
-Result RocksDBSyncThread::syncWal() {
+Result RocksDBSyncThread::syncWal(rocksdb::SequenceNumber sequenceNumber) {
   // note the following line in RocksDB documentation (rocksdb/db.h):
   // > Currently only works if allow_mmap_writes = false in Options.
   TRI_ASSERT(!_engine.rocksDBOptions().allow_mmap_writes);
 
   auto db = _engine.db()->GetBaseDB();
 
+  if (sequenceNumber == 0) {
+    sequenceNumber = db->GetLatestSequenceNumber();
+  }
+
+  {
+    // group commit: while another caller is syncing, wait for it. its
+    // sync may already cover our sequence number, so that we do not need
+    // to sync ourselves
+    std::unique_lock guard{_condition.mutex};
+    _syncFinished.wait(guard, [&] {
+      return !_syncInProgress || sequenceNumber <= _lastSequenceNumber;
+    });
+    if (sequenceNumber <= _lastSequenceNumber) {
+      return {};
+    }
+    _syncInProgress = true;
+  }
+
+  auto inProgressGuard = scopeGuard([this]() noexcept {
+    {
+      std::lock_guard guard{_condition.mutex};
+      _syncInProgress = false;
+    }
+    _syncFinished.notify_all();
+  });
+
+  if (_groupDelay.count() > 0) {
+    // give other commits the chance to be written to the WAL, so that they
+    // are synced together with ours
+    std::this_thread::sleep_for(_groupDelay);
+  }
+
   // set time of last syncing under the lock
   auto const now = std::chrono::steady_clock::now();
   auto const lastSequenceNumber = db->GetLatestSequenceNumber();
+  TRI_ASSERT(lastSequenceNumber >= sequenceNumber);
 
   // actual syncing is done without holding the lock
   auto result = sync(db);
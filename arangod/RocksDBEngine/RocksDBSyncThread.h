@@ -31,6 +31,7 @@
 #include <rocksdb/types.h>
 
 #include <chrono>
+#include <condition_variable>
 
 namespace rocksdb {
 class DB;
@@ -43,7 +44,8 @@ class RocksDBEngine;
 class RocksDBSyncThread final : public Thread {
  public:
   RocksDBSyncThread(RocksDBEngine& engine, std::chrono::milliseconds interval,
-                    std::chrono::milliseconds delayThreshold);
+                    std::chrono::milliseconds delayThreshold,
+                    std::chrono::microseconds groupDelay);
 
   ~RocksDBSyncThread();
 
@@ -51,8 +53,13 @@ class RocksDBSyncThread final : public Thread {
 
   /// @brief updates last sync time and calls the synchronization
   /// this is the preferred method to call when trying to avoid redundant
-  /// syncs by foreground work and the background sync thread
-  Result syncWal();
+  /// syncs by foreground work and the background sync thread.
+  /// concurrent callers are grouped: only one of them syncs the WAL at a
+  /// time, and callers whose sequence number has been synced already (by
+  /// another caller or the background thread) return without syncing.
+  /// a sequence number of 0 means the latest sequence number when the
+  /// function is called
+  Result syncWal(rocksdb::SequenceNumber sequenceNumber = 0);
 
   /// @brief unconditionally syncs the RocksDB WAL, static variant
   static Result sync(rocksdb::DB* db);
@@ -88,9 +95,22 @@ class RocksDBSyncThread final : public Thread {
   /// sync thread
   std::chrono::milliseconds const _delayThreshold;
 
-  /// @brief protects _lastSyncTime and _lastSequenceNumber
+  /// @brief time a foreground WAL sync waits before syncing, so that
+  /// more concurrent commits can be synced by the same WAL sync
+  std::chrono::microseconds const _groupDelay;
+
+  /// @brief protects _lastSyncTime, _lastSequenceNumber and _syncInProgress
   arangodb::basics::ConditionVariable _condition;
 
+  /// @brief whether a foreground WAL sync is currently running.
+  /// protected by _condition.mutex
+  bool _syncInProgress;
+
+  /// @brief signaled when a foreground WAL sync has finished. uses
+  /// _condition.mutex. this is separate from _condition so that finished
+  /// syncs do not wake up the background thread
+  std::condition_variable _syncFinished;
+
   /// @brief listeners to be notified when _lastSequenceNumber is updated after
   /// a sync. We don't need to protect this vector because it is only
   /// modified once after the syncer thread is started.
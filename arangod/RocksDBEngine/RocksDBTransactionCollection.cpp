@@ -230,6 +230,7 @@ void RocksDBTransactionCollection::commitCounts(TransactionId trxId,
       }
     }
     rcoll->meta().adjustNumberDocuments(commitSeq, _revision, adj);
+    rcoll->meta().addWrites(_numInserts + _numUpdates + _numRemoves);
   }
 
   // update the revision tree
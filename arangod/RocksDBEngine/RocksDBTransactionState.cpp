@@ -213,6 +213,7 @@ Result RocksDBTransactionState::abortTransaction(
   if (hasOperations()) {
     // must clean up the query cache because the transaction
     // may have queried something via AQL that is now rolled back
+    discardQueryCacheChanges();
     clearQueryCache();
   }
 
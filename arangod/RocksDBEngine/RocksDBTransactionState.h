@@ -136,6 +136,10 @@ class RocksDBTransactionState : public TransactionState {
 
   [[nodiscard]] virtual rocksdb::SequenceNumber beginSeq() const = 0;
 
+  [[nodiscard]] TRI_voc_tick_t snapshotTick() const override {
+    return beginSeq();
+  }
+
 #ifdef ARANGODB_ENABLE_MAINTAINER_MODE
   /// @brief only needed for RocksDBTransactionStateGuard
   void use() noexcept;
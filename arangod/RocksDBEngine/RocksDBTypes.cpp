@@ -143,6 +143,13 @@ static rocksdb::Slice KeyGeneratorValue(
         &keyGeneratorValue),
     1);
 
+static RocksDBEntryType collectionStatisticsValue =
+    RocksDBEntryType::CollectionStatisticsValue;
+static rocksdb::Slice CollectionStatisticsValue(
+    reinterpret_cast<std::underlying_type<RocksDBEntryType>::type*>(
+        &collectionStatisticsValue),
+    1);
+
 static RocksDBEntryType logEntry = RocksDBEntryType::LogEntry;
 static rocksdb::Slice LogEntry(
     reinterpret_cast<std::underlying_type<RocksDBEntryType>::type*>(&logEntry),
@@ -211,6 +218,8 @@ std::string_view arangodb::rocksDBEntryTypeName(
       return "IndexEstimateValue";
     case arangodb::RocksDBEntryType::KeyGeneratorValue:
       return "KeyGeneratorValue";
+    case arangodb::RocksDBEntryType::CollectionStatisticsValue:
+      return "CollectionStatisticsValue";
     case arangodb::RocksDBEntryType::RevisionTreeValue:
       return "RevisionTreeValue";
     case arangodb::RocksDBEntryType::ZkdIndexValue:
@@ -317,6 +326,8 @@ rocksdb::Slice const& arangodb::rocksDBSlice(RocksDBEntryType const& type) {
       return IndexEstimateValue;
     case RocksDBEntryType::KeyGeneratorValue:
       return KeyGeneratorValue;
+    case RocksDBEntryType::CollectionStatisticsValue:
+      return CollectionStatisticsValue;
     case RocksDBEntryType::RevisionTreeValue:
       return RevisionTreeValue;
     case RocksDBEntryType::ZkdIndexValue:
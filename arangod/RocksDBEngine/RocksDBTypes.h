@@ -52,6 +52,7 @@ enum class RocksDBEntryType : char {
   LegacyGeoIndexValue = ';',
   IndexEstimateValue = '<',
   KeyGeneratorValue = '=',
+  CollectionStatisticsValue = '+',
   View = '>',
   GeoIndexValue = '?',
   LogEntry = 'L',
@@ -764,6 +764,25 @@ class RocksDBVPackIndexIterator final : public IndexIterator {
   }
 
   void skipImpl(uint64_t count, uint64_t& skipped) override {
+    if (_cache != nullptr) {
+      // go through the same code path as when producing results, so that
+      // skipping and counting the entries for a lookup value can be served
+      // from the in-memory cache, without scanning the index in RocksDB
+      if (count > 0) {
+        size_t const numFields = _index->hasStoredValues() ? 3 : 2;
+        nextImplementation(
+            [&skipped, numFields, this]() {
+              for (size_t i = 0; i < numFields; ++i) {
+                TRI_ASSERT(_resultIterator.valid());
+                _resultIterator.next();
+              }
+              ++skipped;
+            },
+            [&skipped]() { ++skipped; }, count);
+      }
+      return;
+    }
+
     ensureIterator();
     TRI_ASSERT(_trx->state()->isRunning());
     TRI_ASSERT(_iterator != nullptr);
@@ -111,6 +111,10 @@ RocksDBValue RocksDBValue::KeyGeneratorValue(VPackSlice data) {
   return RocksDBValue(RocksDBEntryType::KeyGeneratorValue, data);
 }
 
+RocksDBValue RocksDBValue::CollectionStatisticsValue(VPackSlice data) {
+  return RocksDBValue(RocksDBEntryType::CollectionStatisticsValue, data);
+}
+
 RocksDBValue RocksDBValue::S2Value(S2Point const& p) { return RocksDBValue(p); }
 
 RocksDBValue RocksDBValue::Empty(RocksDBEntryType type) {
@@ -264,6 +268,7 @@ RocksDBValue::RocksDBValue(RocksDBEntryType type, VPackSlice data)
     case RocksDBEntryType::ReplicatedState:
     case RocksDBEntryType::View:
     case RocksDBEntryType::KeyGeneratorValue:
+    case RocksDBEntryType::CollectionStatisticsValue:
     case RocksDBEntryType::ReplicationApplierConfig: {
       size_t byteSize = static_cast<size_t>(data.byteSize());
       _buffer.reserve(byteSize);
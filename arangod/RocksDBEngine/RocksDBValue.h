@@ -66,6 +66,7 @@ class RocksDBValue {
   static RocksDBValue View(VPackSlice data);
   static RocksDBValue ReplicationApplierConfig(VPackSlice data);
   static RocksDBValue KeyGeneratorValue(VPackSlice data);
+  static RocksDBValue CollectionStatisticsValue(VPackSlice data);
   static RocksDBValue S2Value(S2Point const& c);
   static RocksDBValue LogEntry(replication2::LogEntry const& entry);
 
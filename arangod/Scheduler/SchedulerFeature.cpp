@@ -231,6 +231,32 @@ sensible to reduce the default value to even `0.5`. This would mean that
 instances with a queue longer than 50% of their maximum queue capacity would
 return HTTP 503 instead of HTTP 200 when their availability API is probed.)");
 
+  options
+      ->addOption("--server.low-priority-target-queue-time",
+                  "The target queue time for low priority requests (in "
+                  "milliseconds, 0 = disable).",
+                  new UInt64Parameter(&_lowPriorityTargetQueueTime),
+                  arangodb::options::makeDefaultFlags(
+                      arangodb::options::Flags::DefaultNoComponents,
+                      arangodb::options::Flags::OnSingle,
+                      arangodb::options::Flags::OnCoordinator,
+                      arangodb::options::Flags::Uncommon))
+      .setIntroducedIn(31200)
+      .setLongDescription(R"(If set to a value greater than 0, the server
+rejects new low priority requests early if the queue time of low priority
+requests (see the `x-arango-queue-time-seconds` response header) stays above
+this target for a while, instead of letting the queue grow until it is full.
+
+Once the queue time has been above the target for 10 times the target (but
+at least 100 milliseconds), the server starts rejecting incoming low priority
+requests with HTTP 503, at an increasing rate, until the queue time drops
+below the target again. Requests with a higher priority are not affected, so
+that they keep a low latency even if the server is saturated with low
+priority requests such as AQL queries.
+
+The default value is `0`, i.e. requests are only rejected if the queue is
+full (see `--server.maximal-queue-size`).)");
+
   options->addOption(
       "--server.scheduler-queue-size",
       "The number of simultaneously queued requests inside the scheduler.",
@@ -337,7 +363,7 @@ void SchedulerFeature::prepare() {
   auto sched = std::make_unique<SupervisedScheduler>(
       server(), _nrMinimalThreads, _nrMaximalThreads, _queueSize, _fifo1Size,
       _fifo2Size, _fifo3Size, ongoingLowPriorityLimit,
-      _unavailabilityQueueFillGrade);
+      _unavailabilityQueueFillGrade, _lowPriorityTargetQueueTime);
 #if (_MSC_VER >= 1)
 #pragma warning(pop)
 #endif
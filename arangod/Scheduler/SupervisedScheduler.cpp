@@ -22,7 +22,10 @@
 /// @author Achim Brandt
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
 #include <atomic>
+#include <chrono>
+#include <cmath>
 #include <cstdint>
 #include <memory>
 
@@ -31,6 +34,7 @@
 #include "SupervisedScheduler.h"
 
 #include "ApplicationFeatures/ApplicationServer.h"
+#include "Basics/ScopeGuard.h"
 #include "Basics/StaticStrings.h"
 #include "Basics/StringUtils.h"
 #include "Basics/Thread.h"
@@ -190,6 +194,9 @@ DECLARE_COUNTER(arangodb_scheduler_queue_full_failures_total,
 DECLARE_COUNTER(arangodb_scheduler_queue_time_violations_total,
                 "Tasks dropped because the client-requested queue time "
                 "restriction would be violated");
+DECLARE_COUNTER(arangodb_scheduler_low_prio_admission_rejections_total,
+                "Tasks dropped because the low priority queue time was above "
+                "the target queue time for too long");
 DECLARE_GAUGE(arangodb_scheduler_queue_length, uint64_t,
               "Server's internal queue length");
 DECLARE_COUNTER(arangodb_scheduler_threads_started_total,
@@ -203,13 +210,15 @@ SupervisedScheduler::SupervisedScheduler(
     ArangodServer& server, uint64_t minThreads, uint64_t maxThreads,
     uint64_t maxQueueSize, uint64_t fifo1Size, uint64_t fifo2Size,
     uint64_t fifo3Size, uint64_t ongoingLowPriorityLimit,
-    double unavailabilityQueueFillGrade)
+    double unavailabilityQueueFillGrade, uint64_t lowPriorityTargetQueueTime)
     : Scheduler(server),
       _nf(server.getFeature<NetworkFeature>()),
       _sharedPRNG(server.getFeature<SharedPRNGFeature>()),
       _numWorkers(0),
       _stopping(false),
       _acceptingNewJobs(true),
+      _localQueues(std::make_unique<LocalQueue[]>(maxThreads)),
+      _numLocalJobs(0),
       _jobsSubmitted(0),
       _jobsDequeued(0),
       _jobsDone(0),
@@ -218,6 +227,9 @@ SupervisedScheduler::SupervisedScheduler(
       _maxFifoSizes{maxQueueSize, fifo1Size, fifo2Size, fifo3Size},
       _ongoingLowPriorityLimit(ongoingLowPriorityLimit),
       _unavailabilityQueueFillGrade(unavailabilityQueueFillGrade),
+      _lowPriorityTargetQueueTime(lowPriorityTargetQueueTime),
+      _lowPriorityAboveTarget(false),
+      _lowPriorityRejections(0),
       _numWorking(0),
       _numAwake(0),
       _metricsQueueLength(server.getFeature<metrics::MetricsFeature>().add(
@@ -254,6 +266,9 @@ SupervisedScheduler::SupervisedScheduler(
       _metricsQueueTimeViolations(
           server.getFeature<metrics::MetricsFeature>().add(
               arangodb_scheduler_queue_time_violations_total{})),
+      _metricsAdmissionRejections(
+          server.getFeature<metrics::MetricsFeature>().add(
+              arangodb_scheduler_low_prio_admission_rejections_total{})),
       _ongoingLowPriorityGauge(
           _server.getFeature<metrics::MetricsFeature>().add(
               arangodb_scheduler_ongoing_low_prio{})),
@@ -278,6 +293,11 @@ SupervisedScheduler::SupervisedScheduler(
 
 SupervisedScheduler::~SupervisedScheduler() = default;
 
+thread_local SupervisedScheduler* SupervisedScheduler::_schedulerOfThread =
+    nullptr;
+thread_local SupervisedScheduler::LocalQueue*
+    SupervisedScheduler::_localQueueOfThread = nullptr;
+
 void SupervisedScheduler::trackQueueItemSize(std::int64_t x) noexcept {
   _schedulerQueueMemory += x;
 }
@@ -296,6 +316,13 @@ bool SupervisedScheduler::queueItem(RequestLane lane,
   TRI_ASSERT(queueNo < NumberOfQueues);
 
   auto& queue = _queues[queueNo];
+  if (bounded && queueNo == LowPriorityQueue && !admitLowPriorityJob()) {
+    LOG_TOPIC("6a0d3", DEBUG, Logger::THREADS)
+        << "rejecting job for scheduler queue: low priority queue time is "
+           "above target";
+    ++_metricsAdmissionRejections;
+    return false;
+  }
   if (bounded) {
     auto maxSize = _maxFifoSizes[queueNo];
     if (queue.numCountedItems.fetch_add(1, std::memory_order_relaxed) >
@@ -332,7 +359,11 @@ bool SupervisedScheduler::queueItem(RequestLane lane,
     return p;
   };
   try {
-    _queues[queueNo].queue.push(makePointer(work.get()));
+    // only unbounded jobs may go into a local queue, because bounded jobs
+    // are counted in the global queue they belong to
+    if (bounded || !tryQueueLocal(queueNo, work.get())) {
+      _queues[queueNo].queue.push(makePointer(work.get()));
+    }
   } catch (...) {
     if (bounded) {
       queue.numCountedItems.fetch_sub(1, std::memory_order_relaxed);
@@ -436,6 +467,98 @@ bool SupervisedScheduler::queueItem(RequestLane lane,
   return true;
 }
 
+bool SupervisedScheduler::admitLowPriorityJob() {
+  if (_lowPriorityTargetQueueTime == 0) {
+    return true;
+  }
+
+  bool const aboveTarget =
+      getLastLowPriorityDequeueTime() > _lowPriorityTargetQueueTime;
+  if (!aboveTarget &&
+      !_lowPriorityAboveTarget.load(std::memory_order_relaxed)) {
+    // fast path: nothing to do
+    return true;
+  }
+
+  // we use the target queue time times 10 as the interval for which the
+  // queue time must stay above the target until we start rejecting jobs,
+  // but at least 100ms (the interval recommended for CoDel)
+  auto const interval =
+      std::max(std::chrono::milliseconds(100),
+               std::chrono::milliseconds(10 * _lowPriorityTargetQueueTime));
+  auto const now = std::chrono::steady_clock::now();
+
+  std::lock_guard guard(_admissionMutex);
+  if (!aboveTarget) {
+    // queue time went back to normal
+    _lowPriorityAboveTarget.store(false, std::memory_order_relaxed);
+    _lowPriorityRejections = 0;
+    return true;
+  }
+
+  if (!_lowPriorityAboveTarget.load(std::memory_order_relaxed)) {
+    // queue time just went above the target. do not reject anything yet,
+    // as this may be only a short burst
+    _lowPriorityAboveTarget.store(true, std::memory_order_relaxed);
+    _nextLowPriorityRejection = now + interval;
+    _lowPriorityRejections = 0;
+    return true;
+  }
+
+  if (now < _nextLowPriorityRejection) {
+    return true;
+  }
+
+  // queue time is persistently too high. reject this job, and schedule the
+  // next rejection. the time between rejections decreases with the square
+  // root of the number of rejections, so that the rejection rate increases
+  // until the queue time drops below the target again
+  ++_lowPriorityRejections;
+  _nextLowPriorityRejection =
+      now + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                interval / std::sqrt(static_cast<double>(
+                               _lowPriorityRejections)));
+  return false;
+}
+
+bool SupervisedScheduler::tryQueueLocal(uint64_t queueIdx,
+                                        WorkItemBase* item) noexcept {
+  if (_schedulerOfThread != this || _localQueueOfThread == nullptr) {
+    return false;
+  }
+  auto& slot = _localQueueOfThread->_items[queueIdx];
+  if (slot.load(std::memory_order_relaxed) != nullptr) {
+    // the slot is still occupied. we do not replace the job in it, so
+    // that a job cannot be delayed by a chain of newer jobs
+    return false;
+  }
+  // increase the counter before the job becomes visible, so that the
+  // counter is never lower than the actual number of local jobs
+  _numLocalJobs.fetch_add(1, std::memory_order_relaxed);
+  WorkItemBase* expected = nullptr;
+  if (!slot.compare_exchange_strong(expected, item, std::memory_order_release,
+                                    std::memory_order_relaxed)) {
+    // another thread cannot put a job into our slot, but play safe
+    _numLocalJobs.fetch_sub(1, std::memory_order_relaxed);
+    return false;
+  }
+  return true;
+}
+
+SupervisedScheduler::WorkItemBase* SupervisedScheduler::tryDequeueLocal(
+    LocalQueue& localQueue, uint64_t queueIdx) noexcept {
+  auto& slot = localQueue._items[queueIdx];
+  if (slot.load(std::memory_order_relaxed) == nullptr) {
+    return nullptr;
+  }
+  WorkItemBase* res = slot.exchange(nullptr, std::memory_order_acquire);
+  if (res != nullptr) {
+    _numLocalJobs.fetch_sub(1, std::memory_order_relaxed);
+    _metricsQueueLengths[queueIdx].get() -= 1;
+  }
+  return res;
+}
+
 bool SupervisedScheduler::start() {
   _manager = std::make_unique<SupervisedSchedulerManagerThread>(_server, *this);
   if (!_manager->start()) {
@@ -524,6 +647,13 @@ void SupervisedScheduler::runWorker() {
     TRI_ASSERT(!state->_ready);
   }
 
+  _schedulerOfThread = this;
+  _localQueueOfThread = state->_localQueue;
+  auto localQueueGuard = scopeGuard([]() noexcept {
+    _schedulerOfThread = nullptr;
+    _localQueueOfThread = nullptr;
+  });
+
   state->_sleepTimeout_ms = 20 * (id + 1);
   // cap the timeout to some boundary value
   if (state->_sleepTimeout_ms >= 1000) {
@@ -789,7 +919,16 @@ bool SupervisedScheduler::canPullFromQueue(uint64_t queueIndex) const noexcept {
 
 std::unique_ptr<SupervisedScheduler::WorkItemBase> SupervisedScheduler::getWork(
     std::shared_ptr<WorkerState>& state) {
-  auto checkAllQueues = [this](uint64_t& maxCheckedQueue) -> WorkItemBase* {
+  auto checkAllQueues = [this, &state](
+                            uint64_t& maxCheckedQueue) -> WorkItemBase* {
+    LocalQueue* localQueue = state->_localQueue;
+    // jobs in the own local queue are preferred, but only up to a limit, so
+    // that a worker which keeps queueing jobs for itself cannot starve the
+    // global queue of the same priority
+    if (localQueue != nullptr &&
+        state->_localJobsInARow >= MaxLocalJobsInARow) {
+      localQueue = nullptr;
+    }
     for (uint64_t i = 0; i < NumberOfQueues; ++i) {
       if (!this->canPullFromQueue(i)) {
         // if we can't pull from high prio, then we will not be able to
@@ -801,6 +940,13 @@ std::unique_ptr<SupervisedScheduler::WorkItemBase> SupervisedScheduler::getWork(
       }
       maxCheckedQueue = i;
       WorkItemBase* res;
+      if (localQueue != nullptr) {
+        res = tryDequeueLocal(*localQueue, i);
+        if (res != nullptr) {
+          ++state->_localJobsInARow;
+          return res;
+        }
+      }
       if (this->_queues[i].queue.pop(res)) {
         auto raw = reinterpret_cast<std::uintptr_t>(res);
         if (raw & 1) {
@@ -810,12 +956,32 @@ std::unique_ptr<SupervisedScheduler::WorkItemBase> SupervisedScheduler::getWork(
           res = reinterpret_cast<WorkItemBase*>(raw - 1);
         }
         _metricsQueueLengths[i].get() -= 1;
+        state->_localJobsInARow = 0;
         return res;
       }
     }
     // Please note that _queues[i].pop(res) can modify res even if it does
     // not return `true`. Therefore it is crucial that we return nullptr
     // here and not res! We have been there and do not want to go back!
+
+    if (_numLocalJobs.load(std::memory_order_relaxed) == 0) {
+      return nullptr;
+    }
+    // steal a job from the local queue of any worker (including our own
+    // one, in case we skipped it above). priorities are respected the
+    // same way as for the global queues
+    for (uint64_t i = 0; i < NumberOfQueues; ++i) {
+      if (!this->canPullFromQueue(i)) {
+        break;
+      }
+      for (size_t j = 0; j < _maxNumWorkers; ++j) {
+        WorkItemBase* res = tryDequeueLocal(_localQueues[j], i);
+        if (res != nullptr) {
+          state->_localJobsInARow = 0;
+          return res;
+        }
+      }
+    }
     return nullptr;
   };
 
@@ -915,6 +1081,16 @@ void SupervisedScheduler::startOneThread() {
     // start a new thread
     _workerStates.emplace_back(std::make_shared<WorkerState>(*this));
     state = _workerStates.back();
+
+    // claim a local queue which is not used by any other worker. there is
+    // always one, as there are as many local queues as possible workers
+    for (size_t i = 0; i < _maxNumWorkers; ++i) {
+      bool expected = false;
+      if (_localQueues[i]._inUse.compare_exchange_strong(expected, true)) {
+        state->_localQueue = &_localQueues[i];
+        break;
+      }
+    }
   }
 
   if (!state->start()) {
@@ -995,7 +1171,17 @@ SupervisedScheduler::WorkerState::WorkerState(SupervisedScheduler& scheduler)
       _ready(false),
       _lastJobStarted(clock::now()),
       _thread(std::make_unique<SupervisedSchedulerWorkerThread>(
-          scheduler._server, scheduler)) {}
+          scheduler._server, scheduler)),
+      _localQueue(nullptr),
+      _localJobsInARow(0) {}
+
+SupervisedScheduler::WorkerState::~WorkerState() {
+  if (_localQueue != nullptr) {
+    // jobs which are still in the local queue can be stolen by the other
+    // workers, so the local queue can be handed to the next worker as is
+    _localQueue->_inUse.store(false);
+  }
+}
 
 bool SupervisedScheduler::WorkerState::start() { return _thread->start(); }
 
@@ -25,6 +25,7 @@
 #pragma once
 
 #include <array>
+#include <chrono>
 #include <condition_variable>
 #include <functional>
 #include <list>
@@ -47,7 +48,8 @@ class SupervisedScheduler final : public Scheduler {
                       uint64_t maxThreads, uint64_t maxQueueSize,
                       uint64_t fifo1Size, uint64_t fifo2Size,
                       uint64_t fifo3Size, uint64_t ongoingLowPriorityLimit,
-                      double unavailabilityQueueFillGrade);
+                      double unavailabilityQueueFillGrade,
+                      uint64_t lowPriorityTargetQueueTime);
   ~SupervisedScheduler() final;
 
   bool start() override;
@@ -87,6 +89,10 @@ class SupervisedScheduler final : public Scheduler {
   static_assert(HighPriorityQueue < MediumPriorityQueue);
   static_assert(MediumPriorityQueue < LowPriorityQueue);
 
+  /// @brief maximum number of consecutive jobs a worker takes from its own
+  /// local queue before it prefers the global queues again
+  constexpr static uint64_t const MaxLocalJobsInARow = 16;
+
   /// @brief approximate fill grade of the scheduler's queue (in %)
   double approximateQueueFillGrade() const override;
 
@@ -101,6 +107,19 @@ class SupervisedScheduler final : public Scheduler {
   friend class SupervisedSchedulerManagerThread;
   friend class SupervisedSchedulerWorkerThread;
 
+  // each worker owns a local queue with one slot per priority. unbounded
+  // jobs queued from within a worker (e.g. future continuations) are put
+  // into the worker's own slot if it is empty, so that the worker picks
+  // them up right after its current job, while their data is still in the
+  // worker's CPU caches. all other workers can steal jobs from the slots,
+  // so that jobs never wait for a busy or blocked worker.
+  // local queues are never freed while the scheduler exists, so that a job
+  // which is still in the slot of an exited worker can still be stolen.
+  struct alignas(64) LocalQueue {
+    std::array<std::atomic<WorkItemBase*>, NumberOfQueues> _items{};
+    std::atomic<bool> _inUse{false};
+  };
+
   // each worker thread has a state block which contains configuration values.
   // _queueRetryTime_us is the number of microseconds this particular
   // thread should spin before going to sleep. Note that this spinning is only
@@ -118,6 +137,8 @@ class SupervisedScheduler final : public Scheduler {
   // started. _working indicates if the thread is currently processing a job.
   //    Hence if you want to know, if the thread has a long running job, test
   //    for _working && (now - _lastJobStarted) > eps
+  // _localQueue holds jobs which were queued by this worker itself. it is
+  //    nullptr if no local queue was available when the worker was started.
   struct WorkerState {
     uint64_t _queueRetryTime_us;  // t1
     uint64_t _sleepTimeout_ms;    // t2
@@ -130,9 +151,13 @@ class SupervisedScheduler final : public Scheduler {
     std::unique_ptr<SupervisedSchedulerWorkerThread> _thread;
     std::mutex _mutex;
     std::condition_variable _conditionWork;
+    LocalQueue* _localQueue;
+    // only accessed by the worker thread itself
+    uint64_t _localJobsInARow;
 
     // initialize with harmless defaults: spin once, sleep forever
     explicit WorkerState(SupervisedScheduler& scheduler);
+    ~WorkerState();
     WorkerState(WorkerState const&) = delete;
     WorkerState& operator=(WorkerState const&) = delete;
 
@@ -141,6 +166,21 @@ class SupervisedScheduler final : public Scheduler {
   };
 
   std::unique_ptr<WorkItemBase> getWork(std::shared_ptr<WorkerState>& state);
+
+  /// @brief admission control for bounded low priority jobs (i.e. incoming
+  /// client requests). returns false if the job should be rejected because
+  /// the low priority queue time has been above the target for too long
+  bool admitLowPriorityJob();
+
+  /// @brief puts the job into the local queue of the current thread, if the
+  /// current thread is a worker of this scheduler and the slot for the
+  /// queue is empty. returns whether the job was queued
+  bool tryQueueLocal(uint64_t queueIdx, WorkItemBase* item) noexcept;
+
+  /// @brief takes a job out of the local queue's slot for the queue
+  WorkItemBase* tryDequeueLocal(LocalQueue& localQueue,
+                                uint64_t queueIdx) noexcept;
+
   void startOneThread();
   void stopOneThread();
 
@@ -177,6 +217,16 @@ class SupervisedScheduler final : public Scheduler {
     boost::lockfree::queue<WorkItemBase*> queue;
   } _queues[NumberOfQueues];
 
+  /// @brief local queues, one for each possible worker thread
+  std::unique_ptr<LocalQueue[]> _localQueues;
+  /// @brief scheduler and local queue of the current worker thread, if any
+  static thread_local SupervisedScheduler* _schedulerOfThread;
+  static thread_local LocalQueue* _localQueueOfThread;
+  /// @brief number of jobs in all local queues. it may be higher than the
+  /// actual number of jobs, but never lower, so that a worker can skip
+  /// looking at all local queues if it is 0
+  alignas(64) std::atomic<uint64_t> _numLocalJobs;
+
   // aligning required to prevent false sharing - assumes cache line size is 64
   alignas(64) std::atomic<uint64_t> _jobsSubmitted;
   alignas(64) std::atomic<uint64_t> _jobsDequeued;
@@ -191,6 +241,24 @@ class SupervisedScheduler final : public Scheduler {
   /// the server is considered unavailable (because of overload)
   double const _unavailabilityQueueFillGrade;
 
+  /// @brief target queue time for low priority jobs [ms] (0 = disabled).
+  /// if the dequeue time of low priority jobs stays above this target for
+  /// longer than an interval, new bounded low priority jobs are rejected at
+  /// an increasing rate (CoDel-style), until the dequeue time drops below
+  /// the target again
+  uint64_t const _lowPriorityTargetQueueTime;
+
+  /// @brief whether the low priority dequeue time is above the target. only
+  /// if this is true, _admissionMutex needs to be acquired
+  std::atomic<bool> _lowPriorityAboveTarget;
+
+  /// @brief protects the following admission control state
+  std::mutex _admissionMutex;
+  /// @brief when to reject the next job, if we are rejecting at all
+  std::chrono::steady_clock::time_point _nextLowPriorityRejection;
+  /// @brief number of jobs rejected since we started rejecting
+  uint64_t _lowPriorityRejections;
+
   std::list<std::shared_ptr<WorkerState>> _workerStates;
   std::list<std::shared_ptr<WorkerState>> _abandonedWorkerStates;
   std::atomic<uint64_t> _numWorking;  // Number of threads actually working
@@ -224,6 +292,7 @@ class SupervisedScheduler final : public Scheduler {
   metrics::Counter& _metricsThreadsStopped;
   metrics::Counter& _metricsQueueFull;
   metrics::Counter& _metricsQueueTimeViolations;
+  metrics::Counter& _metricsAdmissionRejections;
   metrics::Gauge<uint64_t>& _ongoingLowPriorityGauge;
 
   /// @brief amount of time it took for the last low prio item to be dequeued
@@ -64,6 +64,9 @@ void ShardingFeature::prepare() {
   registerFactory(ShardingStrategyHash::NAME, [](ShardingInfo* sharding) {
     return std::make_unique<ShardingStrategyHash>(sharding);
   });
+  registerFactory(ShardingStrategyJumpHash::NAME, [](ShardingInfo* sharding) {
+    return std::make_unique<ShardingStrategyJumpHash>(sharding);
+  });
 #ifdef USE_ENTERPRISE
   // the following sharding strategies are only available in the
   // Enterprise Edition
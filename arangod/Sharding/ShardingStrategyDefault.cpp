@@ -56,6 +56,20 @@ void preventUseOnSmartEdgeCollection(LogicalCollection const* collection,
   }
 }
 
+/// @brief whether the shard keys are only "_key", or its prefix/suffix
+bool usesKeyShardKey(std::span<std::string const> shardKeys) {
+  TRI_ASSERT(!shardKeys.empty());
+
+  return shardKeys.size() == 1 &&
+         (shardKeys[0] == StaticStrings::KeyString ||
+          (shardKeys[0][0] == ':' &&
+           shardKeys[0].compare(1, shardKeys[0].size() - 1,
+                                StaticStrings::KeyString) == 0) ||
+          (shardKeys[0].back() == ':' &&
+           shardKeys[0].compare(0, shardKeys[0].size() - 1,
+                                StaticStrings::KeyString) == 0));
+}
+
 inline void parseAttributeAndPart(std::string_view attr,
                                   std::string_view& realAttr, Part& part) {
   if (!attr.empty() && attr.back() == ':') {
@@ -214,6 +228,7 @@ std::string const ShardingStrategyNone::NAME("none");
 std::string const ShardingStrategyCommunityCompat::NAME("community-compat");
 std::string const ShardingStrategyEnterpriseCompat::NAME("enterprise-compat");
 std::string const ShardingStrategyHash::NAME("hash");
+std::string const ShardingStrategyJumpHash::NAME("jump-hash");
 
 /// @brief a sharding class used for single server and the DB servers
 /// calling getResponsibleShard on this class will always throw an exception
@@ -300,7 +315,7 @@ ErrorCode ShardingStrategyHashBase::getResponsibleShard(
 
     // To improve our hash function result:
     hashval = FnvHashBlock(hashval, magicPhrase, magicLength);
-    shardID = shards[hashval % shards.size()];
+    shardID = shards[shardIndex(hashval, shards.size())];
   }
   return res;
 }
@@ -363,19 +378,7 @@ ShardingStrategyEnterpriseBase::ShardingStrategyEnterpriseBase(
   // whether or not the collection uses the default shard attributes (["_key"])
   // this setting is initialized to false, and we may change it now
   TRI_ASSERT(!_usesDefaultShardKeys);
-  auto shardKeys = _sharding->shardKeys();
-  TRI_ASSERT(!shardKeys.empty());
-
-  if (shardKeys.size() == 1) {
-    _usesDefaultShardKeys =
-        (shardKeys[0] == StaticStrings::KeyString ||
-         (shardKeys[0][0] == ':' &&
-          shardKeys[0].compare(1, shardKeys[0].size() - 1,
-                               StaticStrings::KeyString) == 0) ||
-         (shardKeys[0].back() == ':' &&
-          shardKeys[0].compare(0, shardKeys[0].size() - 1,
-                               StaticStrings::KeyString) == 0));
-  }
+  _usesDefaultShardKeys = ::usesKeyShardKey(_sharding->shardKeys());
 }
 
 /// @brief this implementation of "hashByAttributes" is slightly different
@@ -404,19 +407,7 @@ ShardingStrategyHash::ShardingStrategyHash(ShardingInfo* sharding)
   // whether or not the collection uses the default shard attributes (["_key"])
   // this setting is initialized to false, and we may change it now
   TRI_ASSERT(!_usesDefaultShardKeys);
-  auto shardKeys = _sharding->shardKeys();
-  TRI_ASSERT(!shardKeys.empty());
-
-  if (shardKeys.size() == 1) {
-    _usesDefaultShardKeys =
-        (shardKeys[0] == StaticStrings::KeyString ||
-         (shardKeys[0][0] == ':' &&
-          shardKeys[0].compare(1, shardKeys[0].size() - 1,
-                               StaticStrings::KeyString) == 0) ||
-         (shardKeys[0].back() == ':' &&
-          shardKeys[0].compare(0, shardKeys[0].size() - 1,
-                               StaticStrings::KeyString) == 0));
-  }
+  _usesDefaultShardKeys = ::usesKeyShardKey(_sharding->shardKeys());
 
   ::preventUseOnSmartEdgeCollection(_sharding->collection(), NAME);
 }
@@ -432,3 +423,36 @@ bool ShardingStrategyHash::isCompatible(const ShardingStrategy* other) const {
   return name() == other->name();
 #endif
 }
+
+/// @brief hash-based sharding strategy using jump consistent hashing
+ShardingStrategyJumpHash::ShardingStrategyJumpHash(ShardingInfo* sharding)
+    : ShardingStrategyHashBase(sharding) {
+  // whether or not the collection uses the default shard attributes (["_key"])
+  // this setting is initialized to false, and we may change it now
+  TRI_ASSERT(!_usesDefaultShardKeys);
+  _usesDefaultShardKeys = ::usesKeyShardKey(_sharding->shardKeys());
+
+  ::preventUseOnSmartEdgeCollection(_sharding->collection(), NAME);
+}
+
+std::size_t ShardingStrategyJumpHash::shardIndex(
+    uint64_t hashval, std::size_t numShards) const noexcept {
+  return jumpConsistentHash(hashval, numShards);
+}
+
+/// @brief jump consistent hash, see "A Fast, Minimal Memory, Consistent Hash
+/// Algorithm" by John Lamping and Eric Veach
+std::size_t ShardingStrategyJumpHash::jumpConsistentHash(
+    uint64_t hashval, std::size_t numBuckets) noexcept {
+  TRI_ASSERT(numBuckets > 0);
+  int64_t b = -1;
+  int64_t j = 0;
+  while (j < static_cast<int64_t>(numBuckets)) {
+    b = j;
+    hashval = hashval * 2862933555777941757ULL + 1;
+    j = static_cast<int64_t>(static_cast<double>(b + 1) *
+                             (static_cast<double>(1LL << 31) /
+                              static_cast<double>((hashval >> 33) + 1)));
+  }
+  return static_cast<std::size_t>(b);
+}
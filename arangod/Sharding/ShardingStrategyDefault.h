@@ -101,6 +101,13 @@ class ShardingStrategyHashBase : public ShardingStrategy {
  protected:
   std::span<ShardID const> determineShards();
 
+  /// @brief maps the (final) hash value of a document to the index of its
+  /// shard, in the range [0, numShards)
+  virtual std::size_t shardIndex(uint64_t hashval,
+                                 std::size_t numShards) const noexcept {
+    return hashval % numShards;
+  }
+
   ShardingInfo* _sharding;
   bool _usesDefaultShardKeys;
 
@@ -162,4 +169,32 @@ class ShardingStrategyHash final : public ShardingStrategyHashBase {
   bool isCompatible(ShardingStrategy const* other) const override;
 };
 
+/// @brief hash-based sharding strategy that uses jump consistent hashing
+/// (Lamping/Veach) instead of modulo to map hash values to shards.
+/// when a shard is appended to the list of shards, only 1/(n + 1) of the
+/// documents move to it, and no documents move between the existing shards.
+/// this makes resharding by adding shards much cheaper than with "hash",
+/// where almost all documents would change their shard.
+/// servers of older versions do not know this strategy, so it must not be
+/// used in a cluster that still contains servers of a version before 3.12,
+/// e.g. during a rolling upgrade.
+class ShardingStrategyJumpHash final : public ShardingStrategyHashBase {
+ public:
+  explicit ShardingStrategyJumpHash(ShardingInfo* sharding);
+
+  std::string const& name() const override { return NAME; }
+
+  static std::string const NAME;
+
+  /// @brief maps a hash value to a bucket in the range [0, numBuckets).
+  /// the mapping determines where documents are stored, so it must never
+  /// change
+  static std::size_t jumpConsistentHash(uint64_t hashval,
+                                        std::size_t numBuckets) noexcept;
+
+ protected:
+  std::size_t shardIndex(uint64_t hashval,
+                         std::size_t numShards) const noexcept override;
+};
+
 }  // namespace arangodb
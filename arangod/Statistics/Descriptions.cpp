@@ -521,6 +521,7 @@ void stats::Descriptions::clientStatistics(
   FillDistribution(b, "requestTime", requestStats.requestTime);
   FillDistribution(b, "queueTime", requestStats.queueTime);
   FillDistribution(b, "ioTime", requestStats.ioTime);
+  FillDistribution(b, "suspendedTime", requestStats.suspendedTime);
   FillDistribution(b, "bytesSent", requestStats.bytesSent);
   FillDistribution(b, "bytesReceived", requestStats.bytesReceived);
 }
@@ -193,6 +193,7 @@ void RequestStatistics::process(RequestStatistics* statistics) {
 
     double requestTime = statistics->_requestEnd - statistics->_requestStart;
     figures.requestTimeDistribution.addFigure(requestTime);
+    figures.suspendedTimeDistribution.addFigure(statistics->_suspendedTime);
 
     double queueTime = 0.0;
     if (statistics->_queueStart != 0.0 && statistics->_queueEnd != 0.0) {
@@ -227,6 +228,7 @@ void RequestStatistics::getSnapshot(Snapshot& snapshot,
   snapshot.requestTime = figures.requestTimeDistribution;
   snapshot.queueTime = figures.queueTimeDistribution;
   snapshot.ioTime = figures.ioTimeDistribution;
+  snapshot.suspendedTime = figures.suspendedTimeDistribution;
   snapshot.bytesSent = figures.bytesSentDistribution;
   snapshot.bytesReceived = figures.bytesReceivedDistribution;
 
@@ -239,6 +241,8 @@ void RequestStatistics::getSnapshot(Snapshot& snapshot,
     snapshot.queueTime.add(
         statistics::UserRequestFigures.queueTimeDistribution);
     snapshot.ioTime.add(statistics::UserRequestFigures.ioTimeDistribution);
+    snapshot.suspendedTime.add(
+        statistics::UserRequestFigures.suspendedTimeDistribution);
     snapshot.bytesSent.add(
         statistics::UserRequestFigures.bytesSentDistribution);
     snapshot.bytesReceived.add(
@@ -254,7 +258,8 @@ std::string RequestStatistics::Item::timingsCsv() const {
      << (_stat->_readEnd - _stat->_readStart) << ",queue,"
      << (_stat->_queueEnd - _stat->_queueStart) << ",queue-size,"
      << _stat->_queueSize << ",request,"
-     << (_stat->_requestEnd - _stat->_requestStart) << ",total,"
+     << (_stat->_requestEnd - _stat->_requestStart) << ",suspended,"
+     << _stat->_suspendedTime << ",total,"
      << (StatisticsFeature::time() - _stat->_readStart);
 
   return ss.str();
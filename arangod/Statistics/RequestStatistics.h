@@ -140,6 +140,20 @@ class RequestStatistics {
       }
     }
 
+    void SET_SUSPEND_START() const {
+      if (_stat != nullptr) {
+        _stat->_suspendStart = StatisticsFeature::time();
+      }
+    }
+
+    void SET_SUSPEND_END() const {
+      if (_stat != nullptr && _stat->_suspendStart != 0.0) {
+        _stat->_suspendedTime +=
+            StatisticsFeature::time() - _stat->_suspendStart;
+        _stat->_suspendStart = 0.0;
+      }
+    }
+
     void SET_REQUEST_START_END() const {
       if (_stat != nullptr) {
         _stat->_requestStart = StatisticsFeature::time();
@@ -183,6 +197,7 @@ class RequestStatistics {
     statistics::Distribution requestTime;
     statistics::Distribution queueTime;
     statistics::Distribution ioTime;
+    statistics::Distribution suspendedTime;
     statistics::Distribution bytesSent;
     statistics::Distribution bytesReceived;
   };
@@ -205,6 +220,8 @@ class RequestStatistics {
     _requestEnd = 0.0;
     _writeStart = 0.0;
     _writeEnd = 0.0;
+    _suspendStart = 0.0;
+    _suspendedTime = 0.0;
     _receivedBytes = 0.0;
     _sentBytes = 0.0;
     _requestType = rest::RequestType::ILLEGAL;
@@ -222,6 +239,10 @@ class RequestStatistics {
   double _requestEnd;
   double _writeStart;
   double _writeEnd;
+  // RestHandler paused, waiting for e.g. a network response
+  double _suspendStart;
+  // total time the RestHandler was paused, part of the request time
+  double _suspendedTime;
 
   double _receivedBytes;
   double _sentBytes;
@@ -196,6 +196,10 @@ DECLARE_HISTOGRAM(arangodb_client_connection_statistics_queue_time,
                   RequestTimeScale, "Queue time needed to answer a request");
 DECLARE_HISTOGRAM(arangodb_client_connection_statistics_io_time,
                   RequestTimeScale, "IO time needed to answer a request");
+DECLARE_HISTOGRAM(arangodb_client_connection_statistics_suspended_time,
+                  RequestTimeScale,
+                  "Time a request handler was suspended, waiting for other "
+                  "operations to complete");
 DECLARE_COUNTER(arangodb_http_request_statistics_total_requests_total,
                 "Total number of HTTP requests");
 DECLARE_COUNTER(arangodb_http_request_statistics_superuser_requests_total,
@@ -354,6 +358,18 @@ auto const statStrings = std::map<std::string_view,
     {"ioTimeSum",
      {"arangodb_client_connection_statistics_io_time_sum", "gauge",
       "IO time needed to answer a request"}},
+    {"suspendedTime",
+     {"arangodb_client_connection_statistics_suspended_time", "histogram",
+      "Time a request handler was suspended, waiting for other operations to "
+      "complete"}},
+    {"suspendedTimeCount",
+     {"arangodb_client_connection_statistics_suspended_time_count", "gauge",
+      "Time a request handler was suspended, waiting for other operations to "
+      "complete"}},
+    {"suspendedTimeSum",
+     {"arangodb_client_connection_statistics_suspended_time_sum", "gauge",
+      "Time a request handler was suspended, waiting for other operations to "
+      "complete"}},
     {"httpReqsTotal",
      {"arangodb_http_request_statistics_total_requests_total", "counter",
       "Total number of HTTP requests"}},
@@ -483,6 +499,10 @@ auto const statBuilder = makeStatBuilder({
     {"ioTime", new arangodb_client_connection_statistics_io_time()},
     {"ioTimeCount", nullptr},
     {"ioTimeSum", nullptr},
+    {"suspendedTime",
+     new arangodb_client_connection_statistics_suspended_time()},
+    {"suspendedTimeCount", nullptr},
+    {"suspendedTimeSum", nullptr},
     {"httpReqsTotal",
      new arangodb_http_request_statistics_total_requests_total()},
     {"httpReqsSuperuser",
@@ -539,6 +559,7 @@ RequestFigures::RequestFigures()
       ioTimeDistribution(RequestTimeDistributionCuts),
       queueTimeDistribution(RequestTimeDistributionCuts),
       requestTimeDistribution(RequestTimeDistributionCuts),
+      suspendedTimeDistribution(RequestTimeDistributionCuts),
       totalTimeDistribution(RequestTimeDistributionCuts) {}
 
 RequestFigures SuperuserRequestFigures;
@@ -970,6 +991,10 @@ void StatisticsFeature::toPrometheus(std::string& result, double now,
                     {"0.01", "0.05", "0.1", "0.2", "0.5", "1.0", "5.0", "15.0",
                      "30.0", "+Inf"},
                     false, ensureWhitespace);
+    appendHistogram(result, requestStats.suspendedTime, "suspendedTime",
+                    {"0.01", "0.05", "0.1", "0.2", "0.5", "1.0", "5.0", "15.0",
+                     "30.0", "+Inf"},
+                    false, ensureWhitespace);
     appendHistogram(result, requestStats.bytesSent, "bytesSent",
                     {"250", "1000", "2000", "5000", "10000", "+Inf"}, true,
                     ensureWhitespace);
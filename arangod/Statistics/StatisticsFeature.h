@@ -76,6 +76,7 @@ struct RequestFigures {
   Distribution ioTimeDistribution;
   Distribution queueTimeDistribution;
   Distribution requestTimeDistribution;
+  Distribution suspendedTimeDistribution;
   Distribution totalTimeDistribution;
 };
 extern RequestFigures SuperuserRequestFigures;
@@ -159,6 +159,38 @@ bool PhysicalCollection::hasDocuments() {
       "hasDocuments not implemented for this engine");
 }
 
+std::shared_ptr<CollectionStatistics const> PhysicalCollection::statistics()
+    const {
+  return nullptr;
+}
+
+Result PhysicalCollection::readMany(transaction::Methods* trx,
+                                    std::span<LocalDocumentId const> tokens,
+                                    IndexIterator::DocumentCallback const& cb,
+                                    ReadOwnWrites readOwnWrites) const {
+  Result res;
+  for (auto const& token : tokens) {
+    Result r = read(trx, token, cb, readOwnWrites);
+    if (r.fail() && !r.is(TRI_ERROR_ARANGO_DOCUMENT_NOT_FOUND) && res.ok()) {
+      res = std::move(r);
+    }
+  }
+  return res;
+}
+
+std::unique_ptr<IndexIterator> PhysicalCollection::getRangeIterator(
+    transaction::Methods* /*trx*/, ReadOwnWrites /*readOwnWrites*/,
+    LocalDocumentId /*lower*/, LocalDocumentId /*upper*/) const {
+  THROW_ARANGO_EXCEPTION_MESSAGE(
+      TRI_ERROR_NOT_IMPLEMENTED,
+      "getRangeIterator not implemented for this engine");
+}
+
+std::vector<LocalDocumentId> PhysicalCollection::partitionDocuments(
+    size_t /*partitions*/) const {
+  return {};
+}
+
 /// @brief Find index by definition
 /*static*/ std::shared_ptr<Index> PhysicalCollection::findIndex(
     velocypack::Slice info, IndexContainerType const& indexes) {
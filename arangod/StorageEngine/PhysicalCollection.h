@@ -38,6 +38,7 @@
 #include <functional>
 #include <memory>
 #include <set>
+#include <span>
 #include <string>
 #include <string_view>
 #include <type_traits>
@@ -53,6 +54,7 @@ class Builder;
 class Slice;
 }  // namespace velocypack
 
+class CollectionStatistics;
 class LocalDocumentId;
 class Index;
 class IndexIterator;
@@ -89,6 +91,18 @@ class PhysicalCollection {
   /// function is allowed to return true even if there are no documents
   virtual bool hasDocuments();
 
+  /// @brief statistics about the attribute values of the documents, for
+  /// the optimizer's cost estimation. returns a nullptr if there are none
+  virtual std::shared_ptr<CollectionStatistics const> statistics() const;
+
+  /// @brief approximate size of the documents and indexes in storage, in
+  /// bytes. returns 0 if unknown
+  virtual uint64_t approximateSize() { return 0; }
+
+  /// @brief number of document operations committed since the server was
+  /// started
+  virtual uint64_t numberWrites() const noexcept { return 0; }
+
   ////////////////////////////////////
   // -- SECTION Indexes --
   ///////////////////////////////////
@@ -155,6 +169,20 @@ class PhysicalCollection {
   virtual std::unique_ptr<IndexIterator> getAnyIterator(
       transaction::Methods* trx) const = 0;
 
+  /// @brief iterator over the documents with a LocalDocumentId in the range
+  /// [lower, upper), in the order of their LocalDocumentIds. an empty upper
+  /// bound means that the range is unbounded
+  virtual std::unique_ptr<IndexIterator> getRangeIterator(
+      transaction::Methods* trx, ReadOwnWrites readOwnWrites,
+      LocalDocumentId lower, LocalDocumentId upper) const;
+
+  /// @brief splits the documents into at most the given number of ranges of
+  /// roughly the same size, for scanning them in parallel. returns the
+  /// ascending bounds between the ranges, for use with getRangeIterator().
+  /// returns no bounds if the engine does not support this
+  virtual std::vector<LocalDocumentId> partitionDocuments(
+      size_t partitions) const;
+
   /// @brief Get an iterator associated with the specified replication batch
   virtual std::unique_ptr<ReplicationIterator> getReplicationIterator(
       ReplicationIterator::Ordering, uint64_t batchId);
@@ -207,6 +235,15 @@ class PhysicalCollection {
                       IndexIterator::DocumentCallback const& cb,
                       ReadOwnWrites readOwnWrites) const = 0;
 
+  /// @brief read multiple documents at once. calls the callback for all
+  /// documents that are found, in the order of the document ids. the
+  /// default implementation reads the documents one by one. returns the
+  /// first error other than "document not found"
+  virtual Result readMany(transaction::Methods* trx,
+                          std::span<LocalDocumentId const> tokens,
+                          IndexIterator::DocumentCallback const& cb,
+                          ReadOwnWrites readOwnWrites) const;
+
   virtual Result lookupDocument(transaction::Methods& trx,
                                 LocalDocumentId token,
                                 velocypack::Builder& builder, bool readCache,
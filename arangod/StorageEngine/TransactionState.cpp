@@ -414,9 +414,29 @@ Result TransactionState::checkCollectionPermission(
   return Result{};
 }
 
+/// @brief the document changes recorded for updating the query results cache
+/// when the transaction commits, or a nullptr if the changes are not recorded
+aql::QueryCacheChanges* TransactionState::queryCacheChanges() {
+  if (!_queryCacheChangesInitialized) {
+    _queryCacheChangesInitialized = true;
+    // the query cache is only used on single servers
+    auto* queryCache = aql::QueryCache::instance();
+    if (_serverRole == ServerState::ROLE_SINGLE && queryCache->mayBeActive() &&
+        queryCache->incremental()) {
+      _queryCacheChanges = std::make_unique<aql::QueryCacheChanges>();
+    }
+  }
+  return _queryCacheChanges.get();
+}
+
+/// @brief drop the recorded document changes
+void TransactionState::discardQueryCacheChanges() noexcept {
+  _queryCacheChanges.reset();
+}
+
 /// @brief clear the query cache for all collections that were modified by
-/// the transaction
-void TransactionState::clearQueryCache() const {
+/// the transaction, or update it with the recorded changes
+void TransactionState::clearQueryCache() {
   if (_collections.empty()) {
     return;
   }
@@ -434,7 +454,16 @@ void TransactionState::clearQueryCache() const {
       }
     }
 
-    if (!collections.empty()) {
+    if (_queryCacheChanges != nullptr) {
+      if (!collections.empty()) {
+        // after a commit, the tick of the last operation is the tick of the
+        // commit
+        arangodb::aql::QueryCache::instance()->update(
+            &_vocbase, collections, *_queryCacheChanges, lastOperationTick());
+      }
+      // an intermediate commit. the transaction's operations go on recording
+      _queryCacheChanges->clear();
+    } else if (!collections.empty()) {
       arangodb::aql::QueryCache::instance()->invalidate(&_vocbase, collections);
     }
   } catch (...) {
@@ -59,6 +59,9 @@ struct TRI_vocbase_t;
 
 namespace arangodb {
 
+namespace aql {
+class QueryCacheChanges;
+}
 namespace transaction {
 class Methods;
 struct Options;
@@ -329,6 +332,19 @@ class TransactionState : public std::enable_shared_from_this<TransactionState> {
   ///       transaction is committed
   [[nodiscard]] virtual TRI_voc_tick_t lastOperationTick() const noexcept = 0;
 
+  /// @returns tick up to which all committed changes are visible to the
+  /// transaction, or 0 if the storage engine cannot tell
+  [[nodiscard]] virtual TRI_voc_tick_t snapshotTick() const { return 0; }
+
+  /// @brief the document changes recorded for updating the query results
+  /// cache when the transaction commits, or a nullptr if the changes are not
+  /// recorded. whether or not they are recorded is decided on the first call
+  aql::QueryCacheChanges* queryCacheChanges();
+
+  /// @brief drop the recorded document changes, e.g. because the transaction
+  /// is aborted
+  void discardQueryCacheChanges() noexcept;
+
   void acceptAnalyzersRevision(
       QueryAnalyzerRevisions const& analyzersRevsion) noexcept;
 
@@ -364,8 +380,8 @@ class TransactionState : public std::enable_shared_from_this<TransactionState> {
       -> std::variant<CollectionNotFound, CollectionFound>;
 
   /// @brief clear the query cache for all collections that were modified by
-  /// the transaction
-  void clearQueryCache() const;
+  /// the transaction, or update it with the recorded changes
+  void clearQueryCache();
 
 #ifdef ARANGODB_USE_GOOGLE_TESTS
   // reset the internal Transaction ID to none.
@@ -437,6 +453,10 @@ class TransactionState : public std::enable_shared_from_this<TransactionState> {
 
   QueryAnalyzerRevisions _analyzersRevision;
   bool _registeredTransaction = false;
+
+  /// @brief document changes for updating the query results cache
+  std::unique_ptr<aql::QueryCacheChanges> _queryCacheChanges;
+  bool _queryCacheChangesInitialized = false;
 };
 
 }  // namespace arangodb
@@ -157,11 +157,12 @@ bool Manager::ManagedTrx::hasPerformedIntermediateCommits() const noexcept {
 }
 
 bool Manager::ManagedTrx::expired() const noexcept {
-  return this->expiryTime < TRI_microtime();
+  return this->expiryTime.load(std::memory_order_relaxed) < TRI_microtime();
 }
 
 void Manager::ManagedTrx::updateExpiry() noexcept {
-  this->expiryTime = TRI_microtime() + this->timeToLive;
+  this->expiryTime.store(TRI_microtime() + this->timeToLive,
+                         std::memory_order_relaxed);
 }
 
 Manager::ManagedTrx::~ManagedTrx() {
@@ -902,8 +903,12 @@ void Manager::returnManagedTrx(TransactionId tid, bool isSideUser) noexcept {
   bool isSoftAborted = false;
 
   {
+    // a read lock on the bucket is sufficient here. we only modify the
+    // transaction's atomic members and release the transaction's own lock.
+    // soft-aborting, committing and aborting all need the bucket's write
+    // lock, so they cannot run concurrently
     size_t bucket = getBucket(tid);
-    WRITE_LOCKER(writeLocker, _transactions[bucket]._lock);
+    READ_LOCKER(readLocker, _transactions[bucket]._lock);
 
     auto it = _transactions[bucket]._managed.find(tid);
     if (it == _transactions[bucket]._managed.end() ||
@@ -928,8 +933,11 @@ void Manager::returnManagedTrx(TransactionId tid, bool isSideUser) noexcept {
       // here, because we have not acquired it before!
     } else {
       // garbageCollection might soft abort used transactions
-      isSoftAborted = it->second.expiryTime == 0;
+      isSoftAborted =
+          it->second.expiryTime.load(std::memory_order_relaxed) == 0;
       if (!isSoftAborted) {
+        // must happen before we release the transaction's lock, because
+        // garbageCollect re-checks the expiry after acquiring that lock
         it->second.updateExpiry();
       }
 
@@ -937,7 +945,7 @@ void Manager::returnManagedTrx(TransactionId tid, bool isSideUser) noexcept {
     }
   }
 
-  // it is important that we release the write lock for the bucket here,
+  // it is important that we release the lock for the bucket here,
   // because abortManagedTrx will call statusChangeWithTimeout, which will
   // call updateTransaction, which then will try to acquire the same
   // write lock
@@ -1249,11 +1257,19 @@ bool Manager::garbageCollect(bool abortAll) {
       if (mtrx.type == MetaType::Managed) {
         TRI_ASSERT(mtrx.state != nullptr);
         if (abortAll || mtrx.expired()) {
-          ++numAborted;
-
           TRY_WRITE_LOCKER(tryGuard,
                            mtrx.rwlock);  // needs lock to access state
 
+          // we only hold the bucket's read lock here, so the transaction
+          // may have been returned and its expiry extended after the check
+          // above. returnManagedTrx updates the expiry before releasing the
+          // transaction's lock, so check again now that we own that lock
+          if (tryGuard.isLocked() && !abortAll && !mtrx.expired()) {
+            continue;
+          }
+
+          ++numAborted;
+
           if (tryGuard.isLocked()) {
             TRI_ASSERT(mtrx.state->isRunning());
             TRI_ASSERT(it.first == mtrx.state->id());
@@ -1263,7 +1279,8 @@ bool Manager::garbageCollect(bool abortAll) {
           } else if (abortAll) {  // transaction is in use but we want to abort
             LOG_TOPIC("92431", INFO, Logger::TRANSACTIONS)
                 << "soft-aborting expired transaction " << it.first;
-            mtrx.expiryTime = 0;  // soft-abort transaction
+            // soft-abort transaction
+            mtrx.expiryTime.store(0, std::memory_order_relaxed);
             didWork = true;
             LOG_TOPIC("7ad4f", INFO, Logger::TRANSACTIONS)
                 << "soft aborting transaction " << it.first;
@@ -103,7 +103,9 @@ class Manager final : public IManager {
     /// repeated commit / abort messages
     transaction::Status finalStatus;
     double const timeToLive;
-    double expiryTime;                        // time this expires
+    /// @brief time this expires. atomic, so that it can be updated when the
+    /// transaction is returned while only holding the bucket's read lock
+    std::atomic<double> expiryTime;
     std::shared_ptr<TransactionState> state;  /// Transaction, may be nullptr
     arangodb::cluster::CallbackGuard rGuard;
     std::string const user;  /// user owning the transaction
@@ -33,6 +33,7 @@
 #include "ApplicationFeatures/ApplicationServer.h"
 #include "Aql/Ast.h"
 #include "Aql/AstNode.h"
+#include "Aql/QueryCacheUpdater.h"
 #include "Basics/Exceptions.h"
 #include "Basics/DownCast.h"
 #include "Basics/GlobalResourceMonitor.h"
@@ -80,6 +81,7 @@
 #include "Utils/ExecContext.h"
 #include "Utils/OperationOptions.h"
 #include "VocBase/ComputedValues.h"
+#include "VocBase/Identifiers/LocalDocumentId.h"
 #include "VocBase/Identifiers/RevisionId.h"
 #include "VocBase/KeyGenerator.h"
 #include "VocBase/LogicalCollection.h"
@@ -651,6 +653,14 @@ struct ReplicatedProcessorBase : GenericProcessor<Derived> {
         _replicationType != Methods::ReplicationType::LEADER ||
         (_followers->empty() &&
          this->_collection.replicationVersion() != replication::Version::TWO);
+
+    if (auto* changes = methods.state()->queryCacheChanges();
+        changes != nullptr) {
+      // the previous versions of the documents are needed for updating the
+      // query results cache
+      _queryCacheChanges = &changes->collection(collection.guid());
+      _needToFetchOldDocument = true;
+    }
   }
 
   static constexpr AccessMode::Type accessMode() {
@@ -658,6 +668,16 @@ struct ReplicatedProcessorBase : GenericProcessor<Derived> {
   }
 
   Future<OperationResult> execute() {
+    if (this->_value.isArray()) {
+      // preallocate the result buffers for all documents, so that they do
+      // not need to be grown and copied repeatedly for large arrays
+      this->_resultBuilder.reserve(this->_value.length() *
+                                   estimatedResultSizePerDocument);
+      if (!_excludeAllFromReplication) {
+        // the documents to replicate are about as large as the input
+        _replicationData->reserve(this->_value.byteSize());
+      }
+    }
     _replicationData->openArray(true);
     std::unordered_map<ErrorCode, size_t> errorCounter;
     Result res;
@@ -788,6 +808,10 @@ struct ReplicatedProcessorBase : GenericProcessor<Derived> {
   }
 
  protected:
+  /// @brief estimated size of the result for a single document, consisting
+  /// of its _id, _key and _rev
+  static constexpr std::size_t estimatedResultSizePerDocument = 96;
+
   void trackWaitForSync() {
     if (this->_collection.waitForSync() && !this->_options.isRestore) {
       this->_options.waitForSync = true;
@@ -815,6 +839,8 @@ struct ReplicatedProcessorBase : GenericProcessor<Derived> {
   bool _needToFetchOldDocument;
   // whether we use replication 1 or 2
   replication::Version _replicationVersion;
+  // document changes for updating the query results cache, if recorded
+  aql::QueryCacheChanges::Collection* _queryCacheChanges = nullptr;
 };
 
 struct RemoveProcessor : ReplicatedProcessorBase<RemoveProcessor> {
@@ -963,6 +989,11 @@ struct RemoveProcessor : ReplicatedProcessorBase<RemoveProcessor> {
 
     if (res.ok()) {
       trackWaitForSync();
+      if (_queryCacheChanges != nullptr) {
+        _queryCacheChanges->add(
+            _previousDocumentBuilder->slice(), VPackSlice::noneSlice(),
+            _methods.transactionContextPtr()->getVPackOptions());
+      }
     }
 
     return res;
@@ -1103,6 +1134,11 @@ struct ModifyingProcessorBase : ReplicatedProcessorBase<Derived> {
 
       if (res.ok()) {
         this->trackWaitForSync();
+        if (this->_queryCacheChanges != nullptr) {
+          this->_queryCacheChanges->add(
+              previousDocument, newDocumentBuilder.slice(),
+              this->_methods.transactionContextPtr()->getVPackOptions());
+        }
       }
     }
 
@@ -1381,6 +1417,11 @@ struct InsertProcessor : ModifyingProcessorBase<InsertProcessor> {
 
       if (res.ok()) {
         trackWaitForSync();
+        if (_queryCacheChanges != nullptr) {
+          _queryCacheChanges->add(
+              VPackSlice::noneSlice(), _newDocumentBuilder->slice(),
+              _methods.transactionContextPtr()->getVPackOptions());
+        }
       }
     }
 
@@ -2625,6 +2666,12 @@ Future<OperationResult> transaction::Methods::truncateLocal(
   // will be populated by the call to truncate()
   bool usedRangeDelete = false;
 
+  if (auto* changes = state()->queryCacheChanges(); changes != nullptr) {
+    // truncating does not record the removals, so the cached query results
+    // for the collection must be invalidated
+    changes->collection(collection->guid()).abandon();
+  }
+
   if (res.ok()) {
     res = collection->truncate(*this, options, usedRangeDelete);
   }
@@ -2985,6 +3032,41 @@ std::unique_ptr<IndexIterator> transaction::Methods::indexScan(
   return iterator;
 }
 
+/// @brief factory for IndexIterator objects over a range of documents
+/// note: the caller must have read-locked the underlying collection when
+/// calling this method
+std::unique_ptr<IndexIterator> transaction::Methods::indexScanRange(
+    ResourceMonitor& /*monitor*/, std::string const& collectionName,
+    LocalDocumentId lower, LocalDocumentId upper,
+    ReadOwnWrites readOwnWrites) {
+  if (ADB_UNLIKELY(_state->isCoordinator())) {
+    // The index scan is only available on DBServers and Single Server.
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_CLUSTER_ONLY_ON_DBSERVER);
+  }
+
+  DataSourceId cid =
+      addCollectionAtRuntime(collectionName, AccessMode::Type::READ);
+  TransactionCollection* trxColl = trxCollection(cid);
+  if (trxColl == nullptr) {
+    throwCollectionNotFound(collectionName);
+  }
+  TRI_ASSERT(trxColl->isLocked(AccessMode::Type::READ));
+
+  std::shared_ptr<LogicalCollection> const& logical = trxColl->collection();
+  if (logical == nullptr) {
+    throwCollectionNotFound(collectionName);
+  }
+
+  if (isInaccessibleCollection(collectionName)) {
+    return std::make_unique<EmptyIndexIterator>(logical.get(), this);
+  }
+
+  auto iterator = logical->getPhysical()->getRangeIterator(
+      this, readOwnWrites, lower, upper);
+  TRI_ASSERT(iterator != nullptr);
+  return iterator;
+}
+
 /// @brief return the collection
 arangodb::LogicalCollection* transaction::Methods::documentCollection(
     std::string_view name) const {
@@ -380,6 +380,16 @@ class Methods {
                                            CursorType cursorType,
                                            ReadOwnWrites readOwnWrites);
 
+  /// @brief factory for IndexIterator objects over the documents with a
+  /// LocalDocumentId in the range [lower, upper). an empty upper bound means
+  /// that the range is unbounded
+  /// note: the caller must have read-locked the underlying collection when
+  /// calling this method
+  std::unique_ptr<IndexIterator> indexScanRange(
+      ResourceMonitor& monitor, std::string const& collectionName,
+      LocalDocumentId lower, LocalDocumentId upper,
+      ReadOwnWrites readOwnWrites);
+
   /// @brief test if a collection is already locked
   ENTERPRISE_VIRT bool isLocked(arangodb::LogicalCollection*,
                                 AccessMode::Type) const;
@@ -129,6 +129,10 @@ void Options::fromVelocyPack(arangodb::velocypack::Slice const& slice) {
       allowDirtyReads = true;
     }
   }
+  value = slice.get("maxDirtyReadLag");
+  if (value.isNumber()) {
+    maxDirtyReadLag = value.getNumber<std::uint64_t>();
+  }
 
   if (!ServerState::instance()->isSingleServer()) {
     value = slice.get("isFollowerTransaction");
@@ -174,6 +178,9 @@ void Options::toVelocyPack(arangodb::velocypack::Builder& builder) const {
   // we are intentionally *not* writing allowImplicitCollectionForWrite here.
   // this is an internal option only used in replication
   builder.add("allowDirtyReads", VPackValue(allowDirtyReads));
+  if (maxDirtyReadLag.has_value()) {
+    builder.add("maxDirtyReadLag", VPackValue(*maxDirtyReadLag));
+  }
 
   // serialize data for cluster-wide collections
   if (!ServerState::instance()->isSingleServer()) {
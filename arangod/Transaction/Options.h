@@ -24,6 +24,7 @@
 #pragma once
 
 #include <cstdint>
+#include <optional>
 
 #include "Basics/Common.h"
 #include "Cluster/RebootTracker.h"
@@ -87,6 +88,12 @@ struct Options {
   /// created.
   bool allowDirtyReads = false;
 
+  /// @brief the maximum number of committed log entries that a follower of
+  /// a replication 2 shard may not have applied yet, for it to serve dirty
+  /// reads. the lag is determined by the follower, relative to the commit
+  /// index it knows of. std::nullopt means no bound
+  std::optional<std::uint64_t> maxDirtyReadLag;
+
   /// @brief originating server of this transaction. will be populated
   /// only in the cluster, and with a coordinator id/coordinator reboot id
   /// then. coordinators fill this in when they start a transaction, and
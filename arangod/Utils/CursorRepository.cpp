@@ -38,6 +38,8 @@
 #include <Basics/ScopeGuard.h>
 #include <velocypack/Builder.h>
 
+#include <bit>
+
 namespace {
 bool authorized(std::pair<arangodb::Cursor*, std::string> const& cursor) {
   auto const& exec = arangodb::ExecContext::current();
@@ -57,8 +59,10 @@ size_t const CursorRepository::MaxCollectCount = 32;
 ////////////////////////////////////////////////////////////////////////////////
 
 CursorRepository::CursorRepository(TRI_vocbase_t& vocbase)
-    : _vocbase(vocbase), _lock(), _cursors(), _softShutdownOngoing(nullptr) {
-  _cursors.reserve(64);
+    : _vocbase(vocbase), _nextCollectShard(0), _softShutdownOngoing(nullptr) {
+  for (auto& s : _shards) {
+    s.cursors.reserve(8);
+  }
   if (ServerState::instance()->isCoordinator()) {
     try {
       auto const& softShutdownFeature{
@@ -102,17 +106,24 @@ CursorRepository::~CursorRepository() {
     ++tries;
   }
 
-  {
-    std::lock_guard mutexLocker{_lock};
+  for (auto& s : _shards) {
+    std::lock_guard mutexLocker{s.lock};
 
-    for (auto it : _cursors) {
+    for (auto it : s.cursors) {
       delete it.second.first;
     }
 
-    _cursors.clear();
+    s.cursors.clear();
   }
 }
 
+CursorRepository::Shard& CursorRepository::shard(CursorId id) noexcept {
+  // cursor ids are ticks, which may share their lowest bits. fibonacci
+  // hashing spreads them evenly across shards
+  constexpr unsigned shift = 64 - std::countr_zero(numShards);
+  return _shards[(static_cast<uint64_t>(id) * 0x9e3779b97f4a7c15ULL) >> shift];
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief stores a cursor in the registry
 /// the repository will take ownership of the cursor
@@ -126,8 +137,9 @@ Cursor* CursorRepository::addCursor(std::unique_ptr<Cursor> cursor) {
   std::string user = ExecContext::current().user();
 
   {
-    std::lock_guard mutexLocker{_lock};
-    _cursors.emplace(id, std::make_pair(cursor.get(), std::move(user)));
+    Shard& s = shard(id);
+    std::lock_guard mutexLocker{s.lock};
+    s.cursors.emplace(id, std::make_pair(cursor.get(), std::move(user)));
   }
 
   TRI_IF_FAILURE(
@@ -197,10 +209,11 @@ bool CursorRepository::remove(CursorId id) {
   arangodb::Cursor* cursor = nullptr;
 
   {
-    std::lock_guard mutexLocker{_lock};
+    Shard& s = shard(id);
+    std::lock_guard mutexLocker{s.lock};
 
-    auto it = _cursors.find(id);
-    if (it == _cursors.end() || !::authorized(it->second)) {
+    auto it = s.cursors.find(id);
+    if (it == s.cursors.end() || !::authorized(it->second)) {
       // not found
       return false;
     }
@@ -214,7 +227,7 @@ bool CursorRepository::remove(CursorId id) {
     }
 
     // cursor not in use by someone else
-    _cursors.erase(it);
+    s.cursors.erase(it);
   }
 
   TRI_ASSERT(cursor != nullptr);
@@ -234,10 +247,11 @@ Cursor* CursorRepository::find(CursorId id, bool& busy) {
   busy = false;
 
   {
-    std::lock_guard mutexLocker{_lock};
+    Shard& s = shard(id);
+    std::lock_guard mutexLocker{s.lock};
 
-    auto it = _cursors.find(id);
-    if (it == _cursors.end() || !::authorized(it->second)) {
+    auto it = s.cursors.find(id);
+    if (it == s.cursors.end() || !::authorized(it->second)) {
       // not found
       return nullptr;
     }
@@ -271,7 +285,8 @@ Cursor* CursorRepository::find(CursorId id, bool& busy) {
 
 void CursorRepository::release(Cursor* cursor) {
   {
-    std::lock_guard mutexLocker{_lock};
+    Shard& s = shard(cursor->id());
+    std::lock_guard mutexLocker{s.lock};
 
     TRI_ASSERT(cursor->isUsed());
     cursor->release();
@@ -281,7 +296,7 @@ void CursorRepository::release(Cursor* cursor) {
     }
 
     // remove from the list
-    _cursors.erase(cursor->id());
+    s.cursors.erase(cursor->id());
   }
 
   // and free the cursor
@@ -289,8 +304,12 @@ void CursorRepository::release(Cursor* cursor) {
 }
 
 size_t CursorRepository::count() {
-  std::lock_guard mutexLocker{_lock};
-  return _cursors.size();
+  size_t result = 0;
+  for (auto& s : _shards) {
+    std::lock_guard mutexLocker{s.lock};
+    result += s.cursors.size();
+  }
+  return result;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -298,11 +317,13 @@ size_t CursorRepository::count() {
 ////////////////////////////////////////////////////////////////////////////////
 
 bool CursorRepository::containsUsedCursor() {
-  std::lock_guard mutexLocker{_lock};
+  for (auto& s : _shards) {
+    std::lock_guard mutexLocker{s.lock};
 
-  for (auto it : _cursors) {
-    if (it.second.first->isUsed()) {
-      return true;
+    for (auto it : s.cursors) {
+      if (it.second.first->isUsed()) {
+        return true;
+      }
     }
   }
 
@@ -320,36 +341,47 @@ bool CursorRepository::garbageCollect(bool force) {
   try {
     found.reserve(MaxCollectCount);
 
-    std::lock_guard mutexLocker{_lock};
+    // each shard is collected under its own lock only
+    size_t const start =
+        _nextCollectShard.fetch_add(1, std::memory_order_relaxed);
+    bool stop = false;
 
-    for (auto it = _cursors.begin(); it != _cursors.end(); /* no hoisting */) {
-      auto cursor = (*it).second.first;
+    for (size_t i = 0; i < numShards && !stop; ++i) {
+      Shard& s = _shards[(start + i) % numShards];
+      std::lock_guard mutexLocker{s.lock};
 
-      if (cursor->isUsed()) {
-        // must not destroy used cursors
-        ++it;
-        continue;
-      }
+      for (auto it = s.cursors.begin();
+           it != s.cursors.end(); /* no hoisting */) {
+        auto cursor = (*it).second.first;
 
-      if (force || cursor->expires() < now) {
-        cursor->kill();
-        cursor->setDeleted();
-      }
+        if (cursor->isUsed()) {
+          // must not destroy used cursors
+          ++it;
+          continue;
+        }
 
-      if (cursor->isDeleted()) {
-        try {
-          found.emplace_back(cursor);
-          it = _cursors.erase(it);
-        } catch (...) {
-          // stop iteration
-          break;
+        if (force || cursor->expires() < now) {
+          cursor->kill();
+          cursor->setDeleted();
         }
 
-        if (!force && found.size() >= MaxCollectCount) {
-          break;
+        if (cursor->isDeleted()) {
+          try {
+            found.emplace_back(cursor);
+            it = s.cursors.erase(it);
+          } catch (...) {
+            // stop iteration
+            stop = true;
+            break;
+          }
+
+          if (!force && found.size() >= MaxCollectCount) {
+            stop = true;
+            break;
+          }
+        } else {
+          ++it;
         }
-      } else {
-        ++it;
       }
     }
   } catch (...) {
@@ -23,6 +23,7 @@
 
 #pragma once
 
+#include <array>
 #include <mutex>
 #include <unordered_map>
 
@@ -129,16 +130,33 @@ class CursorRepository {
   TRI_vocbase_t& _vocbase;
 
   //////////////////////////////////////////////////////////////////////////////
-  /// @brief mutex for the cursors repository
+  /// @brief one part of the cursors, selected by the cursor id. all accesses
+  /// to a cursor's state happen under the mutex of its shard, so that
+  /// requests for different cursors do not contend on a single mutex
   //////////////////////////////////////////////////////////////////////////////
 
-  std::mutex _lock;
+  struct Shard {
+    std::mutex lock;
+    std::unordered_map<CursorId, std::pair<Cursor*, std::string>> cursors;
+  };
+
+  static constexpr size_t numShards = 16;
+  static_assert((numShards & (numShards - 1)) == 0);
+
+  Shard& shard(CursorId id) noexcept;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief current cursors
+  //////////////////////////////////////////////////////////////////////////////
+
+  std::array<Shard, numShards> _shards;
 
   //////////////////////////////////////////////////////////////////////////////
-  /// @brief list of current cursors
+  /// @brief shard in which the next garbage collection starts, so that
+  /// partial collections do not always favor the first shards
   //////////////////////////////////////////////////////////////////////////////
 
-  std::unordered_map<CursorId, std::pair<Cursor*, std::string>> _cursors;
+  std::atomic<size_t> _nextCollectShard;
 
   //////////////////////////////////////////////////////////////////////////////
   /// @brief maximum number of cursors to garbage-collect in one go
@@ -113,6 +113,20 @@ class V8GcThread : public Thread {
   V8DealerFeature& _dealer;
   std::atomic<uint64_t> _lastGcStamp;
 };
+
+class V8PrewarmThread : public Thread {
+ public:
+  explicit V8PrewarmThread(V8DealerFeature& dealer)
+      : Thread(dealer.server(), "V8Prewarm"), _dealer(dealer) {}
+
+  ~V8PrewarmThread() { shutdown(); }
+
+ public:
+  void run() override { _dealer.prewarmContexts(); }
+
+ private:
+  V8DealerFeature& _dealer;
+};
 }  // namespace
 
 DECLARE_COUNTER(arangodb_v8_context_created_total, "V8 contexts created");
@@ -131,7 +145,9 @@ V8DealerFeature::V8DealerFeature(Server& server)
       _maxContextAge(60.0),
       _nrMaxContexts(0),
       _nrMinContexts(0),
+      _nrSpareContexts(0),
       _nrInflightContexts(0),
+      _nrWaitingForContexts(0),
       _maxContextInvocations(0),
       _copyInstallation(false),
       _allowAdminExecute(false),
@@ -276,6 +292,28 @@ When there are unused V8 contexts that linger around and the number of V8
 contexts is greater than `--javascript.v8-contexts-minimum`, the server's
 garbage collector thread automatically deletes them.)");
 
+  options
+      ->addOption("--javascript.v8-contexts-spare",
+                  "The number of idle V8 contexts to keep ready in addition "
+                  "to the ones in use (0 = create contexts only on demand).",
+                  new UInt64Parameter(&_nrSpareContexts),
+                  arangodb::options::makeFlags(
+                      arangodb::options::Flags::DefaultNoComponents,
+                      arangodb::options::Flags::OnCoordinator,
+                      arangodb::options::Flags::OnSingle,
+                      arangodb::options::Flags::Uncommon))
+      .setIntroducedIn(31200)
+      .setLongDescription(R"(Creating a V8 context takes a considerable amount
+of time, because the JavaScript bootstrap code has to run in it. By default,
+additional contexts are created by the thread that needs one, so bursts of
+JavaScript requests (e.g. Foxx) have to wait for the creation.
+
+If this option is set to a value greater than zero, a background thread
+creates V8 contexts ahead of time, so that the configured number of contexts
+is idle and ready for use. The background thread additionally creates one
+context for every request that is currently waiting for a context. The total
+number of contexts is still limited by `--javascript.v8-contexts`.)");
+
   options->addOption(
       "--javascript.v8-contexts-max-invocations",
       "The maximum number of invocations for each V8 context before it is "
@@ -566,9 +604,13 @@ void V8DealerFeature::start() {
     _nrMaxContexts = _nrMinContexts;
   }
 
+  if (_nrSpareContexts > _nrMaxContexts) {
+    _nrSpareContexts = _nrMaxContexts;
+  }
+
   LOG_TOPIC("09e14", DEBUG, Logger::V8)
       << "number of V8 contexts: min: " << _nrMinContexts
-      << ", max: " << _nrMaxContexts;
+      << ", max: " << _nrMaxContexts << ", spare: " << _nrSpareContexts;
 
   defineDouble("V8_CONTEXTS", static_cast<double>(_nrMaxContexts));
 
@@ -611,6 +653,15 @@ void V8DealerFeature::start() {
   loadJavaScriptFileInAllContexts(database.get(), "server/initialize.js",
                                   nullptr);
   startGarbageCollection();
+
+  if (_nrSpareContexts > 0) {
+    _prewarmThread = std::make_unique<V8PrewarmThread>(*this);
+    if (!_prewarmThread->start()) {
+      LOG_TOPIC("7b1c4", WARN, Logger::V8)
+          << "could not start V8 context prewarm thread";
+      _prewarmThread.reset();
+    }
+  }
 }
 
 void V8DealerFeature::copyInstallationFiles() {
@@ -1111,6 +1162,52 @@ void V8DealerFeature::collectGarbage() {
   _gcFinished = true;
 }
 
+bool V8DealerFeature::needsPrewarmedContext() const {
+  // must be called with the mutex of _contextCondition held
+  return !_stopping && _dynamicContextCreationBlockers == 0 &&
+         _contexts.size() + _nrInflightContexts < _nrMaxContexts &&
+         _idleContexts.size() + _nrInflightContexts <
+             _nrSpareContexts + _nrWaitingForContexts;
+}
+
+void V8DealerFeature::prewarmContexts() {
+  while (!_stopping) {
+    {
+      std::unique_lock guard{_contextCondition.mutex};
+      if (!needsPrewarmedContext()) {
+        _contextCondition.cv.wait_for(guard, std::chrono::seconds{1});
+        continue;
+      }
+      ++_nrInflightContexts;
+    }
+
+    V8Context* context = nullptr;
+    try {
+      LOG_TOPIC("3f0d7", DEBUG, Logger::V8) << "prewarming V8 context";
+      context = addContext().release();
+    } catch (std::exception const& ex) {
+      LOG_TOPIC("c0a1e", DEBUG, Logger::V8)
+          << "could not prewarm V8 context: " << ex.what();
+    } catch (...) {
+    }
+
+    std::unique_lock guard{_contextCondition.mutex};
+    --_nrInflightContexts;
+    if (context == nullptr) {
+      // don't retry right away
+      _contextCondition.cv.wait_for(guard, std::chrono::seconds{1});
+      continue;
+    }
+    // push_back will not fail as we reserved enough memory before
+    _contexts.push_back(context);
+    _idleContexts.push_back(context);
+    LOG_TOPIC("a28e5", DEBUG, Logger::V8)
+        << "prewarmed V8 context #" << context->id()
+        << ", number of contexts is now " << _contexts.size();
+    _contextCondition.cv.notify_all();
+  }
+}
+
 void V8DealerFeature::unblockDynamicContextCreation() {
   std::lock_guard guard{_contextCondition.mutex};
 
@@ -1272,7 +1369,18 @@ V8Context* V8DealerFeature::enterContext(
   {
     std::unique_lock guard{_contextCondition.mutex};
 
-    while (_idleContexts.empty() && !_stopping) {
+    bool const waiting = _idleContexts.empty();
+    if (waiting) {
+      // counts towards the contexts the prewarm thread creates
+      ++_nrWaitingForContexts;
+    }
+    // runs with the mutex held, as it is declared after the lock
+    auto waitingGuard = arangodb::scopeGuard([&]() noexcept {
+      if (waiting) {
+        --_nrWaitingForContexts;
+      }
+    });
+
       TRI_ASSERT(guard.owns_lock());
 
       LOG_TOPIC("619ab", TRACE, arangodb::Logger::V8)
@@ -1396,6 +1504,10 @@ V8Context* V8DealerFeature::enterContext(
     // should not fail because we reserved enough space beforehand
     _busyContexts.emplace(context);
 
+    if (_prewarmThread != nullptr && needsPrewarmedContext()) {
+      _contextCondition.cv.notify_all();
+    }
+
     context->setDescription(securityContext.typeName(), TRI_microtime());
   }
 
@@ -1627,6 +1739,16 @@ void V8DealerFeature::shutdownContexts() {
     FATAL_ERROR_EXIT();
   }
 
+  // stop prewarm thread. waits for a context creation in progress
+  if (_prewarmThread != nullptr) {
+    _prewarmThread->beginShutdown();
+    {
+      std::lock_guard guard{_contextCondition.mutex};
+      _contextCondition.cv.notify_all();
+    }
+    _prewarmThread.reset();
+  }
+
   // stop GC thread
   if (_gcThread != nullptr) {
     LOG_TOPIC("c6543", DEBUG, arangodb::Logger::V8)
@@ -99,8 +99,12 @@ class V8DealerFeature final : public ArangodFeature {
   uint64_t _nrMaxContexts;
   // minimum number of contexts to keep
   uint64_t _nrMinContexts;
+  // number of idle contexts to keep ready, created in the background
+  uint64_t _nrSpareContexts;
   // number of contexts currently in creation
   uint64_t _nrInflightContexts;
+  // number of threads currently waiting for a context
+  uint64_t _nrWaitingForContexts;
   // maximum number of V8 context invocations
   uint64_t _maxContextInvocations;
 
@@ -128,6 +132,11 @@ class V8DealerFeature final : public ArangodFeature {
   bool addGlobalContextMethod(GlobalContextMethods::MethodType type);
   void collectGarbage();
 
+  /// @brief creates contexts in the background whenever fewer contexts than
+  /// the configured number of spare contexts are idle, plus one for every
+  /// thread that is waiting for a context. runs until shutdown
+  void prewarmContexts();
+
   /// @brief loads a JavaScript file in all contexts, only called at startup.
   /// if the builder pointer is not nullptr, then
   /// the Javascript result(s) are returned as VPack in the builder,
@@ -171,6 +180,7 @@ class V8DealerFeature final : public ArangodFeature {
   uint64_t nextId() { return _nextId++; }
   void copyInstallationFiles();
   void startGarbageCollection();
+  bool needsPrewarmedContext() const;
   std::unique_ptr<V8Context> addContext();
   std::unique_ptr<V8Context> buildContext(TRI_vocbase_t* vocbase, size_t id);
   V8Context* pickFreeContextForGc();
@@ -190,6 +200,7 @@ class V8DealerFeature final : public ArangodFeature {
   std::atomic<uint64_t> _nextId;
 
   std::unique_ptr<Thread> _gcThread;
+  std::unique_ptr<Thread> _prewarmThread;
   std::atomic<bool> _stopping;
   std::atomic<bool> _gcFinished;
 
@@ -0,0 +1,348 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "CollectionStatistics.h"
+
+#include "Basics/StaticStrings.h"
+#include "Basics/VelocyPackHelper.h"
+#include "Basics/debugging.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Iterator.h>
+#include <velocypack/Slice.h>
+
+#include <algorithm>
+#include <cmath>
+#include <string_view>
+
+using namespace arangodb;
+
+namespace {
+std::string_view const numberDocumentsAttribute("numberDocuments");
+std::string_view const attributesAttribute("attributes");
+std::string_view const attributeAttribute("attribute");
+std::string_view const nullsAttribute("nulls");
+std::string_view const boolsAttribute("bools");
+std::string_view const numbersAttribute("numbers");
+std::string_view const stringsAttribute("strings");
+std::string_view const distinctAttribute("distinct");
+std::string_view const histogramAttribute("histogram");
+}  // namespace
+
+AttributeStatistics::AttributeStatistics(velocypack::Slice slice) {
+  using basics::VelocyPackHelper;
+  _nullFraction =
+      VelocyPackHelper::getNumericValue<double>(slice, nullsAttribute, 1.0);
+  _boolFraction =
+      VelocyPackHelper::getNumericValue<double>(slice, boolsAttribute, 0.0);
+  _numberFraction =
+      VelocyPackHelper::getNumericValue<double>(slice, numbersAttribute, 0.0);
+  _stringFraction =
+      VelocyPackHelper::getNumericValue<double>(slice, stringsAttribute, 0.0);
+  _distinctValues =
+      VelocyPackHelper::getNumericValue<double>(slice, distinctAttribute, 0.0);
+
+  velocypack::Slice histogram = slice.get(histogramAttribute);
+  if (histogram.isArray()) {
+    for (auto it : velocypack::ArrayIterator(histogram)) {
+      if (!it.isNumber()) {
+        _histogram.clear();
+        break;
+      }
+      _histogram.emplace_back(it.getNumber<double>());
+    }
+  }
+  if (_histogram.size() < 2 ||
+      !std::is_sorted(_histogram.begin(), _histogram.end())) {
+    _histogram.clear();
+  }
+}
+
+void AttributeStatistics::toVelocyPack(velocypack::Builder& builder) const {
+  TRI_ASSERT(builder.isOpenObject());
+  builder.add(nullsAttribute, velocypack::Value(_nullFraction));
+  builder.add(boolsAttribute, velocypack::Value(_boolFraction));
+  builder.add(numbersAttribute, velocypack::Value(_numberFraction));
+  builder.add(stringsAttribute, velocypack::Value(_stringFraction));
+  builder.add(distinctAttribute, velocypack::Value(_distinctValues));
+  builder.add(velocypack::Value(histogramAttribute));
+  builder.openArray();
+  for (double bound : _histogram) {
+    builder.add(velocypack::Value(bound));
+  }
+  builder.close();
+}
+
+double AttributeStatistics::equalitySelectivity() const noexcept {
+  return (1.0 - _nullFraction) / std::max(1.0, _distinctValues);
+}
+
+double AttributeStatistics::numbersBelow(double value) const noexcept {
+  if (_histogram.empty() || value <= _histogram.front()) {
+    return 0.0;
+  }
+  if (value >= _histogram.back()) {
+    return 1.0;
+  }
+  // interpolate linearly inside the bucket
+  auto it = std::upper_bound(_histogram.begin(), _histogram.end(), value);
+  TRI_ASSERT(it != _histogram.begin() && it != _histogram.end());
+  size_t const bucket = std::distance(_histogram.begin(), it) - 1;
+  double const low = _histogram[bucket];
+  double const high = _histogram[bucket + 1];
+  double const inBucket = high > low ? (value - low) / (high - low) : 0.0;
+  return (static_cast<double>(bucket) + inBucket) /
+         static_cast<double>(_histogram.size() - 1);
+}
+
+double AttributeStatistics::rangeSelectivity(
+    std::optional<double> lower, std::optional<double> upper) const noexcept {
+  double result = 0.0;
+  if (!lower.has_value()) {
+    // null and boolean values are sorted before numbers
+    result += _nullFraction + _boolFraction;
+  }
+  if (!upper.has_value()) {
+    // strings, arrays and objects are sorted after numbers
+    result += std::max(
+        0.0, 1.0 - _nullFraction - _boolFraction - _numberFraction);
+  }
+  double const from = lower.has_value() ? numbersBelow(*lower) : 0.0;
+  double const to = upper.has_value() ? numbersBelow(*upper) : 1.0;
+  result += _numberFraction * std::max(0.0, to - from);
+  return std::clamp(result, 0.0, 1.0);
+}
+
+CollectionStatistics::CollectionStatistics(uint64_t numberDocuments)
+    : _numberDocuments(numberDocuments) {}
+
+CollectionStatistics::CollectionStatistics(velocypack::Slice slice)
+    : _numberDocuments(basics::VelocyPackHelper::getNumericValue<uint64_t>(
+          slice, numberDocumentsAttribute, 0)) {
+  velocypack::Slice attributes = slice.get(attributesAttribute);
+  if (!attributes.isArray()) {
+    return;
+  }
+  for (auto it : velocypack::ArrayIterator(attributes)) {
+    velocypack::Slice path = it.get(attributeAttribute);
+    if (!path.isArray() || path.length() == 0) {
+      continue;
+    }
+    std::vector<std::string> attribute;
+    for (auto part : velocypack::ArrayIterator(path)) {
+      if (!part.isString()) {
+        attribute.clear();
+        break;
+      }
+      attribute.emplace_back(part.copyString());
+    }
+    if (!attribute.empty()) {
+      std::string k = key(attribute);
+      _attributes.try_emplace(std::move(k), std::move(attribute),
+                              AttributeStatistics(it));
+    }
+  }
+}
+
+void CollectionStatistics::toVelocyPack(velocypack::Builder& builder) const {
+  builder.openObject();
+  builder.add(numberDocumentsAttribute, velocypack::Value(_numberDocuments));
+  builder.add(velocypack::Value(attributesAttribute));
+  builder.openArray();
+  for (auto const& [k, entry] : _attributes) {
+    builder.openObject();
+    builder.add(velocypack::Value(attributeAttribute));
+    builder.openArray();
+    for (auto const& part : entry.first) {
+      builder.add(velocypack::Value(part));
+    }
+    builder.close();
+    entry.second.toVelocyPack(builder);
+    builder.close();
+  }
+  builder.close();
+  builder.close();
+}
+
+AttributeStatistics const* CollectionStatistics::get(
+    std::vector<basics::AttributeName> const& attribute) const {
+  std::vector<std::string> path;
+  path.reserve(attribute.size());
+  for (auto const& it : attribute) {
+    if (it.shouldExpand) {
+      return nullptr;
+    }
+    path.emplace_back(it.name);
+  }
+  auto it = _attributes.find(key(path));
+  if (it == _attributes.end()) {
+    return nullptr;
+  }
+  return &(*it).second.second;
+}
+
+bool CollectionStatistics::needsAnalysis(
+    CollectionStatistics const* statistics, uint64_t numberDocuments) noexcept {
+  if (statistics == nullptr) {
+    return numberDocuments >= minDocuments;
+  }
+  uint64_t const previous = statistics->numberDocuments();
+  uint64_t const changed = numberDocuments > previous
+                               ? numberDocuments - previous
+                               : previous - numberDocuments;
+  return changed >= minDocuments &&
+         static_cast<double>(changed) >
+             static_cast<double>(previous) * outdatedFraction;
+}
+
+std::string CollectionStatistics::key(
+    std::vector<std::string> const& attribute) {
+  // attribute names can contain dots, so use a separator that is unlikely
+  // to be part of a name
+  std::string result;
+  for (auto const& part : attribute) {
+    if (!result.empty()) {
+      result.push_back('\0');
+    }
+    result.append(part);
+  }
+  return result;
+}
+
+CollectionStatisticsBuilder::CollectionStatisticsBuilder(
+    std::vector<std::vector<std::string>> attributes)
+    : _attributes(std::move(attributes)) {}
+
+void CollectionStatisticsBuilder::add(velocypack::Slice document) {
+  document = document.resolveExternals();
+  if (!document.isObject()) {
+    return;
+  }
+  ++_sampled;
+
+  std::vector<std::string> attribute(1);
+  velocypack::ObjectIterator it(document, true);
+  while (it.valid()) {
+    velocypack::Slice key = it.key(/*translate*/ true);
+    // _id values are not stored as plain values
+    if (key.isString() && key.stringView() != StaticStrings::IdString) {
+      attribute[0] = key.copyString();
+      add(attribute, it.value());
+    }
+    it.next();
+  }
+  for (auto const& path : _attributes) {
+    if (path.size() > 1) {
+      add(path, document.get(path));
+    }
+  }
+}
+
+void CollectionStatisticsBuilder::add(
+    std::vector<std::string> const& attribute, velocypack::Slice value) {
+  value = value.resolveExternals();
+  if (value.isNone() || value.isNull() || value.isCustom()) {
+    // missing attributes count as null, and nulls are not tracked
+    return;
+  }
+
+  std::string k = CollectionStatistics::key(attribute);
+  auto it = _values.find(k);
+  if (it == _values.end()) {
+    if (_values.size() >= maxAttributes) {
+      return;
+    }
+    it = _values.emplace(std::move(k), Values{}).first;
+    (*it).second.attribute = attribute;
+  }
+
+  auto& values = (*it).second;
+  if (value.isBoolean()) {
+    ++values.bools;
+  } else if (value.isNumber()) {
+    values.numbers.emplace_back(value.getNumber<double>());
+  } else if (value.isString()) {
+    ++values.strings;
+  } else {
+    ++values.others;
+  }
+  ++values.frequencies[value.normalizedHash()];
+}
+
+std::shared_ptr<CollectionStatistics const> CollectionStatisticsBuilder::finish(
+    uint64_t numberDocuments) const {
+  auto result = std::make_shared<CollectionStatistics>(numberDocuments);
+  if (_sampled == 0) {
+    return result;
+  }
+
+  double const sampled = static_cast<double>(_sampled);
+  // the sample may be slightly larger than the collection if documents were
+  // removed in the meantime
+  double const total =
+      std::max(sampled, static_cast<double>(numberDocuments));
+
+  for (auto const& [k, values] : _values) {
+    AttributeStatistics statistics;
+    double const numbers = static_cast<double>(values.numbers.size());
+    double const nonNull = static_cast<double>(values.bools) + numbers +
+                           static_cast<double>(values.strings) +
+                           static_cast<double>(values.others);
+    statistics._nullFraction = 1.0 - nonNull / sampled;
+    statistics._boolFraction = static_cast<double>(values.bools) / sampled;
+    statistics._numberFraction = numbers / sampled;
+    statistics._stringFraction = static_cast<double>(values.strings) / sampled;
+
+    // extrapolate the number of distinct values in the sample to the whole
+    // collection. this is the Duj1 estimator from Haas et al., "Sampling-based
+    // estimation of the number of distinct values of an attribute": values
+    // seen only once in the sample indicate that there are more values which
+    // have not been sampled
+    double const distinct = static_cast<double>(values.frequencies.size());
+    double const singletons = static_cast<double>(std::count_if(
+        values.frequencies.begin(), values.frequencies.end(),
+        [](auto const& it) { return it.second == 1; }));
+    double const population = nonNull * total / sampled;
+    if (sampled >= total || singletons == 0.0) {
+      statistics._distinctValues = distinct;
+    } else {
+      double estimate =
+          nonNull * distinct /
+          (nonNull - singletons + singletons * nonNull / population);
+      statistics._distinctValues =
+          std::clamp(estimate, distinct, std::max(distinct, population));
+    }
+
+    if (!values.numbers.empty()) {
+      std::vector<double> sorted = values.numbers;
+      std::sort(sorted.begin(), sorted.end());
+      size_t const buckets = std::min(histogramBuckets, sorted.size());
+      statistics._histogram.reserve(buckets + 1);
+      for (size_t i = 0; i <= buckets; ++i) {
+        statistics._histogram.emplace_back(
+            sorted[i * (sorted.size() - 1) / buckets]);
+      }
+    }
+
+    result->_attributes.try_emplace(k, values.attribute, std::move(statistics));
+  }
+  return result;
+}
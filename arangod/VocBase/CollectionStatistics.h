@@ -0,0 +1,160 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Basics/AttributeNameParser.h"
+#include "Containers/FlatHashMap.h"
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace arangodb {
+namespace velocypack {
+class Builder;
+class Slice;
+}  // namespace velocypack
+
+/// @brief statistics about the values of a single attribute, computed from
+/// a sample of the documents of a collection. the fractions are relative to
+/// all documents of the collection. a missing attribute counts as null
+class AttributeStatistics {
+  friend class CollectionStatisticsBuilder;
+
+ public:
+  AttributeStatistics() = default;
+  explicit AttributeStatistics(velocypack::Slice slice);
+
+  void toVelocyPack(velocypack::Builder& builder) const;
+
+  /// @brief estimated number of distinct non-null values
+  double distinctValues() const noexcept { return _distinctValues; }
+
+  /// @brief estimated fraction of documents with a specific non-null value
+  double equalitySelectivity() const noexcept;
+
+  /// @brief estimated fraction of documents with a value in the range. a
+  /// missing bound means that the range is unbounded on this side. values
+  /// of all types are considered, in the order in which AQL compares them,
+  /// e.g. `doc.value < 5` is also true for null and boolean values
+  double rangeSelectivity(std::optional<double> lower,
+                          std::optional<double> upper) const noexcept;
+
+ private:
+  /// @brief estimated fraction of the numeric values lower than the value
+  double numbersBelow(double value) const noexcept;
+
+  double _nullFraction = 1.0;
+  double _boolFraction = 0.0;
+  double _numberFraction = 0.0;
+  double _stringFraction = 0.0;
+  // the remainder are arrays and objects
+  double _distinctValues = 0.0;
+
+  /// @brief bounds of an equi-depth histogram of the numeric values. each
+  /// bucket between two adjacent bounds contains the same number of values
+  std::vector<double> _histogram;
+};
+
+/// @brief statistics about the attribute values of the documents of a
+/// collection, for the optimizer's cost estimation
+class CollectionStatistics {
+  friend class CollectionStatisticsBuilder;
+
+ public:
+  /// @brief collections with fewer documents are not analyzed
+  static constexpr uint64_t minDocuments = 1000;
+
+  /// @brief fraction of the documents that must have changed for the
+  /// statistics to become outdated
+  static constexpr double outdatedFraction = 0.2;
+
+  explicit CollectionStatistics(uint64_t numberDocuments);
+  explicit CollectionStatistics(velocypack::Slice slice);
+
+  void toVelocyPack(velocypack::Builder& builder) const;
+
+  /// @brief number of documents at the time the statistics were computed
+  uint64_t numberDocuments() const noexcept { return _numberDocuments; }
+
+  /// @brief statistics for the attribute, or a nullptr if there are none
+  AttributeStatistics const* get(
+      std::vector<basics::AttributeName> const& attribute) const;
+
+  /// @brief whether or not a collection with the current number of
+  /// documents should be analyzed (again)
+  static bool needsAnalysis(CollectionStatistics const* statistics,
+                            uint64_t numberDocuments) noexcept;
+
+  /// @brief key of an attribute path in the statistics
+  static std::string key(std::vector<std::string> const& attribute);
+
+ private:
+  uint64_t _numberDocuments;
+
+  /// @brief statistics per attribute path, keyed by the path
+  containers::FlatHashMap<std::string,
+                          std::pair<std::vector<std::string>,
+                                    AttributeStatistics>>
+      _attributes;
+};
+
+/// @brief computes collection statistics from a sample of documents. all
+/// top-level attributes as well as the given attribute paths are analyzed,
+/// up to a maximum number of attributes
+class CollectionStatisticsBuilder {
+ public:
+  static constexpr size_t maxAttributes = 64;
+  static constexpr size_t histogramBuckets = 32;
+
+  explicit CollectionStatisticsBuilder(
+      std::vector<std::vector<std::string>> attributes);
+
+  /// @brief add a sampled document
+  void add(velocypack::Slice document);
+
+  /// @brief compute the statistics for a collection with the given number
+  /// of documents from the sampled documents
+  std::shared_ptr<CollectionStatistics const> finish(
+      uint64_t numberDocuments) const;
+
+ private:
+  struct Values {
+    std::vector<std::string> attribute;
+    uint64_t bools = 0;
+    uint64_t strings = 0;
+    uint64_t others = 0;
+    std::vector<double> numbers;
+    /// @brief number of occurrences of each non-null value, by hash
+    containers::FlatHashMap<uint64_t, uint64_t> frequencies;
+  };
+
+  void add(std::vector<std::string> const& attribute, velocypack::Slice value);
+
+  std::vector<std::vector<std::string>> _attributes;
+  containers::FlatHashMap<std::string, Values> _values;
+  uint64_t _sampled = 0;
+};
+
+}  // namespace arangodb
@@ -236,7 +236,9 @@ ComputedValues::ComputedValue::ComputedValue(TRI_vocbase_t& vocbase,
 
   // build Expression object from Ast
   _expression = std::make_unique<aql::Expression>(ast, _rootNode);
-  _expression->prepareForExecution();
+  // the expression is executed for every document written, and possibly by
+  // multiple threads at the same time, so compile it once now
+  _expression->compile();
   TRI_ASSERT(!_expression->willUseV8());
   TRI_ASSERT(_expression->canRunOnDBServer(true));
   TRI_ASSERT(_expression->canRunOnDBServer(false));
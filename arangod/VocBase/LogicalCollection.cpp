@@ -26,6 +26,7 @@
 
 #include "ApplicationFeatures/ApplicationServer.h"
 #include "Aql/QueryCache.h"
+#include "Aql/QueryPlanCache.h"
 #include "Basics/DownCast.h"
 #include "Basics/ReadLocker.h"
 #include "Basics/StaticStrings.h"
@@ -1105,6 +1106,10 @@ std::shared_ptr<Index> LogicalCollection::createIndex(
     std::shared_ptr<std::function<arangodb::Result(double)>> progress) {
   auto idx = _physical->createIndex(info, /*restore*/ false, created,
                                     std::move(progress));
+  if (idx && created) {
+    // cached plans may be able to use the new index
+    aql::QueryPlanCache::instance()->invalidate(&vocbase());
+  }
   if (idx) {
     auto& df = vocbase().server().getFeature<DatabaseFeature>();
     if (df.versionTracker() != nullptr) {
@@ -1119,6 +1124,7 @@ Result LogicalCollection::dropIndex(IndexId iid) {
   TRI_ASSERT(!ServerState::instance()->isCoordinator());
 
   aql::QueryCache::instance()->invalidate(&vocbase(), guid());
+  aql::QueryPlanCache::instance()->invalidate(&vocbase());
 
   Result res = _physical->dropIndex(iid);
 
@@ -24,12 +24,19 @@
 #include "AqlUserFunctions.h"
 
 #include "ApplicationFeatures/ApplicationServer.h"
+#include "Aql/Ast.h"
+#include "Aql/AstNode.h"
+#include "Aql/Function.h"
 #include "Aql/Query.h"
+#include "Aql/QueryCache.h"
+#include "Aql/QueryPlanCache.h"
 #include "Aql/QueryRegistry.h"
 #include "Aql/QueryString.h"
+#include "Basics/Exceptions.h"
 #include "Basics/StaticStrings.h"
 #include "Basics/StringUtils.h"
 #include "Basics/VelocyPackHelper.h"
+#include "Cluster/ServerState.h"
 #include "RestServer/QueryRegistryFeature.h"
 #include "Transaction/Helpers.h"
 #include "Transaction/Methods.h"
@@ -42,10 +49,14 @@
 #include "V8/v8-utils.h"
 #include "V8Server/V8Context.h"
 #include "V8Server/V8DealerFeature.h"
+#include "VocBase/Methods/NativeUserFunctionCache.h"
+#include "VocBase/vocbase.h"
 
+#include <absl/strings/str_cat.h>
 #include <v8.h>
 #include <velocypack/Builder.h>
 #include <velocypack/Iterator.h>
+#include <algorithm>
 #include <regex>
 
 using namespace arangodb;
@@ -68,7 +79,195 @@ bool isValidFunctionNameFilter(std::string const& testName) {
   return std::regex_match(testName, funcFilterRegEx);
 }
 
-void reloadAqlUserFunctions(ArangodServer& server) {
+// language of native user functions
+constexpr std::string_view nativeLanguage("aql");
+
+// maximum length of the bind parameter names for function arguments
+constexpr size_t maxArgumentNameLength = 4;
+
+/// @brief check whether the node can be used in the body of a native user
+/// function. tracks the number of arguments the body refers to
+bool isValidNativeNode(aql::AstNode const* node, size_t& numArguments,
+                       std::string& error) {
+  switch (node->type) {
+    case aql::NODE_TYPE_PARAMETER: {
+      std::string_view name = node->getStringView();
+      if (name.empty() || name.size() > maxArgumentNameLength ||
+          !std::all_of(name.begin(), name.end(),
+                       [](char c) { return c >= '0' && c <= '9'; })) {
+        error = absl::StrCat("invalid argument '@", name,
+                             "', arguments must be referred to as @0, @1, ...");
+        return false;
+      }
+      numArguments = std::max(
+          numArguments,
+          static_cast<size_t>(basics::StringUtils::uint64(name)) + 1);
+      return true;
+    }
+    case aql::NODE_TYPE_FCALL: {
+      auto const* func = static_cast<aql::Function const*>(node->getData());
+      if (!func->hasCxxImplementation() ||
+          func->hasFlag(aql::Function::Flags::CanReadDocuments)) {
+        error = absl::StrCat("function '", func->name,
+                             "' cannot be used in native user functions");
+        return false;
+      }
+      break;
+    }
+    case aql::NODE_TYPE_VALUE:
+    case aql::NODE_TYPE_ARRAY:
+    case aql::NODE_TYPE_OBJECT:
+    case aql::NODE_TYPE_OBJECT_ELEMENT:
+    case aql::NODE_TYPE_CALCULATED_OBJECT_ELEMENT:
+    case aql::NODE_TYPE_ATTRIBUTE_ACCESS:
+    case aql::NODE_TYPE_INDEXED_ACCESS:
+    case aql::NODE_TYPE_RANGE:
+    case aql::NODE_TYPE_QUANTIFIER:
+    case aql::NODE_TYPE_OPERATOR_UNARY_PLUS:
+    case aql::NODE_TYPE_OPERATOR_UNARY_MINUS:
+    case aql::NODE_TYPE_OPERATOR_UNARY_NOT:
+    case aql::NODE_TYPE_OPERATOR_BINARY_AND:
+    case aql::NODE_TYPE_OPERATOR_BINARY_OR:
+    case aql::NODE_TYPE_OPERATOR_BINARY_PLUS:
+    case aql::NODE_TYPE_OPERATOR_BINARY_MINUS:
+    case aql::NODE_TYPE_OPERATOR_BINARY_TIMES:
+    case aql::NODE_TYPE_OPERATOR_BINARY_DIV:
+    case aql::NODE_TYPE_OPERATOR_BINARY_MOD:
+    case aql::NODE_TYPE_OPERATOR_BINARY_EQ:
+    case aql::NODE_TYPE_OPERATOR_BINARY_NE:
+    case aql::NODE_TYPE_OPERATOR_BINARY_LT:
+    case aql::NODE_TYPE_OPERATOR_BINARY_LE:
+    case aql::NODE_TYPE_OPERATOR_BINARY_GT:
+    case aql::NODE_TYPE_OPERATOR_BINARY_GE:
+    case aql::NODE_TYPE_OPERATOR_BINARY_IN:
+    case aql::NODE_TYPE_OPERATOR_BINARY_NIN:
+    case aql::NODE_TYPE_OPERATOR_BINARY_ARRAY_EQ:
+    case aql::NODE_TYPE_OPERATOR_BINARY_ARRAY_NE:
+    case aql::NODE_TYPE_OPERATOR_BINARY_ARRAY_LT:
+    case aql::NODE_TYPE_OPERATOR_BINARY_ARRAY_LE:
+    case aql::NODE_TYPE_OPERATOR_BINARY_ARRAY_GT:
+    case aql::NODE_TYPE_OPERATOR_BINARY_ARRAY_GE:
+    case aql::NODE_TYPE_OPERATOR_BINARY_ARRAY_IN:
+    case aql::NODE_TYPE_OPERATOR_BINARY_ARRAY_NIN:
+    case aql::NODE_TYPE_OPERATOR_TERNARY:
+    case aql::NODE_TYPE_OPERATOR_NARY_AND:
+    case aql::NODE_TYPE_OPERATOR_NARY_OR:
+      break;
+    default:
+      // variables, subqueries, collections, user functions etc.
+      error = absl::StrCat("'", node->getTypeString(),
+                           "' cannot be used in native user functions");
+      return false;
+  }
+
+  for (size_t i = 0; i < node->numMembers(); ++i) {
+    if (!isValidNativeNode(node->getMemberUnchecked(i), numArguments,
+                           error)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/// @brief parse and validate the body of a native user function and build
+/// its AST template
+Result parseNativeUserFunction(TRI_vocbase_t& vocbase, std::string const& code,
+                               VPackBuilder& ast, size_t& numArguments,
+                               bool& isDeterministic) {
+  auto query = aql::Query::create(
+      transaction::V8Context::CreateWhenRequired(vocbase, true),
+      aql::QueryString(absl::StrCat("RETURN (", code, "\n)")), nullptr);
+  aql::QueryResult parsed = query->parse();
+  if (parsed.result.fail()) {
+    return Result(TRI_ERROR_QUERY_FUNCTION_INVALID_CODE,
+                  absl::StrCat(TRI_errno_string(
+                                   TRI_ERROR_QUERY_FUNCTION_INVALID_CODE),
+                               ": ", parsed.result.errorMessage()));
+  }
+
+  aql::AstNode const* root = query->ast()->root();
+  if (root->numMembers() != 1 ||
+      root->getMemberUnchecked(0)->type != aql::NODE_TYPE_RETURN) {
+    return Result(TRI_ERROR_QUERY_FUNCTION_INVALID_CODE,
+                  "expecting a single AQL expression as function definition");
+  }
+  aql::AstNode const* body = root->getMemberUnchecked(0)->getMember(0);
+
+  numArguments = 0;
+  std::string error;
+  if (!isValidNativeNode(body, numArguments, error)) {
+    return Result(
+        TRI_ERROR_QUERY_FUNCTION_INVALID_CODE,
+        absl::StrCat(TRI_errno_string(TRI_ERROR_QUERY_FUNCTION_INVALID_CODE),
+                     ": ", error));
+  }
+
+  isDeterministic = body->isDeterministic();
+  body->toVelocyPack(ast, false);
+  return Result();
+}
+
+NativeUserFunctionCache nativeUserFunctions;
+
+/// @brief read the definition of a native user function from _aqlfunctions.
+/// returns a nullptr for JavaScript functions and unknown functions
+Result readNativeUserFunction(TRI_vocbase_t& vocbase, std::string const& key,
+                              std::shared_ptr<VPackBuilder const>& result) {
+  VPackBuilder search;
+  {
+    VPackObjectBuilder guard(&search);
+    search.add(StaticStrings::KeyString, VPackValue(key));
+  }
+
+  Result res;
+  auto document = std::make_shared<VPackBuilder>();
+  try {
+    auto ctx = transaction::V8Context::CreateWhenRequired(vocbase, true);
+    SingleCollectionTransaction trx(ctx, StaticStrings::AqlFunctionsCollection,
+                                    AccessMode::Type::READ);
+    trx.addHint(transaction::Hints::Hint::SINGLE_OPERATION);
+
+    res = trx.begin();
+    if (res.ok()) {
+      OperationResult opRes = trx.document(
+          StaticStrings::AqlFunctionsCollection, search.slice(),
+          OperationOptions());
+      res = trx.finish(opRes.result);
+      if (res.ok()) {
+        document->add(opRes.slice().resolveExternal());
+      }
+    }
+  } catch (basics::Exception const& ex) {
+    res.reset(ex.code(), ex.message());
+  }
+
+  result.reset();
+  if (res.is(TRI_ERROR_ARANGO_DOCUMENT_NOT_FOUND) ||
+      res.is(TRI_ERROR_ARANGO_DATA_SOURCE_NOT_FOUND)) {
+    return Result();
+  }
+  if (res.fail()) {
+    return res;
+  }
+
+  VPackSlice function = document->slice();
+  if (function.isObject() &&
+      function.get("language").isEqualString(nativeLanguage) &&
+      function.get("ast").isObject() && function.get("arguments").isNumber()) {
+    result = std::move(document);
+  }
+  return res;
+}
+
+/// @brief to be called whenever user functions of the database have been
+/// registered or unregistered
+void userFunctionsChanged(TRI_vocbase_t& vocbase) {
+  nativeUserFunctions.invalidate(vocbase.id());
+  // native functions are inlined into the plans and the results of queries
+  aql::QueryPlanCache::instance()->invalidate(&vocbase);
+  aql::QueryCache::instance()->invalidate(&vocbase);
+
+  auto& server = vocbase.server();
   if (server.hasFeature<V8DealerFeature>() &&
       server.isEnabled<V8DealerFeature>() &&
       server.getFeature<V8DealerFeature>().isEnabled()) {
@@ -112,7 +311,7 @@ Result arangodb::unregisterUserFunction(TRI_vocbase_t& vocbase,
   }
 
   if (res.ok()) {
-    reloadAqlUserFunctions(vocbase.server());
+    userFunctionsChanged(vocbase);
   } else if (res.is(TRI_ERROR_ARANGO_DOCUMENT_NOT_FOUND)) {
     return res.reset(TRI_ERROR_QUERY_FUNCTION_NOT_FOUND,
                      std::string("no AQL user function with name '") +
@@ -178,7 +377,7 @@ Result arangodb::unregisterUserFunctionsGroup(
     deleteCount = static_cast<int>(countSlice.length());
   }
 
-  reloadAqlUserFunctions(vocbase.server());
+  userFunctionsChanged(vocbase);
   return Result();
 }
 
@@ -189,10 +388,19 @@ Result arangodb::registerUserFunction(TRI_vocbase_t& vocbase,
 
   Result res;
 
+  VPackSlice language = userFunction.get("language");
+  bool const isNative =
+      language.isString() && language.stringView() == nativeLanguage;
+  if (!language.isNone() && !isNative &&
+      !(language.isString() && language.stringView() == "js")) {
+    return Result(TRI_ERROR_QUERY_FUNCTION_INVALID_CODE,
+                  "expecting 'js' or 'aql' as function language");
+  }
+
   auto& server = vocbase.server();
-  if (!server.hasFeature<V8DealerFeature>() ||
-      !server.isEnabled<V8DealerFeature>() ||
-      !server.getFeature<V8DealerFeature>().isEnabled()) {
+  if (!isNative && (!server.hasFeature<V8DealerFeature>() ||
+                    !server.isEnabled<V8DealerFeature>() ||
+                    !server.getFeature<V8DealerFeature>().isEnabled())) {
     return res.reset(TRI_ERROR_DISABLED,
                      "JavaScript operations are not available");
   }
@@ -236,7 +444,12 @@ Result arangodb::registerUserFunction(TRI_vocbase_t& vocbase,
     isDeterministic = isDeterministicSlice.getBoolean();
   }
 
-  {
+  VPackBuilder ast;
+  size_t numArguments = 0;
+  if (isNative) {
+    res = parseNativeUserFunction(vocbase, tmp, ast, numArguments,
+                                  isDeterministic);
+  } else {
     ISOLATE;
     bool throwV8Exception = (isolate != nullptr);
 
@@ -296,6 +509,11 @@ Result arangodb::registerUserFunction(TRI_vocbase_t& vocbase,
   oneFunctionDocument.add("name", VPackValue(name));
   oneFunctionDocument.add("code", VPackValue(code));
   oneFunctionDocument.add("isDeterministic", VPackValue(isDeterministic));
+  if (isNative) {
+    oneFunctionDocument.add("language", VPackValue(nativeLanguage));
+    oneFunctionDocument.add("ast", ast.slice());
+    oneFunctionDocument.add("arguments", VPackValue(numArguments));
+  }
   oneFunctionDocument.close();
 
   {
@@ -329,12 +547,42 @@ Result arangodb::registerUserFunction(TRI_vocbase_t& vocbase,
   }
 
   if (res.ok()) {
-    reloadAqlUserFunctions(vocbase.server());
+    userFunctionsChanged(vocbase);
   }
 
   return res;
 }
 
+Result arangodb::lookupNativeUserFunction(
+    TRI_vocbase_t& vocbase, std::string const& functionName,
+    std::shared_ptr<velocypack::Builder const>& result) {
+  std::string const key = basics::StringUtils::toupper(functionName);
+
+  // coordinators are not notified about functions registered on other
+  // coordinators, so they always read the current definition
+  bool const useCache = ServerState::instance()->isSingleServer();
+  if (!useCache || !nativeUserFunctions.lookup(vocbase.id(), key, result)) {
+    uint64_t const generation = nativeUserFunctions.generation();
+    Result res = readNativeUserFunction(vocbase, key, result);
+    if (res.fail()) {
+      return res;
+    }
+    if (useCache) {
+      nativeUserFunctions.store(vocbase.id(), generation, key, result);
+    }
+  }
+
+  if (result == nullptr) {
+    // a JavaScript function, or no function at all
+    return Result(TRI_ERROR_QUERY_FUNCTION_NOT_FOUND);
+  }
+  return Result();
+}
+
+void arangodb::invalidateNativeUserFunctions(TRI_vocbase_t& vocbase) {
+  nativeUserFunctions.invalidate(vocbase.id());
+}
+
 Result arangodb::toArrayUserFunctions(TRI_vocbase_t& vocbase,
                                       std::string const& functionFilterPrefix,
                                       velocypack::Builder& result) {
@@ -396,11 +644,12 @@ Result arangodb::toArrayUserFunctions(TRI_vocbase_t& vocbase,
                     "element that stores AQL user function is not an object");
     }
 
-    VPackSlice name, fn, dtm;
+    VPackSlice name, fn, dtm, language;
     bool isDeterministic = false;
     name = resolved.get("name");
     fn = resolved.get("code");
     dtm = resolved.get("isDeterministic");
+    language = resolved.get("language");
     if (dtm.isBoolean()) {
       isDeterministic = dtm.getBool();
     }
@@ -416,6 +665,9 @@ Result arangodb::toArrayUserFunctions(TRI_vocbase_t& vocbase,
       oneFunction.add("name", name);
       oneFunction.add("code", VPackValue(tmp));
       oneFunction.add("isDeterministic", VPackValue(isDeterministic));
+      if (language.isString()) {
+        oneFunction.add("language", language);
+      }
       oneFunction.close();
       result.add(oneFunction.slice());
     }
@@ -25,6 +25,7 @@
 
 #include "Basics/Result.h"
 
+#include <memory>
 #include <string>
 
 struct TRI_vocbase_t;
@@ -62,9 +63,13 @@ Result unregisterUserFunctionsGroup(TRI_vocbase_t& vocbase,
 // @param vocbase current database to work with
 // @param userFunction an Object with the following attributes:
 //    name: the case insensitive name of the user function.
-//    code: the javascript code of the function body
+//    code: the javascript code of the function body, or an AQL expression
+//    that refers to the function arguments as @0, @1, ... for native functions
+//    language: "js" (default) or "aql" for native functions, which do not
+//    need V8. native functions may only use values, operators and C++ AQL
+//    functions that do not read documents
 //    isDeterministic: whether the function will return the same result on same
-//    params
+//    params. determined automatically for native functions
 // @param replaceExisting set to true if the function replaced a previously
 // existing one
 // @return result object
@@ -72,6 +77,24 @@ Result registerUserFunction(TRI_vocbase_t& vocbase,
                             velocypack::Slice userFunction,
                             bool& replacedExisting);
 
+// @brief looks up a native user function in the current database. on single
+// servers, the definitions are cached per database until a user function of
+// the database is registered or unregistered
+// @param vocbase current database to work with
+// @param functionName the case insensitive name of the function
+// @param result receives the stored function definition, with the AST of the
+// function body in attribute "ast" and the number of arguments in attribute
+// "arguments"
+// @return TRI_ERROR_QUERY_FUNCTION_NOT_FOUND if there is no such function or
+// if it is a JavaScript function
+Result lookupNativeUserFunction(
+    TRI_vocbase_t& vocbase, std::string const& functionName,
+    std::shared_ptr<velocypack::Builder const>& result);
+
+// @brief removes the cached native user functions of the database, e.g.
+// when it is dropped
+void invalidateNativeUserFunctions(TRI_vocbase_t& vocbase);
+
 // @brief fetches [all functions | functions matching the functionFilterPrefix]
 // @param vocbase current database to work with
 // @param functionFilterPrefix if non-empty, only return functions matching this
@@ -82,6 +105,7 @@ Result registerUserFunction(TRI_vocbase_t& vocbase,
 //    code: the javascript code of the function body
 //    isDeterministic: whether the function will return the same result on same
 //    params
+//    language: "aql", only for native functions
 // @return result object
 Result toArrayUserFunctions(TRI_vocbase_t& vocbase,
                             std::string const& functionFilterPrefix,
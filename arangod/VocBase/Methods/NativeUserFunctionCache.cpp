@@ -0,0 +1,69 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "NativeUserFunctionCache.h"
+
+#include "Basics/ReadLocker.h"
+#include "Basics/WriteLocker.h"
+
+#include <velocypack/Builder.h>
+
+using namespace arangodb;
+
+uint64_t NativeUserFunctionCache::generation() const noexcept {
+  return _generation.load(std::memory_order_acquire);
+}
+
+bool NativeUserFunctionCache::lookup(
+    TRI_voc_tick_t databaseId, std::string const& key,
+    std::shared_ptr<velocypack::Builder const>& definition) const {
+  READ_LOCKER(readLocker, _lock);
+  auto it = _functions.find(databaseId);
+  if (it == _functions.end()) {
+    return false;
+  }
+  auto it2 = it->second.find(key);
+  if (it2 == it->second.end()) {
+    return false;
+  }
+  definition = it2->second;
+  return true;
+}
+
+void NativeUserFunctionCache::store(
+    TRI_voc_tick_t databaseId, uint64_t generation, std::string const& key,
+    std::shared_ptr<velocypack::Builder const> definition) {
+  WRITE_LOCKER(writeLocker, _lock);
+  if (generation != _generation.load(std::memory_order_relaxed)) {
+    return;
+  }
+  auto& functions = _functions[databaseId];
+  if (functions.size() >= maxFunctionsPerDatabase) {
+    functions.clear();
+  }
+  functions.insert_or_assign(key, std::move(definition));
+}
+
+void NativeUserFunctionCache::invalidate(TRI_voc_tick_t databaseId) {
+  WRITE_LOCKER(writeLocker, _lock);
+  _generation.fetch_add(1, std::memory_order_release);
+  _functions.erase(databaseId);
+}
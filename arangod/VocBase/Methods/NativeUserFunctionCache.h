@@ -0,0 +1,79 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Basics/ReadWriteLock.h"
+#include "VocBase/voc-types.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+namespace arangodb {
+namespace velocypack {
+class Builder;
+}  // namespace velocypack
+
+/// @brief the definitions of native user functions, per database and
+/// upper-cased function name. JavaScript functions and unknown functions
+/// are cached as nullptrs, so that parsing a query only needs to read from
+/// _aqlfunctions once per function. the entries of a database must be
+/// invalidated whenever a user function of the database is registered or
+/// unregistered. there is no invalidation across servers, so the cache
+/// must only be used on single servers
+class NativeUserFunctionCache {
+ public:
+  /// @brief maximum number of functions cached per database
+  static constexpr size_t maxFunctionsPerDatabase = 1024;
+
+  /// @brief must be fetched before reading a definition, and passed to
+  /// store() afterwards
+  uint64_t generation() const noexcept;
+
+  /// @brief look up a definition. returns false if the function is not
+  /// cached. definition is a nullptr for cached JavaScript functions and
+  /// unknown functions
+  bool lookup(TRI_voc_tick_t databaseId, std::string const& key,
+              std::shared_ptr<velocypack::Builder const>& definition) const;
+
+  /// @brief store a definition. does nothing if the functions of any
+  /// database have changed since the generation was fetched
+  void store(TRI_voc_tick_t databaseId, uint64_t generation,
+             std::string const& key,
+             std::shared_ptr<velocypack::Builder const> definition);
+
+  /// @brief remove all cached definitions of the database
+  void invalidate(TRI_voc_tick_t databaseId);
+
+ private:
+  mutable basics::ReadWriteLock _lock;
+  std::unordered_map<
+      TRI_voc_tick_t,
+      std::unordered_map<std::string,
+                         std::shared_ptr<velocypack::Builder const>>>
+      _functions;
+  std::atomic<uint64_t> _generation{0};
+};
+
+}  // namespace arangodb
@@ -273,6 +273,7 @@ Result UserInputCollectionProperties::validateOrSetDefaultShardingStrategy() {
   }
   if (shardingStrategy.has_value()) {
     if (shardingStrategy.value() == "hash" ||
+        shardingStrategy.value() == "jump-hash" ||
         shardingStrategy.value() == "community-compat" ||
         shardingStrategy.value() == "enterprise-compat") {
       return {TRI_ERROR_NO_ERROR};
@@ -65,7 +65,8 @@ auto UtilityInvariants::isValidShardingStrategy(std::string const& strat)
   // Note we may be better off with a lookup list here
   // Hash is first on purpose (default)
   if (strat == "" || strat == "hash" || strat == "enterprise-hash-smart-edge" ||
-      strat == "community-compat" || strat == "enterprise-compat" ||
+      strat == "jump-hash" || strat == "community-compat" ||
+      strat == "enterprise-compat" ||
       strat == "enterprise-smart-edge-compat" ||
       strat == "enterprise-hex-smart-vertex") {
     return inspection::Status::Success{};
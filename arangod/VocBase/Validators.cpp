@@ -31,12 +31,233 @@
 #include <tao/json/jaxn/to_string.hpp>
 #include <validation/validation.hpp>
 
+#include <velocypack/Iterator.h>
+
+#include <algorithm>
 #include <array>
 #include <iostream>
 #include <string_view>
 #include <tao/json/to_string.hpp>
+#include <vector>
 
 namespace arangodb {
+namespace detail {
+
+/// @brief a JSON schema that only uses "type", "required", "properties" and
+/// a boolean "additionalProperties", flattened into a vector of nodes. The
+/// nodes are evaluated on the VelocyPack document directly. This yields the
+/// same result as the full validator, but does not allocate.
+struct CompiledJsonSchema {
+  enum Type : std::uint8_t {
+    kNull = 1 << 0,
+    kBoolean = 1 << 1,
+    kInteger = 1 << 2,
+    kNumber = 1 << 3,
+    kString = 1 << 4,
+    kArray = 1 << 5,
+    kObject = 1 << 6,
+  };
+
+  enum class Outcome { kValid, kInvalid, kUnknown };
+
+  struct Node {
+    // allowed types, 0 if any type is allowed
+    std::uint8_t types = 0;
+    bool additionalProperties = true;
+    std::vector<std::string> required;
+    // sorted by name, with the index of the node for the property value
+    std::vector<std::pair<std::string, std::size_t>> properties;
+  };
+
+  /// @brief returns nullptr if the schema uses unsupported keywords
+  static std::shared_ptr<CompiledJsonSchema const> compile(VPackSlice schema) {
+    auto compiled = std::make_shared<CompiledJsonSchema>();
+    if (!compiled->compileNode(schema)) {
+      return nullptr;
+    }
+    return compiled;
+  }
+
+  /// @brief returns kUnknown if the document contains something that only
+  /// the full validator can handle
+  Outcome check(VPackSlice slice,
+                validation::SpecialProperties special) const {
+    return checkNode(0, slice, special);
+  }
+
+ private:
+  static std::uint8_t typeFromName(std::string_view name) {
+    if (name == "null") {
+      return kNull;
+    } else if (name == "boolean") {
+      return kBoolean;
+    } else if (name == "integer") {
+      return kInteger;
+    } else if (name == "number") {
+      return kNumber;
+    } else if (name == "string") {
+      return kString;
+    } else if (name == "array") {
+      return kArray;
+    } else if (name == "object") {
+      return kObject;
+    }
+    return 0;
+  }
+
+  // returns the types a value of the given slice matches, 0 for types the
+  // full validator has to deal with
+  static std::uint8_t typeOf(VPackSlice slice) {
+    switch (slice.type()) {
+      case VPackValueType::Null:
+        return kNull;
+      case VPackValueType::Bool:
+        return kBoolean;
+      case VPackValueType::Int:
+      case VPackValueType::UInt:
+      case VPackValueType::SmallInt:
+        return static_cast<std::uint8_t>(kInteger | kNumber);
+      case VPackValueType::Double:
+        // the full validator does not consider integral doubles integers
+        return kNumber;
+      case VPackValueType::String:
+        return kString;
+      case VPackValueType::Array:
+        return kArray;
+      case VPackValueType::Object:
+        return kObject;
+      default:
+        return 0;
+    }
+  }
+
+  bool compileNode(VPackSlice schema) {
+    if (!schema.isObject()) {
+      return false;
+    }
+    std::size_t index = _nodes.size();
+    _nodes.emplace_back();
+
+    for (auto [key, value] : VPackObjectIterator(schema)) {
+      std::string_view name = key.stringView();
+      if (name == "type") {
+        std::uint8_t types = 0;
+        if (value.isString()) {
+          types = typeFromName(value.stringView());
+          if (types == 0) {
+            return false;
+          }
+        } else if (value.isArray()) {
+          for (VPackSlice t : VPackArrayIterator(value)) {
+            std::uint8_t type = t.isString() ? typeFromName(t.stringView()) : 0;
+            if (type == 0) {
+              return false;
+            }
+            types |= type;
+          }
+        } else {
+          return false;
+        }
+        _nodes[index].types = types;
+      } else if (name == "required") {
+        if (!value.isArray()) {
+          return false;
+        }
+        for (VPackSlice r : VPackArrayIterator(value)) {
+          if (!r.isString()) {
+            return false;
+          }
+          _nodes[index].required.emplace_back(r.stringView());
+        }
+      } else if (name == "properties") {
+        if (!value.isObject()) {
+          return false;
+        }
+        for (auto [property, subschema] : VPackObjectIterator(value)) {
+          std::size_t child = _nodes.size();
+          if (!compileNode(subschema)) {
+            return false;
+          }
+          _nodes[index].properties.emplace_back(property.copyString(), child);
+        }
+        std::sort(_nodes[index].properties.begin(),
+                  _nodes[index].properties.end());
+      } else if (name == "additionalProperties") {
+        if (!value.isBool()) {
+          return false;
+        }
+        _nodes[index].additionalProperties = value.getBool();
+      } else if (name != "title" && name != "description" &&
+                 name != "default" && name != "$schema" &&
+                 name != "$comment") {
+        // anything else is left to the full validator
+        return false;
+      }
+    }
+    return true;
+  }
+
+  Outcome checkNode(std::size_t index, VPackSlice slice,
+                    validation::SpecialProperties special) const {
+    Node const& node = _nodes[index];
+
+    std::uint8_t type = typeOf(slice);
+    if (type == 0) {
+      return Outcome::kUnknown;
+    }
+    if (node.types != 0 && (node.types & type) == 0) {
+      return Outcome::kInvalid;
+    }
+    if (type != kObject) {
+      return Outcome::kValid;
+    }
+
+    for (auto const& name : node.required) {
+      // attributes hidden from the validator count as missing
+      if (validation::skip_special(name, special) || slice.get(name).isNone()) {
+        return Outcome::kInvalid;
+      }
+    }
+
+    if (node.properties.empty() && node.additionalProperties) {
+      return Outcome::kValid;
+    }
+
+    for (auto [key, value] : VPackObjectIterator(slice, true)) {
+      if (!key.isString()) {
+        if (special != validation::SpecialProperties::None) {
+          return Outcome::kUnknown;
+        }
+        // translated system attribute, not visible to the validator
+        continue;
+      }
+      std::string_view name = key.stringView();
+      if (validation::skip_special(name, special)) {
+        continue;
+      }
+      auto it = std::lower_bound(
+          node.properties.begin(), node.properties.end(), name,
+          [](auto const& property, std::string_view n) {
+            return property.first < n;
+          });
+      if (it == node.properties.end() || it->first != name) {
+        if (!node.additionalProperties) {
+          return Outcome::kInvalid;
+        }
+        continue;
+      }
+      Outcome outcome = checkNode(it->second, value, special);
+      if (outcome != Outcome::kValid) {
+        return outcome;
+      }
+    }
+    return Outcome::kValid;
+  }
+
+  std::vector<Node> _nodes;
+};
+
+}  // namespace detail
 
 std::string const& to_string(ValidationLevel level) {
   switch (level) {
@@ -224,6 +445,7 @@ ValidatorJsonSchema::ValidatorJsonSchema(VPackSlice params)
   auto taoRuleValue = validation::slice_to_value(rule);
   try {
     _schema = std::make_shared<tao::json::schema>(taoRuleValue);
+    _compiled = detail::CompiledJsonSchema::compile(rule);
     _builder.add(rule);
   } catch (std::exception const& ex) {
     auto valueString = tao::json::to_string(taoRuleValue, 4);
@@ -236,6 +458,14 @@ ValidatorJsonSchema::ValidatorJsonSchema(VPackSlice params)
 
 Result ValidatorJsonSchema::validateOne(VPackSlice slice,
                                         VPackOptions const* options) const {
+  if (_compiled != nullptr) {
+    auto outcome = _compiled->check(slice, _special);
+    if (outcome == detail::CompiledJsonSchema::Outcome::kValid) {
+      return {};
+    } else if (outcome == detail::CompiledJsonSchema::Outcome::kInvalid) {
+      return {TRI_ERROR_VALIDATION_FAILED, _message};
+    }
+  }
   auto res = validation::validate(*_schema, _special, slice, options);
   if (res) {
     return {};
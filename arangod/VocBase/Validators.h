@@ -36,6 +36,9 @@ class basic_schema;
 }
 
 namespace arangodb {
+namespace detail {
+struct CompiledJsonSchema;
+}
 
 enum class ValidationLevel {
   None = 0,
@@ -86,6 +89,11 @@ struct ValidatorJsonSchema : public ValidatorBase {
 
  private:
   std::shared_ptr<tao::json::basic_schema<tao::json::traits>> _schema;
+  // flattened version of the schema, which is checked directly on the
+  // document without going through the event consumers of _schema. only
+  // set if the schema uses nothing but the keywords "type", "required",
+  // "properties" and a boolean "additionalProperties" (plus annotations)
+  std::shared_ptr<detail::CompiledJsonSchema const> _compiled;
   VPackBuilder _builder;
 };
 
@@ -38,6 +38,7 @@
 
 #include "ApplicationFeatures/ApplicationServer.h"
 #include "Aql/QueryCache.h"
+#include "Aql/QueryPlanCache.h"
 #include "Aql/QueryList.h"
 #include "Auth/Common.h"
 #include "Basics/Exceptions.h"
@@ -481,6 +482,7 @@ Result TRI_vocbase_t::dropCollectionWorker(LogicalCollection& collection) {
   TRI_ASSERT(locker.isLocked());
 
   aql::QueryCache::instance()->invalidate(this);
+  aql::QueryPlanCache::instance()->invalidate(this);
 
   collection.setDeleted();
 
@@ -1094,6 +1096,7 @@ Result TRI_vocbase_t::renameView(DataSourceId cid, std::string_view oldName) {
 
   // invalidate all entries in the query cache now
   aql::QueryCache::instance()->invalidate(this);
+  aql::QueryPlanCache::instance()->invalidate(this);
 
   return TRI_ERROR_NO_ERROR;
 }
@@ -1203,6 +1206,9 @@ Result TRI_vocbase_t::renameCollection(DataSourceId cid,
   locker.unlock();
   writeLocker.unlock();
 
+  // cached plans refer to the collection by its old name
+  aql::QueryPlanCache::instance()->invalidate(this);
+
   auto& df = server().getFeature<DatabaseFeature>();
   if (df.versionTracker() != nullptr) {
     df.versionTracker()->track("rename collection");
@@ -1358,6 +1364,7 @@ Result TRI_vocbase_t::dropView(DataSourceId cid, bool allowDropSystem) {
 
   // invalidate all entries in the query cache now
   aql::QueryCache::instance()->invalidate(this);
+  aql::QueryPlanCache::instance()->invalidate(this);
 
   unregisterView(*view);
 
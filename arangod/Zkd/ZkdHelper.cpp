@@ -28,6 +28,7 @@
 #include "Containers/SmallVector.h"
 
 #include <algorithm>
+#include <bit>
 #include <cassert>
 #include <cmath>
 #include <cstddef>
@@ -39,6 +40,40 @@
 using namespace arangodb;
 using namespace arangodb::zkd;
 
+namespace {
+auto byteAt(byte_string_view bs, std::size_t index) -> std::byte {
+  return index < bs.size() ? bs[index] : std::byte{0};
+}
+
+/// @brief call func(index, curBit, minBit, maxBit) for every bit index at
+/// which cur differs from min or max, in ascending order, until func returns
+/// false. bits at which cur, min and max are equal cannot change the
+/// relation of cur to the box, so they are skipped a byte at a time.
+template<typename F>
+void forEachDifferingBit(byte_string_view cur, byte_string_view min,
+                         byte_string_view max, F&& func) {
+  std::size_t maxSize = std::max({cur.size(), min.size(), max.size()});
+  for (std::size_t b = 0; b < maxSize; ++b) {
+    auto const curByte = byteAt(cur, b);
+    auto const minByte = byteAt(min, b);
+    auto const maxByte = byteAt(max, b);
+    auto differing = std::to_integer<unsigned char>((curByte ^ minByte) |
+                                                    (curByte ^ maxByte));
+    while (differing != 0) {
+      auto const k = static_cast<unsigned>(std::countl_zero(differing));
+      auto const mask = std::byte{0x80} >> k;
+      differing &= static_cast<unsigned char>(~(0x80u >> k));
+      auto const toBit = [mask](std::byte v) {
+        return (v & mask) != std::byte{0} ? Bit::ONE : Bit::ZERO;
+      };
+      if (!func(8 * b + k, toBit(curByte), toBit(minByte), toBit(maxByte))) {
+        return;
+      }
+    }
+  }
+}
+}  // namespace
+
 zkd::byte_string zkd::operator"" _bs(const char* const str, std::size_t len) {
   using namespace std::string_literals;
 
@@ -290,11 +325,6 @@ void zkd::compareWithBoxInto(byte_string_view cur, byte_string_view min,
                              std::vector<CompareResult>& result) {
   TRI_ASSERT(result.size() == dimensions);
   std::fill(result.begin(), result.end(), CompareResult{});
-  std::size_t max_size = std::max({cur.size(), min.size(), max.size()});
-
-  BitReader cur_reader(cur);
-  BitReader min_reader(min);
-  BitReader max_reader(max);
 
   auto const isLargerThanMin = [&result](auto const dim) {
     return result[dim].saveMin != CompareResult::max;
@@ -303,16 +333,10 @@ void zkd::compareWithBoxInto(byte_string_view cur, byte_string_view min,
     return result[dim].saveMax != CompareResult::max;
   };
 
-  std::size_t step = 0;
-  std::size_t dim = 0;
-
-  for (std::size_t i = 0; i < 8 * max_size; i++) {
-    TRI_ASSERT(step == i / dimensions);
-    TRI_ASSERT(dim == i % dimensions);
-
-    auto cur_bit = cur_reader.next().value_or(Bit::ZERO);
-    auto min_bit = min_reader.next().value_or(Bit::ZERO);
-    auto max_bit = max_reader.next().value_or(Bit::ZERO);
+  forEachDifferingBit(cur, min, max, [&](std::size_t i, Bit cur_bit,
+                                         Bit min_bit, Bit max_bit) {
+    std::size_t const step = i / dimensions;
+    std::size_t const dim = i % dimensions;
 
     if (result[dim].flag == 0) {
       if (!isLargerThanMin(dim)) {
@@ -333,12 +357,8 @@ void zkd::compareWithBoxInto(byte_string_view cur, byte_string_view min,
         }
       }
     }
-    dim += 1;
-    if (dim >= dimensions) {
-      dim = 0;
-      step += 1;
-    }
-  }
+    return true;
+  });
 }
 
 auto zkd::testInBox(byte_string_view cur, byte_string_view min,
@@ -350,51 +370,43 @@ auto zkd::testInBox(byte_string_view cur, byte_string_view min,
     throw std::invalid_argument{msg};
   }
 
-  std::size_t max_size = std::max({cur.size(), min.size(), max.size()});
-
-  BitReader cur_reader(cur);
-  BitReader min_reader(min);
-  BitReader max_reader(max);
-
   containers::SmallVector<std::pair<bool, bool>, 32> isLargerLowerThanMinMax;
   isLargerLowerThanMinMax.resize(dimensions);
 
-  unsigned dim = 0;
+  bool inBox = true;
   unsigned finished_dims = static_cast<unsigned>(2 * dimensions);
-  for (std::size_t i = 0; i < 8 * max_size; i++) {
-    auto cur_bit = cur_reader.next().value_or(Bit::ZERO);
-    auto min_bit = min_reader.next().value_or(Bit::ZERO);
-    auto max_bit = max_reader.next().value_or(Bit::ZERO);
+  forEachDifferingBit(cur, min, max, [&](std::size_t i, Bit cur_bit,
+                                         Bit min_bit, Bit max_bit) {
+    std::size_t const dim = i % dimensions;
 
     if (!isLargerLowerThanMinMax[dim].first) {
       if (cur_bit == Bit::ZERO && min_bit == Bit::ONE) {
+        inBox = false;
         return false;
       } else if (cur_bit == Bit::ONE && min_bit == Bit::ZERO) {
         isLargerLowerThanMinMax[dim].first = true;
         if (--finished_dims == 0) {
-          break;
+          return false;
         }
       }
     }
 
     if (!isLargerLowerThanMinMax[dim].second) {
       if (cur_bit == Bit::ONE && max_bit == Bit::ZERO) {
+        inBox = false;
         return false;
       } else if (cur_bit == Bit::ZERO && max_bit == Bit::ONE) {
         isLargerLowerThanMinMax[dim].second = true;
         if (--finished_dims == 0) {
-          break;
+          return false;
         }
       }
     }
 
-    dim += 1;
-    if (dim >= dimensions) {
-      dim = 0;
-    }
-  }
+    return true;
+  });
 
-  return true;
+  return inBox;
 }
 
 auto zkd::getNextZValue(byte_string_view cur, byte_string_view min,
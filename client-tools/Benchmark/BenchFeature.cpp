@@ -116,6 +116,7 @@ BenchFeature::BenchFeature(Server& server, int* result)
   DocumentImportTest::registerTestcase();
   EdgeCrudTest::registerTestcase();
   PersistentIndexTest::registerTestcase();
+  TraversalTest::registerTestcase();
   VersionTest::registerTestcase();
 }
 
@@ -154,6 +155,22 @@ void BenchFeature::collectOptions(std::shared_ptr<ProgramOptions> options) {
   options->addOption("--requests", "The total number of operations.",
                      new UInt64Parameter(&_operations));
 
+  options
+      ->addOption("--rate",
+                  "The target number of operations per second of all threads "
+                  "together (0 = no target rate).",
+                  new UInt64Parameter(&_rate))
+      .setIntroducedIn(31200)
+      .setLongDescription(R"(By default, each thread sends its next request
+as soon as the previous one has returned. A slow response then delays all
+following requests of the thread, and the measured latencies understate the
+latencies that clients with a fixed request rate would see.
+
+With a target rate, the requests of each thread are started on a fixed
+schedule, and the latency of each request is measured from its scheduled
+start time. The rate must be reachable with the number of threads, otherwise
+requests fall further and further behind the schedule.)");
+
   options->addOption(
       "--batch-size",
       "The number of operations in one batch (0 = disable batching)",
@@ -469,7 +486,8 @@ void BenchFeature::start() {
           server(), benchmark.get(), &startCondition,
           &BenchFeature::updateStartCounter, static_cast<int>(i), _batchSize,
           &operationsCounter, client, _keepAlive, _async,
-          _histogramIntervalSize, _histogramNumIntervals, _generateHistogram);
+          _histogramIntervalSize, _histogramNumIntervals, _generateHistogram,
+          _rate > 0 ? static_cast<double>(_threadCount) / _rate : 0.0);
       thread->setOffset(i * realStep);
       thread->start();
       threads.push_back(std::move(thread));
@@ -604,6 +622,7 @@ void BenchFeature::report(ClientFeature& client,
   builder.add("numberOfShards", VPackValue(_numberOfShards));
   builder.add("waitForSync", VPackValue(_waitForSync));
   builder.add("concurrencyLevel", VPackValue(_threadCount));
+  builder.add("rate", VPackValue(_rate));
   builder.add("testCase", VPackValue(_testCase));
   builder.add("complexity", VPackValue(_complexity));
   builder.add("database", VPackValue(client.databaseName()));
@@ -107,6 +107,7 @@ class BenchFeature final : public ArangoBenchFeature {
   uint64_t _realOperations;
   uint64_t _batchSize;
   uint64_t _duration;
+  uint64_t _rate{0};
   std::string _collection;
   std::string _testCase;
   uint64_t _complexity;
@@ -23,9 +23,11 @@
 
 #pragma once
 
+#include <chrono>
 #include <cmath>
 #include <memory>
 #include <string>
+#include <thread>
 #include <vector>
 #include <shared_mutex>
 
@@ -67,7 +69,7 @@ class BenchmarkThread : public arangodb::Thread {
                   BenchmarkCounter<uint64_t>* operationsCounter,
                   ClientFeature& client, bool keepAlive, bool async,
                   double histogramIntervalSize, uint64_t histogramNumIntervals,
-                  bool generateHistogram)
+                  bool generateHistogram, double operationInterval)
       : Thread(server, "BenchmarkThread"),
         _operation(operation),
         _startCondition(condition),
@@ -81,6 +83,7 @@ class BenchmarkThread : public arangodb::Thread {
         _async(async),
         _useVelocyPack(_batchSize == 0),
         _generateHistogram(generateHistogram),
+        _operationInterval(operationInterval),
         _httpClient(nullptr),
         _offset(0),
         _counter(0),
@@ -201,6 +204,8 @@ class BenchmarkThread : public arangodb::Thread {
       _startCondition->cv.wait(guard);
     }
 
+    _nextStart = TRI_microtime();
+
     while (!isStopping()) {
       uint64_t numOps = _operationsCounter->next(_batchSize);
 
@@ -282,7 +287,7 @@ class BenchmarkThread : public arangodb::Thread {
     _headers[StaticStrings::ContentTypeHeader] =
         StaticStrings::MultiPartContentType + "; boundary=" + boundary;
 
-    double start = TRI_microtime();
+    double start = waitForStart(numOperations);
     std::unique_ptr<httpclient::SimpleHttpResult> result(_httpClient->request(
         rest::RequestType::POST, "/_api/batch", _payloadBuffer.data(),
         _payloadBuffer.size(), _headers));
@@ -326,7 +331,7 @@ class BenchmarkThread : public arangodb::Thread {
 
     TRI_ASSERT(p != nullptr || length == 0);
 
-    double start = TRI_microtime();
+    double start = waitForStart(1);
     std::unique_ptr<httpclient::SimpleHttpResult> result(_httpClient->request(
         _requestData.type, _requestData.url, p, length, _headers));
     double delta = TRI_microtime() - start;
@@ -336,6 +341,25 @@ class BenchmarkThread : public arangodb::Thread {
     _httpClient->recycleResult(std::move(result));
   }
 
+  /// @brief returns the start time of a request with numOperations
+  /// operations. with a target rate, requests are started on a fixed
+  /// schedule, waiting for the scheduled time if necessary. the scheduled
+  /// time is returned even if the request starts later, so that responses
+  /// which delay subsequent requests also count against these requests
+  /// (instead of hiding the delay in the closed loop)
+  double waitForStart(uint64_t numOperations) {
+    double now = TRI_microtime();
+    if (_operationInterval <= 0.0) {
+      return now;
+    }
+    double start = _nextStart;
+    _nextStart += _operationInterval * static_cast<double>(numOperations);
+    if (now < start) {
+      std::this_thread::sleep_for(std::chrono::duration<double>(start - now));
+    }
+    return start;
+  }
+
   void processResponse(httpclient::SimpleHttpResult const* result, bool batch,
                        uint64_t numOperations) {
     char const* type = (batch ? "batch" : "single");
@@ -429,6 +453,13 @@ class BenchmarkThread : public arangodb::Thread {
   /// @brief show the histogram or not
   bool const _generateHistogram;
 
+  /// @brief scheduled time between two operations in seconds, 0 if the next
+  /// request is sent as soon as the previous one has returned
+  double const _operationInterval;
+
+  /// @brief scheduled start time of the next request
+  double _nextStart{0.0};
+
   /// @brief underlying http client
   std::unique_ptr<arangodb::httpclient::SimpleHttpClient> _httpClient;
 
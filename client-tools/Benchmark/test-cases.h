@@ -33,4 +33,5 @@
 #include "testcases/DocumentImportTestCase.h"
 #include "testcases/EdgeCrudTestCase.h"
 #include "testcases/PersistentIndexTestCase.h"
+#include "testcases/TraversalTestCase.h"
 #include "testcases/VersionTestCase.h"
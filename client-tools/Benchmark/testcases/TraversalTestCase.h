@@ -0,0 +1,112 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Benchmark.h"
+#include "helpers.h"
+#include <velocypack/Builder.h>
+#include <velocypack/Value.h>
+#include <algorithm>
+#include <string>
+
+namespace arangodb::arangobench {
+
+struct TraversalTest : public Benchmark<TraversalTest> {
+  static std::string name() { return "aql-traversal"; }
+
+  /// @brief number of vertices of the generated graph
+  static constexpr uint64_t numVertices = 10000;
+  /// @brief number of outgoing edges per vertex
+  static constexpr uint64_t numEdgesPerVertex = 5;
+
+  TraversalTest(BenchFeature& arangobench)
+      : Benchmark<TraversalTest>(arangobench) {}
+
+  bool setUp(arangodb::httpclient::SimpleHttpClient* client) override {
+    if (!_arangobench.createCollection()) {
+      return true;
+    }
+    std::string const& vertices = _arangobench.collection();
+    std::string const edges = edgeCollection();
+    // edge targets are skewed towards vertices with low numbers, so that
+    // some vertices have a very high in-degree, as in power-law graphs
+    return DeleteCollection(client, edges) &&
+           DeleteCollection(client, vertices) &&
+           CreateCollection(client, vertices, 2, _arangobench) &&
+           CreateCollection(client, edges, 3, _arangobench) &&
+           RunQuery(client, "FOR i IN 0.." + std::to_string(numVertices - 1) +
+                                " INSERT {_key: CONCAT('v', i)} INTO " +
+                                vertices) &&
+           RunQuery(client,
+                    "FOR i IN 0.." + std::to_string(numVertices - 1) +
+                        " FOR j IN 1.." + std::to_string(numEdgesPerVertex) +
+                        " INSERT {_from: CONCAT('" + vertices +
+                        "/v', i), _to: CONCAT('" + vertices +
+                        "/v', FLOOR(POW(RAND(), 3) * " +
+                        std::to_string(numVertices) + "))} INTO " + edges);
+  }
+
+  void tearDown() override {}
+
+  void buildRequest(
+      size_t threadNumber, size_t threadCounter, size_t globalCounter,
+      BenchmarkOperation::RequestData& requestData) const override {
+    using namespace arangodb::velocypack;
+    requestData.url = "/_api/cursor";
+    requestData.type = rest::RequestType::POST;
+    requestData.payload.openObject();
+    requestData.payload.add(
+        "query", Value("FOR v IN 1..@depth OUTBOUND @start " +
+                       edgeCollection() +
+                       " COLLECT WITH COUNT INTO count RETURN count"));
+    requestData.payload.add(Value("bindVars"));
+    requestData.payload.openObject();
+    requestData.payload.add(
+        "depth", Value(std::max<uint64_t>(_arangobench.complexity(), 1)));
+    requestData.payload.add(
+        "start", Value(_arangobench.collection() + "/v" +
+                       std::to_string(globalCounter % numVertices)));
+    requestData.payload.close();
+    requestData.payload.close();
+  }
+
+  char const* getDescription() const noexcept override {
+    return "creates a graph with 10,000 vertices and 5 outgoing edges per "
+           "vertex in the collection given by --collection and an edge "
+           "collection with the same name plus the suffix '_edges'. The edge "
+           "targets are skewed, so that a few vertices have a very high "
+           "in-degree. Then performs AQL traversal queries that count the "
+           "vertices reachable from a start vertex, with a different start "
+           "vertex for each query. The --complexity parameter controls the "
+           "maximum traversal depth. The total number of queries is equal to "
+           "the value of --requests.";
+  }
+
+  bool isDeprecated() const noexcept override { return false; }
+
+ private:
+  std::string edgeCollection() const {
+    return _arangobench.collection() + "_edges";
+  }
+};
+
+}  // namespace arangodb::arangobench
@@ -28,6 +28,9 @@
 #include "Basics/StringUtils.h"
 #include "SimpleHttpClient/SimpleHttpResult.h"
 
+#include <velocypack/Builder.h>
+#include <velocypack/Value.h>
+
 namespace arangodb::arangobench {
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -150,4 +153,37 @@ bool CreateDocument(arangodb::httpclient::SimpleHttpClient* client,
   return !failed;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief run an AQL query, ignoring its result (e.g. to generate data)
+////////////////////////////////////////////////////////////////////////////////
+
+bool RunQuery(arangodb::httpclient::SimpleHttpClient* client,
+              std::string const& query) {
+  std::unordered_map<std::string, std::string> headerFields;
+
+  velocypack::Builder builder;
+  builder.openObject();
+  builder.add("query", velocypack::Value(query));
+  builder.close();
+  std::string payload = builder.slice().toJson();
+
+  std::unique_ptr<arangodb::httpclient::SimpleHttpResult> result(
+      client->request(rest::RequestType::POST, "/_api/cursor",
+                      payload.c_str(), payload.size(), headerFields));
+
+  bool failed = true;
+
+  if (result != nullptr) {
+    if (result->getHttpReturnCode() == 201) {
+      failed = false;
+    } else {
+      LOG_TOPIC("9a4f2", WARN, Logger::BENCH)
+          << "error when running query: " << result->getHttpReturnMessage()
+          << " for query '" << query << "': " << result->getBody();
+    }
+  }
+
+  return !failed;
+}
+
 }  // namespace arangodb::arangobench
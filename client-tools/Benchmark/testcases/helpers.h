@@ -43,4 +43,6 @@ bool CreateDocument(arangodb::httpclient::SimpleHttpClient*, std::string const&,
 
 bool CreateIndex(arangodb::httpclient::SimpleHttpClient*, std::string const&,
                  std::string const&, std::string const&);
+
+bool RunQuery(arangodb::httpclient::SimpleHttpClient*, std::string const&);
 }  // namespace arangodb::arangobench
@@ -797,6 +797,20 @@ void DumpFeature::collectOptions(
                   new BooleanParameter(&_options.useGzip))
       .setIntroducedIn(30406);
 
+  options
+      ->addOption("--compression-level",
+                  "The gzip compression level to use with --compress-output, "
+                  "from 1 (fastest) to 9 (smallest files).",
+                  new UInt32Parameter(&_options.compressionLevel, /*base*/ 1,
+                                      /*minValue*/ 1, /*maxValue*/ 9),
+                  arangodb::options::makeDefaultFlags(
+                      arangodb::options::Flags::Uncommon))
+      .setLongDescription(R"(Compressing the dump data is often more
+expensive than fetching it from the server. Lower levels compress much faster,
+at the cost of somewhat larger files. arangorestore can read files of any
+compression level.)")
+      .setIntroducedIn(31200);
+
   options
       ->addOption("--use-experimental-dump",
                   "Enable experimental dump behavior.",
@@ -1006,6 +1020,7 @@ Result DumpFeature::runDump(httpclient::SimpleHttpClient& client,
         arangodb::basics::FileUtils::buildFilename(
             _options.outputPath, ::getDatabaseDirName(dbName, dbId)),
         !_options.overwrite, true, _options.useGzip);
+    _directory->setGzipLevel(static_cast<int>(_options.compressionLevel));
 
     if (_directory->status().fail()) {
       LOG_TOPIC("94201", ERR, Logger::DUMP)
@@ -1142,7 +1157,14 @@ Result DumpFeature::runDump(httpclient::SimpleHttpClient& client,
       continue;
     }
 
-    if (_options.useExperimentalDump) {
+    bool dumpData = _options.dumpData;
+    if (dumpData && _maskings != nullptr) {
+      dumpData = _maskings->shouldDumpData(name);
+    }
+
+    if (_options.useExperimentalDump && dumpData) {
+      // only fetch the shards of collections whose data is dumped. for all
+      // other collections, the DumpCollectionJob writes the structure only
       for (auto const& [shard, servers] : VPackObjectIterator(
                collectionInfo.get("parameters").get("shards"))) {
         TRI_ASSERT(servers.isArray());
@@ -1326,6 +1348,7 @@ void DumpFeature::start() {
   _directory = std::make_unique<ManagedDirectory>(
       encryption, _options.outputPath, !_options.overwrite, true,
       _options.useGzip);
+  _directory->setGzipLevel(static_cast<int>(_options.compressionLevel));
   if (_directory->status().fail()) {
     switch (static_cast<int>(_directory->status().errorNumber())) {
       case static_cast<int>(TRI_ERROR_FILE_EXISTS):
@@ -82,6 +82,7 @@ class DumpFeature final : public ArangoDumpFeature {
     bool overwrite{false};
     bool progress{true};
     bool useGzip{true};
+    std::uint32_t compressionLevel{6};
     bool useEnvelope{false};
 
     bool useExperimentalDump{false};
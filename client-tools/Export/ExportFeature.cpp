@@ -408,9 +408,24 @@ void ExportFeature::collectionExport(SimpleHttpClient* httpClient) {
 
     VPackBuilder post;
     post.openObject();
-    post.add("query", VPackValue("FOR doc IN @@collection RETURN doc"));
+    if (_typeExport == "csv") {
+      // only the fields for the CSV columns are written, so there is no need
+      // to transfer the other attributes
+      post.add("query", VPackValue("FOR doc IN @@collection "
+                                   "RETURN KEEP(doc, @fields)"));
+    } else {
+      post.add("query", VPackValue("FOR doc IN @@collection RETURN doc"));
+    }
     post.add("bindVars", VPackValue(VPackValueType::Object));
     post.add("@collection", VPackValue(collection));
+    if (_typeExport == "csv") {
+      post.add(VPackValue("fields"));
+      post.openArray();
+      for (auto const& field : _csvFields) {
+        post.add(VPackValue(field));
+      }
+      post.close();
+    }
     post.close();
     post.add("ttl", VPackValue(::ttlValue));
     post.add("batchSize", VPackValue(_documentsPerBatch));
@@ -485,7 +485,16 @@ ManagedDirectory::File::File(ManagedDirectory const& directory,
   TRI_ASSERT(::flagNotSet(_flags, O_RDWR));  // disallow read/write (encryption)
 
   if (isGzip) {
-    prepareGzip((O_WRONLY & _flags) ? "wb" : "rb");
+    if (O_WRONLY & _flags) {
+      // e.g. "wb1" for fastest compression
+      std::string gzFlags = "wb";
+      if (int level = _directory.gzipLevel(); level >= 1 && level <= 9) {
+        gzFlags.push_back(static_cast<char>('0' + level));
+      }
+      prepareGzip(gzFlags.c_str());
+    } else {
+      prepareGzip("rb");
+    }
   }
 }
 
@@ -262,6 +262,18 @@ class ManagedDirectory {
                                      bool overwrite, int flags = 0,
                                      bool gzipOk = true);
 
+  /**
+   * @brief Set the gzip compression level for files written from now on
+   * @param level Level between 1 (fastest) and 9 (smallest), or -1 for the
+   *              zlib default
+   */
+  void setGzipLevel(int level) noexcept { _gzipLevel = level; }
+
+  /**
+   * @brief Returns the gzip compression level used for written files
+   */
+  int gzipLevel() const noexcept { return _gzipLevel; }
+
   /**
    * @brief Write a string to file
    * @param filename Name of file to write to
@@ -288,6 +300,7 @@ class ManagedDirectory {
   std::string const _path;
   std::string _encryptionType;
   bool _writeGzip;
+  int _gzipLevel{-1};
   Result _status;
 };
 }  // namespace arangodb
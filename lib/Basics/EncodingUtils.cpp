@@ -257,6 +257,10 @@ encoding::gzipUncompress<arangodb::velocypack::Buffer<uint8_t>>(
     uint8_t const* compressed, size_t compressedLength,
     arangodb::velocypack::Buffer<uint8_t>& uncompressed);
 
+template ErrorCode encoding::gzipUncompress<arangodb::basics::StringBuffer>(
+    uint8_t const* compressed, size_t compressedLength,
+    arangodb::basics::StringBuffer& uncompressed);
+
 template ErrorCode encoding::gzipUncompress<std::string>(
     uint8_t const* compressed, size_t compressedLength,
     std::string& uncompressed);
@@ -260,6 +260,7 @@ std::string const StaticStrings::MultiPartContentType("multipart/form-data");
 // accept-encodings
 std::string const StaticStrings::EncodingDeflate("deflate");
 std::string const StaticStrings::EncodingGzip("gzip");
+std::string const StaticStrings::EncodingIdentity("identity");
 
 std::string const StaticStrings::Body("body");
 std::string const StaticStrings::ParsedBody("parsedBody");
@@ -331,6 +332,7 @@ std::string const StaticStrings::QuerySortDESC("DESC");
 
 // Graph Query Strings
 std::string const StaticStrings::GraphQueryEdges("edges");
+std::string const StaticStrings::GraphQueryEdgeCounts("edgeCounts");
 std::string const StaticStrings::GraphQueryVertices("vertices");
 std::string const StaticStrings::GraphQueryPath("path");
 std::string const StaticStrings::GraphQueryGlobal("global");
@@ -240,6 +240,7 @@ class StaticStrings {
   // encodings
   static std::string const EncodingDeflate;
   static std::string const EncodingGzip;
+  static std::string const EncodingIdentity;
 
   // arangosh result body
   static std::string const Body;
@@ -311,6 +312,7 @@ class StaticStrings {
 
   // Graph Query Strings
   static std::string const GraphQueryEdges;
+  static std::string const GraphQueryEdgeCounts;
   static std::string const GraphQueryVertices;
   static std::string const GraphQueryPath;
   static std::string const GraphQueryGlobal;
@@ -42,6 +42,7 @@
 #include "Basics/application-exit.h"
 #include "Basics/debugging.h"
 #include "Basics/error.h"
+#include "CrashHandler/CpuProfiler.h"
 #include "Logger/LogMacros.h"
 #include "Logger/Logger.h"
 #include "Logger/LoggerStream.h"
@@ -131,8 +132,12 @@ void Thread::startThread(void* arg) {
 
   LOCAL_THREAD_NAME = ptr->name().c_str();
 
+  // allow the CPU profiler to sample this thread
+  CpuProfiler::registerThread();
+
   // make sure we drop our reference when we are finished!
   auto guard = scopeGuard([ptr]() noexcept {
+    CpuProfiler::unregisterThread();
     LOCAL_THREAD_NAME = nullptr;
     ptr->_state.store(ThreadState::STOPPED);
     ptr->releaseRef();
@@ -37,6 +37,12 @@ class VPackStringBufferAdapter final : public VPackSink {
       : _buffer(buffer) {}
 
   void push_back(char c) override final {
+    // the dumper appends most characters one by one. avoid the out-of-line
+    // call if the buffer has sufficient capacity
+    if (remaining() > 0) {
+      TRI_AppendCharUnsafeStringBuffer(_buffer, c);
+      return;
+    }
     auto res = TRI_AppendCharStringBuffer(_buffer, c);
     if (res != TRI_ERROR_NO_ERROR) {
       THROW_ARANGO_EXCEPTION(res);
@@ -57,6 +63,10 @@ class VPackStringBufferAdapter final : public VPackSink {
     }
   }
   void append(char const* p, uint64_t len) override final {
+    if (remaining() >= len) {
+      TRI_AppendStringUnsafeStringBuffer(_buffer, p, static_cast<size_t>(len));
+      return;
+    }
     auto res =
         TRI_AppendString2StringBuffer(_buffer, p, static_cast<size_t>(len));
     if (res != TRI_ERROR_NO_ERROR) {
@@ -72,6 +82,11 @@ class VPackStringBufferAdapter final : public VPackSink {
   }
 
  private:
+  size_t remaining() const noexcept {
+    return _buffer->_len -
+           static_cast<size_t>(_buffer->_current - _buffer->_buffer);
+  }
+
   TRI_string_buffer_t* _buffer;
 };
 }  // namespace basics
@@ -286,9 +286,19 @@ ErrorCode TRI_ParseCsvString(TRI_csv_parser_t* parser, char const* line,
           break;
 
         case TRI_CSV_PARSER_WITHIN_FIELD:
-          while (ptr < parser->_stop && *ptr != parser->_separator &&
-                 *ptr != '\r' && *ptr != '\n') {
-            *qtr++ = *ptr++;
+          if (qtr == ptr) {
+            // nothing has been unescaped in this field, so the field's
+            // characters are already where they belong. only scan them
+            while (ptr < parser->_stop && *ptr != parser->_separator &&
+                   *ptr != '\r' && *ptr != '\n') {
+              ++ptr;
+            }
+            qtr = ptr;
+          } else {
+            while (ptr < parser->_stop && *ptr != parser->_separator &&
+                   *ptr != '\r' && *ptr != '\n') {
+              *qtr++ = *ptr++;
+            }
           }
 
           // found separator or eol
@@ -335,9 +345,18 @@ ErrorCode TRI_ParseCsvString(TRI_csv_parser_t* parser, char const* line,
         case TRI_CSV_PARSER_WITHIN_QUOTED_FIELD:
           TRI_ASSERT(parser->_useQuote);
 
-          while (ptr < parser->_stop && *ptr != parser->_quote &&
-                 (!parser->_useBackslash || *ptr != '\\')) {
-            *qtr++ = *ptr++;
+          if (qtr == ptr) {
+            // no escaped quote so far, scan without copying
+            while (ptr < parser->_stop && *ptr != parser->_quote &&
+                   (!parser->_useBackslash || *ptr != '\\')) {
+              ++ptr;
+            }
+            qtr = ptr;
+          } else {
+            while (ptr < parser->_stop && *ptr != parser->_quote &&
+                   (!parser->_useBackslash || *ptr != '\\')) {
+              *qtr++ = *ptr++;
+            }
           }
 
           // found quote or a backslash, need at least another quote, a
@@ -28,6 +28,7 @@
 #include <string.h>
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <time.h>
 #include <algorithm>
 #include <chrono>
 #include <memory>
@@ -837,6 +838,21 @@ ProcessInfo TRI_ProcessInfo(TRI_pid_t pid) {
 
 #endif
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief returns the CPU time consumed by the calling thread
+////////////////////////////////////////////////////////////////////////////////
+
+uint64_t TRI_ThreadCpuTime() noexcept {
+#ifdef CLOCK_THREAD_CPUTIME_ID
+  struct timespec ts;
+  if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) == 0) {
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000ULL +
+           static_cast<uint64_t>(ts.tv_nsec) / 1000ULL;
+  }
+#endif
+  return 0;
+}
+
 /// @brief returns information about the process
 #ifdef TRI_HAVE_LINUX_PROC
 
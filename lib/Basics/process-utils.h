@@ -150,6 +150,13 @@ uint64_t TRI_MicrosecondsTv(struct timeval* tv);
 
 ProcessInfo TRI_ProcessInfoSelf();
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief returns the CPU time consumed by the calling thread, in
+/// microseconds. returns 0 if this is not supported on the platform
+////////////////////////////////////////////////////////////////////////////////
+
+uint64_t TRI_ThreadCpuTime() noexcept;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief returns information about the process
 ////////////////////////////////////////////////////////////////////////////////
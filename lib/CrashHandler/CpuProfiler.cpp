@@ -0,0 +1,378 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "CpuProfiler.h"
+
+#include "Basics/debugging.h"
+#include "Basics/operating-system.h"
+#include "Basics/voc-errors.h"
+
+#if defined(__linux__) && defined(ARANGODB_HAVE_LIBUNWIND)
+#define ARANGODB_HAVE_CPU_PROFILER 1
+#endif
+
+#ifdef ARANGODB_HAVE_CPU_PROFILER
+#define UNW_LOCAL_ONLY
+#include <libunwind.h>
+
+#include <pthread.h>
+#include <signal.h>
+#include <sys/prctl.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#ifndef sigev_notify_thread_id
+#define sigev_notify_thread_id _sigev_un._tid
+#endif
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <boost/core/demangle.hpp>
+
+using namespace arangodb;
+
+#ifdef ARANGODB_HAVE_CPU_PROFILER
+namespace {
+
+struct Sample {
+  // name of the sampled thread, as set via prctl(PR_SET_NAME)
+  char threadName[16];
+  std::uint32_t numFrames;
+  // innermost frame first
+  void* frames[CpuProfiler::maxFrames];
+};
+
+// frames of the signal handler itself and of the signal trampoline, which
+// are on top of every recorded stack
+constexpr int skipFrames = 2;
+
+// whether a profile is currently being taken
+std::atomic<bool> profiling{false};
+// whether the signal handler has been installed. the handler is never
+// uninstalled, because the default action for a late SIGPROF would be to
+// terminate the process
+bool handlerInstalled = false;
+// owns the buffer for samples between start() and stop()
+std::unique_ptr<Sample[]> sampleBuffer;
+
+struct RegisteredThread {
+  pthread_t thread;
+  pid_t tid;
+  // CPU time timer of the thread, only valid while hasTimer is set
+  timer_t timer;
+  bool hasTimer = false;
+};
+
+// protects registeredThreads and timerFrequency
+std::mutex registryMutex;
+// all threads that may be sampled, by kernel thread id
+std::unordered_map<pid_t, RegisteredThread> registeredThreads;
+// frequency of the timers while sampling, 0 otherwise
+std::uint32_t timerFrequency = 0;
+
+// buffer for samples, set only while sampling
+std::atomic<Sample*> samples{nullptr};
+// index of the next sample slot to use
+std::atomic<std::size_t> nextSample{0};
+// number of signal handler invocations currently accessing samples
+std::atomic<std::size_t> activeHandlers{0};
+
+void profileSignalHandler(int /*signal*/, siginfo_t* /*info*/,
+                          void* /*context*/) {
+  int savedErrno = errno;
+
+  // must be sequentially consistent with the store of nullptr into samples
+  // and the check for activeHandlers in stopSampling()
+  activeHandlers.fetch_add(1);
+  Sample* buffer = samples.load();
+  if (buffer != nullptr) {
+    std::size_t index = nextSample.fetch_add(1, std::memory_order_relaxed);
+    if (index < CpuProfiler::maxSamples) {
+      Sample& sample = buffer[index];
+      sample.threadName[0] = '\0';
+      prctl(PR_GET_NAME, &sample.threadName[0], 0, 0, 0);
+      sample.threadName[sizeof(sample.threadName) - 1] = '\0';
+
+      void* frames[CpuProfiler::maxFrames + skipFrames];
+      int n = unw_backtrace(&frames[0], CpuProfiler::maxFrames + skipFrames);
+      n = std::max(n - skipFrames, 0);
+      std::memcpy(&sample.frames[0], &frames[skipFrames], n * sizeof(void*));
+      sample.numFrames = static_cast<std::uint32_t>(n);
+    }
+  }
+  activeHandlers.fetch_sub(1, std::memory_order_release);
+
+  errno = savedErrno;
+}
+
+bool installSignalHandler() {
+  if (handlerInstalled) {
+    return true;
+  }
+  struct sigaction action;
+  memset(&action, 0, sizeof(action));
+  sigfillset(&action.sa_mask);
+  // restart interrupted system calls, so that sampling does not change the
+  // behavior of the sampled threads
+  action.sa_flags = SA_SIGINFO | SA_RESTART;
+  action.sa_sigaction = profileSignalHandler;
+  handlerInstalled = (sigaction(SIGPROF, &action, nullptr) == 0);
+  return handlerInstalled;
+}
+
+// starts a timer that raises SIGPROF in the thread after every interval of
+// CPU time the thread consumed. requires registryMutex
+bool startTimer(RegisteredThread& entry, std::uint32_t frequency) {
+  TRI_ASSERT(!entry.hasTimer);
+  clockid_t clock;
+  if (pthread_getcpuclockid(entry.thread, &clock) != 0) {
+    return false;
+  }
+
+  struct sigevent event;
+  memset(&event, 0, sizeof(event));
+  // deliver the signal to the sampled thread only
+  event.sigev_notify = SIGEV_THREAD_ID;
+  event.sigev_signo = SIGPROF;
+  event.sigev_notify_thread_id = entry.tid;
+  if (timer_create(clock, &event, &entry.timer) != 0) {
+    return false;
+  }
+
+  struct itimerspec spec;
+  memset(&spec, 0, sizeof(spec));
+  spec.it_interval.tv_nsec = 1000000000L / frequency;
+  spec.it_value = spec.it_interval;
+  if (timer_settime(entry.timer, 0, &spec, nullptr) != 0) {
+    timer_delete(entry.timer);
+    return false;
+  }
+  entry.hasTimer = true;
+  return true;
+}
+
+// requires registryMutex
+void stopTimer(RegisteredThread& entry) {
+  if (entry.hasTimer) {
+    timer_delete(entry.timer);
+    entry.hasTimer = false;
+  }
+}
+
+void setProfileSignalBlocked(bool blocked) {
+  sigset_t set;
+  sigemptyset(&set);
+  sigaddset(&set, SIGPROF);
+  pthread_sigmask(blocked ? SIG_BLOCK : SIG_UNBLOCK, &set, nullptr);
+}
+
+std::size_t stopSampling() {
+  {
+    std::lock_guard<std::mutex> guard(registryMutex);
+    timerFrequency = 0;
+    for (auto& [tid, entry] : registeredThreads) {
+      stopTimer(entry);
+    }
+  }
+  samples.store(nullptr);
+  // wait until no signal handler accesses the buffer anymore
+  while (activeHandlers.load(std::memory_order_acquire) > 0) {
+    std::this_thread::yield();
+  }
+  return std::min(nextSample.load(), CpuProfiler::maxSamples);
+}
+
+// returns the (demangled) name of the function containing the address
+std::string symbolize(unw_word_t address) {
+  char mangled[512];
+  unw_word_t offset = 0;
+  std::string name;
+  if (unw_get_proc_name_by_ip(unw_local_addr_space, address, &mangled[0],
+                              sizeof(mangled) - 1, &offset, nullptr) == 0) {
+    mangled[sizeof(mangled) - 1] = '\0';
+    name = boost::core::demangle(&mangled[0]);
+  } else {
+    char buffer[32];
+    snprintf(&buffer[0], sizeof(buffer), "0x%llx",
+             static_cast<unsigned long long>(address));
+    name = &buffer[0];
+  }
+  // ';' separates the frames in the folded stack format
+  std::replace(name.begin(), name.end(), ';', ':');
+  return name;
+}
+
+void buildFoldedStacks(Sample const* buffer, std::size_t numSamples,
+                       std::string& result) {
+  std::unordered_map<unw_word_t, std::string> names;
+  std::unordered_map<std::string, std::uint64_t> stacks;
+
+  std::string stack;
+  for (std::size_t i = 0; i < numSamples; ++i) {
+    Sample const& sample = buffer[i];
+    stack.assign(sample.threadName[0] != '\0' ? &sample.threadName[0]
+                                              : "unknown");
+    // outermost frame first
+    for (std::uint32_t f = sample.numFrames; f > 0; --f) {
+      auto address = reinterpret_cast<unw_word_t>(sample.frames[f - 1]);
+      if (f > 1 && address > 0) {
+        // all frames except the innermost one contain return addresses,
+        // which may already belong to the next function
+        --address;
+      }
+      auto it = names.find(address);
+      if (it == names.end()) {
+        it = names.emplace(address, symbolize(address)).first;
+      }
+      stack.push_back(';');
+      stack.append(it->second);
+    }
+    ++stacks[stack];
+  }
+
+  std::vector<std::pair<std::string const*, std::uint64_t>> sorted;
+  sorted.reserve(stacks.size());
+  for (auto const& [s, count] : stacks) {
+    sorted.emplace_back(&s, count);
+  }
+  std::sort(sorted.begin(), sorted.end(), [](auto const& a, auto const& b) {
+    return a.second > b.second;
+  });
+
+  for (auto const& [s, count] : sorted) {
+    result.append(*s).push_back(' ');
+    result.append(std::to_string(count)).push_back('\n');
+  }
+}
+
+}  // namespace
+#endif
+
+void CpuProfiler::registerThread() noexcept {
+#ifdef ARANGODB_HAVE_CPU_PROFILER
+  try {
+    RegisteredThread entry;
+    entry.thread = pthread_self();
+    entry.tid = static_cast<pid_t>(syscall(SYS_gettid));
+
+    std::lock_guard<std::mutex> guard(registryMutex);
+    auto [it, inserted] = registeredThreads.emplace(entry.tid, entry);
+    TRI_ASSERT(inserted);
+    if (timerFrequency > 0) {
+      // a profile is being taken. sample this thread as well
+      startTimer(it->second, timerFrequency);
+    }
+  } catch (...) {
+    // out of memory. the thread is simply not sampled
+    return;
+  }
+  setProfileSignalBlocked(false);
+#endif
+}
+
+void CpuProfiler::unregisterThread() noexcept {
+#ifdef ARANGODB_HAVE_CPU_PROFILER
+  // a signal that is still pending stays pending, and is discarded when the
+  // thread exits
+  setProfileSignalBlocked(true);
+
+  auto tid = static_cast<pid_t>(syscall(SYS_gettid));
+  std::lock_guard<std::mutex> guard(registryMutex);
+  auto it = registeredThreads.find(tid);
+  if (it != registeredThreads.end()) {
+    stopTimer(it->second);
+    registeredThreads.erase(it);
+  }
+#endif
+}
+
+ErrorCode CpuProfiler::start(std::uint32_t frequency) {
+#ifdef ARANGODB_HAVE_CPU_PROFILER
+  if (profiling.exchange(true)) {
+    return TRI_ERROR_LOCKED;
+  }
+
+  try {
+    sampleBuffer = std::make_unique<Sample[]>(maxSamples);
+  } catch (...) {
+    profiling.store(false);
+    return TRI_ERROR_OUT_OF_MEMORY;
+  }
+
+  if (!installSignalHandler()) {
+    sampleBuffer.reset();
+    profiling.store(false);
+    return TRI_ERROR_SYS_ERROR;
+  }
+
+  nextSample.store(0);
+  samples.store(sampleBuffer.get());
+
+  frequency = std::clamp<std::uint32_t>(frequency, 1, 1000);
+  bool ok = true;
+  {
+    std::lock_guard<std::mutex> guard(registryMutex);
+    timerFrequency = frequency;
+    for (auto& [tid, entry] : registeredThreads) {
+      ok &= startTimer(entry, frequency);
+    }
+  }
+
+  if (!ok) {
+    stopSampling();
+    sampleBuffer.reset();
+    profiling.store(false);
+    return TRI_ERROR_SYS_ERROR;
+  }
+  return TRI_ERROR_NO_ERROR;
+#else
+  return TRI_ERROR_NOT_IMPLEMENTED;
+#endif
+}
+
+void CpuProfiler::stop(std::string& result) {
+  result.clear();
+#ifdef ARANGODB_HAVE_CPU_PROFILER
+  TRI_ASSERT(profiling.load());
+  std::size_t numSamples = stopSampling();
+
+  // reset flag when leaving
+  struct ProfilingGuard {
+    ~ProfilingGuard() {
+      sampleBuffer.reset();
+      profiling.store(false);
+    }
+  } guard;
+
+  buildFoldedStacks(sampleBuffer.get(), numSamples, result);
+#endif
+}
@@ -0,0 +1,71 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Basics/ErrorCode.h"
+
+#include <cstdint>
+#include <string>
+
+namespace arangodb {
+
+/// @brief sampling CPU profiler for the current process.
+/// Only threads that have registered themselves via registerThread() are
+/// sampled. All other threads keep SIGPROF blocked. While a profile is
+/// taken, every registered thread has its own CPU time timer, which raises
+/// SIGPROF in that thread after every interval of CPU time it consumed. The
+/// signal handler records the stack of the thread together with the
+/// thread's name, so the samples are distributed across threads in
+/// proportion to their CPU usage. Stacks are symbolized only after sampling
+/// has finished. Only available on Linux with libunwind.
+class CpuProfiler {
+ public:
+  /// @brief maximum number of stack frames recorded per sample
+  static constexpr std::size_t maxFrames = 64;
+  /// @brief maximum number of samples recorded per profile. further samples
+  /// are dropped
+  static constexpr std::size_t maxSamples = 32768;
+
+  /// @brief allows sampling of the calling thread, and unblocks SIGPROF for
+  /// it. must be called by the thread itself, and be followed by a call to
+  /// unregisterThread() before the thread exits
+  static void registerThread() noexcept;
+
+  /// @brief stops sampling of the calling thread, and blocks SIGPROF for it
+  static void unregisterThread() noexcept;
+
+  /// @brief starts sampling all registered threads with the given frequency
+  /// (in samples per second of CPU time, at most 1000). threads that
+  /// register while sampling are sampled as well. does not block. every
+  /// successful call must be followed by a call to stop().
+  /// returns TRI_ERROR_NOT_IMPLEMENTED if profiling is not supported on this
+  /// platform, and TRI_ERROR_LOCKED if a profile is already being taken.
+  static ErrorCode start(std::uint32_t frequency);
+
+  /// @brief stops sampling. result is set to the profile in folded stack
+  /// format, i.e. one line per distinct stack, with the thread name and the
+  /// frames separated by semicolons, followed by the number of samples for
+  /// the stack.
+  static void stop(std::string& result);
+};
+
+}  // namespace arangodb
@@ -0,0 +1,172 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#if defined(_LIBCPP_VERSION) && _LIBCPP_VERSION < 14000
+#include <experimental/coroutine>
+namespace std_coro = std::experimental;
+#else
+#include <coroutine>
+namespace std_coro = std;
+#endif
+
+#include <atomic>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include "Futures/Future.h"
+#include "Futures/Promise.h"
+#include "Futures/Try.h"
+
+/// Coroutine support for futures: a function returning a Future<T> can be a
+/// coroutine, and a Future<T> can be awaited with co_await.
+///
+/// Awaiting a future that is already fulfilled does not suspend the
+/// coroutine at all, and does not install a callback. Otherwise the
+/// coroutine is resumed by the thread that fulfills the future. If that
+/// happens while the callback is being installed, the coroutine is resumed
+/// by returning from await_suspend instead of calling resume() from within
+/// it, so that chains of already fulfilled futures do not grow the stack.
+
+namespace arangodb::futures {
+
+namespace detail {
+
+/// @brief the common part of all future awaitables. Derived classes provide
+/// `onResult(Try<T>&&) noexcept`, which stores the result for await_resume.
+template<typename T, typename Derived>
+struct FutureAwaitableBase {
+  explicit FutureAwaitableBase(Future<T> fut) : _future(std::move(fut)) {}
+
+  [[nodiscard]] bool await_ready() noexcept {
+    if (_future.isReady()) {
+      self().onResult(std::move(_future).result());
+      return true;
+    }
+    return false;
+  }
+
+  bool await_suspend(std_coro::coroutine_handle<> coro) noexcept {
+    _coro = coro;
+    std::move(_future).thenFinal([this](Try<T>&& result) noexcept {
+      self().onResult(std::move(result));
+      // whoever comes second resumes the coroutine
+      if (_done.exchange(true, std::memory_order_acq_rel)) {
+        _coro.resume();
+      }
+    });
+    // if the callback has run already, continue right away
+    return !_done.exchange(true, std::memory_order_acq_rel);
+  }
+
+ private:
+  Derived& self() noexcept { return static_cast<Derived&>(*this); }
+
+  Future<T> _future;
+  std_coro::coroutine_handle<> _coro;
+  std::atomic<bool> _done{false};
+};
+
+}  // namespace detail
+
+template<typename T>
+struct FutureAwaitable
+    : detail::FutureAwaitableBase<T, FutureAwaitable<T>> {
+  explicit FutureAwaitable(Future<T> fut)
+      : detail::FutureAwaitableBase<T, FutureAwaitable<T>>(std::move(fut)) {}
+
+  void onResult(Try<T>&& result) noexcept {
+    _result.emplace(std::move(result));
+  }
+  auto await_resume() -> T { return std::move(_result.value().get()); }
+
+ private:
+  std::optional<Try<T>> _result;
+};
+
+template<typename T>
+auto operator co_await(Future<T>&& f) noexcept {
+  return FutureAwaitable<T>{std::move(f)};
+}
+
+template<typename T, typename F>
+struct FutureTransformAwaitable
+    : F,
+      detail::FutureAwaitableBase<T, FutureTransformAwaitable<T, F>> {
+  using ResultType = std::invoke_result_t<F, Try<T>&&>;
+
+  explicit FutureTransformAwaitable(Future<T> fut, F&& f)
+      : F(std::forward<F>(f)),
+        detail::FutureAwaitableBase<T, FutureTransformAwaitable<T, F>>(
+            std::move(fut)) {}
+
+  void onResult(Try<T>&& result) noexcept {
+    _result.emplace(F::operator()(std::move(result)));
+  }
+  auto await_resume() noexcept -> ResultType {
+    return std::move(_result.value());
+  }
+
+ private:
+  static_assert(std::is_nothrow_invocable_v<F, Try<T>&&>);
+  std::optional<ResultType> _result;
+};
+
+/// @brief await the future, and get its Try instead of its value. Does not
+/// throw.
+template<typename T>
+auto asTry(Future<T>&& f) noexcept {
+  return FutureTransformAwaitable{
+      std::move(f), [](Try<T>&& res) noexcept { return std::move(res); }};
+}
+
+}  // namespace arangodb::futures
+
+template<typename T, typename... Args>
+struct std_coro::coroutine_traits<arangodb::futures::Future<T>, Args...> {
+  struct promise_type {
+    arangodb::futures::Promise<T> promise;
+
+    auto initial_suspend() noexcept { return std_coro::suspend_never{}; }
+    auto final_suspend() noexcept { return std_coro::suspend_never{}; }
+
+    auto get_return_object() -> arangodb::futures::Future<T> {
+      return promise.getFuture();
+    }
+
+    auto return_value(T const& t) noexcept(
+        std::is_nothrow_copy_constructible_v<T>) {
+      static_assert(std::is_copy_constructible_v<T>);
+      promise.setValue(t);
+    }
+
+    auto return_value(T&& t) noexcept(std::is_nothrow_move_constructible_v<T>) {
+      static_assert(std::is_move_constructible_v<T>);
+      promise.setValue(std::move(t));
+    }
+
+    auto unhandled_exception() noexcept {
+      promise.setException(std::current_exception());
+    }
+  };
+};
@@ -24,7 +24,9 @@
 #pragma once
 
 #include <atomic>
+#include <cstddef>
 #include <function2.hpp>
+#include <type_traits>
 
 #include "Assertions/Assert.h"
 
@@ -152,10 +154,23 @@ class SharedState {
   void setCallback(F&& func) {
     TRI_ASSERT(!hasCallback());
 
-    // construct _callback first; TODO maybe try to avoid this?
+    auto state = _state.load(std::memory_order_acquire);
+    if (state == State::OnlyResult) {
+      // the result is there already, and only the consumer can leave this
+      // state. call func directly, without storing it in _callback
+      _state.store(State::Done, std::memory_order_relaxed);
+      _attached.fetch_add(1);
+      // SharedStateScope makes this exception safe
+      SharedStateScope scope(this);  // will call detachOne()
+      // destroyed before the scope, like _callback would be
+      std::decay_t<F> callback(std::forward<F>(func));
+      callback(std::move(_result));
+      return;
+    }
+
+    // construct _callback first, setResult() may call it right away
     _callback = std::forward<F>(func);
 
-    auto state = _state.load(std::memory_order_acquire);
     switch (state) {
       case State::Start:
         if (_state.compare_exchange_strong(state, State::OnlyCallback,
@@ -272,7 +287,15 @@ class SharedState {
   }
 
  private:
-  using Callback = fu2::unique_function<void(Try<T>&&)>;
+  /// @brief inline storage for callbacks, large enough for the callbacks
+  /// Future::then() and friends create for most continuations (a functor and
+  /// a Promise). Larger callbacks are allocated on the heap.
+  static constexpr std::size_t kCallbackCapacity = 6 * sizeof(void*);
+
+  // unique_function, but with more inline storage
+  using Callback =
+      fu2::function_base<true, false, fu2::capacity_fixed<kCallbackCapacity>,
+                         true, false, void(Try<T>&&)>;
   Callback _callback;
   union {  // avoids having to construct the result
     Try<T> _result;
@@ -23,6 +23,7 @@
 
 #include "Utils.h"
 
+#include <iterator>
 #include <vector>
 
 #include <s2/s2latlng.h>
@@ -121,6 +122,20 @@ void scanIntervals(QueryParams const& params,
   // sort these disjunctive intervals
   std::sort(sortedIntervals.begin(), sortedIntervals.end(), Interval::compare);
 
+  // merge intervals which are directly adjacent in the id space, so that
+  // they can be scanned with a single seek. this is e.g. the case for the
+  // ranges of two adjacent child cells and the exact id of their parent,
+  // which lies in between
+  auto last = sortedIntervals.begin();
+  for (auto it = std::next(last); it != sortedIntervals.end(); ++it) {
+    if (last->range_max.id() + 1 == it->range_min.id()) {
+      last->range_max = it->range_max;
+    } else {
+      *(++last) = *it;
+    }
+  }
+  sortedIntervals.erase(std::next(last), sortedIntervals.end());
+
 #ifdef ARANGODB_ENABLE_MAINTAINER_MODE
   //  constexpr size_t diff = 64;
   for (size_t i = 0; i < sortedIntervals.size() - 1; i++) {
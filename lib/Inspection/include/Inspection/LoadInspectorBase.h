@@ -23,6 +23,8 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cstddef>
 #include <memory>
 #include <optional>
 #include <string>
@@ -30,6 +32,7 @@
 #include <tuple>
 #include <type_traits>
 #include <variant>
+#include <vector>
 
 #include "Inspection/InspectorBase.h"
 #include "Inspection/Factory.h"
@@ -162,9 +165,10 @@ struct LoadInspectorBase : InspectorBase<Derived, Context> {
 
     auto result = parseFields(fields, std::forward<Args>(args)...);
     if (result.ok() && !_options.ignoreUnknownFields) {
-      for (auto& [k, v] : fields) {
-        if (!v.second) {
-          return {"Found unexpected attribute '" + std::string(k) + "'"};
+      for (auto it = fields.begin(); it != fields.end(); ++it) {
+        if (!it->second.second && !fields.isProcessedDuplicate(it)) {
+          return {"Found unexpected attribute '" + std::string(it->first) +
+                  "'"};
         }
       }
     }
@@ -184,8 +188,54 @@ struct LoadInspectorBase : InspectorBase<Derived, Context> {
   }
 
  protected:
-  using FieldsMap =
-      std::unordered_map<std::string_view, std::pair<ValueType, bool>>;
+  // The attributes of the object being loaded, in the order of the object.
+  // Objects usually have only a few attributes, stored in the order in which
+  // their fields are inspected. So instead of building a hash table for every
+  // loaded object, attributes are looked up by a linear search that starts
+  // after the previously found attribute, which typically finds the next
+  // field right away.
+  class FieldsMap {
+   public:
+    using Entry = std::pair<std::string_view, std::pair<ValueType, bool>>;
+    using iterator = typename std::vector<Entry>::iterator;
+
+    void emplace(std::string_view key, std::pair<ValueType, bool>&& value) {
+      _entries.emplace_back(key, std::move(value));
+    }
+
+    iterator begin() noexcept { return _entries.begin(); }
+    iterator end() noexcept { return _entries.end(); }
+
+    iterator find(std::string_view key) noexcept {
+      std::size_t const size = _entries.size();
+      std::size_t pos = _next;
+      for (std::size_t i = 0; i < size; ++i, ++pos) {
+        if (pos >= size) {
+          pos = 0;
+        }
+        if (_entries[pos].first == key) {
+          _next = pos + 1;
+          return _entries.begin() + pos;
+        }
+      }
+      return _entries.end();
+    }
+
+    // whether another attribute with the same name as the given one has been
+    // processed, i.e. the given one is a duplicate of a known attribute
+    bool isProcessedDuplicate(iterator it) const noexcept {
+      return std::any_of(_entries.begin(), _entries.end(),
+                         [&](Entry const& other) {
+                           return other.second.second &&
+                                  other.first == it->first;
+                         });
+    }
+
+   private:
+    std::vector<Entry> _entries;
+    // position at which the next search starts
+    std::size_t _next = 0;
+  };
 
   using EmbeddedParam = FieldsMap;
 
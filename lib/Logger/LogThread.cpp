@@ -24,13 +24,16 @@
 #include "LogThread.h"
 #include "Basics/debugging.h"
 #include "Logger/LogAppender.h"
+#include "Logger/LogMacros.h"
 #include "Logger/Logger.h"
 
 using namespace arangodb;
 
 LogThread::LogThread(application_features::ApplicationServer& server,
-                     std::string const& name)
-    : Thread(server, name), _messages(64) {}
+                     std::string const& name, std::size_t maxQueuedMessages)
+    : Thread(server, name),
+      _messages(64),
+      _maxQueuedMessages(maxQueuedMessages) {}
 
 LogThread::~LogThread() {
   Logger::_active = false;
@@ -50,7 +53,22 @@ bool LogThread::log(LogGroup& group, std::unique_ptr<LogMessage>& message) {
       (message->_level == LogLevel::FATAL || message->_level == LogLevel::ERR ||
        message->_level == LogLevel::WARN);
 
+  auto queued = _numQueuedMessages.fetch_add(1, std::memory_order_relaxed);
+  if (_maxQueuedMessages != 0 && queued >= _maxQueuedMessages) {
+    _numQueuedMessages.fetch_sub(1, std::memory_order_relaxed);
+    if (isDirectLogLevel || &group != &Logger::defaultLogGroup()) {
+      // warnings and errors as well as messages of other log groups (e.g.
+      // the audit log) are never dropped. the caller writes them directly
+      return false;
+    }
+    // the log thread cannot keep up. drop the message, so that threads
+    // which log a lot are not slowed down any further
+    _numDroppedMessages.fetch_add(1, std::memory_order_relaxed);
+    return true;
+  }
+
   if (!_messages.push({&group, message.get()})) {
+    _numQueuedMessages.fetch_sub(1, std::memory_order_relaxed);
     return false;
   }
 
@@ -105,6 +123,7 @@ bool LogThread::processPendingMessages() {
   MessageEnvelope env{nullptr, nullptr};
 
   while (_messages.pop(env)) {
+    _numQueuedMessages.fetch_sub(1, std::memory_order_relaxed);
     worked = true;
     TRI_ASSERT(env.group != nullptr);
     TRI_ASSERT(env.msg != nullptr);
@@ -115,5 +134,14 @@ bool LogThread::processPendingMessages() {
 
     delete env.msg;
   }
+
+  if (auto dropped = _numDroppedMessages.exchange(0, std::memory_order_relaxed);
+      dropped > 0) {
+    LOG_TOPIC("4c1e7", WARN, Logger::FIXME)
+        << "dropped " << dropped
+        << " log message(s) because the logging queue was full. you may "
+           "want to reduce the log levels or increase the value of "
+           "--log.max-queued-entries";
+  }
   return worked;
 }
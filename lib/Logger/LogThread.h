@@ -28,6 +28,10 @@
 
 #include <boost/lockfree/queue.hpp>
 
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
 namespace arangodb {
 class LogGroup;
 namespace application_features {
@@ -46,8 +50,11 @@ class LogThread final : public Thread {
   };
 
  public:
-  explicit LogThread(application_features::ApplicationServer& server,
-                     std::string const& name);
+  /// @brief maxQueuedMessages is the number of queued messages above which
+  /// messages of the default log group with a level below WARN are dropped
+  /// (0 = unlimited)
+  LogThread(application_features::ApplicationServer& server,
+            std::string const& name, std::size_t maxQueuedMessages);
   ~LogThread();
 
  public:
@@ -71,5 +78,10 @@ class LogThread final : public Thread {
  private:
   arangodb::basics::ConditionVariable _condition;
   boost::lockfree::queue<MessageEnvelope> _messages;
+  std::size_t const _maxQueuedMessages;
+  /// @brief number of messages in _messages
+  std::atomic<std::size_t> _numQueuedMessages{0};
+  /// @brief number of messages dropped since the last report
+  std::atomic<std::uint64_t> _numDroppedMessages{0};
 };
 }  // namespace arangodb
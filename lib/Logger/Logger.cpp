@@ -133,6 +133,7 @@ bool Logger::_keepLogRotate(false);
 bool Logger::_logRequestParameters(true);
 bool Logger::_showRole(false);
 bool Logger::_useJson(false);
+std::size_t Logger::_maxQueuedLogMessages(10000);
 char Logger::_role('\0');
 std::atomic<TRI_pid_t> Logger::_cachedPid(0);
 std::string Logger::_outputPrefix;
@@ -465,6 +466,16 @@ void Logger::setUseJson(bool value) {
   _useJson = value;
 }
 
+// NOTE: this function should not be called if the logging is active.
+void Logger::setMaxQueuedLogMessages(std::size_t value) {
+  if (_active) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(
+        TRI_ERROR_INTERNAL, "cannot change settings once logging is active");
+  }
+
+  _maxQueuedLogMessages = value;
+}
+
 bool Logger::translateLogLevel(std::string const& l, bool isGeneral,
                                LogLevel& level) noexcept {
   if (l == "fatal") {
@@ -896,7 +907,8 @@ void Logger::initialize(application_features::ApplicationServer& server,
   // logging is now active
   if (threaded) {
     auto loggingThread =
-        std::make_unique<LogThread>(server, std::string(logThreadName));
+        std::make_unique<LogThread>(server, std::string(logThreadName),
+                                    _maxQueuedLogMessages);
     if (!loggingThread->start()) {
       LOG_TOPIC("28bd9", FATAL, arangodb::Logger::FIXME)
           << "could not start logging thread";
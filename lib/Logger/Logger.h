@@ -275,6 +275,7 @@ class Logger {
   static void setLogRequestParameters(bool);
   static bool logRequestParameters() { return _logRequestParameters; }
   static void setUseJson(bool);
+  static void setMaxQueuedLogMessages(std::size_t);
   static LogTimeFormats::TimeFormat timeFormat() { return _timeFormat; }
 
   // can be called after fork()
@@ -333,6 +334,7 @@ class Logger {
   static bool _logRequestParameters;
   static bool _showIds;
   static bool _useJson;
+  static std::size_t _maxQueuedLogMessages;
   static char _role;  // current server role to log
   static std::atomic<TRI_pid_t> _cachedPid;
   static std::string _outputPrefix;
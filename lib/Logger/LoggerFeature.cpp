@@ -325,6 +325,26 @@ The default value is 128 MB, which is very high and should effectively mean
 downwards-compatibility with previous arangod versions, which did not restrict
 the maximum size of log messages.)");
 
+  options
+      ->addOption("--log.max-queued-entries",
+                  "The maximum number of log messages to queue for the "
+                  "logging thread before dropping messages below the "
+                  "warning level (0 = unlimited).",
+                  new UInt32Parameter(&_maxQueuedLogMessages),
+                  arangodb::options::makeDefaultFlags(
+                      arangodb::options::Flags::Uncommon))
+      .setIntroducedIn(31200)
+      .setLongDescription(R"(Log messages are handed off to an extra logging
+thread, which writes them asynchronously. If messages are logged faster than
+the logging thread can write them, e.g. because of very verbose log levels,
+the queue of pending messages grows.
+
+Once this many messages are queued, new messages with the `info`, `debug` or
+`trace` level are dropped, so that the threads which log them are not slowed
+down any further. Messages with the `warning`, `error` or `fatal` level are
+never dropped, but are written directly by the thread that logs them. The
+logging thread reports the number of dropped messages with a warning.)");
+
   options
       ->addOption("--log.use-local-time",
                   "Use the local timezone instead of UTC.",
@@ -717,6 +737,7 @@ void LoggerFeature::prepare() {
   Logger::setKeepLogrotate(_keepLogRotate);
   Logger::setLogRequestParameters(_logRequestParameters);
   Logger::setUseJson(_useJson);
+  Logger::setMaxQueuedLogMessages(_maxQueuedLogMessages);
 
   for (auto const& definition : _output) {
     if (_supervisor && definition.starts_with("file://")) {
@@ -36,6 +36,9 @@
 #include <velocypack/Parser.h>
 #include <velocypack/Validator.h>
 
+#include <algorithm>
+#include <string_view>
+
 using namespace arangodb;
 using namespace arangodb::basics;
 
@@ -68,6 +71,80 @@ std::string urlDecode(char const* begin, char const* end) {
 
   return out;
 }
+
+std::string_view trimWhitespace(std::string_view value) {
+  while (!value.empty() && (value.front() == ' ' || value.front() == '\t')) {
+    value.remove_prefix(1);
+  }
+  while (!value.empty() && (value.back() == ' ' || value.back() == '\t')) {
+    value.remove_suffix(1);
+  }
+  return value;
+}
+
+// parses an HTTP quality value, e.g. "0.5", into thousandths. invalid values
+// are treated as 0, i.e. not acceptable
+unsigned parseQuality(std::string_view value) {
+  if (value.empty() || value[0] < '0' || value[0] > '1') {
+    return 0;
+  }
+  unsigned result = (value[0] - '0') * 1000;
+  if (value.size() > 1 && value[1] == '.') {
+    unsigned scale = 100;
+    for (size_t i = 2; i < value.size() && scale > 0; ++i, scale /= 10) {
+      if (value[i] < '0' || value[i] > '9') {
+        break;
+      }
+      result += (value[i] - '0') * scale;
+    }
+  }
+  return std::min(result, 1000U);
+}
+
+// determines the preferred response encoding from an Accept-Encoding header
+// value such as "gzip, deflate;q=0.5". gzip is preferred over deflate if
+// both are accepted with the same quality
+rest::EncodingType parseAcceptEncoding(std::string_view value) {
+  rest::EncodingType result = rest::EncodingType::UNSET;
+  unsigned bestQuality = 0;
+
+  while (!value.empty()) {
+    size_t comma = value.find(',');
+    std::string_view item = value.substr(0, comma);
+    value = comma == std::string_view::npos ? std::string_view()
+                                            : value.substr(comma + 1);
+
+    size_t semicolon = item.find(';');
+    std::string_view name = trimWhitespace(item.substr(0, semicolon));
+    unsigned quality = 1000;
+    if (semicolon != std::string_view::npos) {
+      std::string_view param = trimWhitespace(item.substr(semicolon + 1));
+      if (param.size() >= 2 && (param[0] == 'q' || param[0] == 'Q') &&
+          param[1] == '=') {
+        quality = parseQuality(param.substr(2));
+      }
+    }
+
+    rest::EncodingType type;
+    if (StringUtils::equalStringsCaseInsensitive(
+            name, std::string_view(StaticStrings::EncodingGzip))) {
+      type = rest::EncodingType::GZIP;
+    } else if (StringUtils::equalStringsCaseInsensitive(
+                   name, std::string_view(StaticStrings::EncodingDeflate))) {
+      type = rest::EncodingType::DEFLATE;
+    } else {
+      continue;
+    }
+
+    if (quality > bestQuality ||
+        (quality == bestQuality && quality > 0 &&
+         type == rest::EncodingType::GZIP)) {
+      result = type;
+      bestQuality = quality;
+    }
+  }
+  return result;
+}
 }  // namespace
 
 HttpRequest::HttpRequest(ConnectionInfo const& connectionInfo, uint64_t mid)
@@ -603,15 +680,10 @@ void HttpRequest::setHeader(std::string key, std::string value) {
       return;
     }
   } else if (key == StaticStrings::AcceptEncoding) {
-    // This can be much more elaborated as the can specify weights on encodings
-    // However, for now just toggle on deflate if deflate is requested
-    if (StaticStrings::EncodingDeflate == value) {
-      // FXIME: cannot use substring search, Java driver chokes on deflated
-      // response
-      _acceptEncoding = EncodingType::DEFLATE;
-    } else if (StaticStrings::EncodingGzip == value) {
-      _acceptEncoding = EncodingType::GZIP;
-    }
+    // a list of encodings, possibly with weights. deflate is only used if
+    // gzip is not accepted at least as much, as some drivers advertise
+    // deflate but cannot handle deflated responses
+    _acceptEncoding = parseAcceptEncoding(value);
   } else if (key == "cookie") {
     parseCookies(value.c_str(), value.size());
     return;
@@ -886,9 +958,14 @@ VPackSlice HttpRequest::payload(bool strictValidation) {
       if (!_vpackBuilder) {
         TRI_ASSERT(!_validatedPayload);
         VPackOptions const* options = validationOptions(strictValidation);
-        VPackParser parser(options);
+        // the VPack representation of a JSON body is hardly ever larger than
+        // the JSON itself. reserving the JSON size upfront saves repeated
+        // reallocations and copies of the builder's buffer for large bodies
+        auto builder = std::make_shared<VPackBuilder>(options);
+        builder->reserve(_payload.size());
+        VPackParser parser(builder, options);
         parser.parse(_payload.data(), _payload.size());
-        _vpackBuilder = parser.steal();
+        _vpackBuilder = std::move(builder);
         _validatedPayload = true;
         _memoryUsage += _vpackBuilder->bufferRef().size();
       }
@@ -398,6 +398,9 @@ void HttpResponse::addPayloadInternal(uint8_t const* data, size_t length,
   if (_generateBody) {
     // convert object to JSON string
     VPackStringBufferAdapter buffer(_body->stringBuffer());
+    // the JSON is hardly ever smaller than the VelocyPack. reserving its
+    // size upfront saves repeated reallocations of the body
+    buffer.reserve(length);
 
     velocypack::Dumper dumper(&buffer, &tmpOpts);
     dumper.dump(current);
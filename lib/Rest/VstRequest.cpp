@@ -112,9 +112,14 @@ std::string_view VstRequest::rawPayload() const {
 VPackSlice VstRequest::payload(bool strictValidation) {
   if (_contentType == ContentType::JSON) {
     if (!_vpackBuilder && _payload.size() > _payloadOffset) {
-      _vpackBuilder = VPackParser::fromJson(
-          _payload.data() + _payloadOffset, _payload.size() - _payloadOffset,
-          validationOptions(strictValidation));
+      VPackOptions const* options = validationOptions(strictValidation);
+      size_t const length = _payload.size() - _payloadOffset;
+      // see HttpRequest::payload()
+      auto builder = std::make_shared<VPackBuilder>(options);
+      builder->reserve(length);
+      VPackParser parser(builder, options);
+      parser.parse(_payload.data() + _payloadOffset, length);
+      _vpackBuilder = std::move(builder);
       _memoryUsage += _vpackBuilder->bufferRef().size();
     }
     if (_vpackBuilder) {
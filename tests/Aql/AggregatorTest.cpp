@@ -0,0 +1,133 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+
+#include "Aql/Aggregator.h"
+#include "Aql/AqlValue.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Parser.h>
+#include <velocypack/Slice.h>
+
+#include <initializer_list>
+#include <string>
+#include <string_view>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+namespace {
+
+// feeds the partial results of multiple DB servers into the coordinator
+// variant of an aggregator
+std::string merge(std::string_view type,
+                  std::initializer_list<char const*> partials) {
+  auto aggregator = Aggregator::fromTypeString(
+      &velocypack::Options::Defaults, Aggregator::runOnCoordinatorAs(type));
+  for (auto partial : partials) {
+    auto b = velocypack::Parser::fromJson(partial);
+    aggregator->reduce(AqlValue(b->slice()));
+  }
+  AqlValue result = aggregator->stealValue();
+  AqlValueGuard guard{result, true};
+  return result.slice().toJson();
+}
+
+}  // namespace
+
+TEST(AggregatorTest, unique_merges_all_partial_results) {
+  EXPECT_EQ("[1,2,3]", merge("UNIQUE", {"[1,2]", "[1,3]", "[]"}));
+}
+
+TEST(AggregatorTest, sorted_unique_merges_all_partial_results) {
+  EXPECT_EQ("[1,2,3,4]", merge("SORTED_UNIQUE", {"[2,3]", "[2,1,4]"}));
+}
+
+TEST(AggregatorTest, count_distinct_merges_all_partial_results) {
+  EXPECT_EQ("4", merge("COUNT_DISTINCT", {"[\"a\",\"b\"]", "[\"a\",1,2]"}));
+}
+
+TEST(AggregatorTest, push_collects_and_concatenates_values) {
+  auto aggregator =
+      Aggregator::fromTypeString(&velocypack::Options::Defaults, "PUSH_STEP1");
+  aggregator->reduce(AqlValue(AqlValueHintInt(1)));
+  aggregator->reduce(AqlValue(AqlValueHintNull()));
+  aggregator->reduce(AqlValue(AqlValueHintInt(1)));
+  AqlValue partial = aggregator->stealValue();
+  AqlValueGuard guard{partial, true};
+  EXPECT_EQ("[1,null,1]", partial.slice().toJson());
+
+  EXPECT_EQ("[1,null,1,\"a\"]",
+            merge("PUSH_STEP2", {partial.slice().toJson().c_str(), "[]",
+                                 "[\"a\"]"}));
+}
+
+TEST(AggregatorTest, sum_removes_integers_exactly) {
+  auto aggregator =
+      Aggregator::fromTypeString(&velocypack::Options::Defaults, "SUM");
+  ASSERT_TRUE(aggregator->supportsRemoval());
+  aggregator->reduce(AqlValue(AqlValueHintInt(3)));
+  aggregator->reduce(AqlValue(AqlValueHintNull()));
+  aggregator->reduce(AqlValue(AqlValueHintInt(4)));
+  EXPECT_TRUE(aggregator->remove(AqlValue(AqlValueHintInt(3))));
+  EXPECT_TRUE(aggregator->remove(AqlValue(AqlValueHintNull())));
+  AqlValue result = aggregator->get();
+  AqlValueGuard guard{result, true};
+  EXPECT_EQ(4.0, result.toDouble());
+}
+
+TEST(AggregatorTest, sum_refuses_removal_of_fractions) {
+  auto aggregator =
+      Aggregator::fromTypeString(&velocypack::Options::Defaults, "SUM");
+  aggregator->reduce(AqlValue(AqlValueHintDouble(0.1)));
+  aggregator->reduce(AqlValue(AqlValueHintDouble(0.2)));
+  EXPECT_FALSE(aggregator->remove(AqlValue(AqlValueHintDouble(0.1))));
+}
+
+TEST(AggregatorTest, average_removes_values) {
+  auto aggregator =
+      Aggregator::fromTypeString(&velocypack::Options::Defaults, "AVG");
+  ASSERT_TRUE(aggregator->supportsRemoval());
+  aggregator->reduce(AqlValue(AqlValueHintInt(1)));
+  aggregator->reduce(AqlValue(AqlValueHintInt(2)));
+  aggregator->reduce(AqlValue(AqlValueHintInt(6)));
+  EXPECT_TRUE(aggregator->remove(AqlValue(AqlValueHintInt(1))));
+  AqlValue result = aggregator->get();
+  AqlValueGuard guard{result, true};
+  EXPECT_EQ(4.0, result.toDouble());
+}
+
+TEST(AggregatorTest, min_removes_values_other_than_the_minimum) {
+  auto aggregator =
+      Aggregator::fromTypeString(&velocypack::Options::Defaults, "MIN");
+  ASSERT_TRUE(aggregator->supportsRemoval());
+  aggregator->reduce(AqlValue(AqlValueHintInt(5)));
+  aggregator->reduce(AqlValue(AqlValueHintInt(2)));
+  EXPECT_TRUE(aggregator->remove(AqlValue(AqlValueHintInt(5))));
+  EXPECT_FALSE(aggregator->remove(AqlValue(AqlValueHintInt(2))));
+}
+
+TEST(AggregatorTest, unique_does_not_support_removal) {
+  auto aggregator =
+      Aggregator::fromTypeString(&velocypack::Options::Defaults, "UNIQUE");
+  EXPECT_FALSE(aggregator->supportsRemoval());
+}
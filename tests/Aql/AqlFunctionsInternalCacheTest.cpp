@@ -0,0 +1,81 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+
+#include "Aql/AqlFunctionsInternalCache.h"
+
+#include <optional>
+#include <string>
+#include <string_view>
+
+using namespace arangodb::aql;
+
+namespace {
+
+std::optional<bool> match(std::string_view pattern, std::string_view value) {
+  std::string buffer;
+  return AqlFunctionsInternalCache::matchLikePattern(pattern, value, buffer);
+}
+
+}  // namespace
+
+TEST(AqlFunctionsInternalCacheTest, like_without_wildcards) {
+  EXPECT_EQ(true, match("abc", "abc"));
+  EXPECT_EQ(false, match("abc", "abcd"));
+  EXPECT_EQ(false, match("abc", "ab"));
+  EXPECT_EQ(true, match("", ""));
+  EXPECT_EQ(false, match("", "a"));
+}
+
+TEST(AqlFunctionsInternalCacheTest, like_with_percent_wildcards) {
+  EXPECT_EQ(true, match("ab%", "abc"));
+  EXPECT_EQ(true, match("ab%", "ab"));
+  EXPECT_EQ(false, match("ab%", "cab"));
+  EXPECT_EQ(true, match("%bc", "abc"));
+  EXPECT_EQ(false, match("%bc", "bca"));
+  EXPECT_EQ(true, match("%b%", "abc"));
+  EXPECT_EQ(false, match("%d%", "abc"));
+  EXPECT_EQ(true, match("a%c%e", "abcde"));
+  EXPECT_EQ(true, match("a%c%e", "ace"));
+  EXPECT_EQ(false, match("a%c%e", "aec"));
+  EXPECT_EQ(false, match("ab%ba", "aba"));
+  EXPECT_EQ(true, match("%", ""));
+  EXPECT_EQ(true, match("%%", "a\r\nb"));
+}
+
+TEST(AqlFunctionsInternalCacheTest, like_with_escapes) {
+  EXPECT_EQ(true, match("100\\%", "100%"));
+  EXPECT_EQ(false, match("100\\%", "1000"));
+  EXPECT_EQ(true, match("a\\_b", "a_b"));
+  EXPECT_EQ(true, match("a\\\\b", "a\\b"));
+  EXPECT_EQ(true, match("a\\.b", "a.b"));
+  EXPECT_EQ(true, match("a\\b", "a\\b"));
+}
+
+TEST(AqlFunctionsInternalCacheTest, like_falls_back_to_icu) {
+  EXPECT_EQ(std::nullopt, match("a_c", "abc"));
+  EXPECT_EQ(std::nullopt, match("a%", "a\xe2\x80\xa8"));
+  EXPECT_EQ(std::nullopt, match("a%", "a\x0b"));
+  EXPECT_EQ(std::nullopt, match("a%", "a\xff"));
+  // line terminators are irrelevant without wildcards
+  EXPECT_EQ(true, match("a\xe2\x80\xa8", "a\xe2\x80\xa8"));
+}
@@ -525,6 +525,97 @@ TEST_F(AqlItemBlockTest, test_serialization_deserialization_input_row) {
   }
 }
 
+TEST_F(AqlItemBlockTest, test_column_major_layout_read_write) {
+  SharedAqlItemBlockPtr block{new AqlItemBlock(itemBlockManager, 3, 2)};
+  block->setLayout(AqlItemBlock::Layout::ColumnMajor);
+  EXPECT_EQ(block->layout(), AqlItemBlock::Layout::ColumnMajor);
+  EXPECT_TRUE(block->hasContiguousColumns());
+
+  for (size_t row = 0; row < 3; ++row) {
+    block->emplaceValue(row, 0, AqlValueHintInt(row));
+    block->emplaceValue(row, 1, AqlValueHintInt(10 + row));
+  }
+
+  for (size_t row = 0; row < 3; ++row) {
+    EXPECT_EQ(block->getValueReference(row, 0).toInt64(),
+              static_cast<int64_t>(row));
+    EXPECT_EQ(block->getValueReference(row, 1).toInt64(),
+              static_cast<int64_t>(10 + row));
+  }
+
+  auto column = block->getColumn(1, 0, 3);
+  ASSERT_EQ(column.size(), 3);
+  EXPECT_EQ(column[0].toInt64(), 10);
+  EXPECT_EQ(column[1].toInt64(), 11);
+  EXPECT_EQ(column[2].toInt64(), 12);
+
+  InputAqlItemRow input{block, 1};
+  ASSERT_TRUE(input.hasContiguousColumns());
+  auto span = input.getColumnSpan(RegisterId{0}, 3);
+  ASSERT_EQ(span.size(), 2);
+  EXPECT_EQ(span[0].toInt64(), 1);
+  EXPECT_EQ(span[1].toInt64(), 2);
+}
+
+TEST_F(AqlItemBlockTest, test_column_major_layout_shrink) {
+  SharedAqlItemBlockPtr block{new AqlItemBlock(itemBlockManager, 4, 2)};
+  block->setLayout(AqlItemBlock::Layout::ColumnMajor);
+
+  for (size_t row = 0; row < 4; ++row) {
+    block->emplaceValue(row, 0, dummyData(4));
+    block->emplaceValue(row, 1, AqlValueHintInt(row));
+  }
+  auto memoryBefore = block->getMemoryUsage();
+
+  block->shrink(2);
+  EXPECT_EQ(block->numRows(), 2);
+  EXPECT_EQ(block->maxModifiedRowIndex(), 2);
+  EXPECT_LT(block->getMemoryUsage(), memoryBefore);
+
+  // values of the remaining rows must be untouched
+  compareWithDummy(block, 0, 0, 4);
+  compareWithDummy(block, 1, 0, 4);
+  EXPECT_EQ(block->getValueReference(0, 1).toInt64(), 0);
+  EXPECT_EQ(block->getValueReference(1, 1).toInt64(), 1);
+}
+
+TEST_F(AqlItemBlockTest, test_manager_selects_column_major_layout) {
+  itemBlockManager.setColumnarLayoutMinRegisters(3);
+
+  auto narrow = itemBlockManager.requestBlock(4, 2);
+  EXPECT_EQ(narrow->layout(), AqlItemBlock::Layout::RowMajor);
+
+  auto wide = itemBlockManager.requestBlock(4, 3);
+  EXPECT_EQ(wide->layout(), AqlItemBlock::Layout::ColumnMajor);
+}
+
+TEST_F(AqlItemBlockTest,
+       test_serialization_deserialization_column_major_layout) {
+  itemBlockManager.setColumnarLayoutMinRegisters(2);
+  SharedAqlItemBlockPtr block = itemBlockManager.requestBlock(2, 2);
+  ASSERT_EQ(block->layout(), AqlItemBlock::Layout::ColumnMajor);
+
+  block->emplaceValue(0, 0, dummyData(0));
+  block->emplaceValue(0, 1, dummyData(1));
+  block->emplaceValue(1, 0, dummyData(2));
+  block->emplaceValue(1, 1, dummyData(4));
+  VPackBuilder result;
+  result.openObject();
+  block->toVelocyPack(nullptr, result);
+  result.close();
+
+  // deserialize into a row-major block
+  itemBlockManager.setColumnarLayoutMinRegisters(0);
+  SharedAqlItemBlockPtr testee =
+      itemBlockManager.requestAndInitBlock(result.slice());
+  EXPECT_EQ(testee->layout(), AqlItemBlock::Layout::RowMajor);
+
+  compareWithDummy(testee, 0, 0, 0);
+  compareWithDummy(testee, 0, 1, 1);
+  compareWithDummy(testee, 1, 0, 2);
+  compareWithDummy(testee, 1, 1, 4);
+}
+
 }  // namespace aql
 }  // namespace tests
 }  // namespace arangodb
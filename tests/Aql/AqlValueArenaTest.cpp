@@ -0,0 +1,119 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+
+#include "Aql/AqlValue.h"
+#include "Aql/AqlValueArena.h"
+#include "Basics/GlobalResourceMonitor.h"
+#include "Basics/ResourceUsage.h"
+
+#include <string>
+#include <tuple>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+class AqlValueArenaTest : public ::testing::Test {
+ protected:
+  GlobalResourceMonitor global{};
+  ResourceMonitor monitor{global};
+};
+
+TEST_F(AqlValueArenaTest, deduplicates_values) {
+  AqlValueArena arena(monitor);
+  AqlValue a(std::string_view("a string that is too long to be inlined"));
+  AqlValue b(std::string_view("a string that is too long to be inlined"));
+  AqlValueGuard guardA{a, true};
+  AqlValueGuard guardB{b, true};
+
+  AqlValue internedA = arena.intern(a);
+  AqlValue internedB = arena.intern(b);
+  EXPECT_FALSE(internedA.requiresDestruction());
+  EXPECT_TRUE(internedA.isPointer());
+  EXPECT_EQ(internedA.slice().start(), internedB.slice().start());
+  EXPECT_EQ("a string that is too long to be inlined",
+            internedA.slice().stringView());
+
+  EXPECT_EQ(arena.memoryUsage(), monitor.current());
+  EXPECT_GE(arena.memoryUsage(), AqlValueArena::blockSize);
+}
+
+TEST_F(AqlValueArenaTest, does_not_store_inline_values) {
+  AqlValueArena arena(monitor);
+  AqlValue value(AqlValueHintInt(42));
+
+  AqlValue interned = arena.intern(value);
+  EXPECT_FALSE(interned.isPointer());
+  EXPECT_EQ(42, interned.toInt64());
+  EXPECT_EQ(0, arena.memoryUsage());
+}
+
+TEST_F(AqlValueArenaTest, clones_large_values) {
+  AqlValueArena arena(monitor);
+  AqlValue value(std::string(AqlValueArena::maxValueSize, 'x'));
+  AqlValueGuard guard{value, true};
+
+  AqlValue interned = arena.intern(value);
+  AqlValueGuard internedGuard{interned, true};
+  EXPECT_TRUE(interned.requiresDestruction());
+  EXPECT_NE(value.slice().start(), interned.slice().start());
+  EXPECT_EQ(0, arena.memoryUsage());
+}
+
+TEST_F(AqlValueArenaTest, clones_values_if_full) {
+  // room for a single block only
+  AqlValueArena arena(monitor, AqlValueArena::blockSize);
+  std::string const prefix(AqlValueArena::maxValueSize / 2, 'x');
+
+  size_t cloned = 0;
+  for (size_t i = 0; i < 2 * AqlValueArena::blockSize / prefix.size(); ++i) {
+    AqlValue value(std::string_view(prefix + std::to_string(i)));
+    AqlValueGuard guard{value, true};
+    AqlValue interned = arena.intern(value);
+    AqlValueGuard internedGuard{interned, interned.requiresDestruction()};
+    EXPECT_EQ(value.slice().stringView(), interned.slice().stringView());
+    if (interned.requiresDestruction()) {
+      ++cloned;
+    }
+  }
+  EXPECT_GT(cloned, 0);
+  EXPECT_LE(arena.memoryUsage(), 2 * AqlValueArena::blockSize);
+}
+
+TEST_F(AqlValueArenaTest, clear_releases_memory) {
+  AqlValueArena arena(monitor);
+  AqlValue value(std::string_view("a string that is too long to be inlined"));
+  AqlValueGuard guard{value, true};
+
+  std::ignore = arena.intern(value);
+  EXPECT_GT(monitor.current(), 0);
+
+  arena.clear();
+  EXPECT_EQ(0, arena.memoryUsage());
+  EXPECT_EQ(0, monitor.current());
+
+  // the arena can be used again after clearing it
+  AqlValue interned = arena.intern(value);
+  EXPECT_FALSE(interned.requiresDestruction());
+  EXPECT_EQ(value.slice().stringView(), interned.slice().stringView());
+  EXPECT_EQ(arena.memoryUsage(), monitor.current());
+}
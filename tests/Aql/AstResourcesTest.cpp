@@ -28,6 +28,7 @@
 
 #include "gtest/gtest.h"
 
+#include <memory_resource>
 #include <string_view>
 
 namespace {
@@ -193,4 +194,42 @@ TEST(AstResourcesTest, testLongStringsFillAndClearMost) {
   EXPECT_EQ(capacity * overheadPerString, resourceMonitor.current());
 }
 
+TEST(AstResourcesTest, testNodeMembersFillAndClear) {
+  arangodb::GlobalResourceMonitor global;
+  arangodb::ResourceMonitor resourceMonitor(global);
+  arangodb::aql::AstResources resources(resourceMonitor);
+
+  constexpr size_t overheadPerChild =
+      arangodb::aql::AstResources::memoryUsageForChildNode();
+
+  for (size_t round = 0; round < 3; ++round) {
+    auto* array = resources.registerNode(arangodb::aql::NODE_TYPE_ARRAY);
+    // member arrays of registered nodes are allocated from the arena
+    EXPECT_NE(std::pmr::get_default_resource(),
+              array->members.get_allocator().resource());
+
+    resources.reserveChildNodes(array, 100);
+    for (size_t i = 0; i < 100; ++i) {
+      auto* member = resources.registerNode(arangodb::aql::NODE_TYPE_NOP);
+      EXPECT_EQ(0, member->numMembers());
+      array->addMember(member);
+    }
+    // growing beyond the reserved size must work as well
+    for (size_t i = 0; i < 1000; ++i) {
+      array->addMember(array->getMemberUnchecked(i % 100));
+    }
+    ASSERT_EQ(1100, array->numMembers());
+    EXPECT_EQ(array->getMemberUnchecked(0), array->getMemberUnchecked(100));
+    EXPECT_EQ(101 * sizeof(arangodb::aql::AstNode) + 100 * overheadPerChild,
+              resourceMonitor.current());
+
+    if (round % 2 == 0) {
+      resources.clearMost();
+    } else {
+      resources.clear();
+    }
+    EXPECT_EQ(0, resourceMonitor.current());
+  }
+}
+
 }  // namespace
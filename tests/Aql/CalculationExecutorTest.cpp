@@ -29,12 +29,14 @@
 #include "Aql/AqlCall.h"
 #include "AqlExecutorTestCase.h"
 #include "AqlItemBlockHelper.h"
+#include "RowFetcherHelper.h"
 
 #include "Aql/AqlItemBlock.h"
 #include "Aql/Ast.h"
 #include "Aql/CalculationExecutor.h"
 #include "Aql/ExecutionPlan.h"
 #include "Aql/Expression.h"
+#include "Aql/ExpressionProgram.h"
 #include "Aql/OutputAqlItemRow.h"
 #include "Aql/Query.h"
 #include "Aql/SingleRowFetcher.h"
@@ -44,6 +46,10 @@
 #include "Transaction/Methods.h"
 
 #include <velocypack/Builder.h>
+#include <velocypack/Parser.h>
+
+#include <functional>
+#include <tuple>
 
 // required for QuerySetup
 #include "Mocks/Servers.h"
@@ -351,6 +357,246 @@ TEST_P(CalculationExecutorTest, condition_some_input_limit_fullcount) {
       .run(true);
 }
 
+TEST_P(CalculationExecutorTest, condition_comparison_some_input) {
+  // a > 3 AND a != 5
+  auto* cmp =
+      ast.createNodeNaryOperator(AstNodeType::NODE_TYPE_OPERATOR_NARY_AND);
+  cmp->addMember(ast.createNodeBinaryOperator(
+      AstNodeType::NODE_TYPE_OPERATOR_BINARY_GT, a, ast.createNodeValueInt(3)));
+  cmp->addMember(ast.createNodeBinaryOperator(
+      AstNodeType::NODE_TYPE_OPERATOR_BINARY_NE, a, ast.createNodeValueInt(5)));
+  Expression cmpExpr(&ast, cmp);
+
+  std::vector<std::pair<VariableId, RegisterId>> varToRegs{
+      std::make_pair(var.id, inRegID)};
+  CalculationExecutorInfos infos{outRegID, *fakedQuery.get(), cmpExpr,
+                                 std::move(varToRegs)};
+
+  AqlCall call{};
+  makeExecutorTestHelper<2, 2>()
+      .addConsumer<CalculationExecutor<CalculationType::Condition>>(
+          std::move(registerInfos), std::move(infos))
+      .setInputValue(MatrixBuilder<2>{
+          RowBuilder<2>{0, NoneEntry{}}, RowBuilder<2>{1, NoneEntry{}},
+          RowBuilder<2>{R"("a")", NoneEntry{}}, RowBuilder<2>{2, NoneEntry{}},
+          RowBuilder<2>{3, NoneEntry{}}, RowBuilder<2>{4, NoneEntry{}},
+          RowBuilder<2>{5, NoneEntry{}},
+          RowBuilder<2>{R"(6.5)", NoneEntry{}}})
+      .setInputSplitType(getSplit())
+      .setCall(call)
+      .expectOutput({0, 1},
+                    MatrixBuilder<2>{RowBuilder<2>{0, R"(false)"},
+                                     RowBuilder<2>{1, R"(false)"},
+                                     RowBuilder<2>{R"("a")", R"(true)"},
+                                     RowBuilder<2>{2, R"(false)"},
+                                     RowBuilder<2>{3, R"(false)"},
+                                     RowBuilder<2>{4, R"(true)"},
+                                     RowBuilder<2>{5, R"(false)"},
+                                     RowBuilder<2>{R"(6.5)", R"(true)"}})
+      .allowAnyOutputOrder(false)
+      .expectSkipped(0)
+      .expectedState(ExecutionState::DONE)
+      .run(true);
+}
+
+TEST_P(CalculationExecutorTest, condition_division_by_zero_some_input) {
+  // 12 / a, which must produce null for a == 0
+  auto* div = ast.createNodeBinaryOperator(
+      AstNodeType::NODE_TYPE_OPERATOR_BINARY_DIV, ast.createNodeValueInt(12),
+      a);
+  Expression divExpr(&ast, div);
+
+  std::vector<std::pair<VariableId, RegisterId>> varToRegs{
+      std::make_pair(var.id, inRegID)};
+  CalculationExecutorInfos infos{outRegID, *fakedQuery.get(), divExpr,
+                                 std::move(varToRegs)};
+
+  AqlCall call{};
+  makeExecutorTestHelper<2, 2>()
+      .addConsumer<CalculationExecutor<CalculationType::Condition>>(
+          std::move(registerInfos), std::move(infos))
+      .setInputValue(MatrixBuilder<2>{
+          RowBuilder<2>{1, NoneEntry{}}, RowBuilder<2>{2, NoneEntry{}},
+          RowBuilder<2>{3, NoneEntry{}}, RowBuilder<2>{4, NoneEntry{}},
+          RowBuilder<2>{0, NoneEntry{}}, RowBuilder<2>{6, NoneEntry{}}})
+      .setInputSplitType(getSplit())
+      .setCall(call)
+      .expectOutput({0, 1},
+                    MatrixBuilder<2>{RowBuilder<2>{1, 12}, RowBuilder<2>{2, 6},
+                                     RowBuilder<2>{3, 4}, RowBuilder<2>{4, 3},
+                                     RowBuilder<2>{0, R"(null)"},
+                                     RowBuilder<2>{6, 2}})
+      .allowAnyOutputOrder(false)
+      .expectSkipped(0)
+      .expectedState(ExecutionState::DONE)
+      .run(true);
+}
+
+TEST_P(CalculationExecutorTest, condition_compiled_some_input) {
+  // a > 3 ? -a : a * 2, executed often enough to be compiled
+  auto* ternary = ast.createNodeTernaryOperator(
+      ast.createNodeBinaryOperator(AstNodeType::NODE_TYPE_OPERATOR_BINARY_GT,
+                                   a, ast.createNodeValueInt(3)),
+      ast.createNodeUnaryOperator(AstNodeType::NODE_TYPE_OPERATOR_UNARY_MINUS,
+                                  a),
+      ast.createNodeBinaryOperator(
+          AstNodeType::NODE_TYPE_OPERATOR_BINARY_TIMES, a,
+          ast.createNodeValueInt(2)));
+  Expression ternaryExpr(&ast, ternary);
+
+  std::vector<std::pair<VariableId, RegisterId>> varToRegs{
+      std::make_pair(var.id, inRegID)};
+  CalculationExecutorInfos infos{outRegID, *fakedQuery.get(), ternaryExpr,
+                                 std::move(varToRegs)};
+
+  MatrixBuilder<2> input;
+  MatrixBuilder<2> output;
+  for (int i = 0; i < 2 * int(ExpressionProgram::compileThreshold); ++i) {
+    int value = i % 10;
+    input.emplace_back(RowBuilder<2>{value, NoneEntry{}});
+    output.emplace_back(
+        RowBuilder<2>{value, value > 3 ? -value : value * 2});
+  }
+  // values which are not numbers
+  input.emplace_back(RowBuilder<2>{R"(null)", NoneEntry{}});
+  output.emplace_back(RowBuilder<2>{R"(null)", 0});
+  input.emplace_back(RowBuilder<2>{R"("5")", NoneEntry{}});
+  output.emplace_back(RowBuilder<2>{R"("5")", -5});
+
+  AqlCall call{};
+  makeExecutorTestHelper<2, 2>()
+      .addConsumer<CalculationExecutor<CalculationType::Condition>>(
+          std::move(registerInfos), std::move(infos))
+      .setInputValue(std::move(input))
+      .setInputSplitType(getSplit())
+      .setCall(call)
+      .expectOutput({0, 1}, std::move(output))
+      .allowAnyOutputOrder(false)
+      .expectSkipped(0)
+      .expectedState(ExecutionState::DONE)
+      .run(true);
+}
+
+namespace {
+// feeds blocks of 100 rows each into the executor, one block per call. every
+// block for which badBlock(i) is true contains a single string value, so that
+// the kernel cannot evaluate it. returns whether the kernel is still in use
+bool runKernelBlocks(AqlItemBlockManager& itemBlockManager,
+                     RegisterInfos const& registerInfos,
+                     CalculationExecutorInfos& infos, size_t numBlocks,
+                     std::function<bool(size_t)> const& badBlock) {
+  constexpr size_t rowsPerBlock = 100;
+  auto fakeUnusedBlock = VPackParser::fromJson("[  ]");
+  SingleRowFetcherHelper<::arangodb::aql::BlockPassthrough::Enable> fetcher(
+      itemBlockManager, fakeUnusedBlock->steal(), false);
+  CalculationExecutor<CalculationType::Condition> testee(fetcher, infos);
+  EXPECT_TRUE(testee.usesKernel());
+
+  for (size_t b = 0; b < numBlocks; ++b) {
+    SharedAqlItemBlockPtr inBlock =
+        itemBlockManager.requestBlock(rowsPerBlock, 1);
+    for (size_t i = 0; i < rowsPerBlock; ++i) {
+      if (badBlock(b) && i == rowsPerBlock / 2) {
+        inBlock->setValue(i, 0, AqlValue(std::string_view("1")));
+      } else {
+        inBlock->emplaceValue(i, 0, AqlValueHintInt(int64_t(i)));
+      }
+    }
+    SharedAqlItemBlockPtr outBlock =
+        itemBlockManager.requestBlock(rowsPerBlock, 2);
+    AqlItemBlockInputRange input{MainQueryState::DONE, 0, inBlock, 0};
+    OutputAqlItemRow output(std::move(outBlock),
+                            registerInfos.getOutputRegisters(),
+                            registerInfos.registersToKeep(),
+                            registerInfos.registersToClear());
+    output.setCall(AqlCall{});
+    auto const [state, stats, call] = testee.produceRows(input, output);
+    EXPECT_EQ(state, ExecutorState::DONE);
+    EXPECT_EQ(output.numRowsWritten(), rowsPerBlock);
+
+    // results must be the same regardless of how they were computed
+    auto result = output.stealBlock();
+    for (size_t i = 0; i < rowsPerBlock; ++i) {
+      AqlValue const& value =
+          result->getValueReference(i, infos.getOutputRegisterId());
+      EXPECT_TRUE(value.isNumber());
+      EXPECT_EQ(value.toInt64(), badBlock(b) && i == rowsPerBlock / 2
+                                     ? 2
+                                     : int64_t(i) + 1);
+    }
+  }
+  return testee.usesKernel();
+}
+}  // namespace
+
+TEST_P(CalculationExecutorTest, condition_kernel_dropped_for_mostly_misses) {
+  // a + 1, where 4 out of 5 blocks contain a value the kernel cannot handle
+  auto infos = buildInfos();
+  EXPECT_FALSE(runKernelBlocks(itemBlockManager, registerInfos, infos, 20,
+                               [](size_t b) { return b % 5 != 0; }));
+}
+
+TEST_P(CalculationExecutorTest, condition_kernel_kept_for_occasional_misses) {
+  // a + 1, where 1 out of 5 blocks contains a value the kernel cannot handle
+  auto infos = buildInfos();
+  EXPECT_TRUE(runKernelBlocks(itemBlockManager, registerInfos, infos, 20,
+                              [](size_t b) { return b % 5 == 0; }));
+}
+
+TEST_P(CalculationExecutorTest, condition_kernel_retried_after_shadow_row) {
+  // a + 1, on a block with a subquery run the kernel cannot evaluate,
+  // followed by a run it can evaluate
+  constexpr size_t rowsPerRun = 10;
+  auto infos = buildInfos();
+  auto fakeUnusedBlock = VPackParser::fromJson("[  ]");
+  SingleRowFetcherHelper<::arangodb::aql::BlockPassthrough::Enable> fetcher(
+      itemBlockManager, fakeUnusedBlock->steal(), false);
+  CalculationExecutor<CalculationType::Condition> testee(fetcher, infos);
+  ASSERT_TRUE(testee.usesKernel());
+
+  SharedAqlItemBlockPtr inBlock =
+      itemBlockManager.requestBlock(2 * rowsPerRun + 1, 1);
+  for (size_t i = 0; i < 2 * rowsPerRun + 1; ++i) {
+    if (i == rowsPerRun / 2) {
+      inBlock->setValue(i, 0, AqlValue(std::string_view("1")));
+    } else {
+      inBlock->emplaceValue(i, 0, AqlValueHintInt(int64_t(i)));
+    }
+  }
+  inBlock->makeShadowRow(rowsPerRun, 0);
+  AqlItemBlockInputRange input{MainQueryState::DONE, 0, inBlock, 0};
+
+  for (size_t run = 0; run < 2; ++run) {
+    OutputAqlItemRow output(itemBlockManager.requestBlock(rowsPerRun, 2),
+                            registerInfos.getOutputRegisters(),
+                            registerInfos.registersToKeep(),
+                            registerInfos.registersToClear());
+    output.setCall(AqlCall{});
+    std::ignore = testee.produceRows(input, output);
+    ASSERT_EQ(output.numRowsWritten(), rowsPerRun);
+
+    auto result = output.stealBlock();
+    for (size_t i = 0; i < rowsPerRun; ++i) {
+      size_t const row = run * (rowsPerRun + 1) + i;
+      AqlValue const& value =
+          result->getValueReference(i, infos.getOutputRegisterId());
+      EXPECT_TRUE(value.isNumber());
+      EXPECT_EQ(value.toInt64(),
+                row == rowsPerRun / 2 ? 2 : int64_t(row) + 1);
+    }
+
+    if (run == 0) {
+      // the first run is evaluated row by row
+      EXPECT_EQ(0U, testee.kernelHitRows());
+      ASSERT_TRUE(input.hasShadowRow());
+      std::ignore = input.nextShadowRow();
+    }
+  }
+  // all rows of the second run are evaluated by the kernel
+  EXPECT_EQ(rowsPerRun, testee.kernelHitRows());
+  EXPECT_TRUE(testee.usesKernel());
+}
+
 // Could be fixed and enabled if one enabled the V8 engine
 TEST_P(CalculationExecutorTest, DISABLED_v8condition_some_input) {
   AqlCall call{};
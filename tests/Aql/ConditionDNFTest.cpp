@@ -0,0 +1,242 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Jan Steemann
+////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+
+#include "AqlExecutorTestCase.h"
+#include "IResearch/common.h"
+#include "Mocks/Servers.h"
+#include "QueryHelper.h"
+
+#include "Aql/Ast.h"
+#include "Aql/AstNode.h"
+#include "Aql/Condition.h"
+#include "Aql/Query.h"
+#include "Aql/QueryOptions.h"
+#include "Aql/QueryString.h"
+#include "Transaction/StandaloneContext.h"
+#include "VocBase/LogicalCollection.h"
+#include "VocBase/vocbase.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Iterator.h>
+#include <velocypack/Parser.h>
+
+#include <set>
+#include <string>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+namespace arangodb {
+namespace tests {
+namespace aql {
+
+class ConditionDNFTest : public AqlExecutorTestCase<false> {
+ protected:
+  TRI_vocbase_t& vocbase;
+
+  ConditionDNFTest() : vocbase(_server->getSystemDatabase()) {}
+
+  // creates a query whose AST is used to build conditions
+  std::shared_ptr<Query> createQuery(size_t maxDNFConditionMembers) {
+    auto options = VPackParser::fromJson(
+        R"({"maxDNFConditionMembers": )" +
+        std::to_string(maxDNFConditionMembers) + "}");
+    return Query::create(
+        std::make_shared<transaction::StandaloneContext>(vocbase),
+        QueryString(std::string_view("RETURN 1")), nullptr,
+        QueryOptions(options->slice()));
+  }
+
+  // d.<attribute> == 0 OR d.<attribute> == 1 OR ...
+  static AstNode* createOr(Ast* ast, Variable const* variable,
+                           std::string_view attribute, size_t members) {
+    AstNode* result = nullptr;
+    for (size_t i = 0; i < members; ++i) {
+      auto* cmp = ast->createNodeBinaryOperator(
+          NODE_TYPE_OPERATOR_BINARY_EQ,
+          ast->createNodeAttributeAccess(ast->createNodeReference(variable),
+                                         attribute),
+          ast->createNodeValueInt(int64_t(i)));
+      result = result == nullptr
+                   ? cmp
+                   : ast->createNodeBinaryOperator(
+                         NODE_TYPE_OPERATOR_BINARY_OR, result, cmp);
+    }
+    return result;
+  }
+
+  // normalizes the AND of ORs with the given numbers of members
+  static AstNode* normalize(Query& query, std::vector<size_t> const& ors) {
+    Ast* ast = query.ast();
+    Variable const* variable = ast->variables()->createTemporaryVariable();
+    Condition condition(ast);
+    for (size_t i = 0; i < ors.size(); ++i) {
+      condition.andCombine(
+          createOr(ast, variable, "a" + std::to_string(i), ors[i]));
+    }
+    condition.normalize();
+    return condition.root();
+  }
+
+  // number of members of the AND which are kept as residual conditions
+  static size_t countResidual(AstNode const* andNode) {
+    EXPECT_EQ(NODE_TYPE_OPERATOR_NARY_AND, andNode->type);
+    size_t residual = 0;
+    for (size_t i = 0; i < andNode->numMembers(); ++i) {
+      auto const* member = andNode->getMemberUnchecked(i);
+      if (member->type == NODE_TYPE_OPERATOR_BINARY_OR) {
+        ++residual;
+      } else {
+        EXPECT_EQ(NODE_TYPE_OPERATOR_BINARY_EQ, member->type);
+      }
+    }
+    return residual;
+  }
+};
+
+TEST_F(ConditionDNFTest, small_condition_is_fully_expanded) {
+  auto query = createQuery(10);
+  AstNode const* root = normalize(*query, {3, 3});
+  ASSERT_EQ(NODE_TYPE_OPERATOR_NARY_OR, root->type);
+  ASSERT_EQ(9U, root->numMembers());
+  for (size_t i = 0; i < root->numMembers(); ++i) {
+    EXPECT_EQ(2U, root->getMemberUnchecked(i)->numMembers());
+    EXPECT_EQ(0U, countResidual(root->getMemberUnchecked(i)));
+  }
+}
+
+TEST_F(ConditionDNFTest, exploding_or_becomes_residual) {
+  // 3 * 3 members would reach the limit, so the second OR is kept as is
+  auto query = createQuery(9);
+  AstNode const* root = normalize(*query, {3, 3});
+  ASSERT_EQ(NODE_TYPE_OPERATOR_NARY_OR, root->type);
+  ASSERT_EQ(3U, root->numMembers());
+  for (size_t i = 0; i < root->numMembers(); ++i) {
+    EXPECT_EQ(2U, root->getMemberUnchecked(i)->numMembers());
+    EXPECT_EQ(1U, countResidual(root->getMemberUnchecked(i)));
+  }
+}
+
+TEST_F(ConditionDNFTest, no_overflow_near_limit) {
+  // the product of all OR sizes (2^70) does not fit into 64 bits. only as
+  // many ORs are expanded as fit below the limit, all others are residual
+  auto query = createQuery(64);
+  AstNode const* root = normalize(*query, std::vector<size_t>(70, 2));
+  ASSERT_EQ(NODE_TYPE_OPERATOR_NARY_OR, root->type);
+  ASSERT_EQ(32U, root->numMembers());
+  for (size_t i = 0; i < root->numMembers(); ++i) {
+    EXPECT_EQ(70U, root->getMemberUnchecked(i)->numMembers());
+    EXPECT_EQ(65U, countResidual(root->getMemberUnchecked(i)));
+  }
+}
+
+class ConditionDNFQueryTest : public ConditionDNFTest {
+ protected:
+  // the ORs use different attributes, so that they are not turned into IN
+  // lookups by the optimizer
+  static constexpr std::string_view query = R"aql(
+      FOR d IN UnitTestDNF
+        FILTER d.a == 3 AND (d.b == 0 OR d.b == 1 OR d.c == 4) AND
+               (d.c == 0 OR d.c == 1 OR d.b == 4 OR d.c == 3)
+        RETURN d._key)aql";
+
+  ConditionDNFQueryTest() {
+    if (vocbase.lookupCollection("UnitTestDNF") == nullptr) {
+      auto json = VPackParser::fromJson(R"({"name":"UnitTestDNF"})");
+      auto collection = vocbase.createCollection(json->slice());
+      EXPECT_NE(collection, nullptr);
+      auto index = VPackParser::fromJson(
+          R"({"type": "persistent", "fields": ["a", "b"]})");
+      bool created = false;
+      EXPECT_NE(collection->createIndex(index->slice(), created), nullptr);
+      EXPECT_TRUE(created);
+      AssertQueryHasResult(vocbase, R"aql(
+          FOR a IN 0..4 FOR b IN 0..4 FOR c IN 0..4
+            INSERT {_key: CONCAT(a, "-", b, "-", c), a, b, c}
+            INTO UnitTestDNF)aql",
+                           VPackSlice::emptyArraySlice());
+    }
+  }
+
+  std::set<std::string> keys(std::string const& queryString,
+                             std::string const& options) {
+    auto result = executeQuery(vocbase, queryString, nullptr, options);
+    EXPECT_TRUE(result.result.ok()) << result.result.errorMessage();
+    std::set<std::string> keys;
+    if (result.data != nullptr) {
+      for (VPackSlice key : VPackArrayIterator(result.data->slice())) {
+        keys.emplace(key.copyString());
+      }
+    }
+    return keys;
+  }
+};
+
+TEST_F(ConditionDNFQueryTest, residual_condition_still_uses_index) {
+  auto options = VPackParser::fromJson(R"({"maxDNFConditionMembers": 4})");
+  auto q = Query::create(
+      std::make_shared<transaction::StandaloneContext>(vocbase),
+      QueryString(query), nullptr, QueryOptions(options->slice()));
+  auto result = q->explain();
+  ASSERT_TRUE(result.result.ok()) << result.result.errorMessage();
+
+  // the second OR is residual, but d.a and the first OR are still used for
+  // the index lookup
+  size_t indexNodes = 0;
+  auto nodes = result.data->slice().get("nodes");
+  for (VPackSlice node : VPackArrayIterator(nodes)) {
+    std::string_view type = node.get("type").stringView();
+    EXPECT_NE(type, "EnumerateCollectionNode");
+    if (type == "IndexNode") {
+      ++indexNodes;
+      VPackSlice condition = node.get("condition");
+      ASSERT_TRUE(condition.isObject());
+      EXPECT_EQ("n-ary or", condition.get("type").stringView());
+      EXPECT_LE(1U, condition.get("subNodes").length());
+    }
+  }
+  EXPECT_EQ(1U, indexNodes);
+}
+
+TEST_F(ConditionDNFQueryTest, residual_condition_results) {
+  std::set<std::string> const expected{"3-0-0", "3-0-1", "3-0-3", "3-1-0",
+                                       "3-1-1", "3-1-3", "3-4-4"};
+
+  // with a residual condition, with the fully expanded condition, and with
+  // the condition evaluated as is
+  EXPECT_EQ(expected, keys(std::string(query),
+                           R"({"maxDNFConditionMembers": 4})"));
+  EXPECT_EQ(expected, keys(std::string(query), "{}"));
+  EXPECT_EQ(expected, keys(R"aql(
+      FOR d IN UnitTestDNF
+        FILTER NOOPT(d.a == 3 AND (d.b == 0 OR d.b == 1 OR d.c == 4) AND
+                     (d.c == 0 OR d.c == 1 OR d.b == 4 OR d.c == 3))
+        RETURN d._key)aql",
+                           "{}"));
+}
+
+}  // namespace aql
+}  // namespace tests
+}  // namespace arangodb
@@ -127,6 +127,26 @@ TEST_P(DistinctCollectExecutorTest, split_2) {
       .run();
 }
 
+TEST_P(DistinctCollectExecutorTest, mixed_types) {
+  auto [split] = GetParam();
+
+  // integral doubles are equal to integers, integers beyond 2^53 are
+  // compared as doubles with other numbers
+  makeExecutorTestHelper()
+      .addConsumer<DistinctCollectExecutor>(std::move(registerInfos),
+                                            std::move(executorInfos))
+      .setInputValueList(1, "1.0", R"("a")", R"("a")", "2.5", "-0.0", 0,
+                         "9007199254740993", "9007199254740992.0", 2, "2.5",
+                         R"("b")", R"("1")", "[1]", "[1.0]", "null", "null")
+      .setInputSplitType(split)
+      .setCall(AqlCall{})
+      .expectOutputValueList(1, R"("a")", "2.5", "-0.0", "9007199254740993",
+                             2, R"("b")", R"("1")", "[1]", "null")
+      .expectSkipped(0)
+      .expectedState(ExecutionState::DONE)
+      .run();
+}
+
 template<size_t... vs>
 const DistinctCollectSplitType splitIntoBlocks =
     DistinctCollectSplitType{std::vector<std::size_t>{vs...}};
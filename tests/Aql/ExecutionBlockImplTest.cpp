@@ -2640,6 +2640,75 @@ INSTANTIATE_TEST_CASE_P(
                                          skipAndHardLimitAndFullCount(),
                                          onlyFullCount(), onlySkipAndCount()),
                        ::testing::Bool()));
+
+class ExecutionBlockImplAdaptiveBatchSizeTest
+    : public SharedExecutionBlockImplTest,
+      public ::testing::Test {
+ protected:
+  /**
+   * @brief Returns the number of rows of the first two output blocks of an
+   * executor that writes a string of the given size into every row.
+   */
+  auto producedBlockSizes(size_t valueSize) -> std::pair<size_t, size_t> {
+    std::deque<SharedAqlItemBlockPtr> blockDeque;
+    for (size_t i = 0; i < 2; ++i) {
+      MatrixBuilder<1> matrix;
+      matrix.reserve(ExecutionBlock::DefaultBatchSize);
+      for (size_t j = 0; j < ExecutionBlock::DefaultBatchSize; ++j) {
+        matrix.emplace_back(RowBuilder<1>{static_cast<int>(j)});
+      }
+      blockDeque.push_back(buildBlock<1>(
+          fakedQuery->rootEngine()->itemBlockManager(), std::move(matrix)));
+    }
+    WaitingExecutionBlockMock upstream{
+        fakedQuery->rootEngine(), generateNodeDummy(), std::move(blockDeque),
+        WaitingExecutionBlockMock::WaitingBehaviour::NEVER};
+
+    AqlValue value{std::string_view{std::string(valueSize, 'x')}};
+    AqlValueGuard guard{value, true};
+    ProduceCall prodCall = [&value](AqlItemBlockInputRange& inputRange,
+                                    OutputAqlItemRow& output)
+        -> std::tuple<ExecutorState, NoStats, AqlCall> {
+      while (inputRange.hasDataRow() && !output.isFull()) {
+        auto [state, input] = inputRange.nextDataRow();
+        output.cloneValueInto(1, input, value);
+        output.advanceRow();
+      }
+      return {inputRange.upstreamState(), NoStats{}, AqlCall{}};
+    };
+    ExecutionBlockImpl<LambdaExe> testee{
+        fakedQuery->rootEngine(), generateNodeDummy(), makeRegisterInfos(0, 1),
+        makeSkipExecutorInfos(prodCall, generateNeverSkipCall())};
+    testee.addDependency(&upstream);
+
+    auto stack = buildStack(AqlCall{});
+    auto [state, skipped, first] = testee.execute(stack);
+    EXPECT_EQ(state, ExecutionState::HASMORE);
+    auto second = std::get<SharedAqlItemBlockPtr>(testee.execute(stack));
+    EXPECT_NE(first, nullptr);
+    EXPECT_NE(second, nullptr);
+    if (first == nullptr || second == nullptr) {
+      return {0, 0};
+    }
+    return {first->numRows(), second->numRows()};
+  }
+};
+
+TEST_F(ExecutionBlockImplAdaptiveBatchSizeTest, narrow_rows_keep_batch_size) {
+  auto [first, second] = producedBlockSizes(8);
+  EXPECT_EQ(first, ExecutionBlock::DefaultBatchSize);
+  EXPECT_EQ(second, ExecutionBlock::DefaultBatchSize);
+}
+
+TEST_F(ExecutionBlockImplAdaptiveBatchSizeTest, wide_rows_get_smaller_blocks) {
+  // nothing is known about the rows of the first block. the next block is
+  // sized so that it uses about 1 MB
+  auto [first, second] = producedBlockSizes(4096);
+  EXPECT_EQ(first, ExecutionBlock::DefaultBatchSize);
+  EXPECT_GE(second, 64U);
+  EXPECT_LE(second, 256U);
+}
+
 }  // namespace aql
 }  // namespace tests
 }  // namespace arangodb
@@ -41,6 +41,7 @@
 #include "Basics/ResourceUsage.h"
 
 #include <velocypack/Builder.h>
+#include <velocypack/Parser.h>
 
 using namespace arangodb;
 using namespace arangodb::aql;
@@ -177,6 +178,30 @@ TEST_P(FilterExecutorTest, skip_and_odd_values) {
       .run();
 }
 
+TEST_P(FilterExecutorTest, soft_limit_and_odd_values) {
+  auto registerInfos = buildRegisterInfos();
+  auto executorInfos = buildExecutorInfos();
+  AqlCall call{};
+  call.softLimit = 3u;
+  ExecutionStats{};
+  makeExecutorTestHelper<2, 2>()
+      .addConsumer<FilterExecutor>(std::move(registerInfos),
+                                   std::move(executorInfos))
+      .setInputValue(MatrixBuilder<2>{RowBuilder<2>{1, 0}, RowBuilder<2>{0, 1},
+                                      RowBuilder<2>{1, 2}, RowBuilder<2>{0, 3},
+                                      RowBuilder<2>{1, 4}, RowBuilder<2>{0, 5},
+                                      RowBuilder<2>{1, 6}, RowBuilder<2>{0, 7}})
+      .setInputSplitType(getSplit())
+      .setCall(call)
+      .expectOutput({0, 1},
+                    MatrixBuilder<2>{RowBuilder<2>{1, 0}, RowBuilder<2>{1, 2},
+                                     RowBuilder<2>{1, 4}})
+      .allowAnyOutputOrder(false)
+      .expectSkipped(0)
+      .expectedState(ExecutionState::HASMORE)
+      .run();
+}
+
 TEST_P(FilterExecutorTest, hard_limit) {
   auto registerInfos = buildRegisterInfos();
   auto executorInfos = buildExecutorInfos();
@@ -195,6 +220,45 @@ TEST_P(FilterExecutorTest, hard_limit) {
       .expectSkipped(0)
       .expectedState(ExecutionState::DONE)
       .run();
+}
+
+TEST_P(FilterExecutorTest, full_output_resumes_with_rest_of_batch) {
+  // every third row passes the filter, and the output only has room for
+  // two rows per call, so the batch is consumed over multiple calls
+  constexpr size_t numRows = 10;
+  auto registerInfos = buildRegisterInfos();
+  auto executorInfos = buildExecutorInfos();
+  auto fakeUnusedBlock = VPackParser::fromJson("[  ]");
+  SingleRowFetcherHelper<::arangodb::aql::BlockPassthrough::Disable> fetcher(
+      itemBlockManager, fakeUnusedBlock->steal(), false);
+  FilterExecutor testee(fetcher, executorInfos);
+
+  SharedAqlItemBlockPtr inBlock = itemBlockManager.requestBlock(numRows, 2);
+  for (size_t i = 0; i < numRows; ++i) {
+    inBlock->emplaceValue(i, 0, AqlValueHintBool(i % 3 == 0));
+    inBlock->emplaceValue(i, 1, AqlValueHintInt(int64_t(i)));
+  }
+  AqlItemBlockInputRange input{MainQueryState::DONE, 0, inBlock, 0};
+
+  std::vector<int64_t> values;
+  std::uint64_t filtered = 0;
+  while (input.hasDataRow()) {
+    OutputAqlItemRow output(itemBlockManager.requestBlock(2, 2),
+                            registerInfos.getOutputRegisters(),
+                            registerInfos.registersToKeep(),
+                            registerInfos.registersToClear());
+    output.setCall(AqlCall{});
+    auto const [state, stats, call] = testee.produceRows(input, output);
+    filtered += stats.getFiltered();
+
+    size_t const written = output.numRowsWritten();
+    auto result = output.stealBlock();
+    for (size_t i = 0; i < written; ++i) {
+      values.emplace_back(result->getValueReference(i, 1).toInt64());
+    }
+  }
+  EXPECT_EQ((std::vector<int64_t>{0, 3, 6, 9}), values);
+  EXPECT_EQ(numRows - values.size(), filtered);
 }  // namespace aql
 
 }  // namespace aql
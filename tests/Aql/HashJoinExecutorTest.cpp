@@ -0,0 +1,166 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+
+#include "AqlExecutorTestCase.h"
+#include "IResearch/common.h"
+#include "Mocks/Servers.h"
+#include "QueryHelper.h"
+
+#include "Aql/OptimizerRule.h"
+#include "Aql/QueryResult.h"
+#include "VocBase/LogicalCollection.h"
+#include "VocBase/vocbase.h"
+
+#include <velocypack/Iterator.h>
+#include <velocypack/Parser.h>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+namespace arangodb {
+namespace tests {
+namespace aql {
+
+// the values are chosen so that some documents have no join partner,
+// some have multiple ones, and numbers compare equal across their types
+static const std::string InsertLeft =
+    R"aql(FOR v IN [1, 2, 2.0, 3, null, "a", [1, 2], {x: 1}]
+            INSERT {value: v} INTO UnitTestHashJoinLeft)aql";
+
+static const std::string InsertRight =
+    R"aql(FOR i IN 0..9
+            INSERT {_key: CONCAT("r", i),
+                    sub: {value: [2, "a", 3, null, [1, 2], 5][i % 6]}}
+            INTO UnitTestHashJoinRight)aql";
+
+static const std::string JoinQuery =
+    R"aql(FOR l IN UnitTestHashJoinLeft
+            FOR r IN UnitTestHashJoinRight
+              FILTER l.value == r.sub.value
+              SORT r._key, l.value
+              RETURN [l.value, r._key])aql";
+
+static const std::string JoinQueryExpected =
+    R"([[2, "r0"], [2, "r0"], ["a", "r1"], [3, "r2"], [null, "r3"],
+        [[1, 2], "r4"], [2, "r6"], [2, "r6"], ["a", "r7"], [3, "r8"],
+        [null, "r9"]])";
+
+class HashJoinExecutorTest : public AqlExecutorTestCase<false> {
+ protected:
+  TRI_vocbase_t& vocbase;
+
+  HashJoinExecutorTest() : vocbase(_server->getSystemDatabase()) {
+    for (std::string name :
+         {"UnitTestHashJoinLeft", "UnitTestHashJoinRight"}) {
+      if (vocbase.lookupCollection(name) == nullptr) {
+        auto json = VPackParser::fromJson(R"({"name":")" + name + R"("})");
+        auto collection = vocbase.createCollection(json->slice());
+        EXPECT_NE(collection, nullptr);
+      }
+    }
+  }
+
+  void insertDocuments() {
+    auto const empty = VPackSlice::emptyArraySlice();
+    AssertQueryHasResult(vocbase, InsertLeft, empty);
+    AssertQueryHasResult(vocbase, InsertRight, empty);
+  }
+
+  void removeDocuments() {
+    auto const empty = VPackSlice::emptyArraySlice();
+    AssertQueryHasResult(
+        vocbase,
+        "FOR doc IN UnitTestHashJoinLeft REMOVE doc IN UnitTestHashJoinLeft",
+        empty);
+    AssertQueryHasResult(
+        vocbase,
+        "FOR doc IN UnitTestHashJoinRight REMOVE doc IN UnitTestHashJoinRight",
+        empty);
+  }
+
+  void assertJoinResult(std::string const& options) {
+    SCOPED_TRACE("Options: " + options);
+    auto expected = VPackParser::fromJson(JoinQueryExpected);
+    auto result = executeQuery(vocbase, JoinQuery, nullptr, options);
+    AssertQueryResultToSlice(result, expected->slice());
+  }
+};
+
+TEST_F(HashJoinExecutorTest, rule_is_applied) {
+  EXPECT_TRUE(assertRules(vocbase, JoinQuery,
+                          {static_cast<int>(OptimizerRule::hashJoinRule)}));
+}
+
+TEST_F(HashJoinExecutorTest, rule_is_not_applied_without_outer_loop) {
+  std::string const query =
+      R"aql(FOR r IN UnitTestHashJoinRight
+              FILTER r.sub.value == 2
+              RETURN r)aql";
+  auto result = explainQuery(vocbase, query);
+  ASSERT_TRUE(result.ok());
+  for (auto rule : VPackArrayIterator(result.data->slice().get("rules"))) {
+    EXPECT_FALSE(rule.isEqualString("hash-join"));
+  }
+}
+
+TEST_F(HashJoinExecutorTest, join_produces_matches) {
+  insertDocuments();
+  assertJoinResult("{}");
+  removeDocuments();
+}
+
+TEST_F(HashJoinExecutorTest, join_without_hash_join_rule) {
+  insertDocuments();
+  assertJoinResult(R"({"optimizer": {"rules": ["-hash-join"]}})");
+  removeDocuments();
+}
+
+TEST_F(HashJoinExecutorTest, join_falls_back_to_scan_with_low_row_limit) {
+  insertDocuments();
+  assertJoinResult(R"({"spillOverThresholdNumRows": 3})");
+  removeDocuments();
+}
+
+TEST_F(HashJoinExecutorTest, join_falls_back_to_scan_with_low_memory_limit) {
+  insertDocuments();
+  assertJoinResult(R"({"spillOverThresholdMemoryUsage": 128})");
+  removeDocuments();
+}
+
+TEST_F(HashJoinExecutorTest, join_with_limit) {
+  insertDocuments();
+  std::string const query =
+      R"aql(FOR l IN UnitTestHashJoinLeft
+              FOR r IN UnitTestHashJoinRight
+                FILTER l.value == r.sub.value
+                LIMIT 2, 100
+                COLLECT WITH COUNT INTO cnt
+                RETURN cnt)aql";
+  auto expected = VPackParser::fromJson("[9]");
+  AssertQueryHasResult(vocbase, query, expected->slice());
+  removeDocuments();
+}
+
+}  // namespace aql
+}  // namespace tests
+}  // namespace arangodb
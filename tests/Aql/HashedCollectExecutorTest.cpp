@@ -34,15 +34,18 @@
 #include "Aql/Collection.h"
 #include "Aql/ExecutionEngine.h"
 #include "Aql/HashedCollectExecutor.h"
+#include "Aql/HashedCollectSpillBackend.h"
 #include "Aql/OutputAqlItemRow.h"
 #include "Aql/Query.h"
 #include "Aql/RegisterPlan.h"
 #include "Aql/SingleRowFetcher.h"
 #include "Mocks/Servers.h"
+#include "RestServer/TemporaryStorageFeature.h"
 #include "Transaction/Context.h"
 #include "Transaction/Methods.h"
 
 #include <velocypack/Builder.h>
+#include <algorithm>
 #include <functional>
 
 using namespace arangodb;
@@ -52,6 +55,66 @@ namespace arangodb {
 namespace tests {
 namespace aql {
 
+// keeps the spilled rows in memory, so that spilling can be tested without
+// a directory for intermediate results
+class HashedCollectSpillBackendMock final : public HashedCollectSpillBackend {
+ public:
+  explicit HashedCollectSpillBackendMock(size_t& numStoredRows)
+      : _numStoredRows(numStoredRows) {}
+
+  void storeRow(size_t partition, velocypack::Slice values) override {
+    ASSERT_FALSE(_sealed);
+    velocypack::Builder builder;
+    builder.add(values);
+    _rows.emplace_back(partition, std::move(builder));
+    ++_numStoredRows;
+  }
+
+  void seal() override {
+    _sealed = true;
+    std::stable_sort(_rows.begin(), _rows.end(),
+                     [](auto const& lhs, auto const& rhs) {
+                       return lhs.first < rhs.first;
+                     });
+  }
+
+  bool hasMore() const override {
+    EXPECT_TRUE(_sealed);
+    return _position < _rows.size();
+  }
+
+  size_t currentPartition() const override {
+    return _rows[_position].first;
+  }
+
+  velocypack::Slice currentRow() const override {
+    return _rows[_position].second.slice();
+  }
+
+  void next() override { ++_position; }
+
+ private:
+  size_t& _numStoredRows;
+  std::vector<std::pair<size_t, velocypack::Builder>> _rows;
+  size_t _position = 0;
+  bool _sealed = false;
+};
+
+class TemporaryStorageMock final : public TemporaryStorageFeature {
+ public:
+  explicit TemporaryStorageMock(ArangodServer& server)
+      : TemporaryStorageFeature(server) {}
+
+  bool canBeUsed() const noexcept override { return true; }
+
+  std::unique_ptr<HashedCollectSpillBackend> getHashedCollectSpillBackend()
+      override {
+    return std::make_unique<HashedCollectSpillBackendMock>(numStoredRows);
+  }
+
+  size_t numStoredRows = 0;
+};
+
 // This is only to get a split-type. The Type is independent of actual template
 // parameters
 using HashedCollectTestHelper = ExecutorTestHelper<1, 1>;
@@ -115,8 +178,8 @@ class HashedCollectExecutorTest
       std::vector<std::pair<RegisterId, RegisterId>> groupRegisters,
       RegisterId collectRegister = RegisterPlan::MaxRegisterId,
       std::vector<std::string> aggregateTypes = {},
-      std::vector<std::pair<RegisterId, RegisterId>> aggregateRegisters = {})
-      -> HashedCollectExecutorInfos {
+      std::vector<std::pair<RegisterId, RegisterId>> aggregateRegisters = {},
+      size_t parallelism = 1) -> HashedCollectExecutorInfos {
     return HashedCollectExecutorInfos{std::move(groupRegisters),
                                       RegisterPlan::MaxRegisterId,
                                       RegisterPlan::MaxRegisterId,
@@ -125,8 +188,37 @@ class HashedCollectExecutorTest
                                       {},
                                       std::move(aggregateRegisters),
                                       &VPackOptions::Defaults,
-                                      monitor};
+                                      monitor,
+                                      parallelism};
   };
+
+  auto buildSpillingExecutorInfos(
+      std::vector<std::pair<RegisterId, RegisterId>> groupRegisters,
+      std::vector<std::string> aggregateTypes,
+      std::vector<std::pair<RegisterId, RegisterId>> aggregateRegisters,
+      size_t spillOverThresholdNumRows, size_t spillOverThresholdMemoryUsage)
+      -> HashedCollectExecutorInfos {
+    if (tempStorage == nullptr) {
+      tempStorage = std::make_unique<TemporaryStorageMock>(
+          fakedQuery->vocbase().server());
+    }
+    return HashedCollectExecutorInfos{std::move(groupRegisters),
+                                      RegisterPlan::MaxRegisterId,
+                                      RegisterPlan::MaxRegisterId,
+                                      nullptr,
+                                      std::move(aggregateTypes),
+                                      {},
+                                      std::move(aggregateRegisters),
+                                      &VPackOptions::Defaults,
+                                      monitor,
+                                      /*parallelism*/ 1,
+                                      tempStorage.get(),
+                                      spillOverThresholdNumRows,
+                                      spillOverThresholdMemoryUsage,
+                                      /*useValueArena*/ true};
+  }
+
+  std::unique_ptr<TemporaryStorageMock> tempStorage;
 };
 
 template<size_t... vs>
@@ -467,6 +559,137 @@ TEST_P(HashedCollectExecutorTest, many_aggregators) {
       .run();
 }
 
+// Collect with multiple aggregators, aggregated in multiple partitions
+TEST_P(HashedCollectExecutorTest, many_aggregators_parallel) {
+  auto registerInfos =
+      buildRegisterInfos(2, 5, {{2, 0}}, RegisterPlan::MaxRegisterId,
+                         {{3, RegisterPlan::MaxRegisterId}, {4, 1}});
+  auto executorInfos = buildExecutorInfos(
+      2, 5, {{2, 0}}, RegisterPlan::MaxRegisterId, {"LENGTH", "SUM"},
+      {{3, RegisterPlan::MaxRegisterId}, {4, 1}}, 3);
+  AqlCall call{};          // unlimited produce
+  ExecutionStats stats{};  // No stats here
+  makeExecutorTestHelper<2, 3>()
+      .addConsumer<HashedCollectExecutor>(std::move(registerInfos),
+                                          std::move(executorInfos))
+      .setInputValue(MatrixBuilder<2>{RowBuilder<2>{1, 5}, RowBuilder<2>{1, 1},
+                                      RowBuilder<2>{2, 2}, RowBuilder<2>{1, 5},
+                                      RowBuilder<2>{6, 1}, RowBuilder<2>{2, 2},
+                                      RowBuilder<2>{3, 1}})
+      .setInputSplitType(getSplit())
+      .setCall(call)
+      .expectOutput(
+          {2, 3, 4},
+          MatrixBuilder<3>{RowBuilder<3>{1, 3, 11}, RowBuilder<3>{2, 2, 4},
+                           RowBuilder<3>{6, 1, 1}, RowBuilder<3>{3, 1, 1}})
+      .allowAnyOutputOrder(true)
+      .expectSkipped(0)
+      .expectedState(ExecutionState::DONE)
+      .appendEmptyBlock(appendEmpty())
+      // .expectedStats(stats)
+      .run();
+}
+
+// Collect with multiple group values, aggregated in multiple partitions
+TEST_P(HashedCollectExecutorTest, collect_multiple_values_parallel) {
+  auto registerInfos = buildRegisterInfos(2, 4, {{2, 0}, {3, 1}});
+  auto executorInfos = buildExecutorInfos(
+      2, 4, {{2, 0}, {3, 1}}, RegisterPlan::MaxRegisterId, {}, {}, 4);
+  AqlCall call{};
+  call.offset = 2;         // skip some
+  call.softLimit = 1000u;  // high limit
+  ExecutionStats stats{};  // No stats here
+  makeExecutorTestHelper<2, 2>()
+      .addConsumer<HashedCollectExecutor>(std::move(registerInfos),
+                                          std::move(executorInfos))
+      .setInputValue(MatrixBuilder<2>{RowBuilder<2>{1, 5}, RowBuilder<2>{1, 1},
+                                      RowBuilder<2>{2, 2}, RowBuilder<2>{1, 5},
+                                      RowBuilder<2>{6, 1}, RowBuilder<2>{2, 2},
+                                      RowBuilder<2>{R"("1")", 1}})
+      .setInputSplitType(getSplit())
+      .setCall(call)
+      .expectOutput({2, 3},
+                    MatrixBuilder<2>{RowBuilder<2>{1, 5}, RowBuilder<2>{1, 1},
+                                     RowBuilder<2>{2, 2}, RowBuilder<2>{6, 1},
+                                     RowBuilder<2>{R"("1")", 1}})
+      .allowAnyOutputOrder(true, 2)
+      .expectSkipped(2)
+      .expectedState(ExecutionState::DONE)
+      // .expectedStats(stats)
+      .run();
+}
+
+// Rows of new groups are spilled once there are too many groups in memory,
+// and are aggregated after the groups in memory have been returned
+TEST_P(HashedCollectExecutorTest, spilled_groups_are_merged) {
+  auto registerInfos =
+      buildRegisterInfos(2, 5, {{2, 0}}, RegisterPlan::MaxRegisterId,
+                         {{3, RegisterPlan::MaxRegisterId}, {4, 1}});
+  auto executorInfos = buildSpillingExecutorInfos(
+      {{2, 0}}, {"LENGTH", "SUM"}, {{3, RegisterPlan::MaxRegisterId}, {4, 1}},
+      /*spillOverThresholdNumRows*/ 2,
+      /*spillOverThresholdMemoryUsage*/ std::numeric_limits<size_t>::max());
+  AqlCall call{};  // unlimited produce
+  makeExecutorTestHelper<2, 3>()
+      .addConsumer<HashedCollectExecutor>(std::move(registerInfos),
+                                          std::move(executorInfos))
+      .setInputValue(MatrixBuilder<2>{
+          RowBuilder<2>{1, 5}, RowBuilder<2>{2, 1}, RowBuilder<2>{3, 1},
+          RowBuilder<2>{1, 1}, RowBuilder<2>{4, 2}, RowBuilder<2>{3, 3},
+          RowBuilder<2>{5, 1}, RowBuilder<2>{2, 2}, RowBuilder<2>{4, 4}})
+      .setInputSplitType(getSplit())
+      .setCall(call)
+      .expectOutput(
+          {2, 3, 4},
+          MatrixBuilder<3>{RowBuilder<3>{1, 2, 6}, RowBuilder<3>{2, 2, 3},
+                           RowBuilder<3>{3, 2, 4}, RowBuilder<3>{4, 2, 6},
+                           RowBuilder<3>{5, 1, 1}})
+      .allowAnyOutputOrder(true)
+      .expectSkipped(0)
+      .expectedState(ExecutionState::DONE)
+      .appendEmptyBlock(appendEmpty())
+      .run();
+
+  // spilling starts with the third group, after which only the rows of the
+  // groups 4 and 5 are spilled
+  ASSERT_NE(nullptr, tempStorage);
+  EXPECT_EQ(3, tempStorage->numStoredRows);
+}
+
+// The memory of the aggregators counts towards the spill-over threshold,
+// not only the memory of the group values
+TEST_P(HashedCollectExecutorTest, aggregator_memory_starts_spilling) {
+  auto registerInfos = buildRegisterInfos(
+      2, 4, {{2, 0}}, RegisterPlan::MaxRegisterId, {{3, 1}});
+  auto executorInfos = buildSpillingExecutorInfos(
+      {{2, 0}}, {"COUNT_DISTINCT"}, {{3, 1}},
+      /*spillOverThresholdNumRows*/ std::numeric_limits<size_t>::max(),
+      /*spillOverThresholdMemoryUsage*/ 1024);
+  AqlCall call{};  // unlimited produce
+  makeExecutorTestHelper<2, 2>()
+      .addConsumer<HashedCollectExecutor>(std::move(registerInfos),
+                                          std::move(executorInfos))
+      .setInputValue(MatrixBuilder<2>{
+          RowBuilder<2>{1, 1}, RowBuilder<2>{1, 2}, RowBuilder<2>{2, 1},
+          RowBuilder<2>{3, 5}, RowBuilder<2>{2, 2}, RowBuilder<2>{1, 2},
+          RowBuilder<2>{3, 6}})
+      .setInputSplitType(getSplit())
+      .setCall(call)
+      .expectOutput({2, 3}, MatrixBuilder<2>{RowBuilder<2>{1, 2},
+                                             RowBuilder<2>{2, 2},
+                                             RowBuilder<2>{3, 2}})
+      .allowAnyOutputOrder(true)
+      .expectSkipped(0)
+      .expectedState(ExecutionState::DONE)
+      .appendEmptyBlock(appendEmpty())
+      .run();
+
+  // the distinct values of the first group alone exceed the threshold, so
+  // all rows of the other groups are spilled
+  ASSERT_NE(nullptr, tempStorage);
+  EXPECT_EQ(4, tempStorage->numStoredRows);
+}
+
 // Collect based on equal arrays.
 TEST_P(HashedCollectExecutorTest, collect_arrays) {
   auto registerInfos = buildRegisterInfos(1, 2, {{1, 0}});
@@ -0,0 +1,94 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+
+#include "Aql/JoinOrderEnumerator.h"
+
+#include <vector>
+
+using namespace arangodb::aql;
+
+TEST(JoinOrderEnumeratorTest, cost_of_cross_product) {
+  JoinOrderEnumerator enumerator;
+  enumerator.addRelation(10.0, 10.0);
+  enumerator.addRelation(5.0, 5.0);
+
+  // 10 rows from the outer loop, then 5 rows for each of them
+  EXPECT_DOUBLE_EQ(20.0 + 100.0, enumerator.cost({0, 1}));
+  EXPECT_DOUBLE_EQ(10.0 + 100.0, enumerator.cost({1, 0}));
+}
+
+TEST(JoinOrderEnumeratorTest, keeps_original_order_if_not_better) {
+  JoinOrderEnumerator enumerator;
+  enumerator.addRelation(100.0, 100.0);
+  enumerator.addRelation(100.0, 100.0);
+  enumerator.addRelation(100.0, 100.0);
+  enumerator.addJoin(0, 1, 1.0, 8.0);
+  enumerator.addJoin(1, 0, 1.0, 8.0);
+
+  EXPECT_EQ((std::vector<size_t>{0, 1, 2}), enumerator.findOrder());
+}
+
+TEST(JoinOrderEnumeratorTest, starts_with_most_selective_loop) {
+  JoinOrderEnumerator enumerator;
+  // a large collection, joined with four small ones via their primary keys.
+  // only one document of the second collection passes its filter
+  size_t fact = enumerator.addRelation(100000.0, 100000.0);
+  size_t selective = enumerator.addRelation(1.0, 8.0);
+  for (size_t i = 0; i < 3; ++i) {
+    size_t dimension = enumerator.addRelation(100.0, 100.0);
+    enumerator.addJoin(fact, dimension, 1.0, 8.0);
+    enumerator.addJoin(dimension, fact, 1000.0, 1017.0);
+  }
+  enumerator.addJoin(fact, selective, 0.01, 8.0);
+  enumerator.addJoin(selective, fact, 1000.0, 1017.0);
+
+  auto order = enumerator.findOrder();
+  ASSERT_EQ(5, order.size());
+  EXPECT_EQ(selective, order[0]);
+  EXPECT_EQ(fact, order[1]);
+  EXPECT_LT(enumerator.cost(order), enumerator.cost({0, 1, 2, 3, 4}));
+}
+
+TEST(JoinOrderEnumeratorTest, avoids_cross_products) {
+  JoinOrderEnumerator enumerator;
+  // the first and the last loop are only joined via the middle one, which
+  // does not have any index
+  enumerator.addRelation(1.0, 1.0);
+  enumerator.addRelation(1000.0, 1000.0);
+  enumerator.addRelation(1.0, 1.0);
+  enumerator.addJoin(0, 1, 50.0, 1000.0);
+  enumerator.addJoin(2, 1, 50.0, 1000.0);
+  enumerator.addJoin(1, 0, 0.05, 1.0);
+  enumerator.addJoin(1, 2, 0.05, 1.0);
+
+  // the cross product of the small loops is cheaper in this cost model,
+  // but the cross product is not considered as there are join conditions
+  ASSERT_LT(enumerator.cost({0, 2, 1}), enumerator.cost({0, 1, 2}));
+  EXPECT_EQ((std::vector<size_t>{0, 1, 2}), enumerator.findOrder());
+}
+
+TEST(JoinOrderEnumeratorTest, single_relation) {
+  JoinOrderEnumerator enumerator;
+  enumerator.addRelation(10.0, 10.0);
+  EXPECT_EQ((std::vector<size_t>{0}), enumerator.findOrder());
+}
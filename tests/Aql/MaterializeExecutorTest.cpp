@@ -0,0 +1,198 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+
+#include "AqlExecutorTestCase.h"
+#include "Mocks/Servers.h"
+#include "QueryHelper.h"
+#include "RowFetcherHelper.h"
+
+#include "Aql/AqlItemBlock.h"
+#include "Aql/AqlItemBlockInputRange.h"
+#include "Aql/MaterializeExecutor.h"
+#include "Aql/OutputAqlItemRow.h"
+#include "Aql/Query.h"
+#include "Aql/RegisterInfos.h"
+#include "Aql/Stats.h"
+#include "StorageEngine/PhysicalCollection.h"
+#include "Transaction/Methods.h"
+#include "VocBase/LogicalCollection.h"
+#include "VocBase/vocbase.h"
+
+#include <velocypack/Parser.h>
+
+#include <limits>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+namespace arangodb {
+namespace tests {
+namespace aql {
+
+static const std::string CollectionName = "UnitTestMaterialize";
+
+static const std::string InsertDocuments =
+    R"aql(FOR i IN 1..5
+            INSERT {_key: CONCAT("k", i), value: i}
+            INTO UnitTestMaterialize)aql";
+
+// materializes the documents with the LocalDocumentIds in register 0 into
+// register 1, reading them from the collection in batches
+class MaterializeExecutorTest : public AqlExecutorTestCase<false> {
+ protected:
+  using Executor = MaterializeExecutor<std::string const&, true>;
+
+  TRI_vocbase_t& vocbase;
+  std::shared_ptr<LogicalCollection> collection;
+  std::shared_ptr<Query> materializeQuery;
+  RegisterInfos registerInfos;
+  MaterializerExecutorInfos<std::string const&> executorInfos;
+  SingleRowFetcherHelper<BlockPassthrough::Disable> fetcher;
+
+  MaterializeExecutorTest()
+      : vocbase(_server->getSystemDatabase()),
+        collection(createCollection(vocbase)),
+        materializeQuery(_server->createFakeQuery(
+            false, "FOR d IN " + CollectionName + " RETURN d")),
+        registerInfos(RegIdSet{0}, RegIdSet{1}, 1, 2, {},
+                      RegIdSetStack{RegIdSet{0}}),
+        executorInfos(0, 1, *materializeQuery, CollectionName),
+        fetcher(itemBlockManager, VPackParser::fromJson("[]")->steal(),
+                false) {}
+
+  static auto createCollection(TRI_vocbase_t& vocbase)
+      -> std::shared_ptr<LogicalCollection> {
+    auto collection = vocbase.lookupCollection(CollectionName);
+    if (collection == nullptr) {
+      auto json =
+          VPackParser::fromJson(R"({"name":")" + CollectionName + R"("})");
+      collection = vocbase.createCollection(json->slice());
+      EXPECT_NE(collection, nullptr);
+      AssertQueryHasResult(vocbase, InsertDocuments,
+                           VPackSlice::emptyArraySlice());
+    }
+    return collection;
+  }
+
+  auto documentId(std::string_view key) -> uint64_t {
+    transaction::Methods trx(materializeQuery->newTrxContext());
+    std::pair<LocalDocumentId, RevisionId> result;
+    EXPECT_TRUE(collection->getPhysical()
+                    ->lookupKey(&trx, key, result, ReadOwnWrites::no)
+                    .ok());
+    return result.first.id();
+  }
+
+  auto buildInput(std::vector<uint64_t> const& ids) -> SharedAqlItemBlockPtr {
+    SharedAqlItemBlockPtr block{
+        new AqlItemBlock(itemBlockManager, ids.size(), 1)};
+    for (size_t i = 0; i < ids.size(); ++i) {
+      block->setValue(i, 0, AqlValue(AqlValueHintUInt(ids[i])));
+    }
+    return block;
+  }
+
+  auto makeOutput(size_t numRows) -> OutputAqlItemRow {
+    return OutputAqlItemRow(
+        SharedAqlItemBlockPtr{new AqlItemBlock(itemBlockManager, numRows, 2)},
+        registerInfos.getOutputRegisters(), registerInfos.registersToKeep(),
+        registerInfos.registersToClear());
+  }
+
+  static auto values(OutputAqlItemRow& output) -> std::vector<int> {
+    auto block = output.stealBlock();
+    std::vector<int> result;
+    for (size_t i = 0; i < block->numRows(); ++i) {
+      result.emplace_back(
+          block->getValueReference(i, 1).slice().get("value").getNumber<int>());
+    }
+    return result;
+  }
+};
+
+TEST_F(MaterializeExecutorTest, documents_are_written_in_input_order) {
+  uint64_t const missing = std::numeric_limits<uint64_t>::max() - 1;
+  AqlItemBlockInputRange input{
+      MainQueryState::DONE, 0,
+      buildInput({documentId("k3"), documentId("k1"), missing,
+                  documentId("k5"), documentId("k2")}),
+      0};
+  auto output = makeOutput(100);
+  Executor testee(fetcher, executorInfos);
+
+  auto const [state, stats, call] = testee.produceRows(input, output);
+  EXPECT_EQ(ExecutorState::DONE, state);
+  EXPECT_FALSE(input.hasDataRow());
+  // the document that is not found is counted as filtered
+  EXPECT_EQ(1U, stats.getFiltered());
+  EXPECT_EQ(4U, output.numRowsWritten());
+  EXPECT_EQ((std::vector<int>{3, 1, 5, 2}), values(output));
+}
+
+TEST_F(MaterializeExecutorTest, missing_documents_at_the_end_are_filtered) {
+  uint64_t const missing = std::numeric_limits<uint64_t>::max() - 1;
+  AqlItemBlockInputRange input{
+      MainQueryState::DONE, 0,
+      buildInput({documentId("k4"), missing, missing - 1}), 0};
+  auto output = makeOutput(100);
+  Executor testee(fetcher, executorInfos);
+
+  auto const [state, stats, call] = testee.produceRows(input, output);
+  EXPECT_EQ(ExecutorState::DONE, state);
+  EXPECT_EQ(2U, stats.getFiltered());
+  EXPECT_EQ(1U, output.numRowsWritten());
+  EXPECT_EQ((std::vector<int>{4}), values(output));
+}
+
+TEST_F(MaterializeExecutorTest, full_output_resumes_with_next_input_row) {
+  // only as many input rows are read as fit into the output block, the
+  // others are left for the next call
+  AqlItemBlockInputRange input{
+      MainQueryState::DONE, 0,
+      buildInput({documentId("k1"), documentId("k2"), documentId("k3"),
+                  documentId("k4"), documentId("k5")}),
+      0};
+  Executor testee(fetcher, executorInfos);
+
+  {
+    auto output = makeOutput(2);
+    auto const [state, stats, call] = testee.produceRows(input, output);
+    EXPECT_TRUE(input.hasDataRow());
+    EXPECT_EQ(0U, stats.getFiltered());
+    EXPECT_TRUE(output.isFull());
+    EXPECT_EQ((std::vector<int>{1, 2}), values(output));
+  }
+  {
+    auto output = makeOutput(100);
+    auto const [state, stats, call] = testee.produceRows(input, output);
+    EXPECT_EQ(ExecutorState::DONE, state);
+    EXPECT_FALSE(input.hasDataRow());
+    EXPECT_EQ(0U, stats.getFiltered());
+    EXPECT_EQ(3U, output.numRowsWritten());
+    EXPECT_EQ((std::vector<int>{3, 4, 5}), values(output));
+  }
+}
+
+}  // namespace aql
+}  // namespace tests
+}  // namespace arangodb
@@ -0,0 +1,253 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+
+#include "AqlExecutorTestCase.h"
+#include "AqlItemBlockHelper.h"
+#include "ExecutorTestHelper.h"
+#include "IResearch/common.h"
+#include "Mocks/Servers.h"
+#include "QueryHelper.h"
+#include "RowFetcherHelper.h"
+
+#include "Aql/AqlCall.h"
+#include "Aql/AqlCallStack.h"
+#include "Aql/AqlItemBlockInputRange.h"
+#include "Aql/Collection.h"
+#include "Aql/ExecutionBlockImpl.h"
+#include "Aql/MergeJoinExecutor.h"
+#include "Aql/OutputAqlItemRow.h"
+#include "Aql/Projections.h"
+#include "Aql/RegisterInfos.h"
+#include "Aql/SubqueryStartExecutor.h"
+#include "Aql/Variable.h"
+#include "Basics/Exceptions.h"
+#include "Indexes/Index.h"
+#include "VocBase/LogicalCollection.h"
+#include "VocBase/vocbase.h"
+
+#include <velocypack/Parser.h>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+namespace arangodb {
+namespace tests {
+namespace aql {
+
+static const std::string CollectionName = "UnitTestMergeJoin";
+
+// multiple documents per value, and values without any document
+static const std::string InsertDocuments =
+    R"aql(FOR d IN [[1, "a"], [2, "b"], [2, "c"], [4, "d"], [5, "e"],
+                   [5, "f"]]
+            INSERT {value: d[0], tag: d[1]} INTO UnitTestMergeJoin)aql";
+
+class MergeJoinExecutorTest : public AqlExecutorTestCase<false> {
+ protected:
+  TRI_vocbase_t& vocbase;
+  std::shared_ptr<Index> index;
+  Variable outVariable;
+  Collection aqlCollection;
+
+  MergeJoinExecutorTest()
+      : vocbase(_server->getSystemDatabase()),
+        outVariable("doc", 1, false, monitor),
+        aqlCollection(CollectionName, &vocbase,
+                      arangodb::AccessMode::Type::READ,
+                      arangodb::aql::Collection::Hint::Collection) {
+    auto collection = vocbase.lookupCollection(CollectionName);
+    if (collection == nullptr) {
+      auto json =
+          VPackParser::fromJson(R"({"name":")" + CollectionName + R"("})");
+      collection = vocbase.createCollection(json->slice());
+      EXPECT_NE(collection, nullptr);
+      AssertQueryHasResult(vocbase, InsertDocuments,
+                           VPackSlice::emptyArraySlice());
+      auto definition = VPackParser::fromJson(
+          R"({"type":"persistent","fields":["value"],"sparse":false})");
+      bool created = false;
+      EXPECT_NE(collection->createIndex(definition->slice(), created),
+                nullptr);
+    }
+    for (auto const& it : collection->getIndexes()) {
+      if (it->type() == Index::TRI_IDX_TYPE_PERSISTENT_INDEX) {
+        index = it;
+      }
+    }
+    EXPECT_NE(index, nullptr);
+  }
+
+  auto makeSubqueryStartRegisterInfos() -> RegisterInfos {
+    return RegisterInfos(RegIdSet{0}, {}, 1, 1, {},
+                         RegIdSetStack{RegIdSet{0}, RegIdSet{0}});
+  }
+
+  auto makeSubqueryStartExecutorInfos() -> SubqueryStartExecutor::Infos {
+    return SubqueryStartExecutor::Infos(RegIdSet{0}, {}, 1, 1, {},
+                                        RegIdSetStack{RegIdSet{0}});
+  }
+
+  // the probe value is the "value" attribute of register 0, the
+  // "tag" attribute of the matching documents is written to register 1
+  auto makeRegisterInfos(size_t subqueryDepth = 0) -> RegisterInfos {
+    RegIdSetStack toKeep{RegIdSet{0}};
+    for (size_t i = 0; i < subqueryDepth; ++i) {
+      toKeep.emplace_back(RegIdSet{0});
+    }
+    return RegisterInfos(RegIdSet{0}, RegIdSet{1}, 1, 2, {},
+                         std::move(toKeep));
+  }
+
+  auto makeExecutorInfos(bool ascending) -> MergeJoinExecutorInfos {
+    std::vector<AttributeNamePath> paths;
+    paths.emplace_back(AttributeNamePath("tag", monitor));
+    auto base = IndexExecutorInfos(
+        1, *fakedQuery, &aqlCollection, &outVariable,
+        /*produceResult*/ true, nullptr, Projections(std::move(paths)), {}, {},
+        NonConstExpressionContainer{}, /*count*/ false, ReadOwnWrites::no,
+        nullptr, /*oneIndexCondition*/ true, {index}, fakedQuery->ast(),
+        IndexIteratorOptions{}, {}, {});
+    std::vector<MergeJoinExecutorInfos::ProbeKey> probeKeys;
+    probeKeys.emplace_back(0, std::vector<std::string>{"value"});
+    return MergeJoinExecutorInfos(std::move(base), std::move(probeKeys),
+                                  ascending);
+  }
+};
+
+TEST_F(MergeJoinExecutorTest, duplicate_keys) {
+  makeExecutorTestHelper<1, 1>()
+      .addConsumer<MergeJoinExecutor>(makeRegisterInfos(),
+                                      makeExecutorInfos(true))
+      .setInputValue({{R"({"value": 1})"},
+                      {R"({"value": 2})"},
+                      {R"({"value": 2})"},
+                      {R"({"value": 3})"},
+                      {R"({"value": 5})"}})
+      .setInputSplitStep(2)
+      .setCall(AqlCall{})
+      .expectOutput({1}, {{R"({"tag": "a"})"},
+                          {R"({"tag": "b"})"},
+                          {R"({"tag": "c"})"},
+                          {R"({"tag": "b"})"},
+                          {R"({"tag": "c"})"},
+                          {R"({"tag": "e"})"},
+                          {R"({"tag": "f"})"}})
+      .expectSkipped(0)
+      .expectedState(ExecutionState::DONE)
+      .run();
+}
+
+TEST_F(MergeJoinExecutorTest, descending) {
+  // the index is read backwards, including the entries with equal values
+  makeExecutorTestHelper<1, 1>()
+      .addConsumer<MergeJoinExecutor>(makeRegisterInfos(),
+                                      makeExecutorInfos(false))
+      .setInputValue({{R"({"value": 5})"},
+                      {R"({"value": 3})"},
+                      {R"({"value": 2})"},
+                      {R"({"value": 2})"},
+                      {R"({"value": 1})"}})
+      .setCall(AqlCall{})
+      .expectOutput({1}, {{R"({"tag": "f"})"},
+                          {R"({"tag": "e"})"},
+                          {R"({"tag": "c"})"},
+                          {R"({"tag": "b"})"},
+                          {R"({"tag": "c"})"},
+                          {R"({"tag": "b"})"},
+                          {R"({"tag": "a"})"}})
+      .expectSkipped(0)
+      .expectedState(ExecutionState::DONE)
+      .run();
+}
+
+TEST_F(MergeJoinExecutorTest, skip_into_duplicate_keys) {
+  makeExecutorTestHelper<1, 1>()
+      .addConsumer<MergeJoinExecutor>(makeRegisterInfos(),
+                                      makeExecutorInfos(true))
+      .setInputValue({{R"({"value": 1})"},
+                      {R"({"value": 2})"},
+                      {R"({"value": 2})"},
+                      {R"({"value": 5})"}})
+      .setCall(AqlCall{2, AqlCall::Infinity{}, AqlCall::Infinity{}, false})
+      .expectOutput({1}, {{R"({"tag": "c"})"},
+                          {R"({"tag": "b"})"},
+                          {R"({"tag": "c"})"},
+                          {R"({"tag": "e"})"},
+                          {R"({"tag": "f"})"}})
+      .expectSkipped(2)
+      .expectedState(ExecutionState::DONE)
+      .run();
+}
+
+TEST_F(MergeJoinExecutorTest, index_is_read_again_after_shadow_rows) {
+  // every input row starts a subquery run of its own, and the lookup values
+  // only need to be sorted within each run
+  AqlCallStack callStack{AqlCallList{AqlCall{}}};
+  callStack.pushCall(AqlCallList{AqlCall{}, AqlCall{}});
+
+  makeExecutorTestHelper<1, 1>()
+      .addConsumer<SubqueryStartExecutor>(makeSubqueryStartRegisterInfos(),
+                                          makeSubqueryStartExecutorInfos(),
+                                          ExecutionNode::SUBQUERY_START)
+      .addConsumer<MergeJoinExecutor>(makeRegisterInfos(1),
+                                      makeExecutorInfos(true))
+      .setInputValue({{R"({"value": 5})"}, {R"({"value": 1})"}})
+      .setCallStack(callStack)
+      .expectOutput({1},
+                    {{R"({"tag": "e"})"},
+                     {R"({"tag": "f"})"},
+                     {NoneEntry{}},
+                     {R"({"tag": "a"})"},
+                     {NoneEntry{}}},
+                    {{2, 0}, {4, 0}})
+      .expectSkipped(0, 0)
+      .expectedState(ExecutionState::DONE)
+      .run();
+}
+
+TEST_F(MergeJoinExecutorTest, unsorted_input_is_an_error) {
+  auto infos = makeExecutorInfos(true);
+  auto registerInfos = makeRegisterInfos();
+  SingleRowFetcherHelper<::arangodb::aql::BlockPassthrough::Disable> fetcher(
+      itemBlockManager, VPackParser::fromJson("[]")->steal(), false);
+  MergeJoinExecutor testee(fetcher, infos);
+
+  SharedAqlItemBlockPtr inBlock = buildBlock<1>(
+      itemBlockManager, {{R"({"value": 5})"}, {R"({"value": 1})"}});
+  AqlItemBlockInputRange inputRange{MainQueryState::DONE, 0, inBlock, 0};
+  OutputAqlItemRow output(
+      SharedAqlItemBlockPtr{new AqlItemBlock(itemBlockManager, 100, 2)},
+      registerInfos.getOutputRegisters(), registerInfos.registersToKeep(),
+      registerInfos.registersToClear());
+
+  try {
+    std::ignore = testee.produceRows(inputRange, output);
+    FAIL() << "expected an exception";
+  } catch (basics::Exception const& ex) {
+    EXPECT_EQ(ex.code(), TRI_ERROR_INTERNAL);
+  }
+}
+
+}  // namespace aql
+}  // namespace tests
+}  // namespace arangodb
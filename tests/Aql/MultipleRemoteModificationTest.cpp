@@ -0,0 +1,216 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Jan Steemann
+////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+
+#include "Mocks/Servers.h"
+
+#include "Aql/MultipleRemoteModificationExecutor.h"
+#include "Aql/Query.h"
+#include "Aql/QueryString.h"
+#include "Basics/Exceptions.h"
+#include "Basics/StaticStrings.h"
+#include "Transaction/StandaloneContext.h"
+#include "Utils/OperationOptions.h"
+#include "Utils/OperationResult.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Iterator.h>
+
+#include <algorithm>
+#include <string>
+#include <tuple>
+#include <vector>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+namespace arangodb::tests::aql {
+
+class MultipleRemoteModificationExplainTest : public ::testing::Test {
+ protected:
+  mocks::MockCoordinator server{"CRDN_0001"};
+
+  MultipleRemoteModificationExplainTest() {
+    std::ignore = server.createCollection(
+        "_system", "UnitTestCollection",
+        {{"s100", "PRMR_0001"}, {"s101", "PRMR_0002"}}, TRI_COL_TYPE_DOCUMENT);
+  }
+
+  // returns the types of all nodes of the plan for the query
+  std::vector<std::string> explain(std::string_view query) {
+    auto q = Query::create(std::make_shared<transaction::StandaloneContext>(
+                               server.getSystemDatabase()),
+                           QueryString(query), nullptr);
+    auto result = q->explain();
+    EXPECT_TRUE(result.result.ok()) << result.result.errorMessage();
+    std::vector<std::string> types;
+    if (result.data != nullptr) {
+      for (VPackSlice node :
+           VPackArrayIterator(result.data->slice().get("nodes"))) {
+        types.emplace_back(node.get("type").copyString());
+      }
+    }
+    return types;
+  }
+
+  static bool usesBatch(std::vector<std::string> const& types) {
+    return std::find(types.begin(), types.end(),
+                     "MultipleRemoteModificationNode") != types.end();
+  }
+};
+
+TEST_F(MultipleRemoteModificationExplainTest, remove_with_string_keys) {
+  auto types = explain(
+      R"aql(FOR k IN ["a", "b", "c"] REMOVE k IN UnitTestCollection)aql");
+  EXPECT_TRUE(usesBatch(types));
+  EXPECT_EQ(std::count(types.begin(), types.end(), "RemoveNode"), 0);
+}
+
+TEST_F(MultipleRemoteModificationExplainTest, update_documents) {
+  for (std::string_view options : {"", " OPTIONS {ignoreErrors: true}"}) {
+    auto types = explain(std::string(R"aql(
+        FOR d IN [{_key: "a", value: 1}, {_key: "missing", value: 2}]
+        UPDATE d IN UnitTestCollection)aql") +
+                         std::string(options));
+    EXPECT_TRUE(usesBatch(types)) << options;
+    EXPECT_EQ(std::count(types.begin(), types.end(), "UpdateNode"), 0);
+  }
+}
+
+TEST_F(MultipleRemoteModificationExplainTest, update_key_with_doc) {
+  // key and document cannot be passed as a single array
+  for (std::string_view query : {
+           R"aql(FOR d IN [{_key: "a"}, {_key: "b"}]
+                 UPDATE d._key WITH {value: 1} IN UnitTestCollection)aql",
+           R"aql(FOR k IN ["a", "b"]
+                 UPDATE k WITH {value: 1} IN UnitTestCollection)aql",
+           R"aql(FOR k IN ["a", "b"]
+                 REPLACE k WITH {value: 1} IN UnitTestCollection)aql"}) {
+    auto types = explain(query);
+    EXPECT_FALSE(usesBatch(types)) << query;
+  }
+}
+
+TEST_F(MultipleRemoteModificationExplainTest, returning_results) {
+  auto types = explain(R"aql(
+      FOR k IN ["a", "b"] REMOVE k IN UnitTestCollection RETURN OLD)aql");
+  EXPECT_FALSE(usesBatch(types));
+}
+
+class MultipleRemoteModificationResultTest : public ::testing::Test {
+ protected:
+  // the result of a batch operation for the documents "a" and "missing",
+  // as returned by the Coordinator's transaction methods
+  static OperationResult updateWithMissingDocument() {
+    auto builder = std::make_shared<VPackBuilder>();
+    builder->openArray();
+    builder->openObject();
+    builder->add(StaticStrings::KeyString, VPackValue("a"));
+    builder->add(StaticStrings::IdString, VPackValue("UnitTestCollection/a"));
+    builder->add(StaticStrings::RevString, VPackValue("_abc"));
+    builder->close();
+    builder->openObject();
+    builder->add(StaticStrings::Error, VPackValue(true));
+    builder->add(StaticStrings::ErrorNum,
+                 VPackValue(static_cast<int>(
+                     TRI_ERROR_ARANGO_DOCUMENT_NOT_FOUND)));
+    builder->close();
+    builder->close();
+    return OperationResult(Result(), builder->steal(), OperationOptions(),
+                           {{TRI_ERROR_ARANGO_DOCUMENT_NOT_FOUND, 1}});
+  }
+
+  static ErrorCode errorCode(OperationResult const& result, bool ignoreErrors,
+                             bool ignoreDocumentNotFound,
+                             CoordinatorModificationStats& stats) {
+    try {
+      MultipleRemoteModificationExecutor::processOperationResult(
+          result, ignoreErrors, ignoreDocumentNotFound, stats);
+    } catch (basics::Exception const& ex) {
+      return ex.code();
+    }
+    return TRI_ERROR_NO_ERROR;
+  }
+};
+
+TEST_F(MultipleRemoteModificationResultTest, update_missing_document_fails) {
+  CoordinatorModificationStats stats;
+  EXPECT_EQ(TRI_ERROR_ARANGO_DOCUMENT_NOT_FOUND,
+            errorCode(updateWithMissingDocument(), false, false, stats));
+}
+
+TEST_F(MultipleRemoteModificationResultTest,
+       update_missing_document_with_ignore_errors) {
+  CoordinatorModificationStats stats;
+  EXPECT_EQ(TRI_ERROR_NO_ERROR,
+            errorCode(updateWithMissingDocument(), true, false, stats));
+  EXPECT_EQ(1U, stats.getWritesExecuted());
+  EXPECT_EQ(1U, stats.getWritesIgnored());
+}
+
+TEST_F(MultipleRemoteModificationResultTest,
+       update_missing_document_with_ignore_document_not_found) {
+  CoordinatorModificationStats stats;
+  EXPECT_EQ(TRI_ERROR_NO_ERROR,
+            errorCode(updateWithMissingDocument(), false, true, stats));
+  EXPECT_EQ(1U, stats.getWritesExecuted());
+  EXPECT_EQ(1U, stats.getWritesIgnored());
+}
+
+TEST_F(MultipleRemoteModificationResultTest, invalid_documents_always_fail) {
+  auto builder = std::make_shared<VPackBuilder>();
+  builder->openArray();
+  builder->openObject();
+  builder->add(StaticStrings::Error, VPackValue(true));
+  builder->add(StaticStrings::ErrorNum,
+               VPackValue(static_cast<int>(
+                   TRI_ERROR_ARANGO_DOCUMENT_TYPE_INVALID)));
+  builder->close();
+  builder->close();
+  OperationResult result(Result(), builder->steal(), OperationOptions(),
+                         {{TRI_ERROR_ARANGO_DOCUMENT_TYPE_INVALID, 1}});
+
+  CoordinatorModificationStats stats;
+  EXPECT_EQ(TRI_ERROR_ARANGO_DOCUMENT_TYPE_INVALID,
+            errorCode(result, true, false, stats));
+}
+
+TEST_F(MultipleRemoteModificationResultTest, remove_with_string_keys) {
+  auto builder = std::make_shared<VPackBuilder>();
+  builder->openArray();
+  for (std::string_view key : {"a", "b", "c"}) {
+    builder->openObject();
+    builder->add(StaticStrings::KeyString, VPackValue(key));
+    builder->close();
+  }
+  builder->close();
+  OperationResult result(Result(), builder->steal(), OperationOptions());
+
+  CoordinatorModificationStats stats;
+  EXPECT_EQ(TRI_ERROR_NO_ERROR, errorCode(result, false, false, stats));
+  EXPECT_EQ(3U, stats.getWritesExecuted());
+  EXPECT_EQ(0U, stats.getWritesIgnored());
+}
+
+}  // namespace arangodb::tests::aql
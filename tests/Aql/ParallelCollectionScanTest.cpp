@@ -0,0 +1,201 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+
+#include "AqlExecutorTestCase.h"
+#include "IResearch/common.h"
+#include "Mocks/PhysicalCollectionMock.h"
+#include "Mocks/Servers.h"
+#include "QueryHelper.h"
+
+#include "Aql/Query.h"
+#include "Aql/QueryResult.h"
+#include "Aql/SharedQueryState.h"
+#include "Indexes/IndexIterator.h"
+#include "Transaction/StandaloneContext.h"
+#include "Utils/SingleCollectionTransaction.h"
+#include "VocBase/Identifiers/LocalDocumentId.h"
+#include "VocBase/LogicalCollection.h"
+#include "VocBase/vocbase.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Parser.h>
+
+#include <algorithm>
+#include <unordered_set>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+namespace arangodb {
+namespace tests {
+namespace aql {
+
+static const std::string ParallelScanOptions =
+    R"({"optimizer": {"rules": ["+parallelize-collection-scans"]}})";
+
+class ParallelCollectionScanTest : public AqlExecutorTestCase<false> {
+ protected:
+  // enough documents for the optimizer rule to use 2 scans
+  static constexpr uint64_t numDocuments = 25000;
+
+  TRI_vocbase_t& vocbase;
+
+  ParallelCollectionScanTest() : vocbase(_server->getSystemDatabase()) {
+    if (vocbase.lookupCollection("UnitTestParallelScan") == nullptr) {
+      auto json = VPackParser::fromJson(R"({"name":"UnitTestParallelScan"})");
+      auto collection = vocbase.createCollection(json->slice());
+      EXPECT_NE(collection, nullptr);
+    }
+    AssertQueryHasResult(vocbase,
+                         "FOR i IN 1.." + std::to_string(numDocuments) +
+                             " INSERT {value: i} INTO UnitTestParallelScan",
+                         VPackSlice::emptyArraySlice());
+  }
+
+  ~ParallelCollectionScanTest() {
+    AssertQueryHasResult(
+        vocbase,
+        "FOR doc IN UnitTestParallelScan REMOVE doc IN UnitTestParallelScan",
+        VPackSlice::emptyArraySlice());
+  }
+
+  std::shared_ptr<Query> createQuery(
+      std::shared_ptr<transaction::Context> ctx, std::string const& query) {
+    return Query::create(
+        std::move(ctx), QueryString(query), nullptr,
+        QueryOptions(VPackParser::fromJson(ParallelScanOptions)->slice()));
+  }
+
+  PhysicalCollectionMock& physical() {
+    auto collection = vocbase.lookupCollection("UnitTestParallelScan");
+    EXPECT_NE(collection, nullptr);
+    auto* physical =
+        dynamic_cast<PhysicalCollectionMock*>(collection->getPhysical());
+    EXPECT_NE(physical, nullptr);
+    return *physical;
+  }
+
+  QueryResult executeQuery(Query& query) {
+    QueryResult result;
+    while (query.execute(result) == ExecutionState::WAITING) {
+      query.sharedState()->waitForAsyncWakeup();
+    }
+    return result;
+  }
+};
+
+TEST_F(ParallelCollectionScanTest, partitions_cover_all_documents) {
+  auto collection = vocbase.lookupCollection("UnitTestParallelScan");
+  ASSERT_NE(collection, nullptr);
+  std::vector<LocalDocumentId> const bounds =
+      collection->getPhysical()->partitionDocuments(4);
+  ASSERT_EQ(3, bounds.size());
+  EXPECT_TRUE(std::is_sorted(bounds.begin(), bounds.end()));
+
+  SingleCollectionTransaction trx(
+      transaction::StandaloneContext::Create(vocbase), *collection,
+      AccessMode::Type::READ);
+  ASSERT_TRUE(trx.begin().ok());
+
+  // every document must be found in exactly one of the ranges
+  std::unordered_set<LocalDocumentId> found;
+  for (size_t i = 0; i <= bounds.size(); ++i) {
+    LocalDocumentId const lower = i == 0 ? LocalDocumentId() : bounds[i - 1];
+    LocalDocumentId const upper =
+        i < bounds.size() ? bounds[i] : LocalDocumentId();
+    auto it = trx.indexScanRange(monitor, collection->name(), lower, upper,
+                                 ReadOwnWrites::no);
+    ASSERT_NE(it, nullptr);
+    size_t inRange = 0;
+    while (it->next(
+        [&](LocalDocumentId const& id) {
+          EXPECT_LE(lower, id);
+          if (!upper.empty()) {
+            EXPECT_LT(id, upper);
+          }
+          EXPECT_TRUE(found.emplace(id).second);
+          ++inRange;
+          return true;
+        },
+        1000)) {
+    }
+    // the documents are split evenly
+    EXPECT_GE(inRange, numDocuments / 4);
+  }
+  EXPECT_EQ(numDocuments, found.size());
+  ASSERT_TRUE(trx.commit().ok());
+}
+
+TEST_F(ParallelCollectionScanTest, scans_use_cloned_transaction_contexts) {
+  size_t const rangeIteratorsBefore = physical().numRangeIterators();
+
+  auto ctx = std::make_shared<transaction::StandaloneContext>(vocbase);
+  auto query = createQuery(
+      ctx, "FOR doc IN UnitTestParallelScan RETURN doc.value");
+  query->prepareQuery();
+
+  // the plan contains parallel scans, so every snippet and async task must
+  // get its own clone of the transaction context
+  EXPECT_TRUE(query->isAsyncQuery());
+  EXPECT_TRUE(query->ast()->canApplyParallelism());
+  auto trxContext = query->newTrxContext();
+  EXPECT_NE(ctx, trxContext);
+
+  auto result = executeQuery(*query);
+  ASSERT_TRUE(result.result.ok()) << result.result.errorMessage();
+  ASSERT_TRUE(result.data->slice().isArray());
+  // the collection was scanned in two ranges
+  EXPECT_EQ(rangeIteratorsBefore + 2, physical().numRangeIterators());
+
+  // the documents are returned in no particular order
+  std::vector<uint64_t> values;
+  for (auto it : VPackArrayIterator(result.data->slice())) {
+    values.emplace_back(it.getNumber<uint64_t>());
+  }
+  std::sort(values.begin(), values.end());
+  ASSERT_EQ(numDocuments, values.size());
+  for (uint64_t i = 0; i < numDocuments; ++i) {
+    EXPECT_EQ(i + 1, values[i]);
+  }
+}
+
+TEST_F(ParallelCollectionScanTest, modification_queries_are_not_parallel) {
+  auto ctx = std::make_shared<transaction::StandaloneContext>(vocbase);
+  auto query = createQuery(ctx,
+                           "FOR doc IN UnitTestParallelScan "
+                           "UPDATE doc WITH {updated: true} "
+                           "IN UnitTestParallelScan");
+  query->prepareQuery();
+
+  EXPECT_FALSE(query->isAsyncQuery());
+  EXPECT_EQ(ctx, query->newTrxContext());
+
+  size_t const rangeIteratorsBefore = physical().numRangeIterators();
+  auto result = executeQuery(*query);
+  ASSERT_TRUE(result.result.ok()) << result.result.errorMessage();
+  EXPECT_EQ(rangeIteratorsBefore, physical().numRangeIterators());
+}
+
+}  // namespace aql
+}  // namespace tests
+}  // namespace arangodb
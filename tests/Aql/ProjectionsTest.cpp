@@ -424,6 +424,77 @@ TEST(ProjectionsTest, toVelocyPackFromDocumentSimple1) {
   }
 }
 
+TEST(ProjectionsTest, toVelocyPackFromDocumentChangingLayouts) {
+  arangodb::GlobalResourceMonitor globalResourceMonitor{};
+  arangodb::ResourceMonitor resMonitor{globalResourceMonitor};
+  std::vector<arangodb::aql::AttributeNamePath> attributes = {
+      createAttributeNamePath({"a"}, resMonitor),
+      createAttributeNamePath({"c"}, resMonitor),
+      createAttributeNamePath({"e", "x"}, resMonitor),
+  };
+  Projections p(std::move(attributes));
+
+  velocypack::Builder out;
+
+  auto prepareResult = [&p](std::string_view json, velocypack::Builder& out) {
+    auto document = velocypack::Parser::fromJson(json.data(), json.size());
+    out.clear();
+    out.openObject();
+    p.toVelocyPackFromDocument(out, document->slice(), nullptr);
+    out.close();
+    return out.slice();
+  };
+
+  // the same projections are used for documents with different layouts,
+  // so the attributes are at different positions in each document
+  for (int i = 0; i < 2; ++i) {
+    {
+      VPackSlice s = prepareResult(
+          "{\"a\":1,\"b\":2,\"c\":3,\"d\":4,\"e\":{\"x\":5}}", out);
+      EXPECT_EQ(3, s.length());
+      EXPECT_EQ(1, s.get("a").getInt());
+      EXPECT_EQ(3, s.get("c").getInt());
+      EXPECT_EQ(5, s.get({"e", "x"}).getInt());
+    }
+
+    {
+      VPackSlice s = prepareResult(
+          "{\"a\":1,\"b\":2,\"c\":3,\"d\":4,\"e\":{\"x\":5}}", out);
+      EXPECT_EQ(3, s.length());
+      EXPECT_EQ(1, s.get("a").getInt());
+      EXPECT_EQ(3, s.get("c").getInt());
+      EXPECT_EQ(5, s.get({"e", "x"}).getInt());
+    }
+
+    {
+      VPackSlice s =
+          prepareResult("{\"c\":6,\"e\":{\"x\":7},\"f\":8}", out);
+      EXPECT_EQ(3, s.length());
+      EXPECT_TRUE(s.get("a").isNull());
+      EXPECT_EQ(6, s.get("c").getInt());
+      EXPECT_EQ(7, s.get({"e", "x"}).getInt());
+    }
+
+    {
+      VPackSlice s = prepareResult(
+          "{\"0\":0,\"1\":1,\"a\":9,\"b\":10,\"c\":11,\"e\":12}",
+          out);
+      EXPECT_EQ(3, s.length());
+      EXPECT_EQ(9, s.get("a").getInt());
+      EXPECT_EQ(11, s.get("c").getInt());
+      EXPECT_EQ(12, s.get("e").getInt());
+    }
+
+    {
+      VPackSlice s = prepareResult("{\"b\":1,\"d\":2}", out);
+      EXPECT_EQ(3, s.length());
+      EXPECT_TRUE(s.get("a").isNull());
+      EXPECT_TRUE(s.get("c").isNull());
+      EXPECT_TRUE(s.get("e").isNull());
+    }
+  }
+}
+
 TEST(ProjectionsTest, toVelocyPackFromDocumentComplex) {
   arangodb::GlobalResourceMonitor globalResourceMonitor{};
   arangodb::ResourceMonitor resMonitor{globalResourceMonitor};
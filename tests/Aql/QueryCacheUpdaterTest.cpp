@@ -0,0 +1,209 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+
+#include "Aql/QueryCache.h"
+#include "Aql/QueryCacheUpdater.h"
+#include "Aql/QueryString.h"
+#include "Basics/VelocyPackHelper.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Parser.h>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+namespace {
+
+/// @brief an updater for `FILTER doc.value >= 10 RETURN {key: doc._key}`
+QueryCacheUpdater objectUpdater() {
+  std::vector<QueryCacheUpdater::Condition> conditions;
+  auto& condition = conditions.emplace_back();
+  condition.attribute = {"value"};
+  condition.comparison = QueryCacheUpdater::Comparison::GreaterEqual;
+  condition.value.add(VPackValue(10));
+
+  QueryCacheUpdater::Projection projection;
+  projection.type = QueryCacheUpdater::ProjectionType::Object;
+  projection.attributes.emplace_back("key", std::vector<std::string>{"_key"});
+  return QueryCacheUpdater(std::move(conditions), std::move(projection));
+}
+
+/// @brief an updater for `FILTER doc.value IN [1, 2] RETURN doc`
+QueryCacheUpdater documentUpdater() {
+  std::vector<QueryCacheUpdater::Condition> conditions;
+  auto& condition = conditions.emplace_back();
+  condition.attribute = {"value"};
+  condition.comparison = QueryCacheUpdater::Comparison::In;
+  condition.value.add(VPackParser::fromJson("[1, 2]")->slice());
+  return QueryCacheUpdater(std::move(conditions),
+                           QueryCacheUpdater::Projection());
+}
+
+void addChange(QueryCacheChanges::Collection& changes, VPackSlice oldDocument,
+               VPackSlice newDocument) {
+  changes.add(oldDocument, newDocument, &VPackOptions::Defaults);
+}
+
+bool matches(QueryCacheUpdater const& updater, std::string const& document) {
+  return updater.matches(VPackParser::fromJson(document)->slice());
+}
+
+void expectEqual(std::string const& expected, VPackSlice actual) {
+  auto builder = VPackParser::fromJson(expected);
+  EXPECT_TRUE(
+      basics::VelocyPackHelper::equal(builder->slice(), actual, false))
+      << actual.toJson();
+}
+
+}  // namespace
+
+TEST(QueryCacheUpdaterTest, matches_conditions) {
+  auto updater = objectUpdater();
+  EXPECT_TRUE(matches(updater, R"({"value":10})"));
+  EXPECT_FALSE(matches(updater, R"({"value":9})"));
+  // a missing attribute is null, which is lower than any number
+  EXPECT_FALSE(matches(updater, R"({"other":10})"));
+  // strings are greater than numbers
+  EXPECT_TRUE(matches(updater, R"({"value":"1"})"));
+
+  auto inUpdater = documentUpdater();
+  EXPECT_TRUE(matches(inUpdater, R"({"value":2})"));
+  EXPECT_FALSE(matches(inUpdater, R"({"value":3})"));
+}
+
+TEST(QueryCacheUpdaterTest, projects_object) {
+  auto updater = objectUpdater();
+  VPackBuilder builder;
+  updater.project(
+      VPackParser::fromJson(R"({"_key":"a","value":10,"other":1})")->slice(),
+      builder);
+  expectEqual(R"({"key":"a"})", builder.slice());
+}
+
+TEST(QueryCacheUpdaterTest, applies_changes) {
+  auto updater = objectUpdater();
+  auto result = VPackParser::fromJson(R"([{"key":"a"},{"key":"b"}])");
+
+  QueryCacheChanges::Collection changes;
+  // insert of a matching and of a non-matching document
+  addChange(changes, VPackSlice::noneSlice(),
+            VPackParser::fromJson(R"({"_key":"c","value":11})")->slice());
+  addChange(changes, VPackSlice::noneSlice(),
+            VPackParser::fromJson(R"({"_key":"d","value":1})")->slice());
+  // update that makes a document stop matching
+  addChange(changes,
+            VPackParser::fromJson(R"({"_key":"a","value":10})")->slice(),
+            VPackParser::fromJson(R"({"_key":"a","value":1})")->slice());
+  // removal
+  addChange(changes,
+            VPackParser::fromJson(R"({"_key":"b","value":12})")->slice(),
+            VPackSlice::noneSlice());
+
+  auto updated = updater.apply(result->slice(), changes.changes());
+  ASSERT_NE(nullptr, updated);
+  expectEqual(R"([{"key":"c"}])", updated->slice());
+}
+
+TEST(QueryCacheUpdaterTest, fails_for_unknown_document) {
+  auto updater = documentUpdater();
+  auto result =
+      VPackParser::fromJson(R"([{"_key":"a","_rev":"1","value":1}])");
+
+  QueryCacheChanges::Collection changes;
+  // the cached result contains a different revision of the document
+  addChange(
+      changes,
+      VPackParser::fromJson(R"({"_key":"a","_rev":"2","value":1})")->slice(),
+      VPackParser::fromJson(R"({"_key":"a","_rev":"3","value":2})")->slice());
+
+  EXPECT_EQ(nullptr, updater.apply(result->slice(), changes.changes()));
+}
+
+TEST(QueryCacheUpdaterTest, abandons_too_many_changes) {
+  QueryCacheChanges::Collection changes;
+  auto document = VPackParser::fromJson(R"({"_key":"a"})");
+  for (size_t i = 0; i <= QueryCacheChanges::maxChanges; ++i) {
+    addChange(changes, VPackSlice::noneSlice(), document->slice());
+  }
+  EXPECT_FALSE(changes.complete());
+
+  // recording is not resumed after an intermediate commit
+  changes.clear();
+  EXPECT_FALSE(changes.complete());
+}
+
+TEST(QueryCacheUpdaterTest, changes_are_applied_once) {
+  std::string const guid = "guid";
+  QueryString const queryString(std::string_view("query"));
+  size_t const maxSize = 1024 * 1024;
+
+  QueryCacheDatabaseEntry cache;
+  auto entry = std::make_shared<QueryCacheResultEntry>(
+      1, queryString, VPackParser::fromJson(R"([{"key":"a"}])"), nullptr,
+      std::unordered_map<std::string, std::string>{{guid, "collection"}});
+  entry->_updater = std::make_shared<QueryCacheUpdater const>(objectUpdater());
+  entry->_snapshotTick = 100;
+  cache.store(std::move(entry), 16, maxSize);
+
+  auto lookup = [&]() -> VPackSlice {
+    auto found = cache.lookup(1, queryString, nullptr);
+    return found == nullptr ? VPackSlice::noneSlice()
+                            : found->_queryResult->slice();
+  };
+
+  QueryCacheChanges::Collection changes;
+  addChange(changes, VPackSlice::noneSlice(),
+            VPackParser::fromJson(R"({"_key":"b","value":11})")->slice());
+
+  // committed before the snapshot of the cached result was taken. the
+  // result already contains the document
+  cache.update(guid, &changes, 90, maxSize, 16, maxSize);
+  expectEqual(R"([{"key":"a"}])", lookup());
+
+  // committed after the snapshot was taken
+  cache.update(guid, &changes, 110, maxSize, 16, maxSize);
+  expectEqual(R"([{"key":"a"},{"key":"b"}])", lookup());
+
+  // an unknown commit tick invalidates the entry
+  cache.update(guid, &changes, 0, maxSize, 16, maxSize);
+  EXPECT_TRUE(lookup().isNone());
+}
+
+TEST(QueryCacheUpdaterTest, entries_without_snapshot_are_invalidated) {
+  std::string const guid = "guid";
+  QueryString const queryString(std::string_view("query"));
+  size_t const maxSize = 1024 * 1024;
+
+  QueryCacheDatabaseEntry cache;
+  auto entry = std::make_shared<QueryCacheResultEntry>(
+      1, queryString, VPackParser::fromJson(R"([{"key":"a"}])"), nullptr,
+      std::unordered_map<std::string, std::string>{{guid, "collection"}});
+  entry->_updater = std::make_shared<QueryCacheUpdater const>(objectUpdater());
+  cache.store(std::move(entry), 16, maxSize);
+
+  QueryCacheChanges::Collection changes;
+  addChange(changes, VPackSlice::noneSlice(),
+            VPackParser::fromJson(R"({"_key":"b","value":11})")->slice());
+  cache.update(guid, &changes, 110, maxSize, 16, maxSize);
+  EXPECT_EQ(nullptr, cache.lookup(1, queryString, nullptr));
+}
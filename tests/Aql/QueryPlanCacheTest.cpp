@@ -0,0 +1,202 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+
+#include "AqlExecutorTestCase.h"
+#include "IResearch/common.h"
+#include "Mocks/Servers.h"
+#include "QueryHelper.h"
+
+#include "Aql/BindParameters.h"
+#include "Aql/QueryPlanCache.h"
+#include "Aql/QueryResult.h"
+#include "Basics/GlobalResourceMonitor.h"
+#include "Basics/ResourceUsage.h"
+#include "VocBase/LogicalCollection.h"
+#include "VocBase/vocbase.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Parser.h>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+namespace arangodb {
+namespace tests {
+namespace aql {
+
+static const std::string PlanCacheOptions = R"({"usePlanCache": true})";
+
+class QueryPlanCacheTest : public AqlExecutorTestCase<false> {
+ protected:
+  TRI_vocbase_t& vocbase;
+
+  QueryPlanCacheTest() : vocbase(_server->getSystemDatabase()) {
+    if (vocbase.lookupCollection("UnitTestPlanCache") == nullptr) {
+      auto json = VPackParser::fromJson(R"({"name":"UnitTestPlanCache"})");
+      auto collection = vocbase.createCollection(json->slice());
+      EXPECT_NE(collection, nullptr);
+    }
+    AssertQueryHasResult(
+        vocbase,
+        "FOR i IN 1..5 INSERT {value: i} INTO UnitTestPlanCache",
+        VPackSlice::emptyArraySlice());
+  }
+
+  ~QueryPlanCacheTest() {
+    AssertQueryHasResult(
+        vocbase,
+        "FOR doc IN UnitTestPlanCache REMOVE doc IN UnitTestPlanCache",
+        VPackSlice::emptyArraySlice());
+    QueryPlanCache::instance()->invalidate();
+  }
+
+  void assertResult(std::string const& query, std::string const& bindVars,
+                    std::string const& expected) {
+    SCOPED_TRACE("Bind parameters: " + bindVars);
+    auto expectedSlice = VPackParser::fromJson(expected);
+    auto result = executeQuery(vocbase, query, VPackParser::fromJson(bindVars),
+                               PlanCacheOptions);
+    AssertQueryResultToSlice(result, expectedSlice->slice());
+  }
+};
+
+TEST_F(QueryPlanCacheTest, runtime_bind_parameters_are_evaluated) {
+  std::string const query =
+      R"aql(FOR doc IN UnitTestPlanCache
+              FILTER doc.value >= @low && doc.value < @high
+              SORT doc.value
+              RETURN doc.value)aql";
+  // all executions but the first one reuse the same plan
+  assertResult(query, R"({"low": 1, "high": 3})", "[1, 2]");
+  assertResult(query, R"({"low": 4, "high": 10})", "[4, 5]");
+  assertResult(query, R"({"low": "a", "high": 10})", "[]");
+  assertResult(query, R"({"low": null, "high": 2})", "[1]");
+}
+
+TEST_F(QueryPlanCacheTest, folded_bind_parameters_are_part_of_the_key) {
+  std::string const query =
+      R"aql(FOR doc IN UnitTestPlanCache
+              SORT doc.value
+              LIMIT @limit
+              RETURN doc.value)aql";
+  assertResult(query, R"({"limit": 1})", "[1]");
+  assertResult(query, R"({"limit": 3})", "[1, 2, 3]");
+  assertResult(query, R"({"limit": 1})", "[1]");
+}
+
+TEST_F(QueryPlanCacheTest, missing_bind_parameter_is_still_an_error) {
+  std::string const query =
+      R"aql(FOR doc IN UnitTestPlanCache
+              FILTER doc.value == @value
+              RETURN doc.value)aql";
+  assertResult(query, R"({"value": 2})", "[2]");
+
+  auto result = executeQuery(vocbase, query, VPackParser::fromJson("{}"),
+                             PlanCacheOptions);
+  EXPECT_TRUE(result.result.is(TRI_ERROR_QUERY_BIND_PARAMETER_MISSING));
+}
+
+TEST_F(QueryPlanCacheTest, undeclared_bind_parameter_is_still_an_error) {
+  std::string const query =
+      R"aql(FOR doc IN UnitTestPlanCache
+              FILTER doc.value == @value
+              RETURN doc.value)aql";
+  assertResult(query, R"({"value": 2})", "[2]");
+
+  auto result =
+      executeQuery(vocbase, query,
+                   VPackParser::fromJson(R"({"value": 2, "other": 1})"),
+                   PlanCacheOptions);
+  EXPECT_TRUE(result.result.is(TRI_ERROR_QUERY_BIND_PARAMETER_UNDECLARED));
+
+  // the cached plan is still usable
+  assertResult(query, R"({"value": 3})", "[3]");
+}
+
+TEST_F(QueryPlanCacheTest, renaming_a_collection_invalidates_plans) {
+  std::string const query =
+      R"aql(FOR doc IN UnitTestPlanCache
+              FILTER doc.value == @value
+              RETURN doc.value)aql";
+  assertResult(query, R"({"value": 2})", "[2]");
+
+  auto collection = vocbase.lookupCollection("UnitTestPlanCache");
+  ASSERT_NE(nullptr, collection);
+  ASSERT_TRUE(
+      vocbase.renameCollection(collection->id(), "UnitTestPlanCacheRenamed")
+          .ok());
+  auto result = executeQuery(vocbase, query,
+                             VPackParser::fromJson(R"({"value": 2})"),
+                             PlanCacheOptions);
+  EXPECT_TRUE(result.result.is(TRI_ERROR_ARANGO_DATA_SOURCE_NOT_FOUND));
+
+  ASSERT_TRUE(
+      vocbase.renameCollection(collection->id(), "UnitTestPlanCache").ok());
+  assertResult(query, R"({"value": 2})", "[2]");
+}
+
+TEST(QueryPlanCacheKeyTest, runtime_bind_parameter_values_are_ignored) {
+  GlobalResourceMonitor global{};
+  ResourceMonitor monitor{global};
+
+  BindParameters first(monitor,
+                       VPackParser::fromJson(R"({"a": 1, "b": [1, 2]})"));
+  BindParameters second(monitor,
+                        VPackParser::fromJson(R"({"b": [1, 2], "a": "x"})"));
+  BindParameters third(monitor,
+                       VPackParser::fromJson(R"({"a": 1, "b": [1, 3]})"));
+
+  std::unordered_set<std::string> const runtime{"a"};
+  auto key = QueryPlanCache::buildPlanKey(first, runtime);
+  ASSERT_TRUE(key.has_value());
+  EXPECT_EQ(key, QueryPlanCache::buildPlanKey(second, runtime));
+  EXPECT_NE(key, QueryPlanCache::buildPlanKey(third, runtime));
+  EXPECT_NE(key, QueryPlanCache::buildPlanKey(second, {}));
+}
+
+TEST(QueryPlanCacheKeyTest, stale_plans_are_not_stored) {
+  QueryPlanCache cache;
+  auto* vocbase = reinterpret_cast<TRI_vocbase_t*>(0x1);
+  auto plan = std::make_shared<QueryPlanCache::CachedPlan>();
+  plan->plan = std::make_shared<VPackBuilder const>(
+      *VPackParser::fromJson(R"({"nodes": []})"));
+  plan->bindParameters = {"a"};
+
+  uint64_t generation = cache.generation();
+  cache.store(vocbase, generation, "query", {"a"}, "plan", plan);
+  EXPECT_EQ(plan, cache.lookup(vocbase, "query", "plan"));
+  EXPECT_EQ((std::unordered_set<std::string>{"a"}),
+            cache.runtimeBindParameters(vocbase, "query"));
+
+  cache.invalidate(vocbase);
+  EXPECT_EQ(nullptr, cache.lookup(vocbase, "query", "plan"));
+  EXPECT_FALSE(cache.runtimeBindParameters(vocbase, "query").has_value());
+
+  // compiled before the invalidation
+  cache.store(vocbase, generation, "query", {"a"}, "plan", plan);
+  EXPECT_EQ(nullptr, cache.lookup(vocbase, "query", "plan"));
+}
+
+}  // namespace aql
+}  // namespace tests
+}  // namespace arangodb
@@ -25,9 +25,13 @@
 #include "Aql/AqlCallStack.h"
 #include "Aql/AqlExecuteResult.h"
 #include "Aql/AqlItemBlockManager.h"
+#include "Aql/ClusterNodes.h"
+#include "Aql/Query.h"
+#include "Aql/RemoteExecutor.h"
 #include "Basics/GlobalResourceMonitor.h"
 #include "Basics/ResourceUsage.h"
 
+#include "AqlExecutorTestCase.h"
 #include "AqlItemBlockHelper.h"
 
 #include "gtest/gtest.h"
@@ -238,4 +242,86 @@ TEST(DeSerializeAqlExecuteResultTest, test) {
     ASSERT_EQ(aqlExecuteResult, deSerializedAqlExecuteResult);
   }
 }
+
+// the rows of a prefetched batch are handed out according to the calls that
+// follow the prefetch, which may differ from the prefetched call. the block
+// does not run on a coordinator here, so it never sends a request itself
+class RemoteExecutorPrefetchTest : public AqlExecutorTestCase<false> {
+ protected:
+  RemoteExecutorPrefetchTest()
+      : node(const_cast<ExecutionPlan*>(fakedQuery->plan()),
+             ExecutionNodeId{1}, &fakedQuery->vocbase(), "PRMR-0001", "1",
+             "12345") {}
+
+  auto makeRemote() -> std::unique_ptr<ExecutionBlockImpl<RemoteExecutor>> {
+    return std::make_unique<ExecutionBlockImpl<RemoteExecutor>>(
+        fakedQuery->rootEngine(), &node,
+        RegisterInfos(RegIdSet{0}, {}, 1, 1, {}, {RegIdSet{0}}), "PRMR-0001",
+        "1", "12345");
+  }
+
+  auto execute(ExecutionBlock& remote, AqlCall call)
+      -> std::tuple<ExecutionState, size_t, std::vector<int64_t>> {
+    auto [state, skipped, block] =
+        remote.execute(AqlCallStack{AqlCallList{call}});
+    std::vector<int64_t> values;
+    if (block != nullptr) {
+      for (size_t row = 0; row < block->numRows(); ++row) {
+        values.emplace_back(block->getValueReference(row, 0).toInt64());
+      }
+    }
+    return {state, skipped.getSkipCount(), std::move(values)};
+  }
+
+  RemoteNode node;
+};
+
+TEST_F(RemoteExecutorPrefetchTest, prefetched_rows_follow_later_calls) {
+  auto remote = makeRemote();
+  remote->testInjectPrefetchedRows(
+      buildBlock<1>(itemBlockManager, {{0}, {1}, {2}, {3}, {4}}),
+      ExecutionState::DONE);
+
+  auto [state, skipped, values] = execute(*remote, AqlCall{0, size_t{2}});
+  EXPECT_EQ(ExecutionState::HASMORE, state);
+  EXPECT_EQ(0U, skipped);
+  EXPECT_EQ((std::vector<int64_t>{0, 1}), values);
+
+  std::tie(state, skipped, values) = execute(*remote, AqlCall{1, size_t{1}});
+  EXPECT_EQ(ExecutionState::HASMORE, state);
+  EXPECT_EQ(1U, skipped);
+  EXPECT_EQ((std::vector<int64_t>{3}), values);
+
+  // the state of the prefetched batch is returned with its last row
+  std::tie(state, skipped, values) = execute(*remote, AqlCall{});
+  EXPECT_EQ(ExecutionState::DONE, state);
+  EXPECT_EQ(0U, skipped);
+  EXPECT_EQ((std::vector<int64_t>{4}), values);
+}
+
+TEST_F(RemoteExecutorPrefetchTest, hard_limit_drops_rest_of_prefetched_rows) {
+  auto remote = makeRemote();
+  remote->testInjectPrefetchedRows(
+      buildBlock<1>(itemBlockManager, {{0}, {1}, {2}, {3}, {4}}),
+      ExecutionState::DONE);
+
+  // the rows after the limit are only counted for the fullCount
+  auto [state, skipped, values] = execute(
+      *remote, AqlCall{0, AqlCall::Infinity{}, size_t{2}, /*fullCount*/ true});
+  EXPECT_EQ(ExecutionState::DONE, state);
+  EXPECT_EQ(3U, skipped);
+  EXPECT_EQ((std::vector<int64_t>{0, 1}), values);
+}
+
+TEST_F(RemoteExecutorPrefetchTest, offset_beyond_prefetched_rows) {
+  auto remote = makeRemote();
+  remote->testInjectPrefetchedRows(
+      buildBlock<1>(itemBlockManager, {{0}, {1}, {2}}), ExecutionState::DONE);
+
+  auto [state, skipped, values] = execute(*remote, AqlCall{5});
+  EXPECT_EQ(ExecutionState::DONE, state);
+  EXPECT_EQ(3U, skipped);
+  EXPECT_TRUE(values.empty());
+}
+
 }  // namespace arangodb::tests::aql
@@ -332,4 +332,31 @@ TEST_P(SortExecutorTest, regression_bts_1511) {
       .run();
 }
 
+TEST_P(SortExecutorTest, sorts_mixed_types) {
+  AqlCall call{};          // unlimited produce
+  ExecutionStats stats{};  // No stats here
+  makeExecutorTestHelper()
+      .addConsumer<SortExecutor>(makeRegisterInfos(), makeExecutorInfos(),
+                                 ExecutionNode::SORT)
+      .setInputSplitType(getSplit())
+      .setInputValueList(R"("b")", R"(2.5)", R"(true)", R"(9007199254740993)",
+                         R"(null)", -3, R"(-0.0)", R"(false)", R"([1])",
+                         R"("a")", 1)
+      .expectOutput({0}, {{R"(null)"},
+                          {R"(false)"},
+                          {R"(true)"},
+                          {-3},
+                          {R"(-0.0)"},
+                          {1},
+                          {R"(2.5)"},
+                          {R"(9007199254740993)"},
+                          {R"("a")"},
+                          {R"("b")"},
+                          {R"([1])"}})
+      .setCall(call)
+      .expectSkipped(0)
+      .expectedState(ExecutionState::DONE)
+      .run();
+}
+
 }  // namespace arangodb::tests::aql
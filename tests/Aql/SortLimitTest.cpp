@@ -131,6 +131,26 @@ class SortLimitTest
     return strategy;
   }
 
+  bool ruleApplied(TRI_vocbase_t& vocbase, std::string const& queryString,
+                   std::string const& rule) {
+    auto options = buildOptions("");
+    auto ctx =
+        std::make_shared<arangodb::transaction::StandaloneContext>(vocbase);
+    auto query = arangodb::aql::Query::create(
+        ctx, arangodb::aql::QueryString(queryString), nullptr,
+        arangodb::aql::QueryOptions(options->slice()));
+
+    auto result = query->explain();
+    VPackSlice rules = result.data->slice().get("rules");
+    EXPECT_TRUE(rules.isArray());
+    for (VPackSlice it : VPackArrayIterator(rules)) {
+      if (it.isEqualString(rule)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
   void verifyExpectedResults(TRI_vocbase_t& vocbase,
                              std::string const& queryString,
                              std::vector<size_t> const& expected,
@@ -328,3 +348,34 @@ TEST_P(SortLimitTest, CheckInterloperEnumerateList) {
   EXPECT_EQ(sorterType(*vocbase, query), "standard");
   verifyExpectedResults(*vocbase, query, expected, 1000);
 }
+
+TEST_P(SortLimitTest, CheckSortLimitThreshold) {
+  std::string query =
+      "FOR d IN testCollection0 SORT d.valDsc LIMIT 0, 5 RETURN d";
+  std::vector<size_t> expected = {999, 998, 997, 996, 995};
+  // with fullCount, all documents must make it into the SORT node
+  EXPECT_EQ(ruleApplied(*vocbase, query, "sort-limit-threshold"),
+            !doFullCount());
+  verifyExpectedResults(*vocbase, query, expected, 1000);
+  verifyExpectedResults(*vocbase, query, expected, 1000,
+                        "\"-sort-limit-threshold\"");
+}
+
+TEST_P(SortLimitTest, CheckSortLimitThresholdWithTies) {
+  // the first sort criterion has many equal values, which must not be
+  // discarded before the second criterion is compared
+  std::string query =
+      "FOR d IN testCollection0 SORT d.mod DESC, d.valAsc LIMIT 3, 5 "
+      "RETURN d";
+  std::vector<size_t> expected = {399, 499, 599, 699, 799};
+  verifyExpectedResults(*vocbase, query, expected, 1000);
+  verifyExpectedResults(*vocbase, query, expected, 1000,
+                        "\"-sort-limit-threshold\"");
+}
+
+TEST_P(SortLimitTest, CheckSortLimitThresholdNotInSubquery) {
+  std::string query =
+      "FOR i IN 1..2 LET sub = (FOR d IN testCollection0 SORT d.valAsc "
+      "LIMIT 0, 3 RETURN d) RETURN sub";
+  EXPECT_FALSE(ruleApplied(*vocbase, query, "sort-limit-threshold"));
+}
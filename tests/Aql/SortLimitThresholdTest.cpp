@@ -0,0 +1,90 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+
+#include "Aql/AqlValue.h"
+#include "Aql/SortLimitThreshold.h"
+
+#include <velocypack/Options.h>
+#include <velocypack/Slice.h>
+
+#include <tuple>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+namespace {
+velocypack::Slice intSlice(velocypack::Builder& builder, int64_t value) {
+  builder.clear();
+  builder.add(velocypack::Value(value));
+  return builder.slice();
+}
+}  // namespace
+
+TEST(SortLimitThresholdTest, excludes_nothing_without_threshold) {
+  SortLimitThreshold threshold(&velocypack::Options::Defaults);
+  SortLimitThreshold::Snapshot snapshot;
+  velocypack::Builder builder;
+
+  EXPECT_FALSE(threshold.excludes(intSlice(builder, 100), true, snapshot));
+  EXPECT_FALSE(threshold.excludes(intSlice(builder, -100), false, snapshot));
+}
+
+TEST(SortLimitThresholdTest, excludes_values_after_threshold) {
+  SortLimitThreshold threshold(&velocypack::Options::Defaults);
+  SortLimitThreshold::Snapshot snapshot;
+  velocypack::Builder builder;
+
+  threshold.update(AqlValue(AqlValueHintInt(10)));
+  EXPECT_TRUE(threshold.excludes(intSlice(builder, 11), true, snapshot));
+  EXPECT_FALSE(threshold.excludes(intSlice(builder, 10), true, snapshot));
+  EXPECT_FALSE(threshold.excludes(intSlice(builder, 9), true, snapshot));
+  EXPECT_TRUE(threshold.excludes(intSlice(builder, 9), false, snapshot));
+
+  threshold.reset();
+  EXPECT_FALSE(threshold.excludes(intSlice(builder, 11), true, snapshot));
+}
+
+TEST(SortLimitThresholdTest, snapshot_is_refreshed_only_on_changes) {
+  SortLimitThreshold threshold(&velocypack::Options::Defaults);
+  SortLimitThreshold::Snapshot snapshot;
+  velocypack::Builder builder;
+
+  threshold.update(AqlValue(AqlValueHintInt(10)));
+  std::ignore = threshold.excludes(intSlice(builder, 1), true, snapshot);
+  auto const version = snapshot.version;
+  EXPECT_NE(0U, version);
+
+  // an equal value does not change the threshold
+  threshold.update(AqlValue(AqlValueHintDouble(10.0)));
+  std::ignore = threshold.excludes(intSlice(builder, 1), true, snapshot);
+  EXPECT_EQ(version, snapshot.version);
+
+  threshold.update(AqlValue(AqlValueHintInt(5)));
+  EXPECT_TRUE(threshold.excludes(intSlice(builder, 6), true, snapshot));
+  EXPECT_NE(version, snapshot.version);
+
+  // every reader has a snapshot of its own
+  SortLimitThreshold::Snapshot other;
+  EXPECT_TRUE(threshold.excludes(intSlice(builder, 6), true, other));
+  EXPECT_EQ(snapshot.version, other.version);
+}
@@ -0,0 +1,152 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+
+#include "AqlExecutorTestCase.h"
+#include "AqlItemBlockHelper.h"
+#include "WaitingExecutionBlockMock.h"
+
+#include "Aql/AqlCallStack.h"
+#include "Aql/ExecutionBlockImpl.h"
+#include "Aql/SortRegister.h"
+#include "Aql/SortingGatherExecutor.h"
+
+#include <deque>
+#include <utility>
+#include <vector>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+namespace arangodb::tests::aql {
+
+// the executor is tested with both sort strategies, which must produce the
+// same order
+class SortingGatherExecutorTest
+    : public AqlExecutorTestCaseWithParam<GatherNode::SortMode, false> {
+ protected:
+  // register 0 holds the sort value, register 1 the dependency the row
+  // comes from
+  auto buildRegisterInfos() -> RegisterInfos {
+    return RegisterInfos(RegIdSet{0, 1}, {}, 2, 2, {}, {RegIdSet{0, 1}});
+  }
+
+  auto buildExecutor(bool ascending) -> std::unique_ptr<ExecutionBlock> {
+    _sortElement = std::make_unique<SortElement>(nullptr, ascending, monitor);
+    std::vector<SortRegister> sortRegister;
+    sortRegister.emplace_back(SortRegister{0, *_sortElement});
+    auto executorInfos = SortingGatherExecutorInfos(
+        std::move(sortRegister), *fakedQuery, GetParam(), 0,
+        GatherNode::Parallelism::Serial);
+    return std::make_unique<ExecutionBlockImpl<SortingGatherExecutor>>(
+        fakedQuery->rootEngine(), generateNodeDummy(ExecutionNode::GATHER),
+        buildRegisterInfos(), std::move(executorInfos));
+  }
+
+  // adds a dependency that returns the given blocks of sort values
+  void addDependency(ExecutionBlock& gather,
+                     std::vector<std::vector<int>> const& blocks) {
+    int const dependency = static_cast<int>(_dependencies.size());
+    std::deque<SharedAqlItemBlockPtr> data;
+    for (auto const& values : blocks) {
+      MatrixBuilder<2> matrix;
+      for (int value : values) {
+        matrix.emplace_back(RowBuilder<2>{value, dependency});
+      }
+      data.emplace_back(buildBlock<2>(itemBlockManager, std::move(matrix)));
+    }
+    _dependencies.emplace_back(std::make_unique<WaitingExecutionBlockMock>(
+        fakedQuery->rootEngine(), generateNodeDummy(), std::move(data),
+        WaitingExecutionBlockMock::WaitingBehaviour::NEVER));
+    gather.addDependency(_dependencies.back().get());
+  }
+
+  // fetches all rows, as pairs of sort value and dependency
+  auto fetchAll(ExecutionBlock& gather)
+      -> std::vector<std::pair<int64_t, int64_t>> {
+    std::vector<std::pair<int64_t, int64_t>> rows;
+    AqlCallStack stack{AqlCallList{AqlCall{}}};
+    ExecutionState state = ExecutionState::HASMORE;
+    while (state != ExecutionState::DONE) {
+      SkipResult skipped;
+      SharedAqlItemBlockPtr block;
+      std::tie(state, skipped, block) = gather.execute(stack);
+      EXPECT_TRUE(skipped.nothingSkipped());
+      if (block == nullptr) {
+        continue;
+      }
+      for (size_t row = 0; row < block->numRows(); ++row) {
+        rows.emplace_back(block->getValueReference(row, 0).toInt64(),
+                          block->getValueReference(row, 1).toInt64());
+      }
+    }
+    return rows;
+  }
+
+ private:
+  std::vector<std::unique_ptr<ExecutionBlock>> _dependencies;
+  std::unique_ptr<SortElement> _sortElement;
+};
+
+INSTANTIATE_TEST_CASE_P(SortingGatherExecutorTest, SortingGatherExecutorTest,
+                        ::testing::Values(GatherNode::SortMode::Heap,
+                                          GatherNode::SortMode::MinElement));
+
+TEST_P(SortingGatherExecutorTest, merges_in_sort_order) {
+  auto gather = buildExecutor(true);
+  addDependency(*gather, {{1, 4}, {4, 9}});
+  addDependency(*gather, {{2, 4, 7}});
+  addDependency(*gather, {{0}, {4}, {10}});
+  addDependency(*gather, {{3, 3, 8}});
+  addDependency(*gather, {{4, 5}, {6, 11}});
+
+  // equal values are returned in the order of their dependencies
+  std::vector<std::pair<int64_t, int64_t>> expected{
+      {0, 2}, {1, 0}, {2, 1}, {3, 3},  {3, 3},  {4, 0},
+      {4, 0}, {4, 1}, {4, 2}, {4, 4},  {5, 4},  {6, 4},
+      {7, 1}, {8, 3}, {9, 0}, {10, 2}, {11, 4},
+  };
+  EXPECT_EQ(expected, fetchAll(*gather));
+}
+
+TEST_P(SortingGatherExecutorTest, merges_in_descending_order) {
+  auto gather = buildExecutor(false);
+  addDependency(*gather, {{9, 4}, {1}});
+  addDependency(*gather, {{7, 4, 2}});
+  addDependency(*gather, {{8}, {4, 0}});
+
+  std::vector<std::pair<int64_t, int64_t>> expected{
+      {9, 0}, {8, 2}, {7, 1}, {4, 0}, {4, 1},
+      {4, 2}, {2, 1}, {1, 0}, {0, 2},
+  };
+  EXPECT_EQ(expected, fetchAll(*gather));
+}
+
+TEST_P(SortingGatherExecutorTest, single_dependency) {
+  auto gather = buildExecutor(true);
+  addDependency(*gather, {{1, 2}, {3}});
+
+  std::vector<std::pair<int64_t, int64_t>> expected{{1, 0}, {2, 0}, {3, 0}};
+  EXPECT_EQ(expected, fetchAll(*gather));
+}
+
+}  // namespace arangodb::tests::aql
@@ -42,6 +42,7 @@
 #include "Aql/ReturnExecutor.h"
 #include "Aql/SingleRowFetcher.h"
 #include "Aql/SubqueryEndExecutor.h"
+#include "Aql/SubqueryResultCache.h"
 #include "Aql/SubqueryStartExecutor.h"
 #include "Transaction/Context.h"
 #include "Transaction/Methods.h"
@@ -100,6 +101,17 @@ class SplicedSubqueryIntegrationTest
                                         toKeepRegisterSet);
   }
 
+  // memoizes the subquery results by the value of register 0
+  auto makeMemoizedSubqueryStartExecutorInfos(
+      std::shared_ptr<SubqueryResultCache> cache)
+      -> SubqueryStartExecutor::Infos {
+    auto infos = makeSubqueryStartExecutorInfos();
+    infos.setResultCache(std::move(cache),
+                         {SubqueryResultCache::KeyPart{RegisterId{0}, {}}},
+                         &velocypack::Options::Defaults);
+    return infos;
+  }
+
   auto makeSubqueryEndRegisterInfos(RegisterId inputRegister) -> RegisterInfos {
     auto inputRegisterSet = RegIdSet{inputRegister};
     auto const outputRegister =
@@ -129,6 +141,14 @@ class SplicedSubqueryIntegrationTest
                                       outputRegister);
   }
 
+  auto makeMemoizedSubqueryEndExecutorInfos(
+      RegisterId inputRegister, std::shared_ptr<SubqueryResultCache> cache)
+      -> SubqueryEndExecutor::Infos {
+    auto infos = makeSubqueryEndExecutorInfos(inputRegister);
+    infos.setResultCache(std::move(cache));
+    return infos;
+  }
+
   auto makeDoNothingRegisterInfos() -> RegisterInfos {
     auto numRegs = size_t{1};
 
@@ -325,6 +345,94 @@ TEST_P(SplicedSubqueryIntegrationTest, single_subquery_skip_and_produce) {
       .run();
 };
 
+// for repeated input values, the subquery body does not get any rows, so
+// the results for them must come from the cache
+TEST_P(SplicedSubqueryIntegrationTest, memoized_single_subquery) {
+  auto cache = std::make_shared<SubqueryResultCache>(monitor);
+  auto helper = makeExecutorTestHelper<1, 2>();
+  auto call = AqlCall{};
+
+  helper
+      .addConsumer<SubqueryStartExecutor>(
+          makeSubqueryStartRegisterInfos(),
+          makeMemoizedSubqueryStartExecutorInfos(cache),
+          ExecutionNode::SUBQUERY_START)
+      .addConsumer<SubqueryEndExecutor>(
+          makeSubqueryEndRegisterInfos(0),
+          makeMemoizedSubqueryEndExecutorInfos(0, cache),
+          ExecutionNode::SUBQUERY_END)
+      .setInputValueList(1, 2, 5, 2, 1, 5, 7, 1)
+      .setInputSplitType(getSplit())
+      .setCall(call)
+      .expectOutput({0, 1}, {{1, R"([1])"},
+                             {2, R"([2])"},
+                             {5, R"([5])"},
+                             {2, R"([2])"},
+                             {1, R"([1])"},
+                             {5, R"([5])"},
+                             {7, R"([7])"},
+                             {1, R"([1])"}})
+      .expectSkipped(0)
+      .expectedState(ExecutionState::DONE)
+      .run();
+
+  EXPECT_GT(cache->memoryUsage(), 0);
+};
+
+TEST_P(SplicedSubqueryIntegrationTest,
+       memoized_single_subquery_skip_and_produce) {
+  auto cache = std::make_shared<SubqueryResultCache>(monitor);
+  auto helper = makeExecutorTestHelper<1, 2>();
+  auto call = AqlCall{5};
+
+  helper
+      .addConsumer<SubqueryStartExecutor>(
+          makeSubqueryStartRegisterInfos(),
+          makeMemoizedSubqueryStartExecutorInfos(cache),
+          ExecutionNode::SUBQUERY_START)
+      .addConsumer<SubqueryEndExecutor>(
+          makeSubqueryEndRegisterInfos(0),
+          makeMemoizedSubqueryEndExecutorInfos(0, cache),
+          ExecutionNode::SUBQUERY_END)
+      .setInputValueList(1, 2, 5, 2, 1, 5, 7, 1)
+      .setInputSplitType(getSplit())
+      .setCall(call)
+      .expectOutput({0, 1}, {{5, R"([5])"}, {7, R"([7])"}, {1, R"([1])"}})
+      .expectSkipped(5)
+      .expectedState(ExecutionState::DONE)
+      .run();
+};
+
+// once the memory limit is reached, results are not memoized anymore, but
+// are still correct
+TEST_P(SplicedSubqueryIntegrationTest, memoized_single_subquery_cache_full) {
+  auto cache = std::make_shared<SubqueryResultCache>(monitor, 1);
+  auto helper = makeExecutorTestHelper<1, 2>();
+  auto call = AqlCall{};
+
+  helper
+      .addConsumer<SubqueryStartExecutor>(
+          makeSubqueryStartRegisterInfos(),
+          makeMemoizedSubqueryStartExecutorInfos(cache),
+          ExecutionNode::SUBQUERY_START)
+      .addConsumer<SubqueryEndExecutor>(
+          makeSubqueryEndRegisterInfos(0),
+          makeMemoizedSubqueryEndExecutorInfos(0, cache),
+          ExecutionNode::SUBQUERY_END)
+      .setInputValueList(1, 2, 1, 2)
+      .setInputSplitType(getSplit())
+      .setCall(call)
+      .expectOutput({0, 1}, {{1, R"([1])"},
+                             {2, R"([2])"},
+                             {1, R"([1])"},
+                             {2, R"([2])"}})
+      .expectSkipped(0)
+      .expectedState(ExecutionState::DONE)
+      .run();
+
+  EXPECT_EQ(cache->memoryUsage(), 0);
+};
+
 TEST_P(SplicedSubqueryIntegrationTest, single_subquery_skip_all) {
   auto helper = makeExecutorTestHelper<1, 2>();
   auto call = AqlCall{20};
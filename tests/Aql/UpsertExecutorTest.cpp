@@ -26,7 +26,9 @@
 #include "gtest/gtest.h"
 
 #include "Aql/ExecutionBlock.h"
+#include "Aql/Query.h"
 #include "Basics/StringUtils.h"
+#include "Transaction/StandaloneContext.h"
 #include "VocBase/vocbase.h"
 
 using namespace arangodb;
@@ -332,6 +334,98 @@ TEST_P(UpsertExecutorTest, alternate_insert_update) {
   AssertQueryHasResult(vocbase, GetAllDocs, expected->slice());
 }
 
+TEST_P(UpsertExecutorTest, option_readOwnWrites_duplicate_insert) {
+  std::string query = R"aql(
+      FOR i IN 1..2
+      UPSERT {_key: "duplicate"}
+      INSERT {_key: "duplicate", value: 2, sortValue: 2}
+      )aql" + action() +
+                      R"aql( {value: 3, sortValue: 2}
+      INTO UnitTestCollection)aql";
+  // the lookup of the second row does not see the insert of the first row
+  AssertQueryFailsWith(vocbase, query + " OPTIONS {readOwnWrites: false}",
+                       TRI_ERROR_ARANGO_UNIQUE_CONSTRAINT_VIOLATED);
+  AssertNotChanged();
+
+  AssertQueryHasResult(
+      vocbase,
+      query + " OPTIONS {readOwnWrites: false, ignoreErrors: true}",
+      VPackSlice::emptyArraySlice());
+  auto expected = VPackParser::fromJson(R"([1, 2])");
+  AssertQueryHasResult(vocbase, GetAllDocs, expected->slice());
+
+  // the second row updates the document inserted by the first row
+  AssertQueryHasResult(vocbase, query, VPackSlice::emptyArraySlice());
+  expected = VPackParser::fromJson(R"([1, 3])");
+  AssertQueryHasResult(vocbase, GetAllDocs, expected->slice());
+}
+
+TEST_P(UpsertExecutorTest, option_readOwnWrites_same_document) {
+  std::string query = R"aql(
+      FOR i IN 1..3
+      UPSERT {_key: "testee"}
+      INSERT {value: "invalid"}
+      )aql" + action() +
+                      R"aql( {value: OLD.value + 1, sortValue: 1}
+      INTO UnitTestCollection)aql";
+  // all rows of the batch see the same OLD value. only the first one may
+  // update the document
+  AssertQueryFailsWith(vocbase, query + " OPTIONS {readOwnWrites: false}",
+                       TRI_ERROR_ARANGO_CONFLICT);
+  AssertNotChanged();
+
+  AssertQueryHasResult(
+      vocbase,
+      query + " OPTIONS {readOwnWrites: false, ignoreErrors: true}",
+      VPackSlice::emptyArraySlice());
+  auto expected = VPackParser::fromJson(R"([2])");
+  AssertQueryHasResult(vocbase, GetAllDocs, expected->slice());
+
+  // every row sees the update of the previous row
+  AssertQueryHasResult(vocbase, query, VPackSlice::emptyArraySlice());
+  expected = VPackParser::fromJson(R"([5])");
+  AssertQueryHasResult(vocbase, GetAllDocs, expected->slice());
+}
+
+TEST_P(UpsertExecutorTest, option_readOwnWrites_explain) {
+  auto explain = [&](std::string const& options) {
+    std::string query = R"aql(
+        FOR i IN 1..3
+        UPSERT {_key: "testee"}
+        INSERT {value: i}
+        )aql" + action() +
+                        R"aql( {value: i}
+        INTO UnitTestCollection )aql" +
+                        options;
+    auto q = arangodb::aql::Query::create(
+        std::make_shared<transaction::StandaloneContext>(vocbase),
+        arangodb::aql::QueryString(query), nullptr);
+    auto result = q->explain();
+    EXPECT_TRUE(result.result.ok()) << result.result.errorMessage();
+    return result.data;
+  };
+
+  for (bool readOwnWrites : {true, false}) {
+    auto plan = explain(readOwnWrites ? ""
+                                      : "OPTIONS {readOwnWrites: false}");
+    size_t lookups = 0;
+    size_t upserts = 0;
+    for (VPackSlice node : VPackArrayIterator(plan->slice().get("nodes"))) {
+      std::string_view type = node.get("type").stringView();
+      if (type == "IndexNode" || type == "EnumerateCollectionNode") {
+        ++lookups;
+        EXPECT_EQ(readOwnWrites, node.get("readOwnWrites").isTrue());
+      } else if (type == "UpsertNode") {
+        ++upserts;
+        EXPECT_EQ(readOwnWrites,
+                  node.get({"modificationFlags", "readOwnWrites"}).isTrue());
+      }
+    }
+    EXPECT_EQ(1, lookups);
+    EXPECT_EQ(1, upserts);
+  }
+}
+
 INSTANTIATE_TEST_CASE_P(UpsertExecutorTestBasics, UpsertExecutorTest,
                         ::testing::Values(UpsertType::UPDATE,
                                           UpsertType::REPLACE));
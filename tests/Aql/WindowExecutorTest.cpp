@@ -197,6 +197,25 @@ auto sortedDateRows = MatrixBuilder<2>{
     RowBuilder<2>{t3, 2}, RowBuilder<2>{t4, 2}, RowBuilder<2>{t5, 1},
     RowBuilder<2>{t5, 1}};
 
+// values for which subtracting values that leave the window loses precision,
+// unless the sum is compensated
+auto sortedDoubleRows = MatrixBuilder<2>{
+    RowBuilder<2>{1, R"(1e16)"},  RowBuilder<2>{2, R"(1.5)"},
+    RowBuilder<2>{3, R"(-1e16)"}, RowBuilder<2>{4, R"(2.5)"},
+    RowBuilder<2>{5, R"(0.25)"},  RowBuilder<2>{6, R"(3.75)"}};
+
+// the extreme value leaves the window with every row
+auto sortedDescendingRows = MatrixBuilder<2>{
+    RowBuilder<2>{1, 5}, RowBuilder<2>{2, 4}, RowBuilder<2>{3, 3},
+    RowBuilder<2>{4, 2}, RowBuilder<2>{5, 1}, RowBuilder<2>{6, 0}};
+auto sortedAscendingRows = MatrixBuilder<2>{
+    RowBuilder<2>{1, 0}, RowBuilder<2>{2, 1}, RowBuilder<2>{3, 2},
+    RowBuilder<2>{4, 3}, RowBuilder<2>{5, 4}, RowBuilder<2>{6, 5}};
+// the minimum occurs twice, and leaves the window one after the other
+auto sortedDuplicateMinRows = MatrixBuilder<2>{
+    RowBuilder<2>{1, 3}, RowBuilder<2>{2, 1}, RowBuilder<2>{3, 1},
+    RowBuilder<2>{4, 4}, RowBuilder<2>{5, 5}, RowBuilder<2>{6, 2}};
+
 auto vpackOptions = VPackOptions();
 auto inf = VPackParser::fromJson("\"inf\"", &vpackOptions);
 auto duration1h10m = VPackParser::fromJson("\"PT1H10M\"", &vpackOptions);
@@ -351,7 +370,75 @@ auto WindowInputs = ::testing::Values(
                  {2, 2, 15},
                  {2, 2, 15},
                  {3, 1, 16},
-                 {6, 1, 2}}}
+                 {6, 1, 2}}},
+    // range based input with doubles, offset of one each way
+    WindowInput{boundsRange1,
+                0,
+                "SUM",
+                1,
+                sortedDoubleRows,
+                {{1, R"(1e16)", R"(1.0000000000000002e16)"},
+                 {2, R"(1.5)", R"(1.5)"},
+                 {3, R"(-1e16)", R"(-9999999999999996)"},
+                 {4, R"(2.5)", R"(-9999999999999998)"},
+                 {5, R"(0.25)", R"(6.5)"},
+                 {6, R"(3.75)", R"(4)"}}},
+    WindowInput{boundsRange1,
+                0,
+                "AVERAGE",
+                1,
+                sortedDoubleRows,
+                {{1, R"(1e16)", R"(5000000000000001)"},
+                 {2, R"(1.5)", R"(0.5)"},
+                 {3, R"(-1e16)", R"(-3333333333333332)"},
+                 {4, R"(2.5)", R"(-3333333333333332.5)"},
+                 {5, R"(0.25)", R"(2.1666666666666665)"},
+                 {6, R"(3.75)", R"(2)"}}},
+    // range based input, the current extreme leaves the window
+    WindowInput{boundsRange1,
+                0,
+                "MAX",
+                1,
+                sortedDescendingRows,
+                {{1, 5, 5},
+                 {2, 4, 5},
+                 {3, 3, 4},
+                 {4, 2, 3},
+                 {5, 1, 2},
+                 {6, 0, 1}}},
+    WindowInput{boundsRange1,
+                0,
+                "MIN",
+                1,
+                sortedAscendingRows,
+                {{1, 0, 0},
+                 {2, 1, 0},
+                 {3, 2, 1},
+                 {4, 3, 2},
+                 {5, 4, 3},
+                 {6, 5, 4}}},
+    WindowInput{boundsRange1,
+                0,
+                "MIN",
+                1,
+                sortedDuplicateMinRows,
+                {{1, 3, 1},
+                 {2, 1, 1},
+                 {3, 1, 1},
+                 {4, 4, 1},
+                 {5, 5, 2},
+                 {6, 2, 2}}},
+    WindowInput{boundsRow1,
+                RegisterPlan::MaxRegisterId,
+                "MAX",
+                1,
+                sortedDescendingRows,
+                {{1, 5, 5},
+                 {2, 4, 5},
+                 {3, 3, 4},
+                 {4, 2, 3},
+                 {5, 1, 2},
+                 {6, 0, 1}}}
     // TODO: fix ISO duration regex to enable date range test
     // WindowInput{boundsDateRange, 0, "SUM", 1, sortedRows, {{t0, 5, 6}, {t1,
     // 1, 6}, { t2, 5, 11}, {t3, 2, 13}, {t4, 2, 15}, {t5, 1, 3}, {t5, 1, 1}}}
@@ -0,0 +1,126 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+
+#include "Auth/TokenCache.h"
+#include "Basics/StringUtils.h"
+#include "Cluster/ServerState.h"
+
+#include <fuerte/jwt.h>
+
+#include <string>
+#include <vector>
+
+using namespace arangodb;
+
+namespace arangodb {
+namespace tests {
+namespace token_cache_test {
+
+class TokenCacheTest : public ::testing::Test {
+ protected:
+  // no user manager: only tokens with a server_id are valid
+  auth::TokenCache cache{nullptr, 0.0};
+
+  TokenCacheTest() { setSecret("secret"); }
+
+  void setSecret(std::string const& secret) {
+#ifdef USE_ENTERPRISE
+    cache.setJwtSecrets(secret, {});
+#else
+    cache.setJwtSecret(secret);
+#endif
+  }
+
+  static std::string tokenFor(std::string const& secret) {
+    return fuerte::jwt::generateInternalToken(secret, "PRMR-srv-A");
+  }
+
+  bool authenticated(std::string const& jwt) {
+    return cache
+        .checkAuthentication(rest::AuthenticationMethod::JWT,
+                             ServerState::Mode::DEFAULT, jwt)
+        .authenticated();
+  }
+};
+
+TEST_F(TokenCacheTest, valid_token_is_verified_once) {
+  std::string const jwt = tokenFor("secret");
+  uint64_t const checks = cache.testNumJwtSignatureChecks();
+  EXPECT_TRUE(authenticated(jwt));
+  EXPECT_TRUE(authenticated(jwt));
+  EXPECT_EQ(checks + 1, cache.testNumJwtSignatureChecks());
+}
+
+TEST_F(TokenCacheTest, rejected_token_is_verified_once) {
+  std::string const jwt = tokenFor("other");
+  uint64_t const checks = cache.testNumJwtSignatureChecks();
+  EXPECT_FALSE(authenticated(jwt));
+  EXPECT_FALSE(authenticated(jwt));
+  EXPECT_EQ(checks + 1, cache.testNumJwtSignatureChecks());
+}
+
+TEST_F(TokenCacheTest, malformed_tokens_are_rejected) {
+  uint64_t const checks = cache.testNumJwtSignatureChecks();
+  for (int i = 0; i < 2; ++i) {
+    EXPECT_FALSE(authenticated(""));
+    EXPECT_FALSE(authenticated("abc"));
+    EXPECT_FALSE(authenticated("abc.def"));
+    EXPECT_FALSE(authenticated("abc.def.ghi"));
+  }
+  // none of them got as far as the signature check
+  EXPECT_EQ(checks, cache.testNumJwtSignatureChecks());
+}
+
+TEST_F(TokenCacheTest, secret_change_invalidates_cached_tokens) {
+  std::string const oldJwt = tokenFor("secret");
+  std::string const newJwt = tokenFor("new secret");
+  EXPECT_TRUE(authenticated(oldJwt));
+  EXPECT_FALSE(authenticated(newJwt));
+
+  setSecret("new secret");
+  EXPECT_FALSE(authenticated(oldJwt));
+  EXPECT_TRUE(authenticated(newJwt));
+}
+
+TEST_F(TokenCacheTest, rejected_tokens_do_not_evict_valid_tokens) {
+  std::string const jwt = tokenFor("secret");
+  EXPECT_TRUE(authenticated(jwt));
+
+  // many more invalid tokens than the rejected tokens of all shards can
+  // hold. they only differ in their signatures
+  std::vector<std::string> const parts =
+      basics::StringUtils::split(tokenFor("other"), '.');
+  ASSERT_EQ(3U, parts.size());
+  for (size_t i = 0; i < 10000; ++i) {
+    EXPECT_FALSE(authenticated(parts[0] + "." + parts[1] + "." + parts[2] +
+                               std::to_string(i)));
+  }
+
+  uint64_t const checks = cache.testNumJwtSignatureChecks();
+  EXPECT_TRUE(authenticated(jwt));
+  EXPECT_EQ(checks, cache.testNumJwtSignatureChecks());
+}
+
+}  // namespace token_cache_test
+}  // namespace tests
+}  // namespace arangodb
@@ -339,3 +339,22 @@ TEST_F(CCsvTest, tst_csv_semicolon_noquote) {
 
   TRI_DestroyCsvParser(&parser);
 }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test csv split into single characters
+////////////////////////////////////////////////////////////////////////////////
+
+TEST_F(CCsvTest, tst_csv_split_input) {
+  INIT_PARSER
+  TRI_SetSeparatorCsvParser(&parser, ',');
+  TRI_SetQuoteCsvParser(&parser, '"', true);
+
+  const char* csv = "abc,\"d\"\"e\"\"f\",gh" LF "\"ij\",k" CR LF;
+
+  for (size_t i = 0; i < strlen(csv); ++i) {
+    TRI_ParseCsvString(&parser, csv + i, 1);
+  }
+  EXPECT_EQ("0:abc,ESCd\"e\"fESC,gh\n1:ESCijESC,k\n", out.str());
+
+  TRI_DestroyCsvParser(&parser);
+}
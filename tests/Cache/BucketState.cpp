@@ -95,3 +95,41 @@ TEST(CacheBucketStateTest, test_methods_for_nonlock_flags) {
   ASSERT_FALSE(state.isSet(BucketState::Flag::migrated));
   state.unlock();
 }
+
+TEST(CacheBucketStateTest, test_optimistic_reads) {
+  BucketState state;
+
+  // no concurrent modification
+  auto snapshot = state.beginOptimisticRead();
+  ASSERT_TRUE(state.validateOptimisticRead(snapshot));
+
+  // locked while reading
+  snapshot = state.beginOptimisticRead();
+  ASSERT_TRUE(state.lock());
+  ASSERT_FALSE(state.validateOptimisticRead(snapshot));
+
+  // locked at the start of the read
+  snapshot = state.beginOptimisticRead();
+  ASSERT_TRUE(BucketState::isSet(snapshot, BucketState::Flag::locked));
+  ASSERT_FALSE(state.validateOptimisticRead(snapshot));
+  state.unlock();
+  ASSERT_FALSE(state.validateOptimisticRead(snapshot));
+
+  // locked and unlocked while reading
+  snapshot = state.beginOptimisticRead();
+  ASSERT_TRUE(state.lock());
+  state.toggleFlag(BucketState::Flag::migrated);
+  state.clear();
+  state.unlock();
+  ASSERT_FALSE(state.validateOptimisticRead(snapshot));
+  ASSERT_FALSE(state.isLocked());
+
+  // flags are kept across unlocks
+  ASSERT_TRUE(state.lock());
+  state.toggleFlag(BucketState::Flag::migrated);
+  state.unlock();
+  snapshot = state.beginOptimisticRead();
+  ASSERT_TRUE(BucketState::isSet(snapshot, BucketState::Flag::migrated));
+  ASSERT_FALSE(BucketState::isSet(snapshot, BucketState::Flag::locked));
+  ASSERT_TRUE(state.validateOptimisticRead(snapshot));
+}
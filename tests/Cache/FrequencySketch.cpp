@@ -0,0 +1,69 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2020 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+
+#include <cstdint>
+
+#include "Cache/FrequencySketch.h"
+
+using namespace arangodb::cache;
+
+TEST(CacheFrequencySketchTest, test_estimates) {
+  FrequencySketch sketch(1024);
+  ASSERT_EQ(sketch.memoryUsage(), sizeof(FrequencySketch) +
+                                      FrequencySketch::allocationSize(1024));
+
+  ASSERT_EQ(0, sketch.estimate(1));
+  ASSERT_EQ(0, sketch.estimate(2));
+
+  sketch.record(1);
+  ASSERT_GE(sketch.estimate(1), 1);
+
+  for (std::size_t i = 0; i < 5; i++) {
+    sketch.record(2);
+  }
+  // count-min sketches may overestimate, but never underestimate
+  ASSERT_GE(sketch.estimate(2), 5);
+  ASSERT_GT(sketch.estimate(2), sketch.estimate(1));
+
+  // counters saturate
+  for (std::size_t i = 0; i < 100; i++) {
+    sketch.record(3);
+  }
+  ASSERT_EQ(FrequencySketch::kMaxCount, sketch.estimate(3));
+}
+
+TEST(CacheFrequencySketchTest, test_aging) {
+  FrequencySketch sketch(1024);
+
+  for (std::size_t i = 0; i < 100; i++) {
+    sketch.record(42);
+  }
+  ASSERT_EQ(FrequencySketch::kMaxCount, sketch.estimate(42));
+
+  // many accesses to other keys halve all counters, so that keys which are
+  // not accessed anymore lose their popularity
+  for (std::uint32_t i = 0; i < 10 * 1024; i++) {
+    sketch.record(1000 + i);
+  }
+  ASSERT_LT(sketch.estimate(42), FrequencySketch::kMaxCount);
+}
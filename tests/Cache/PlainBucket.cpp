@@ -206,3 +206,34 @@ TEST(CachePlainBucketTest, verify_eviction_works_correctly) {
     delete ptrs[i];
   }
 }
+
+TEST(CachePlainBucketTest, verify_may_contain_without_locking) {
+  auto bucket = std::make_unique<PlainBucket>();
+
+  std::uint64_t key = 1;
+  std::uint64_t value = 2;
+  CachedValue* ptr = CachedValue::construct(&key, sizeof(std::uint64_t),
+                                            &value, sizeof(std::uint64_t));
+  TRI_ASSERT(ptr != nullptr);
+
+  ASSERT_FALSE(bucket->mayContain(5));
+
+  ASSERT_TRUE(bucket->lock(-1LL));
+  // a locked bucket may be modified concurrently
+  ASSERT_TRUE(bucket->mayContain(5));
+  bucket->insert(5, ptr);
+  bucket->unlock();
+
+  ASSERT_TRUE(bucket->mayContain(5));
+  ASSERT_FALSE(bucket->mayContain(6));
+
+  ASSERT_TRUE(bucket->lock(-1LL));
+  CachedValue* res =
+      bucket->remove<BinaryKeyHasher>(5, ptr->key(), ptr->keySize());
+  ASSERT_EQ(res, ptr);
+  bucket->unlock();
+
+  ASSERT_FALSE(bucket->mayContain(5));
+
+  delete ptr;
+}
@@ -24,6 +24,7 @@
 
 #include "gtest/gtest.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <string>
 #include <thread>
@@ -262,6 +263,51 @@ TEST(CacheTransactionalCacheTest, verify_banishing_works_as_expected) {
   manager.destroyCache(std::move(cache));
 }
 
+TEST(CacheTransactionalCacheTest, verify_recent_keys_returns_cached_keys) {
+  std::uint64_t cacheLimit = 128 * 1024;
+  auto postFn = [](std::function<void()>) -> bool { return false; };
+  MockMetricsServer server;
+  SharedPRNGFeature& sharedPRNG = server.getFeature<SharedPRNGFeature>();
+  CacheOptions co;
+  co.cacheSize = 4 * cacheLimit;
+  Manager manager(sharedPRNG, postFn, co);
+  auto cache = manager.createCache<BinaryKeyHasher>(CacheType::Transactional,
+                                                    false, cacheLimit);
+
+  ASSERT_TRUE(cache->recentKeys(100).empty());
+
+  std::vector<std::uint64_t> inserted;
+  for (std::uint64_t i = 0; i < 256; i++) {
+    CachedValue* value = CachedValue::construct(&i, sizeof(std::uint64_t), &i,
+                                                sizeof(std::uint64_t));
+    TRI_ASSERT(value != nullptr);
+    auto status = cache->insert(value);
+    if (status == TRI_ERROR_NO_ERROR) {
+      inserted.push_back(i);
+    } else {
+      delete value;
+    }
+  }
+  ASSERT_FALSE(inserted.empty());
+
+  auto keys = cache->recentKeys(inserted.size() + 100);
+  // keys can be evicted or skipped because of locking, but we must not get
+  // any keys that were never inserted
+  ASSERT_LE(keys.size(), inserted.size());
+  ASSERT_FALSE(keys.empty());
+  for (auto const& key : keys) {
+    ASSERT_EQ(sizeof(std::uint64_t), key.size());
+    std::uint64_t i;
+    memcpy(&i, key.data(), sizeof(std::uint64_t));
+    ASSERT_NE(inserted.end(), std::find(inserted.begin(), inserted.end(), i));
+  }
+
+  ASSERT_EQ(std::min<std::size_t>(keys.size(), 10),
+            cache->recentKeys(10).size());
+
+  manager.destroyCache(std::move(cache));
+}
+
 TEST(CacheTransactionalCacheTest,
      verify_cache_can_grow_correctly_when_it_runs_out_of_space_LongRunning) {
   MockScheduler scheduler(4);
@@ -32,3 +32,51 @@ TEST(AutoShardRebalancer, simple_randomized_test) {
                     << " !";
   EXPECT_LE(moves.size(), atMostJobs);
 }
+
+TEST(AutoShardRebalancer, apply_shard_loads) {
+  AutoRebalanceProblem p;
+  p.createCluster(3, false);
+  p.createDatabase("db");
+  p.createCollection("coll", "db", 4, 1);
+  ASSERT_EQ(p.shards.size(), 4);
+  for (auto& shard : p.shards) {
+    shard.name = "s" + std::to_string(shard.id);
+  }
+  uint64_t const defaultSize = p.shards[0].size;
+
+  // s3 is not reported at all, s1 does not report a size
+  std::unordered_map<std::string, ShardLoad> loads{
+      {"s0", ShardLoad{.size = 4096, .writes = 0}},
+      {"s1", ShardLoad{.size = 0, .writes = 100}},
+      {"s2", ShardLoad{.size = 8192, .writes = 300}},
+      {"unknown", ShardLoad{.size = 1, .writes = 1000}},
+  };
+  p.applyShardLoads(loads);
+
+  EXPECT_EQ(p.shards[0].size, 4096);
+  EXPECT_EQ(p.shards[1].size, defaultSize);
+  EXPECT_EQ(p.shards[2].size, 8192);
+  EXPECT_EQ(p.shards[3].size, defaultSize);
+
+  // the mean number of writes is 100
+  EXPECT_DOUBLE_EQ(p.shards[0].weight, 0.5);
+  EXPECT_DOUBLE_EQ(p.shards[1].weight, 1.0);
+  EXPECT_DOUBLE_EQ(p.shards[2].weight, 2.0);
+  EXPECT_DOUBLE_EQ(p.shards[3].weight, 0.5);
+}
+
+TEST(AutoShardRebalancer, apply_shard_loads_without_writes) {
+  AutoRebalanceProblem p;
+  p.createCluster(3, false);
+  p.createDatabase("db");
+  p.createCollection("coll", "db", 2, 1, 3.0);
+  for (auto& shard : p.shards) {
+    shard.name = "s" + std::to_string(shard.id);
+  }
+
+  p.applyShardLoads({{"s0", ShardLoad{.size = 4096, .writes = 0}}});
+
+  EXPECT_EQ(p.shards[0].size, 4096);
+  EXPECT_DOUBLE_EQ(p.shards[0].weight, 3.0);
+  EXPECT_DOUBLE_EQ(p.shards[1].weight, 3.0);
+}
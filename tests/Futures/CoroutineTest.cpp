@@ -0,0 +1,118 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Futures/Coroutine.h"
+
+#include "gtest/gtest.h"
+
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace arangodb::futures;
+
+namespace {
+Future<int> addOne(Future<int>&& f) { co_return co_await std::move(f) + 1; }
+
+Future<int> sumAll(std::vector<Future<int>>&& fs) {
+  int sum = 0;
+  for (auto& f : fs) {
+    sum += co_await std::move(f);
+  }
+  co_return sum;
+}
+
+Future<bool> hasException(Future<int>&& f) {
+  auto result = co_await asTry(std::move(f));
+  co_return result.hasException();
+}
+}  // namespace
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                        test suite
+// -----------------------------------------------------------------------------
+
+TEST(CoroutineTest, await_ready_future) {
+  auto f = addOne(Future<int>{41});
+  ASSERT_TRUE(f.isReady());
+  ASSERT_EQ(f.get(), 42);
+}
+
+TEST(CoroutineTest, await_pending_future) {
+  Promise<int> p;
+  auto f = addOne(p.getFuture());
+  ASSERT_FALSE(f.isReady());
+  p.setValue(41);
+  ASSERT_TRUE(f.isReady());
+  ASSERT_EQ(f.get(), 42);
+}
+
+TEST(CoroutineTest, await_future_fulfilled_by_other_thread) {
+  Promise<int> p;
+  auto f = addOne(p.getFuture());
+  std::thread t([&] { p.setValue(41); });
+  ASSERT_EQ(std::move(f).get(), 42);
+  t.join();
+}
+
+TEST(CoroutineTest, await_many_ready_futures) {
+  std::vector<Future<int>> fs;
+  for (int i = 0; i < 100000; ++i) {
+    fs.emplace_back(1);
+  }
+  auto f = sumAll(std::move(fs));
+  ASSERT_TRUE(f.isReady());
+  ASSERT_EQ(f.get(), 100000);
+}
+
+TEST(CoroutineTest, await_many_pending_futures) {
+  std::vector<Promise<int>> ps(1000);
+  std::vector<Future<int>> fs;
+  for (auto& p : ps) {
+    fs.emplace_back(p.getFuture());
+  }
+  auto f = sumAll(std::move(fs));
+  for (auto& p : ps) {
+    ASSERT_FALSE(f.isReady());
+    p.setValue(1);
+  }
+  ASSERT_TRUE(f.isReady());
+  ASSERT_EQ(f.get(), 1000);
+}
+
+TEST(CoroutineTest, exception_is_propagated) {
+  Promise<int> p;
+  auto f = addOne(p.getFuture());
+  p.setException(std::logic_error("abc"));
+  ASSERT_TRUE(f.isReady());
+  ASSERT_TRUE(f.hasException());
+  ASSERT_THROW(f.get(), std::logic_error);
+}
+
+TEST(CoroutineTest, as_try_does_not_throw) {
+  Promise<int> p;
+  auto f = hasException(p.getFuture());
+  p.setException(std::logic_error("abc"));
+  ASSERT_TRUE(f.isReady());
+  ASSERT_TRUE(f.get());
+
+  ASSERT_FALSE(hasException(Future<int>{1}).get());
+}
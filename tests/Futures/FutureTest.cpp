@@ -26,9 +26,11 @@
 
 #include "gtest/gtest.h"
 
+#include <array>
 #include <condition_variable>
 #include <exception>
 #include <mutex>
+#include <numeric>
 
 using namespace arangodb::futures;
 
@@ -707,6 +709,36 @@ TEST(FutureTest, finish) {
   ASSERT_EQ(1, x.use_count());
 }
 
+TEST(FutureTest, callbackOnReadyFuture) {
+  auto x = std::make_shared<int>(0);
+
+  // executed right away, as the result is already there
+  auto f = makeFuture(42).thenValue([x](int v) { *x = v; });
+  ASSERT_TRUE(f.isReady());
+  ASSERT_EQ(42, *x);
+
+  // the callback has been destructed
+  ASSERT_EQ(1, x.use_count());
+}
+
+TEST(FutureTest, largeCallback) {
+  // does not fit into the inline storage for callbacks
+  std::array<int, 64> values;
+  values.fill(1);
+
+  Promise<int> p;
+  auto f = p.getFuture().thenValue([values](int v) {
+    return std::accumulate(values.begin(), values.end(), v);
+  });
+  p.setValue(42);
+  ASSERT_EQ(106, f.get());
+
+  auto f2 = makeFuture(42).thenValue([values](int v) {
+    return std::accumulate(values.begin(), values.end(), v);
+  });
+  ASSERT_EQ(106, f2.get());
+}
+
 TEST(FutureTest, detachRace) {
   // This test is designed to detect a race that was in Core::detachOne()
   // where detached_ was incremented and then tested, and that
@@ -23,6 +23,7 @@
 
 #include "gtest/gtest.h"
 
+#include <algorithm>
 #include <map>
 
 #include "Basics/StringUtils.h"
@@ -469,3 +470,33 @@ TEST_F(QueryPointsContainedInTest, rectangle) {
   AscIterator near(std::move(params));
   checkResult(nearSearch(index, docs, near, 10000), {{1.0, 1.0}});
 }
+
+TEST(ScanIntervalsTest, adjacent_intervals_are_merged) {
+  geo::QueryParams params;
+  params.pointsOnly = false;
+  S2CellId parent = S2CellId::FromLatLng(S2LatLng::FromDegrees(50.0, 8.0))
+                        .parent(params.cover.worstIndexedLevel + 4);
+
+  // the ranges of the two middle children are separated only by the exact
+  // id of the parent, so they are scanned as one interval
+  std::vector<S2CellId> cover{parent.child(1), parent.child(2)};
+  std::vector<geo::Interval> intervals;
+  geo::utils::scanIntervals(params, cover, intervals);
+
+  auto it = std::find_if(intervals.begin(), intervals.end(),
+                         [&](geo::Interval const& interval) {
+                           return interval.range_min ==
+                                  parent.child(1).range_min();
+                         });
+  ASSERT_NE(it, intervals.end());
+  EXPECT_EQ(parent.child(2).range_max(), it->range_max);
+
+  // all other intervals are the exact ids of the parent's ancestors
+  EXPECT_EQ(static_cast<size_t>(1 + parent.level() -
+                                params.cover.worstIndexedLevel),
+            intervals.size());
+  for (size_t i = 1; i < intervals.size(); ++i) {
+    EXPECT_LT(intervals[i - 1].range_max.id() + 1,
+              intervals[i].range_min.id());
+  }
+}
@@ -105,6 +105,24 @@ TEST_F(VPackLoadInspectorTest, load_object) {
   EXPECT_EQ("foobar", d.s);
 }
 
+TEST_F(VPackLoadInspectorTest, load_object_with_attributes_in_different_order) {
+  builder.openObject();
+  builder.add("s", VPackValue("foobar"));
+  builder.add("b", VPackValue(true));
+  builder.add("i", VPackValue(42));
+  builder.add("d", VPackValue(123.456));
+  builder.close();
+  VPackLoadInspector inspector{builder};
+
+  Dummy d;
+  auto result = inspector.apply(d);
+  ASSERT_TRUE(result.ok());
+  EXPECT_EQ(42, d.i);
+  EXPECT_EQ(123.456, d.d);
+  EXPECT_EQ(true, d.b);
+  EXPECT_EQ("foobar", d.s);
+}
+
 TEST_F(VPackLoadInspectorTest, load_nested_object) {
   builder.openObject();
   builder.add(VPackValue("dummy"));
@@ -857,6 +875,22 @@ TEST_F(VPackLoadInspectorTest, error_found_unexpected_attribute) {
   EXPECT_EQ("Found unexpected attribute 'should_not_be_here'", result.error());
 }
 
+TEST_F(VPackLoadInspectorTest, error_found_unexpected_attribute_between_known) {
+  builder.openObject();
+  builder.add("d", VPackValue(123.456));
+  builder.add("i", VPackValue(42));
+  builder.add("should_not_be_here", VPackValue(123));
+  builder.add("s", VPackValue("foobar"));
+  builder.add("b", VPackValue(true));
+  builder.close();
+  VPackLoadInspector inspector{builder};
+
+  Dummy d;
+  auto result = inspector.apply(d);
+  ASSERT_FALSE(result.ok());
+  EXPECT_EQ("Found unexpected attribute 'should_not_be_here'", result.error());
+}
+
 TEST_F(VPackLoadInspectorTest, load_object_ignoring_unknown_attributes) {
   builder.openObject();
   builder.add("i", VPackValue(42));
@@ -111,6 +111,9 @@ TEST(MetricsTest, test_histogram_concurrency_same) {
   ASSERT_EQ(h.load(1), 0);
   ASSERT_EQ(h.load(2), 0);
   ASSERT_EQ(h.load(3), 0);
+  // the observations of the threads are spread over multiple stripes
+  ASSERT_EQ(h[0], ::numThreads * ::numOpsPerThread);
+  ASSERT_EQ(h[1], 0);
 }
 
 TEST(MetricsTest, test_histogram_concurrency_distributed) {
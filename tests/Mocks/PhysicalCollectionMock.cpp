@@ -192,6 +192,37 @@ class AllIteratorMock final : public arangodb::IndexIterator {
                      PhysicalCollectionMock::DocElement>::const_iterator _it;
 };  // AllIteratorMock
 
+class RangeIteratorMock final : public arangodb::IndexIterator {
+ public:
+  RangeIteratorMock(std::vector<arangodb::LocalDocumentId> ids,
+                    arangodb::LogicalCollection& coll,
+                    arangodb::transaction::Methods* trx,
+                    arangodb::ReadOwnWrites readOwnWrites)
+      : arangodb::IndexIterator(&coll, trx, readOwnWrites),
+        _ids(std::move(ids)),
+        _position(0) {}
+
+  std::string_view typeName() const noexcept final {
+    return "RangeIteratorMock";
+  }
+
+  void resetImpl() override { _position = 0; }
+
+  bool nextImpl(LocalDocumentIdCallback const& callback,
+                uint64_t limit) override {
+    while (_position < _ids.size() && limit != 0) {
+      callback(_ids[_position++]);
+      --limit;
+    }
+    return _position < _ids.size();
+  }
+
+ private:
+  // the ids of the documents in the range, in ascending order
+  std::vector<arangodb::LocalDocumentId> _ids;
+  size_t _position;
+};  // RangeIteratorMock
+
 class EdgeIndexMock final : public arangodb::Index {
  public:
   static std::shared_ptr<arangodb::Index> make(
@@ -930,6 +961,269 @@ class HashIndexMock final : public arangodb::Index {
   HashIndexMap _hashData;
 };  // HashIndexMock
 
+/// @brief index entries of the persistent index mock, sorted by the index
+/// values and then by document id, like in the RocksDB persistent index
+using PersistentIndexEntries =
+    std::vector<std::pair<VPackBuilder, arangodb::LocalDocumentId>>;
+
+class PersistentIndexIteratorMock final : public arangodb::IndexIterator {
+ public:
+  PersistentIndexIteratorMock(arangodb::LogicalCollection* collection,
+                              arangodb::transaction::Methods* trx,
+                              PersistentIndexEntries const& entries,
+                              std::unique_ptr<VPackBuilder>&& keys,
+                              bool ascending)
+      : IndexIterator(collection, trx, arangodb::ReadOwnWrites::no),
+        _entries(entries),
+        _keys(std::move(keys)),
+        _ascending(ascending),
+        _position(0) {}
+
+  std::string_view typeName() const noexcept final {
+    return "persistent-index-iterator-mock";
+  }
+
+  bool nextCoveringImpl(CoveringCallback const& cb, uint64_t limit) override {
+    while (limit && next()) {
+      auto const& entry = current();
+      auto data = SliceCoveringData(entry.first.slice());
+      cb(entry.second, data);
+      --limit;
+    }
+    return hasMore();
+  }
+
+  bool nextImpl(LocalDocumentIdCallback const& cb, uint64_t limit) override {
+    while (limit && next()) {
+      cb(current().second);
+      --limit;
+    }
+    return hasMore();
+  }
+
+  void resetImpl() override { _position = 0; }
+
+ private:
+  /// @brief move forward to the next entry matching the lookup values.
+  /// returns false if there is none
+  bool next() {
+    while (_position < _entries.size()) {
+      ++_position;
+      if (matches(current().first.slice())) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  bool hasMore() const {
+    for (size_t i = _position; i < _entries.size(); ++i) {
+      if (matches(entry(i).first.slice())) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  bool matches(VPackSlice values) const {
+    size_t i = 0;
+    for (auto key : VPackArrayIterator(_keys->slice())) {
+      if (arangodb::basics::VelocyPackHelper::compare(values.at(i++), key,
+                                                      true) != 0) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /// @brief the i-th entry in iteration order
+  PersistentIndexEntries::value_type const& entry(size_t i) const {
+    return _ascending ? _entries[i] : _entries[_entries.size() - 1 - i];
+  }
+
+  /// @brief the entry the iterator was moved to by next()
+  PersistentIndexEntries::value_type const& current() const {
+    TRI_ASSERT(_position > 0);
+    return entry(_position - 1);
+  }
+
+  PersistentIndexEntries const& _entries;
+  /// @brief the lookup values for the leading index fields
+  std::unique_ptr<VPackBuilder> _keys;
+  bool const _ascending;
+  size_t _position;
+};  // PersistentIndexIteratorMock
+
+/// @brief sorted index, which supports full scans in both directions and
+/// equality lookups on the leading index fields
+class PersistentIndexMock final : public arangodb::Index {
+ public:
+  static std::shared_ptr<arangodb::Index> make(
+      arangodb::IndexId iid, arangodb::LogicalCollection& collection,
+      arangodb::velocypack::Slice const& definition) {
+    auto const type = arangodb::basics::VelocyPackHelper::getStringView(
+        definition.get("type"), std::string_view());
+
+    if (type.compare("persistent") != 0) {
+      return nullptr;
+    }
+
+    return std::make_shared<PersistentIndexMock>(iid, collection, definition);
+  }
+
+  IndexType type() const override {
+    return Index::TRI_IDX_TYPE_PERSISTENT_INDEX;
+  }
+
+  char const* typeName() const override { return "persistent"; }
+
+  bool canBeDropped() const override { return true; }
+
+  bool isHidden() const override { return false; }
+
+  bool isSorted() const override { return true; }
+
+  bool hasSelectivityEstimate() const override { return false; }
+
+  size_t memory() const override { return sizeof(PersistentIndexMock); }
+
+  void load() override {}
+
+  void unload() override {}
+
+  void toVelocyPack(VPackBuilder& builder,
+                    std::underlying_type<arangodb::Index::Serialize>::type
+                        flags) const override {
+    builder.openObject();
+    Index::toVelocyPack(builder, flags);
+    builder.add("sparse", VPackValue(sparse()));
+    builder.add("unique", VPackValue(unique()));
+    builder.close();
+  }
+
+  void toVelocyPackFigures(VPackBuilder& builder) const override {
+    Index::toVelocyPackFigures(builder);
+  }
+
+  arangodb::Result insert(arangodb::transaction::Methods&,
+                          arangodb::LocalDocumentId const& documentId,
+                          arangodb::velocypack::Slice const doc) {
+    if (!doc.isObject()) {
+      return {TRI_ERROR_INTERNAL};
+    }
+
+    VPackBuilder values;
+    values.openArray();
+    for (auto const& field : _fields) {
+      VPackSlice value = doc;
+      for (auto const& part : field) {
+        value =
+            value.isObject() ? value.get(part.name) : VPackSlice::noneSlice();
+      }
+      if (value.isNone()) {
+        // like in the persistent index, a missing attribute is indexed as null
+        value = VPackSlice::nullSlice();
+      }
+      values.add(value);
+    }
+    values.close();
+
+    auto pos = std::upper_bound(
+        _entries.begin(), _entries.end(), std::make_pair(values, documentId),
+        [](auto const& lhs, auto const& rhs) {
+          int cmp = arangodb::basics::VelocyPackHelper::compare(
+              lhs.first.slice(), rhs.first.slice(), true);
+          return cmp < 0 || (cmp == 0 && lhs.second < rhs.second);
+        });
+    _entries.emplace(pos, std::move(values), documentId);
+
+    return {};  // ok
+  }
+
+  Index::FilterCosts supportsFilterCondition(
+      arangodb::transaction::Methods& /*trx*/,
+      std::vector<std::shared_ptr<arangodb::Index>> const& allIndexes,
+      arangodb::aql::AstNode const* node,
+      arangodb::aql::Variable const* reference,
+      size_t itemsInIndex) const override {
+    return arangodb::SortedIndexAttributeMatcher::supportsFilterCondition(
+        allIndexes, this, node, reference, itemsInIndex);
+  }
+
+  Index::SortCosts supportsSortCondition(
+      arangodb::aql::SortCondition const* sortCondition,
+      arangodb::aql::Variable const* reference,
+      size_t itemsInIndex) const override {
+    return arangodb::SortedIndexAttributeMatcher::supportsSortCondition(
+        this, sortCondition, reference, itemsInIndex);
+  }
+
+  arangodb::aql::AstNode* specializeCondition(
+      arangodb::transaction::Methods& /*trx*/, arangodb::aql::AstNode* node,
+      arangodb::aql::Variable const* reference) const override {
+    return arangodb::SortedIndexAttributeMatcher::specializeCondition(
+        this, node, reference);
+  }
+
+  std::unique_ptr<arangodb::IndexIterator> iteratorForCondition(
+      arangodb::ResourceMonitor& monitor, arangodb::transaction::Methods* trx,
+      arangodb::aql::AstNode const* node, arangodb::aql::Variable const*,
+      arangodb::IndexIteratorOptions const& opts, arangodb::ReadOwnWrites,
+      int) override {
+    arangodb::transaction::BuilderLeaser builder(trx);
+    std::unique_ptr<VPackBuilder> keys(builder.steal());
+    keys->openArray();
+    if (node != nullptr) {
+      TRI_ASSERT(node->type == arangodb::aql::NODE_TYPE_OPERATOR_NARY_AND);
+      // only equality lookups on the leading index fields are supported
+      size_t numKeys = 0;
+      for (auto const& field : _fields) {
+        arangodb::aql::AstNode const* value = nullptr;
+        for (size_t i = 0; i < node->numMembers() && value == nullptr; ++i) {
+          auto comp = node->getMember(i);
+          if (comp->type != arangodb::aql::NODE_TYPE_OPERATOR_BINARY_EQ) {
+            return std::make_unique<arangodb::EmptyIndexIterator>(&_collection,
+                                                                  trx);
+          }
+          for (size_t j = 0; j < 2; ++j) {
+            std::pair<arangodb::aql::Variable const*,
+                      std::vector<arangodb::basics::AttributeName>>
+                attribute;
+            if (comp->getMember(j)->isAttributeAccessForVariable(attribute) &&
+                arangodb::basics::AttributeName::isIdentical(attribute.second,
+                                                             field, false)) {
+              value = comp->getMember(1 - j);
+              break;
+            }
+          }
+        }
+        if (value == nullptr) {
+          break;
+        }
+        value->toVelocyPackValue(*keys);
+        ++numKeys;
+      }
+      if (numKeys != node->numMembers()) {
+        keys->close();
+        return std::make_unique<arangodb::EmptyIndexIterator>(&_collection,
+                                                              trx);
+      }
+    }
+    keys->close();
+
+    return std::make_unique<PersistentIndexIteratorMock>(
+        &_collection, trx, _entries, std::move(keys), opts.ascending);
+  }
+
+  PersistentIndexMock(arangodb::IndexId iid,
+                      arangodb::LogicalCollection& collection,
+                      VPackSlice const& slice)
+      : arangodb::Index(iid, collection, slice) {}
+
+ private:
+  PersistentIndexEntries _entries;
+};  // PersistentIndexMock
+
 }  // namespace
 
 PhysicalCollectionMock::DocElement::DocElement(
@@ -992,6 +1286,8 @@ std::shared_ptr<arangodb::Index> PhysicalCollectionMock::createIndex(
     index = EdgeIndexMock::make(id, _logicalCollection, info);
   } else if (type == "hash") {
     index = HashIndexMock::make(id, _logicalCollection, info);
+  } else if (type == "persistent") {
+    index = PersistentIndexMock::make(id, _logicalCollection, info);
   } else if (type == "inverted") {
     index =
         StorageEngineMock::buildInvertedIndexMock(id, _logicalCollection, info);
@@ -1035,6 +1331,13 @@ std::shared_ptr<arangodb::Index> PhysicalCollectionMock::createIndex(
     for (auto const& pair : docs) {
       l->insert(trx, pair.first, pair.second);
     }
+  } else if (index->type() ==
+             arangodb::Index::TRI_IDX_TYPE_PERSISTENT_INDEX) {
+    auto* l = dynamic_cast<PersistentIndexMock*>(index.get());
+    TRI_ASSERT(l != nullptr);
+    for (auto const& pair : docs) {
+      l->insert(trx, pair.first, pair.second);
+    }
   } else if (index->type() == arangodb::Index::TRI_IDX_TYPE_IRESEARCH_LINK) {
     auto* l =
         dynamic_cast<arangodb::iresearch::IResearchLinkMock*>(index.get());
@@ -1115,6 +1418,46 @@ std::unique_ptr<arangodb::IndexIterator> PhysicalCollectionMock::getAnyIterator(
                                            trx, arangodb::ReadOwnWrites::no);
 }
 
+std::unique_ptr<arangodb::IndexIterator>
+PhysicalCollectionMock::getRangeIterator(
+    arangodb::transaction::Methods* trx, arangodb::ReadOwnWrites readOwnWrites,
+    arangodb::LocalDocumentId lower, arangodb::LocalDocumentId upper) const {
+  before();
+
+  std::vector<arangodb::LocalDocumentId> ids;
+  for (auto const& entry : _documents) {
+    auto id = entry.second.docId();
+    if (lower <= id && (upper.empty() || id < upper)) {
+      ids.emplace_back(id);
+    }
+  }
+  std::sort(ids.begin(), ids.end());
+  _numRangeIterators.fetch_add(1, std::memory_order_relaxed);
+  return std::make_unique<RangeIteratorMock>(
+      std::move(ids), this->_logicalCollection, trx, readOwnWrites);
+}
+
+std::vector<arangodb::LocalDocumentId>
+PhysicalCollectionMock::partitionDocuments(size_t partitions) const {
+  before();
+
+  std::vector<arangodb::LocalDocumentId> ids;
+  ids.reserve(_documents.size());
+  for (auto const& entry : _documents) {
+    ids.emplace_back(entry.second.docId());
+  }
+  std::vector<arangodb::LocalDocumentId> result;
+  if (partitions <= 1 || ids.size() < partitions) {
+    return result;
+  }
+  // ranges with the same number of documents each
+  std::sort(ids.begin(), ids.end());
+  for (size_t i = 1; i < partitions; ++i) {
+    result.emplace_back(ids[ids.size() / partitions * i]);
+  }
+  return result;
+}
+
 std::unique_ptr<arangodb::ReplicationIterator>
 PhysicalCollectionMock::getReplicationIterator(
     arangodb::ReplicationIterator::Ordering, uint64_t) {
@@ -1169,6 +1512,13 @@ arangodb::Result PhysicalCollectionMock::insert(
         return {TRI_ERROR_BAD_PARAMETER};
       }
       continue;
+    } else if (index->type() ==
+               arangodb::Index::TRI_IDX_TYPE_PERSISTENT_INDEX) {
+      auto* l = static_cast<PersistentIndexMock*>(index.get());
+      if (!l->insert(trx, id, newDocument).ok()) {
+        return {TRI_ERROR_BAD_PARAMETER};
+      }
+      continue;
     } else if (index->type() == arangodb::Index::TRI_IDX_TYPE_IRESEARCH_LINK) {
       auto* l =
           static_cast<arangodb::iresearch::IResearchLinkMock*>(index.get());
@@ -65,6 +65,12 @@ class PhysicalCollectionMock : public arangodb::PhysicalCollection {
       arangodb::ReadOwnWrites readOwnWrites) const override;
   std::unique_ptr<arangodb::IndexIterator> getAnyIterator(
       arangodb::transaction::Methods* trx) const override;
+  std::unique_ptr<arangodb::IndexIterator> getRangeIterator(
+      arangodb::transaction::Methods* trx,
+      arangodb::ReadOwnWrites readOwnWrites, arangodb::LocalDocumentId lower,
+      arangodb::LocalDocumentId upper) const override;
+  std::vector<arangodb::LocalDocumentId> partitionDocuments(
+      size_t partitions) const override;
   std::unique_ptr<arangodb::ReplicationIterator> getReplicationIterator(
       arangodb::ReplicationIterator::Ordering, uint64_t) override;
   void getPropertiesVPack(arangodb::velocypack::Builder&) const override;
@@ -138,6 +144,11 @@ class PhysicalCollectionMock : public arangodb::PhysicalCollection {
                           arangodb::OperationOptions const& options) override;
   arangodb::Result updateProperties(arangodb::velocypack::Slice slice) override;
 
+  /// @brief number of range iterators created so far
+  size_t numRangeIterators() const noexcept {
+    return _numRangeIterators.load(std::memory_order_relaxed);
+  }
+
  private:
   bool addIndex(std::shared_ptr<arangodb::Index> idx);
 
@@ -151,6 +162,7 @@ class PhysicalCollectionMock : public arangodb::PhysicalCollection {
                                   bool isUpdate);
 
   uint64_t _lastDocumentId;
+  mutable std::atomic<size_t> _numRangeIterators{0};
   // map _key => data. Keyslice references memory in the value
   std::unordered_map<std::string_view, DocElement> _documents;
 };
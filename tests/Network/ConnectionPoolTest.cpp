@@ -572,6 +572,61 @@ TEST_F(NetworkConnectionPoolTest, checking_expiration_multiple_endpints) {
   EXPECT_EQ(extractCurrentMetric(), 0ull);
 }
 
+TEST_F(NetworkConnectionPoolTest, checking_adaptive_idle_connections) {
+  ConnectionPool::Config config(server.getFeature<metrics::MetricsFeature>());
+  config.numIOThreads = 1;
+  config.maxOpenConnections = 8;
+  config.idleConnectionMilli = 10;  // extra small for testing
+  config.verifyHosts = false;
+  config.adaptiveIdleConnections = true;
+  config.protocol = fuerte::ProtocolType::Http;
+
+  ConnectionPool pool(config);
+
+  bool isFromPool;
+  {
+    // a burst which needs 4 connections at once
+    auto conn1 = pool.leaseConnection("tcp://example.org:80", isFromPool);
+    auto conn2 = pool.leaseConnection("tcp://example.org:80", isFromPool);
+    auto conn3 = pool.leaseConnection("tcp://example.org:80", isFromPool);
+    auto conn4 = pool.leaseConnection("tcp://example.org:80", isFromPool);
+    EXPECT_FALSE(isFromPool);
+  }
+  ASSERT_EQ(pool.numOpenConnections(), 4);
+
+  // 21ms > 2 * 10ms
+  std::this_thread::sleep_for(std::chrono::milliseconds(21));
+
+  // keeps all connections, although they are expired
+  pool.pruneConnections();
+  ASSERT_EQ(pool.numOpenConnections(), 4);
+  EXPECT_EQ(extractCurrentMetric(), 4ull);
+
+  // no burst since, so only half of them are kept
+  pool.pruneConnections();
+  ASSERT_EQ(pool.numOpenConnections(), 2);
+  EXPECT_EQ(extractCurrentMetric(), 2ull);
+
+  {
+    // kept connections are reused
+    auto conn1 = pool.leaseConnection("tcp://example.org:80", isFromPool);
+    EXPECT_TRUE(isFromPool);
+    ASSERT_EQ(pool.numOpenConnections(), 2);
+  }
+
+  // 21ms > 2 * 10ms
+  std::this_thread::sleep_for(std::chrono::milliseconds(21));
+
+  // one connection was needed since the last run
+  pool.pruneConnections();
+  ASSERT_EQ(pool.numOpenConnections(), 1);
+  EXPECT_EQ(extractCurrentMetric(), 1ull);
+
+  pool.pruneConnections();
+  ASSERT_EQ(pool.numOpenConnections(), 0);
+  EXPECT_EQ(extractCurrentMetric(), 0ull);
+}
+
 TEST_F(NetworkConnectionPoolTest, test_cancel_endpoint_all) {
   ConnectionPool::Config config(server.getFeature<metrics::MetricsFeature>());
   config.numIOThreads = 1;
@@ -0,0 +1,215 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+
+#include <fuerte/requests.h>
+#include <velocypack/Parser.h>
+#include <velocypack/Slice.h>
+
+#include "Mocks/LogLevels.h"
+#include "Mocks/Servers.h"
+
+#include "Network/DocumentReadCoalescer.h"
+#include "Network/NetworkFeature.h"
+#include "Scheduler/SchedulerFeature.h"
+
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+using namespace arangodb;
+
+namespace {
+
+/// @brief records the batches instead of sending them. the test answers
+/// them through the promises
+struct RecordingCoalescer final : public network::DocumentReadCoalescer {
+  struct Request {
+    std::string database;
+    std::string shard;
+    std::string keys;
+    futures::Promise<network::Response> promise;
+  };
+
+  using network::DocumentReadCoalescer::DocumentReadCoalescer;
+
+  futures::Future<network::Response> sendRequest(
+      std::string const& database, std::string const& shard,
+      velocypack::Buffer<uint8_t> keys) override {
+    std::lock_guard guard(mutex);
+    auto& request = requests.emplace_back();
+    request.database = database;
+    request.shard = shard;
+    request.keys = velocypack::Slice(keys.data()).toJson();
+    return request.promise.getFuture();
+  }
+
+  size_t numRequests() {
+    std::lock_guard guard(mutex);
+    return requests.size();
+  }
+
+  bool waitForRequests(size_t n) {
+    auto const end =
+        std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (numRequests() < n) {
+      if (std::chrono::steady_clock::now() > end) {
+        return false;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+  }
+
+  std::mutex mutex;
+  std::deque<Request> requests;
+};
+
+network::Response makeResponse(std::string const& json) {
+  fuerte::ResponseHeader header;
+  header.responseCode = fuerte::StatusOK;
+  header.contentType(fuerte::ContentType::VPack);
+  auto response = std::make_unique<fuerte::Response>(std::move(header));
+  response->setPayload(std::move(*VPackParser::fromJson(json)->steal()), 0);
+  return network::Response("shard:s1", fuerte::Error::NoError,
+                           std::unique_ptr<fuerte::Request>(),
+                           std::move(response));
+}
+
+}  // namespace
+
+struct DocumentReadCoalescerTest
+    : public ::testing::Test,
+      public arangodb::tests::LogSuppressor<arangodb::Logger::THREADS,
+                                            arangodb::LogLevel::FATAL> {
+  DocumentReadCoalescerTest() : server("CRDN_0001", false) {
+    server.addFeature<SchedulerFeature>(true);
+    server.startFeatures();
+  }
+
+  std::unique_ptr<RecordingCoalescer> makeCoalescer(
+      std::chrono::microseconds window) {
+    return std::make_unique<RecordingCoalescer>(
+        server.getFeature<NetworkFeature>(), window);
+  }
+
+  tests::mocks::MockCoordinator server;
+};
+
+TEST_F(DocumentReadCoalescerTest, coalesces_reads_per_shard) {
+  auto coalescer = makeCoalescer(std::chrono::milliseconds(100));
+  OperationOptions options;
+
+  auto a = coalescer->read("db", "s1", "a", options);
+  auto b = coalescer->read("db", "s1", "b", options);
+  auto other = coalescer->read("db", "s2", "x", options);
+  auto c = coalescer->read("db", "s1", "c", options);
+
+  ASSERT_TRUE(coalescer->waitForRequests(2));
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  ASSERT_EQ(2, coalescer->numRequests());
+
+  auto& requests = coalescer->requests;
+  auto& s1 = requests[0].shard == "s1" ? requests[0] : requests[1];
+  auto& s2 = requests[0].shard == "s1" ? requests[1] : requests[0];
+  EXPECT_EQ("db", s1.database);
+  EXPECT_EQ(R"(["a","b","c"])", s1.keys);
+  EXPECT_EQ("s2", s2.shard);
+  EXPECT_EQ(R"(["x"])", s2.keys);
+
+  // each read gets its own part of the response
+  s1.promise.setValue(makeResponse(
+      R"([{"_key":"a"},{"error":true,"errorNum":1202},{"_key":"c"}])"));
+  OperationResult resA = std::move(a).get();
+  ASSERT_TRUE(resA.ok());
+  EXPECT_EQ("a", resA.slice().get("_key").stringView());
+  OperationResult resB = std::move(b).get();
+  EXPECT_TRUE(resB.result.is(TRI_ERROR_ARANGO_DOCUMENT_NOT_FOUND));
+  OperationResult resC = std::move(c).get();
+  ASSERT_TRUE(resC.ok());
+  EXPECT_EQ("c", resC.slice().get("_key").stringView());
+
+  EXPECT_FALSE(other.isReady());
+  s2.promise.setValue(makeResponse(R"([{"_key":"x"}])"));
+  EXPECT_TRUE(std::move(other).get().ok());
+}
+
+TEST_F(DocumentReadCoalescerTest, full_batch_is_sent_right_away) {
+  auto coalescer = makeCoalescer(std::chrono::hours(1));
+  OperationOptions options;
+
+  std::vector<futures::Future<OperationResult>> reads;
+  std::string response = "[";
+  for (size_t i = 0; i < network::DocumentReadCoalescer::maxBatchSize; ++i) {
+    reads.emplace_back(
+        coalescer->read("db", "s1", std::to_string(i), options));
+    if (i > 0) {
+      response += ",";
+    }
+    response += R"({"_key":")" + std::to_string(i) + R"("})";
+  }
+  response += "]";
+
+  // no need to wait for the window
+  ASSERT_EQ(1, coalescer->numRequests());
+  coalescer->requests[0].promise.setValue(makeResponse(response));
+  for (size_t i = 0; i < reads.size(); ++i) {
+    OperationResult res = std::move(reads[i]).get();
+    ASSERT_TRUE(res.ok());
+    EXPECT_EQ(std::to_string(i), res.slice().get("_key").stringView());
+  }
+}
+
+TEST_F(DocumentReadCoalescerTest, request_error_fails_all_reads) {
+  auto coalescer = makeCoalescer(std::chrono::milliseconds(1));
+  OperationOptions options;
+
+  auto a = coalescer->read("db", "s1", "a", options);
+  auto b = coalescer->read("db", "s1", "b", options);
+  ASSERT_TRUE(coalescer->waitForRequests(1));
+
+  coalescer->requests[0].promise.setValue(network::Response(
+      "shard:s1", fuerte::Error::ConnectionClosed,
+      std::unique_ptr<fuerte::Request>(), std::unique_ptr<fuerte::Response>()));
+  EXPECT_TRUE(std::move(a).get().fail());
+  EXPECT_TRUE(std::move(b).get().fail());
+}
+
+TEST_F(DocumentReadCoalescerTest, shutdown_fails_pending_reads) {
+  auto coalescer = makeCoalescer(std::chrono::hours(1));
+  OperationOptions options;
+
+  auto a = coalescer->read("db", "s1", "a", options);
+  auto b = coalescer->read("db", "s2", "b", options);
+  EXPECT_FALSE(a.isReady());
+
+  coalescer->shutdown();
+  EXPECT_TRUE(std::move(a).get().result.is(TRI_ERROR_SHUTTING_DOWN));
+  EXPECT_TRUE(std::move(b).get().result.is(TRI_ERROR_SHUTTING_DOWN));
+
+  // later reads fail right away
+  auto c = coalescer->read("db", "s1", "c", options);
+  ASSERT_TRUE(c.isReady());
+  EXPECT_TRUE(std::move(c).get().result.is(TRI_ERROR_SHUTTING_DOWN));
+  EXPECT_EQ(0, coalescer->numRequests());
+}
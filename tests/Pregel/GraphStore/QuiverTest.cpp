@@ -81,4 +81,19 @@ TEST(PregelQuiver, storing_some_vertices) {
   ASSERT_EQ(store.numberOfVertices(), 155);
 }
 
+TEST(PregelQuiver, memory_usage_counts_keys_and_edges) {
+  using MyQuiver = Quiver<std::string, std::string>;
+  auto store = MyQuiver{};
+  ASSERT_EQ(store.memoryUsage(), 0);
+
+  auto v = MyQuiver::VertexType();
+  auto key = std::string(100, 'x');
+  v.setKey(key.data(), key.size());
+  v.addEdge(MyQuiver::EdgeType({PregelShard(5), std::string(100, 'y')}, ""));
+  store.emplace(std::move(v));
+
+  ASSERT_GE(store.memoryUsage(), sizeof(MyQuiver::VertexType) +
+                                     sizeof(MyQuiver::EdgeType) + 2 * 100);
+}
+
 // TODO: A test that creates a number of vertices with edges
@@ -127,6 +127,8 @@ struct AsyncLogWriteBatcherMetricsMock : AsyncLogWriteBatcherMetrics {
     rocksdbWriteTimeInUs =
         makeMetric<arangodb_replication2_rocksdb_write_time>();
     rocksdbSyncTimeInUs = makeMetric<arangodb_replication2_rocksdb_sync_time>();
+    syncGroupSize =
+        makeMetric<arangodb_replication2_rocksdb_sync_group_size>();
     operationLatencyInsert =
         makeMetric<arangodb_replication2_storage_operation_latency>();
     operationLatencyRemoveFront =
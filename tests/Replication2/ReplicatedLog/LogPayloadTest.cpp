@@ -0,0 +1,116 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+#include <gtest/gtest.h>
+
+#include "Basics/StaticStrings.h"
+#include "Replication2/ReplicatedLog/LogEntry.h"
+#include "Replication2/ReplicatedLog/LogEntryView.h"
+#include "Replication2/ReplicatedLog/LogPayload.h"
+
+#include <velocypack/Builder.h>
+
+#include <string>
+
+using namespace arangodb;
+using namespace arangodb::replication2;
+
+TEST(LogPayloadTest, compression_disabled) {
+  auto payload = LogPayload::createFromString(std::string(1000, 'a'));
+  auto size = payload.byteSize();
+  auto result = LogPayload::compress(std::move(payload), 0);
+  EXPECT_EQ(result.byteSize(), size);
+  EXPECT_FALSE(LogPayload::isCompressed(result.slice()));
+  EXPECT_TRUE(result.slice().isString());
+}
+
+TEST(LogPayloadTest, small_payload_is_not_compressed) {
+  auto payload = LogPayload::createFromString(std::string(100, 'a'));
+  auto result = LogPayload::compress(std::move(payload), 1000);
+  EXPECT_FALSE(LogPayload::isCompressed(result.slice()));
+
+  LogPayload::BufferType buffer;
+  auto slice = LogPayload::uncompress(result.slice(), buffer);
+  EXPECT_EQ(slice.start(), result.slice().start());
+}
+
+TEST(LogPayloadTest, compress_and_uncompress) {
+  auto value = std::string(10000, 'a');
+  auto payload = LogPayload::createFromString(value);
+  auto size = payload.byteSize();
+  auto result = LogPayload::compress(std::move(payload), 1000);
+  ASSERT_TRUE(LogPayload::isCompressed(result.slice()));
+  EXPECT_LT(result.byteSize(), size);
+
+  LogPayload::BufferType buffer;
+  auto slice = LogPayload::uncompress(result.slice(), buffer);
+  ASSERT_TRUE(slice.isString());
+  EXPECT_EQ(slice.stringView(), value);
+  EXPECT_EQ(slice.byteSize(), size);
+}
+
+TEST(LogPayloadTest, log_entry_serialization_uncompresses_payload) {
+  auto value = std::string(10000, 'a');
+  auto payload =
+      LogPayload::compress(LogPayload::createFromString(value), 1000);
+  ASSERT_TRUE(LogPayload::isCompressed(payload.slice()));
+  auto entry = LogEntry(LogTerm{1}, LogIndex{12}, std::move(payload));
+
+  // as returned by the poll, head, tail and slice REST APIs
+  {
+    velocypack::Builder builder;
+    entry.toVelocyPack(builder);
+    auto slice = builder.slice().get(StaticStrings::Payload);
+    ASSERT_TRUE(slice.isString());
+    EXPECT_EQ(slice.stringView(), value);
+    EXPECT_EQ(builder.slice().get(StaticStrings::LogIndex).getNumber<int>(),
+              12);
+  }
+
+  // as sent to followers, which must get the same entry as the leader
+  {
+    velocypack::Builder builder;
+    entry.toVelocyPack(builder, LogEntry::keepCompressed);
+    EXPECT_TRUE(LogPayload::isCompressed(
+        builder.slice().get(StaticStrings::Payload)));
+    auto copy = LogEntry::fromVelocyPack(builder.slice());
+    EXPECT_EQ(copy, entry);
+  }
+
+  // as persisted
+  {
+    velocypack::Builder builder;
+    entry.toVelocyPack(builder, LogEntry::omitLogIndex);
+    EXPECT_TRUE(LogPayload::isCompressed(
+        builder.slice().get(StaticStrings::Payload)));
+    auto copy = LogEntry(LogIndex{12}, builder.slice());
+    EXPECT_EQ(copy, entry);
+  }
+
+  // views of log entries, as handed out to replicated states
+  {
+    auto view = LogEntryView(entry.logIndex(), *entry.logPayload());
+    velocypack::Builder builder;
+    view.toVelocyPack(builder);
+    auto slice = builder.slice().get(StaticStrings::Payload);
+    ASSERT_TRUE(slice.isString());
+    EXPECT_EQ(slice.stringView(), value);
+  }
+}
@@ -0,0 +1,213 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+
+#include "Mocks/Servers.h"
+
+#include "Basics/FileUtils.h"
+#include "Basics/StringBuffer.h"
+#include "Basics/files.h"
+#include "Basics/system-functions.h"
+#include "Endpoint/ConnectionInfo.h"
+#include "GeneralServer/AsyncJobManager.h"
+#include "GeneralServer/RestHandler.h"
+#include "Random/RandomGenerator.h"
+#include "Rest/GeneralResponse.h"
+#include "Rest/HttpRequest.h"
+#include "Rest/HttpResponse.h"
+#include "RestServer/TemporaryStorageFeature.h"
+
+#include <memory>
+#include <string>
+
+using namespace arangodb;
+using namespace arangodb::rest;
+
+namespace {
+
+// a handler that has already produced its response
+class ResultHandler final : public RestHandler {
+ public:
+  ResultHandler(ArangodServer& server, std::string const& body)
+      : RestHandler(server, new HttpRequest(ConnectionInfo{}, 1),
+                    new HttpResponse(ResponseCode::OK, 1)) {
+    response()->addRawPayload(body);
+  }
+
+  char const* name() const override { return "ResultHandler"; }
+  RequestLane lane() const override { return RequestLane::CLIENT_FAST; }
+  RestStatus execute() override { return RestStatus::DONE; }
+  void handleError(basics::Exception const&) override {}
+};
+
+// spills into a plain directory, without starting the RocksDB backend
+class TemporaryStorageMock final : public TemporaryStorageFeature {
+ public:
+  TemporaryStorageMock(ArangodServer& server, std::string path)
+      : TemporaryStorageFeature(server), tracker(0), path(std::move(path)) {}
+
+  StorageUsageTracker* usageTracker() const noexcept override {
+    return &tracker;
+  }
+  std::string const& asyncJobResultsPath() const noexcept override {
+    return path;
+  }
+
+  mutable StorageUsageTracker tracker;
+  std::string const path;
+};
+
+}  // namespace
+
+class AsyncJobManagerTest : public ::testing::Test {
+ protected:
+  tests::mocks::MockRestServer server;
+  std::string directory;
+  TemporaryStorageMock temporaryStorage;
+
+  AsyncJobManagerTest()
+      : directory(basics::FileUtils::buildFilename(
+            TRI_GetTempPath(),
+            "arangotest-asyncjobs-" +
+                std::to_string(static_cast<uint64_t>(TRI_microtime())) +
+                std::to_string(RandomGenerator::interval(UINT32_MAX)))),
+        temporaryStorage(server.server(), directory) {
+    long systemError;
+    std::string errorMessage;
+    EXPECT_EQ(TRI_ERROR_NO_ERROR, TRI_CreateDirectory(directory.c_str(),
+                                                      systemError,
+                                                      errorMessage));
+  }
+
+  ~AsyncJobManagerTest() {
+    TRI_ASSERT(directory.length() > 10);
+    TRI_RemoveDirectory(directory.c_str());
+  }
+
+  // runs a job with a response of the given body, and returns its id
+  AsyncJobResult::IdType runJob(AsyncJobManager& manager,
+                                std::string const& body) {
+    auto handler = std::make_shared<ResultHandler>(server.server(), body);
+    manager.initAsyncJob(handler);
+    manager.finishAsyncJob(handler.get());
+    return handler->handlerId();
+  }
+
+  static std::unique_ptr<HttpResponse> fetch(AsyncJobManager& manager,
+                                             AsyncJobResult::IdType jobId) {
+    AsyncJobResult::Status status;
+    std::unique_ptr<GeneralResponse> response(
+        manager.getJobResult(jobId, status, true));
+    EXPECT_EQ(AsyncJobResult::JOB_DONE, status);
+    EXPECT_NE(nullptr, response);
+    return std::unique_ptr<HttpResponse>(
+        static_cast<HttpResponse*>(response.release()));
+  }
+
+  size_t numSpillFiles() const {
+    return TRI_FilesDirectory(directory.c_str()).size();
+  }
+
+  static std::string body(HttpResponse& response) {
+    return std::string(response.body().data(), response.body().length());
+  }
+};
+
+TEST_F(AsyncJobManagerTest, small_results_are_kept_in_memory) {
+  AsyncJobManager manager(1000, 500, &temporaryStorage);
+  std::string const result(100, 'a');
+  auto jobId = runJob(manager, result);
+  EXPECT_EQ(100U, manager.memoryUsage());
+  EXPECT_EQ(0U, numSpillFiles());
+
+  auto response = fetch(manager, jobId);
+  EXPECT_EQ(result, body(*response));
+  EXPECT_EQ(0U, manager.memoryUsage());
+}
+
+TEST_F(AsyncJobManagerTest, large_result_is_spilled_and_restored) {
+  AsyncJobManager manager(0, 500, &temporaryStorage);
+  std::string const result(1000, 'b');
+  auto jobId = runJob(manager, result);
+  EXPECT_EQ(0U, manager.memoryUsage());
+  EXPECT_EQ(1U, numSpillFiles());
+  EXPECT_LT(0U, temporaryStorage.tracker.currentUsage());
+
+  auto response = fetch(manager, jobId);
+  EXPECT_EQ(ResponseCode::OK, response->responseCode());
+  EXPECT_EQ(result, body(*response));
+  EXPECT_EQ(0U, numSpillFiles());
+  EXPECT_EQ(0U, temporaryStorage.tracker.currentUsage());
+}
+
+TEST_F(AsyncJobManagerTest, result_over_memory_limit_is_spilled) {
+  AsyncJobManager manager(1000, 0, &temporaryStorage);
+  std::string const first(600, 'c');
+  std::string const second(600, 'd');
+  auto firstId = runJob(manager, first);
+  auto secondId = runJob(manager, second);
+  EXPECT_EQ(600U, manager.memoryUsage());
+  EXPECT_EQ(1U, numSpillFiles());
+
+  EXPECT_EQ(second, body(*fetch(manager, secondId)));
+  EXPECT_EQ(first, body(*fetch(manager, firstId)));
+  EXPECT_EQ(0U, manager.memoryUsage());
+  EXPECT_EQ(0U, numSpillFiles());
+}
+
+TEST_F(AsyncJobManagerTest, result_over_memory_limit_is_an_error_without_disk) {
+  AsyncJobManager manager(1000, 0, nullptr);
+  std::string const first(600, 'e');
+  auto firstId = runJob(manager, first);
+  auto secondId = runJob(manager, std::string(600, 'f'));
+  EXPECT_EQ(600U, manager.memoryUsage());
+
+  auto response = fetch(manager, secondId);
+  EXPECT_EQ(GeneralResponse::responseCode(TRI_ERROR_RESOURCE_LIMIT),
+            response->responseCode());
+  EXPECT_NE(std::string::npos,
+            body(*response).find(
+                "\"errorNum\":" +
+                std::to_string(static_cast<int>(TRI_ERROR_RESOURCE_LIMIT))));
+  EXPECT_EQ(first, body(*fetch(manager, firstId)));
+}
+
+TEST_F(AsyncJobManagerTest, deleted_job_removes_its_spill_file) {
+  AsyncJobManager manager(0, 500, &temporaryStorage);
+  auto jobId = runJob(manager, std::string(1000, 'g'));
+  EXPECT_EQ(1U, numSpillFiles());
+
+  EXPECT_TRUE(manager.deleteJobResult(jobId));
+  EXPECT_EQ(0U, numSpillFiles());
+  EXPECT_EQ(0U, temporaryStorage.tracker.currentUsage());
+}
+
+TEST_F(AsyncJobManagerTest, cleared_jobs_remove_their_spill_files) {
+  AsyncJobManager manager(0, 500, &temporaryStorage);
+  runJob(manager, std::string(1000, 'h'));
+  runJob(manager, std::string(1000, 'i'));
+  EXPECT_EQ(2U, numSpillFiles());
+
+  EXPECT_TRUE(manager.clearAllJobs().ok());
+  EXPECT_EQ(0U, numSpillFiles());
+  EXPECT_EQ(0U, temporaryStorage.tracker.currentUsage());
+}
@@ -132,3 +132,57 @@ TEST(HttpRequestTest, testWrongUrlEncoding) {
   EXPECT_THROW(request.parseUrl(url.data(), url.size()),
                arangodb::basics::Exception);
 }
+
+TEST(HttpRequestTest, testAcceptEncoding) {
+  auto acceptEncoding = [](std::string value) {
+    ConnectionInfo ci;
+    HttpRequest request(ci, 1);
+    request.setHeader("Accept-Encoding", std::move(value));
+    return request.acceptEncoding();
+  };
+
+  EXPECT_EQ(rest::EncodingType::UNSET, acceptEncoding(""));
+  EXPECT_EQ(rest::EncodingType::UNSET, acceptEncoding("br"));
+  EXPECT_EQ(rest::EncodingType::UNSET, acceptEncoding("identity"));
+  EXPECT_EQ(rest::EncodingType::GZIP, acceptEncoding("gzip"));
+  EXPECT_EQ(rest::EncodingType::DEFLATE, acceptEncoding("deflate"));
+  EXPECT_EQ(rest::EncodingType::GZIP, acceptEncoding("GZip"));
+  EXPECT_EQ(rest::EncodingType::GZIP, acceptEncoding("gzip, deflate"));
+  EXPECT_EQ(rest::EncodingType::GZIP, acceptEncoding("deflate,gzip"));
+  EXPECT_EQ(rest::EncodingType::GZIP, acceptEncoding("br, gzip;q=0.8"));
+  EXPECT_EQ(rest::EncodingType::DEFLATE,
+            acceptEncoding("gzip;q=0.5, deflate;q=0.9"));
+  EXPECT_EQ(rest::EncodingType::DEFLATE, acceptEncoding("gzip;q=0, deflate"));
+  EXPECT_EQ(rest::EncodingType::UNSET, acceptEncoding("gzip; q=0.000"));
+  EXPECT_EQ(rest::EncodingType::GZIP, acceptEncoding("gzip;q=1.0"));
+}
+
+TEST(HttpRequestTest, testAcceptEncodingCommonValues) {
+  auto acceptEncoding = [](std::string value) {
+    ConnectionInfo ci;
+    HttpRequest request(ci, 1);
+    request.setHeader("Accept-Encoding", std::move(value));
+    return request.acceptEncoding();
+  };
+
+  // values sent by browsers, curl and common HTTP client libraries
+  EXPECT_EQ(rest::EncodingType::GZIP, acceptEncoding("gzip, deflate"));
+  EXPECT_EQ(rest::EncodingType::GZIP, acceptEncoding("gzip, deflate, br"));
+  EXPECT_EQ(rest::EncodingType::GZIP,
+            acceptEncoding("gzip, deflate, br, zstd"));
+  EXPECT_EQ(rest::EncodingType::GZIP, acceptEncoding("deflate, gzip"));
+  EXPECT_EQ(rest::EncodingType::GZIP, acceptEncoding("gzip,deflate"));
+  EXPECT_EQ(rest::EncodingType::GZIP, acceptEncoding("  gzip  "));
+  EXPECT_EQ(rest::EncodingType::GZIP,
+            acceptEncoding("gzip;q=1.0, identity; q=0.5, *;q=0"));
+  EXPECT_EQ(rest::EncodingType::DEFLATE, acceptEncoding("deflate, br"));
+  EXPECT_EQ(rest::EncodingType::DEFLATE,
+            acceptEncoding("deflate;q=1, gzip;q=0.8"));
+  // wildcards and unsupported encodings do not enable compression
+  EXPECT_EQ(rest::EncodingType::UNSET, acceptEncoding("*"));
+  EXPECT_EQ(rest::EncodingType::UNSET, acceptEncoding("br, zstd"));
+  EXPECT_EQ(rest::EncodingType::UNSET, acceptEncoding("identity, *;q=0"));
+  EXPECT_EQ(rest::EncodingType::UNSET, acceptEncoding(" , ,"));
+  EXPECT_EQ(rest::EncodingType::UNSET,
+            acceptEncoding("gzip;q=0, deflate;q=0"));
+}
@@ -0,0 +1,86 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+
+#include "GeneralServer/HttpWriteQueue.h"
+
+#include <memory>
+
+using namespace arangodb::rest;
+
+namespace {
+// move-only, like the request statistics item of a response
+using Response = std::unique_ptr<int>;
+using Queue = HttpWriteQueue<Response>;
+}  // namespace
+
+TEST(HttpWriteQueueTest, writes_right_away_when_idle) {
+  Queue queue;
+  auto response = queue.addResponse(false, std::make_unique<int>(1));
+  ASSERT_TRUE(response.has_value());
+  EXPECT_EQ(1, **response);
+  EXPECT_TRUE(queue.addContinue(false));
+  EXPECT_EQ(Queue::Write::NOTHING, queue.next());
+}
+
+TEST(HttpWriteQueueTest, response_waits_for_current_write) {
+  Queue queue;
+  EXPECT_FALSE(queue.addResponse(true, std::make_unique<int>(2)).has_value());
+  ASSERT_EQ(Queue::Write::RESPONSE, queue.next());
+  EXPECT_EQ(2, *queue.popResponse());
+  EXPECT_EQ(Queue::Write::NOTHING, queue.next());
+}
+
+TEST(HttpWriteQueueTest, continue_waits_for_current_write) {
+  Queue queue;
+  EXPECT_FALSE(queue.addContinue(true));
+  ASSERT_EQ(Queue::Write::CONTINUE, queue.next());
+  queue.popContinue();
+  EXPECT_EQ(Queue::Write::NOTHING, queue.next());
+}
+
+TEST(HttpWriteQueueTest, continue_is_written_before_its_response) {
+  // the pipelined request asked for a "100 Continue" and was answered
+  // while the previous response was still being written
+  Queue queue;
+  EXPECT_FALSE(queue.addContinue(true));
+  EXPECT_FALSE(queue.addResponse(true, std::make_unique<int>(2)).has_value());
+
+  ASSERT_EQ(Queue::Write::CONTINUE, queue.next());
+  queue.popContinue();
+  ASSERT_EQ(Queue::Write::RESPONSE, queue.next());
+  EXPECT_EQ(2, *queue.popResponse());
+  EXPECT_EQ(Queue::Write::NOTHING, queue.next());
+}
+
+TEST(HttpWriteQueueTest, response_after_written_continue_is_not_queued) {
+  // the "100 Continue" was written before the request was answered
+  Queue queue;
+  EXPECT_FALSE(queue.addContinue(true));
+  ASSERT_EQ(Queue::Write::CONTINUE, queue.next());
+  queue.popContinue();
+
+  auto response = queue.addResponse(false, std::make_unique<int>(3));
+  ASSERT_TRUE(response.has_value());
+  EXPECT_EQ(3, **response);
+  EXPECT_EQ(Queue::Write::NOTHING, queue.next());
+}
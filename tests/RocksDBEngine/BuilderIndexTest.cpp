@@ -0,0 +1,107 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+
+#include "RocksDBEngine/RocksDBBuilderIndex.h"
+#include "RocksDBEngine/RocksDBFormat.h"
+#include "RocksDBEngine/RocksDBKey.h"
+#include "VocBase/Identifiers/LocalDocumentId.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+using namespace arangodb;
+
+class RocksDBBuilderIndexTest
+    : public ::testing::TestWithParam<RocksDBEndianness> {
+ protected:
+  RocksDBBuilderIndexTest() {
+    rocksutils::setRocksDBKeyFormatEndianess(GetParam());
+  }
+
+  static std::string documentKey(uint64_t objectId, uint64_t documentId) {
+    RocksDBKey key;
+    key.constructDocument(objectId, LocalDocumentId(documentId));
+    return key.string();
+  }
+
+  // the document keys of a collection, in the order rocksdb stores them
+  static std::vector<std::string> documentKeys(uint64_t objectId,
+                                               uint64_t numDocuments) {
+    std::vector<std::string> keys;
+    for (uint64_t id = 1; id <= numDocuments; ++id) {
+      keys.emplace_back(documentKey(objectId, id));
+    }
+    std::sort(keys.begin(), keys.end());
+    return keys;
+  }
+};
+
+INSTANTIATE_TEST_CASE_P(RocksDBBuilderIndexTest, RocksDBBuilderIndexTest,
+                        ::testing::Values(RocksDBEndianness::Little,
+                                          RocksDBEndianness::Big));
+
+TEST_P(RocksDBBuilderIndexTest, split_covers_all_documents_evenly) {
+  constexpr size_t numRanges = 8;
+  auto keys = documentKeys(42, 10000);
+  auto boundaries =
+      splitDocumentKeyRange(keys.front(), keys.back(), numRanges);
+  ASSERT_EQ(numRanges - 1, boundaries.size());
+  EXPECT_TRUE(std::is_sorted(boundaries.begin(), boundaries.end()));
+  EXPECT_GT(boundaries.front(), keys.front());
+  EXPECT_LE(boundaries.back(), keys.back());
+
+  // count the documents in every range
+  std::vector<size_t> counts(numRanges, 0);
+  for (auto const& key : keys) {
+    // the boundaries belong to the ranges they start
+    size_t range = std::upper_bound(boundaries.begin(), boundaries.end(),
+                                    key) -
+                   boundaries.begin();
+    ++counts[range];
+  }
+  size_t const expected = keys.size() / numRanges;
+  for (size_t count : counts) {
+    EXPECT_GT(count, expected / 2);
+    EXPECT_LT(count, expected * 2);
+  }
+}
+
+TEST_P(RocksDBBuilderIndexTest, boundaries_keep_the_collection_prefix) {
+  auto boundaries = splitDocumentKeyRange(documentKey(12345, 1),
+                                          documentKey(12345, 100000), 4);
+  ASSERT_EQ(3U, boundaries.size());
+  std::string const prefix = documentKey(12345, 0).substr(0, sizeof(uint64_t));
+  for (auto const& key : boundaries) {
+    EXPECT_EQ(2 * sizeof(uint64_t), key.size());
+    EXPECT_EQ(prefix, key.substr(0, sizeof(uint64_t)));
+  }
+}
+
+TEST_P(RocksDBBuilderIndexTest, too_few_documents_are_not_split) {
+  auto key = documentKey(42, 17);
+  EXPECT_TRUE(splitDocumentKeyRange(key, key, 8).empty());
+
+  auto keys = documentKeys(42, 1);
+  EXPECT_TRUE(splitDocumentKeyRange(keys.front(), keys.back(), 8).empty());
+}
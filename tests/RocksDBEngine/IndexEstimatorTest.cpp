@@ -462,6 +462,46 @@ TEST_F(IndexEstimatorTest, test_truncate_logic_2) {
   ASSERT_EQ(1.0, est.computeEstimate());
 }
 
+TEST_F(IndexEstimatorTest, test_apply_many_buffers_at_once) {
+  RocksDBCuckooIndexEstimatorType est(nullptr, 2048);
+  auto format = RocksDBCuckooIndexEstimatorType::SerializeFormat::UNCOMPRESSED;
+
+  // seq 1-10: insert 1..10 ten times. seq 11-15: remove 1..10 five times.
+  // seq 16-20: insert 1..10 five more times
+  rocksdb::SequenceNumber currentSeq(0);
+  auto buffer = [&](bool insert) {
+    uint64_t index = 0;
+    std::vector<uint64_t> keys(10);
+    std::generate(keys.begin(), keys.end(), [&index] { return ++index; });
+    if (insert) {
+      est.bufferUpdates(++currentSeq, std::move(keys), {});
+    } else {
+      est.bufferUpdates(++currentSeq, {}, std::move(keys));
+    }
+  };
+  for (size_t i = 0; i < 10; ++i) {
+    buffer(true);
+  }
+  for (size_t i = 0; i < 5; ++i) {
+    buffer(false);
+  }
+  for (size_t i = 0; i < 5; ++i) {
+    buffer(true);
+  }
+
+  // apply only the buffers up to seq 15
+  std::string serialization;
+  est.serialize(serialization, 15, format);
+  ASSERT_EQ(15, est.appliedSeq());
+  ASSERT_EQ(10.0 / 50.0, est.computeEstimate());
+
+  // apply the rest
+  serialization.clear();
+  est.serialize(serialization, currentSeq, format);
+  ASSERT_EQ(currentSeq, est.appliedSeq());
+  ASSERT_EQ(10.0 / 100.0, est.computeEstimate());
+}
+
 TEST_F(IndexEstimatorTest, test_serialize_compression) {
   std::vector<uint64_t> toInsert(10000);
   constexpr uint64_t seq = 42;
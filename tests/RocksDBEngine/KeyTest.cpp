@@ -635,6 +635,40 @@ TEST_F(RocksDBKeyBoundsTestLittleEndian, test_hash_index) {
   EXPECT_LT(cmp->Compare(key4.string(), key7.string()), 0);
 }
 
+/// @brief test comparison of identical and equal, but not identical values
+TEST_F(RocksDBKeyBoundsTestLittleEndian, test_vpack_comparator_equal_values) {
+  VPackBuilder smallInt;
+  smallInt(VPackValue(VPackValueType::Array))(VPackValue("a"))(VPackValue(1))();
+  VPackBuilder dbl;
+  dbl(VPackValue(VPackValueType::Array))(VPackValue("a"))(VPackValue(1.0))();
+  VPackBuilder higher;
+  higher(VPackValue(VPackValueType::Array))(VPackValue("a"))(VPackValue(2))();
+
+  RocksDBKey key1, key2, key3, key4;
+  key1.constructVPackIndexValue(1, smallInt.slice(), LocalDocumentId(33));
+  key2.constructVPackIndexValue(1, smallInt.slice(), LocalDocumentId(34));
+  key3.constructVPackIndexValue(1, dbl.slice(), LocalDocumentId(33));
+  key4.constructVPackIndexValue(1, higher.slice(), LocalDocumentId(1));
+
+  auto cmp = std::make_unique<RocksDBVPackComparator>();
+  EXPECT_EQ(cmp->Compare(key1.string(), key1.string()), 0);
+  EXPECT_TRUE(cmp->Equal(key1.string(), key1.string()));
+
+  // identical index values, different LocalDocumentIds
+  EXPECT_LT(cmp->Compare(key1.string(), key2.string()), 0);
+  EXPECT_GT(cmp->Compare(key2.string(), key1.string()), 0);
+  EXPECT_FALSE(cmp->Equal(key1.string(), key2.string()));
+
+  // equal index values with different VelocyPack types
+  EXPECT_EQ(cmp->Compare(key1.string(), key3.string()), 0);
+  EXPECT_TRUE(cmp->Equal(key1.string(), key3.string()));
+  EXPECT_LT(cmp->Compare(key3.string(), key2.string()), 0);
+
+  // identical first value, different second value
+  EXPECT_LT(cmp->Compare(key2.string(), key4.string()), 0);
+  EXPECT_LT(cmp->Compare(key3.string(), key4.string()), 0);
+}
+
 /// @brief test RocksDBKeyBounds class
 class RocksDBKeyBoundsTestBigEndian : public ::testing::Test {
  protected:
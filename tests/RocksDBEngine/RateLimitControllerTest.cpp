@@ -0,0 +1,97 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include "gtest/gtest.h"
+
+#include "RocksDBEngine/RocksDBRateLimitController.h"
+
+using namespace arangodb;
+
+namespace {
+constexpr std::uint64_t maxRate = 160 * 1024 * 1024;
+constexpr std::uint64_t targetLatency = 1000;
+constexpr std::uint64_t pendingLimit = 64ULL * 1024 * 1024 * 1024;
+}  // namespace
+
+TEST(RocksDBRateLimitControllerTest, starts_at_max_rate) {
+  RocksDBRateLimitController controller(maxRate, targetLatency, pendingLimit);
+  EXPECT_EQ(maxRate, controller.rate());
+  EXPECT_EQ(maxRate / RocksDBRateLimitController::kMinRateDivisor,
+            controller.minRate());
+}
+
+TEST(RocksDBRateLimitControllerTest, lowers_rate_on_high_latency) {
+  RocksDBRateLimitController controller(maxRate, targetLatency, pendingLimit);
+  EXPECT_EQ(RocksDBRateLimitController::Decision::kDecrease,
+            controller.adjust(2000.0, 0));
+  EXPECT_LT(controller.rate(), maxRate);
+
+  for (int i = 0; i < 100; ++i) {
+    controller.adjust(2000.0, 0);
+  }
+  EXPECT_EQ(controller.minRate(), controller.rate());
+  EXPECT_EQ(RocksDBRateLimitController::Decision::kKeep,
+            controller.adjust(2000.0, 0));
+}
+
+TEST(RocksDBRateLimitControllerTest, keeps_rate_near_target_latency) {
+  RocksDBRateLimitController controller(maxRate, targetLatency, pendingLimit);
+  controller.adjust(2000.0, 0);
+  auto rate = controller.rate();
+  EXPECT_EQ(RocksDBRateLimitController::Decision::kKeep,
+            controller.adjust(800.0, 0));
+  EXPECT_EQ(rate, controller.rate());
+}
+
+TEST(RocksDBRateLimitControllerTest, raises_rate_on_low_latency) {
+  RocksDBRateLimitController controller(maxRate, targetLatency, pendingLimit);
+  controller.adjust(2000.0, 0);
+  controller.adjust(2000.0, 0);
+  auto rate = controller.rate();
+  EXPECT_EQ(RocksDBRateLimitController::Decision::kIncrease,
+            controller.adjust(100.0, 0));
+  EXPECT_GT(controller.rate(), rate);
+
+  for (int i = 0; i < 100; ++i) {
+    controller.adjust(0.0, 0);
+  }
+  EXPECT_EQ(maxRate, controller.rate());
+  EXPECT_EQ(RocksDBRateLimitController::Decision::kKeep,
+            controller.adjust(0.0, 0));
+}
+
+TEST(RocksDBRateLimitControllerTest, compaction_debt_overrides_latency) {
+  RocksDBRateLimitController controller(maxRate, targetLatency, pendingLimit);
+  for (int i = 0; i < 10; ++i) {
+    controller.adjust(2000.0, 0);
+  }
+  EXPECT_LT(controller.rate(), maxRate);
+  EXPECT_EQ(RocksDBRateLimitController::Decision::kIncrease,
+            controller.adjust(2000.0, pendingLimit / 2));
+  EXPECT_EQ(maxRate, controller.rate());
+}
+
+TEST(RocksDBRateLimitControllerTest, no_pending_compaction_limit) {
+  RocksDBRateLimitController controller(maxRate, targetLatency, 0);
+  EXPECT_EQ(RocksDBRateLimitController::Decision::kDecrease,
+            controller.adjust(2000.0, pendingLimit));
+}
@@ -0,0 +1,72 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+
+#include "RocksDBEngine/RocksDBMetaCollection.h"
+
+#include <chrono>
+
+using namespace arangodb;
+
+namespace {
+using Clock = std::chrono::steady_clock;
+using namespace std::chrono_literals;
+
+// a time point that is far enough from the clock's epoch
+Clock::time_point const now = Clock::time_point{} + 24h;
+// no hibernation attempt yet
+Clock::time_point const never{};
+std::uint64_t const treeMemoryUsage = 1024 * 1024;
+}  // namespace
+
+TEST(RevisionTreeHibernationTest, idle_tree_is_hibernated_over_the_limit) {
+  EXPECT_TRUE(revisionTreeHibernationOverdue(true, treeMemoryUsage, now - 10s,
+                                             never, now));
+  EXPECT_TRUE(revisionTreeHibernationOverdue(true, treeMemoryUsage, now - 1h,
+                                             never, now));
+}
+
+TEST(RevisionTreeHibernationTest, nothing_is_hibernated_below_the_limit) {
+  EXPECT_FALSE(revisionTreeHibernationOverdue(false, treeMemoryUsage,
+                                              now - 1h, never, now));
+}
+
+TEST(RevisionTreeHibernationTest, recently_used_tree_is_kept) {
+  EXPECT_FALSE(revisionTreeHibernationOverdue(true, treeMemoryUsage, now,
+                                              never, now));
+  EXPECT_FALSE(revisionTreeHibernationOverdue(true, treeMemoryUsage,
+                                              now - 9s, never, now));
+}
+
+TEST(RevisionTreeHibernationTest, tiny_tree_is_kept) {
+  EXPECT_FALSE(
+      revisionTreeHibernationOverdue(true, 256, now - 1h, never, now));
+  EXPECT_TRUE(
+      revisionTreeHibernationOverdue(true, 257, now - 1h, never, now));
+}
+
+TEST(RevisionTreeHibernationTest, hibernation_is_tried_once_per_minute) {
+  EXPECT_FALSE(revisionTreeHibernationOverdue(true, treeMemoryUsage,
+                                              now - 1h, now - 59s, now));
+  EXPECT_TRUE(revisionTreeHibernationOverdue(true, treeMemoryUsage, now - 1h,
+                                             now - 1min, now));
+}
@@ -0,0 +1,164 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+
+#include "Mocks/Servers.h"
+
+#include "Scheduler/SupervisedScheduler.h"
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <thread>
+
+using namespace arangodb;
+using namespace arangodb::tests::mocks;
+
+namespace {
+
+// every job of the chain queues the next one from within its worker, so
+// all jobs but the first one go through the worker's local queue
+struct JobChain {
+  JobChain(Scheduler& scheduler, size_t length)
+      : scheduler(scheduler), length(length) {}
+
+  void queueNext() {
+    scheduler.queue(RequestLane::CLIENT_FAST, [this]() {
+      if (jobsRun.fetch_add(1) + 1 < length) {
+        queueNext();
+      }
+    });
+  }
+
+  bool done() const { return jobsRun.load() == length; }
+
+  Scheduler& scheduler;
+  size_t const length;
+  std::atomic<size_t> jobsRun{0};
+};
+
+template<typename F>
+bool waitFor(F&& condition) {
+  auto const deadline =
+      std::chrono::steady_clock::now() + std::chrono::seconds(60);
+  while (!condition()) {
+    if (std::chrono::steady_clock::now() > deadline) {
+      return false;
+    }
+    std::this_thread::yield();
+  }
+  return true;
+}
+
+}  // namespace
+
+class SupervisedSchedulerTest : public ::testing::Test {
+ protected:
+// MSVC new/malloc only guarantees 8 byte alignment, but SupervisedScheduler
+// needs 64. Disable warning:
+#if (_MSC_VER >= 1)
+#pragma warning(push)
+#pragma warning(disable : 4316)  // Object allocated on the heap may not be
+                                 // aligned for this type
+#endif
+  auto makeScheduler(uint64_t minThreads, uint64_t maxThreads)
+      -> std::unique_ptr<SupervisedScheduler> {
+    return std::make_unique<SupervisedScheduler>(
+        mockApplicationServer.server(), minThreads, maxThreads, 128,
+        1024 * 1024, 4096, 4096, 128, 0.0, 0);
+  }
+#if (_MSC_VER >= 1)
+#pragma warning(pop)
+#endif
+
+  void TearDown() override {
+    if (scheduler != nullptr) {
+      scheduler->shutdown();
+    }
+  }
+
+  MockRestServer mockApplicationServer;
+  std::unique_ptr<SupervisedScheduler> scheduler;
+};
+
+TEST_F(SupervisedSchedulerTest, jobs_queued_by_a_worker_are_run) {
+  scheduler = makeScheduler(2, 8);
+  ASSERT_TRUE(scheduler->start());
+
+  JobChain chain(*scheduler, 1000);
+  chain.queueNext();
+  EXPECT_TRUE(waitFor([&] { return chain.done(); }));
+}
+
+TEST_F(SupervisedSchedulerTest, job_of_a_blocked_worker_is_stolen) {
+  scheduler = makeScheduler(2, 8);
+  ASSERT_TRUE(scheduler->start());
+
+  // the job is put into the local queue of the worker, which then waits
+  // for the job instead of running it. another worker must steal it
+  std::promise<void> stolen;
+  std::atomic<bool> innerDone{false};
+  std::atomic<bool> outerDone{false};
+  scheduler->queue(RequestLane::CLIENT_FAST, [&]() {
+    scheduler->queue(RequestLane::CLIENT_FAST, [&]() {
+      stolen.set_value();
+      innerDone.store(true);
+    });
+    EXPECT_EQ(std::future_status::ready,
+              stolen.get_future().wait_for(std::chrono::seconds(60)));
+    outerDone.store(true);
+  });
+  EXPECT_TRUE(waitFor([&] { return outerDone.load() && innerDone.load(); }));
+}
+
+TEST_F(SupervisedSchedulerTest, local_jobs_do_not_starve_the_global_queue) {
+  scheduler = makeScheduler(1, 4);
+  ASSERT_TRUE(scheduler->start());
+
+  // the chain keeps the local queue of its worker filled. a job in the
+  // global queue of the same priority must still be run long before the
+  // chain ends
+  JobChain chain(*scheduler, 1000);
+  std::atomic<bool> chainStarted{false};
+  std::atomic<bool> globalQueued{false};
+  scheduler->queue(RequestLane::CLIENT_FAST, [&]() {
+    chainStarted.store(true);
+    while (!globalQueued.load()) {
+      std::this_thread::yield();
+    }
+    chain.queueNext();
+  });
+  ASSERT_TRUE(waitFor([&] { return chainStarted.load(); }));
+
+  std::atomic<bool> globalDone{false};
+  size_t chainJobsBefore = 0;
+  scheduler->queue(RequestLane::CLIENT_FAST, [&]() {
+    chainJobsBefore = chain.jobsRun.load();
+    globalDone.store(true);
+  });
+  globalQueued.store(true);
+
+  ASSERT_TRUE(waitFor([&] { return chain.done(); }));
+  ASSERT_TRUE(globalDone.load());
+  EXPECT_LE(chainJobsBefore, SupervisedScheduler::MaxLocalJobsInARow);
+}
@@ -0,0 +1,106 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+
+#include "Sharding/ShardingStrategyDefault.h"
+
+#include <cstdint>
+#include <vector>
+
+using namespace arangodb;
+
+namespace {
+
+constexpr std::size_t numKeys = 100000;
+
+// splitmix64, to get well-distributed but reproducible hash values
+uint64_t hashOf(uint64_t i) {
+  uint64_t z = i + 0x9e3779b97f4a7c15ULL;
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+  return z ^ (z >> 31);
+}
+
+std::size_t jumpHash(uint64_t hashval, std::size_t numShards) {
+  return ShardingStrategyJumpHash::jumpConsistentHash(hashval, numShards);
+}
+
+}  // namespace
+
+TEST(ShardingStrategyJumpHashTest, single_shard) {
+  for (uint64_t i = 0; i < 1000; ++i) {
+    EXPECT_EQ(0U, jumpHash(hashOf(i), 1));
+  }
+}
+
+TEST(ShardingStrategyJumpHashTest, results_are_stable) {
+  // the mapping decides where documents are stored, so it must never change
+  EXPECT_EQ(0U, jumpHash(0, 1000));
+  EXPECT_EQ(6U, jumpHash(1, 10));
+  EXPECT_EQ(55U, jumpHash(1, 100));
+  EXPECT_EQ(549U, jumpHash(1, 1000));
+  EXPECT_EQ(1U, jumpHash(42, 2));
+  EXPECT_EQ(2U, jumpHash(42, 10));
+  EXPECT_EQ(43U, jumpHash(42, 100));
+  EXPECT_EQ(571U, jumpHash(42, 1000));
+  EXPECT_EQ(5U, jumpHash(0xdeadbeefULL, 10));
+  EXPECT_EQ(87U, jumpHash(0xdeadbeefULL, 100));
+  EXPECT_EQ(9U, jumpHash(UINT64_MAX, 10));
+  EXPECT_EQ(313U, jumpHash(UINT64_MAX, 1000));
+}
+
+TEST(ShardingStrategyJumpHashTest, keys_are_spread_evenly) {
+  for (std::size_t numShards : {2, 3, 7, 10, 16}) {
+    std::vector<std::size_t> counts(numShards, 0);
+    for (uint64_t i = 0; i < numKeys; ++i) {
+      std::size_t shard = jumpHash(hashOf(i), numShards);
+      ASSERT_LT(shard, numShards);
+      ++counts[shard];
+    }
+    std::size_t const expected = numKeys / numShards;
+    for (std::size_t count : counts) {
+      // allow 5% deviation from a perfectly even distribution
+      EXPECT_GT(count, expected * 95 / 100) << "numShards: " << numShards;
+      EXPECT_LT(count, expected * 105 / 100) << "numShards: " << numShards;
+    }
+  }
+}
+
+TEST(ShardingStrategyJumpHashTest, adding_a_shard_moves_few_keys) {
+  for (std::size_t numShards : {1, 2, 5, 10, 15}) {
+    std::size_t moved = 0;
+    for (uint64_t i = 0; i < numKeys; ++i) {
+      uint64_t hashval = hashOf(i);
+      std::size_t before = jumpHash(hashval, numShards);
+      std::size_t after = jumpHash(hashval, numShards + 1);
+      if (before != after) {
+        // keys only ever move to the new shard
+        EXPECT_EQ(numShards, after);
+        ++moved;
+      }
+    }
+    // about 1/(n + 1) of the keys move, allow 5% deviation
+    std::size_t const expected = numKeys / (numShards + 1);
+    EXPECT_GT(moved, expected * 95 / 100) << "numShards: " << numShards;
+    EXPECT_LT(moved, expected * 105 / 100) << "numShards: " << numShards;
+  }
+}
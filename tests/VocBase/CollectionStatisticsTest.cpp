@@ -0,0 +1,158 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include "gtest/gtest.h"
+
+#include "Basics/AttributeNameParser.h"
+#include "VocBase/CollectionStatistics.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Parser.h>
+#include <velocypack/Slice.h>
+#include <velocypack/Value.h>
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+using namespace arangodb;
+
+namespace {
+std::vector<basics::AttributeName> const valueAttribute{
+    basics::AttributeName(std::string_view("value"))};
+
+void addDocument(CollectionStatisticsBuilder& builder,
+                 velocypack::Value value) {
+  velocypack::Builder doc;
+  doc.openObject();
+  doc.add("value", value);
+  doc.close();
+  builder.add(doc.slice());
+}
+}  // namespace
+
+TEST(CollectionStatisticsTest, range_selectivity_of_numbers) {
+  CollectionStatisticsBuilder builder({});
+  for (int i = 0; i < 1000; ++i) {
+    addDocument(builder, velocypack::Value(i));
+  }
+  auto stats = builder.finish(1000);
+  auto const* value = stats->get(valueAttribute);
+  ASSERT_NE(nullptr, value);
+
+  EXPECT_NEAR(0.5, value->rangeSelectivity(250.0, 750.0), 0.01);
+  EXPECT_NEAR(0.1, value->rangeSelectivity(std::nullopt, 100.0), 0.01);
+  EXPECT_NEAR(0.1, value->rangeSelectivity(900.0, std::nullopt), 0.01);
+  EXPECT_DOUBLE_EQ(0.0, value->rangeSelectivity(2000.0, 3000.0));
+  EXPECT_DOUBLE_EQ(1.0, value->rangeSelectivity(std::nullopt, std::nullopt));
+  EXPECT_DOUBLE_EQ(1000.0, value->distinctValues());
+  EXPECT_DOUBLE_EQ(0.001, value->equalitySelectivity());
+}
+
+TEST(CollectionStatisticsTest, range_selectivity_respects_type_order) {
+  CollectionStatisticsBuilder builder({});
+  for (int i = 0; i < 100; ++i) {
+    if (i % 2 == 0) {
+      addDocument(builder, velocypack::Value(velocypack::ValueType::Null));
+    } else {
+      addDocument(builder, velocypack::Value(std::to_string(i)));
+    }
+  }
+  auto stats = builder.finish(100);
+  auto const* value = stats->get(valueAttribute);
+  ASSERT_NE(nullptr, value);
+
+  // nulls are less than any number, strings are greater than any number
+  EXPECT_DOUBLE_EQ(0.5, value->rangeSelectivity(std::nullopt, 5.0));
+  EXPECT_DOUBLE_EQ(0.5, value->rangeSelectivity(5.0, std::nullopt));
+  EXPECT_DOUBLE_EQ(0.0, value->rangeSelectivity(0.0, 10.0));
+  EXPECT_DOUBLE_EQ(0.01, value->equalitySelectivity());
+}
+
+TEST(CollectionStatisticsTest, distinct_values_are_extrapolated) {
+  {
+    // all sampled values are unique, so the collection is likely unique
+    CollectionStatisticsBuilder builder({});
+    for (int i = 0; i < 100; ++i) {
+      addDocument(builder, velocypack::Value(i));
+    }
+    auto stats = builder.finish(10000);
+    EXPECT_DOUBLE_EQ(10000.0, stats->get(valueAttribute)->distinctValues());
+  }
+  {
+    // every sampled value occurs twice, so there are probably no others
+    CollectionStatisticsBuilder builder({});
+    for (int i = 0; i < 100; ++i) {
+      addDocument(builder, velocypack::Value(i / 2));
+    }
+    auto stats = builder.finish(10000);
+    EXPECT_DOUBLE_EQ(50.0, stats->get(valueAttribute)->distinctValues());
+  }
+}
+
+TEST(CollectionStatisticsTest, nested_attributes) {
+  CollectionStatisticsBuilder builder({{"a", "b"}});
+  for (int i = 0; i < 10; ++i) {
+    auto doc = velocypack::Parser::fromJson("{\"a\":{\"b\":" +
+                                            std::to_string(i) + "}}");
+    builder.add(doc->slice());
+  }
+  auto stats = builder.finish(10);
+  EXPECT_NE(nullptr,
+            stats->get({basics::AttributeName(std::string_view("a")),
+                        basics::AttributeName(std::string_view("b"))}));
+  EXPECT_EQ(nullptr,
+            stats->get({basics::AttributeName(std::string_view("b"))}));
+  EXPECT_EQ(nullptr,
+            stats->get({basics::AttributeName(std::string_view("a"), true)}));
+}
+
+TEST(CollectionStatisticsTest, velocypack_round_trip) {
+  CollectionStatisticsBuilder builder({});
+  for (int i = 0; i < 100; ++i) {
+    addDocument(builder, velocypack::Value(i * 2));
+  }
+  auto stats = builder.finish(100);
+
+  velocypack::Builder serialized;
+  stats->toVelocyPack(serialized);
+  CollectionStatistics restored(serialized.slice());
+
+  EXPECT_EQ(100, restored.numberDocuments());
+  auto const* value = restored.get(valueAttribute);
+  ASSERT_NE(nullptr, value);
+  EXPECT_DOUBLE_EQ(stats->get(valueAttribute)->rangeSelectivity(10.0, 50.0),
+                   value->rangeSelectivity(10.0, 50.0));
+  EXPECT_DOUBLE_EQ(100.0, value->distinctValues());
+}
+
+TEST(CollectionStatisticsTest, needs_analysis) {
+  EXPECT_FALSE(CollectionStatistics::needsAnalysis(nullptr, 999));
+  EXPECT_TRUE(CollectionStatistics::needsAnalysis(nullptr, 1000));
+
+  CollectionStatistics stats(10000);
+  EXPECT_FALSE(CollectionStatistics::needsAnalysis(&stats, 10000));
+  EXPECT_FALSE(CollectionStatistics::needsAnalysis(&stats, 11000));
+  EXPECT_TRUE(CollectionStatistics::needsAnalysis(&stats, 13000));
+  EXPECT_TRUE(CollectionStatistics::needsAnalysis(&stats, 7000));
+}
@@ -1009,3 +1009,48 @@ TEST_F(ComputedValuesTest, insertKeepNullTrue) {
                      })
                   .ok());
 }
+
+TEST_F(ComputedValuesTest, insertMultipleDocumentsCompiledExpression) {
+  auto& vocbase = server->getSystemDatabase();
+  auto b = velocypack::Parser::fromJson(
+      "{\"name\":\"test\", \"computedValues\": [{\"name\":\"attr\", "
+      "\"expression\":\"RETURN @doc.value > 2 ? @doc.value * 2 + 1 : "
+      "CONCAT('v', @doc.value)\", \"overwrite\": true}]}");
+
+  auto c = vocbase.createCollection(b->slice());
+  ASSERT_NE(nullptr, c->computedValues());
+
+  std::vector<std::string> const EMPTY;
+  std::vector<std::string> collections{"test"};
+  transaction::Methods trx(transaction::StandaloneContext::Create(vocbase),
+                           EMPTY, collections, EMPTY, transaction::Options());
+
+  EXPECT_TRUE(trx.begin().ok());
+  velocypack::Builder docs;
+  docs.openArray();
+  for (int i = 0; i < 10; ++i) {
+    docs.openObject();
+    docs.add("_key", velocypack::Value("test" + std::to_string(i)));
+    docs.add("value", velocypack::Value(i));
+    docs.close();
+  }
+  docs.close();
+  EXPECT_TRUE(trx.insert("test", docs.slice(), OperationOptions()).ok());
+
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_TRUE(trx.documentFastPathLocal(
+                       "test", "test" + std::to_string(i),
+                       [&](LocalDocumentId const& token,
+                           velocypack::Slice doc) {
+                         if (i > 2) {
+                           EXPECT_EQ(i * 2 + 1,
+                                     doc.get("attr").getNumber<int>());
+                         } else {
+                           EXPECT_EQ("v" + std::to_string(i),
+                                     doc.get("attr").stringView());
+                         }
+                         return true;
+                       })
+                    .ok());
+  }
+}
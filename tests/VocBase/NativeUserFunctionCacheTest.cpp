@@ -0,0 +1,117 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "VocBase/Methods/NativeUserFunctionCache.h"
+
+#include "gtest/gtest.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Parser.h>
+
+using namespace arangodb;
+
+namespace {
+std::shared_ptr<velocypack::Builder const> makeDefinition(int arguments) {
+  return velocypack::Parser::fromJson(
+      R"({"language":"aql","ast":{},"arguments":)" +
+      std::to_string(arguments) + "}");
+}
+}  // namespace
+
+TEST(NativeUserFunctionCacheTest, miss) {
+  NativeUserFunctionCache cache;
+  std::shared_ptr<velocypack::Builder const> definition;
+  EXPECT_FALSE(cache.lookup(1, "MY::FUNC", definition));
+
+  cache.store(1, cache.generation(), "MY::FUNC", makeDefinition(1));
+  // other functions and other databases are not cached
+  EXPECT_FALSE(cache.lookup(1, "MY::OTHER", definition));
+  EXPECT_FALSE(cache.lookup(2, "MY::FUNC", definition));
+}
+
+TEST(NativeUserFunctionCacheTest, hit) {
+  NativeUserFunctionCache cache;
+  cache.store(1, cache.generation(), "MY::FUNC", makeDefinition(2));
+
+  std::shared_ptr<velocypack::Builder const> definition;
+  ASSERT_TRUE(cache.lookup(1, "MY::FUNC", definition));
+  ASSERT_NE(nullptr, definition);
+  EXPECT_EQ(2, definition->slice().get("arguments").getNumber<int>());
+}
+
+TEST(NativeUserFunctionCacheTest, negative_entry) {
+  NativeUserFunctionCache cache;
+  cache.store(1, cache.generation(), "MY::JSFUNC", nullptr);
+
+  auto definition = makeDefinition(1);
+  // the lookup succeeds, and tells that there is no native function
+  ASSERT_TRUE(cache.lookup(1, "MY::JSFUNC", definition));
+  EXPECT_EQ(nullptr, definition);
+}
+
+TEST(NativeUserFunctionCacheTest, invalidation) {
+  NativeUserFunctionCache cache;
+  cache.store(1, cache.generation(), "MY::FUNC", makeDefinition(1));
+  cache.store(1, cache.generation(), "MY::JSFUNC", nullptr);
+  cache.store(2, cache.generation(), "MY::FUNC", makeDefinition(3));
+
+  cache.invalidate(1);
+
+  std::shared_ptr<velocypack::Builder const> definition;
+  EXPECT_FALSE(cache.lookup(1, "MY::FUNC", definition));
+  EXPECT_FALSE(cache.lookup(1, "MY::JSFUNC", definition));
+  // the functions of other databases stay cached
+  ASSERT_TRUE(cache.lookup(2, "MY::FUNC", definition));
+  ASSERT_NE(nullptr, definition);
+  EXPECT_EQ(3, definition->slice().get("arguments").getNumber<int>());
+}
+
+TEST(NativeUserFunctionCacheTest, outdated_store_is_ignored) {
+  NativeUserFunctionCache cache;
+  // a lookup fetches the generation, then reads the definition, while the
+  // function is replaced concurrently
+  uint64_t const generation = cache.generation();
+  cache.invalidate(1);
+  cache.store(1, generation, "MY::FUNC", makeDefinition(1));
+
+  std::shared_ptr<velocypack::Builder const> definition;
+  EXPECT_FALSE(cache.lookup(1, "MY::FUNC", definition));
+
+  cache.store(1, cache.generation(), "MY::FUNC", makeDefinition(2));
+  ASSERT_TRUE(cache.lookup(1, "MY::FUNC", definition));
+  EXPECT_EQ(2, definition->slice().get("arguments").getNumber<int>());
+}
+
+TEST(NativeUserFunctionCacheTest, limited_size) {
+  NativeUserFunctionCache cache;
+  for (size_t i = 0; i < NativeUserFunctionCache::maxFunctionsPerDatabase;
+       ++i) {
+    cache.store(1, cache.generation(), "MY::FUNC" + std::to_string(i),
+                nullptr);
+  }
+  std::shared_ptr<velocypack::Builder const> definition;
+  EXPECT_TRUE(cache.lookup(1, "MY::FUNC0", definition));
+
+  // the cache of the database is full and starts over
+  cache.store(1, cache.generation(), "MY::NEXT", nullptr);
+  EXPECT_FALSE(cache.lookup(1, "MY::FUNC0", definition));
+  EXPECT_TRUE(cache.lookup(1, "MY::NEXT", definition));
+}
@@ -109,6 +109,7 @@ TEST_F(ClusteringConstantPropertiesTest, test_shardingStrategy) {
   };
   std::vector<std::string> allowedStrategies{"",
                                              "hash",
+                                             "jump-hash",
                                              "enterprise-hash-smart-edge",
                                              "community-compat",
                                              "enterprise-compat",
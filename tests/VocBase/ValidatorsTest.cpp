@@ -0,0 +1,126 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/voc-errors.h"
+#include "VocBase/Validators.h"
+
+#include "gtest/gtest.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Parser.h>
+
+#include <string_view>
+
+using namespace arangodb;
+
+namespace {
+
+ValidatorJsonSchema makeValidator(std::string_view rule) {
+  auto params = velocypack::Parser::fromJson(
+      std::string("{\"level\":\"strict\",\"message\":\"failed\",\"rule\":") +
+      std::string(rule) + "}");
+  return ValidatorJsonSchema(params->slice());
+}
+
+bool isValid(ValidatorJsonSchema const& validator, std::string_view doc) {
+  auto builder = velocypack::Parser::fromJson(doc.data(), doc.size());
+  auto res = validator.validateOne(builder->slice(),
+                                   &velocypack::Options::Defaults);
+  if (res.fail()) {
+    EXPECT_EQ(TRI_ERROR_VALIDATION_FAILED, res.errorNumber());
+    EXPECT_EQ("failed", res.errorMessage());
+  }
+  return res.ok();
+}
+
+}  // namespace
+
+TEST(ValidatorsTest, typesOfAttributes) {
+  auto validator = makeValidator(R"({
+    "type": "object",
+    "properties": {
+      "name": { "type": "string", "description": "the name" },
+      "age": { "type": "integer" },
+      "score": { "type": ["number", "null"] },
+      "tags": { "type": "array" }
+    }
+  })");
+
+  EXPECT_TRUE(isValid(validator, R"({})"));
+  EXPECT_TRUE(isValid(validator, R"({"name":"a","age":3,"score":1.5})"));
+  EXPECT_TRUE(isValid(validator, R"({"score":null,"tags":[1,"x"]})"));
+  EXPECT_TRUE(isValid(validator, R"({"score":-2,"other":{"a":1}})"));
+  EXPECT_FALSE(isValid(validator, R"({"name":1})"));
+  EXPECT_FALSE(isValid(validator, R"({"age":"3"})"));
+  EXPECT_FALSE(isValid(validator, R"({"age":3.5})"));
+  EXPECT_FALSE(isValid(validator, R"({"score":"high"})"));
+  EXPECT_FALSE(isValid(validator, R"({"tags":{}})"));
+  EXPECT_FALSE(isValid(validator, R"([])"));
+  EXPECT_FALSE(isValid(validator, R"("name")"));
+}
+
+TEST(ValidatorsTest, requiredAndAdditionalAttributes) {
+  auto validator = makeValidator(R"({
+    "type": "object",
+    "required": ["name"],
+    "additionalProperties": false,
+    "properties": {
+      "name": { "type": "string" },
+      "address": {
+        "type": "object",
+        "required": ["city"],
+        "properties": { "city": { "type": "string" } }
+      }
+    }
+  })");
+
+  EXPECT_TRUE(isValid(validator, R"({"name":"a"})"));
+  EXPECT_TRUE(isValid(validator, R"({"name":"a","address":{"city":"b"}})"));
+  EXPECT_TRUE(
+      isValid(validator, R"({"name":"a","address":{"city":"b","zip":1}})"));
+  EXPECT_FALSE(isValid(validator, R"({})"));
+  EXPECT_FALSE(isValid(validator, R"({"name":"a","age":1})"));
+  EXPECT_FALSE(isValid(validator, R"({"name":"a","address":{}})"));
+  EXPECT_FALSE(isValid(validator, R"({"name":"a","address":{"city":1}})"));
+  // system attributes are not visible to the schema
+  EXPECT_TRUE(isValid(validator, R"({"name":"a","_key":"k","_rev":"r"})"));
+}
+
+TEST(ValidatorsTest, requiredSystemAttribute) {
+  auto validator = makeValidator(R"({"required": ["_key"]})");
+
+  EXPECT_FALSE(isValid(validator, R"({"_key":"k"})"));
+}
+
+TEST(ValidatorsTest, otherKeywords) {
+  auto validator = makeValidator(R"({
+    "type": "object",
+    "properties": {
+      "name": { "type": "string", "minLength": 2 },
+      "tags": { "type": "array", "items": { "type": "string" } }
+    }
+  })");
+
+  EXPECT_TRUE(isValid(validator, R"({"name":"ab","tags":["x"]})"));
+  EXPECT_FALSE(isValid(validator, R"({"name":"a"})"));
+  EXPECT_FALSE(isValid(validator, R"({"tags":[1]})"));
+  EXPECT_FALSE(isValid(validator, R"({"name":1})"));
+}